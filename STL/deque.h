@@ -4,6 +4,11 @@
  * 双向开口的[分段]连续性空间
  * 区别：vector:单向开口的；deque:双向开口的
  * 迭代器：Random Access iterators
+ * 缓冲区大小：缺省由 deque_buf_size 决定，可在运行期以 deque<T>::set_default_buffer_size() 调整，
+ *   每个 deque 在构造时取当时的缺省值，之后不变；迭代器由 last - first 得知缓冲区大小
+ * 缓冲区回收：释放的缓冲区先放进每个 deque 自带的小缓存(最多 DEQUE_SPARE_BUFFERS 个)，
+ *   另一端需要新缓冲区时优先取用，当作队列使用(尾进头出)时稳定后不再配置、释放内存
+ * map 扩充：节点数不到 map 容量的一半时只把节点挪回 map 中央，否则才配置更大的 map
  */
 #include <cstddef>                       //for size_t, ptrdiff_t
 #include "../src/memory/allocator.h"     //标准空间配置器
@@ -17,6 +22,10 @@ namespace zfwstl
   // deque map 初始化的大小
 #ifndef DEQUE_MAP_INIT_SIZE
 #define DEQUE_MAP_INIT_SIZE 8
+#endif
+  // 每个 deque 缓存的空闲缓冲区个数上限
+#ifndef DEQUE_SPARE_BUFFERS
+#define DEQUE_SPARE_BUFFERS 2
 #endif
 
   template <class T, size_t BufSize = 0>
@@ -41,8 +50,6 @@ namespace zfwstl
     typedef T *value_pointer;
     typedef T **map_pointer;
 
-    static const size_type buffer_size = deque_buf_size<T, BufSize>::value; // 缓冲区大小
-
     // 迭代器所含成员数据 [first, cur)
     value_pointer cur;   // NOTE:cur指向所在缓冲区[1-开头]首元素 ；[2-末尾]尾元素的下一个位置
     value_pointer first; // 指向所在缓冲区的头部
@@ -56,8 +63,8 @@ namespace zfwstl
     __deque_iterator() noexcept
         : cur(nullptr), first(nullptr), last(nullptr), node(nullptr) {}
 
-    __deque_iterator(value_pointer v, map_pointer n)
-        : cur(v), first(*n), last(*n + buffer_size), node(n) {}
+    __deque_iterator(value_pointer v, map_pointer n, size_type buf_size)
+        : cur(v), first(*n), last(*n + buf_size), node(n) {}
 
     __deque_iterator(const iterator &rhs)
         : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node)
@@ -76,17 +83,24 @@ namespace zfwstl
         : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node)
     {
     }
+    self &operator=(const self &) = default;
 
     /**
      * 一旦行进时遇到缓冲区边缘，要特别当心！视前进或后退而定，可能需调用以下函数：
      * 跳出一个缓冲区
      */
     void set_node(map_pointer new_node)
+    {
+      set_node(new_node, buffer_size());
+    }
+    void set_node(map_pointer new_node, size_type buf_size)
     {
       node = new_node;
       first = *new_node;
-      last = first + buffer_size;
+      last = first + buf_size;
     }
+    // 缓冲区大小(元素个数)，由所属 deque 在运行期决定
+    size_type buffer_size() const { return static_cast<size_type>(last - first); }
     // 重载运算符
     reference operator*() const { return *cur; }
     pointer operator->() const { return cur; }
@@ -98,7 +112,8 @@ namespace zfwstl
        * static_cast<difference_type>(buffer_size) * (node - x.node)：计算两个迭代器之间完整缓冲区的元素数量。
        * (cur - first) - (x.cur - x.first)：计算两个迭代器在各自缓冲区中的相对位置差。
        */
-      return static_cast<difference_type>(buffer_size) * (node - x.node) + (cur - first) - (x.cur - x.first);
+      const difference_type buf_size = node != x.node ? last - first : 0; // 同一缓冲区时不用乘，也允许空迭代器
+      return buf_size * (node - x.node) + (cur - first) - (x.cur - x.first);
     }
     self &operator++()
     {
@@ -136,18 +151,19 @@ namespace zfwstl
     self &operator+=(difference_type n)
     {
       const auto offset = n + (cur - first);
-      if (offset >= 0 && offset < static_cast<difference_type>(buffer_size))
+      const difference_type buf_size = last - first;
+      if (offset >= 0 && offset < buf_size)
       { // 仍在当前缓冲区
         cur += n;
       }
       else
       { // 要跳到其他的缓冲区
         const auto node_offset = offset > 0
-                                     ? offset / static_cast<difference_type>(buffer_size)
-                                     : -static_cast<difference_type>((-offset - 1) / buffer_size) - 1;
-        set_node(node + node_offset); // 切换到正确map节点，即缓冲区上
+                                     ? offset / buf_size
+                                     : -((-offset - 1) / buf_size) - 1;
+        set_node(node + node_offset, buf_size); // 切换到正确map节点，即缓冲区上
         // 在新缓冲区上，移动到正确元素位置
-        cur = first + (offset - node_offset * static_cast<difference_type>(buffer_size));
+        cur = first + (offset - node_offset * buf_size);
       }
       return *this;
     }
@@ -168,17 +184,6 @@ namespace zfwstl
     }
     // TAG:*this 是一个指针，它指向当前对象
     reference operator[](difference_type n) const { return *(*this + n); }
-    self &operator=(const iterator &rhs)
-    {
-      if (this != &rhs)
-      {
-        cur = rhs.cur;
-        first = rhs.first;
-        last = rhs.last;
-        node = rhs.node;
-      }
-      return *this;
-    }
     // 重载比较操作符
     bool operator==(const self &rhs) const { return cur == rhs.cur; }
     bool operator<(const self &rhs) const
@@ -191,15 +196,42 @@ namespace zfwstl
     bool operator>=(const self &rhs) const { return !(*this < rhs); }
   };
 
+  // deque 迭代器是分段迭代器：每个缓冲区是一段连续内存(见 iterator.h)
+  template <class T, class Ref, class Ptr, size_t BufSize>
+  struct segmented_iterator_traits<__deque_iterator<T, Ref, Ptr, BufSize>>
+  {
+    typedef std::true_type is_segmented;
+    typedef __deque_iterator<T, Ref, Ptr, BufSize> iterator;
+    typedef Ptr local_iterator;
+
+    static local_iterator local(const iterator &it) { return it.cur; }
+    static local_iterator local_begin(const iterator &it) { return it.first; }
+    static local_iterator local_end(const iterator &it) { return it.last; }
+    static bool same_segment(const iterator &a, const iterator &b) { return a.node == b.node; }
+    static void next_segment(iterator &it)
+    {
+      it.set_node(it.node + 1);
+      it.cur = it.first;
+    }
+    static void prev_segment(iterator &it)
+    {
+      it.set_node(it.node - 1);
+      it.cur = it.last;
+    }
+    static void set_local(iterator &it, local_iterator p) { it.cur = const_cast<T *>(p); }
+  };
+
   //======================================deque===========================================
-  template <class T /*,class Alloc=alloc*/, size_t BufSize = 0>
+  // Alloc: 原始内存配置器，默认 new_alloc(::operator new)
+  // 为兼容已有的 deque<T, BufSize> 写法，Alloc 放在 BufSize 之后
+  template <class T, size_t BufSize = 0, class Alloc = zfwstl::new_alloc>
   class deque
   {
   public:
     //  专属空间配置器
-    typedef zfwstl::simple_allocator<T> data_allocator; // 每次配置一个元素大小
-    typedef zfwstl::simple_allocator<T> allocator_type;
-    typedef zfwstl::simple_allocator<T *> map_allocator; // 每次配置一个指针大小
+    typedef zfwstl::simple_allocator<T, Alloc> data_allocator; // 每次配置一个元素大小
+    typedef zfwstl::simple_allocator<T, Alloc> allocator_type;
+    typedef zfwstl::simple_allocator<T *, Alloc> map_allocator; // 每次配置一个指针大小
     // list 的嵌套型别定义
     typedef typename allocator_type::value_type value_type;
     typedef typename allocator_type::pointer pointer;
@@ -224,8 +256,20 @@ namespace zfwstl
      */
     map_pointer map;    // 指向map中控器的指针
     size_type map_size; // map内可容纳多少指针
+    size_type buf_size = default_buffer_size(); // 每个缓冲区的元素个数，构造时确定
+    pointer spare[DEQUE_SPARE_BUFFERS] = {}; // 空闲缓冲区缓存
+    size_type spare_count = 0;
 
   public:
+    // 之后构造的 deque<T, BufSize, Alloc> 使用的缓冲区大小(元素个数)，0 表示恢复 deque_buf_size 的缺省值
+    // 只影响之后构造的 deque，应在构造 deque 前设定(不是线程安全的)
+    static void set_default_buffer_size(size_type n)
+    {
+      default_buffer_size_ref() = n != 0 ? n : deque_buf_size<T, BufSize>::value;
+    }
+    static size_type default_buffer_size() { return default_buffer_size_ref(); }
+    size_type buffer_size() const noexcept { return buf_size; }
+
     // 构造、复制、移动、析构函数
     // 默认构造函数
     deque() { fill_initialize(0, value_type()); }
@@ -253,21 +297,27 @@ namespace zfwstl
         : start(zfwstl::move(rhs.start)),
           finish(zfwstl::move(rhs.finish)),
           map(rhs.map),
-          map_size(rhs.map_size)
+          map_size(rhs.map_size),
+          buf_size(rhs.buf_size),
+          spare_count(rhs.spare_count)
     {
+      for (size_type i = 0; i < spare_count; ++i)
+        spare[i] = rhs.spare[i];
       rhs.map = nullptr;
       rhs.map_size = 0;
+      rhs.spare_count = 0;
     }
     ~deque()
     {
       if (map != nullptr)
       {
         clear();
-        data_allocator::deallocate(*start.node, start.buffer_size); // 表示start.node指针所指向的内存块中的元素数组的首地址
+        data_allocator::deallocate(*start.node, buf_size); // 表示start.node指针所指向的内存块中的元素数组的首地址
         *start.node = nullptr;
         map_allocator::deallocate(map, map_size);
         map = nullptr;
       }
+      release_spare();
     }
 
     iterator begin() noexcept
@@ -382,16 +432,14 @@ namespace zfwstl
       }
       return *this;
     }
-    // 移动赋值运算符
-    deque &operator=(deque &&rhs)
+    // 移动赋值运算符：原有的 map 与缓冲区随 tmp 析构释放
+    deque &operator=(deque &&rhs) noexcept
     {
-      clear();
-      start = zfwstl::move(rhs.start);
-      finish = zfwstl::move(rhs.finish);
-      map = rhs.map;
-      map_size = rhs.map_size;
-      rhs.map = nullptr;
-      rhs.map_size = 0;
+      if (this != &rhs)
+      {
+        deque tmp(zfwstl::move(rhs));
+        swap(tmp);
+      }
       return *this;
     }
     deque &operator=(std::initializer_list<value_type> ilist)
@@ -409,6 +457,10 @@ namespace zfwstl
         zfwstl::swap(finish, rhs.finish);
         zfwstl::swap(map, rhs.map);
         zfwstl::swap(map_size, rhs.map_size);
+        zfwstl::swap(buf_size, rhs.buf_size);
+        for (size_type i = 0; i < DEQUE_SPARE_BUFFERS; ++i)
+          zfwstl::swap(spare[i], rhs.spare[i]);
+        zfwstl::swap(spare_count, rhs.spare_count);
       }
     }
 
@@ -433,16 +485,16 @@ namespace zfwstl
       // 针对头尾以外的每个缓冲区(它们一定都是饱满的)
       for (auto node = start.node + 1; node < finish.node; ++node)
       {
-        data_allocator::destroy(*node, *node + start.buffer_size);
-        data_allocator::deallocate(*node, start.buffer_size);
+        data_allocator::destroy(*node, *node + buf_size);
+        deallocate_node(*node);
       }
       if (start.node != finish.node)
       {
         // 至少有头尾两个缓冲区
         data_allocator::destroy(start.cur, start.last);
-        data_allocator::destroy(finish.cur, finish.last);
+        data_allocator::destroy(finish.first, finish.cur);
         // 释放尾部缓冲区，注意，头缓冲区保留
-        data_allocator::deallocate(finish.first, finish.buffer_size);
+        deallocate_node(finish.first);
       }
       else
         data_allocator::destroy(start.cur, finish.cur); // 只有一个缓冲区，仅析构所有元素而不释放缓冲区内存空间
@@ -457,6 +509,7 @@ namespace zfwstl
      */
     void shrink_to_fit() noexcept
     {
+      release_spare(); // 缓存的空闲缓冲区全部归还
       if (empty())
         return; // 如果容器为空，直接返回
       // 计算当前使用的缓冲区数量
@@ -468,7 +521,7 @@ namespace zfwstl
       size_type new_map_size = used_buffers + 2; // 保留一个头部和一个尾部的备用缓冲区
       // 分配新的 map
       map_pointer new_map = map_allocator::allocate(new_map_size);
-      map_pointer new_nstart = new_map + new_map_size / 2;
+      map_pointer new_nstart = new_map + 1;
       // 复制当前使用的缓冲区到新的 map
       zfwstl::copy(start.node, finish.node + 1, new_nstart);
       // for (size_type i = 0; i < used_buffers; ++i)
@@ -595,7 +648,7 @@ namespace zfwstl
     }
     void pop_back()
     {
-      if (finish.cur == finish.last)
+      if (finish.cur == finish.first)
         pop_back_aux(); // 最后缓冲区buffer没有任何元素，释放工作
       else
       {
@@ -704,10 +757,10 @@ namespace zfwstl
           // 前方元素较少
           zfwstl::copy_backward(start, first, last); // 向后移动前方元素(覆盖清除区间)
           iterator new_start = start + n;            // 标记deque新起点
-          data_allocator::destroy(start.first, new_start.last);
+          zfwstl::destroy(start, new_start);
           // 将冗余的缓冲区释放
           for (auto cur = start.node; cur < new_start.node; ++cur)
-            data_allocator::deallocate(*cur, start.buffer_size);
+            deallocate_node(*cur);
           start = new_start;
         }
         else
@@ -715,10 +768,10 @@ namespace zfwstl
           // 后方元素较少
           zfwstl::copy(last, finish, first); // 向前移动后方元素(覆盖清除区间)
           iterator new_finish = finish - n;
-          data_allocator::destroy(new_finish.first, finish.last);
+          zfwstl::destroy(new_finish, finish);
           // 将冗余的缓冲区释放
           for (auto cur = new_finish.node + 1; cur <= finish.node; ++cur)
-            data_allocator::deallocate(*cur, finish.buffer_size);
+            deallocate_node(*cur);
           finish = new_finish;
         }
         return start + elems_before;
@@ -726,15 +779,30 @@ namespace zfwstl
     }
 
   protected:
-    // 配置一个新节点(buffer缓冲区)
+    static size_type &default_buffer_size_ref()
+    {
+      static size_type n = deque_buf_size<T, BufSize>::value;
+      return n;
+    }
+    // 配置一个新节点(buffer缓冲区)：优先取用缓存的空闲缓冲区
     pointer allocate_node()
     {
-      auto tmp = data_allocator::allocate(start.buffer_size);
-      return tmp;
+      if (spare_count != 0)
+        return spare[--spare_count];
+      return data_allocator::allocate(buf_size);
     }
+    // 释放一个节点：缓存未满时留作下次使用
     void deallocate_node(pointer p)
     {
-      data_allocator::deallocate(p, start.buffer_size);
+      if (spare_count < DEQUE_SPARE_BUFFERS)
+        spare[spare_count++] = p;
+      else
+        data_allocator::deallocate(p, buf_size);
+    }
+    void release_spare()
+    {
+      while (spare_count != 0)
+        data_allocator::deallocate(spare[--spare_count], buf_size);
     }
     // NOTE: deque关键函数！配置多个新节点(buffer缓冲区)
     void create_buffer(map_pointer nstart, map_pointer nfinish)
@@ -744,7 +812,7 @@ namespace zfwstl
       {
         for (cur = nstart; cur <= nfinish; ++cur)
         {
-          *cur = data_allocator::allocate(start.buffer_size);
+          *cur = allocate_node();
         }
       }
       catch (...)
@@ -752,7 +820,7 @@ namespace zfwstl
         while (cur != nstart)
         {
           --cur;
-          data_allocator::deallocate(*cur, start.buffer_size);
+          deallocate_node(*cur);
           *cur = nullptr;
         }
         throw;
@@ -763,7 +831,7 @@ namespace zfwstl
     {
       for (map_pointer n = nstart; n <= nfinish; ++n)
       {
-        data_allocator::deallocate(*n, start.buffer_size);
+        deallocate_node(*n);
         *n = nullptr;
       }
     }
@@ -772,22 +840,15 @@ namespace zfwstl
     {
       if (front && (static_cast<size_type>(start.cur - start.first) < n))
       {
-        const size_type need_buffer = (n - (start.cur - start.first)) / start.buffer_size + 1;
-        if (need_buffer > static_cast<size_type>(start.node - map))
-        {
-          reserve_map_at_front(need_buffer);
-          return;
-        }
+        // 恰好填满时不多配置缓冲区，否则多出的缓冲区不在 [start.node, finish.node] 内，无人释放
+        const size_type need_buffer = (n - (start.cur - start.first) - 1) / buf_size + 1;
+        reserve_map_at_front(need_buffer); // map 前端节点不够时先扩充(或挪回中央)，再配置缓冲区
         create_buffer(start.node - need_buffer, start.node - 1);
       }
       else if (!front && (static_cast<size_type>(finish.last - finish.cur - 1) < n))
       {
-        const size_type need_buffer = (n - (finish.last - finish.cur - 1)) / finish.buffer_size + 1;
-        if (need_buffer > static_cast<size_type>((map + map_size) - finish.node - 1))
-        {
-          reserve_map_at_back(need_buffer);
-          return;
-        }
+        const size_type need_buffer = (n - (finish.last - finish.cur - 1) - 1) / buf_size + 1;
+        reserve_map_at_back(need_buffer);
         create_buffer(finish.node + 1, finish.node + need_buffer);
       }
     }
@@ -795,10 +856,9 @@ namespace zfwstl
     {
       // 需要map节点数=(元素个数/每个缓冲区可容纳元素个数)+1
       // 如果刚好整除，会多分配一个节点
-      const size_type num_nodes = num_elements / start.buffer_size + 1;
+      const size_type num_nodes = num_elements / buf_size + 1;
       // 一个map管理节点数最少8个，最多 ="所需节点数 +2(前后各预留一个，扩充时可用) "
       map_size = zfwstl::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE), num_nodes + 2);
-      // std::cout << "buffer_size:" << start.buffer_size << std::endl;
       // std::cout << "map_size:" << map_size << std::endl;
       map = map_allocator::allocate(map_size); // 分配内存空间
       // nstart, nfinish指向map所拥有之全部节点的最中央区段
@@ -820,12 +880,12 @@ namespace zfwstl
         throw;
       }
       // 为deque内的两个迭代器 start, finish设置正确内容
-      start.set_node(nstart);
-      finish.set_node(nfinish);
+      start.set_node(nstart, buf_size);
+      finish.set_node(nfinish, buf_size);
       start.cur = start.first;
       // 前面所述，若刚好整除，会多分配一个节点
       // 此时cur就会与first指向相同位置
-      finish.cur = finish.first + num_elements % finish.buffer_size;
+      finish.cur = finish.first + num_elements % buf_size;
     }
     void fill_initialize(size_type n, const value_type &x)
     {
@@ -835,7 +895,7 @@ namespace zfwstl
       {
         for (cur = start.node; cur < finish.node; ++cur)
         {
-          zfwstl::uninitialized_fill(*cur, *cur + start.buffer_size, x);
+          zfwstl::uninitialized_fill(*cur, *cur + buf_size, x);
         }
         // NOTE:因为最后一个map中控节点指向的buffer缓冲区可能会有备用空间未使用，不能将这部分初始化
         zfwstl::uninitialized_fill(finish.first, finish.cur, x);
@@ -845,8 +905,8 @@ namespace zfwstl
     template <class IIter>
     void copy_init(IIter first, IIter last, input_iterator_tag)
     {
-      const size_type n = zfwstl::distance(first, last);
-      create_map_and_nodes(n);
+      // 输入迭代器只能遍历一次，无法预知个数：从空容器逐个追加
+      create_map_and_nodes(0);
       for (; first != last; ++first)
         emplace_back(*first);
     }
@@ -858,7 +918,7 @@ namespace zfwstl
       for (auto cur = start.node; cur < finish.node; ++cur)
       {
         auto next = first;
-        zfwstl::advance(next, start.buffer_size);
+        zfwstl::advance(next, buf_size);
         zfwstl::uninitialized_copy(first, next, *cur);
         first = next;
       }
@@ -955,29 +1015,14 @@ namespace zfwstl
     template <class IIter>
     void insert_dispatch(iterator position, IIter first, IIter last, input_iterator_tag)
     {
-      if (last <= first)
-        return;
-      const size_type n = zfwstl::distance(first, last);
-      const size_type elems_before = position - start;
-      if (elems_before < (size() / 2))
-      {
-        require_capacity(n, true);
-      }
-      else
-      {
-        require_capacity(n, false);
-      }
-      position = start + elems_before;
-      auto cur = --last;
-      for (size_type i = 0; i < n; ++i, --cur)
-      {
-        insert(position, *cur);
-      }
+      // 输入迭代器：先收进临时 deque，再按前向迭代器区间一次插入
+      deque tmp(first, last);
+      insert_dispatch(position, tmp.begin(), tmp.end(), forward_iterator_tag{});
     }
     template <class FIter>
     void insert_dispatch(iterator position, FIter first, FIter last, forward_iterator_tag)
     {
-      if (last <= first)
+      if (first == last)
         return;
       const size_type n = zfwstl::distance(first, last);
       if (position.cur == start.cur)
@@ -994,7 +1039,7 @@ namespace zfwstl
           if (new_begin.node != start.node)
             for (map_pointer n = new_begin.node; n <= start.node - 1; ++n)
             {
-              data_allocator::deallocate(*n, start.buffer_size);
+              deallocate_node(*n);
               *n = nullptr;
             }
           throw;
@@ -1014,7 +1059,7 @@ namespace zfwstl
           if (new_end.node != finish.node)
             for (map_pointer n = finish.node + 1; n <= new_end.node; ++n)
             {
-              data_allocator::deallocate(*n, finish.buffer_size);
+              deallocate_node(*n);
               *n = nullptr;
             }
           throw;
@@ -1061,7 +1106,7 @@ namespace zfwstl
           if (new_begin.node != start.node)
             for (map_pointer n = new_begin.node; n <= start.node - 1; ++n)
             {
-              data_allocator::deallocate(*n, start.buffer_size);
+              deallocate_node(*n);
               *n = nullptr;
             }
 
@@ -1099,7 +1144,7 @@ namespace zfwstl
           if (new_end.node != finish.node)
             for (map_pointer n = finish.node + 1; n <= new_end.node; ++n)
             {
-              data_allocator::deallocate(*n, finish.buffer_size);
+              deallocate_node(*n);
               *n = nullptr;
             }
           throw;
@@ -1113,7 +1158,7 @@ namespace zfwstl
       auto len = size();
       if (elems_before < (len / 2))
       {
-        reserve_map_at_front();
+        require_capacity(n, true);
         // 原来的迭代器可能会失效
         auto old_begin = start;
         auto new_begin = start - n;
@@ -1143,7 +1188,7 @@ namespace zfwstl
           if (new_begin.node != start.node)
             for (map_pointer n = new_begin.node; n <= start.node - 1; ++n)
             {
-              data_allocator::deallocate(*n, start.buffer_size);
+              deallocate_node(*n);
               *n = nullptr;
             }
           throw;
@@ -1151,7 +1196,7 @@ namespace zfwstl
       }
       else
       {
-        reserve_map_at_back();
+        require_capacity(n, false);
         // 原来的迭代器可能会失效
         auto old_end = finish;
         auto new_end = finish + n;
@@ -1182,7 +1227,7 @@ namespace zfwstl
           if (new_end.node != finish.node)
             for (map_pointer n = finish.node + 1; n <= new_end.node; ++n)
             {
-              data_allocator::deallocate(*n, finish.buffer_size);
+              deallocate_node(*n);
               *n = nullptr;
             }
           throw;
@@ -1285,40 +1330,40 @@ namespace zfwstl
 
   //========================模板类外重载操作===============
   // 重载 zfwstl 的 swap
-  template <class U>
-  void swap(deque<U> &lhs, deque<U> &rhs) noexcept
+  template <class U, size_t BufSize, class Alloc>
+  void swap(deque<U, BufSize, Alloc> &lhs, deque<U, BufSize, Alloc> &rhs) noexcept
   {
     lhs.swap(rhs);
   }
-  template <class T>
-  bool operator==(const deque<T> &lhs, const deque<T> &rhs)
+  template <class T, size_t BufSize, class Alloc>
+  bool operator==(const deque<T, BufSize, Alloc> &lhs, const deque<T, BufSize, Alloc> &rhs)
   {
     return lhs.size() == rhs.size() &&
            zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
-  template <typename T>
-  bool operator!=(const deque<T> &lhs, const deque<T> &rhs)
+  template <class T, size_t BufSize, class Alloc>
+  bool operator!=(const deque<T, BufSize, Alloc> &lhs, const deque<T, BufSize, Alloc> &rhs)
   {
     return !(lhs == rhs);
   }
-  template <class T>
-  bool operator<(const deque<T> &lhs, const deque<T> &rhs)
+  template <class T, size_t BufSize, class Alloc>
+  bool operator<(const deque<T, BufSize, Alloc> &lhs, const deque<T, BufSize, Alloc> &rhs)
   {
     return zfwstl::lexicographical_compare(
         lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
   }
-  template <class T>
-  bool operator>(const deque<T> &lhs, const deque<T> &rhs)
+  template <class T, size_t BufSize, class Alloc>
+  bool operator>(const deque<T, BufSize, Alloc> &lhs, const deque<T, BufSize, Alloc> &rhs)
   {
     return rhs < lhs;
   }
-  template <class T>
-  bool operator<=(const deque<T> &lhs, const deque<T> &rhs)
+  template <class T, size_t BufSize, class Alloc>
+  bool operator<=(const deque<T, BufSize, Alloc> &lhs, const deque<T, BufSize, Alloc> &rhs)
   {
     return !(rhs < lhs);
   }
-  template <class T>
-  bool operator>=(const deque<T> &lhs, const deque<T> &rhs)
+  template <class T, size_t BufSize, class Alloc>
+  bool operator>=(const deque<T, BufSize, Alloc> &lhs, const deque<T, BufSize, Alloc> &rhs)
   {
     return !(lhs < rhs);
   }
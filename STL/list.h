@@ -6,6 +6,7 @@
  */
 #include <cstddef>                       //for size_t, ptrdiff_t
 #include "../src/memory/allocator.h"     //标准空间配置器
+#include "../src/memory/alloc.h"         //内存池 alloc
 #include "../src/iterator.h"             // for bidirectional_iterator_tag, distance
 #include "../src/exceptdef.h"            //for MYSTL_DEBUG, MYSTL_DEBUG
 #include "../src/functional.h"           //函数对象 less<T>()
@@ -56,6 +57,7 @@ namespace zfwstl
     __list_iterator(link_type x) : node(x) {}
     __list_iterator() {}
     __list_iterator(const iterator &x) : node(x.node) {}
+    self &operator=(const self &) = default;
 
     /**
      * 检查当前迭代器（*this）是否与另一个迭代器（x）相等
@@ -102,16 +104,17 @@ namespace zfwstl
   };
 
   //=========================list=========================
-  template <class T /*,class Alloc=alloc*/>
+  // Alloc: 原始内存配置器，节点型容器默认使用内存池 alloc，每个节点不再单独调用 ::operator new
+  template <class T, class Alloc = zfwstl::alloc>
   class list
   {
   protected:
     typedef __list_node<T> list_node;
-    typedef zfwstl::simple_allocator<list_node /* , Alloc */> list_node_allocator; // 专属之空间配置器，每次分配一个节点大小
+    typedef zfwstl::simple_allocator<list_node, Alloc> list_node_allocator; // 专属之空间配置器，每次分配一个节点大小
   public:
     //  专属空间配置器
-    typedef zfwstl::simple_allocator<T> data_allocator;
-    typedef zfwstl::simple_allocator<T> allocator_type;
+    typedef zfwstl::simple_allocator<T, Alloc> data_allocator;
+    typedef zfwstl::simple_allocator<T, Alloc> allocator_type;
     // list 的嵌套型别定义
     typedef typename allocator_type::value_type value_type;
     typedef typename allocator_type::pointer pointer;
@@ -128,8 +131,8 @@ namespace zfwstl
     typedef zfwstl::reverse_iterator<const_iterator> const_reverse_iterator;
 
     allocator_type get_allocator() { return data_allocator(); }
-    template <class U>
-    friend void swap(list<U> &lhs, list<U> &rhs) noexcept;
+    template <class U, class A>
+    friend void swap(list<U, A> &lhs, list<U, A> &rhs) noexcept;
 
   private:
     link_type node;  // 只要一个指针，便可表示整个环状双向链表 [就是空白节点]
@@ -680,8 +683,8 @@ namespace zfwstl
        * 它避免了随机访问，而链表的随机访问效率较低。
        * 通过使用链表的 splice 和 swap 操作，算法能够有效地对链表进行排序
        */
-      list<T> carry;       // 临时链表，用于存储从主链表中取出的元素
-      list<T> counter[64]; // 一个包含64个链表的数组 counter，用于基数排序中的桶（bucket）
+      list carry;          // 临时链表，用于存储从主链表中取出的元素
+      list counter[64];    // 一个包含64个链表的数组 counter，用于基数排序中的桶（bucket）
       int fill = 0;        // 一个计数器, 用于记录 counter 数组中有多少个链表非空
       while (!empty())
       {
@@ -772,20 +775,20 @@ namespace zfwstl
 
   //========================模板类外重载操作===============
   // 重载 zfwstl 的 swap
-  template <class U>
-  void swap(list<U> &lhs, list<U> &rhs) noexcept
+  template <class U, class Alloc>
+  void swap(list<U, Alloc> &lhs, list<U, Alloc> &rhs) noexcept
   {
     lhs.swap(rhs);
   }
-  template <typename T>
-  bool operator==(const list<T> &lhs, const list<T> &rhs)
+  template <class T, class Alloc>
+  bool operator==(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs)
   {
     return lhs.size() == rhs.size() &&
            zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
 
-  template <typename T>
-  bool operator!=(const list<T> &lhs, const list<T> &rhs)
+  template <class T, class Alloc>
+  bool operator!=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs)
   {
     return !(lhs == rhs);
   }
@@ -3,17 +3,20 @@
 /**
  * 优先级队列(权值高先出)
  * 属于container adapter
+ * 底层为 D 叉堆，叉数 Arity 缺省为 2；元素较小且个数多时取 4 或 8 可减少树高与缓存未命中(见 heap_algo.h 的 dary_*_heap)
+ * 整数优先级且取出的优先级单调不减(如事件调度)时，可使用 radix_heap.h 中的 radix_heap
  */
 #include <cstddef> //for size_t, ptrdiff_t
 #include "vector.h"
 #include "../src/functional.h"           //for less
-#include "../src/algorithms/heap_algo.h" //for push_heap, pop_heap, sort_heap, make_heap
+#include "../src/algorithms/heap_algo.h" //for dary_push_heap, dary_pop_heap, dary_make_heap
 #include "../src/iterator.h"             //for is_input_iterator
 #include "../src/util.h"                 //for move()
 namespace zfwstl
 {
 
-  template <class T, class Container = zfwstl::vector<T>, class Compare = zfwstl::less<typename Container::value_type>>
+  template <class T, class Container = zfwstl::vector<T>, class Compare = zfwstl::less<typename Container::value_type>,
+            size_t Arity = 2>
   class priority_queue
   {
   public:
@@ -30,6 +33,7 @@ namespace zfwstl
     typedef typename Container::const_reference const_reference;
     static_assert(std::is_same<T, value_type>::value,
                   "the value_type of Container should be same with T");
+    static_assert(Arity >= 2, "the arity of priority_queue should be at least 2");
 
   private:
     container_type c;   // 底层容器
@@ -42,46 +46,46 @@ namespace zfwstl
     explicit priority_queue(size_type n)
         : c(n)
     {
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
     }
     priority_queue(size_type n, const value_type &value) : c(n, value)
     {
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
     }
     template <class InputIter, typename std::enable_if<
                                    zfwstl::is_input_iterator<InputIter>::value, int>::type = 0>
-    priority_queue(InputIter first, InputIter last, const Compare &x) : c(first, last), comp(x) { zfwstl::make_heap(c.begin(), c.end(), comp); }
+    priority_queue(InputIter first, InputIter last, const Compare &x) : c(first, last), comp(x) { zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp); }
     template <class InputIter, typename std::enable_if<
                                    zfwstl::is_input_iterator<InputIter>::value, int>::type = 0>
     priority_queue(InputIter first, InputIter last) : c(first, last)
     {
       MYSTL_DEBUG(!(last < first));
-      make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
     }
     priority_queue(std::initializer_list<T> ilist)
         : c(ilist)
     {
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
     }
     priority_queue(const Container &s)
         : c(s)
     {
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
     }
     priority_queue(Container &&s)
         : c(zfwstl::move(s))
     {
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
     }
     priority_queue(const priority_queue &rhs)
         : c(rhs.c), comp(rhs.comp)
     {
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
     }
     priority_queue(priority_queue &&rhs)
         : c(zfwstl::move(rhs.c)), comp(rhs.comp)
     {
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
     }
     ~priority_queue() = default;
     //=================operator操作运算符重载=====================
@@ -89,21 +93,21 @@ namespace zfwstl
     {
       c = rhs.c;
       comp = rhs.comp;
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
       return *this;
     }
     priority_queue &operator=(priority_queue &&rhs)
     {
       c = zfwstl::move(rhs.c);
       comp = rhs.comp;
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
       return *this;
     }
     priority_queue &operator=(std::initializer_list<T> ilist)
     {
       c = ilist;
       comp = value_compare();
-      zfwstl::make_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_make_heap<Arity>(c.begin(), c.end(), comp);
       return *this;
     }
 
@@ -119,7 +123,7 @@ namespace zfwstl
       try
       {
         c.push_back(x);
-        zfwstl::push_heap(c.begin(), c.end(), comp);
+        zfwstl::dary_push_heap<Arity>(c.begin(), c.end(), comp);
       }
       catch (...)
       {
@@ -131,7 +135,7 @@ namespace zfwstl
       try
       {
         c.push_back(zfwstl::move(x));
-        zfwstl::push_heap(c.begin(), c.end(), comp);
+        zfwstl::dary_push_heap<Arity>(c.begin(), c.end(), comp);
       }
       catch (...)
       {
@@ -142,7 +146,7 @@ namespace zfwstl
     {
       try
       {
-        pop_heap(c.begin(), c.end(), comp);
+        zfwstl::dary_pop_heap<Arity>(c.begin(), c.end(), comp);
         c.pop_back();
       }
       catch (...)
@@ -154,7 +158,7 @@ namespace zfwstl
     void emplace(Args &&...args)
     {
       c.emplace_back(zfwstl::forward<Args>(args)...);
-      zfwstl::push_heap(c.begin(), c.end(), comp);
+      zfwstl::dary_push_heap<Arity>(c.begin(), c.end(), comp);
     }
     void clear()
     {
@@ -169,24 +173,24 @@ namespace zfwstl
     }
   };
 
-  template <class T, class Container, class Compare>
-  bool operator==(priority_queue<T, Container, Compare> &lhs,
-                  priority_queue<T, Container, Compare> &rhs)
+  template <class T, class Container, class Compare, size_t Arity>
+  bool operator==(priority_queue<T, Container, Compare, Arity> &lhs,
+                  priority_queue<T, Container, Compare, Arity> &rhs)
   {
     return lhs == rhs;
   }
 
-  template <class T, class Container, class Compare>
-  bool operator!=(priority_queue<T, Container, Compare> &lhs,
-                  priority_queue<T, Container, Compare> &rhs)
+  template <class T, class Container, class Compare, size_t Arity>
+  bool operator!=(priority_queue<T, Container, Compare, Arity> &lhs,
+                  priority_queue<T, Container, Compare, Arity> &rhs)
   {
     return lhs != rhs;
   }
 
   // 重载 zfwstl 的 swap
-  template <class T, class Container, class Compare>
-  void swap(priority_queue<T, Container, Compare> &lhs,
-            priority_queue<T, Container, Compare> &rhs) noexcept(noexcept(lhs.swap(rhs)))
+  template <class T, class Container, class Compare, size_t Arity>
+  void swap(priority_queue<T, Container, Compare, Arity> &lhs,
+            priority_queue<T, Container, Compare, Arity> &rhs) noexcept(noexcept(lhs.swap(rhs)))
   {
     lhs.swap(rhs);
   }
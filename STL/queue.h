@@ -2,7 +2,7 @@
 #define ZFWSTL_QUEUE_H_
 /**
  * 队列(FIFO 先进先出)
- * 属于container adapter
+ * 属于container adapter；不做同步，线程间传递数据用 ring_queue.h 中的 spsc_queue / mpmc_queue
  */
 #include <cstddef>       //for size_t, ptrdiff_t
 #include "../src/util.h" //for move()
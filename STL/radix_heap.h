@@ -0,0 +1,127 @@
+#ifndef ZFWSTL_RADIX_HEAP_H_
+#define ZFWSTL_RADIX_HEAP_H_
+/**
+ * radix_heap: 单调基数堆(monotone radix heap)，键为无符号整数的最小堆，每个元素带一个值
+ * 要求单调：放入的键不小于最近一次取出的键 last_key()(事件调度、Dijkstra 等场景满足)
+ * 按键与 last 的最高不同位分桶：桶 0 存放键等于 last 的元素，桶 i 存放最高不同位为第 i-1 位的元素
+ * 桶 0 为空时找出第一个非空桶，其中的最小键成为新的 last，该桶的元素全部下移到更低的桶
+ * 每个元素至多下移 sizeof(Key)*8 次，push 为 O(1)，pop 均摊 O(log C)(C 为键的取值范围)，且只比较整数，不调用比较函数
+ * 接口：push(key, value) / emplace(key, args...) / top() / top_key() / pop() / last_key() / size() / empty() / clear()
+ * top() 会先整理桶(把最小键的元素移到桶 0)，因此不是 const 成员函数
+ */
+#include <cstddef>            // for size_t
+#include <type_traits>        // for is_unsigned
+#include "vector.h"
+#include "../src/exceptdef.h" // for MYSTL_DEBUG, THROW_OUT_OF_RANGE_IF
+#include "../src/util.h"      // for pair, move, forward
+namespace zfwstl
+{
+  template <class Key, class T, class Alloc = zfwstl::new_alloc>
+  class radix_heap
+  {
+    static_assert(std::is_unsigned<Key>::value, "the key of radix_heap should be an unsigned integer");
+
+  public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef zfwstl::pair<Key, T> value_type;
+    typedef size_t size_type;
+    typedef const value_type &const_reference;
+
+  private:
+    enum : size_t
+    {
+      key_bits = sizeof(Key) * 8
+    };
+    typedef zfwstl::vector<value_type, Alloc> bucket_type;
+
+    bucket_type buckets[key_bits + 1];
+    Key last;      // 最近一次整理时的最小键
+    size_type cnt; // 元素个数
+
+  public:
+    radix_heap() : last(0), cnt(0) {}
+
+    bool empty() const noexcept { return cnt == 0; }
+    size_type size() const noexcept { return cnt; }
+    Key last_key() const noexcept { return last; }
+
+    void push(Key key, const T &value) { emplace(key, value); }
+    void push(Key key, T &&value) { emplace(key, zfwstl::move(value)); }
+    template <class... Args>
+    void emplace(Key key, Args &&...args)
+    {
+      THROW_OUT_OF_RANGE_IF(key < last, "radix_heap<Key, T>::push: key is smaller than the last popped key");
+      buckets[bucket_of(key)].push_back(value_type(key, T(zfwstl::forward<Args>(args)...)));
+      ++cnt;
+    }
+
+    // 最小键的元素；堆不能为空
+    const_reference top()
+    {
+      MYSTL_DEBUG(!empty());
+      pull();
+      return buckets[0].back();
+    }
+    Key top_key()
+    {
+      MYSTL_DEBUG(!empty());
+      pull();
+      return last;
+    }
+    void pop()
+    {
+      MYSTL_DEBUG(!empty());
+      pull();
+      buckets[0].pop_back();
+      --cnt;
+    }
+    // 清空后 last 回到 0，可以重新放入任意键
+    void clear()
+    {
+      for (size_t i = 0; i <= key_bits; ++i)
+        buckets[i].clear();
+      last = 0;
+      cnt = 0;
+    }
+
+  private:
+    // 键与 last 的最高不同位 + 1，相同时为 0
+    size_type bucket_of(Key key) const noexcept
+    {
+      Key x = key ^ last;
+#if defined(__GNUC__) || defined(__clang__)
+      if (x == 0)
+        return 0;
+      if (sizeof(Key) <= sizeof(unsigned))
+        return sizeof(unsigned) * 8 - static_cast<size_type>(__builtin_clz(static_cast<unsigned>(x)));
+      return sizeof(unsigned long long) * 8 - static_cast<size_type>(__builtin_clzll(static_cast<unsigned long long>(x)));
+#else
+      size_type n = 0;
+      for (; x != 0; x >>= 1)
+        ++n;
+      return n;
+#endif
+    }
+
+    // 桶 0 为空时，以第一个非空桶中的最小键为新的 last，把该桶的元素分到更低的桶
+    void pull()
+    {
+      if (!buckets[0].empty())
+        return;
+      size_t i = 1;
+      while (buckets[i].empty())
+        ++i;
+      bucket_type &b = buckets[i];
+      Key min_key = b[0].first;
+      for (size_t k = 1; k < b.size(); ++k)
+        if (b[k].first < min_key)
+          min_key = b[k].first;
+      last = min_key;
+      for (size_t k = 0; k < b.size(); ++k)
+        buckets[bucket_of(b[k].first)].push_back(zfwstl::move(b[k])); // 新的桶号一定小于 i
+      b.clear();
+    }
+  };
+} // namespace zfwstl
+#endif // !ZFWSTL_RADIX_HEAP_H_
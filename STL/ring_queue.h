@@ -0,0 +1,346 @@
+#ifndef ZFWSTL_RING_QUEUE_H_
+#define ZFWSTL_RING_QUEUE_H_
+/**
+ * 定长的无锁环形队列(ring buffer)，用于线程间传递数据，替代 mutex + queue
+ * spsc_queue<T>: 单生产者单消费者。head 只由消费者写、tail 只由生产者写，各自再缓存一份对方的下标，
+ *                只有缓存的下标显示队列满(空)时才去读对方的缓存行
+ * mpmc_queue<T>: 多生产者多消费者，Dmitry Vyukov 的有界队列：每个槽带一个序号 seq，
+ *                seq == pos 表示槽空闲可写，seq == pos + 1 表示已写入可读；
+ *                生产者/消费者用 CAS 抢占 enqueue_pos / dequeue_pos，之后独占该槽，不需要加锁
+ * 容量在构造时给定，向上取整为 2 的幂(mpmc 至少为 2)；两种队列都不可复制、不可移动
+ * 接口：
+ *   try_push(x) / try_emplace(args...)：队列满时返回 false
+ *   try_pop(x)：队列空时返回 false，否则把队首元素移动赋值给 x
+ *   push_n(first, n) / pop_n(result, n)：批量版本，返回实际放入/取出的个数；
+ *                                       spsc 一批只发布一次下标，mpmc 一次 CAS 抢占连续的一段槽
+ *   size_approx()：并发时只是一个近似值
+ * 生产者和消费者的下标分别放在独立的缓存行上(ZFWSTL_CACHE_LINE)，避免伪共享
+ * 注意：mpmc_queue 抢占槽之后才构造元素，元素的构造(复制/移动)不应抛出异常，否则该槽永远不会变为可读
+ */
+#include <cstddef>                   // for size_t
+#include <atomic>                    // for std::atomic
+#include <type_traits>               // for aligned_storage
+#include "../src/memory/allocator.h" // 标准空间配置器
+#include "../src/memory/construct.h" // for construct(), destroy()
+#include "../src/exceptdef.h"        // for THROW_LENGTH_ERROR_IF
+#include "../src/util.h"             // for move(), forward(), ZFWSTL_CACHE_LINE
+namespace zfwstl
+{
+  // 向上取整为 2 的幂
+  inline size_t ring_queue_capacity(size_t n)
+  {
+    size_t cap = 1;
+    while (cap < n)
+      cap <<= 1;
+    return cap;
+  }
+
+  //======================================spsc_queue===========================================
+  template <class T, class Alloc = zfwstl::new_alloc>
+  class spsc_queue
+  {
+  public:
+    typedef zfwstl::simple_allocator<T, Alloc> data_allocator;
+    typedef T value_type;
+    typedef size_t size_type;
+
+  private:
+    // 只读的部分：两端都会读，构造后不再修改
+    T *buf;
+    size_type mask;
+    // 消费者写的部分
+    alignas(ZFWSTL_CACHE_LINE) std::atomic<size_type> head;
+    size_type tail_cache; // 消费者看到的 tail
+    // 生产者写的部分
+    alignas(ZFWSTL_CACHE_LINE) std::atomic<size_type> tail;
+    size_type head_cache; // 生产者看到的 head；alignas 使对象大小补齐到整缓存行，不与其后的对象共享
+
+  public:
+    explicit spsc_queue(size_type n)
+        : buf(nullptr), mask(0), head(0), tail_cache(0), tail(0), head_cache(0)
+    {
+      THROW_LENGTH_ERROR_IF(n == 0 || n > (static_cast<size_type>(-1) >> 2) / sizeof(T),
+                            "spsc_queue<T>'s capacity is invalid");
+      const size_type cap = ring_queue_capacity(n);
+      buf = data_allocator::allocate(cap);
+      mask = cap - 1;
+    }
+    spsc_queue(const spsc_queue &) = delete;
+    spsc_queue &operator=(const spsc_queue &) = delete;
+    ~spsc_queue()
+    {
+      for (size_type i = head.load(std::memory_order_relaxed), t = tail.load(std::memory_order_relaxed); i != t; ++i)
+        zfwstl::destroy(buf + (i & mask));
+      data_allocator::deallocate(buf, mask + 1);
+    }
+
+    size_type capacity() const noexcept { return mask + 1; }
+    size_type size_approx() const noexcept
+    {
+      const size_type h = head.load(std::memory_order_acquire);
+      const size_type t = tail.load(std::memory_order_acquire);
+      return t - h <= mask + 1 ? t - h : 0; // 两次读之间对方可能已前进
+    }
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+
+    // 生产者调用
+    template <class... Args>
+    bool try_emplace(Args &&...args)
+    {
+      const size_type t = tail.load(std::memory_order_relaxed);
+      if (t - head_cache > mask)
+      {
+        head_cache = head.load(std::memory_order_acquire);
+        if (t - head_cache > mask)
+          return false;
+      }
+      zfwstl::construct(buf + (t & mask), zfwstl::forward<Args>(args)...); // 抛出异常时尚未发布，队列不变
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+    }
+    bool try_push(const value_type &x) { return try_emplace(x); }
+    bool try_push(value_type &&x) { return try_emplace(zfwstl::move(x)); }
+
+    // 从 first 开始依次放入至多 n 个元素，返回放入的个数；整批只发布一次 tail
+    template <class InputIter>
+    size_type push_n(InputIter first, size_type n)
+    {
+      const size_type t = tail.load(std::memory_order_relaxed);
+      size_type room = mask + 1 - (t - head_cache);
+      if (room < n)
+      {
+        head_cache = head.load(std::memory_order_acquire);
+        room = mask + 1 - (t - head_cache);
+      }
+      const size_type cnt = n < room ? n : room;
+      size_type i = 0;
+      try
+      {
+        for (; i < cnt; ++i, ++first)
+          zfwstl::construct(buf + ((t + i) & mask), *first);
+      }
+      catch (...)
+      {
+        tail.store(t + i, std::memory_order_release); // 已构造的部分照常发布
+        throw;
+      }
+      tail.store(t + cnt, std::memory_order_release);
+      return cnt;
+    }
+
+    // 消费者调用
+    bool try_pop(value_type &x)
+    {
+      const size_type h = head.load(std::memory_order_relaxed);
+      if (h == tail_cache)
+      {
+        tail_cache = tail.load(std::memory_order_acquire);
+        if (h == tail_cache)
+          return false;
+      }
+      T *p = buf + (h & mask);
+      x = zfwstl::move(*p);
+      zfwstl::destroy(p);
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+
+    // 至多取出 n 个元素依次写入 result，返回取出的个数；整批只发布一次 head
+    template <class OutputIter>
+    size_type pop_n(OutputIter result, size_type n)
+    {
+      const size_type h = head.load(std::memory_order_relaxed);
+      size_type avail = tail_cache - h;
+      if (avail < n)
+      {
+        tail_cache = tail.load(std::memory_order_acquire);
+        avail = tail_cache - h;
+      }
+      const size_type cnt = n < avail ? n : avail;
+      for (size_type i = 0; i < cnt; ++i, ++result)
+      {
+        T *p = buf + ((h + i) & mask);
+        *result = zfwstl::move(*p);
+        zfwstl::destroy(p);
+      }
+      head.store(h + cnt, std::memory_order_release);
+      return cnt;
+    }
+  };
+
+  //======================================mpmc_queue===========================================
+  template <class T, class Alloc = zfwstl::new_alloc>
+  class mpmc_queue
+  {
+  private:
+    struct cell
+    {
+      std::atomic<size_t> seq;
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+      T *value() { return reinterpret_cast<T *>(&storage); }
+    };
+
+  public:
+    typedef zfwstl::simple_allocator<cell, Alloc> cell_allocator;
+    typedef T value_type;
+    typedef size_t size_type;
+
+  private:
+    cell *buf;
+    size_type mask;
+    alignas(ZFWSTL_CACHE_LINE) std::atomic<size_type> enqueue_pos;
+    alignas(ZFWSTL_CACHE_LINE) std::atomic<size_type> dequeue_pos;
+
+  public:
+    explicit mpmc_queue(size_type n)
+        : buf(nullptr), mask(0), enqueue_pos(0), dequeue_pos(0)
+    {
+      THROW_LENGTH_ERROR_IF(n == 0 || n > (static_cast<size_type>(-1) >> 2) / sizeof(cell),
+                            "mpmc_queue<T>'s capacity is invalid");
+      const size_type cap = ring_queue_capacity(n < 2 ? 2 : n); // 容量为 1 时无法区分“空闲”与“已写入”
+      buf = cell_allocator::allocate(cap);
+      for (size_type i = 0; i < cap; ++i)
+        ::new (static_cast<void *>(&buf[i].seq)) std::atomic<size_type>(i);
+      mask = cap - 1;
+    }
+    mpmc_queue(const mpmc_queue &) = delete;
+    mpmc_queue &operator=(const mpmc_queue &) = delete;
+    ~mpmc_queue()
+    {
+      for (size_type i = dequeue_pos.load(std::memory_order_relaxed), e = enqueue_pos.load(std::memory_order_relaxed);
+           i != e; ++i)
+        zfwstl::destroy(buf[i & mask].value());
+      cell_allocator::deallocate(buf, mask + 1);
+    }
+
+    size_type capacity() const noexcept { return mask + 1; }
+    size_type size_approx() const noexcept
+    {
+      const size_type d = dequeue_pos.load(std::memory_order_acquire);
+      const size_type e = enqueue_pos.load(std::memory_order_acquire);
+      return e - d <= mask + 1 ? e - d : 0;
+    }
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+
+    template <class... Args>
+    bool try_emplace(Args &&...args)
+    {
+      size_type pos = enqueue_pos.load(std::memory_order_relaxed);
+      cell *c;
+      for (;;)
+      {
+        c = &buf[pos & mask];
+        const size_type seq = c->seq.load(std::memory_order_acquire);
+        const ptrdiff_t diff = static_cast<ptrdiff_t>(seq - pos);
+        if (diff == 0)
+        { // 槽空闲，抢占 pos
+          if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (diff < 0) // 槽里还是上一圈的元素：队列满
+          return false;
+        else // 被别的生产者抢先
+          pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+      zfwstl::construct(c->value(), zfwstl::forward<Args>(args)...);
+      c->seq.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+    bool try_push(const value_type &x) { return try_emplace(x); }
+    bool try_push(value_type &&x) { return try_emplace(zfwstl::move(x)); }
+
+    bool try_pop(value_type &x)
+    {
+      size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+      cell *c;
+      for (;;)
+      {
+        c = &buf[pos & mask];
+        const size_type seq = c->seq.load(std::memory_order_acquire);
+        const ptrdiff_t diff = static_cast<ptrdiff_t>(seq - (pos + 1));
+        if (diff == 0)
+        { // 槽已写入，抢占 pos
+          if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (diff < 0) // 槽尚未写入：队列空
+          return false;
+        else
+          pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+      x = zfwstl::move(*c->value());
+      zfwstl::destroy(c->value());
+      c->seq.store(pos + mask + 1, std::memory_order_release); // 留给下一圈的生产者
+      return true;
+    }
+
+    // 一次 CAS 抢占从 enqueue_pos 开始连续空闲的至多 n 个槽，返回放入的个数
+    // 抢占成功后其间的槽只属于本线程：别的生产者必须先推进 enqueue_pos 才能写它们
+    template <class InputIter>
+    size_type push_n(InputIter first, size_type n)
+    {
+      if (n == 0)
+        return 0;
+      size_type pos = enqueue_pos.load(std::memory_order_relaxed);
+      size_type cnt;
+      for (;;)
+      {
+        cnt = 0;
+        while (cnt < n && buf[(pos + cnt) & mask].seq.load(std::memory_order_acquire) == pos + cnt)
+          ++cnt;
+        if (cnt == 0)
+        {
+          const size_type seq = buf[pos & mask].seq.load(std::memory_order_acquire);
+          if (static_cast<ptrdiff_t>(seq - pos) < 0)
+            return 0; // 队列满
+          pos = enqueue_pos.load(std::memory_order_relaxed);
+          continue;
+        }
+        if (enqueue_pos.compare_exchange_weak(pos, pos + cnt, std::memory_order_relaxed))
+          break;
+      }
+      for (size_type i = 0; i < cnt; ++i, ++first)
+      {
+        cell *c = &buf[(pos + i) & mask];
+        zfwstl::construct(c->value(), *first);
+        c->seq.store(pos + i + 1, std::memory_order_release);
+      }
+      return cnt;
+    }
+
+    // 一次 CAS 抢占从 dequeue_pos 开始连续已写入的至多 n 个槽，依次写入 result，返回取出的个数
+    template <class OutputIter>
+    size_type pop_n(OutputIter result, size_type n)
+    {
+      if (n == 0)
+        return 0;
+      size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+      size_type cnt;
+      for (;;)
+      {
+        cnt = 0;
+        while (cnt < n && buf[(pos + cnt) & mask].seq.load(std::memory_order_acquire) == pos + cnt + 1)
+          ++cnt;
+        if (cnt == 0)
+        {
+          const size_type seq = buf[pos & mask].seq.load(std::memory_order_acquire);
+          if (static_cast<ptrdiff_t>(seq - (pos + 1)) < 0)
+            return 0; // 队列空
+          pos = dequeue_pos.load(std::memory_order_relaxed);
+          continue;
+        }
+        if (dequeue_pos.compare_exchange_weak(pos, pos + cnt, std::memory_order_relaxed))
+          break;
+      }
+      for (size_type i = 0; i < cnt; ++i, ++result)
+      {
+        cell *c = &buf[(pos + i) & mask];
+        *result = zfwstl::move(*c->value());
+        zfwstl::destroy(c->value());
+        c->seq.store(pos + i + mask + 1, std::memory_order_release);
+      }
+      return cnt;
+    }
+  };
+} // namespace zfwstl
+#endif // !ZFWSTL_RING_QUEUE_H_
@@ -8,6 +8,7 @@
 #include <cstddef>                       //for size_t, ptrdiff_t
 #include "../src/iterator.h"             //for forward_iterator_tag
 #include "../src/memory/allocator.h"     //标准空间配置器
+#include "../src/memory/alloc.h"         //内存池 alloc
 #include "../src/algorithms/algorithm.h" //for equal()
 namespace zfwstl
 {
@@ -65,6 +66,7 @@ namespace zfwstl
     // 调用slist<T>::end()时会造成__slist_iterator(nullptr)，于是调用上述函数
     __slist_iterator() : __slist_iterator_base(nullptr) {}
     __slist_iterator(const iterator &x) : __slist_iterator_base(x.node) {}
+    self &operator=(const self &) = default;
 
     reference operator*() const { return static_cast<list_node *>(node)->data; } // ((list_node *)node)首先将node指针强制转换为list_node类型的指针
     pointer operator->() const { return &(operator*()); }                        // iterator->member通常用来访问迭代器当前指向的元素的成员
@@ -82,18 +84,19 @@ namespace zfwstl
     // slist单向链表没有opertator--
   };
 
-  template <class T /*,class Alloc=alloc*/>
+  // Alloc: 原始内存配置器，节点型容器默认使用内存池 alloc，每个节点不再单独调用 ::operator new
+  template <class T, class Alloc = zfwstl::alloc>
   class slist
   {
   protected:
     typedef __slist_node<T> list_node;
     typedef __slist_node_base list_node_base;
     typedef __slist_iterator_base iterator_base;
-    typedef zfwstl::simple_allocator<list_node /* , Alloc */> list_node_allocator; // 专属之空间配置器，每次分配一个节点大小
+    typedef zfwstl::simple_allocator<list_node, Alloc> list_node_allocator; // 专属之空间配置器，每次分配一个节点大小
   public:
     //  专属空间配置器
-    typedef zfwstl::simple_allocator<T> data_allocator;
-    typedef zfwstl::simple_allocator<T> allocator_type;
+    typedef zfwstl::simple_allocator<T, Alloc> data_allocator;
+    typedef zfwstl::simple_allocator<T, Alloc> allocator_type;
     // list 的嵌套型别定义
     typedef typename allocator_type::value_type value_type;
     typedef typename allocator_type::pointer pointer;
@@ -108,8 +111,8 @@ namespace zfwstl
     typedef __slist_iterator<T, const T &, const T *> const_iterator;
 
     allocator_type get_allocator() { return data_allocator(); }
-    template <class U>
-    friend void swap(slist<U> &lhs, slist<U> &rhs) noexcept;
+    template <class U, class A>
+    friend void swap(slist<U, A> &lhs, slist<U, A> &rhs) noexcept;
 
   private:
     static list_node *create_node(const value_type &x)
@@ -270,22 +273,22 @@ namespace zfwstl
     }
   };
   //========================模板类外重载操作===============
-  template <class T>
-  bool operator==(const slist<T> &lhs, const slist<T> &rhs)
+  template <class T, class Alloc>
+  bool operator==(const slist<T, Alloc> &lhs, const slist<T, Alloc> &rhs)
   {
     return lhs.size() == rhs.size() &&
            zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
 
-  template <class T>
-  bool operator!=(const slist<T> &lhs, const slist<T> &rhs)
+  template <class T, class Alloc>
+  bool operator!=(const slist<T, Alloc> &lhs, const slist<T, Alloc> &rhs)
   {
     return !(lhs == rhs);
   }
 
   // 重载 zfwstl 的 swap
-  template <class U>
-  void swap(slist<U> &lhs, slist<U> &rhs) noexcept
+  template <class U, class Alloc>
+  void swap(slist<U, Alloc> &lhs, slist<U, Alloc> &rhs) noexcept
   {
     lhs.swap(rhs);
   }
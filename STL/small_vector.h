@@ -0,0 +1,594 @@
+#ifndef ZFWSTL_SMALL_VECTOR_H_
+#define ZFWSTL_SMALL_VECTOR_H_
+/**
+ * small_vector<T, N>: 带 N 个元素内嵌缓冲区的 vector
+ * 元素个数不超过 N 时存放在对象内部，不配置内存；超过 N 后搬到 data_allocator 配置的堆空间，之后与 vector 相同
+ * 接口与 vector 一致，迭代器为原生指针：Random Access iterators
+ * 注意：
+ *   内嵌存储时移动构造/移动赋值/swap 需要逐个移动元素，是 O(N) 而不是交换指针；
+ *   被移动的对象为空并回到内嵌缓冲区，可继续使用
+ *   容量只增不减，clear() 后不会回到内嵌缓冲区(与 vector 不释放内存一致)
+ */
+#include <initializer_list>          // for initializer_list
+#include <cstddef>                   // for size_t, ptrdiff_t
+#include <type_traits>               // for aligned_storage, enable_if
+#include "../src/memory/allocator.h" // 标准空间配置器
+#include "../src/memory/construct.h" // for construct(), destroy()
+#include "../src/exceptdef.h"            // for 宏MYSTL_DEBUG, THROW_LENGTH_ERROR_IF
+#include "../src/memory/unintialized.h"  // for uninitialized_fill_n() uninitialized_copy(), uninitialized_move_if_noexcept()
+#include "../src/algorithms/algorithm.h" // for lexicographical_compare(), equal(), max(), move(), move_backward(), fill()
+#include "../src/iterator.h"             // for reverse_iterator, iterator_category(), distance(), is_input_iterator
+namespace zfwstl
+{
+  template <class T, size_t N = 8, class Alloc = zfwstl::new_alloc>
+  class small_vector
+  {
+    static_assert(N > 0, "small_vector needs at least one inline element");
+
+  public:
+    //  专属空间配置器，只在溢出到堆上时使用
+    typedef zfwstl::simple_allocator<T, Alloc> data_allocator;
+    typedef zfwstl::simple_allocator<T, Alloc> allocator_type;
+    typedef typename allocator_type::value_type value_type;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::difference_type difference_type;
+
+    typedef value_type *iterator;
+    typedef const value_type *const_iterator;
+    typedef zfwstl::reverse_iterator<iterator> reverse_iterator;
+    typedef zfwstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    static const size_type inline_capacity = N;
+
+    allocator_type get_allocator() { return data_allocator(); }
+
+  private:
+    //[start, finish)，start 指向 buf 或堆空间
+    iterator start;
+    iterator finish;
+    iterator end_of_storage;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buf; // 内嵌缓冲区，不会自动构造元素
+
+    iterator inline_data() { return reinterpret_cast<iterator>(&buf); }
+    const_iterator inline_data() const { return reinterpret_cast<const_iterator>(&buf); }
+    void reset_inline()
+    {
+      start = finish = inline_data();
+      end_of_storage = start + N;
+    }
+
+  public:
+    small_vector() noexcept { reset_inline(); }
+    small_vector(size_type n, const T &value) { fill_init(n, value); }
+    small_vector(int n, const T &value) { fill_init(n, value); }
+    small_vector(long n, const T &value) { fill_init(n, value); }
+    explicit small_vector(size_type n) { fill_init(n, T()); }
+    small_vector(std::initializer_list<value_type> ilist)
+    {
+      range_init(ilist.begin(), ilist.end(), zfwstl::forward_iterator_tag{});
+    }
+    template <class Iter, typename std::enable_if<zfwstl::is_input_iterator<Iter>::value, int>::type = 0>
+    small_vector(Iter first, Iter last)
+    {
+      range_init(first, last, zfwstl::iterator_category(first));
+    }
+    small_vector(const small_vector &rhs)
+    {
+      range_init(rhs.start, rhs.finish, zfwstl::forward_iterator_tag{});
+    }
+    // 移动构造：rhs 在堆上则直接接管，否则逐个移动到自己的内嵌缓冲区(元素的移动构造可能抛出异常)
+    small_vector(small_vector &&rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+      reset_inline();
+      steal(rhs);
+    }
+    ~small_vector()
+    {
+      zfwstl::destroy(start, finish);
+      release();
+    }
+    //=================operator操作运算符重载=====================
+    small_vector &operator=(const small_vector &rhs)
+    {
+      if (this != &rhs)
+        assign(rhs.begin(), rhs.end());
+      return *this;
+    }
+    small_vector &operator=(small_vector &&rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+      if (this != &rhs)
+      {
+        zfwstl::destroy(start, finish);
+        release();
+        reset_inline();
+        steal(rhs);
+      }
+      return *this;
+    }
+    small_vector &operator=(std::initializer_list<value_type> ilist)
+    {
+      assign(ilist.begin(), ilist.end());
+      return *this;
+    }
+    // =================迭代器相关操作=====================
+    iterator begin() { return start; }
+    iterator end() { return finish; }
+    const_iterator begin() const { return start; }
+    const_iterator end() const { return finish; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator crend() const { return rend(); }
+
+    // 容量相关操作
+    size_type size() const { return static_cast<size_type>(finish - start); }
+    size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+    size_type capacity() const { return static_cast<size_type>(end_of_storage - start); }
+    bool empty() const { return start == finish; }
+    // 元素是否仍在内嵌缓冲区中
+    bool is_inline() const { return start == inline_data(); }
+    void reserve(size_type n)
+    {
+      if (capacity() < n)
+      {
+        THROW_LENGTH_ERROR_IF(n > max_size(),
+                              "n can not larger than max_size() in small_vector<T>::reserve(n)");
+        reallocate(n);
+      }
+    }
+    // 访问元素相关操作
+    reference front()
+    {
+      MYSTL_DEBUG(!empty());
+      return *start;
+    }
+    const_reference front() const
+    {
+      MYSTL_DEBUG(!empty());
+      return *start;
+    }
+    reference back()
+    {
+      MYSTL_DEBUG(!empty());
+      return *(finish - 1);
+    }
+    const_reference back() const
+    {
+      MYSTL_DEBUG(!empty());
+      return *(finish - 1);
+    }
+    reference operator[](size_type n)
+    {
+      MYSTL_DEBUG(n < size());
+      return *(start + n);
+    }
+    const_reference operator[](size_type n) const
+    {
+      MYSTL_DEBUG(n < size());
+      return *(start + n);
+    }
+    pointer data() noexcept { return start; }
+    const_pointer data() const noexcept { return start; }
+    reference at(size_type n)
+    {
+      THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T>::at() subscript out of range");
+      return (*this)[n];
+    }
+    const_reference at(size_type n) const
+    {
+      THROW_OUT_OF_RANGE_IF(!(n < size()), "small_vector<T>::at() subscript out of range");
+      return (*this)[n];
+    }
+    // =================修改容器相关操作=====================
+    void push_back(const T &x) { emplace_back(x); }
+    void push_back(T &&x) { emplace_back(zfwstl::move(x)); }
+    template <class... Args>
+    reference emplace_back(Args &&...args)
+    {
+      if (finish == end_of_storage)
+      {
+        // 先在新空间构造新元素再搬旧元素：args 可能引用本容器中的元素
+        const size_type old_size = size();
+        const size_type len = next_capacity(1);
+        iterator new_start = data_allocator::allocate(len);
+        try
+        {
+          zfwstl::construct(new_start + old_size, zfwstl::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+          data_allocator::deallocate(new_start, len);
+          throw;
+        }
+        relocate(finish, new_start, 1, len);
+        replace_storage(new_start, old_size + 1, len);
+      }
+      else
+      {
+        zfwstl::construct(finish, zfwstl::forward<Args>(args)...);
+        ++finish;
+      }
+      return *(finish - 1);
+    }
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args &&...args)
+    {
+      MYSTL_DEBUG(pos >= begin() && pos <= end());
+      iterator xpos = const_cast<iterator>(pos);
+      const size_type n = xpos - start;
+      if (xpos == finish)
+      {
+        emplace_back(zfwstl::forward<Args>(args)...);
+      }
+      else if (finish != end_of_storage)
+      {
+        value_type x_copy(zfwstl::forward<Args>(args)...); // 先构造：args 可能引用被挪动的元素
+        zfwstl::construct(finish, zfwstl::move(*(finish - 1)));
+        ++finish;
+        zfwstl::move_backward(xpos, finish - 2, finish - 1);
+        *xpos = zfwstl::move(x_copy);
+      }
+      else
+      {
+        const size_type len = next_capacity(1);
+        iterator new_start = data_allocator::allocate(len);
+        try
+        {
+          zfwstl::construct(new_start + n, zfwstl::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+          data_allocator::deallocate(new_start, len);
+          throw;
+        }
+        const size_type old_size = size();
+        relocate(xpos, new_start, 1, len);
+        replace_storage(new_start, old_size + 1, len);
+      }
+      return start + n;
+    }
+    iterator insert(const_iterator pos, const value_type &x) { return emplace(pos, x); }
+    iterator insert(const_iterator pos, value_type &&x) { return emplace(pos, zfwstl::move(x)); }
+    // 指定位置插入 n 个元素，元素初值 = x
+    iterator insert(const_iterator pos, size_type n, const value_type &x)
+    {
+      MYSTL_DEBUG(pos >= begin() && pos <= end());
+      iterator xpos = const_cast<iterator>(pos);
+      const size_type off = xpos - start;
+      if (n == 0)
+        return xpos;
+      const value_type x_copy = x; // 避免 x 是本容器的元素而被覆盖
+      if (size_type(end_of_storage - finish) >= n)
+      {
+        const size_type elems_after = finish - xpos;
+        iterator old_finish = finish;
+        if (elems_after > n)
+        {
+          zfwstl::uninitialized_move(finish - n, finish, finish);
+          finish += n;
+          zfwstl::move_backward(xpos, old_finish - n, old_finish);
+          zfwstl::fill(xpos, xpos + n, x_copy);
+        }
+        else
+        {
+          finish = zfwstl::uninitialized_fill_n(finish, n - elems_after, x_copy);
+          zfwstl::uninitialized_move(xpos, old_finish, finish);
+          finish += elems_after;
+          zfwstl::fill(xpos, old_finish, x_copy);
+        }
+      }
+      else
+      {
+        const size_type old_size = size();
+        const size_type len = next_capacity(n);
+        iterator new_start = data_allocator::allocate(len);
+        try
+        {
+          zfwstl::uninitialized_fill_n(new_start + off, n, x_copy);
+        }
+        catch (...)
+        {
+          data_allocator::deallocate(new_start, len);
+          throw;
+        }
+        relocate(xpos, new_start, n, len);
+        replace_storage(new_start, old_size + n, len);
+      }
+      return start + off;
+    }
+    // 指定位置插入 [first, last)，返回指向第一个新元素的迭代器
+    // 前向迭代器：先算出元素个数，空位只开一次；输入迭代器：逐个追加到尾部再 rotate 到插入位置
+    // 注意：[first, last) 不能是本容器中的元素
+    template <class Iter, typename std::enable_if<
+                              zfwstl::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last)
+    {
+      MYSTL_DEBUG(pos >= begin() && pos <= end());
+      const size_type off = pos - start;
+      range_insert(const_cast<iterator>(pos), first, last, zfwstl::iterator_category(first));
+      return start + off;
+    }
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+    {
+      return insert(pos, ilist.begin(), ilist.end());
+    }
+    void pop_back()
+    {
+      MYSTL_DEBUG(!empty());
+      --finish;
+      zfwstl::destroy(finish);
+    }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+      iterator xfirst = const_cast<iterator>(first);
+      if (first == last) // 空区间：避免元素移动赋值给自身
+        return xfirst;
+      iterator new_finish = zfwstl::move(const_cast<iterator>(last), finish, xfirst);
+      zfwstl::destroy(new_finish, finish);
+      finish = new_finish;
+      return xfirst;
+    }
+    iterator erase(const_iterator position)
+    {
+      MYSTL_DEBUG(position >= begin() && position < end());
+      return erase(position, position + 1);
+    }
+    void clear()
+    {
+      zfwstl::destroy(start, finish);
+      finish = start;
+    }
+    void swap(small_vector &rhs)
+    {
+      if (this == &rhs)
+        return;
+      if (!is_inline() && !rhs.is_inline())
+      {
+        zfwstl::swap(start, rhs.start);
+        zfwstl::swap(finish, rhs.finish);
+        zfwstl::swap(end_of_storage, rhs.end_of_storage);
+        return;
+      }
+      small_vector tmp(zfwstl::move(rhs));
+      rhs = zfwstl::move(*this);
+      *this = zfwstl::move(tmp);
+    }
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type &value)
+    {
+      if (new_size < size())
+        erase(begin() + new_size, end());
+      else
+        insert(end(), new_size - size(), value);
+    }
+    template <class Iter, typename std::enable_if<
+                              zfwstl::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last)
+    {
+      clear();
+      append_range(first, last, zfwstl::iterator_category(first));
+    }
+    void assign(size_type n, const value_type &value)
+    {
+      clear();
+      insert(end(), n, value);
+    }
+    void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
+
+  private:
+    // 构造函数中抛出异常时不会调用析构函数，先销毁已构造的元素、归还堆空间再重新抛出
+    void fill_init(size_type n, const T &value)
+    {
+      reset_inline();
+      try
+      {
+        reserve(n);
+        finish = zfwstl::uninitialized_fill_n(start, n, value);
+      }
+      catch (...)
+      {
+        zfwstl::destroy(start, finish);
+        release();
+        throw;
+      }
+    }
+    template <class Iter, class Tag>
+    void range_init(Iter first, Iter last, Tag tag)
+    {
+      reset_inline();
+      try
+      {
+        append_range(first, last, tag);
+      }
+      catch (...)
+      {
+        zfwstl::destroy(start, finish);
+        release();
+        throw;
+      }
+    }
+    template <class IIter>
+    void append_range(IIter first, IIter last, zfwstl::input_iterator_tag)
+    {
+      for (; first != last; ++first)
+        emplace_back(*first);
+    }
+    template <class FIter>
+    void append_range(FIter first, FIter last, zfwstl::forward_iterator_tag)
+    {
+      reserve(size() + static_cast<size_type>(zfwstl::distance(first, last)));
+      finish = zfwstl::uninitialized_copy(first, last, finish);
+    }
+    template <class IIter>
+    void range_insert(iterator pos, IIter first, IIter last, zfwstl::input_iterator_tag)
+    {
+      const size_type off = pos - start;
+      const size_type old_size = size();
+      append_range(first, last, zfwstl::input_iterator_tag{});
+      zfwstl::rotate(start + off, start + old_size, finish);
+    }
+    template <class FIter>
+    void range_insert(iterator pos, FIter first, FIter last, zfwstl::forward_iterator_tag)
+    {
+      const size_type n = static_cast<size_type>(zfwstl::distance(first, last));
+      if (n == 0)
+        return;
+      if (size_type(end_of_storage - finish) >= n)
+      {
+        const size_type elems_after = finish - pos;
+        iterator old_finish = finish;
+        if (elems_after > n)
+        {
+          zfwstl::uninitialized_move(finish - n, finish, finish);
+          finish += n;
+          zfwstl::move_backward(pos, old_finish - n, old_finish);
+          zfwstl::copy(first, last, pos);
+        }
+        else
+        {
+          // 区间后半段直接构造在尾部之后，前半段覆盖插入点之后的原有元素
+          FIter mid = first;
+          zfwstl::advance(mid, elems_after);
+          finish = zfwstl::uninitialized_copy(mid, last, finish);
+          zfwstl::uninitialized_move(pos, old_finish, finish);
+          finish += elems_after;
+          zfwstl::copy(first, mid, pos);
+        }
+      }
+      else
+      {
+        const size_type old_size = size();
+        const size_type off = pos - start;
+        const size_type len = next_capacity(n);
+        iterator new_start = data_allocator::allocate(len);
+        try
+        {
+          zfwstl::uninitialized_copy(first, last, new_start + off);
+        }
+        catch (...)
+        {
+          data_allocator::deallocate(new_start, len);
+          throw;
+        }
+        relocate(pos, new_start, n, len);
+        replace_storage(new_start, old_size + n, len);
+      }
+    }
+    // 扩容：至少 2 倍，并且至少放得下新增的 n 个元素
+    size_type next_capacity(size_type n) const
+    {
+      const size_type old_size = size();
+      THROW_LENGTH_ERROR_IF(max_size() - old_size < n, "small_vector<T>'s size too big");
+      return zfwstl::max(old_size + n, capacity() * 2);
+    }
+    void reallocate(size_type n)
+    {
+      const size_type old_size = size();
+      iterator new_start = data_allocator::allocate(n);
+      relocate(finish, new_start, 0, n);
+      replace_storage(new_start, old_size, n);
+    }
+    // 把 [start, pos) 与 [pos, finish) 搬到新空间，中间空出 gap 个位置(调用者已在其中构造好新元素)
+    // 移动构造可能抛出异常时改为复制，出错时原有元素完好：析构新空间中已构造的元素、归还新空间后重新抛出
+    void relocate(iterator pos, iterator new_start, size_type gap, size_type len)
+    {
+      const size_type off = static_cast<size_type>(pos - start);
+      iterator mid = new_start;
+      try
+      {
+        mid = zfwstl::uninitialized_move_if_noexcept(start, pos, new_start);
+        zfwstl::uninitialized_move_if_noexcept(pos, finish, new_start + off + gap);
+      }
+      catch (...)
+      {
+        zfwstl::destroy(new_start, mid);
+        zfwstl::destroy(new_start + off, new_start + off + gap);
+        data_allocator::deallocate(new_start, len);
+        throw;
+      }
+    }
+    // 销毁旧元素并换成 [new_start, new_start + len) 的新空间，新空间中已有 new_size 个元素
+    void replace_storage(iterator new_start, size_type new_size, size_type len)
+    {
+      zfwstl::destroy(start, finish);
+      release();
+      start = new_start;
+      finish = new_start + new_size;
+      end_of_storage = new_start + len;
+    }
+    // 归还堆空间，内嵌缓冲区不用归还
+    void release()
+    {
+      if (!is_inline())
+        data_allocator::deallocate(start, capacity());
+    }
+    // 自己为空且在内嵌缓冲区时接管 rhs 的元素，之后 rhs 为空并回到内嵌缓冲区
+    void steal(small_vector &rhs)
+    {
+      if (rhs.is_inline())
+      {
+        finish = zfwstl::uninitialized_move(rhs.start, rhs.finish, start);
+        zfwstl::destroy(rhs.start, rhs.finish);
+      }
+      else
+      {
+        start = rhs.start;
+        finish = rhs.finish;
+        end_of_storage = rhs.end_of_storage;
+      }
+      rhs.reset_inline();
+    }
+  };
+
+  template <class T, size_t N, class Alloc>
+  const typename small_vector<T, N, Alloc>::size_type small_vector<T, N, Alloc>::inline_capacity;
+
+  //========================模板类外重载操作===============
+  template <class T, size_t N, class Alloc>
+  void swap(small_vector<T, N, Alloc> &lhs, small_vector<T, N, Alloc> &rhs)
+  {
+    lhs.swap(rhs);
+  }
+  template <class T, size_t N, class Alloc>
+  bool operator==(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+  {
+    return lhs.size() == rhs.size() &&
+           zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+  template <class T, size_t N, class Alloc>
+  bool operator!=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+  {
+    return !(lhs == rhs);
+  }
+  template <class T, size_t N, class Alloc>
+  bool operator<(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+  {
+    return zfwstl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+  template <class T, size_t N, class Alloc>
+  bool operator>(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+  {
+    return rhs < lhs;
+  }
+  template <class T, size_t N, class Alloc>
+  bool operator<=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+  {
+    return !(rhs < lhs);
+  }
+  template <class T, size_t N, class Alloc>
+  bool operator>=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs)
+  {
+    return !(lhs < rhs);
+  }
+}
+
+#endif // !ZFWSTL_SMALL_VECTOR_H_
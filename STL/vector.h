@@ -3,24 +3,46 @@
 /**
  * 容器
  * 迭代器：Random Access iterators
+ * 扩容：容量按 Growth 增长(缺省 growth_2x，可换成 growth_1_5x)，旧元素搬到新空间时
+ *   可平凡搬移的元素(is_trivially_relocatable)直接 realloc，配置器支持时可能原地扩大而不用搬；
+ *   否则移动构造不抛异常时移动，会抛异常时复制(保证扩容失败时原容器不变)
  */
 #include <initializer_list>          // for initializer_list
 #include <cstddef>                   // for size_t, ptrdiff_t
+#include <cstring>                   // for memmove
 #include "../src/memory/allocator.h" // 标准空间配置器
 // #include "../src/util.h"                 //for forward
 #include "../src/exceptdef.h"            // for 宏MYSTL_DEBUG, THROW_LENGTH_ERROR_IF
-#include "../src/memory/unintialized.h"  // for uninitialized_fill_n() uninitialized_copy(), uninitialized_move()
+#include "../src/memory/unintialized.h"  // for uninitialized_fill_n() uninitialized_copy(), uninitialized_move_if_noexcept()
 #include "../src/algorithms/algorithm.h" // for lexicographical_compare(), equal(), max(), copy_backward(), fill(), copy()
 #include "../src/iterator.h"             // for reverse_iterator, iterator_category()萃取迭代器类型, distance(), advance(), is_input_iterator, forward_iterator_tag
 namespace zfwstl
 {
-  template <class T /*,class Alloc=alloc*/>
+  // 扩容策略：容量不足时新容量为 capacity * Num / Den，且至少能放下所需元素
+  // 2 倍摊还复制次数少；1.5 倍峰值内存小，且释放的旧空间之和最终能容纳新空间，利于配置器复用
+  template <size_t Num, size_t Den>
+  struct growth_factor
+  {
+    static_assert(Den > 0 && Num > Den, "growth factor must be greater than 1");
+    static size_t next(size_t cap, size_t need, size_t max_size)
+    {
+      const size_t inc = cap / Den * (Num - Den) + cap % Den * (Num - Den) / Den;
+      size_t len = max_size - cap < inc ? max_size : cap + inc;
+      return len < need ? need : len;
+    }
+  };
+  typedef growth_factor<2, 1> growth_2x;
+  typedef growth_factor<3, 2> growth_1_5x;
+
+  // Alloc: 原始内存配置器，默认 new_alloc(::operator new)，也可换用 alloc.h 中的内存池
+  // Growth: 扩容策略
+  template <class T, class Alloc = zfwstl::new_alloc, class Growth = zfwstl::growth_2x>
   class vector
   {
   public:
     //  专属空间配置器
-    typedef zfwstl::simple_allocator<T> data_allocator;
-    typedef zfwstl::simple_allocator<T> allocator_type;
+    typedef zfwstl::simple_allocator<T, Alloc> data_allocator;
+    typedef zfwstl::simple_allocator<T, Alloc> allocator_type;
     // vector的嵌套型别定义
     // NOTE:通过配置器allocator的类型间接定义下面类型，虽然有点复杂，但是更有利于后续的维护，因为只用修改simple_allocator类型即可
     typedef typename allocator_type::value_type value_type;
@@ -37,15 +59,23 @@ namespace zfwstl
     typedef zfwstl::reverse_iterator<const_iterator> const_reverse_iterator;
 
     allocator_type get_allocator() { return data_allocator(); }
-    template <class U>
-    friend void swap(vector<U> &lhs, vector<U> &rhs);
+    template <class U, class A, class G>
+    friend void swap(vector<U, A, G> &lhs, vector<U, A, G> &rhs);
 
   protected:
     // 配置空间并填满内容
     iterator allocate_and_fill(size_type n, const T &x)
     {
       iterator result = data_allocator::allocate(n);
-      zfwstl::uninitialized_fill_n(result, n, x);
+      try
+      {
+        zfwstl::uninitialized_fill_n(result, n, x);
+      }
+      catch (...)
+      {
+        data_allocator::deallocate(result, n);
+        throw;
+      }
       return result;
     }
 
@@ -58,11 +88,7 @@ namespace zfwstl
     // 默认构造函数 / 初始化列表构造函数
     explicit vector() noexcept : start(nullptr), finish(nullptr), end_of_storage(nullptr) {}
     // 参数化构造函数
-    vector(size_type n, const T &value)
-    {
-      std::cout << n << std::endl;
-      init_space(n, value);
-    }
+    vector(size_type n, const T &value) { init_space(n, value); }
     vector(int n, const T &value) { init_space(n, value); }
     vector(long n, const T &value) { init_space(n, value); }
     // TAG: explicit 防止编译器使用该构造函数进行隐式类型转换
@@ -92,10 +118,9 @@ namespace zfwstl
      * 这里的 0 是一个整数，它在这里没有实际的语义作用，只是作为一个占位符，表示这个模板特化的存在
      */
     template <class Iter, typename std::enable_if<zfwstl::is_input_iterator<Iter>::value, int>::type = 0>
-    vector(Iter first, Iter last)
+    vector(Iter first, Iter last) : start(nullptr), finish(nullptr), end_of_storage(nullptr)
     {
-      MYSTL_DEBUG(!(last < first));
-      range_init(first, last);
+      range_init(first, last, zfwstl::iterator_category(first));
     }
     ~vector()
     {
@@ -106,7 +131,7 @@ namespace zfwstl
     }
     //=================operator操作运算符重载=====================
     // 复制赋值操作符
-    vector<T> &operator=(const vector &rhs)
+    vector &operator=(const vector &rhs)
     {
       if (this != &rhs)
       {
@@ -126,7 +151,7 @@ namespace zfwstl
         {
           zfwstl::copy(rhs.begin(), rhs.begin() + size(), start);
           zfwstl::uninitialized_copy(rhs.begin() + size(), rhs.end(), finish);
-          end_of_storage = finish = start + len;
+          finish = start + len; // 容量不变，end_of_storage 仍指向配置的整块内存的末尾
         }
       }
       return *this;
@@ -176,13 +201,7 @@ namespace zfwstl
       {
         THROW_LENGTH_ERROR_IF(n > max_size(),
                               "n can not larger than max_size() in vector<T>::reserve(n)");
-        const auto old_size = size();
-        auto tmp = data_allocator::allocate(n);
-        zfwstl::uninitialized_move(start, finish, tmp);
-        data_allocator::deallocate(start, end_of_storage - start);
-        start = tmp;
-        finish = tmp + old_size;
-        end_of_storage = start + n;
+        relocate_storage(n, zfwstl::is_trivially_relocatable<T>{});
       }
     }
     bool empty() const { return (begin() == end()); }
@@ -258,10 +277,10 @@ namespace zfwstl
         iterator old_finish = finish;
         if (elems_after > n)
         {
-          // 1-1插入点之后现有元素个数 > 新增元素个数
-          zfwstl::uninitialized_copy(finish - n, finish, old_finish);
+          // 1-1插入点之后现有元素个数 > 新增元素个数：尾部整体后移 n 个位置，只挪一次
+          zfwstl::uninitialized_move(finish - n, finish, old_finish);
           finish += n;
-          zfwstl::copy_backward(position, old_finish - n, old_finish);
+          zfwstl::move_backward(position, old_finish - n, old_finish);
           zfwstl::fill(position, position + n, x_copy);
         }
         else
@@ -269,7 +288,7 @@ namespace zfwstl
           // 1-2插入点之后现有元素个数 <= 新增元素个数
           zfwstl::uninitialized_fill_n(finish, n - elems_after, x_copy);
           finish += n - elems_after;
-          zfwstl::uninitialized_copy(position, old_finish, finish);
+          zfwstl::uninitialized_move(position, old_finish, finish);
           finish += elems_after;
           zfwstl::fill(position, old_finish, x_copy);
         }
@@ -277,37 +296,47 @@ namespace zfwstl
       else
       {
         // 2-备用空间 < 新增元素个数 (需要配置额外内存)
-        const size_type old_size = size();
-        const size_type len = old_size + zfwstl::max(old_size, n); // 扩容关键
-        // 配置新的vector空间
-        iterator new_start = data_allocator::allocate(len);
-        iterator new_finish = new_start;
-        try
-        {
-          new_finish = zfwstl::uninitialized_copy(start, position, new_start);
-          new_finish = zfwstl::uninitialized_fill_n(new_finish, n, x);
-          new_finish = zfwstl::uninitialized_copy(position, finish, new_finish);
-        }
-        catch (...)
-        {
-          // 如果有异常，则 "commit or rollback"
-          data_allocator::destroy(new_start, new_finish);
-          data_allocator::deallocate(new_start, len);
-          throw;
-        }
-        // 清楚并释放旧的vector
-        data_allocator::destroy(start, finish);
-        data_allocator::deallocate(start, finish - start);
-        // 调整水位
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = start + len;
+        realloc_fill_insert(position, n, x, zfwstl::is_trivially_relocatable<T>{});
       }
     }
     void insert(iterator position, const value_type &x)
     {
       insert(position, 1, x);
     }
+    // 指定位置插入 [first, last)，返回指向第一个新元素的迭代器
+    // 前向迭代器：先算出元素个数，空位只开一次，尾部只挪一次
+    // 输入迭代器：无法预知个数，先逐个追加到尾部(摊还 O(1))，再 rotate 到插入位置
+    // 注意：[first, last) 不能是本容器中的元素
+    template <class Iter, typename std::enable_if<
+                              zfwstl::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(iterator position, Iter first, Iter last)
+    {
+      MYSTL_DEBUG(position >= begin() && position <= end());
+      const size_type off = position - start;
+      range_insert(position, first, last, zfwstl::iterator_category(first));
+      return start + off;
+    }
+    iterator insert(iterator position, std::initializer_list<value_type> ilist)
+    {
+      return insert(position, ilist.begin(), ilist.end());
+    }
+    // 插入/追加整个区间(任何提供 begin()/end() 的容器)，仿 C++23 insert_range / append_range
+    template <class Range>
+    iterator insert_range(iterator position, const Range &rg)
+    {
+      return insert(position, rg.begin(), rg.end());
+    }
+    template <class Range>
+    void append_range(const Range &rg)
+    {
+      insert(finish, rg.begin(), rg.end());
+    }
+    template <class Iter, typename std::enable_if<
+                              zfwstl::is_input_iterator<Iter>::value, int>::type = 0>
+    void append_range(Iter first, Iter last)
+    {
+      insert(finish, first, last);
+    }
     // emplace_back, emplace
     // 在 pos 位置就地构造元素，避免额外的复制或移动开销
     template <class... Args>
@@ -324,11 +353,13 @@ namespace zfwstl
       }
       else if (finish != end_of_storage) // 需要其他元素挪动位置
       {
+        // 先构造新元素：args 可能引用容器内的元素，挪动后就被移走了
+        value_type x_copy(zfwstl::forward<Args>(args)...);
         auto new_end = finish;
-        data_allocator::construct(finish, *(finish - 1));
+        data_allocator::construct(finish, zfwstl::move(*(finish - 1)));
         ++new_end;
-        zfwstl::copy_backward(xpos, finish - 1, finish);
-        *xpos = value_type(zfwstl::forward<Args>(args)...);
+        zfwstl::move_backward(xpos, finish - 1, finish);
+        *xpos = zfwstl::move(x_copy);
         finish = new_end;
       }
       else // 需要扩容
@@ -377,7 +408,7 @@ namespace zfwstl
     // 清空容器
     void clear() { erase(begin(), end()); }
     // 与另一个 vector 交换
-    void swap(vector<T> &rhs)
+    void swap(vector &rhs)
     {
       if (this != &rhs)
       {
@@ -396,13 +427,25 @@ namespace zfwstl
       else
         insert(end(), new_size - size(), value);
     }
+    // 重置容器大小，新增元素默认初始化而不是值初始化：
+    // 平凡类型(如 char、int、POD 结构体)的新元素不清零，内容未定，适合随后马上整块覆盖的缓冲区
+    void resize_default_init(size_type new_size)
+    {
+      if (new_size < size())
+      {
+        erase(begin() + new_size, end());
+        return;
+      }
+      if (new_size > capacity())
+        reserve(Growth::next(capacity(), new_size, max_size()));
+      default_init_n(finish, new_size - size(), std::is_trivially_default_constructible<T>{});
+    }
 
     // 覆盖替换操作 assign
     template <class Iter, typename std::enable_if<
                               zfwstl::is_input_iterator<Iter>::value, int>::type = 0>
     void assign(Iter first, Iter last)
     {
-      MYSTL_DEBUG(!(last < first));
       copy_assign(first, last, zfwstl::iterator_category(first));
     }
     // 从头覆盖 n个重复的 value值
@@ -432,64 +475,65 @@ namespace zfwstl
 
   private:
     // 容器初始化分配大小：用户要多少就给多少，不多分
-    void init_space(size_type n, const T &value) noexcept
+    void init_space(size_type n, const T &value)
     {
       start = allocate_and_fill(n, value);
       finish = start + n;
       end_of_storage = finish;
     }
-    // range_init 函数
+    // range_init 函数：输入迭代器只能遍历一次，逐个追加
+    template <class IIter>
+    void range_init(IIter first, IIter last, input_iterator_tag)
+    {
+      try
+      {
+        for (; first != last; ++first)
+          emplace_back(*first);
+      }
+      catch (...)
+      {
+        data_allocator::destroy(start, finish);
+        data_allocator::deallocate(start, end_of_storage - start);
+        throw;
+      }
+    }
+    template <class FIter>
+    void range_init(FIter first, FIter last, forward_iterator_tag)
+    {
+      range_init(first, last);
+    }
     template <class Iter>
     void range_init(Iter first, Iter last)
     {
       const size_type len = zfwstl::distance(first, last);
-      const size_type init_size = zfwstl::max(len, static_cast<size_type>(16));
-      init_space(len, init_size);
-      zfwstl::uninitialized_copy(first, last, start);
+      start = data_allocator::allocate(len);
+      try
+      {
+        finish = zfwstl::uninitialized_copy(first, last, start);
+      }
+      catch (...)
+      {
+        data_allocator::deallocate(start, len);
+        throw;
+      }
+      end_of_storage = finish;
     }
     // 指定位置插入元素，涉及是否需要扩容
     void inser_aux(iterator position, const T &x)
     {
       if (finish != end_of_storage) // 还有备份空间
       {
-        data_allocator::construct(finish, *(finish - 1));
+        value_type x_copy = x; // x 可能是容器内的元素，挪动前先复制
+        data_allocator::construct(finish, zfwstl::move(*(finish - 1)));
         // 调整水位
         ++finish;
-        value_type x_copy = x;
-        zfwstl::copy_backward(position, finish - 2, finish - 1); // 从后往前复制
-        *position = x_copy;
+        zfwstl::move_backward(position, finish - 2, finish - 1); // 从后往前移动
+        *position = zfwstl::move(x_copy);
       }
       else
       {
         // 没有备份空间-->扩容
-        const size_type old_size = size();
-        const size_type len = old_size != 0 ? 2 * old_size : 1; // 扩容原来的 2 倍
-        // 前半段放原数据，后半段用来放新数据
-        iterator new_start = data_allocator::allocate(len);
-        iterator new_finish = new_start;
-        try
-        {
-          // 将原vector内容拷贝到新vector
-          new_finish = zfwstl::uninitialized_copy(start, position, new_start);
-          data_allocator::construct(new_finish, x); // 为新元素设定初值 x
-          // 调整水位
-          ++new_finish;
-          // new_finish = zfwstl::uninitialized_copy(position, finish, new_finish);//将原vector的备用空间中的内容也忠实地拷贝过来
-        }
-        catch (...) //... 捕获所有异常的异常处理块
-        {
-          // commit or rollback
-          data_allocator::destroy(new_start, new_finish);
-          data_allocator::deallocate(new_start, len);
-          throw;
-        }
-        // 释放掉原内存空间
-        data_allocator::destroy(begin(), end());
-        data_allocator::deallocate(start, size());
-        // 调整迭代器，指向新vector
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = new_start + len;
+        realloc_emplace(position, zfwstl::is_trivially_relocatable<T>{}, x);
       }
     }
     // 就地构造元素，涉及是否需要扩容
@@ -498,51 +542,231 @@ namespace zfwstl
     {
       if (finish != end_of_storage) // 还有备份空间
       {
-        data_allocator::construct(finish, *(finish - 1));
+        value_type x_copy = value_type(zfwstl::forward<Args>(args)...); // 同 inser_aux，挪动前先构造
+        data_allocator::construct(finish, zfwstl::move(*(finish - 1)));
         // 调整水位
         ++finish;
-        value_type x_copy = value_type(zfwstl::forward<Args>(args)...);
-        zfwstl::copy_backward(position, finish - 2, finish - 1); // 从后往前复制
+        zfwstl::move_backward(position, finish - 2, finish - 1); // 从后往前移动
         *position = zfwstl::move(x_copy);
       }
       else
       {
         // 没有备份空间-->扩容
-        const size_type old_size = size();
-        const size_type len = old_size != 0 ? 2 * old_size : 1; // 扩容原来的 2 倍
-        // 前半段放原数据，后半段用来放新数据
-        iterator new_start = data_allocator::allocate(len);
-        iterator new_finish = new_start;
-        try
+        realloc_emplace(position, zfwstl::is_trivially_relocatable<T>{}, zfwstl::forward<Args>(args)...);
+      }
+    }
+    // 在尾部的未初始化空间上默认初始化 n 个元素
+    void default_init_n(iterator first, size_type n, std::true_type)
+    {
+      finish = first + n;
+    }
+    void default_init_n(iterator first, size_type n, std::false_type)
+    {
+      iterator cur = first;
+      try
+      {
+        for (; n > 0; --n, ++cur)
+          ::new (static_cast<void *>(cur)) T;
+      }
+      catch (...)
+      {
+        data_allocator::destroy(first, cur);
+        throw;
+      }
+      finish = cur;
+    }
+    template <class IIter>
+    void range_insert(iterator position, IIter first, IIter last, input_iterator_tag)
+    {
+      const size_type off = position - start;
+      const size_type old_size = size();
+      for (; first != last; ++first)
+        emplace_back(*first);
+      zfwstl::rotate(start + off, start + old_size, finish);
+    }
+    template <class FIter>
+    void range_insert(iterator position, FIter first, FIter last, forward_iterator_tag)
+    {
+      const size_type n = static_cast<size_type>(zfwstl::distance(first, last));
+      if (n == 0)
+        return;
+      if (size_type(end_of_storage - finish) >= n)
+      {
+        const size_type elems_after = finish - position;
+        iterator old_finish = finish;
+        if (elems_after > n)
         {
-          // 将原vector内容拷贝到新vector
-          new_finish = zfwstl::uninitialized_copy(start, position, new_start);
-          data_allocator::construct(new_finish, zfwstl::forward<Args>(args)...); // 为新元素设定初值 x
-          // 调整水位
-          ++new_finish;
-          // new_finish = zfwstl::uninitialized_copy(position, finish, new_finish);//将原vector的备用空间中的内容也忠实地拷贝过来
+          zfwstl::uninitialized_move(finish - n, finish, old_finish);
+          finish += n;
+          zfwstl::move_backward(position, old_finish - n, old_finish);
+          zfwstl::copy(first, last, position);
         }
-        catch (...) //... 捕获所有异常的异常处理块
+        else
         {
-          // commit or rollback
-          data_allocator::destroy(new_start, new_finish);
-          data_allocator::deallocate(new_start, len);
-          throw;
+          // 区间后半段直接构造在尾部之后，前半段覆盖插入点之后的原有元素
+          FIter mid = first;
+          zfwstl::advance(mid, elems_after);
+          zfwstl::uninitialized_copy(mid, last, finish);
+          finish += n - elems_after;
+          zfwstl::uninitialized_move(position, old_finish, finish);
+          finish += elems_after;
+          zfwstl::copy(first, mid, position);
         }
-        // 释放掉原内存空间
-        data_allocator::destroy(begin(), end());
-        data_allocator::deallocate(start, size());
-        // 调整迭代器，指向新vector
-        start = new_start;
-        finish = new_finish;
-        end_of_storage = new_start + len;
       }
+      else
+      {
+        realloc_range_insert(position, first, last, n, zfwstl::is_trivially_relocatable<T>{});
+      }
+    }
+    template <class FIter>
+    void realloc_range_insert(iterator position, FIter first, FIter last, size_type n, std::true_type)
+    {
+      iterator gap = realloc_with_gap(position, n, next_capacity(n));
+      try
+      {
+        zfwstl::uninitialized_copy(first, last, gap);
+      }
+      catch (...)
+      {
+        // 迭代器抛出异常：把尾部挪回去，空位合上
+        std::memmove(static_cast<void *>(gap), static_cast<const void *>(gap + n),
+                     (finish - gap - n) * sizeof(T));
+        finish -= n;
+        throw;
+      }
+    }
+    template <class FIter>
+    void realloc_range_insert(iterator position, FIter first, FIter last, size_type n, std::false_type)
+    {
+      const size_type len = next_capacity(n);
+      iterator new_start = data_allocator::allocate(len);
+      try
+      {
+        zfwstl::uninitialized_copy(first, last, new_start + (position - start));
+      }
+      catch (...)
+      {
+        data_allocator::deallocate(new_start, len);
+        throw;
+      }
+      relocate_around_gap(position, new_start, n, len);
+    }
+    // 扩容后至少能再放 n 个元素
+    size_type next_capacity(size_type n) const
+    {
+      THROW_LENGTH_ERROR_IF(max_size() - size() < n, "vector<T>'s size too big");
+      return Growth::next(capacity(), size() + n, max_size());
+    }
+    // 换成 [new_start, new_start + len) 的新空间，其中已有 new_size 个元素；旧元素已搬走(或已析构)
+    void replace_storage(iterator new_start, size_type new_size, size_type len)
+    {
+      data_allocator::deallocate(start, end_of_storage - start);
+      start = new_start;
+      finish = new_start + new_size;
+      end_of_storage = new_start + len;
+    }
+    // 可平凡搬移：realloc 到 len 个元素的空间(可能原地扩大)，并把 position 之后的元素整体后移 n 个位置
+    // 返回空位起点，空位未构造，finish 已包含空位
+    iterator realloc_with_gap(iterator position, size_type n, size_type len)
+    {
+      const size_type off = position - start;
+      const size_type old_size = size();
+      start = data_allocator::reallocate(start, end_of_storage - start, len);
+      finish = start + old_size + n;
+      end_of_storage = start + len;
+      if (off != old_size)
+        std::memmove(static_cast<void *>(start + off + n), static_cast<const void *>(start + off),
+                     (old_size - off) * sizeof(T));
+      return start + off;
+    }
+    // 把 [start, position) 与 [position, finish) 搬到新空间中空位 [gap, gap + n) 的两侧，然后换成新空间
+    // 空位已由调用者构造好；搬移失败时析构空位并释放新空间，原容器不变
+    void relocate_around_gap(iterator position, iterator new_start, size_type n, size_type len)
+    {
+      const size_type off = position - start;
+      iterator new_finish = new_start;
+      try
+      {
+        new_finish = zfwstl::uninitialized_move_if_noexcept(start, position, new_start);
+        new_finish = zfwstl::uninitialized_move_if_noexcept(position, finish, new_finish + n);
+      }
+      catch (...)
+      {
+        if (new_finish == new_start + off) // 前半段已搬完，失败在后半段
+          data_allocator::destroy(new_start, new_start + off);
+        data_allocator::destroy(new_start + off, new_start + off + n);
+        data_allocator::deallocate(new_start, len);
+        throw;
+      }
+      const size_type new_size = size() + n;
+      data_allocator::destroy(start, finish);
+      replace_storage(new_start, new_size, len);
+    }
+    // 扩容并在 position 处构造一个元素
+    template <class... Args>
+    void realloc_emplace(iterator position, std::true_type, Args &&...args)
+    {
+      value_type x_copy(zfwstl::forward<Args>(args)...); // 先构造：args 可能引用旧空间中的元素
+      iterator gap = realloc_with_gap(position, 1, next_capacity(1));
+      zfwstl::construct(gap, zfwstl::move(x_copy));
+    }
+    template <class... Args>
+    void realloc_emplace(iterator position, std::false_type, Args &&...args)
+    {
+      const size_type len = next_capacity(1);
+      iterator new_start = data_allocator::allocate(len);
+      iterator gap = new_start + (position - start);
+      try
+      {
+        // 先构造新元素再搬旧元素：args 可能引用旧空间中的元素
+        zfwstl::construct(gap, zfwstl::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+        data_allocator::deallocate(new_start, len);
+        throw;
+      }
+      relocate_around_gap(position, new_start, 1, len);
+    }
+    // 扩容并在 position 处插入 n 个 x
+    void realloc_fill_insert(iterator position, size_type n, const value_type &x, std::true_type)
+    {
+      const value_type x_copy = x;
+      iterator gap = realloc_with_gap(position, n, next_capacity(n));
+      zfwstl::uninitialized_fill_n(gap, n, x_copy);
+    }
+    void realloc_fill_insert(iterator position, size_type n, const value_type &x, std::false_type)
+    {
+      const size_type len = next_capacity(n);
+      iterator new_start = data_allocator::allocate(len);
+      try
+      {
+        zfwstl::uninitialized_fill_n(new_start + (position - start), n, x);
+      }
+      catch (...)
+      {
+        data_allocator::deallocate(new_start, len);
+        throw;
+      }
+      relocate_around_gap(position, new_start, n, len);
+    }
+    // 容量调整为 n，用于 reserve
+    void relocate_storage(size_type n, std::true_type)
+    {
+      const size_type old_size = size();
+      start = data_allocator::reallocate(start, end_of_storage - start, n);
+      finish = start + old_size;
+      end_of_storage = start + n;
+    }
+    void relocate_storage(size_type n, std::false_type)
+    {
+      relocate_around_gap(finish, data_allocator::allocate(n), 0, n);
     }
     template <class IIter>
     void copy_assign(IIter first, IIter last, input_iterator_tag)
     {
       auto cur = start;
-      for (; first != last && finish != start; ++first, ++cur)
+      for (; first != last && cur != finish; ++first, ++cur)
         *cur = *first;
       if (first == last)
         erase(cur, finish);
@@ -577,39 +801,39 @@ namespace zfwstl
 
   //========================模板类外重载操作===============
   // 重载 zfwstl 的 swap
-  template <class T>
-  void swap(vector<T> &lhs, vector<T> &rhs)
+  template <class T, class Alloc, class Growth>
+  void swap(vector<T, Alloc, Growth> &lhs, vector<T, Alloc, Growth> &rhs)
   {
     lhs.swap(rhs);
   }
-  template <class T>
-  bool operator==(const vector<T> &lhs, const vector<T> &rhs)
+  template <class T, class Alloc, class Growth>
+  bool operator==(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
   {
     return lhs.size() == rhs.size() &&
            zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
-  template <typename T>
-  bool operator!=(const vector<T> &lhs, const vector<T> &rhs)
+  template <class T, class Alloc, class Growth>
+  bool operator!=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
   {
     return !(lhs == rhs);
   }
-  template <class T>
-  bool operator<(const vector<T> &lhs, const vector<T> &rhs)
+  template <class T, class Alloc, class Growth>
+  bool operator<(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
   {
     return zfwstl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
   }
-  template <class T>
-  bool operator>(const vector<T> &lhs, const vector<T> &rhs)
+  template <class T, class Alloc, class Growth>
+  bool operator>(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
   {
     return rhs < lhs;
   }
-  template <class T>
-  bool operator<=(const vector<T> &lhs, const vector<T> &rhs)
+  template <class T, class Alloc, class Growth>
+  bool operator<=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
   {
     return !(rhs < lhs);
   }
-  template <class T>
-  bool operator>=(const vector<T> &lhs, const vector<T> &rhs)
+  template <class T, class Alloc, class Growth>
+  bool operator>=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
   {
     return !(lhs < rhs);
   }
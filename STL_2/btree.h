@@ -0,0 +1,1094 @@
+#ifndef ZFWSTL_BTREE_H_
+#define ZFWSTL_BTREE_H_
+/**
+ * B+ tree
+ * rb_tree 每个元素一个节点(三个指针加颜色)，区间扫描要逐个追指针，int 键的内存开销是元素本身的 5~8 倍
+ * btree 的每个节点是一块连续内存(缺省 256 字节，即 4 条 cache line)，一个节点存放多个元素：
+ *   叶节点存放元素本身，并以 prev / next 串成双向链表，中序遍历只是顺序扫描叶节点；
+ *   内部节点只存放分隔键和子节点指针，查找时每层在一个节点内二分，树高约为 log_B(n)
+ * 分隔键：内部节点 children[i] 中的键 <= keys[i] <= children[i + 1] 中的键
+ *   两边都允许相等，所以可以存放重复键；删除元素后分隔键依然是合法的上下界，不必更新
+ * 注意：与 rb_tree 不同，插入、删除会在节点之间搬移元素，任何插入、删除都可能使迭代器、指针和引用失效
+ */
+#include <cstddef>                       //for size_t, ptrdiff_t
+#include <type_traits>                   //for aligned_storage
+#include "../src/iterator.h"             //for bidirectional_iterator_tag, distance, reverse_iterator
+#include "../src/memory/allocator.h"     //标准空间配置器
+#include "../src/memory/alloc.h"         //内存池 alloc
+#include "../src/memory/construct.h"     //for construct, destroy
+#include "../STL/vector.h"               //建树时暂存每一层的节点
+#include "../src/util.h"                 //for pair, swap, move, forward
+#include "../src/algorithms/algorithm.h" //for equal(), lexicographical_compare()
+namespace zfwstl
+{
+  //==================节点node==================
+  struct __btree_node_base
+  {
+    bool leaf;                  // 是否叶节点
+    unsigned short count;       // 叶节点：元素个数；内部节点：分隔键个数(子节点个数为 count + 1)
+    unsigned short pos;         // 在父节点 children 中的下标
+    __btree_node_base *parent;  // 根节点的 parent 为 nullptr
+  };
+  // 叶节点：N 个元素的原始空间，元素只在 [0, count) 中构造
+  template <class Value, size_t N>
+  struct __btree_leaf : public __btree_node_base
+  {
+    __btree_leaf *prev;
+    __btree_leaf *next;
+    typename std::aligned_storage<sizeof(Value), alignof(Value)>::type slots[N];
+
+    Value *value(size_t i) { return reinterpret_cast<Value *>(&slots[i]); }
+  };
+  // 内部节点：多留一个键位和一个子节点位，插入分隔键后允许暂时溢出一个，再分裂
+  template <class Key, size_t N>
+  struct __btree_internal : public __btree_node_base
+  {
+    typename std::aligned_storage<sizeof(Key), alignof(Key)>::type keys[N + 1];
+    __btree_node_base *children[N + 2];
+
+    Key *key(size_t i) { return reinterpret_cast<Key *>(&keys[i]); }
+  };
+  //==================迭代器iterator==================
+  // (叶节点, 下标)；end() 为 (最后一个叶节点, 其元素个数)，空树为 (nullptr, 0)
+  template <class Value, class Ref, class Ptr, class Leaf>
+  struct __btree_iterator
+  {
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef Ref reference;
+    typedef Ptr pointer;
+    typedef ptrdiff_t difference_type;
+    typedef __btree_iterator<Value, Value &, Value *, Leaf> iterator;
+    typedef __btree_iterator<Value, const Value &, const Value *, Leaf> const_iterator;
+    typedef __btree_iterator<Value, Ref, Ptr, Leaf> self;
+
+    Leaf *node;
+    size_t index;
+
+    __btree_iterator() : node(nullptr), index(0) {}
+    __btree_iterator(Leaf *x, size_t i) : node(x), index(i) {}
+    __btree_iterator(const iterator &rhs) : node(rhs.node), index(rhs.index) {}
+    self &operator=(const self &) = default;
+
+    reference operator*() const { return *node->value(index); }
+    pointer operator->() const { return &(operator*()); }
+    self &operator++()
+    {
+      // 走完一个叶节点后转到下一个叶节点；最后一个叶节点停在 count 处，即 end()
+      if (++index == node->count && node->next)
+      {
+        node = node->next;
+        index = 0;
+      }
+      return *this;
+    }
+    self operator++(int)
+    {
+      self tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    self &operator--()
+    {
+      if (index == 0)
+      {
+        node = node->prev;
+        index = node->count - 1;
+      }
+      else
+        --index;
+      return *this;
+    }
+    self operator--(int)
+    {
+      self tmp = *this;
+      --*this;
+      return tmp;
+    }
+    bool operator==(const self &other) const { return node == other.node && index == other.index; }
+    bool operator!=(const self &other) const { return !(*this == other); }
+  };
+  // 节点大小 bytes 扣除 overhead 后能放下几个大小为 per 的槽位，至少 4 个；先比较再相减，键/元素比节点还大时不回绕
+  constexpr size_t __btree_slots(size_t bytes, size_t overhead, size_t per)
+  {
+    return bytes > overhead && (bytes - overhead) / per >= 4 ? (bytes - overhead) / per : 4;
+  }
+  //===============================btree==========================
+  // KeyOfValue用于从值类型中提取Key
+  // Alloc: 原始内存配置器；NodeBytes: 节点的目标大小，元素/键的个数据此算出(至少 4 个)
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = zfwstl::alloc, size_t NodeBytes = 256>
+  class btree
+  {
+  public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef value_type *pointer;
+    typedef const value_type *const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    enum
+    {
+      // 叶节点能放下的元素个数
+      leaf_slots = __btree_slots(NodeBytes, sizeof(__btree_node_base) + 2 * sizeof(void *), sizeof(Value)),
+      // 内部节点能放下的分隔键个数(另有一个溢出位)
+      internal_slots = __btree_slots(NodeBytes, sizeof(__btree_node_base) + sizeof(Key) + 2 * sizeof(void *),
+                                     sizeof(Key) + sizeof(void *)),
+      // 删除后元素/键个数低于下限时向兄弟借或与兄弟合并
+      leaf_min = leaf_slots / 2,
+      internal_min = internal_slots / 2
+    };
+
+  protected:
+    typedef __btree_node_base *base_ptr;
+    typedef __btree_leaf<Value, leaf_slots> leaf_node;
+    typedef __btree_internal<Key, internal_slots> internal_node;
+    typedef zfwstl::simple_allocator<leaf_node, Alloc> leaf_allocator;
+    typedef zfwstl::simple_allocator<internal_node, Alloc> internal_allocator;
+
+  public:
+    typedef __btree_iterator<value_type, reference, pointer, leaf_node> iterator;
+    typedef __btree_iterator<value_type, const_reference, const_pointer, leaf_node> const_iterator;
+    typedef zfwstl::reverse_iterator<iterator> reverse_iterator;
+    typedef zfwstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  protected:
+    base_ptr root_node;    // 空树为 nullptr
+    leaf_node *first_leaf; // 最左叶节点，begin()
+    leaf_node *last_leaf;  // 最右叶节点，end()
+    size_type node_count;  // 元素个数
+    Compare key_compare;
+
+    static const Key &key(leaf_node *x, size_type i) { return KeyOfValue()(*x->value(i)); }
+    static leaf_node *as_leaf(base_ptr x) { return static_cast<leaf_node *>(x); }
+    static internal_node *as_internal(base_ptr x) { return static_cast<internal_node *>(x); }
+
+    leaf_node *create_leaf()
+    {
+      leaf_node *x = leaf_allocator::allocate();
+      x->leaf = true;
+      x->count = 0;
+      x->pos = 0;
+      x->parent = nullptr;
+      x->prev = nullptr;
+      x->next = nullptr;
+      return x;
+    }
+    internal_node *create_internal()
+    {
+      internal_node *x = internal_allocator::allocate();
+      x->leaf = false;
+      x->count = 0;
+      x->pos = 0;
+      x->parent = nullptr;
+      return x;
+    }
+    void destroy_node(base_ptr x)
+    {
+      if (x->leaf)
+      {
+        leaf_node *l = as_leaf(x);
+        for (size_type i = 0; i < l->count; ++i)
+          zfwstl::destroy(l->value(i));
+        leaf_allocator::deallocate(l);
+      }
+      else
+      {
+        internal_node *n = as_internal(x);
+        for (size_type i = 0; i < n->count; ++i)
+          zfwstl::destroy(n->key(i));
+        internal_allocator::deallocate(n);
+      }
+    }
+    // 元素/键在节点内外搬移：移动构造到新位置，再析构旧位置
+    // (map 的 pair<const Key, T> 不能赋值，所以不用移动赋值)
+    template <class T>
+    static void relocate(T *dst, T *src)
+    {
+      zfwstl::construct(dst, zfwstl::move(*src));
+      zfwstl::destroy(src);
+    }
+
+  public:
+    btree(const Compare &comp = Compare())
+        : root_node(nullptr), first_leaf(nullptr), last_leaf(nullptr), node_count(0), key_compare(comp) {}
+    // 拷贝构造：源树已有序，直接 O(n) 建出紧凑的树
+    btree(const btree &rhs)
+        : root_node(nullptr), first_leaf(nullptr), last_leaf(nullptr), node_count(0), key_compare(rhs.key_compare)
+    {
+      if (rhs.node_count != 0)
+        __build_sorted(rhs.begin(), rhs.end(), rhs.node_count, false);
+    }
+    // 移动构造
+    btree(btree &&rhs) noexcept
+        : root_node(rhs.root_node), first_leaf(rhs.first_leaf), last_leaf(rhs.last_leaf),
+          node_count(rhs.node_count), key_compare(rhs.key_compare)
+    {
+      rhs.root_node = nullptr;
+      rhs.first_leaf = nullptr;
+      rhs.last_leaf = nullptr;
+      rhs.node_count = 0;
+    }
+    ~btree() { clear(); }
+    //=================operator操作运算符重载=====================
+    btree &operator=(const btree &rhs)
+    {
+      if (this != &rhs)
+      {
+        clear();
+        key_compare = rhs.key_compare;
+        if (rhs.node_count != 0)
+          __build_sorted(rhs.begin(), rhs.end(), rhs.node_count, false);
+      }
+      return *this;
+    }
+    btree &operator=(btree &&rhs) noexcept
+    {
+      if (this != &rhs)
+      {
+        clear();
+        swap(rhs);
+      }
+      return *this;
+    }
+
+    void swap(btree &rhs) noexcept
+    {
+      zfwstl::swap(root_node, rhs.root_node);
+      zfwstl::swap(first_leaf, rhs.first_leaf);
+      zfwstl::swap(last_leaf, rhs.last_leaf);
+      zfwstl::swap(node_count, rhs.node_count);
+      zfwstl::swap(key_compare, rhs.key_compare);
+    }
+
+    // 容量相关操作
+    Compare key_comp() const { return key_compare; }
+    bool empty() const noexcept { return node_count == 0; }
+    size_type size() const noexcept { return node_count; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+    iterator begin() noexcept { return iterator(first_leaf, 0); }
+    const_iterator begin() const noexcept { return const_iterator(first_leaf, 0); }
+    iterator end() noexcept { return iterator(last_leaf, last_leaf ? last_leaf->count : 0); }
+    const_iterator end() const noexcept { return const_iterator(last_leaf, last_leaf ? last_leaf->count : 0); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    void clear()
+    {
+      if (root_node)
+        __erase_subtree(root_node);
+      root_node = nullptr;
+      first_leaf = nullptr;
+      last_leaf = nullptr;
+      node_count = 0;
+    }
+
+    //==================插入操作==================
+    // 键值唯一：已存在时返回指向它的迭代器和 false
+    zfwstl::pair<iterator, bool> insert_unique(const value_type &v) { return __insert_unique(v); }
+    zfwstl::pair<iterator, bool> insert_unique(value_type &&v) { return __insert_unique(zfwstl::move(v)); }
+    // 可插入重复key，新元素排在相等元素之后
+    iterator insert_equal(const value_type &v) { return __insert_equal(v); }
+    iterator insert_equal(value_type &&v) { return __insert_equal(zfwstl::move(v)); }
+    // 批量插入：空树且输入已按 key_compare 排好序时 O(n) 直接建树(叶节点塞满)；
+    // 否则逐个插入，新键大于当前最大键时直接追加到最右叶节点
+    template <class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last)
+    {
+      __insert_range(first, last, true, iterator_category(first));
+    }
+    template <class InputIterator>
+    void insert_equal(InputIterator first, InputIterator last)
+    {
+      __insert_range(first, last, false, iterator_category(first));
+    }
+
+    //==================删除操作==================
+    // 返回被删元素之后的元素；其余迭代器全部失效
+    iterator erase(const_iterator position) { return __erase_at(position.node, position.index); }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      if (first == begin() && last == end())
+      {
+        clear();
+        return end();
+      }
+      iterator it(first.node, first.index);
+      for (size_type n = zfwstl::distance(first, last); n > 0; --n)
+        it = __erase_at(it.node, it.index);
+      return it;
+    }
+    template <class K>
+    size_type erase_unique(const K &k)
+    {
+      iterator it = find(k);
+      if (it == end())
+        return 0;
+      erase(it);
+      return 1;
+    }
+    template <class K>
+    size_type erase_multi(const K &k)
+    {
+      zfwstl::pair<iterator, iterator> p = equal_range(k);
+      size_type n = zfwstl::distance(p.first, p.second);
+      erase(p.first, p.second);
+      return n;
+    }
+
+    //==================查找操作==================
+    // 查找均为模板：K 可以是 key_type，也可以是透明比较器(如 less<>)能与 key_type 比较的任何型别，
+    // 由上层容器决定开放哪些重载
+    template <class K>
+    iterator find(const K &k)
+    {
+      iterator it = lower_bound(k);
+      return (it == end() || key_compare(k, KeyOfValue()(*it))) ? end() : it;
+    }
+    template <class K>
+    const_iterator find(const K &k) const
+    {
+      const_iterator it = lower_bound(k);
+      return (it == end() || key_compare(k, KeyOfValue()(*it))) ? end() : it;
+    }
+    template <class K>
+    size_type count_unique(const K &k) const { return find(k) == end() ? 0 : 1; }
+    template <class K>
+    size_type count_multi(const K &k) const
+    {
+      zfwstl::pair<const_iterator, const_iterator> p = equal_range(k);
+      return zfwstl::distance(p.first, p.second);
+    }
+    template <class K>
+    iterator lower_bound(const K &k) { return __lower_bound(k); }
+    template <class K>
+    const_iterator lower_bound(const K &k) const { return __lower_bound(k); }
+    template <class K>
+    iterator upper_bound(const K &k) { return __upper_bound(k); }
+    template <class K>
+    const_iterator upper_bound(const K &k) const { return __upper_bound(k); }
+    template <class K>
+    zfwstl::pair<iterator, iterator> equal_range(const K &k)
+    {
+      return zfwstl::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    template <class K>
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const K &k) const
+    {
+      return zfwstl::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+
+    // 节点数与占用的字节数(只含节点本身)，供测试与基准比较内存开销
+    size_type leaf_count() const
+    {
+      size_type n = 0;
+      for (leaf_node *x = first_leaf; x; x = x->next)
+        ++n;
+      return n;
+    }
+    size_type bytes_used() const { return root_node ? __bytes_used(root_node) : 0; }
+
+    // 调试用：检查所有叶节点同深度且非空、父子指针与下标一致、分隔键上下界、叶链表与元素个数，
+    // 以及非根内部节点的键数不低于下限
+    bool __btree_verify() const
+    {
+      if (root_node == nullptr)
+        return node_count == 0 && first_leaf == nullptr && last_leaf == nullptr;
+      if (root_node->parent != nullptr)
+        return false;
+      size_type leaf_depth = static_cast<size_type>(-1);
+      leaf_node *prev = nullptr;
+      size_type n = 0;
+      if (!__verify_node(root_node, 0, leaf_depth, prev, n))
+        return false;
+      if (prev != last_leaf || last_leaf->next != nullptr || first_leaf->prev != nullptr || n != node_count)
+        return false;
+      for (const_iterator it = begin(), nx = begin(); it != end(); it = nx)
+        if (++nx != end() && key_compare(KeyOfValue()(*nx), KeyOfValue()(*it)))
+          return false;
+      return true;
+    }
+
+  private:
+    //==================查找辅助==================
+    // 节点内二分：第一个 >= k / 第一个 > k 的下标
+    template <class K>
+    size_type __leaf_lower(leaf_node *x, const K &k) const
+    {
+      size_type lo = 0, hi = x->count;
+      while (lo < hi)
+      {
+        size_type mid = (lo + hi) >> 1;
+        if (key_compare(key(x, mid), k))
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      return lo;
+    }
+    template <class K>
+    size_type __leaf_upper(leaf_node *x, const K &k) const
+    {
+      size_type lo = 0, hi = x->count;
+      while (lo < hi)
+      {
+        size_type mid = (lo + hi) >> 1;
+        if (key_compare(k, key(x, mid)))
+          hi = mid;
+        else
+          lo = mid + 1;
+      }
+      return lo;
+    }
+    template <class K>
+    size_type __internal_lower(internal_node *x, const K &k) const
+    {
+      size_type lo = 0, hi = x->count;
+      while (lo < hi)
+      {
+        size_type mid = (lo + hi) >> 1;
+        if (key_compare(*x->key(mid), k))
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      return lo;
+    }
+    template <class K>
+    size_type __internal_upper(internal_node *x, const K &k) const
+    {
+      size_type lo = 0, hi = x->count;
+      while (lo < hi)
+      {
+        size_type mid = (lo + hi) >> 1;
+        if (key_compare(k, *x->key(mid)))
+          hi = mid;
+        else
+          lo = mid + 1;
+      }
+      return lo;
+    }
+    // lower 下降：进入第一个分隔键 >= k 的子节点，其左侧子树的键都 < k
+    template <class K>
+    leaf_node *__descend_lower(const K &k) const
+    {
+      base_ptr x = root_node;
+      while (!x->leaf)
+        x = as_internal(x)->children[__internal_lower(as_internal(x), k)];
+      return as_leaf(x);
+    }
+    // upper 下降：进入第一个分隔键 > k 的子节点，其左侧子树的键都 <= k
+    template <class K>
+    leaf_node *__descend_upper(const K &k) const
+    {
+      base_ptr x = root_node;
+      while (!x->leaf)
+        x = as_internal(x)->children[__internal_upper(as_internal(x), k)];
+      return as_leaf(x);
+    }
+    // 落在叶节点末尾的位置换成下一个叶节点的开头，保证同一位置只有一种表示
+    iterator __make_iter(leaf_node *x, size_type i) const
+    {
+      if (i == x->count && x->next)
+        return iterator(x->next, 0);
+      return iterator(x, i);
+    }
+    template <class K>
+    iterator __lower_bound(const K &k) const
+    {
+      if (root_node == nullptr)
+        return iterator();
+      leaf_node *x = __descend_lower(k);
+      return __make_iter(x, __leaf_lower(x, k));
+    }
+    template <class K>
+    iterator __upper_bound(const K &k) const
+    {
+      if (root_node == nullptr)
+        return iterator();
+      leaf_node *x = __descend_upper(k);
+      return __make_iter(x, __leaf_upper(x, k));
+    }
+
+    //==================插入辅助==================
+    template <class V>
+    zfwstl::pair<iterator, bool> __insert_unique(V &&v)
+    {
+      if (root_node == nullptr)
+        return zfwstl::pair<iterator, bool>(__insert_first(zfwstl::forward<V>(v)), true);
+      const key_type &k = KeyOfValue()(v);
+      leaf_node *x = __descend_lower(k);
+      size_type i = __leaf_lower(x, k);
+      // 叶节点内都 < k 时，相等的键可能是下一个叶节点的第一个元素
+      if (i < x->count)
+      {
+        if (!key_compare(k, key(x, i)))
+          return zfwstl::pair<iterator, bool>(iterator(x, i), false);
+      }
+      else if (x->next && !key_compare(k, key(x->next, 0)))
+        return zfwstl::pair<iterator, bool>(iterator(x->next, 0), false);
+      return zfwstl::pair<iterator, bool>(__insert_at(x, i, zfwstl::forward<V>(v)), true);
+    }
+    template <class V>
+    iterator __insert_equal(V &&v)
+    {
+      if (root_node == nullptr)
+        return __insert_first(zfwstl::forward<V>(v));
+      const key_type &k = KeyOfValue()(v);
+      leaf_node *x = __descend_upper(k);
+      return __insert_at(x, __leaf_upper(x, k), zfwstl::forward<V>(v));
+    }
+    template <class V>
+    iterator __insert_first(V &&v)
+    {
+      leaf_node *x = create_leaf();
+      try
+      {
+        zfwstl::construct(x->value(0), zfwstl::forward<V>(v));
+      }
+      catch (...)
+      {
+        leaf_allocator::deallocate(x);
+        throw;
+      }
+      x->count = 1;
+      root_node = first_leaf = last_leaf = x;
+      node_count = 1;
+      return iterator(x, 0);
+    }
+    /**
+     * 在叶节点 x 的下标 i 处插入 v。x 已满时先分裂：
+     * 一般对半分；若是在最右叶节点末尾追加(顺序插入)，则 x 保持满、新元素独占新的叶节点，
+     * 顺序插入得到的叶节点几乎都是满的
+     */
+    template <class V>
+    iterator __insert_at(leaf_node *x, size_type i, V &&v)
+    {
+      if (x->count == leaf_slots)
+      {
+        const bool append = x->next == nullptr && i == x->count;
+        const size_type keep = append ? x->count : (x->count + 1) / 2;
+        leaf_node *r = create_leaf();
+        for (size_type j = keep; j < x->count; ++j)
+          relocate(r->value(j - keep), x->value(j));
+        r->count = x->count - keep;
+        x->count = keep;
+        r->prev = x;
+        r->next = x->next;
+        if (x->next)
+          x->next->prev = r;
+        else
+          last_leaf = r;
+        x->next = r;
+        // 新元素放在左边(有空位时)或右边；放进右边开头时它就是新的分隔键
+        if (i > keep || (i == keep && append))
+        {
+          i -= keep;
+          if (i == 0)
+            __insert_parent(x, KeyOfValue()(v), r);
+          else
+            __insert_parent(x, key(r, 0), r);
+          x = r;
+        }
+        else
+          __insert_parent(x, key(r, 0), r);
+      }
+      for (size_type j = x->count; j > i; --j)
+        relocate(x->value(j), x->value(j - 1));
+      try
+      {
+        zfwstl::construct(x->value(i), zfwstl::forward<V>(v));
+      }
+      catch (...)
+      {
+        for (size_type j = i; j < x->count; ++j)
+          relocate(x->value(j), x->value(j + 1));
+        throw;
+      }
+      ++x->count;
+      ++node_count;
+      return iterator(x, i);
+    }
+    // 节点 left 分裂出 right 后，把分隔键 sep 与 right 插入父节点；父节点溢出则继续向上分裂
+    void __insert_parent(base_ptr left, const key_type &sep, base_ptr right)
+    {
+      internal_node *p = as_internal(left->parent);
+      if (p == nullptr)
+      {
+        p = create_internal();
+        zfwstl::construct(p->key(0), sep);
+        p->count = 1;
+        p->children[0] = left;
+        p->children[1] = right;
+        left->parent = right->parent = p;
+        left->pos = 0;
+        right->pos = 1;
+        root_node = p;
+        return;
+      }
+      const size_type i = left->pos;
+      for (size_type j = p->count; j > i; --j)
+        relocate(p->key(j), p->key(j - 1));
+      for (size_type j = p->count + 1; j > i + 1; --j)
+      {
+        p->children[j] = p->children[j - 1];
+        p->children[j]->pos = static_cast<unsigned short>(j);
+      }
+      zfwstl::construct(p->key(i), sep);
+      p->children[i + 1] = right;
+      right->parent = p;
+      right->pos = static_cast<unsigned short>(i + 1);
+      if (++p->count > internal_slots)
+        __split_internal(p);
+    }
+    // 溢出的内部节点对半分，中间的键上移到父节点
+    void __split_internal(internal_node *p)
+    {
+      internal_node *r = create_internal();
+      const size_type mid = p->count / 2;
+      const size_type rn = p->count - mid - 1;
+      for (size_type j = 0; j < rn; ++j)
+        relocate(r->key(j), p->key(mid + 1 + j));
+      for (size_type j = 0; j <= rn; ++j)
+      {
+        r->children[j] = p->children[mid + 1 + j];
+        r->children[j]->parent = r;
+        r->children[j]->pos = static_cast<unsigned short>(j);
+      }
+      r->count = static_cast<unsigned short>(rn);
+      p->count = static_cast<unsigned short>(mid);
+      __insert_parent(p, *p->key(mid), r);
+      zfwstl::destroy(p->key(mid));
+    }
+    template <class InputIterator>
+    void __insert_range(InputIterator first, InputIterator last, bool unique, zfwstl::input_iterator_tag)
+    {
+      for (; first != last; ++first)
+        __insert_rightmost_or_search(*first, unique);
+    }
+    template <class ForwardIterator>
+    void __insert_range(ForwardIterator first, ForwardIterator last, bool unique, zfwstl::forward_iterator_tag)
+    {
+      size_type n = zfwstl::distance(first, last);
+      THROW_LENGTH_ERROR_IF(node_count > max_size() - n, "btree<T, Comp>'s size too big");
+      size_type count = 0;
+      if (node_count == 0 && n > 1 && __sorted_count(first, last, unique, count))
+      {
+        __build_sorted(first, last, count, unique);
+        return;
+      }
+      for (; n > 0; --n, ++first)
+        __insert_rightmost_or_search(*first, unique);
+    }
+    // 新值排在当前最大键之后(unique 要求严格大于)时直接追加到最右叶节点，否则从根向下查找插入点
+    void __insert_rightmost_or_search(const value_type &v, bool unique)
+    {
+      if (node_count != 0)
+      {
+        const key_type &max_key = key(last_leaf, last_leaf->count - 1);
+        if (unique ? key_compare(max_key, KeyOfValue()(v)) : !key_compare(KeyOfValue()(v), max_key))
+        {
+          __insert_at(last_leaf, last_leaf->count, v);
+          return;
+        }
+      }
+      if (unique)
+        __insert_unique(v);
+      else
+        __insert_equal(v);
+    }
+    // [first, last) 是否按 key_compare 非降序排列；是则给出元素个数(unique 时相邻重复只算一个)
+    template <class ForwardIterator>
+    bool __sorted_count(ForwardIterator first, ForwardIterator last, bool unique, size_type &count) const
+    {
+      count = 1;
+      ForwardIterator prev = first;
+      for (++first; first != last; prev = first, ++first)
+      {
+        if (key_compare(KeyOfValue()(*first), KeyOfValue()(*prev)))
+          return false;
+        if (!unique || key_compare(KeyOfValue()(*prev), KeyOfValue()(*first)))
+          ++count;
+      }
+      return true;
+    }
+    /**
+     * 由排好序的区间 O(n) 自底向上建树(要求树为空)：
+     * n 个元素均分到 ceil(n / leaf_slots) 个叶节点，每层再把节点均分到 ceil(m / (internal_slots + 1)) 个父节点，
+     * 均分保证(多于一个节点时)每个节点都不低于下限；分隔键取右侧子树的最小键
+     */
+    template <class ForwardIterator>
+    void __build_sorted(ForwardIterator first, ForwardIterator last, size_type n, bool unique)
+    {
+      const size_type leaves = (n + leaf_slots - 1) / leaf_slots;
+      zfwstl::vector<base_ptr> level;
+      zfwstl::vector<base_ptr> internals; // 每个内部节点至少两个子节点，总数少于叶节点数
+      level.reserve(leaves);
+      internals.reserve(leaves);
+      try
+      {
+        leaf_node *prev = nullptr;
+        for (size_type l = 0; l < leaves; ++l)
+        {
+          leaf_node *x = create_leaf();
+          x->prev = prev;
+          if (prev)
+            prev->next = x;
+          else
+            first_leaf = x;
+          prev = last_leaf = x;
+          level.push_back(x);
+          const size_type cnt = n / leaves + (l < n % leaves ? 1 : 0);
+          for (size_type c = 0; c < cnt; ++c)
+          {
+            zfwstl::construct(x->value(c), *first);
+            ++x->count;
+            for (++first; unique && first != last && !key_compare(key(x, c), KeyOfValue()(*first)); ++first)
+              ;
+          }
+        }
+        while (level.size() > 1)
+        {
+          const size_type m = level.size();
+          const size_type parents = (m + internal_slots) / (internal_slots + 1);
+          zfwstl::vector<base_ptr> up;
+          up.reserve(parents);
+          for (size_type p = 0, idx = 0; p < parents; ++p)
+          {
+            internal_node *q = create_internal();
+            internals.push_back(q);
+            up.push_back(q);
+            const size_type cnt = m / parents + (p < m % parents ? 1 : 0);
+            for (size_type c = 0; c < cnt; ++c, ++idx)
+            {
+              base_ptr ch = level[idx];
+              if (c > 0)
+              {
+                zfwstl::construct(q->key(c - 1), __min_key(ch));
+                ++q->count;
+              }
+              q->children[c] = ch;
+              ch->parent = q;
+              ch->pos = static_cast<unsigned short>(c);
+            }
+          }
+          level.swap(up);
+        }
+      }
+      catch (...)
+      {
+        for (size_type i = 0; i < internals.size(); ++i)
+          destroy_node(internals[i]);
+        for (leaf_node *x = first_leaf; x;)
+        {
+          leaf_node *nx = x->next;
+          destroy_node(x);
+          x = nx;
+        }
+        first_leaf = last_leaf = nullptr;
+        throw;
+      }
+      root_node = level[0];
+      node_count = n;
+    }
+    static const key_type &__min_key(base_ptr x)
+    {
+      while (!x->leaf)
+        x = as_internal(x)->children[0];
+      return key(as_leaf(x), 0);
+    }
+
+    //==================删除辅助==================
+    void __erase_subtree(base_ptr x)
+    {
+      if (!x->leaf)
+      {
+        internal_node *n = as_internal(x);
+        for (size_type i = 0; i <= n->count; ++i)
+          __erase_subtree(n->children[i]);
+      }
+      destroy_node(x);
+    }
+    /**
+     * 删除叶节点 x 的第 i 个元素，返回其后继。x 低于下限时：
+     * 兄弟多于下限则借一个元素(同时更新父节点的分隔键)，否则与兄弟合并，并从父节点删去一个分隔键，
+     * 父节点低于下限时同样借或合并，一直到根；根只剩一个子节点时树高减一
+     * (tl, ti) 跟踪后继元素在借、合并过程中的位置
+     */
+    iterator __erase_at(leaf_node *x, size_type i)
+    {
+      zfwstl::destroy(x->value(i));
+      for (size_type j = i; j + 1 < x->count; ++j)
+        relocate(x->value(j), x->value(j + 1));
+      --x->count;
+      --node_count;
+      leaf_node *tl = x;
+      size_type ti = i;
+      if (x == root_node)
+      {
+        if (x->count == 0)
+        {
+          leaf_allocator::deallocate(x);
+          root_node = nullptr;
+          first_leaf = last_leaf = nullptr;
+          return iterator();
+        }
+      }
+      else if (x->count < leaf_min)
+        __rebalance_leaf(x, tl, ti);
+      return __make_iter(tl, ti);
+    }
+    void __rebalance_leaf(leaf_node *x, leaf_node *&tl, size_type &ti)
+    {
+      internal_node *p = as_internal(x->parent);
+      const size_type i = x->pos;
+      leaf_node *ls = i > 0 ? as_leaf(p->children[i - 1]) : nullptr;
+      leaf_node *rs = i < p->count ? as_leaf(p->children[i + 1]) : nullptr;
+      if (ls && ls->count > leaf_min)
+      {
+        // 借左兄弟的最后一个元素
+        for (size_type j = x->count; j > 0; --j)
+          relocate(x->value(j), x->value(j - 1));
+        relocate(x->value(0), ls->value(ls->count - 1));
+        --ls->count;
+        ++x->count;
+        __replace_key(p, i - 1, key(x, 0));
+        if (tl == x)
+          ++ti;
+      }
+      else if (rs && rs->count > leaf_min)
+      {
+        // 借右兄弟的第一个元素
+        relocate(x->value(x->count), rs->value(0));
+        ++x->count;
+        for (size_type j = 0; j + 1 < rs->count; ++j)
+          relocate(rs->value(j), rs->value(j + 1));
+        --rs->count;
+        __replace_key(p, i, key(rs, 0));
+      }
+      else if (ls)
+      {
+        if (tl == x)
+        {
+          tl = ls;
+          ti += ls->count;
+        }
+        __merge_leaf(ls, x);
+      }
+      else
+        __merge_leaf(x, rs);
+    }
+    // 相邻叶节点 b 并入 a，再从父节点删去二者之间的分隔键
+    void __merge_leaf(leaf_node *a, leaf_node *b)
+    {
+      for (size_type j = 0; j < b->count; ++j)
+        relocate(a->value(a->count + j), b->value(j));
+      a->count = static_cast<unsigned short>(a->count + b->count);
+      a->next = b->next;
+      if (b->next)
+        b->next->prev = a;
+      else
+        last_leaf = a;
+      internal_node *p = as_internal(a->parent);
+      const size_type i = a->pos;
+      leaf_allocator::deallocate(b);
+      __remove_from_internal(p, i);
+      __rebalance_internal(p);
+    }
+    // 删去内部节点 p 的第 i 个分隔键及其右侧的子节点 children[i + 1]
+    void __remove_from_internal(internal_node *p, size_type i)
+    {
+      zfwstl::destroy(p->key(i));
+      for (size_type j = i; j + 1 < p->count; ++j)
+        relocate(p->key(j), p->key(j + 1));
+      for (size_type j = i + 1; j < p->count; ++j)
+      {
+        p->children[j] = p->children[j + 1];
+        p->children[j]->pos = static_cast<unsigned short>(j);
+      }
+      --p->count;
+    }
+    void __replace_key(internal_node *p, size_type i, const key_type &k)
+    {
+      zfwstl::destroy(p->key(i));
+      zfwstl::construct(p->key(i), k);
+    }
+    void __rebalance_internal(internal_node *x)
+    {
+      if (x == root_node)
+      {
+        if (x->count == 0)
+        {
+          root_node = x->children[0];
+          root_node->parent = nullptr;
+          root_node->pos = 0;
+          internal_allocator::deallocate(x);
+        }
+        return;
+      }
+      if (x->count >= internal_min)
+        return;
+      internal_node *p = as_internal(x->parent);
+      const size_type i = x->pos;
+      internal_node *ls = i > 0 ? as_internal(p->children[i - 1]) : nullptr;
+      internal_node *rs = i < p->count ? as_internal(p->children[i + 1]) : nullptr;
+      if (ls && ls->count > internal_min)
+      {
+        // 右旋：父节点的分隔键下移到 x 最前，左兄弟的最后一个键上移，最后一个子节点转给 x
+        for (size_type j = x->count; j > 0; --j)
+          relocate(x->key(j), x->key(j - 1));
+        for (size_type j = x->count + 1; j > 0; --j)
+        {
+          x->children[j] = x->children[j - 1];
+          x->children[j]->pos = static_cast<unsigned short>(j);
+        }
+        relocate(x->key(0), p->key(i - 1));
+        relocate(p->key(i - 1), ls->key(ls->count - 1));
+        x->children[0] = ls->children[ls->count];
+        x->children[0]->parent = x;
+        x->children[0]->pos = 0;
+        --ls->count;
+        ++x->count;
+      }
+      else if (rs && rs->count > internal_min)
+      {
+        // 左旋：父节点的分隔键下移到 x 末尾，右兄弟的第一个键上移，第一个子节点转给 x
+        relocate(x->key(x->count), p->key(i));
+        relocate(p->key(i), rs->key(0));
+        x->children[x->count + 1] = rs->children[0];
+        x->children[x->count + 1]->parent = x;
+        x->children[x->count + 1]->pos = static_cast<unsigned short>(x->count + 1);
+        ++x->count;
+        for (size_type j = 0; j + 1 < rs->count; ++j)
+          relocate(rs->key(j), rs->key(j + 1));
+        for (size_type j = 0; j < rs->count; ++j)
+        {
+          rs->children[j] = rs->children[j + 1];
+          rs->children[j]->pos = static_cast<unsigned short>(j);
+        }
+        --rs->count;
+      }
+      else if (ls)
+        __merge_internal(ls, x);
+      else
+        __merge_internal(x, rs);
+    }
+    // 相邻内部节点 b 并入 a：父节点的分隔键下移到二者之间
+    void __merge_internal(internal_node *a, internal_node *b)
+    {
+      internal_node *p = as_internal(a->parent);
+      const size_type i = a->pos;
+      zfwstl::construct(a->key(a->count), zfwstl::move(*p->key(i)));
+      for (size_type j = 0; j < b->count; ++j)
+        relocate(a->key(a->count + 1 + j), b->key(j));
+      for (size_type j = 0; j <= b->count; ++j)
+      {
+        base_ptr ch = b->children[j];
+        a->children[a->count + 1 + j] = ch;
+        ch->parent = a;
+        ch->pos = static_cast<unsigned short>(a->count + 1 + j);
+      }
+      a->count = static_cast<unsigned short>(a->count + b->count + 1);
+      internal_allocator::deallocate(b);
+      __remove_from_internal(p, i);
+      __rebalance_internal(p);
+    }
+
+    //==================统计与校验==================
+    size_type __bytes_used(base_ptr x) const
+    {
+      if (x->leaf)
+        return sizeof(leaf_node);
+      size_type n = sizeof(internal_node);
+      for (size_type i = 0; i <= x->count; ++i)
+        n += __bytes_used(as_internal(x)->children[i]);
+      return n;
+    }
+    // 子树中的键都应在 [lo, hi] 内(nullptr 表示无界)
+    bool __verify_node(base_ptr x, size_type depth, size_type &leaf_depth, leaf_node *&prev, size_type &n,
+                       const key_type *lo = nullptr, const key_type *hi = nullptr) const
+    {
+      if (x->leaf)
+      {
+        leaf_node *l = as_leaf(x);
+        if (l->count == 0 || l->count > leaf_slots || l->prev != prev || (prev ? prev->next != l : first_leaf != l))
+          return false;
+        if (leaf_depth == static_cast<size_type>(-1))
+          leaf_depth = depth;
+        if (leaf_depth != depth)
+          return false;
+        if ((lo && key_compare(key(l, 0), *lo)) || (hi && key_compare(*hi, key(l, l->count - 1))))
+          return false;
+        prev = l;
+        n += l->count;
+        return true;
+      }
+      internal_node *q = as_internal(x);
+      if (q->count == 0 || q->count > internal_slots || (x != root_node && q->count < internal_min))
+        return false;
+      for (size_type i = 0; i <= q->count; ++i)
+      {
+        base_ptr ch = q->children[i];
+        if (ch->parent != x || ch->pos != i)
+          return false;
+        if (i > 0 && i < q->count && key_compare(*q->key(i), *q->key(i - 1)))
+          return false;
+        const key_type *clo = i == 0 ? lo : q->key(i - 1);
+        const key_type *chi = i == q->count ? hi : q->key(i);
+        if (!__verify_node(ch, depth + 1, leaf_depth, prev, n, clo, chi))
+          return false;
+      }
+      return true;
+    }
+  };
+
+  // 重载比较操作符
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+  bool operator==(const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &lhs, const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &rhs)
+  {
+    return lhs.size() == rhs.size() && zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+  bool operator<(const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &lhs, const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &rhs)
+  {
+    return zfwstl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+  bool operator!=(const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &lhs, const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+  bool operator>(const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &lhs, const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &rhs)
+  {
+    return rhs < lhs;
+  }
+
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+  bool operator<=(const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &lhs, const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+  bool operator>=(const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &lhs, const btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+  // 重载 zfwstl 的 swap
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+  void swap(btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &lhs, btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes> &rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif // !ZFWSTL_BTREE_H_
@@ -0,0 +1,174 @@
+#ifndef ZFWSTL_BTREE_MAP_H_
+#define ZFWSTL_BTREE_MAP_H_
+/**
+ * btree_map: key, value
+ * 接口与 map 相同，底层为 B+ tree：一个节点存放多个元素，查找、区间扫描对 cache 更友好，内存开销更小
+ * 注意：与 map 不同，任何插入、删除都可能使迭代器、指针和引用失效；erase 返回被删元素的后继
+ */
+#include <cstddef>             //for size_t, ptrdiff_t
+#include "../src/functional.h" //for binary_function, less,select1st
+#include "btree.h"
+#include "../src/util.h" //for  pair<iterator, bool>
+namespace zfwstl
+{
+
+  template <class Key, class T, class Compare = zfwstl::less<Key>, class Alloc = zfwstl::alloc>
+  class btree_map
+  {
+  public:
+    typedef Key key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef zfwstl::pair<const Key, T> value_type;
+    typedef Compare key_compare;
+    class value_compare : public binary_function<value_type, value_type, bool>
+    {
+      friend class btree_map<Key, T, Compare, Alloc>;
+
+    private:
+      Compare comp;
+      value_compare(Compare c) : comp(c) {}
+
+    public:
+      bool operator()(const value_type &lhs, const value_type &rhs) const
+      {
+        return comp(lhs.first, rhs.first); // 比较键值的大小
+      }
+    };
+
+  private:
+    typedef btree<key_type, value_type, zfwstl::select1st<value_type>, key_compare, Alloc> rep_type;
+    rep_type t; // 采用B+树表现btree_map
+  public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    btree_map() : t(Compare()) {}
+    explicit btree_map(const Compare &comp) : t(comp) {}
+    // btree_map不允许相同键值存在->insert_unique
+    template <class InputIter>
+    btree_map(InputIter first, InputIter last) : t(Compare()) { t.insert_unique(first, last); }
+    template <class InputIter>
+    btree_map(InputIter first, InputIter last, const Compare &comp) : t(comp) { t.insert_unique(first, last); }
+    btree_map(std::initializer_list<value_type> ilist) : t()
+    {
+      t.insert_unique(ilist.begin(), ilist.end());
+    }
+    btree_map(const btree_map &rhs) : t(rhs.t) {}
+    btree_map(btree_map &&rhs) noexcept : t(zfwstl::move(rhs.t)) {}
+
+    btree_map &operator=(const btree_map &x)
+    {
+      t = x.t;
+      return *this;
+    }
+    btree_map &operator=(btree_map &&x) noexcept
+    {
+      t = zfwstl::move(x.t);
+      return *this;
+    }
+    btree_map &operator=(std::initializer_list<value_type> ilist)
+    {
+      t.clear();
+      t.insert_unique(ilist.begin(), ilist.end());
+      return *this;
+    }
+
+  public:
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return value_compare(t.key_comp()); }
+    iterator begin() { return t.begin(); }
+    const_iterator begin() const { return t.begin(); }
+    iterator end() { return t.end(); }
+    const_iterator end() const { return t.end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+    bool empty() const noexcept { return t.empty(); }
+    size_type size() const noexcept { return t.size(); }
+    size_type max_size() const noexcept { return t.max_size(); }
+    T &operator[](const key_type &k) { return (*((insert(value_type(k, T()))).first)).second; }
+    void swap(btree_map &x) noexcept { t.swap(x.t); }
+    //==================插入删除操作==================
+    void clear() { t.clear(); }
+
+    typedef zfwstl::pair<iterator, bool> pair_iterator_bool;
+
+    pair_iterator_bool insert(const value_type &x) { return t.insert_unique(x); }
+    pair_iterator_bool insert(value_type &&x) { return t.insert_unique(zfwstl::move(x)); }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last)
+    {
+      t.insert_unique(first, last);
+    }
+    iterator erase(const_iterator position) { return t.erase(position); }
+    size_type erase(const key_type &x) { return t.erase_unique(x); }
+    iterator erase(const_iterator first, const_iterator last) { return t.erase(first, last); }
+
+    iterator find(const key_type &x) { return t.find(x); }
+    const_iterator find(const key_type &x) const { return t.find(x); }
+    size_type count(const key_type &x) const { return t.count_unique(x); }
+    iterator lower_bound(const key_type &x) { return t.lower_bound(x); }
+    iterator upper_bound(const key_type &x) { return t.upper_bound(x); }
+    const_iterator lower_bound(const key_type &x) const { return t.lower_bound(x); }
+    const_iterator upper_bound(const key_type &x) const { return t.upper_bound(x); }
+    zfwstl::pair<iterator, iterator>
+    equal_range(const key_type &x) { return t.equal_range(x); }
+    zfwstl::pair<const_iterator, const_iterator>
+    equal_range(const key_type &x) const { return t.equal_range(x); }
+    // Compare 透明(如 less<>)时，以下重载接受任何可与 key_type 比较的键，查找时不构造临时 key_type
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator find(const K &x) { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K &x) const { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count(const K &x) const { return t.count_unique(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator lower_bound(const K &x) { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K &x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator upper_bound(const K &x) { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K &x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &x) { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const K &x) const { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value && !std::is_convertible<const K &, const_iterator>::value, int>::type = 0>
+    size_type erase(const K &x) { return t.erase_unique(x); }
+
+  public:
+    // 节点占用的字节数，用于与 map 比较内存开销
+    size_type bytes_used() const { return t.bytes_used(); }
+    bool __btree_verify() const { return t.__btree_verify(); }
+
+    friend bool operator==(const btree_map &lhs, const btree_map &rhs) { return lhs.t == rhs.t; }
+    friend bool operator!=(const btree_map &lhs, const btree_map &rhs) { return lhs.t != rhs.t; }
+    friend bool operator<(const btree_map &lhs, const btree_map &rhs) { return lhs.t < rhs.t; }
+    friend bool operator>(const btree_map &lhs, const btree_map &rhs) { return lhs.t > rhs.t; }
+    friend bool operator<=(const btree_map &lhs, const btree_map &rhs) { return lhs.t <= rhs.t; }
+    friend bool operator>=(const btree_map &lhs, const btree_map &rhs) { return lhs.t >= rhs.t; }
+  };
+
+  template <class Key, class T, class Compare, class Alloc>
+  void swap(btree_map<Key, T, Compare, Alloc> &lhs, btree_map<Key, T, Compare, Alloc> &rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif // !ZFWSTL_BTREE_MAP_H_
@@ -0,0 +1,153 @@
+#ifndef ZFWSTL_BTREE_SET_H_
+#define ZFWSTL_BTREE_SET_H_
+/**
+ * btree_set集合: key即value
+ * 接口与 set 相同，底层为 B+ tree；底层迭代器：const iterator，也就是不能修改集合中插入的元素
+ * 注意：任何插入、删除都可能使迭代器、指针和引用失效；erase 返回被删元素的后继
+ */
+#include <cstddef>             //for size_t, ptrdiff_t
+#include "../src/functional.h" //for less<>, identity
+#include "btree.h"
+#include "../src/util.h" //for  pair<iterator, bool>, move()
+namespace zfwstl
+{
+
+  template <class Key, class Compare = zfwstl::less<Key>, class Alloc = zfwstl::alloc>
+  class btree_set
+  {
+  public:
+    typedef Key key_type;
+    typedef Key value_type;
+    // 注意，key与value使用同一个比较函数
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+  private:
+    typedef btree<key_type, value_type, zfwstl::identity<value_type>, key_compare, Alloc> rep_type;
+    rep_type t; // 采用B+树表现btree_set
+
+  public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::const_iterator iterator; //!!底层迭代器const_iterator
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::const_reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    btree_set() : t(Compare()) {}
+    explicit btree_set(const Compare &comp) : t(comp) {}
+    btree_set(std::initializer_list<value_type> ilist) : t()
+    {
+      t.insert_unique(ilist.begin(), ilist.end());
+    }
+    // btree_set不允许相同键值存在->insert_unique
+    template <class InputIter>
+    btree_set(InputIter first, InputIter last) : t(Compare()) { t.insert_unique(first, last); }
+    template <class InputIter>
+    btree_set(InputIter first, InputIter last, const Compare &comp) : t(comp) { t.insert_unique(first, last); }
+    btree_set(const btree_set &other) : t(other.t) {}
+    btree_set(btree_set &&other) noexcept : t(zfwstl::move(other.t)) {}
+
+    btree_set &operator=(const btree_set &x)
+    {
+      t = x.t;
+      return *this;
+    }
+    btree_set &operator=(btree_set &&x) noexcept
+    {
+      t = zfwstl::move(x.t);
+      return *this;
+    }
+    btree_set &operator=(std::initializer_list<value_type> ilist)
+    {
+      t.clear();
+      t.insert_unique(ilist.begin(), ilist.end());
+      return *this;
+    }
+
+  public:
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return t.key_comp(); }
+    iterator begin() const { return t.begin(); }
+    iterator end() const { return t.end(); }
+    reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+    bool empty() const noexcept { return t.empty(); }
+    size_type size() const noexcept { return t.size(); }
+    size_type max_size() const noexcept { return t.max_size(); }
+    void swap(btree_set &x) noexcept { t.swap(x.t); }
+    //==================插入删除操作==================
+    void clear() { t.clear(); }
+
+    typedef zfwstl::pair<iterator, bool> pair_iterator_bool;
+
+    pair_iterator_bool insert(const value_type &x)
+    {
+      zfwstl::pair<typename rep_type::iterator, bool> p = t.insert_unique(x);
+      return pair_iterator_bool(p.first, p.second);
+    }
+    pair_iterator_bool insert(value_type &&x)
+    {
+      zfwstl::pair<typename rep_type::iterator, bool> p = t.insert_unique(zfwstl::move(x));
+      return pair_iterator_bool(p.first, p.second);
+    }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last)
+    {
+      t.insert_unique(first, last);
+    }
+    iterator erase(const_iterator position) { return t.erase(position); }
+    size_type erase(const key_type &x) { return t.erase_unique(x); }
+    iterator erase(const_iterator first, const_iterator last) { return t.erase(first, last); }
+
+    iterator find(const key_type &x) const { return t.find(x); }
+    size_type count(const key_type &x) const { return t.count_unique(x); }
+    iterator lower_bound(const key_type &x) const { return t.lower_bound(x); }
+    iterator upper_bound(const key_type &x) const { return t.upper_bound(x); }
+    zfwstl::pair<iterator, iterator>
+    equal_range(const key_type &x) const
+    {
+      return t.equal_range(x);
+    }
+    // Compare 透明(如 less<>)时，以下重载接受任何可与 key_type 比较的键，查找时不构造临时 key_type
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator find(const K &x) const { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count(const K &x) const { return t.count_unique(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator lower_bound(const K &x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator upper_bound(const K &x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &x) const { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value && !std::is_convertible<const K &, const_iterator>::value, int>::type = 0>
+    size_type erase(const K &x) { return t.erase_unique(x); }
+
+  public:
+    size_type bytes_used() const { return t.bytes_used(); }
+    bool __btree_verify() const { return t.__btree_verify(); }
+
+    friend bool operator==(const btree_set &lhs, const btree_set &rhs) { return lhs.t == rhs.t; }
+    friend bool operator!=(const btree_set &lhs, const btree_set &rhs) { return lhs.t != rhs.t; }
+    friend bool operator<(const btree_set &lhs, const btree_set &rhs) { return lhs.t < rhs.t; }
+    friend bool operator>(const btree_set &lhs, const btree_set &rhs) { return lhs.t > rhs.t; }
+    friend bool operator<=(const btree_set &lhs, const btree_set &rhs) { return lhs.t <= rhs.t; }
+    friend bool operator>=(const btree_set &lhs, const btree_set &rhs) { return lhs.t >= rhs.t; }
+  };
+
+  template <class Key, class Compare, class Alloc>
+  void swap(btree_set<Key, Compare, Alloc> &lhs, btree_set<Key, Compare, Alloc> &rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif // !ZFWSTL_BTREE_SET_H_
@@ -0,0 +1,425 @@
+#ifndef ZFWSTL_CONCURRENT_HASH_MAP_H_
+#define ZFWSTL_CONCURRENT_HASH_MAP_H_
+/**
+ * concurrent_hash_map: 可被多个线程同时读写的哈希表(键唯一)
+ * 分段锁(lock striping)：整张表分成 2 的幂个段(segment)，每段是一张独立的开链哈希表，
+ * 节点与 bucket 沿用 hashtable.h 的 __hashtable_node 与 vector<node*>，bucket 下标沿用桶策略(缺省 pow2)
+ *   键先经 pow2_bucket_policy::mix 打散，高半部分的位决定段，段内 bucket 由桶策略决定，两者互不相关
+ *   每段一把读写自旋锁：查找取共享锁，不同段的写互不阻塞，同一段的读也可以并行
+ *   扩容按段进行：某段元素个数超过其 bucket 个数时，只在该段的独占锁内重排，其他段照常读写(并发扩容)
+ * 没有做无锁读：无锁读需要延迟回收被删除的节点(epoch / hazard pointer)，这里的读只持有所在段的共享锁
+ * 接口不返回迭代器或引用(解锁后可能失效)，而是复制出值，或在锁内调用传入的函数：
+ *   find(key, out) / contains(key) / visit(key, f)
+ *   insert(key, obj) / insert_or_assign(key, obj)：返回是否新插入
+ *   compute_if_absent(key, f)：键不存在时在锁内调用 f() 生成值并插入，返回(复制出的)值；同一个键的 f 只会被调用一次
+ *   erase(key)：返回删除的个数
+ *   for_each(f)：逐段在共享锁内遍历；size()：并发修改时只是近似值
+ * 段数在构造时决定(缺省 64)，大致取同时访问的线程数的几倍
+ */
+#include <cstddef>                   // for size_t
+#include <atomic>                    // for std::atomic
+#include <thread>                    // for std::this_thread::yield
+#include "hashtable.h"               // for __hashtable_node, pow2_bucket_policy
+#include "../src/memory/allocator.h" // 标准空间配置器
+#include "../src/memory/alloc.h"     // for multithreaded_alloc
+#include "../src/memory/construct.h" // for construct(), destroy()
+#include "../src/functional.h"       // for hash, equal_to
+#include "../src/util.h"             // for pair, move, forward, ZFWSTL_CACHE_LINE
+#include "../STL/vector.h"
+namespace zfwstl
+{
+  // 读写自旋锁：bit0 为写者持有，bit1 为有写者在等(此时不再放进新的读者，避免写者饿死)，其余位为读者个数
+  class shared_spin_lock
+  {
+    enum : unsigned
+    {
+      writer = 1u,
+      writer_waiting = 2u,
+      reader = 4u
+    };
+    std::atomic<unsigned> state;
+
+  public:
+    shared_spin_lock() noexcept : state(0) {}
+    shared_spin_lock(const shared_spin_lock &) = delete;
+    shared_spin_lock &operator=(const shared_spin_lock &) = delete;
+
+    void lock() noexcept
+    {
+      for (;;)
+      {
+        unsigned s = state.load(std::memory_order_relaxed);
+        if ((s & ~writer_waiting) == 0)
+        {
+          if (state.compare_exchange_weak(s, writer, std::memory_order_acquire, std::memory_order_relaxed))
+            return;
+        }
+        else if (!(s & writer_waiting))
+          state.fetch_or(writer_waiting, std::memory_order_relaxed);
+        std::this_thread::yield();
+      }
+    }
+    void unlock() noexcept { state.fetch_and(~writer, std::memory_order_release); }
+
+    void lock_shared() noexcept
+    {
+      for (;;)
+      {
+        unsigned s = state.load(std::memory_order_relaxed);
+        if (!(s & (writer | writer_waiting)) &&
+            state.compare_exchange_weak(s, s + reader, std::memory_order_acquire, std::memory_order_relaxed))
+          return;
+        std::this_thread::yield();
+      }
+    }
+    void unlock_shared() noexcept { state.fetch_sub(reader, std::memory_order_release); }
+  };
+
+  template <class Key, class T, class HashFcn = zfwstl::hash<Key>, class EqualKey = zfwstl::equal_to<Key>,
+            class Alloc = zfwstl::multithreaded_alloc, class BucketPolicy = zfwstl::pow2_bucket_policy>
+  class concurrent_hash_map
+  {
+  public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef zfwstl::pair<const Key, T> value_type;
+    typedef HashFcn hasher;
+    typedef EqualKey key_equal;
+    typedef size_t size_type;
+
+  private:
+    typedef __hashtable_node<value_type> node;
+    typedef zfwstl::simple_allocator<node, Alloc> node_allocator;
+    typedef zfwstl::vector<node *, Alloc> bucket_vector;
+
+    struct alignas(ZFWSTL_CACHE_LINE) segment
+    {
+      mutable shared_spin_lock lock;
+      std::atomic<size_type> count; // 只在独占锁内修改，size() 不加锁读取
+      bucket_vector buckets;
+      segment() : count(0) {}
+    };
+    typedef zfwstl::simple_allocator<char, Alloc> byte_allocator;
+
+    // 作用域内持有共享锁 / 独占锁
+    struct shared_guard
+    {
+      const segment &seg;
+      explicit shared_guard(const segment &s) : seg(s) { seg.lock.lock_shared(); }
+      ~shared_guard() { seg.lock.unlock_shared(); }
+    };
+    struct unique_guard
+    {
+      const segment &seg;
+      explicit unique_guard(const segment &s) : seg(s) { seg.lock.lock(); }
+      ~unique_guard() { seg.lock.unlock(); }
+    };
+
+    hasher hash;
+    key_equal equals;
+    segment *segs;   // 按缓存行对齐的段数组
+    char *raw;       // segs 所在的原始内存
+    size_type nsegs; // 段数，2 的幂
+    size_type seg_mask;
+
+  public:
+    explicit concurrent_hash_map(size_type bucket_hint = 0, size_type segments = 64,
+                                 const hasher &hf = hasher(), const key_equal &eql = key_equal())
+        : hash(hf), equals(eql), segs(nullptr), raw(nullptr), nsegs(1), seg_mask(0)
+    {
+      while (nsegs < segments && nsegs < (static_cast<size_type>(1) << (sizeof(size_type) * 4)))
+        nsegs <<= 1;
+      seg_mask = nsegs - 1;
+      raw = byte_allocator::allocate(nsegs * sizeof(segment) + ZFWSTL_CACHE_LINE);
+      const size_t addr = reinterpret_cast<size_t>(raw);
+      segs = reinterpret_cast<segment *>((addr + ZFWSTL_CACHE_LINE - 1) & ~static_cast<size_t>(ZFWSTL_CACHE_LINE - 1));
+      size_type constructed = 0; // 构造函数已返回的段数，配置 bucket 失败的那一段也包括在内
+      try
+      {
+        const size_type per_seg = BucketPolicy::next_size(bucket_hint / nsegs + 1);
+        while (constructed < nsegs)
+        {
+          segment *seg = ::new (static_cast<void *>(segs + constructed)) segment();
+          ++constructed;
+          bucket_vector tmp(per_seg, static_cast<node *>(nullptr));
+          seg->buckets.swap(tmp);
+        }
+      }
+      catch (...)
+      {
+        for (size_type i = 0; i < constructed; ++i)
+          segs[i].~segment();
+        byte_allocator::deallocate(raw, nsegs * sizeof(segment) + ZFWSTL_CACHE_LINE);
+        throw;
+      }
+    }
+    concurrent_hash_map(const concurrent_hash_map &) = delete;
+    concurrent_hash_map &operator=(const concurrent_hash_map &) = delete;
+    ~concurrent_hash_map()
+    {
+      clear();
+      for (size_type i = 0; i < nsegs; ++i)
+        segs[i].~segment();
+      byte_allocator::deallocate(raw, nsegs * sizeof(segment) + ZFWSTL_CACHE_LINE);
+    }
+
+    hasher hash_funct() const { return hash; }
+    key_equal key_eq() const { return equals; }
+    size_type segment_count() const noexcept { return nsegs; }
+    size_type size() const noexcept
+    {
+      size_type n = 0;
+      for (size_type i = 0; i < nsegs; ++i)
+        n += segs[i].count.load(std::memory_order_relaxed);
+      return n;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    size_type bucket_count() const
+    {
+      size_type n = 0;
+      for (size_type i = 0; i < nsegs; ++i)
+      {
+        shared_guard g(segs[i]);
+        n += segs[i].buckets.size();
+      }
+      return n;
+    }
+
+    // 查找：找到时把值复制到 out
+    bool find(const key_type &key, mapped_type &out) const
+    {
+      const size_type h = hash(key);
+      const segment &seg = segment_of(h);
+      shared_guard g(seg);
+      const node *cur = find_in(seg, h, key);
+      if (cur == nullptr)
+        return false;
+      out = cur->val.second;
+      return true;
+    }
+    bool contains(const key_type &key) const
+    {
+      const size_type h = hash(key);
+      const segment &seg = segment_of(h);
+      shared_guard g(seg);
+      return find_in(seg, h, key) != nullptr;
+    }
+    size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+    // 找到时在共享锁内调用 f(const value_type&)，适合只读取值的一部分、不必整个复制的场合
+    template <class F>
+    bool visit(const key_type &key, F f) const
+    {
+      const size_type h = hash(key);
+      const segment &seg = segment_of(h);
+      shared_guard g(seg);
+      const node *cur = find_in(seg, h, key);
+      if (cur == nullptr)
+        return false;
+      f(cur->val);
+      return true;
+    }
+
+    // 键不存在时插入，返回是否插入
+    template <class M>
+    bool insert(const key_type &key, M &&obj)
+    {
+      const size_type h = hash(key);
+      segment &seg = segment_of(h);
+      unique_guard g(seg);
+      if (find_in(seg, h, key) != nullptr)
+        return false;
+      link_node(seg, h, create_node(key, zfwstl::forward<M>(obj)));
+      return true;
+    }
+    bool insert(const value_type &value) { return insert(value.first, value.second); }
+    // 键存在时赋新值，否则插入；返回是否插入
+    template <class M>
+    bool insert_or_assign(const key_type &key, M &&obj)
+    {
+      const size_type h = hash(key);
+      segment &seg = segment_of(h);
+      unique_guard g(seg);
+      node *cur = find_in(seg, h, key);
+      if (cur != nullptr)
+      {
+        cur->val.second = zfwstl::forward<M>(obj);
+        return false;
+      }
+      link_node(seg, h, create_node(key, zfwstl::forward<M>(obj)));
+      return true;
+    }
+    // 键存在时返回其值；否则在独占锁内调用 f() 生成值插入并返回。先用共享锁查一次，命中时不阻塞其他读者
+    // f 抛出异常时不插入
+    template <class F>
+    mapped_type compute_if_absent(const key_type &key, F f)
+    {
+      const size_type h = hash(key);
+      segment &seg = segment_of(h);
+      {
+        shared_guard g(seg);
+        const node *cur = find_in(seg, h, key);
+        if (cur != nullptr)
+          return cur->val.second;
+      }
+      unique_guard g(seg);
+      const node *cur = find_in(seg, h, key); // 释放共享锁后可能已被别的线程插入
+      if (cur != nullptr)
+        return cur->val.second;
+      node *tmp = create_node(key, f());
+      link_node(seg, h, tmp);
+      return tmp->val.second;
+    }
+
+    // 删除键值为 key 的元素，节点在解锁后再销毁以缩短临界区
+    size_type erase(const key_type &key)
+    {
+      const size_type h = hash(key);
+      segment &seg = segment_of(h);
+      node *victim = nullptr;
+      {
+        unique_guard g(seg);
+        node **link = &seg.buckets[bucket_of(seg, h)];
+        for (; *link != nullptr; link = &(*link)->next)
+        {
+          if (equals((*link)->val.first, key))
+          {
+            victim = *link;
+            *link = victim->next;
+            seg.count.store(seg.count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            break;
+          }
+        }
+      }
+      if (victim == nullptr)
+        return 0;
+      destroy_node(victim);
+      return 1;
+    }
+
+    // 逐段在共享锁内对每个元素调用 f(const value_type&)；遍历期间其他段可以被修改
+    template <class F>
+    void for_each(F f) const
+    {
+      for (size_type i = 0; i < nsegs; ++i)
+      {
+        shared_guard g(segs[i]);
+        for (size_type b = 0; b < segs[i].buckets.size(); ++b)
+          for (const node *cur = segs[i].buckets[b]; cur != nullptr; cur = cur->next)
+            f(cur->val);
+      }
+    }
+
+    void clear()
+    {
+      for (size_type i = 0; i < nsegs; ++i)
+      {
+        unique_guard g(segs[i]);
+        for (size_type b = 0; b < segs[i].buckets.size(); ++b)
+        {
+          node *cur = segs[i].buckets[b];
+          while (cur != nullptr)
+          {
+            node *next = cur->next;
+            destroy_node(cur);
+            cur = next;
+          }
+          segs[i].buckets[b] = nullptr;
+        }
+        segs[i].count.store(0, std::memory_order_relaxed);
+      }
+    }
+    // 预留能容纳 n 个元素的 bucket，逐段扩容
+    void reserve(size_type n)
+    {
+      const size_type per_seg = n / nsegs + 1;
+      for (size_type i = 0; i < nsegs; ++i)
+      {
+        unique_guard g(segs[i]);
+        if (per_seg > segs[i].buckets.size())
+          rehash_segment(segs[i], BucketPolicy::next_size(per_seg));
+      }
+    }
+
+  private:
+    segment &segment_of(size_type h) const
+    {
+      const size_type m = zfwstl::pow2_bucket_policy::mix(h);
+      return segs[(m >> (sizeof(size_type) * 4)) & seg_mask];
+    }
+    static size_type bucket_of(const segment &seg, size_type h) { return BucketPolicy::index(h, seg.buckets.size()); }
+
+    node *find_in(const segment &seg, size_type h, const key_type &key) const
+    {
+      node *cur = seg.buckets[bucket_of(seg, h)];
+      while (cur != nullptr && !equals(cur->val.first, key))
+        cur = cur->next;
+      return cur;
+    }
+
+    template <class M>
+    node *create_node(const key_type &key, M &&obj)
+    {
+      node *n = node_allocator::allocate(1);
+      n->next = nullptr;
+      try
+      {
+        zfwstl::construct(&n->val, key, zfwstl::forward<M>(obj));
+      }
+      catch (...)
+      {
+        node_allocator::deallocate(n, 1);
+        throw;
+      }
+      return n;
+    }
+    void destroy_node(node *n)
+    {
+      zfwstl::destroy(&n->val);
+      node_allocator::deallocate(n, 1);
+    }
+
+    // 在独占锁内把新节点挂到 bucket 头部；元素个数超过 bucket 个数时本段扩容
+    void link_node(segment &seg, size_type h, node *n)
+    {
+      const size_type cnt = seg.count.load(std::memory_order_relaxed) + 1;
+      if (cnt > seg.buckets.size())
+      {
+        const size_type new_n = BucketPolicy::next_size(cnt);
+        if (new_n > seg.buckets.size())
+        {
+          try
+          {
+            rehash_segment(seg, new_n);
+          }
+          catch (...)
+          { // 配置新 bucket 失败时不扩容，照常插入
+          }
+        }
+      }
+      node *&head = seg.buckets[bucket_of(seg, h)];
+      n->next = head;
+      head = n;
+      seg.count.store(cnt, std::memory_order_relaxed);
+    }
+
+    // 把本段的节点重新挂到 n 个 bucket 上(只改指针，不复制元素)
+    void rehash_segment(segment &seg, size_type n)
+    {
+      bucket_vector tmp(n, static_cast<node *>(nullptr));
+      for (size_type b = 0; b < seg.buckets.size(); ++b)
+      {
+        node *cur = seg.buckets[b];
+        while (cur != nullptr)
+        {
+          node *next = cur->next;
+          const size_type nb = BucketPolicy::index(hash(cur->val.first), n);
+          cur->next = tmp[nb];
+          tmp[nb] = cur;
+          cur = next;
+        }
+      }
+      seg.buckets.swap(tmp);
+    }
+  };
+} // namespace zfwstl
+#endif // !ZFWSTL_CONCURRENT_HASH_MAP_H_
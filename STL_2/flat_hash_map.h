@@ -0,0 +1,203 @@
+#ifndef ZFWSTL_FLAT_HASH_MAP_H_
+#define ZFWSTL_FLAT_HASH_MAP_H_
+/**
+ * flat_hash_map
+ * 底层为开放定址的 flat_hashtable，键值唯一，元素直接存放在连续数组中
+ * 与 unordered_map 的区别：
+ * 1. 扩容、rehash 会移动元素，任何插入都可能使迭代器、指针和引用失效
+ * 2. 迭代顺序与插入顺序无关
+ */
+#include <cstddef> //for size_t, ptrdiff_t
+#include <initializer_list>
+#include "flat_hashtable.h"
+#include "../src/functional.h" //for select1st, equal_to, hash
+#include "../src/util.h"       //for pair, move
+#include "../src/exceptdef.h"  //for THROW_OUT_OF_RANGE_IF
+namespace zfwstl
+{
+
+  template <class Key, class Tp, class HashFcn = zfwstl::hash<Key>, class EqualKey = zfwstl::equal_to<Key>, class Alloc = zfwstl::new_alloc>
+  class flat_hash_map
+  {
+    typedef flat_hashtable<zfwstl::pair<const Key, Tp>, Key, HashFcn, zfwstl::select1st<zfwstl::pair<const Key, Tp>>, EqualKey, Alloc> ht;
+    ht rep; // 底层机制flat hash table完成
+  public:
+    typedef typename ht::key_type key_type;
+    typedef typename ht::value_type value_type;
+    typedef Tp data_type;
+    typedef Tp mapped_type;
+    typedef typename ht::hasher hasher;
+    typedef typename ht::key_equal key_equal;
+    typedef typename ht::pointer pointer;
+    typedef typename ht::const_pointer const_pointer;
+    typedef typename ht::reference reference;
+    typedef typename ht::const_reference const_reference;
+    typedef typename ht::iterator iterator;
+    typedef typename ht::const_iterator const_iterator;
+    typedef typename ht::size_type size_type;
+    typedef typename ht::difference_type difference_type;
+
+  public:
+    // 缺省不配置任何空间，第一次插入时才配置
+    flat_hash_map() : rep(0, hasher(), key_equal()) {}
+    explicit flat_hash_map(size_type n) : rep(n, hasher(), key_equal()) {}
+    flat_hash_map(size_type n, const hasher &hf) : rep(n, hf, key_equal()) {}
+    flat_hash_map(size_type n, const hasher &hf, const key_equal &eql) : rep(n, hf, eql) {}
+    flat_hash_map(std::initializer_list<value_type> ilist,
+                  const hasher &hf = hasher(),
+                  const key_equal &equal = key_equal())
+        : rep(ilist.size(), hf, equal)
+    {
+      rep.insert_unique(ilist.begin(), ilist.end());
+    }
+    template <class InputIter>
+    flat_hash_map(InputIter f, InputIter l) : rep(0, hasher(), key_equal()) { rep.insert_unique(f, l); }
+    template <class InputIter>
+    flat_hash_map(InputIter f, InputIter l, size_type n) : rep(n, hasher(), key_equal()) { rep.insert_unique(f, l); }
+    template <class InputIter>
+    flat_hash_map(InputIter f, InputIter l, size_type n, const hasher &hf, const key_equal &eql = key_equal())
+        : rep(n, hf, eql) { rep.insert_unique(f, l); }
+
+    flat_hash_map(const flat_hash_map &rhs) : rep(rhs.rep) {}
+    flat_hash_map(flat_hash_map &&rhs) noexcept : rep(zfwstl::move(rhs.rep)) {}
+
+    flat_hash_map &operator=(const flat_hash_map &rhs)
+    {
+      rep = rhs.rep;
+      return *this;
+    }
+    flat_hash_map &operator=(flat_hash_map &&rhs) noexcept
+    {
+      rep = zfwstl::move(rhs.rep);
+      return *this;
+    }
+    flat_hash_map &operator=(std::initializer_list<value_type> ilist)
+    {
+      rep.clear();
+      rep.reserve(ilist.size());
+      rep.insert_unique(ilist.begin(), ilist.end());
+      return *this;
+    }
+
+    ~flat_hash_map() = default;
+
+    // 元素访问
+    Tp &operator[](const key_type &key)
+    {
+      return rep.find_or_emplace(key, key, Tp()).first->second;
+    }
+    Tp &operator[](key_type &&key)
+    {
+      return rep.find_or_emplace(key, zfwstl::move(key), Tp()).first->second;
+    }
+    Tp &at(const key_type &key)
+    {
+      iterator it = rep.find(key);
+      THROW_OUT_OF_RANGE_IF(it == rep.end(), "flat_hash_map<Key, T> no such element exists");
+      return it->second;
+    }
+    const Tp &at(const key_type &key) const
+    {
+      const_iterator it = rep.find(key);
+      THROW_OUT_OF_RANGE_IF(it == rep.end(), "flat_hash_map<Key, T> no such element exists");
+      return it->second;
+    }
+
+    hasher hash_funct() const { return rep.hash_fcn(); }
+    key_equal key_eq() const { return rep.key_eq(); }
+    iterator begin() { return rep.begin(); }
+    iterator end() { return rep.end(); }
+    const_iterator begin() const { return rep.begin(); }
+    const_iterator end() const { return rep.end(); }
+    const_iterator cbegin() const { return rep.cbegin(); }
+    const_iterator cend() const { return rep.cend(); }
+    size_type size() const { return rep.size(); }
+    bool empty() const { return rep.empty(); }
+    size_type max_size() const noexcept { return rep.max_size(); }
+    void swap(flat_hash_map &x) noexcept { rep.swap(x.rep); }
+
+    // 插入操作全部使用insert_unique(), 不允许键值重复
+    zfwstl::pair<iterator, bool> insert(const value_type &obj) { return rep.insert_unique(obj); }
+    zfwstl::pair<iterator, bool> insert(value_type &&obj) { return rep.insert_unique(zfwstl::move(obj)); }
+    template <class InputIter>
+    void insert(InputIter f, InputIter l) { rep.insert_unique(f, l); }
+    void insert(std::initializer_list<value_type> ilist) { rep.insert_unique(ilist.begin(), ilist.end()); }
+    template <class... Args>
+    zfwstl::pair<iterator, bool> emplace(Args &&...args) { return rep.emplace_unique(zfwstl::forward<Args>(args)...); }
+    // 键值已存在时不构造 mapped_type
+    template <class... Args>
+    zfwstl::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args)
+    {
+      iterator it = rep.find(key);
+      if (it != rep.end())
+        return zfwstl::pair<iterator, bool>(it, false);
+      return rep.find_or_emplace(key, key, Tp(zfwstl::forward<Args>(args)...));
+    }
+    template <class M>
+    zfwstl::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj)
+    {
+      iterator it = rep.find(key);
+      if (it != rep.end())
+      {
+        it->second = zfwstl::forward<M>(obj);
+        return zfwstl::pair<iterator, bool>(it, false);
+      }
+      return rep.find_or_emplace(key, key, Tp(zfwstl::forward<M>(obj)));
+    }
+
+    iterator find(const key_type &key) { return rep.find(key); }
+    const_iterator find(const key_type &key) const { return rep.find(key); }
+    size_type count(const key_type &key) const { return rep.count(key); }
+    bool contains(const key_type &key) const { return rep.count(key) != 0; }
+
+    size_type erase(const key_type &key) { return rep.erase_unique(key); }
+    // hasher 与 key_equal 都透明(如 hash<std::string> 搭配 equal_to<>)时的异构查找
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    iterator find(const K &key) { return rep.find(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    const_iterator find(const K &key) const { return rep.find(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    size_type count(const K &key) const { return rep.count(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    bool contains(const K &key) const { return rep.count(key) != 0; }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value && !std::is_convertible<const K &, const_iterator>::value, int>::type = 0>
+    size_type erase(const K &key) { return rep.erase_unique(key); }
+    iterator erase(const_iterator it) { return rep.erase(it); }
+    iterator erase(const_iterator first, const_iterator last) { return rep.erase(first, last); }
+    void clear() { rep.clear(); }
+
+  public:
+    void reserve(size_type n) { rep.reserve(n); }
+    void rehash(size_type n) { rep.rehash(n); }
+    size_type bucket_count() const { return rep.bucket_count(); }
+    float load_factor() const { return rep.load_factor(); }
+    float max_load_factor() const { return rep.max_load_factor(); }
+
+    friend bool operator==(const flat_hash_map &lhs, const flat_hash_map &rhs)
+    {
+      if (lhs.size() != rhs.size())
+        return false;
+      for (const auto &pair : lhs)
+      {
+        auto it = rhs.find(pair.first);
+        if (it == rhs.end() || !(it->second == pair.second))
+          return false;
+      }
+      return true;
+    }
+    friend bool operator!=(const flat_hash_map &lhs, const flat_hash_map &rhs)
+    {
+      return !(lhs == rhs);
+    }
+  };
+
+  template <class Key, class Tp, class HashFcn, class EqualKey, class Alloc>
+  void swap(flat_hash_map<Key, Tp, HashFcn, EqualKey, Alloc> &lhs,
+            flat_hash_map<Key, Tp, HashFcn, EqualKey, Alloc> &rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+
+}
+
+#endif // !ZFWSTL_FLAT_HASH_MAP_H_
@@ -0,0 +1,158 @@
+#ifndef ZFWSTL_FLAT_HASH_SET_H_
+#define ZFWSTL_FLAT_HASH_SET_H_
+/**
+ * flat_hash_set
+ * 底层为开放定址的 flat_hashtable，键值唯一
+ * 扩容、rehash 会移动元素，任何插入都可能使迭代器、指针和引用失效
+ */
+#include <cstddef> //for size_t, ptrdiff_t
+#include <initializer_list>
+#include "flat_hashtable.h"
+#include "../src/functional.h" //for identity, equal_to, hash
+#include "../src/util.h"       //for pair, move
+namespace zfwstl
+{
+
+  template <class Value, class HashFcn = zfwstl::hash<Value>, class EqualKey = zfwstl::equal_to<Value>, class Alloc = zfwstl::new_alloc>
+  class flat_hash_set
+  {
+    typedef flat_hashtable<Value, Value, HashFcn, zfwstl::identity<Value>, EqualKey, Alloc> ht;
+    ht rep; // 底层机制flat hash table完成
+  public:
+    typedef typename ht::key_type key_type;
+    typedef typename ht::value_type value_type;
+    typedef typename ht::hasher hasher;
+    typedef typename ht::key_equal key_equal;
+    typedef typename ht::const_pointer pointer;
+    typedef typename ht::const_pointer const_pointer;
+    typedef typename ht::const_reference reference;
+    typedef typename ht::const_reference const_reference;
+    typedef typename ht::const_iterator iterator; //!!元素不可修改，底层迭代器const_iterator
+    typedef typename ht::const_iterator const_iterator;
+    typedef typename ht::size_type size_type;
+    typedef typename ht::difference_type difference_type;
+
+  public:
+    flat_hash_set() : rep(0, hasher(), key_equal()) {}
+    explicit flat_hash_set(size_type n) : rep(n, hasher(), key_equal()) {}
+    flat_hash_set(size_type n, const hasher &hf) : rep(n, hf, key_equal()) {}
+    flat_hash_set(size_type n, const hasher &hf, const key_equal &eql) : rep(n, hf, eql) {}
+    flat_hash_set(std::initializer_list<value_type> ilist,
+                  const hasher &hf = hasher(),
+                  const key_equal &equal = key_equal())
+        : rep(ilist.size(), hf, equal)
+    {
+      rep.insert_unique(ilist.begin(), ilist.end());
+    }
+    template <class InputIter>
+    flat_hash_set(InputIter f, InputIter l) : rep(0, hasher(), key_equal()) { rep.insert_unique(f, l); }
+    template <class InputIter>
+    flat_hash_set(InputIter f, InputIter l, size_type n) : rep(n, hasher(), key_equal()) { rep.insert_unique(f, l); }
+    template <class InputIter>
+    flat_hash_set(InputIter f, InputIter l, size_type n, const hasher &hf, const key_equal &eql = key_equal())
+        : rep(n, hf, eql) { rep.insert_unique(f, l); }
+
+    flat_hash_set(const flat_hash_set &rhs) : rep(rhs.rep) {}
+    flat_hash_set(flat_hash_set &&rhs) noexcept : rep(zfwstl::move(rhs.rep)) {}
+
+    flat_hash_set &operator=(const flat_hash_set &rhs)
+    {
+      rep = rhs.rep;
+      return *this;
+    }
+    flat_hash_set &operator=(flat_hash_set &&rhs) noexcept
+    {
+      rep = zfwstl::move(rhs.rep);
+      return *this;
+    }
+    flat_hash_set &operator=(std::initializer_list<value_type> ilist)
+    {
+      rep.clear();
+      rep.reserve(ilist.size());
+      rep.insert_unique(ilist.begin(), ilist.end());
+      return *this;
+    }
+
+    ~flat_hash_set() = default;
+
+    hasher hash_funct() const { return rep.hash_fcn(); }
+    key_equal key_eq() const { return rep.key_eq(); }
+    iterator begin() const { return rep.begin(); }
+    iterator end() const { return rep.end(); }
+    const_iterator cbegin() const { return rep.cbegin(); }
+    const_iterator cend() const { return rep.cend(); }
+    size_type size() const { return rep.size(); }
+    bool empty() const { return rep.empty(); }
+    size_type max_size() const noexcept { return rep.max_size(); }
+    void swap(flat_hash_set &x) noexcept { rep.swap(x.rep); }
+
+    zfwstl::pair<iterator, bool> insert(const value_type &obj)
+    {
+      zfwstl::pair<typename ht::iterator, bool> p = rep.insert_unique(obj);
+      return zfwstl::pair<iterator, bool>(p.first, p.second);
+    }
+    zfwstl::pair<iterator, bool> insert(value_type &&obj)
+    {
+      zfwstl::pair<typename ht::iterator, bool> p = rep.insert_unique(zfwstl::move(obj));
+      return zfwstl::pair<iterator, bool>(p.first, p.second);
+    }
+    template <class InputIter>
+    void insert(InputIter f, InputIter l) { rep.insert_unique(f, l); }
+    void insert(std::initializer_list<value_type> ilist) { rep.insert_unique(ilist.begin(), ilist.end()); }
+    template <class... Args>
+    zfwstl::pair<iterator, bool> emplace(Args &&...args)
+    {
+      zfwstl::pair<typename ht::iterator, bool> p = rep.emplace_unique(zfwstl::forward<Args>(args)...);
+      return zfwstl::pair<iterator, bool>(p.first, p.second);
+    }
+
+    iterator find(const key_type &key) const { return rep.find(key); }
+    size_type count(const key_type &key) const { return rep.count(key); }
+    bool contains(const key_type &key) const { return rep.count(key) != 0; }
+
+    size_type erase(const key_type &key) { return rep.erase_unique(key); }
+    // hasher 与 key_equal 都透明时的异构查找
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    iterator find(const K &key) const { return rep.find(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    size_type count(const K &key) const { return rep.count(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    bool contains(const K &key) const { return rep.count(key) != 0; }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value && !std::is_convertible<const K &, const_iterator>::value, int>::type = 0>
+    size_type erase(const K &key) { return rep.erase_unique(key); }
+    iterator erase(const_iterator it) { return rep.erase(it); }
+    iterator erase(const_iterator first, const_iterator last) { return rep.erase(first, last); }
+    void clear() { rep.clear(); }
+
+  public:
+    void reserve(size_type n) { rep.reserve(n); }
+    void rehash(size_type n) { rep.rehash(n); }
+    size_type bucket_count() const { return rep.bucket_count(); }
+    float load_factor() const { return rep.load_factor(); }
+    float max_load_factor() const { return rep.max_load_factor(); }
+
+    friend bool operator==(const flat_hash_set &lhs, const flat_hash_set &rhs)
+    {
+      if (lhs.size() != rhs.size())
+        return false;
+      for (const auto &v : lhs)
+        if (rhs.find(v) == rhs.end())
+          return false;
+      return true;
+    }
+    friend bool operator!=(const flat_hash_set &lhs, const flat_hash_set &rhs)
+    {
+      return !(lhs == rhs);
+    }
+  };
+
+  template <class Value, class HashFcn, class EqualKey, class Alloc>
+  void swap(flat_hash_set<Value, HashFcn, EqualKey, Alloc> &lhs,
+            flat_hash_set<Value, HashFcn, EqualKey, Alloc> &rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+
+}
+
+#endif // !ZFWSTL_FLAT_HASH_SET_H_
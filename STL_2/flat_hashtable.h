@@ -0,0 +1,571 @@
+#ifndef ZFWSTL_FLAT_HASHTABLE_H_
+#define ZFWSTL_FLAT_HASHTABLE_H_
+/**
+ * flat_hashtable 开放定址哈希表(仿 SwissTable)
+ * 与 hashtable 的开链法不同，元素直接存放在连续的 slots 数组中，不再为每个元素配置节点
+ * 每个 slot 对应一个控制字节 ctrl:
+ *   empty   = -128 (0b10000000)
+ *   deleted = -2   (0b11111110) 墓碑，查找时越过，插入时可复用
+ *   full    = 0 ~ 127          保存哈希值的低 7 位(H2)
+ * 哈希值的其余高位(H1)决定探测起点，以 group(16 个控制字节，SSE2 一条指令比较)为单位做二次探测:
+ *   pos = H1 & mask, pos = (pos + width * i) & mask，i = 1, 2, 3...(三角数步长，可遍历所有 group)
+ * 一个 group 内先用 H2 一次性筛出候选位置，再逐个比较键值；group 中出现 empty 即可断定查找失败
+ * 容量恒为 2 的幂，最大负载因子 7/8；ctrl 数组末尾复制开头 width-1 个字节，使任意位置都能整组读取
+ */
+#include <cstddef> // for size_t, ptrdiff_t
+#include <cstdint> // for uint32_t, uint64_t
+#include <cstring> // for memset
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> // SSE2
+#define ZFWSTL_FLAT_HASH_SSE2 1
+#endif
+#include "../src/iterator.h"         //for forward_iterator_tag
+#include "../src/memory/allocator.h" //simple_allocator, new_alloc
+#include "../src/memory/construct.h" //construct, destroy
+#include "../src/functional.h"       //for hash, equal_to, hash_mix
+#include "../src/util.h"             //pair, move, forward, swap
+#include "../src/exceptdef.h"        //THROW_LENGTH_ERROR_IF
+
+namespace zfwstl
+{
+  typedef signed char __flat_ctrl_t;
+  static const __flat_ctrl_t __flat_ctrl_empty = -128;
+  static const __flat_ctrl_t __flat_ctrl_deleted = -2;
+
+  // 最低位 1 的位置(mask != 0)
+  inline unsigned __flat_ctz(uint32_t mask)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned n = 0;
+    while (!(mask & 1u))
+    {
+      mask >>= 1;
+      ++n;
+    }
+    return n;
+#endif
+  }
+  // 最高位 1 的位置(mask != 0)
+  inline unsigned __flat_msb(uint32_t mask)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31u - static_cast<unsigned>(__builtin_clz(mask));
+#else
+    unsigned n = 0;
+    while (mask >>= 1)
+      ++n;
+    return n;
+#endif
+  }
+
+  // ===========================group: 一组控制字节===========================
+#ifdef ZFWSTL_FLAT_HASH_SSE2
+  struct __flat_group
+  {
+    enum
+    {
+      width = 16
+    };
+    __m128i ctrl;
+    explicit __flat_group(const __flat_ctrl_t *p)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+    // 返回等于 h 的位置掩码
+    uint32_t match(__flat_ctrl_t h) const
+    {
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), ctrl)));
+    }
+    uint32_t match_empty() const { return match(__flat_ctrl_empty); }
+    // empty(-128) 与 deleted(-2) 都小于 -1，full(0~127) 不小于 0
+    uint32_t match_empty_or_deleted() const
+    {
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+    }
+  };
+#else
+  // 无 SSE2 时的可移植版本：一组 8 个控制字节，逐字节比较
+  struct __flat_group
+  {
+    enum
+    {
+      width = 8
+    };
+    __flat_ctrl_t ctrl[8];
+    explicit __flat_group(const __flat_ctrl_t *p) { std::memcpy(ctrl, p, 8); }
+    uint32_t match(__flat_ctrl_t h) const
+    {
+      uint32_t mask = 0;
+      for (unsigned i = 0; i < 8; ++i)
+        mask |= static_cast<uint32_t>(ctrl[i] == h) << i;
+      return mask;
+    }
+    uint32_t match_empty() const { return match(__flat_ctrl_empty); }
+    uint32_t match_empty_or_deleted() const
+    {
+      uint32_t mask = 0;
+      for (unsigned i = 0; i < 8; ++i)
+        mask |= static_cast<uint32_t>(ctrl[i] < -1) << i;
+      return mask;
+    }
+  };
+#endif
+
+  template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+  class flat_hashtable;
+
+  // ===========================迭代器===========================
+  // Ref/Ptr 区分 iterator 与 const_iterator；迭代器保存表指针与 slot 下标
+  template <class Value, class Ref, class Ptr, class Table>
+  struct __flat_hashtable_iterator
+  {
+    typedef forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef Ref reference;
+    typedef Ptr pointer;
+    typedef __flat_hashtable_iterator<Value, Value &, Value *, Table> iterator;
+    typedef __flat_hashtable_iterator<Value, Ref, Ptr, Table> self;
+
+    const Table *ht;
+    size_type index;
+
+    __flat_hashtable_iterator() : ht(nullptr), index(0) {}
+    __flat_hashtable_iterator(const Table *t, size_type i) : ht(t), index(i) {}
+    __flat_hashtable_iterator(const iterator &it) : ht(it.ht), index(it.index) {}
+    self &operator=(const self &) = default;
+
+    reference operator*() const { return const_cast<reference>(ht->slot_at(index)); }
+    pointer operator->() const { return &(operator*()); }
+    self &operator++()
+    {
+      index = ht->next_full(index + 1);
+      return *this;
+    }
+    self operator++(int)
+    {
+      self tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const self &rhs) const { return index == rhs.index; }
+    bool operator!=(const self &rhs) const { return index != rhs.index; }
+  };
+
+  // ===========================flat_hashtable===========================
+  template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc = zfwstl::new_alloc>
+  class flat_hashtable
+  {
+  public:
+    typedef HashFcn hasher;
+    typedef EqualKey key_equal;
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef value_type *pointer;
+    typedef const value_type *const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef __flat_hashtable_iterator<Value, Value &, Value *, flat_hashtable> iterator;
+    typedef __flat_hashtable_iterator<Value, const Value &, const Value *, flat_hashtable> const_iterator;
+    friend struct __flat_hashtable_iterator<Value, Value &, Value *, flat_hashtable>;
+    friend struct __flat_hashtable_iterator<Value, const Value &, const Value *, flat_hashtable>;
+
+    enum
+    {
+      group_width = __flat_group::width
+    };
+
+    // K 即 key_type，或者 hasher 与 key_equal 都透明时，K 可以作为查找用的键
+    template <class K>
+    struct is_lookup_key
+        : std::integral_constant<bool, std::is_same<K, key_type>::value ||
+                                           (zfwstl::has_transparent<HashFcn>::value && zfwstl::has_transparent<EqualKey>::value)>
+    {
+    };
+
+  private:
+    typedef zfwstl::simple_allocator<__flat_ctrl_t, Alloc> ctrl_allocator;
+    typedef zfwstl::simple_allocator<Value, Alloc> slot_allocator;
+
+    __flat_ctrl_t *ctrl_;    // capacity_ + group_width - 1 个控制字节
+    value_type *slots_;      // capacity_ 个 slot
+    size_type capacity_;     // 0 或 2 的幂(>= group_width)
+    size_type size_;         // 元素个数
+    size_type growth_left_;  // 在不扩容的前提下还能占用多少个 empty slot
+    hasher hash;
+    key_equal equals;
+    ExtractKey get_key;
+
+  public:
+    explicit flat_hashtable(size_type n = 0, const hasher &hf = hasher(), const key_equal &eql = key_equal())
+        : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+          hash(hf), equals(eql), get_key()
+    {
+      if (n > 0)
+        reserve(n);
+    }
+    flat_hashtable(const flat_hashtable &rhs)
+        : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+          hash(rhs.hash), equals(rhs.equals), get_key(rhs.get_key)
+    {
+      reserve(rhs.size_);
+      for (size_type i = rhs.next_full(0); i < rhs.capacity_; i = rhs.next_full(i + 1))
+        insert_unique(rhs.slots_[i]);
+    }
+    flat_hashtable(flat_hashtable &&rhs) noexcept
+        : ctrl_(rhs.ctrl_), slots_(rhs.slots_), capacity_(rhs.capacity_), size_(rhs.size_),
+          growth_left_(rhs.growth_left_), hash(rhs.hash), equals(rhs.equals), get_key(rhs.get_key)
+    {
+      rhs.ctrl_ = nullptr;
+      rhs.slots_ = nullptr;
+      rhs.capacity_ = rhs.size_ = rhs.growth_left_ = 0;
+    }
+    flat_hashtable &operator=(const flat_hashtable &rhs)
+    {
+      if (this != &rhs)
+      {
+        flat_hashtable tmp(rhs);
+        swap(tmp);
+      }
+      return *this;
+    }
+    flat_hashtable &operator=(flat_hashtable &&rhs) noexcept
+    {
+      flat_hashtable tmp(zfwstl::move(rhs));
+      swap(tmp);
+      return *this;
+    }
+    ~flat_hashtable()
+    {
+      destroy_slots();
+      deallocate_arrays(ctrl_, slots_, capacity_);
+    }
+
+  public:
+    // 迭代器
+    iterator begin() noexcept { return iterator(this, next_full(0)); }
+    const_iterator begin() const noexcept { return const_iterator(this, next_full(0)); }
+    iterator end() noexcept { return iterator(this, capacity_); }
+    const_iterator end() const noexcept { return const_iterator(this, capacity_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // 容量
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(value_type); }
+    size_type capacity() const noexcept { return capacity_; }
+    size_type bucket_count() const noexcept { return capacity_; }
+    float load_factor() const noexcept { return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f; }
+    float max_load_factor() const noexcept { return 7.0f / 8.0f; }
+
+    hasher hash_fcn() const { return hash; }
+    key_equal key_eq() const { return equals; }
+
+  public:
+    // 查找
+    iterator find(const key_type &key) { return iterator(this, find_index(key)); }
+    const_iterator find(const key_type &key) const { return const_iterator(this, find_index(key)); }
+    size_type count(const key_type &key) const { return find_index(key) != capacity_ ? 1 : 0; }
+    // hasher 与 key_equal 都透明时，可用任意可哈希、可比较的键查找
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    iterator find(const K &key) { return iterator(this, find_index(key)); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    const_iterator find(const K &key) const { return const_iterator(this, find_index(key)); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    size_type count(const K &key) const { return find_index(key) != capacity_ ? 1 : 0; }
+
+    // 插入：键值已存在时不插入
+    zfwstl::pair<iterator, bool> insert_unique(const value_type &obj)
+    {
+      const key_type &k = get_key(obj);
+      const size_type h = hash_of(k);
+      size_type idx = find_index(k, h);
+      if (idx != capacity_)
+        return zfwstl::pair<iterator, bool>(iterator(this, idx), false);
+      idx = prepare_insert(h);
+      zfwstl::construct(slots_ + idx, obj);
+      commit_insert(idx, h);
+      return zfwstl::pair<iterator, bool>(iterator(this, idx), true);
+    }
+    zfwstl::pair<iterator, bool> insert_unique(value_type &&obj)
+    {
+      const key_type &k = get_key(obj);
+      const size_type h = hash_of(k);
+      size_type idx = find_index(k, h);
+      if (idx != capacity_)
+        return zfwstl::pair<iterator, bool>(iterator(this, idx), false);
+      idx = prepare_insert(h);
+      zfwstl::construct(slots_ + idx, zfwstl::move(obj));
+      commit_insert(idx, h);
+      return zfwstl::pair<iterator, bool>(iterator(this, idx), true);
+    }
+    template <class InputIter>
+    void insert_unique(InputIter first, InputIter last)
+    {
+      for (; first != last; ++first)
+        insert_unique(*first);
+    }
+    template <class... Args>
+    zfwstl::pair<iterator, bool> emplace_unique(Args &&...args)
+    {
+      value_type tmp(zfwstl::forward<Args>(args)...);
+      return insert_unique(zfwstl::move(tmp));
+    }
+
+    // 查找键值 key，不存在时以 args 原位构造一个新元素(供 operator[] / try_emplace 使用)
+    template <class... Args>
+    zfwstl::pair<iterator, bool> find_or_emplace(const key_type &key, Args &&...args)
+    {
+      const size_type h = hash_of(key);
+      size_type idx = find_index(key, h);
+      if (idx != capacity_)
+        return zfwstl::pair<iterator, bool>(iterator(this, idx), false);
+      idx = prepare_insert(h);
+      zfwstl::construct(slots_ + idx, zfwstl::forward<Args>(args)...);
+      commit_insert(idx, h);
+      return zfwstl::pair<iterator, bool>(iterator(this, idx), true);
+    }
+
+    // 删除
+    size_type erase_unique(const key_type &key) { return erase_unique<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    size_type erase_unique(const K &key)
+    {
+      const size_type idx = find_index(key);
+      if (idx == capacity_)
+        return 0;
+      erase_at(idx);
+      return 1;
+    }
+    iterator erase(const_iterator pos)
+    {
+      erase_at(pos.index);
+      return iterator(this, next_full(pos.index + 1));
+    }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      while (first != last)
+        first = erase(first);
+      return iterator(this, last.index);
+    }
+    void clear()
+    {
+      if (capacity_ == 0)
+        return;
+      destroy_slots();
+      std::memset(ctrl_, __flat_ctrl_empty, capacity_ + group_width - 1);
+      size_ = 0;
+      growth_left_ = max_growth(capacity_);
+    }
+
+    // 预留空间：保证容纳 n 个元素时不再扩容
+    void reserve(size_type n)
+    {
+      size_type cap = group_width;
+      while (max_growth(cap) < n)
+        cap <<= 1;
+      if (cap > capacity_)
+        resize(cap);
+    }
+    // 以至少 n 个 slot 重建表格(也会清除墓碑)
+    void rehash(size_type n)
+    {
+      size_type cap = group_width;
+      while (cap < n || max_growth(cap) < size_)
+        cap <<= 1;
+      resize(cap);
+    }
+
+    void swap(flat_hashtable &rhs) noexcept
+    {
+      zfwstl::swap(ctrl_, rhs.ctrl_);
+      zfwstl::swap(slots_, rhs.slots_);
+      zfwstl::swap(capacity_, rhs.capacity_);
+      zfwstl::swap(size_, rhs.size_);
+      zfwstl::swap(growth_left_, rhs.growth_left_);
+      zfwstl::swap(hash, rhs.hash);
+      zfwstl::swap(equals, rhs.equals);
+    }
+
+  private:
+    // 负载因子 7/8
+    static size_type max_growth(size_type cap) { return cap - cap / 8; }
+    static __flat_ctrl_t h2(size_type h) { return static_cast<__flat_ctrl_t>(h & 0x7f); }
+    static size_type h1(size_type h) { return h >> 7; }
+    static bool is_full(__flat_ctrl_t c) { return c >= 0; }
+
+    // 对用户哈希值再做一次 hash_mix，使 identity 哈希(整数)也能均匀地分出 H1/H2
+    template <class K>
+    size_type hash_of(const K &key) const { return zfwstl::hash_mix(hash(key)); }
+    const value_type &slot_at(size_type i) const { return slots_[i]; }
+
+    // 从下标 i 开始的第一个 full slot，没有则返回 capacity_
+    size_type next_full(size_type i) const
+    {
+      while (i < capacity_ && !is_full(ctrl_[i]))
+        ++i;
+      return i;
+    }
+
+    // 设置控制字节，同时维护末尾的镜像字节
+    void set_ctrl(size_type i, __flat_ctrl_t c)
+    {
+      ctrl_[i] = c;
+      if (i < static_cast<size_type>(group_width - 1))
+        ctrl_[capacity_ + i] = c;
+    }
+
+    template <class K>
+    size_type find_index(const K &key) const
+    {
+      return capacity_ == 0 ? 0 : find_index(key, hash_of(key));
+    }
+    template <class K>
+    size_type find_index(const K &key, size_type h) const
+    {
+      if (capacity_ == 0)
+        return 0;
+      const size_type mask = capacity_ - 1;
+      const __flat_ctrl_t tag = h2(h);
+      size_type pos = h1(h) & mask;
+      size_type step = 0;
+      while (true)
+      {
+        __flat_group g(ctrl_ + pos);
+        for (uint32_t bits = g.match(tag); bits; bits &= bits - 1)
+        {
+          const size_type idx = (pos + __flat_ctz(bits)) & mask;
+          if (equals(get_key(slots_[idx]), key))
+            return idx;
+        }
+        if (g.match_empty())
+          return capacity_;
+        step += group_width;
+        pos = (pos + step) & mask;
+      }
+    }
+
+    // 沿探测序列找到第一个 empty 或 deleted 的 slot
+    size_type find_first_non_full(size_type h) const
+    {
+      const size_type mask = capacity_ - 1;
+      size_type pos = h1(h) & mask;
+      size_type step = 0;
+      while (true)
+      {
+        __flat_group g(ctrl_ + pos);
+        const uint32_t bits = g.match_empty_or_deleted();
+        if (bits)
+          return (pos + __flat_ctz(bits)) & mask;
+        step += group_width;
+        pos = (pos + step) & mask;
+      }
+    }
+
+    // 为哈希值 h 的新元素找一个 slot，必要时扩容；返回的 slot 尚未构造
+    size_type prepare_insert(size_type h)
+    {
+      if (capacity_ == 0)
+        resize(group_width);
+      size_type idx = find_first_non_full(h);
+      if (growth_left_ == 0 && ctrl_[idx] == __flat_ctrl_empty)
+      {
+        // 墓碑过多(元素不到可容纳量的一半)时原容量重建，否则容量翻倍
+        if (size_ <= max_growth(capacity_) / 2)
+          resize(capacity_);
+        else
+          resize(capacity_ * 2);
+        idx = find_first_non_full(h);
+      }
+      return idx;
+    }
+    // slot 构造成功后再标记为 full，构造抛出异常时表格保持不变
+    void commit_insert(size_type idx, size_type h)
+    {
+      if (ctrl_[idx] == __flat_ctrl_empty)
+        --growth_left_;
+      set_ctrl(idx, h2(h));
+      ++size_;
+    }
+
+    void erase_at(size_type idx)
+    {
+      zfwstl::destroy(slots_ + idx);
+      --size_;
+      // 若 idx 前后的 empty 之间不足一整组，说明没有探测序列曾在此处越过满组，可直接置为 empty
+      const size_type mask = capacity_ - 1;
+      const size_type before = (idx - group_width) & mask;
+      const uint32_t empty_before = __flat_group(ctrl_ + before).match_empty();
+      const uint32_t empty_after = __flat_group(ctrl_ + idx).match_empty();
+      const bool was_never_full = empty_before && empty_after &&
+                                  (__flat_ctz(empty_after) + (group_width - 1 - __flat_msb(empty_before))) < static_cast<unsigned>(group_width);
+      set_ctrl(idx, was_never_full ? __flat_ctrl_empty : __flat_ctrl_deleted);
+      if (was_never_full)
+        ++growth_left_;
+    }
+
+    // 以容量 new_cap 重建表格，元素移动到新位置
+    void resize(size_type new_cap)
+    {
+      THROW_LENGTH_ERROR_IF(new_cap > max_size(), "flat_hashtable's size too big");
+      __flat_ctrl_t *old_ctrl = ctrl_;
+      value_type *old_slots = slots_;
+      const size_type old_cap = capacity_;
+
+      ctrl_ = ctrl_allocator::allocate(new_cap + group_width - 1);
+      try
+      {
+        slots_ = slot_allocator::allocate(new_cap);
+      }
+      catch (...)
+      {
+        ctrl_allocator::deallocate(ctrl_, new_cap + group_width - 1);
+        ctrl_ = old_ctrl;
+        throw;
+      }
+      std::memset(ctrl_, __flat_ctrl_empty, new_cap + group_width - 1);
+      capacity_ = new_cap;
+      for (size_type i = 0; i < old_cap; ++i)
+      {
+        if (is_full(old_ctrl[i]))
+        {
+          const size_type h = hash_of(get_key(old_slots[i]));
+          const size_type idx = find_first_non_full(h);
+          zfwstl::construct(slots_ + idx, zfwstl::move(old_slots[i]));
+          zfwstl::destroy(old_slots + i);
+          set_ctrl(idx, h2(h));
+        }
+      }
+      growth_left_ = max_growth(capacity_) - size_;
+      deallocate_arrays(old_ctrl, old_slots, old_cap);
+    }
+
+    void destroy_slots()
+    {
+      for (size_type i = 0; i < capacity_; ++i)
+        if (is_full(ctrl_[i]))
+          zfwstl::destroy(slots_ + i);
+    }
+    static void deallocate_arrays(__flat_ctrl_t *ctrl, value_type *slots, size_type cap)
+    {
+      if (cap == 0)
+        return;
+      ctrl_allocator::deallocate(ctrl, cap + group_width - 1);
+      slot_allocator::deallocate(slots, cap);
+    }
+  };
+
+  template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+  void swap(flat_hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc> &lhs,
+            flat_hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc> &rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif // !ZFWSTL_FLAT_HASHTABLE_H_
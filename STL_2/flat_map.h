@@ -0,0 +1,189 @@
+#ifndef ZFWSTL_FLAT_MAP_H_
+#define ZFWSTL_FLAT_MAP_H_
+/**
+ * flat_map: key, value
+ * 接口与 map 相同，底层为按键有序的 vector(见 flat_tree.h)，查找为二分，适合读多写少的查找表
+ * value_type 为 pair<Key, T>：元素要在 vector 中搬移，键不能是 const，但不要通过迭代器修改键
+ * SplitStorage = true 时键与值分别存放(flat_split_tree)，二分只访问键数组；
+ *   此时迭代器解引用得到 {const Key &first, T &second} 的代理，而不是 value_type &
+ * 注意：任何插入、删除都可能使迭代器、指针和引用失效
+ */
+#include <cstddef>             //for size_t, ptrdiff_t
+#include <type_traits>         //for conditional
+#include "../src/functional.h" //for binary_function, less
+#include "flat_tree.h"
+#include "../src/util.h" //for  pair<iterator, bool>, move()
+namespace zfwstl
+{
+
+  template <class Key, class T, class Compare = zfwstl::less<Key>, class Alloc = zfwstl::new_alloc,
+            bool SplitStorage = false>
+  class flat_map
+  {
+  public:
+    typedef Key key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef zfwstl::pair<Key, T> value_type;
+    typedef Compare key_compare;
+    class value_compare : public binary_function<value_type, value_type, bool>
+    {
+      friend class flat_map<Key, T, Compare, Alloc, SplitStorage>;
+
+    private:
+      Compare comp;
+      value_compare(Compare c) : comp(c) {}
+
+    public:
+      bool operator()(const value_type &lhs, const value_type &rhs) const
+      {
+        return comp(lhs.first, rhs.first); // 比较键值的大小
+      }
+    };
+
+  private:
+    typedef typename std::conditional<SplitStorage,
+                                      flat_split_tree<key_type, mapped_type, key_compare, Alloc>,
+                                      flat_tree<key_type, value_type, zfwstl::__flat_select1st<value_type>, key_compare, Alloc>>::type rep_type;
+    rep_type t; // 采用有序 vector 表现flat_map
+  public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    flat_map() : t(Compare()) {}
+    explicit flat_map(const Compare &comp) : t(comp) {}
+    // flat_map不允许相同键值存在->insert_unique；区间构造只排序一次
+    template <class InputIter>
+    flat_map(InputIter first, InputIter last) : t(Compare()) { t.insert_unique(first, last); }
+    template <class InputIter>
+    flat_map(InputIter first, InputIter last, const Compare &comp) : t(comp) { t.insert_unique(first, last); }
+    flat_map(std::initializer_list<value_type> ilist) : t()
+    {
+      t.insert_unique(ilist.begin(), ilist.end());
+    }
+    flat_map(const flat_map &rhs) : t(rhs.t) {}
+    flat_map(flat_map &&rhs) noexcept : t(zfwstl::move(rhs.t)) {}
+
+    flat_map &operator=(const flat_map &x)
+    {
+      t = x.t;
+      return *this;
+    }
+    flat_map &operator=(flat_map &&x) noexcept
+    {
+      t = zfwstl::move(x.t);
+      return *this;
+    }
+    flat_map &operator=(std::initializer_list<value_type> ilist)
+    {
+      t.clear();
+      t.insert_unique(ilist.begin(), ilist.end());
+      return *this;
+    }
+
+  public:
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return value_compare(t.key_comp()); }
+    iterator begin() { return t.begin(); }
+    const_iterator begin() const { return t.begin(); }
+    iterator end() { return t.end(); }
+    const_iterator end() const { return t.end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+    bool empty() const noexcept { return t.empty(); }
+    size_type size() const noexcept { return t.size(); }
+    size_type max_size() const noexcept { return t.max_size(); }
+    size_type capacity() const noexcept { return t.capacity(); }
+    // 预留空间：已知元素个数时避免逐个插入过程中的多次扩容
+    void reserve(size_type n) { t.reserve(n); }
+    // 键已存在时不构造 T()
+    T &operator[](const key_type &k)
+    {
+      iterator it = t.lower_bound(k);
+      if (it == end() || key_comp()(k, (*it).first))
+        it = t.insert_unique(value_type(k, T())).first;
+      return (*it).second;
+    }
+    void swap(flat_map &x) { t.swap(x.t); }
+    //==================插入删除操作==================
+    void clear() { t.clear(); }
+
+    typedef zfwstl::pair<iterator, bool> pair_iterator_bool;
+
+    pair_iterator_bool insert(const value_type &x) { return t.insert_unique(x); }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last)
+    {
+      t.insert_unique(first, last);
+    }
+    iterator erase(const_iterator position) { return t.erase(position); }
+    size_type erase(const key_type &x) { return t.erase_unique(x); }
+    iterator erase(const_iterator first, const_iterator last) { return t.erase(first, last); }
+
+    iterator find(const key_type &x) { return t.find(x); }
+    const_iterator find(const key_type &x) const { return t.find(x); }
+    size_type count(const key_type &x) const { return t.count_unique(x); }
+    bool contains(const key_type &x) const { return t.find(x) != t.end(); }
+    iterator lower_bound(const key_type &x) { return t.lower_bound(x); }
+    iterator upper_bound(const key_type &x) { return t.upper_bound(x); }
+    const_iterator lower_bound(const key_type &x) const { return t.lower_bound(x); }
+    const_iterator upper_bound(const key_type &x) const { return t.upper_bound(x); }
+    zfwstl::pair<iterator, iterator>
+    equal_range(const key_type &x) { return t.equal_range(x); }
+    zfwstl::pair<const_iterator, const_iterator>
+    equal_range(const key_type &x) const { return t.equal_range(x); }
+    // Compare 透明(如 less<>)时，以下重载接受任何可与 key_type 比较的键，查找时不构造临时 key_type
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator find(const K &x) { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K &x) const { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count(const K &x) const { return t.count_unique(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    bool contains(const K &x) const { return t.find(x) != t.end(); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator lower_bound(const K &x) { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K &x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator upper_bound(const K &x) { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K &x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &x) { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const K &x) const { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value && !std::is_convertible<const K &, const_iterator>::value, int>::type = 0>
+    size_type erase(const K &x) { return t.erase_unique(x); }
+
+  public:
+    friend bool operator==(const flat_map &lhs, const flat_map &rhs) { return lhs.t == rhs.t; }
+    friend bool operator!=(const flat_map &lhs, const flat_map &rhs) { return !(lhs.t == rhs.t); }
+    friend bool operator<(const flat_map &lhs, const flat_map &rhs) { return lhs.t < rhs.t; }
+    friend bool operator>(const flat_map &lhs, const flat_map &rhs) { return rhs.t < lhs.t; }
+    friend bool operator<=(const flat_map &lhs, const flat_map &rhs) { return !(rhs.t < lhs.t); }
+    friend bool operator>=(const flat_map &lhs, const flat_map &rhs) { return !(lhs.t < rhs.t); }
+  };
+
+  template <class Key, class T, class Compare, class Alloc, bool SplitStorage>
+  void swap(flat_map<Key, T, Compare, Alloc, SplitStorage> &lhs, flat_map<Key, T, Compare, Alloc, SplitStorage> &rhs)
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif // !ZFWSTL_FLAT_MAP_H_
@@ -0,0 +1,145 @@
+#ifndef ZFWSTL_FLAT_MULTISET_H_
+#define ZFWSTL_FLAT_MULTISET_H_
+/**
+ * key值可重复的flat_set
+ * 接口与 multiset 相同，底层为有序 vector(见 flat_tree.h)，查找为二分；底层迭代器：const iterator，不能修改集合中的元素
+ * 注意：任何插入、删除都可能使迭代器、指针和引用失效
+ */
+#include <cstddef>             //for size_t, ptrdiff_t
+#include "../src/functional.h" //for less<>, identity
+#include "flat_tree.h"
+#include "../src/util.h" //for  pair<iterator, bool>, move()
+namespace zfwstl
+{
+
+  template <class Key, class Compare = zfwstl::less<Key>, class Alloc = zfwstl::new_alloc>
+  class flat_multiset
+  {
+  public:
+    typedef Key key_type;
+    typedef Key value_type;
+    // 注意，key与value使用同一个比较函数
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+  private:
+    typedef flat_tree<key_type, value_type, zfwstl::identity<value_type>, key_compare, Alloc> rep_type;
+    rep_type t; // 采用有序 vector 表现flat_multiset
+
+  public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::const_iterator iterator; //!!底层迭代器const_iterator
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::const_reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    flat_multiset() : t(Compare()) {}
+    explicit flat_multiset(const Compare &comp) : t(comp) {}
+    flat_multiset(std::initializer_list<value_type> ilist) : t()
+    {
+      t.insert_equal(ilist.begin(), ilist.end());
+    }
+    // flat_multiset允许相同键值存在->insert_equal；区间构造只排序一次
+    template <class InputIter>
+    flat_multiset(InputIter first, InputIter last) : t(Compare()) { t.insert_equal(first, last); }
+    template <class InputIter>
+    flat_multiset(InputIter first, InputIter last, const Compare &comp) : t(comp) { t.insert_equal(first, last); }
+    flat_multiset(const flat_multiset &other) : t(other.t) {}
+    flat_multiset(flat_multiset &&other) noexcept : t(zfwstl::move(other.t)) {}
+
+    flat_multiset &operator=(const flat_multiset &x)
+    {
+      t = x.t;
+      return *this;
+    }
+    flat_multiset &operator=(flat_multiset &&x) noexcept
+    {
+      t = zfwstl::move(x.t);
+      return *this;
+    }
+    flat_multiset &operator=(std::initializer_list<value_type> ilist)
+    {
+      t.clear();
+      t.insert_equal(ilist.begin(), ilist.end());
+      return *this;
+    }
+
+  public:
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return t.key_comp(); }
+    iterator begin() const { return t.begin(); }
+    iterator end() const { return t.end(); }
+    reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+    bool empty() const noexcept { return t.empty(); }
+    size_type size() const noexcept { return t.size(); }
+    size_type max_size() const noexcept { return t.max_size(); }
+    size_type capacity() const noexcept { return t.capacity(); }
+    // 预留空间：已知元素个数时避免逐个插入过程中的多次扩容
+    void reserve(size_type n) { t.reserve(n); }
+    void swap(flat_multiset &x) noexcept { t.swap(x.t); }
+    //==================插入删除操作==================
+    void clear() { t.clear(); }
+
+    iterator insert(const value_type &x) { return t.insert_equal(x); }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last)
+    {
+      t.insert_equal(first, last);
+    }
+    iterator erase(const_iterator position) { return t.erase(position); }
+    size_type erase(const key_type &x) { return t.erase_multi(x); }
+    iterator erase(const_iterator first, const_iterator last) { return t.erase(first, last); }
+
+    iterator find(const key_type &x) const { return t.find(x); }
+    size_type count(const key_type &x) const { return t.count_multi(x); }
+    bool contains(const key_type &x) const { return t.find(x) != t.end(); }
+    iterator lower_bound(const key_type &x) const { return t.lower_bound(x); }
+    iterator upper_bound(const key_type &x) const { return t.upper_bound(x); }
+    zfwstl::pair<iterator, iterator>
+    equal_range(const key_type &x) const
+    {
+      return t.equal_range(x);
+    }
+    // Compare 透明(如 less<>)时，以下重载接受任何可与 key_type 比较的键，查找时不构造临时 key_type
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator find(const K &x) const { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count(const K &x) const { return t.count_multi(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    bool contains(const K &x) const { return t.find(x) != t.end(); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator lower_bound(const K &x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator upper_bound(const K &x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &x) const { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value && !std::is_convertible<const K &, const_iterator>::value, int>::type = 0>
+    size_type erase(const K &x) { return t.erase_multi(x); }
+
+  public:
+    friend bool operator==(const flat_multiset &lhs, const flat_multiset &rhs) { return lhs.t == rhs.t; }
+    friend bool operator!=(const flat_multiset &lhs, const flat_multiset &rhs) { return !(lhs.t == rhs.t); }
+    friend bool operator<(const flat_multiset &lhs, const flat_multiset &rhs) { return lhs.t < rhs.t; }
+    friend bool operator>(const flat_multiset &lhs, const flat_multiset &rhs) { return rhs.t < lhs.t; }
+    friend bool operator<=(const flat_multiset &lhs, const flat_multiset &rhs) { return !(rhs.t < lhs.t); }
+    friend bool operator>=(const flat_multiset &lhs, const flat_multiset &rhs) { return !(lhs.t < rhs.t); }
+  };
+
+  template <class Key, class Compare, class Alloc>
+  void swap(flat_multiset<Key, Compare, Alloc> &lhs, flat_multiset<Key, Compare, Alloc> &rhs)
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#endif // !ZFWSTL_FLAT_MULTISET_H_
@@ -0,0 +1,592 @@
+#ifndef ZFWSTL_FLAT_TREE_H_
+#define ZFWSTL_FLAT_TREE_H_
+/**
+ * flat_tree: 以有序 vector 实现的关联容器底层，供 flat_map / flat_set / flat_multimap / flat_multiset 使用
+ * 元素连续存放、没有节点开销，查找用 algo.h 的 lower_bound / upper_bound 二分，适合读多写少的查找表
+ * 单个插入、删除要搬移其后的元素，是 O(n)；区间插入先追加，再对新元素排序一次，与原有元素归并，最后去重(unique)
+ *
+ * flat_split_tree: 键与值分别放在两个 vector 中(flat_map / flat_multimap 的 SplitStorage 模式)
+ * 二分查找只访问键数组，值较大时每次查找碰到的 cache line 更少；迭代器解引用得到 {first, second} 两个引用组成的代理
+ *
+ * 注意：任何插入、删除都可能使迭代器、指针和引用失效
+ * 区间插入时，相等的新元素之间谁保留(唯一键)、谁排在前面(可重复键)是未指定的；已有元素总是优先于新元素
+ */
+#include <cstddef>                       //for size_t, ptrdiff_t
+#include <type_traits>                   //for remove_const
+#include "../src/iterator.h"             //for random_access_iterator_tag, reverse_iterator, distance
+#include "../src/memory/allocator.h"     //for new_alloc
+#include "../STL/vector.h"               //底层存储
+#include "../src/util.h"                 //for pair, move, swap
+#include "../src/algorithms/algo.h"      //for lower_bound, upper_bound, sort, unique, is_sorted
+#include "../src/algorithms/algorithm.h" //for equal(), lexicographical_compare()
+namespace zfwstl
+{
+  // flat_map 的元素是 pair<Key, T>(不是 pair<const Key, T>)：vector 搬移元素要用赋值
+  template <class Pair>
+  struct __flat_select1st
+  {
+    const typename Pair::first_type &operator()(const Pair &x) const { return x.first; }
+  };
+
+  //===============================flat_tree==========================
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = zfwstl::new_alloc>
+  class flat_tree
+  {
+  public:
+    typedef zfwstl::vector<Value, Alloc> container_type;
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef value_type *pointer;
+    typedef const value_type *const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename container_type::iterator iterator;
+    typedef typename container_type::const_iterator const_iterator;
+    typedef zfwstl::reverse_iterator<iterator> reverse_iterator;
+    typedef zfwstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  private:
+    container_type c;
+    Compare key_compare;
+
+    // 二分查找用的比较器：两侧各自取键(元素取 KeyOfValue，查找键原样)，再交给 key_compare
+    struct key_less
+    {
+      const Compare &comp;
+      explicit key_less(const Compare &cmp) : comp(cmp) {}
+      static const Key &key(const Value &v) { return KeyOfValue()(v); }
+      template <class K>
+      static const K &key(const K &k) { return k; }
+      template <class A, class B>
+      bool operator()(const A &a, const B &b) const { return comp(key(a), key(b)); }
+    };
+
+  public:
+    explicit flat_tree(const Compare &comp = Compare()) : c(), key_compare(comp) {}
+
+    Compare key_comp() const { return key_compare; }
+    bool empty() const noexcept { return c.empty(); }
+    size_type size() const noexcept { return c.size(); }
+    size_type max_size() const noexcept { return c.max_size(); }
+    size_type capacity() const noexcept { return c.capacity(); }
+    void reserve(size_type n) { c.reserve(n); }
+    void clear() { c.clear(); }
+    void swap(flat_tree &rhs)
+    {
+      c.swap(rhs.c);
+      zfwstl::swap(key_compare, rhs.key_compare);
+    }
+    iterator begin() noexcept { return c.begin(); }
+    const_iterator begin() const noexcept { return c.begin(); }
+    iterator end() noexcept { return c.end(); }
+    const_iterator end() const noexcept { return c.end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    //==================插入操作==================
+    zfwstl::pair<iterator, bool> insert_unique(const value_type &v)
+    {
+      iterator it = lower_bound(KeyOfValue()(v));
+      if (it != end() && !key_compare(KeyOfValue()(v), KeyOfValue()(*it)))
+        return zfwstl::pair<iterator, bool>(it, false);
+      return zfwstl::pair<iterator, bool>(__insert_at(it, v), true);
+    }
+    // 可插入重复key，新元素排在相等元素之后
+    iterator insert_equal(const value_type &v)
+    {
+      return __insert_at(upper_bound(KeyOfValue()(v)), v);
+    }
+    // 区间插入：追加到末尾，新元素未排序则 sort 一次，再与原有元素归并；unique 时最后去重
+    template <class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last) { __insert_range(first, last, true); }
+    template <class InputIterator>
+    void insert_equal(InputIterator first, InputIterator last) { __insert_range(first, last, false); }
+
+    //==================删除操作==================
+    iterator erase(const_iterator position) { return c.erase(const_cast<iterator>(position)); }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      return c.erase(const_cast<iterator>(first), const_cast<iterator>(last));
+    }
+    template <class K>
+    size_type erase_unique(const K &k)
+    {
+      iterator it = find(k);
+      if (it == end())
+        return 0;
+      c.erase(it);
+      return 1;
+    }
+    template <class K>
+    size_type erase_multi(const K &k)
+    {
+      zfwstl::pair<iterator, iterator> p = equal_range(k);
+      const size_type n = static_cast<size_type>(p.second - p.first);
+      c.erase(p.first, p.second);
+      return n;
+    }
+
+    //==================查找操作==================
+    template <class K>
+    iterator lower_bound(const K &k) { return zfwstl::lower_bound(c.begin(), c.end(), k, key_less(key_compare)); }
+    template <class K>
+    const_iterator lower_bound(const K &k) const { return zfwstl::lower_bound(c.begin(), c.end(), k, key_less(key_compare)); }
+    template <class K>
+    iterator upper_bound(const K &k) { return zfwstl::upper_bound(c.begin(), c.end(), k, key_less(key_compare)); }
+    template <class K>
+    const_iterator upper_bound(const K &k) const { return zfwstl::upper_bound(c.begin(), c.end(), k, key_less(key_compare)); }
+    template <class K>
+    zfwstl::pair<iterator, iterator> equal_range(const K &k)
+    {
+      return zfwstl::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    template <class K>
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const K &k) const
+    {
+      return zfwstl::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+    template <class K>
+    iterator find(const K &k)
+    {
+      iterator it = lower_bound(k);
+      return (it == end() || key_compare(k, KeyOfValue()(*it))) ? end() : it;
+    }
+    template <class K>
+    const_iterator find(const K &k) const
+    {
+      const_iterator it = lower_bound(k);
+      return (it == end() || key_compare(k, KeyOfValue()(*it))) ? end() : it;
+    }
+    template <class K>
+    size_type count_unique(const K &k) const { return find(k) == end() ? 0 : 1; }
+    template <class K>
+    size_type count_multi(const K &k) const
+    {
+      zfwstl::pair<const_iterator, const_iterator> p = equal_range(k);
+      return static_cast<size_type>(p.second - p.first);
+    }
+
+  private:
+    iterator __insert_at(iterator position, const value_type &v)
+    {
+      const size_type n = static_cast<size_type>(position - c.begin());
+      c.insert(position, 1, v);
+      return c.begin() + n;
+    }
+    // 新元素先在临时数组中排序，c 只在最后追加或整体替换；元素复制或比较抛出异常时 c 保持原样
+    template <class InputIterator>
+    void __insert_range(InputIterator first, InputIterator last, bool unique)
+    {
+      container_type tmp;
+      __reserve_for(tmp, first, last, iterator_category(first));
+      for (; first != last; ++first)
+        tmp.push_back(*first);
+      if (tmp.empty())
+        return;
+      key_less comp(key_compare);
+      if (!zfwstl::is_sorted(tmp.begin(), tmp.end(), comp))
+        zfwstl::sort(tmp.begin(), tmp.end(), comp);
+      if (unique)
+        tmp.erase(zfwstl::unique(tmp.begin(), tmp.end(), __equiv(comp)), tmp.end());
+      if (c.empty() || comp(c.back(), tmp.front()) || (!unique && !comp(tmp.front(), c.back())))
+        __append(tmp);
+      else
+        __merge(tmp, unique);
+    }
+    template <class InputIterator>
+    static void __reserve_for(container_type &, InputIterator, InputIterator, zfwstl::input_iterator_tag) {}
+    template <class ForwardIterator>
+    static void __reserve_for(container_type &v, ForwardIterator first, ForwardIterator last, zfwstl::forward_iterator_tag)
+    {
+      v.reserve(static_cast<size_type>(zfwstl::distance(first, last)));
+    }
+    // 新元素都不小于原有元素(如顺序追加)时直接接在末尾
+    void __append(const container_type &tmp)
+    {
+      const size_type old_size = c.size();
+      c.reserve(old_size + tmp.size());
+      try
+      {
+        for (size_type i = 0; i < tmp.size(); ++i)
+          c.push_back(tmp[i]);
+      }
+      catch (...)
+      {
+        c.erase(c.begin() + old_size, c.end());
+        throw;
+      }
+    }
+    // 已排好序的 c 与 tmp 归并到新数组；相等时原有元素在前，unique 时跳过与前一个相等的元素
+    void __merge(const container_type &tmp, bool unique)
+    {
+      key_less comp(key_compare);
+      container_type result;
+      result.reserve(c.size() + tmp.size());
+      const_iterator a = c.begin(), a_end = c.end();
+      const_iterator b = tmp.begin(), b_end = tmp.end();
+      while (a != a_end || b != b_end)
+      {
+        const_iterator take = (b == b_end || (a != a_end && !comp(*b, *a))) ? a++ : b++;
+        if (!unique || result.empty() || comp(result.back(), *take))
+          result.push_back(*take);
+      }
+      c.swap(result);
+    }
+    // 已排序区间中"相等"即不严格小于
+    struct equiv
+    {
+      key_less comp;
+      explicit equiv(const key_less &cmp) : comp(cmp) {}
+      bool operator()(const Value &a, const Value &b) const { return !comp(a, b); }
+    };
+    static equiv __equiv(const key_less &comp) { return equiv(comp); }
+
+  public:
+    friend bool operator==(const flat_tree &lhs, const flat_tree &rhs)
+    {
+      return lhs.size() == rhs.size() && zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator<(const flat_tree &lhs, const flat_tree &rhs)
+    {
+      return zfwstl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+  };
+
+  //===============================flat_split_tree==========================
+  // 迭代器解引用得到的代理：first 为键的常量引用，second 为值的引用(const_iterator 时为常量引用)
+  template <class Key, class T>
+  struct __flat_split_ref
+  {
+    const Key &first;
+    T &second;
+
+    __flat_split_ref(const Key &k, T &v) : first(k), second(v) {}
+    operator zfwstl::pair<Key, typename std::remove_const<T>::type>() const
+    {
+      return zfwstl::pair<Key, typename std::remove_const<T>::type>(first, second);
+    }
+    friend bool operator==(const __flat_split_ref &lhs, const __flat_split_ref &rhs)
+    {
+      return lhs.first == rhs.first && lhs.second == rhs.second;
+    }
+    friend bool operator<(const __flat_split_ref &lhs, const __flat_split_ref &rhs)
+    {
+      return lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second);
+    }
+  };
+  // T 为 const 时是 const_iterator
+  template <class Key, class T>
+  struct __flat_split_iterator
+  {
+    typedef random_access_iterator_tag iterator_category;
+    typedef zfwstl::pair<Key, typename std::remove_const<T>::type> value_type;
+    typedef __flat_split_ref<Key, T> reference;
+    typedef ptrdiff_t difference_type;
+    // operator-> 返回的代理指针
+    struct pointer
+    {
+      reference ref;
+      reference *operator->() { return &ref; }
+    };
+    typedef __flat_split_iterator<Key, typename std::remove_const<T>::type> iterator;
+    typedef __flat_split_iterator self;
+
+    const Key *kp;
+    T *vp;
+
+    __flat_split_iterator() : kp(nullptr), vp(nullptr) {}
+    __flat_split_iterator(const Key *k, T *v) : kp(k), vp(v) {}
+    __flat_split_iterator(const iterator &rhs) : kp(rhs.kp), vp(rhs.vp) {}
+    self &operator=(const self &) = default;
+
+    reference operator*() const { return reference(*kp, *vp); }
+    pointer operator->() const { return pointer{**this}; }
+    reference operator[](difference_type n) const { return reference(kp[n], vp[n]); }
+    self &operator++()
+    {
+      ++kp;
+      ++vp;
+      return *this;
+    }
+    self operator++(int)
+    {
+      self tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    self &operator--()
+    {
+      --kp;
+      --vp;
+      return *this;
+    }
+    self operator--(int)
+    {
+      self tmp = *this;
+      --*this;
+      return tmp;
+    }
+    self &operator+=(difference_type n)
+    {
+      kp += n;
+      vp += n;
+      return *this;
+    }
+    self &operator-=(difference_type n) { return *this += -n; }
+    self operator+(difference_type n) const { return self(kp + n, vp + n); }
+    self operator-(difference_type n) const { return self(kp - n, vp - n); }
+    difference_type operator-(const self &rhs) const { return kp - rhs.kp; }
+    bool operator==(const self &rhs) const { return kp == rhs.kp; }
+    bool operator!=(const self &rhs) const { return kp != rhs.kp; }
+    bool operator<(const self &rhs) const { return kp < rhs.kp; }
+    bool operator>(const self &rhs) const { return rhs.kp < kp; }
+    bool operator<=(const self &rhs) const { return !(rhs.kp < kp); }
+    bool operator>=(const self &rhs) const { return !(kp < rhs.kp); }
+  };
+
+  template <class Key, class T, class Compare, class Alloc = zfwstl::new_alloc>
+  class flat_split_tree
+  {
+  public:
+    typedef zfwstl::vector<Key, Alloc> key_container_type;
+    typedef zfwstl::vector<T, Alloc> mapped_container_type;
+    typedef Key key_type;
+    typedef zfwstl::pair<Key, T> value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __flat_split_iterator<Key, T> iterator;
+    typedef __flat_split_iterator<Key, const T> const_iterator;
+    typedef typename iterator::reference reference;
+    typedef typename const_iterator::reference const_reference;
+    typedef typename iterator::pointer pointer;
+    typedef typename const_iterator::pointer const_pointer;
+    typedef zfwstl::reverse_iterator<iterator> reverse_iterator;
+    typedef zfwstl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  private:
+    key_container_type keys;
+    mapped_container_type vals;
+    Compare key_compare;
+
+  public:
+    explicit flat_split_tree(const Compare &comp = Compare()) : keys(), vals(), key_compare(comp) {}
+
+    Compare key_comp() const { return key_compare; }
+    bool empty() const noexcept { return keys.empty(); }
+    size_type size() const noexcept { return keys.size(); }
+    size_type max_size() const noexcept { return keys.max_size(); }
+    size_type capacity() const noexcept { return keys.capacity(); }
+    void reserve(size_type n)
+    {
+      keys.reserve(n);
+      vals.reserve(n);
+    }
+    void clear()
+    {
+      keys.clear();
+      vals.clear();
+    }
+    void swap(flat_split_tree &rhs)
+    {
+      keys.swap(rhs.keys);
+      vals.swap(rhs.vals);
+      zfwstl::swap(key_compare, rhs.key_compare);
+    }
+    iterator begin() noexcept { return iterator(keys.begin(), vals.begin()); }
+    const_iterator begin() const noexcept { return const_iterator(keys.begin(), vals.begin()); }
+    iterator end() noexcept { return iterator(keys.end(), vals.end()); }
+    const_iterator end() const noexcept { return const_iterator(keys.end(), vals.end()); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    // 直接访问键数组 / 值数组
+    const key_container_type &key_array() const noexcept { return keys; }
+    const mapped_container_type &mapped_array() const noexcept { return vals; }
+
+    //==================插入操作==================
+    zfwstl::pair<iterator, bool> insert_unique(const value_type &v)
+    {
+      const size_type i = __lower_index(v.first);
+      if (i != keys.size() && !key_compare(v.first, keys[i]))
+        return zfwstl::pair<iterator, bool>(begin() + i, false);
+      return zfwstl::pair<iterator, bool>(__insert_at(i, v), true);
+    }
+    iterator insert_equal(const value_type &v) { return __insert_at(__upper_index(v.first), v); }
+    // 区间插入：先在临时数组中排序、去重，再与原有键值逐个归并到新的两个数组
+    template <class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last) { __insert_range(first, last, true); }
+    template <class InputIterator>
+    void insert_equal(InputIterator first, InputIterator last) { __insert_range(first, last, false); }
+
+    //==================删除操作==================
+    iterator erase(const_iterator position) { return erase(position, position + 1); }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      const size_type i = static_cast<size_type>(first.kp - keys.begin());
+      const size_type j = static_cast<size_type>(last.kp - keys.begin());
+      keys.erase(keys.begin() + i, keys.begin() + j);
+      vals.erase(vals.begin() + i, vals.begin() + j);
+      return begin() + i;
+    }
+    template <class K>
+    size_type erase_unique(const K &k)
+    {
+      const_iterator it = find(k);
+      if (it == end())
+        return 0;
+      erase(it);
+      return 1;
+    }
+    template <class K>
+    size_type erase_multi(const K &k)
+    {
+      zfwstl::pair<iterator, iterator> p = equal_range(k);
+      const size_type n = static_cast<size_type>(p.second - p.first);
+      erase(p.first, p.second);
+      return n;
+    }
+
+    //==================查找操作==================
+    // 只在键数组上二分
+    template <class K>
+    iterator lower_bound(const K &k) { return begin() + __lower_index(k); }
+    template <class K>
+    const_iterator lower_bound(const K &k) const { return begin() + __lower_index(k); }
+    template <class K>
+    iterator upper_bound(const K &k) { return begin() + __upper_index(k); }
+    template <class K>
+    const_iterator upper_bound(const K &k) const { return begin() + __upper_index(k); }
+    template <class K>
+    zfwstl::pair<iterator, iterator> equal_range(const K &k)
+    {
+      return zfwstl::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    template <class K>
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const K &k) const
+    {
+      return zfwstl::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+    template <class K>
+    iterator find(const K &k)
+    {
+      const size_type i = __lower_index(k);
+      return (i == keys.size() || key_compare(k, keys[i])) ? end() : begin() + i;
+    }
+    template <class K>
+    const_iterator find(const K &k) const
+    {
+      const size_type i = __lower_index(k);
+      return (i == keys.size() || key_compare(k, keys[i])) ? end() : begin() + i;
+    }
+    template <class K>
+    size_type count_unique(const K &k) const { return find(k) == end() ? 0 : 1; }
+    template <class K>
+    size_type count_multi(const K &k) const { return __upper_index(k) - __lower_index(k); }
+
+  private:
+    template <class K>
+    size_type __lower_index(const K &k) const
+    {
+      return static_cast<size_type>(zfwstl::lower_bound(keys.begin(), keys.end(), k, key_compare) - keys.begin());
+    }
+    template <class K>
+    size_type __upper_index(const K &k) const
+    {
+      return static_cast<size_type>(zfwstl::upper_bound(keys.begin(), keys.end(), k, key_compare) - keys.begin());
+    }
+    iterator __insert_at(size_type i, const value_type &v)
+    {
+      keys.insert(keys.begin() + i, 1, v.first);
+      try
+      {
+        vals.insert(vals.begin() + i, 1, v.second);
+      }
+      catch (...)
+      {
+        keys.erase(keys.begin() + i);
+        throw;
+      }
+      return begin() + i;
+    }
+    struct value_less
+    {
+      const Compare &comp;
+      explicit value_less(const Compare &cmp) : comp(cmp) {}
+      bool operator()(const value_type &a, const value_type &b) const { return comp(a.first, b.first); }
+    };
+    struct value_equiv
+    {
+      const Compare &comp;
+      explicit value_equiv(const Compare &cmp) : comp(cmp) {}
+      bool operator()(const value_type &a, const value_type &b) const { return !comp(a.first, b.first); }
+    };
+    template <class InputIterator>
+    void __insert_range(InputIterator first, InputIterator last, bool unique)
+    {
+      zfwstl::vector<value_type, Alloc> tmp;
+      for (; first != last; ++first)
+        tmp.push_back(*first);
+      if (tmp.empty())
+        return;
+      if (!zfwstl::is_sorted(tmp.begin(), tmp.end(), value_less(key_compare)))
+        zfwstl::sort(tmp.begin(), tmp.end(), value_less(key_compare));
+      if (unique)
+        tmp.erase(zfwstl::unique(tmp.begin(), tmp.end(), value_equiv(key_compare)), tmp.end());
+      // 新键都排在原有键之后(如顺序追加)时直接接在末尾
+      if (keys.empty() || key_compare(keys.back(), tmp.front().first) ||
+          (!unique && !key_compare(tmp.front().first, keys.back())))
+      {
+        reserve(keys.size() + tmp.size());
+        for (size_type i = 0; i < tmp.size(); ++i)
+        {
+          keys.push_back(tmp[i].first);
+          vals.push_back(tmp[i].second);
+        }
+        return;
+      }
+      key_container_type nk;
+      mapped_container_type nv;
+      nk.reserve(keys.size() + tmp.size());
+      nv.reserve(keys.size() + tmp.size());
+      size_type a = 0, b = 0;
+      while (a != keys.size() || b != tmp.size())
+      {
+        // 相等时原有元素在前；unique 时与已输出的最后一个键相等的新元素跳过
+        if (b == tmp.size() || (a != keys.size() && !key_compare(tmp[b].first, keys[a])))
+        {
+          nk.push_back(keys[a]);
+          nv.push_back(vals[a]);
+          ++a;
+        }
+        else
+        {
+          if (!unique || nk.empty() || key_compare(nk.back(), tmp[b].first))
+          {
+            nk.push_back(tmp[b].first);
+            nv.push_back(tmp[b].second);
+          }
+          ++b;
+        }
+      }
+      keys.swap(nk);
+      vals.swap(nv);
+    }
+
+  public:
+    friend bool operator==(const flat_split_tree &lhs, const flat_split_tree &rhs)
+    {
+      return lhs.size() == rhs.size() && zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    friend bool operator<(const flat_split_tree &lhs, const flat_split_tree &rhs)
+    {
+      return zfwstl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+  };
+}
+
+#endif // !ZFWSTL_FLAT_TREE_H_
@@ -4,25 +4,113 @@
  * hashtable哈希表
  * hash冲突采用开链法
  * hash的迭代器没有后退操作(operator--())，即它没有定义所谓逆向迭代器
+ * 可选渐进式 rehash(set_incremental_rehash)：扩容时新旧两张 bucket 表并存，
+ * 之后每次插入只迁移固定个数的旧 bucket，把一次性的整表重排摊到后续插入上
  */
 #include <cstddef>                   //for size_t, ptrdiff_t
+#include <cstdint>                   //for uint64_t
 #include "../src/iterator.h"         //for forward_iterator_tag, input_iterator_tag, distance
 #include "../src/memory/allocator.h" //simple_allocator标准空间支配其
+#include "../src/memory/alloc.h"     //内存池 alloc
 #include "../src/memory/construct.h"
 #include "../STL/vector.h"
 #include "../src/algorithms/algorithm.h" //for lower_bound
 #include "../src/util.h"                 //make_pair, move, pair
+#include "../src/exceptdef.h"            //for THROW_LENGTH_ERROR_IF
 namespace zfwstl
 {
+  /**
+   * 虽然开链法不要求表格大小必须为质数，
+   * 但SGI STL仍然以质数来设计表格大小，且将28个质数(逐渐呈现大约两倍关系)计算好，
+   * 以备随时访问，同时提供一个函数，用以查询这28个质数中，“最接近某数并大于某数”的质数
+   */
+  static const int __stl_num_primes = 28;
+  static const unsigned long __stl_prime_list[__stl_num_primes] = {
+      53ul, 97ul, 193ul, 389ul, 769ul,
+      1543ul, 3079ul, 6151ul, 12289ul, 24593ul,
+      49157ul, 98317ul, 196613ul, 393241ul, 786433ul,
+      1572869ul, 3145739ul, 6291469ul, 12582917ul, 25165843ul,
+      50331653ul, 100663319ul, 201326611ul, 402653189ul, 805306457ul,
+      1610612741ul, 3221225473ul, 4294967291ul};
+  inline unsigned long __stl_next_prime(unsigned long n)
+  {
+    const unsigned long *first = __stl_prime_list;
+    const unsigned long *last = __stl_prime_list + __stl_num_primes;
+    const unsigned long *pos = zfwstl::lower_bound(first, last, n);
+    return pos == last ? *(last - 1) : *pos;
+  }
+  //=============================bucket 策略================================
+  /**
+   * 桶策略提供三个静态函数：
+   * next_size(n)         不小于 n 的 bucket 个数(resize 时据此成倍增长)
+   * index(h, n)          哈希值 h 落在 n 个 bucket 中的哪一个
+   * max_bucket_count()   bucket 个数上限
+   * 质数取模每次查找/插入都要做一次整数除法；另两种策略不做除法
+   */
+  // 1.质数取模(SGI 原始做法)：对 identity 哈希也足够均匀，但取模是一条除法指令
+  struct prime_bucket_policy
+  {
+    static size_t next_size(size_t n) { return __stl_next_prime(n); }
+    static size_t index(size_t h, size_t n) { return h % n; }
+    static size_t max_bucket_count() { return __stl_prime_list[__stl_num_primes - 1]; }
+  };
+
+  // 2.2的幂 bucket 个数 + 位与。低位直接决定 bucket，而 hash<int> 等是 identity 哈希，
+  // 因此先用 murmur3 的 fmix64 终结函数把高位扩散到低位，再取低位
+  // 上限取 bucket 数组字节数不溢出的最大 2 的幂；超过上限时 next_size 抛出 length_error，而不是左移到 0 死循环
+  struct pow2_bucket_policy
+  {
+    static size_t next_size(size_t n)
+    {
+      THROW_LENGTH_ERROR_IF(n > max_bucket_count(), "pow2_bucket_policy: bucket count too big");
+      size_t cap = 8;
+      while (cap < n)
+        cap <<= 1;
+      return cap;
+    }
+    static size_t mix(size_t h)
+    {
+      uint64_t x = static_cast<uint64_t>(h);
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdull;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ull;
+      x ^= x >> 33;
+      return static_cast<size_t>(x);
+    }
+    static size_t index(size_t h, size_t n) { return mix(h) & (n - 1); }
+    static size_t max_bucket_count() { return (static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1)) / sizeof(void *); }
+  };
+
+  // 3.fastrange：bucket 个数沿用质数序列，下标取 (h' * n) >> 64 的高位，用一次乘法代替除法
+  // h' = h * 2^64/φ (Fibonacci hashing)，使 identity 哈希的差异进入高位
+  struct fastrange_bucket_policy
+  {
+    static size_t next_size(size_t n) { return __stl_next_prime(n); }
+    static size_t index(size_t h, size_t n)
+    {
+#if defined(__SIZEOF_INT128__)
+      const uint64_t x = static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+      return static_cast<size_t>((static_cast<unsigned __int128>(x) * n) >> 64);
+#else
+      return h % n; // 没有 128 位乘法时退回取模
+#endif
+    }
+    static size_t max_bucket_count() { return __stl_prime_list[__stl_num_primes - 1]; }
+  };
+
   /**
    * bucket所维护的linked list并不采用STL的list或者slist，
    * 而是自行维护一个hash table node.
    */
   template <class Value, class Key, class HashFcn,
-            class ExtractKey, class EqualKey /*, class Alloc */>
+            class ExtractKey, class EqualKey, class Alloc, class BucketPolicy>
   struct __hashtable_const_iterator;
 
-  template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey>
+  // Alloc: 原始内存配置器，节点与 buckets 默认使用内存池 alloc
+  // BucketPolicy: 桶策略，决定 bucket 个数序列以及哈希值到 bucket 下标的映射，缺省为 SGI 的质数取模
+  template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc = zfwstl::alloc,
+            class BucketPolicy = zfwstl::prime_bucket_policy>
   class hashtable;
   template <class Value>
   struct __hashtable_node
@@ -31,12 +119,12 @@ namespace zfwstl
     Value val;
   };
   template <class Value, class Key, class HashFcn,
-            class ExtractKey, class EqualKey /*, class Alloc */>
+            class ExtractKey, class EqualKey, class Alloc, class BucketPolicy>
   struct __hashtable_iterator
   {
-    typedef zfwstl::hashtable<Value, Key, HashFcn, ExtractKey, EqualKey> hashtable;
-    typedef __hashtable_iterator<Value, Key, HashFcn, ExtractKey, EqualKey> iterator;
-    typedef __hashtable_const_iterator<Value, Key, HashFcn, ExtractKey, EqualKey> const_iterator;
+    typedef zfwstl::hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc, BucketPolicy> hashtable;
+    typedef __hashtable_iterator<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc, BucketPolicy> iterator;
+    typedef __hashtable_const_iterator<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc, BucketPolicy> const_iterator;
     typedef __hashtable_node<Value> node;
     typedef forward_iterator_tag iterator_category;
     typedef Value value_type;
@@ -60,9 +148,9 @@ namespace zfwstl
       if (!cur)
       {
         // 若目前cur节点为list尾端，就跳至下一个bucket身上，即指向下一个list的头部节点
-        size_type bucket = ht->bkt_num(old->val);
-        while (!cur && ++bucket < (ht->get_buckets()).size())
-          cur = ht->get_buckets()[bucket];
+        size_type bucket = ht->slot_num(old->val);
+        while (!cur && ++bucket < ht->slot_count())
+          cur = ht->slot(bucket);
       }
       return *this;
     }
@@ -79,12 +167,12 @@ namespace zfwstl
   };
 
   template <class Value, class Key, class HashFcn,
-            class ExtractKey, class EqualKey /*, class Alloc */>
+            class ExtractKey, class EqualKey, class Alloc, class BucketPolicy>
   struct __hashtable_const_iterator
   {
-    typedef zfwstl::hashtable<Value, Key, HashFcn, ExtractKey, EqualKey> hashtable;
-    typedef __hashtable_iterator<Value, Key, HashFcn, ExtractKey, EqualKey> iterator;
-    typedef __hashtable_const_iterator<Value, Key, HashFcn, ExtractKey, EqualKey> const_iterator;
+    typedef zfwstl::hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc, BucketPolicy> hashtable;
+    typedef __hashtable_iterator<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc, BucketPolicy> iterator;
+    typedef __hashtable_const_iterator<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc, BucketPolicy> const_iterator;
     typedef __hashtable_node<Value> node;
     typedef forward_iterator_tag iterator_category;
     typedef Value value_type;
@@ -108,9 +196,9 @@ namespace zfwstl
       if (!cur)
       {
         // 若目前cur节点为list尾端，就跳至下一个bucket身上，即指向下一个list的头部节点
-        size_type bucket = ht->bkt_num(old->val);
-        while (!cur && ++bucket < (ht->get_buckets()).size())
-          cur = ht->get_buckets()[bucket];
+        size_type bucket = ht->slot_num(old->val);
+        while (!cur && ++bucket < ht->slot_count())
+          cur = ht->slot(bucket);
       }
       return *this;
     }
@@ -124,29 +212,9 @@ namespace zfwstl
     bool operator==(const const_iterator &it) const { return cur == it.cur; }
     bool operator!=(const const_iterator &it) const { return cur != it.cur; }
   };
-  /**
-   * 虽然开链法不要求表格大小必须为质数，
-   * 但SGI STL仍然以质数来设计表格大小，且将28个质数(逐渐呈现大约两倍关系)计算好，
-   * 以备随时访问，同时提供一个函数，用以查询这28个质数中，“最接近某数并大于某数”的质数
-   */
-  static const int __stl_num_primes = 28;
-  static const unsigned long __stl_prime_list[__stl_num_primes] = {
-      53ul, 97ul, 193ul, 389ul, 769ul,
-      1543ul, 3079ul, 6151ul, 12289ul, 24593ul,
-      49157ul, 98317ul, 196613ul, 393241ul, 786433ul,
-      1572869ul, 3145739ul, 6291469ul, 12582917ul, 25165843ul,
-      50331653ul, 100663319ul, 201326611ul, 402653189ul, 805306457ul,
-      1610612741ul, 3221225473ul, 4294967291ul};
-  inline unsigned long __stl_next_prime(unsigned long n)
-  {
-    const unsigned long *first = __stl_prime_list;
-    const unsigned long *last = __stl_prime_list + __stl_num_primes;
-    const unsigned long *pos = zfwstl::lower_bound(first, last, n);
-    return pos == last ? *(last - 1) : *pos;
-  }
   //=============================hashtable================================
   template <class Value, class Key, class HashFcn,
-            class ExtractKey, class EqualKey /*, class Alloc */>
+            class ExtractKey, class EqualKey, class Alloc, class BucketPolicy>
   class hashtable
   {
   public:
@@ -163,8 +231,18 @@ namespace zfwstl
     typedef size_t size_type;
     typedef ptrdiff_t difference_type;
 
-    typedef __hashtable_iterator<value_type, key_type, hasher, ExtractKey, key_equal> iterator;
-    typedef __hashtable_const_iterator<value_type, key_type, hasher, ExtractKey, key_equal> const_iterator;
+    typedef __hashtable_iterator<value_type, key_type, hasher, ExtractKey, key_equal, Alloc, BucketPolicy> iterator;
+    typedef __hashtable_const_iterator<value_type, key_type, hasher, ExtractKey, key_equal, Alloc, BucketPolicy> const_iterator;
+
+    // 查找类操作(find/count/equal_range/erase)的键型别 K 是否可用：
+    // K 即 key_type，或者 hasher 与 key_equal 都是透明的(定义了 is_transparent)，
+    // 后者允许直接以 const char* 等型别查找 std::string 键而不构造临时对象
+    template <class K>
+    struct is_lookup_key
+        : std::integral_constant<bool, std::is_same<K, key_type>::value ||
+                                           (zfwstl::has_transparent<HashFcn>::value && zfwstl::has_transparent<EqualKey>::value)>
+    {
+    };
 
   public:
     // 提供一个公共的访问器函数
@@ -180,14 +258,31 @@ namespace zfwstl
     ExtractKey get_key;
     typedef __hashtable_node<Value> node;
     // 专属空间配置器
-    typedef zfwstl::simple_allocator<node /*,Alloc */> node_allocator;
-    typedef zfwstl::simple_allocator<node /*,Alloc */> allocator_type;
+    typedef zfwstl::simple_allocator<node, Alloc> node_allocator;
+    typedef zfwstl::simple_allocator<node, Alloc> allocator_type;
 
-    zfwstl::vector<node *> buckets;
+    zfwstl::vector<node *, Alloc> buckets;
+    // 渐进式 rehash：迁移期间 buckets 为新表，old_buckets 为旧表，
+    // 旧表 [0, rehash_pos) 已经搬空，其余 bucket 中的节点尚未迁移；不在迁移时 old_buckets 为空
+    zfwstl::vector<node *, Alloc> old_buckets;
+    // 渐进式下预先分配的下一张新表：元素数过半后 reserve 出空间，每次插入清零一小段，
+    // 扩容时直接换上，避免在一次插入中清零整张大表
+    zfwstl::vector<node *, Alloc> next_buckets;
+    size_type rehash_pos;
+    bool incremental;       // 是否开启渐进式 rehash
     size_type num_elements; // 元素个数
+    // 每次插入迁移的旧 bucket 个数。扩容后的新表约为旧表的两倍，
+    // 下次扩容前还有约 old_n 次插入，每次迁移 4 个足以在此之前迁移完
+    enum
+    {
+      rehash_step_buckets = 4,
+      prepare_step_buckets = 16, // 新表约为旧表两倍，需在后一半的 old_n / 2 次插入内清零完
+      prefetch_distance = 8      // 批量插入时提前预取 bucket 的元素个数
+    };
 
   public:
-    hashtable(size_type n, const hasher &hf, const key_equal &eql) : hash(hf), equals(eql), get_key(ExtractKey()), num_elements(0)
+    hashtable(size_type n, const hasher &hf, const key_equal &eql)
+        : hash(hf), equals(eql), get_key(ExtractKey()), rehash_pos(0), incremental(false), num_elements(0)
     {
       initialize_buckets(n);
     }
@@ -195,7 +290,7 @@ namespace zfwstl
 
     template <class Iter, typename std::enable_if<zfwstl::is_input_iterator<Iter>::value, int>::type = 0>
     hashtable(Iter first, Iter last, size_type bucket_count,
-              const hasher &hash_ = zfwstl::hash<Value>(), const key_equal &equal = zfwstl::equal_to<Value>()) : num_elements(zfwstl::distance(first, last)), hash(hash_), equals(equal)
+              const hasher &hash_ = zfwstl::hash<Value>(), const key_equal &equal = zfwstl::equal_to<Value>()) : num_elements(zfwstl::distance(first, last)), hash(hash_), equals(equal), rehash_pos(0), incremental(false)
     {
       initialize_buckets(zfwstl::max(bucket_count, static_cast<size_type>(zfwstl::distance(first, last))));
     }
@@ -204,10 +299,14 @@ namespace zfwstl
         : num_elements(rhs.num_elements),
           get_key(rhs.get_key),
           hash(rhs.hash),
-          equals(rhs.equals)
+          equals(rhs.equals),
+          rehash_pos(rhs.rehash_pos),
+          incremental(rhs.incremental)
     {
       buckets = zfwstl::move(rhs.buckets);
+      old_buckets = zfwstl::move(rhs.old_buckets);
       rhs.num_elements = 0;
+      rhs.rehash_pos = 0;
     }
 
     hashtable &operator=(const hashtable &rhs)
@@ -227,26 +326,26 @@ namespace zfwstl
     }
 
     // 获取桶访问
-    zfwstl::vector<node *> &get_buckets() { return buckets; }
-    const zfwstl::vector<node *> &get_buckets() const { return buckets; }
+    zfwstl::vector<node *, Alloc> &get_buckets() { return buckets; }
+    const zfwstl::vector<node *, Alloc> &get_buckets() const { return buckets; }
     hasher hash_funct() const { return hash; }
     key_equal key_eq() const { return equals; }
     // 迭代器相关操作
     iterator begin()
     {
-      for (size_type n = 0; n < buckets.size(); ++n)
+      for (size_type n = 0; n < slot_count(); ++n)
       {
-        if (buckets[n]) // 找到第一个有节点的位置就返回
-          return iterator(buckets[n], this);
+        if (slot(n)) // 找到第一个有节点的位置就返回
+          return iterator(slot(n), this);
       }
       return iterator(nullptr, this);
     }
     const_iterator begin() const
     {
-      for (size_type n = 0; n < buckets.size(); ++n)
+      for (size_type n = 0; n < slot_count(); ++n)
       {
-        if (buckets[n]) // 找到第一个有节点的位置就返回
-          return const_iterator(buckets[n], const_cast<hashtable *>(this));
+        if (slot(n)) // 找到第一个有节点的位置就返回
+          return const_iterator(slot(n), const_cast<hashtable *>(this));
       }
       return const_iterator(nullptr, const_cast<hashtable *>(this));
     }
@@ -264,82 +363,114 @@ namespace zfwstl
     size_type max_size() const noexcept { return static_cast<size_type>(-1); }
     // bucket个数，即buckets vector大小
     size_type bucket_count() const { return buckets.size(); }
-    size_type max_bucket_count() const { return __stl_prime_list[__stl_num_primes - 1]; }
+    size_type max_bucket_count() const { return BucketPolicy::max_bucket_count(); }
     allocator_type get_allocator() { return node_allocator(); }
 
+    // 渐进式 rehash 开关，关闭时若仍在迁移则立即迁移完成
+    void set_incremental_rehash(bool on)
+    {
+      incremental = on;
+      if (!on)
+        finish_rehash();
+    }
+    bool incremental_rehash() const noexcept { return incremental; }
+    // 是否处于新旧两表并存的迁移过程中
+    bool rehashing() const noexcept { return !old_buckets.empty(); }
+
+    /**
+     * 槽位：把新表与旧表首尾相接 [buckets | old_buckets] 看作一个序列，
+     * 每个节点恰好位于一个槽位中，迭代器与查找都按槽位进行。不在迁移时槽位即 bucket
+     */
+    size_type slot_count() const { return buckets.size() + old_buckets.size(); }
+    node *slot(size_type s) const { return s < buckets.size() ? buckets[s] : old_buckets[s - buckets.size()]; }
+    node *&slot(size_type s) { return s < buckets.size() ? buckets[s] : old_buckets[s - buckets.size()]; }
+    size_type slot_num(const value_type &obj) const { return hashf(get_key(obj)); }
+
     // 查找相关操作
     // 查找键值为 key 的节点，返回其迭代器
-    iterator find(const key_type &key)
+    iterator find(const key_type &key) { return find<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    iterator find(const K &key)
     {
       const auto n = hashf(key);
-      node *first = buckets[n];
+      node *first = slot(n);
       for (; first && !equals(get_key(first->val), key); first = first->next)
       {
       }
       return iterator(first, this);
     }
-    const_iterator find(const key_type &key) const
+    const_iterator find(const key_type &key) const { return find<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    const_iterator find(const K &key) const
     {
       const auto n = hashf(key);
-      node *first = buckets[n];
+      node *first = slot(n);
       for (; first && !equals(get_key(first->val), key); first = first->next)
       {
       }
       return const_iterator(first, const_cast<hashtable *>(this));
     }
-    size_type count(const key_type &key) const
+    size_type count(const key_type &key) const { return count<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    size_type count(const K &key) const
     {
       const auto n = hashf(key);
       size_type result = 0;
-      for (node *cur = buckets[n]; cur; cur = cur->next)
+      for (node *cur = slot(n); cur; cur = cur->next)
       {
         if (equals(get_key(cur->val), key))
           ++result;
       }
       return result;
     }
-    zfwstl::pair<iterator, iterator> equal_range_unique(const key_type &key)
+    zfwstl::pair<iterator, iterator> equal_range_unique(const key_type &key) { return equal_range_unique<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range_unique(const K &key)
     {
       const auto n = hashf(key);
-      for (node *first = buckets[n]; first; first = first->next)
+      for (node *first = slot(n); first; first = first->next)
       {
         if (equals(get_key(first->val), key))
         {
           if (first->next)
             return zfwstl::make_pair(iterator(first, this), iterator(first->next, this));
-          for (auto m = n + 1; m < buckets.size(); ++m)
+          for (auto m = n + 1; m < slot_count(); ++m)
           { // 整个链表都相等，查找下一个链表出现的位置
-            if (buckets[m])
-              return zfwstl::make_pair(iterator(first, this), iterator(buckets[m], this));
+            if (slot(m))
+              return zfwstl::make_pair(iterator(first, this), iterator(slot(m), this));
           }
           return zfwstl::make_pair(iterator(first, this), end());
         }
       }
       return zfwstl::make_pair(end(), end());
     }
-    zfwstl::pair<const_iterator, const_iterator> equal_range_unique(const key_type &key) const
+    zfwstl::pair<const_iterator, const_iterator> equal_range_unique(const key_type &key) const { return equal_range_unique<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    zfwstl::pair<const_iterator, const_iterator> equal_range_unique(const K &key) const
     {
       const auto n = hashf(key);
-      for (node *first = buckets[n]; first; first = first->next)
+      for (node *first = slot(n); first; first = first->next)
       {
         if (equals(get_key(first->val), key))
         {
           if (first->next)
             return zfwstl::make_pair(const_iterator(first, const_cast<hashtable *>(this)), const_iterator(first->next, const_cast<hashtable *>(this)));
-          for (auto m = n + 1; m < buckets.size(); ++m)
+          for (auto m = n + 1; m < slot_count(); ++m)
           { // 整个链表都相等，查找下一个链表出现的位置
-            if (buckets[m])
-              return zfwstl::make_pair(const_iterator(first, const_cast<hashtable *>(this)), const_iterator(buckets[m], const_cast<hashtable *>(this)));
+            if (slot(m))
+              return zfwstl::make_pair(const_iterator(first, const_cast<hashtable *>(this)), const_iterator(slot(m), const_cast<hashtable *>(this)));
           }
           return zfwstl::make_pair(const_iterator(first, const_cast<hashtable *>(this)), end());
         }
       }
       return zfwstl::make_pair(end(), end());
     }
-    zfwstl::pair<iterator, iterator> equal_range_multi(const key_type &key)
+    zfwstl::pair<iterator, iterator> equal_range_multi(const key_type &key) { return equal_range_multi<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range_multi(const K &key)
     {
       const auto n = hashf(key);
-      for (node *first = buckets[n]; first; first = first->next)
+      for (node *first = slot(n); first; first = first->next)
       {
         if (equals(get_key(first->val), key))
         { // 如果出现相等的键值
@@ -348,20 +479,22 @@ namespace zfwstl
             if (!equals(get_key(second->val), key))
               return zfwstl::make_pair(iterator(first, this), iterator(second, this));
           }
-          for (auto m = n + 1; m < buckets.size(); ++m)
+          for (auto m = n + 1; m < slot_count(); ++m)
           { // 整个链表都相等，查找下一个链表出现的位置
-            if (buckets[m])
-              return zfwstl::make_pair(iterator(first, this), iterator(buckets[m], this));
+            if (slot(m))
+              return zfwstl::make_pair(iterator(first, this), iterator(slot(m), this));
           }
           return zfwstl::make_pair(iterator(first, this), end());
         }
       }
       return zfwstl::make_pair(end(), end());
     }
-    zfwstl::pair<const_iterator, const_iterator> equal_range_multi(const key_type &key) const
+    zfwstl::pair<const_iterator, const_iterator> equal_range_multi(const key_type &key) const { return equal_range_multi<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    zfwstl::pair<const_iterator, const_iterator> equal_range_multi(const K &key) const
     {
       const auto n = hashf(key);
-      for (node *first = buckets[n]; first; first = first->next)
+      for (node *first = slot(n); first; first = first->next)
       {
         if (equals(get_key(first->val), key))
         { // 如果出现相等的键值
@@ -370,10 +503,10 @@ namespace zfwstl
             if (!equals(get_key(second->val), key))
               return zfwstl::make_pair(const_iterator(first, this), const_iterator(second, this));
           }
-          for (auto m = n + 1; m < buckets.size(); ++m)
+          for (auto m = n + 1; m < slot_count(); ++m)
           { // 整个链表都相等，查找下一个链表出现的位置
-            if (buckets[m])
-              return zfwstl::make_pair(const_iterator(first, this), const_iterator(buckets[m], this));
+            if (slot(m))
+              return zfwstl::make_pair(const_iterator(first, this), const_iterator(slot(m), this));
           }
           return zfwstl::make_pair(const_iterator(first, this), end());
         }
@@ -385,7 +518,7 @@ namespace zfwstl
     // 打印桶中各个元素的位置
     size_type bucket_index_of(const Key &key) const
     {
-      return hash(key) % buckets.size();
+      return bkt_num_key(key);
     }
     // insert, resize表格重整
     zfwstl::pair<iterator, bool> insert_unique(const value_type &obj)
@@ -413,8 +546,8 @@ namespace zfwstl
     {
       resize(num_elements + 1);
 
-      size_type n = bkt_num(obj);
-      node *first = buckets[n];
+      size_type n = slot_num(obj);
+      node *first = slot(n);
 
       for (node *cur = first; cur; cur = cur->next)
         if (equals(get_key(cur->val), get_key(obj)))
@@ -422,7 +555,7 @@ namespace zfwstl
 
       node *tmp = new_node(obj);
       tmp->next = first;
-      buckets[n] = tmp;
+      slot(n) = tmp;
       ++num_elements;
       return tmp->val;
     }
@@ -433,10 +566,10 @@ namespace zfwstl
       if (p)
       {
         const auto n = hashf(get_key(p->val));
-        auto cur = buckets[n];
+        auto cur = slot(n);
         if (cur == p)
         { // p 位于链表头部
-          buckets[n] = cur->next;
+          slot(n) = cur->next;
           delete_node(cur);
           --num_elements;
         }
@@ -467,10 +600,10 @@ namespace zfwstl
         return;
       auto first_bucket = first.cur
                               ? hashf(get_key(first.cur->val))
-                              : buckets.size();
+                              : slot_count();
       auto last_bucket = last.cur
                              ? hashf(get_key(last.cur->val))
-                             : buckets.size();
+                             : slot_count();
       if (first_bucket == last_bucket)
       { // 如果在 bucket 在同一个位置
         erase_bucket(first_bucket, const_cast<node *>(first.cur), const_cast<node *>(last.cur));
@@ -480,10 +613,10 @@ namespace zfwstl
         erase_bucket(first_bucket, const_cast<node *>(first.cur), nullptr);
         for (auto n = first_bucket + 1; n < last_bucket; ++n)
         {
-          if (buckets[n] != nullptr)
+          if (slot(n) != nullptr)
             erase_bucket(n, nullptr);
         }
-        if (last_bucket != buckets.size())
+        if (last_bucket != slot_count())
         {
           erase_bucket(last_bucket, const_cast<node *>(last.cur));
         }
@@ -492,7 +625,7 @@ namespace zfwstl
     // 在第 n 个 bucket 内，删除 [first, last) 的节点
     void erase_bucket(size_type n, node *first, node *last)
     {
-      auto cur = buckets[n];
+      auto cur = slot(n);
       if (cur == first)
       {
         erase_bucket(n, last);
@@ -515,7 +648,7 @@ namespace zfwstl
     // 在第 n 个 bucket 内，删除 [buckets_[n], last) 的节点
     void erase_bucket(size_type n, node *last)
     {
-      auto cur = buckets[n];
+      auto cur = slot(n);
       while (cur != last)
       {
         auto next = cur->next;
@@ -523,9 +656,11 @@ namespace zfwstl
         cur = next;
         --num_elements;
       }
-      buckets[n] = last;
+      slot(n) = last;
     }
-    size_type erase_multi(const key_type &key)
+    size_type erase_multi(const key_type &key) { return erase_multi<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    size_type erase_multi(const K &key)
     {
       auto p = equal_range_multi(key);
       if (p.first.cur)
@@ -536,15 +671,17 @@ namespace zfwstl
       }
       return 0;
     }
-    size_type erase_unique(const key_type &key)
+    size_type erase_unique(const key_type &key) { return erase_unique<key_type>(key); }
+    template <class K, typename std::enable_if<is_lookup_key<K>::value, int>::type = 0>
+    size_type erase_unique(const K &key)
     {
       const auto n = hashf(key);
-      auto first = buckets[n];
+      auto first = slot(n);
       if (first)
       {
         if (equals(get_key(first->val), key))
         {
-          buckets[n] = first->next;
+          slot(n) = first->next;
           delete_node(first);
           --num_elements;
           return 1;
@@ -574,6 +711,10 @@ namespace zfwstl
       if (this != &rhs)
       {
         buckets.swap(rhs.buckets);
+        old_buckets.swap(rhs.old_buckets);
+        next_buckets.swap(rhs.next_buckets);
+        zfwstl::swap(rehash_pos, rhs.rehash_pos);
+        zfwstl::swap(incremental, rhs.incremental);
         zfwstl::swap(num_elements, rhs.num_elements);
         zfwstl::swap(hash, rhs.hash);
         zfwstl::swap(equals, rhs.equals);
@@ -584,17 +725,19 @@ namespace zfwstl
     // copy_from, clear
     void clear()
     {
-      for (size_type i = 0; i < buckets.size(); ++i)
+      for (size_type i = 0; i < slot_count(); ++i)
       {
-        node *cur = buckets[i];
+        node *cur = slot(i);
         while (cur)
         {
           node *next = cur->next;
           delete_node(cur);
           cur = next;
         }
-        buckets[i] = nullptr;
+        slot(i) = nullptr;
       }
+      zfwstl::vector<node *, Alloc>().swap(old_buckets); // 旧表已无节点，直接结束迁移
+      rehash_pos = 0;
       num_elements = 0;
       // PS! buckets vector并没释放掉空间，仍保持原有大小
     }
@@ -605,14 +748,19 @@ namespace zfwstl
       // 保留自己的buckets vector的空间，并使其与对方ht空间相同
       buckets.reserve(ht.buckets.size());
       buckets.insert(buckets.end(), ht.buckets.size(), static_cast<node *>(0));
+      // 对方正在迁移时连同旧表一起按槽位原样复制
+      old_buckets.clear();
+      old_buckets.insert(old_buckets.end(), ht.old_buckets.size(), static_cast<node *>(0));
+      rehash_pos = ht.rehash_pos;
+      incremental = ht.incremental;
       try
       {
-        for (size_type i = 0; i < ht.buckets.size(); ++i)
+        for (size_type i = 0; i < ht.slot_count(); ++i)
         {
-          if (const node *cur = ht.buckets[i])
+          if (const node *cur = ht.slot(i))
           {
             node *copy = new_node(cur->val);
-            buckets[i] = copy;
+            slot(i) = copy;
             // 针对同一个bucket list，复制每一个节点
             for (node *next = cur->next; next; cur = next, next = cur->next)
             {
@@ -628,45 +776,21 @@ namespace zfwstl
         clear();
       }
     }
+    // 迁移期间旧表中尚未迁移、迁移后会落到该 bucket 的节点也计入，保证各 bucket 之和等于 size()
     size_type elems_in_bucket(size_type bucket) const
     {
       size_type result = 0;
       for (node *n = buckets[bucket]; n; n = n->next)
         ++result;
+      for (size_type i = rehash_pos; i < old_buckets.size(); ++i)
+        for (node *n = old_buckets[i]; n; n = n->next)
+          if (bkt_num(n->val, buckets.size()) == bucket)
+            ++result;
       return result;
     }
 
-  private:
-    // hashtable的构造与内存管理
-    node *new_node(const value_type &obj)
-    {
-      node *n = node_allocator::allocate();
-      n->next = nullptr;
-      try
-      {
-        zfwstl::construct(&n->val, obj); // 在 n->val 的地址上构造对象
-        return n;
-      }
-      catch (...)
-      {
-        node_allocator::deallocate(n);
-      }
-    }
-    void delete_node(node *n)
-    {
-      zfwstl::destroy(&n->val);
-      node_allocator::deallocate(n);
-    }
-    size_type next_size(size_type n) const { return __stl_next_prime(n); }
-    void initialize_buckets(size_type n)
-    {
-      const size_type n_buckets = next_size(n); // next_size()返回最接近 n且 >n 的质数
-      // 例如，n=50，返回53,余下3个填 0
-      buckets.reserve(n_buckets);
-      buckets.insert(buckets.end(), n_buckets, static_cast<node *>(0));
-      num_elements = 0;
-    }
-    // num_elements_hint预期元素个数
+  public:
+    // num_elements_hint预期元素个数，超过 bucket 个数时扩容
     void resize(size_type num_elements_hint)
     {
       /**
@@ -674,38 +798,120 @@ namespace zfwstl
        * >大于：重建表格
        * 由此可判，每个bucket(list)的最大容量和bucket vector的大小相同
        */
+      if (rehashing())
+      {
+        // 上一次扩容的迁移尚未完成：先推进一步；若又需要扩容(如一次插入大量元素)，则先一次迁移完
+        rehash_step(rehash_step_buckets);
+        if (num_elements_hint > buckets.size())
+          finish_rehash();
+      }
+      else if (incremental)
+        prepare_step(num_elements_hint);
       const size_type old_n = buckets.size();
       if (num_elements_hint > old_n)
       {
         const size_type n = next_size(num_elements_hint); // 找出下一个质数
         if (n > old_n)
+          grow(n, incremental && num_elements != 0);
+      }
+    }
+    // 预留至少能容纳 n 个元素的 bucket。总是一次性重排(不走渐进式)，
+    // 批量插入前调用一次，之后的插入都不再需要扩容
+    void reserve(size_type n)
+    {
+      finish_rehash();
+      if (n > buckets.size())
+      {
+        const size_type new_n = next_size(n);
+        if (new_n > buckets.size())
+          grow(new_n, false);
+      }
+    }
+
+  private:
+    // 把 bucket 表换成 n 个 bucket；lazy 为真时只换表，节点留给之后的插入逐步迁移
+    void grow(size_type n, bool lazy)
+    {
+      const size_type old_n = buckets.size();
+      zfwstl::vector<node *, Alloc> tmp; // 设置新的buckets
+      tmp.swap(next_buckets);
+      if (tmp.capacity() == n) // 预先准备好的新表，补齐未清零的部分
+        tmp.insert(tmp.end(), n - tmp.size(), static_cast<node *>(0));
+      else
+        zfwstl::vector<node *, Alloc>(n, static_cast<node *>(0)).swap(tmp);
+      if (lazy)
+      {
+        // 渐进式：新表就位，旧表原样保留，节点留给之后的插入逐步迁移
+        old_buckets.swap(buckets);
+        buckets.swap(tmp);
+        rehash_pos = 0;
+        rehash_step(rehash_step_buckets);
+        return;
+      }
+      // 处理每一个旧的bucket
+      for (size_type bucket = 0; bucket < old_n; ++bucket)
+      {
+        node *first = buckets[bucket];
+        while (first)
         {
-          zfwstl::vector<node *> tmp(n, static_cast<node *>(0)); // 设置新的buckets
-                                                                 // 处理每一个旧的bucket
-          for (size_type bucket = 0; bucket < old_n; ++bucket)
-          {
-            node *first = buckets[bucket];
-            while (first)
-            {
-              size_type new_bucket = bkt_num(first->val, n); // 找出节点落在哪个新的bucket内
-              // 1-令旧bucket 指向其所对应之串行的下一个节点(以便迭代处理)
-              buckets[bucket] = first->next;
-              // 2+3-将当前节点插入新bucket 内，成为其对应串行的第一个节点
-              first->next = tmp[new_bucket];
-              // 4-回到旧bucket 所指的待处理串行，准备处理下一个节点
-              first = buckets[bucket];
-            }
-          }
-          buckets.swap(tmp); // vector.swap 新旧两个buckets对调
-          // 离开时释放local tmp内存
+          size_type new_bucket = bkt_num(first->val, n); // 找出节点落在哪个新的bucket内
+          // 1-令旧bucket 指向其所对应之串行的下一个节点(以便迭代处理)
+          buckets[bucket] = first->next;
+          // 2+3-将当前节点插入新bucket 内，成为其对应串行的第一个节点
+          first->next = tmp[new_bucket];
+          tmp[new_bucket] = first;
+          // 4-回到旧bucket 所指的待处理串行，准备处理下一个节点
+          first = buckets[bucket];
         }
       }
+      buckets.swap(tmp); // vector.swap 新旧两个buckets对调
+      // 离开时释放local tmp内存
     }
+    // 把旧表中至多 k 个 bucket 的节点迁移到新表，旧表搬空后释放
+    void rehash_step(size_type k)
+    {
+      const size_type old_n = old_buckets.size();
+      const size_type n = buckets.size();
+      for (; k > 0 && rehash_pos < old_n; --k, ++rehash_pos)
+      {
+        node *first = old_buckets[rehash_pos];
+        while (first)
+        {
+          node *next = first->next;
+          const size_type new_bucket = bkt_num(first->val, n);
+          first->next = buckets[new_bucket];
+          buckets[new_bucket] = first;
+          first = next;
+        }
+        old_buckets[rehash_pos] = nullptr;
+      }
+      if (old_n != 0 && rehash_pos == old_n)
+      {
+        zfwstl::vector<node *, Alloc>().swap(old_buckets);
+        rehash_pos = 0;
+      }
+    }
+    void finish_rehash() { rehash_step(old_buckets.size()); }
+    // 元素数超过 bucket 数一半后开始准备下一张新表，每次清零 prepare_step_buckets 个 bucket
+    void prepare_step(size_type num_elements_hint)
+    {
+      const size_type old_n = buckets.size();
+      if (num_elements_hint <= old_n / 2)
+        return;
+      if (next_buckets.capacity() == 0)
+        next_buckets.reserve(next_size(old_n + 1)); // 与 resize 中下一次扩容的大小一致
+      const size_type left = next_buckets.capacity() - next_buckets.size();
+      next_buckets.insert(next_buckets.end(), zfwstl::min(left, static_cast<size_type>(prepare_step_buckets)),
+                          static_cast<node *>(0));
+    }
+
+  public:
+    // 不检查是否需要扩容的插入，调用者须事先 resize/reserve
     zfwstl::pair<iterator, bool> insert_unique_noresize(const value_type &obj)
     {
       // 1-横找
-      const size_type n = bkt_num(obj); // 决定obj应位于#n bucket
-      node *first = buckets[n];
+      const size_type n = slot_num(obj); // 决定obj应位于#n bucket(迁移期间可能仍在旧表)
+      node *first = slot(n);
       // 2-纵找
       for (node *cur = first; cur; cur = cur->next)
         if (equals(get_key(cur->val), get_key(obj)))
@@ -713,15 +919,15 @@ namespace zfwstl
 
       node *tmp = new_node(obj);
       tmp->next = first; // 头插法
-      buckets[n] = tmp;
+      slot(n) = tmp;
       ++num_elements;
       return zfwstl::pair<iterator, bool>(iterator(tmp, this), true);
     }
     iterator insert_equal_noresize(const value_type &obj)
     {
       // 1-横找
-      const size_type n = bkt_num(obj); // 决定obj应位于#n bucket
-      node *first = buckets[n];
+      const size_type n = slot_num(obj); // 决定obj应位于#n bucket(迁移期间可能仍在旧表)
+      node *first = slot(n);
       // 2-纵找
       for (node *cur = first; cur; cur = cur->next)
         if (equals(get_key(cur->val), get_key(obj)))
@@ -736,51 +942,122 @@ namespace zfwstl
       // 没有发现重复键
       node *tmp = new_node(obj);
       tmp->next = first; // 头插法
-      buckets[n] = tmp;
+      slot(n) = tmp;
       ++num_elements;
       return iterator(tmp, this);
     }
 
+  private:
+    // hashtable的构造与内存管理
+    node *new_node(const value_type &obj)
+    {
+      node *n = node_allocator::allocate();
+      n->next = nullptr;
+      try
+      {
+        zfwstl::construct(&n->val, obj); // 在 n->val 的地址上构造对象
+        return n;
+      }
+      catch (...)
+      {
+        node_allocator::deallocate(n);
+        throw;
+      }
+    }
+    void delete_node(node *n)
+    {
+      zfwstl::destroy(&n->val);
+      node_allocator::deallocate(n);
+    }
+    size_type next_size(size_type n) const { return BucketPolicy::next_size(n); }
+    void initialize_buckets(size_type n)
+    {
+      const size_type n_buckets = next_size(n); // next_size()返回最接近 n且 >n 的 bucket 个数(缺省为质数)
+      // 例如，n=50，返回53,余下3个填 0
+      buckets.reserve(n_buckets);
+      buckets.insert(buckets.end(), n_buckets, static_cast<node *>(0));
+      num_elements = 0;
+    }
     // hash函数
-    size_type hashf(const key_type &key, size_type n) const
+    template <class K>
+    size_type hashf(const K &key, size_type n) const
     {
-      return hash(key) % n;
+      return BucketPolicy::index(hash(key), n);
     }
-    size_type hashf(const key_type &key) const
-
+    // 返回键所在的槽位：迁移期间，落在旧表未迁移部分的键仍在旧表中
+    template <class K>
+    size_type hashf(const K &key) const
     {
-      return hash(key) % buckets.size();
+      const size_type h = hash(key);
+      if (!old_buckets.empty())
+      {
+        const size_type old_bucket = BucketPolicy::index(h, old_buckets.size());
+        if (old_bucket >= rehash_pos)
+          return buckets.size() + old_bucket;
+      }
+      return BucketPolicy::index(h, buckets.size());
     }
 
+    void prefetch_bucket(const value_type &obj) const
+    {
+#if defined(__GNUC__)
+      const size_type s = slot_num(obj);
+      __builtin_prefetch(s < buckets.size() ? &buckets[s] : &old_buckets[s - buckets.size()]);
+#else
+      (void)obj;
+#endif
+    }
+    // 批量插入：前向迭代器可以先数出元素个数，一次 reserve 到位后逐个插入而不再扩容；
+    // 单趟的输入迭代器无法预知个数，只能逐个插入
     template <class InputIter>
     void copy_insert_unique(InputIter first, InputIter last, zfwstl::input_iterator_tag)
     {
-      resize(num_elements + zfwstl::distance(first, last)); // 判断是否需要重建表格，如需则扩充
       for (; first != last; ++first)
-        insert_unique_noresize(*first);
+        insert_unique(*first);
     }
     template <class ForwardIter>
     void copy_insert_unique(ForwardIter first, ForwardIter last, zfwstl::forward_iterator_tag)
     {
       size_type n = zfwstl::distance(first, last);
-      resize(num_elements + n); // 判断是否需要重建表格，如需则扩充
+      reserve(num_elements + n);
+      // 提前 prefetch_distance 个元素预取其 bucket，把随机访问 bucket 数组的缓存未命中重叠起来
+      ForwardIter ahead = first;
+      for (size_type i = 0; i < n && i < prefetch_distance; ++i, ++ahead)
+        prefetch_bucket(*ahead);
       for (; n > 0; --n, ++first)
+      {
+        if (n > prefetch_distance)
+        {
+          prefetch_bucket(*ahead);
+          ++ahead;
+        }
         insert_unique_noresize(*first);
+      }
     }
     template <class InputIter>
     void copy_insert_multi(InputIter first, InputIter last, zfwstl::input_iterator_tag)
     {
-      resize(zfwstl::distance(first, last));
       for (; first != last; ++first)
-        insert_equal_noresize(*first);
+        insert_equal(*first);
     }
     template <class ForwardIter>
     void copy_insert_multi(ForwardIter first, ForwardIter last, zfwstl::forward_iterator_tag)
     {
       size_type n = zfwstl::distance(first, last);
-      resize(n);
+      reserve(num_elements + n);
+      // 提前 prefetch_distance 个元素预取其 bucket，把随机访问 bucket 数组的缓存未命中重叠起来
+      ForwardIter ahead = first;
+      for (size_type i = 0; i < n && i < prefetch_distance; ++i, ++ahead)
+        prefetch_bucket(*ahead);
       for (; n > 0; --n, ++first)
+      {
+        if (n > prefetch_distance)
+        {
+          prefetch_bucket(*ahead);
+          ++ahead;
+        }
         insert_equal_noresize(*first);
+      }
     }
 
   public:
@@ -794,7 +1071,7 @@ namespace zfwstl
     // 4: 接受键值， buckets个数
     size_type bkt_num_key(const key_type &key, size_type n) const
     {
-      return hash(key) % n; // SGI的所有内建的hash()
+      return BucketPolicy::index(hash(key), n); // 由桶策略决定，缺省为 SGI 的 hash(key) % n
     }
   };
 }
@@ -12,7 +12,7 @@
 namespace zfwstl
 {
 
-  template <class Key, class T, class Compare = zfwstl::less<Key> /* ,class Alloc=alloc */>
+  template <class Key, class T, class Compare = zfwstl::less<Key>, class Alloc = zfwstl::alloc>
   class map
   {
   public:
@@ -24,7 +24,7 @@ namespace zfwstl
     // TAG: 嵌套类，以下定义一个functor比较函数对象，其作用就是调用 "元素比较函数"
     class value_compare : public binary_function<value_type, value_type, bool>
     {
-      friend class map<Key, T, Compare>;
+      friend class map<Key, T, Compare, Alloc>;
 
     private:
       Compare comp;
@@ -44,7 +44,7 @@ namespace zfwstl
     };
 
   private:
-    typedef rb_tree<key_type, value_type, zfwstl::select1st<value_type>, key_compare> rep_type;
+    typedef rb_tree<key_type, value_type, zfwstl::select1st<value_type>, key_compare, Alloc> rep_type;
     rep_type t; // 采用红黑树表现map
   public:
     typedef typename rep_type::pointer pointer;
@@ -154,7 +154,7 @@ namespace zfwstl
     }
     size_type erase(const key_type &x)
     {
-      return t.erase(x);
+      return t.erase_unique(x);
     }
     void erase(iterator first, iterator last) { t.erase(first, last); }
 
@@ -169,6 +169,27 @@ namespace zfwstl
     equal_range(const key_type &x) { return t.equal_range(x); }
     zfwstl::pair<const_iterator, const_iterator>
     equal_range(const key_type &x) const { return t.equal_range(x); }
+    // Compare 透明(如 less<>)时，以下重载接受任何可与 key_type 比较的键，查找时不构造临时 key_type
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator find(const K &x) { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K &x) const { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count(const K &x) const { return t.count_unique(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator lower_bound(const K &x) { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K &x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator upper_bound(const K &x) { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K &x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &x) { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const K &x) const { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value && !std::is_convertible<const K &, iterator>::value, int>::type = 0>
+    size_type erase(const K &x) { return t.erase_unique(x); }
 
   public:
     friend bool operator==(const map &lhs, const map &rhs) { return lhs.t == rhs.t; }
@@ -176,33 +197,33 @@ namespace zfwstl
   };
 
   // 重载比较操作符
-  template <class Key, class T, class Compare>
-  bool operator==(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+  template <class Key, class T, class Compare, class Alloc>
+  bool operator==(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
   {
     return lhs.t == rhs.t;
   }
-  template <class Key, class T, class Compare>
-  bool operator<(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+  template <class Key, class T, class Compare, class Alloc>
+  bool operator<(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
   {
     return lhs.t < rhs.t;
   }
-  template <class Key, class T, class Compare>
-  bool operator!=(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+  template <class Key, class T, class Compare, class Alloc>
+  bool operator!=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
   {
     return !(lhs == rhs);
   }
-  template <class Key, class T, class Compare>
-  bool operator>(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+  template <class Key, class T, class Compare, class Alloc>
+  bool operator>(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
   {
     return rhs < lhs;
   }
-  template <class Key, class T, class Compare>
-  bool operator<=(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+  template <class Key, class T, class Compare, class Alloc>
+  bool operator<=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
   {
     return !(rhs < lhs);
   }
-  template <class Key, class T, class Compare>
-  bool operator>=(const map<Key, T, Compare> &lhs, const map<Key, T, Compare> &rhs)
+  template <class Key, class T, class Compare, class Alloc>
+  bool operator>=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
   {
     return !(lhs < rhs);
   }
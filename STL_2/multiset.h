@@ -10,7 +10,7 @@
 namespace zfwstl
 {
 
-  template <class Key, class Compare = zfwstl::less<Key> /* ,class Alloc=alloc */>
+  template <class Key, class Compare = zfwstl::less<Key>, class Alloc = zfwstl::alloc>
   class multiset
   {
   public:
@@ -21,7 +21,7 @@ namespace zfwstl
     typedef Compare value_compare;
 
   private:
-    typedef rb_tree<key_type, value_type, zfwstl::identity<value_type>, key_compare> rep_type;
+    typedef rb_tree<key_type, value_type, zfwstl::identity<value_type>, key_compare, Alloc> rep_type;
     rep_type t; // 采用红黑树表现multiset
 
   public:
@@ -86,7 +86,7 @@ namespace zfwstl
     bool empty() { return t.empty(); }
     size_type size() const noexcept { return t.size(); }
     size_type max_size() const noexcept { return t.max_size(); }
-    void swap(multiset<Key, Compare> &x) { t.swap(x.t); }
+    void swap(multiset<Key, Compare, Alloc> &x) { t.swap(x.t); }
     //==================插入删除操作==================
     void clear() { t.clear(); }
 
@@ -114,7 +114,7 @@ namespace zfwstl
     }
     size_type erase(const key_type &x)
     {
-      return t.erase(x);
+      return t.erase_multi(x);
     }
     void erase(iterator first, iterator last) { t.erase(first, last); }
 
@@ -127,39 +127,52 @@ namespace zfwstl
     {
       return t.equal_range(x);
     }
+    // Compare 透明(如 less<>)时，以下重载接受任何可与 key_type 比较的键，查找时不构造临时 key_type
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator find(const K &x) const { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count(const K &x) const { return t.count_multi(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator lower_bound(const K &x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator upper_bound(const K &x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &x) const { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value && !std::is_convertible<const K &, iterator>::value, int>::type = 0>
+    size_type erase(const K &x) { return t.erase_multi(x); }
 
   public:
     friend bool operator==(const multiset &lhs, const multiset &rhs) { return lhs.t == rhs.t; }
     friend bool operator<(const multiset &lhs, const multiset &rhs) { return lhs.t < rhs.t; }
   };
   // 重载比较操作符
-  template <class Key, class Compare>
-  bool operator==(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator==(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
   {
     return lhs.t == rhs.t;
   }
-  template <class Key, class Compare>
-  bool operator<(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator<(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
   {
     return lhs.t < rhs.t;
   }
-  template <class Key, class Compare>
-  bool operator!=(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator!=(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
   {
     return !(lhs == rhs);
   }
-  template <class Key, class Compare>
-  bool operator>(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator>(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
   {
     return rhs < lhs;
   }
-  template <class Key, class Compare>
-  bool operator<=(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator<=(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
   {
     return !(rhs < lhs);
   }
-  template <class Key, class Compare>
-  bool operator>=(const multiset<Key, Compare> &lhs, const multiset<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator>=(const multiset<Key, Compare, Alloc> &lhs, const multiset<Key, Compare, Alloc> &rhs)
   {
     return !(lhs < rhs);
   }
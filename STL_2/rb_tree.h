@@ -7,6 +7,7 @@
 #include <cstddef>                       //for size_t, ptrdiff_t
 #include "../src/iterator.h"             //for bidirectional_iterator_tag, distance
 #include "../src/memory/allocator.h"     //标准空间配置器
+#include "../src/memory/alloc.h"         //内存池 alloc
 #include "../src/util.h"                 //for pair<iterator,bool>, swap, move()
 #include "../src/exceptdef.h"            //for THROW_LENGTH_ERROR_IF
 #include "../src/algorithms/algorithm.h" //for equal(), lexicographical_compare()
@@ -122,6 +123,7 @@ namespace zfwstl
     __rb_tree_iterator(link_type x) { node = x; }
     __rb_tree_iterator(const iterator &rhs) { node = rhs.node; }
     __rb_tree_iterator(const const_iterator &rhs) { node = rhs.node; }
+    self &operator=(const self &) = default;
 
     // TAG：强制类型转换 static_cast, dynamic_cast
     /**
@@ -165,7 +167,8 @@ namespace zfwstl
   };
   //===============================rb_tree==========================
   // KeyOfValue用于从值类型中提取Key
-  template <class Key, class Value, class KeyOfValue, class Compare /* ,class Alloc=alloc */>
+  // Alloc: 原始内存配置器，节点默认使用内存池 alloc
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = zfwstl::alloc>
   class rb_tree
   {
   protected:
@@ -173,7 +176,7 @@ namespace zfwstl
     typedef __rb_tree_node_base *base_ptr;
     typedef __rb_tree_color_type color_type;
     typedef __rb_tree_node<Value> rb_tree_node;
-    typedef zfwstl::simple_allocator<rb_tree_node /* , Alloc */> rb_tree_node_allocator; // 专属之空间配置器，每次分配一个节点大小
+    typedef zfwstl::simple_allocator<rb_tree_node, Alloc> rb_tree_node_allocator; // 专属之空间配置器，每次分配一个节点大小
   public:
     typedef Key key_type;
     typedef Value value_type;
@@ -343,50 +346,13 @@ namespace zfwstl
     const_reverse_iterator crbegin() const noexcept { return rbegin(); }
     const_reverse_iterator crend() const noexcept { return rend(); }
 
-    iterator find(const Key &k)
-    {
-      auto y = header;
-      auto x = root();
-      while (x)
-      {
-        if (!key_compare(key(x), k))
-        {
-          // key 小于等于 x 键值，向左走
-          /**
-           * 这里的逗号,用于在if语句的代码块中分隔两个语句。
-           * 在C++中，逗号运算符会顺序执行两个表达式，并返回最后一个表达式的结果。
-           * 在这个上下文中，逗号运算符被用来同时更新y和x的值。
-           */
-          y = x, x = static_cast<link_type>(x->left);
-        }
-        else // key 大于 x 键值，向右走
-          x = right(x);
-      }
-      iterator j = iterator(y);
-      return (j == end() || key_compare(k, key(j.node))) ? end() : j;
-    }
-    const_iterator find(const Key &k) const
-    {
-      link_type y = header;
-      link_type x = root();
-      while (x)
-      {
-        if (!key_compare(key(x), k))
-        {
-          // key 小于等于 x 键值，向左走
-          /**
-           * 这里的逗号,用于在if语句的代码块中分隔两个语句。
-           * 在C++中，逗号运算符会顺序执行两个表达式，并返回最后一个表达式的结果。
-           * 在这个上下文中，逗号运算符被用来同时更新y和x的值。
-           */
-          y = x, x = static_cast<link_type>(x->left);
-        }
-        else // key 大于 x 键值，向右走
-          x = right(x);
-      }
-      const_iterator j = const_iterator(y);
-      return (j == end() || key_compare(k, key(j.node))) ? end() : j;
-    }
+    iterator find(const Key &k) { return iterator(__find(k)); }
+    const_iterator find(const Key &k) const { return const_iterator(__find(k)); }
+    // Compare 透明(定义了 is_transparent)时，允许以任何可与 Key 比较的型别查找，不必先构造 Key
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator find(const K &k) { return iterator(__find(k)); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator find(const K &k) const { return const_iterator(__find(k)); }
 
     void clear()
     {
@@ -415,39 +381,37 @@ namespace zfwstl
           erase(__first++);
     }
     // 删除键值等于 key 的元素，返回删除的个数
-    size_type erase_multi(const key_type &x)
-    {
-      auto __p = equal_range(x);
-      auto n = zfwstl::distance(__p.first, __p.second);
-      erase(__p.first, __p.second);
-      return n;
-    }
-    size_type erase_unique(const key_type &key)
-    {
-      auto it = find(key);
-      if (it != end())
-      {
-        erase(it);
-        return 1;
-      }
-      return 0;
-    }
+    size_type erase_multi(const key_type &x) { return __erase_multi(x); }
+    size_type erase_unique(const key_type &key) { return __erase_unique(key); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type erase_multi(const K &x) { return __erase_multi(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type erase_unique(const K &key) { return __erase_unique(key); }
 
     iterator copy(iterator x, iterator p);
     // 统计某个给定键（key）在容器中出现的唯一次数
     size_type count_unique(const key_type &key) const
     {
-      return find(key) != end() ? 1 : 0;
+      return __find(key) != header ? 1 : 0;
     }
     size_type count_multi(const key_type &key) const
     {
-      auto p = equal_range(key);
-      return static_cast<size_type>(zfwstl::distance(p.first, p.second));
+      return static_cast<size_type>(zfwstl::distance(const_iterator(__lower_bound(key)), const_iterator(__upper_bound(key))));
+    }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count_unique(const K &key) const
+    {
+      return __find(key) != header ? 1 : 0;
+    }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count_multi(const K &key) const
+    {
+      return static_cast<size_type>(zfwstl::distance(const_iterator(__lower_bound(key)), const_iterator(__upper_bound(key))));
     }
     //=====================修改红黑树相关操作insert, erase=====================
     // 被插入节点的key在整棵树中，必须是独一无二的
     // 若树中已有相同key，插入操作不会真正进行
-    zfwstl::pair<typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator, bool>
+    zfwstl::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator, bool>
     insert_unique(const value_type &v)
     {
       link_type y = header;
@@ -474,23 +438,12 @@ namespace zfwstl
       // 至此，新值v一定与树中键值重复，则不插入
       return zfwstl::pair<iterator, bool>(j, false);
     }
-    void insert_unique(const_iterator __first, const_iterator __last)
-    {
-      for (; __first != __last; ++__first)
-        insert_unique(*__first);
-    }
-    void insert_unique(iterator __first, iterator __last)
-    {
-      for (; __first != __last; ++__first)
-        insert_unique(*__first);
-    }
+    // 批量插入：空树且输入已按 key_compare 排好序(如来自另一棵树或排好序的 vector)时，
+    // O(n) 直接建出平衡的红黑树；否则逐个插入，新键大于当前最大键时直接挂在最右节点下
     template <class InputIterator>
     void insert_unique(InputIterator first, InputIterator last)
     {
-      size_type n = zfwstl::distance(first, last);
-      THROW_LENGTH_ERROR_IF(node_count > max_size() - n, "rb_tree<T, Comp>'s size too big");
-      for (; n > 0; --n, ++first)
-        insert_unique(*first);
+      __insert_range(first, last, true, iterator_category(first));
     }
     // 可插入重复key
     iterator insert_equal(const value_type &v)
@@ -506,39 +459,191 @@ namespace zfwstl
       }
       return __insert(x, y, v); // x新插入点，y插入点父节点，v新值
     }
-    void insert_equal(const_iterator __first, const_iterator __last)
+    template <class InputIterator>
+    void insert_equal(InputIterator first, InputIterator last)
     {
-      for (; __first != __last; ++__first)
-        insert_equal(*__first);
+      __insert_range(first, last, false, iterator_category(first));
     }
-    void insert_equal(iterator __first, iterator __last)
+    //==========================
+    iterator lower_bound(const key_type &k) { return iterator(__lower_bound(k)); }
+    const_iterator lower_bound(const key_type &k) const { return const_iterator(__lower_bound(k)); }
+    iterator upper_bound(const key_type &k) { return iterator(__upper_bound(k)); }
+    const_iterator upper_bound(const key_type &k) const { return const_iterator(__upper_bound(k)); }
+    // 在容器中所有相等元素的范围
+    zfwstl::pair<iterator, iterator> equal_range(const key_type &k)
     {
-      for (; __first != __last; ++__first)
-        insert_equal(*__first);
+      return zfwstl::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const key_type &k) const
+    {
+      return zfwstl::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+    // 透明比较版本
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator lower_bound(const K &k) { return iterator(__lower_bound(k)); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator lower_bound(const K &k) const { return const_iterator(__lower_bound(k)); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator upper_bound(const K &k) { return iterator(__upper_bound(k)); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    const_iterator upper_bound(const K &k) const { return const_iterator(__upper_bound(k)); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &k)
+    {
+      return zfwstl::pair<iterator, iterator>(iterator(__lower_bound(k)), iterator(__upper_bound(k)));
+    }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const K &k) const
+    {
+      return zfwstl::pair<const_iterator, const_iterator>(const_iterator(__lower_bound(k)), const_iterator(__upper_bound(k)));
+    }
+
+    // 调试用：检查红黑树性质(不红红、黑路同、中序有序)以及 header 的最左/最右指针
+    bool __rb_verify() const
+    {
+      if (node_count == 0 || begin() == end())
+        return node_count == 0 && begin() == end() && header->left == header && header->right == header;
+      const size_type len = __black_count(leftmost(), root());
+      for (const_iterator it = begin(); it != end(); ++it)
+      {
+        link_type x = static_cast<link_type>(it.node);
+        link_type l = left(x);
+        link_type r = right(x);
+        if (x->color == __rb_tree_red && ((l && l->color == __rb_tree_red) || (r && r->color == __rb_tree_red)))
+          return false;
+        if ((l && (l->parent != x || key_compare(key(x), key(l)))) ||
+            (r && (r->parent != x || key_compare(key(r), key(x)))))
+          return false;
+        if ((!l || !r) && __black_count(x, root()) != len)
+          return false;
+      }
+      return root()->color == __rb_tree_black && leftmost() == minimum(root()) && rightmost() == maximum(root());
+    }
+
+  private:
+    // 从 x 上溯到 root 途经的黑节点个数
+    static size_type __black_count(base_ptr x, base_ptr root)
+    {
+      size_type n = 0;
+      for (; x; x = x->parent)
+      {
+        if (x->color == __rb_tree_black)
+          ++n;
+        if (x == root)
+          break;
+      }
+      return n;
     }
     template <class InputIterator>
-    void insert_equal(InputIterator first, InputIterator last)
+    void __insert_range(InputIterator first, InputIterator last, bool unique, zfwstl::input_iterator_tag)
+    {
+      for (; first != last; ++first)
+        __insert_rightmost_or_search(*first, unique);
+    }
+    template <class ForwardIterator>
+    void __insert_range(ForwardIterator first, ForwardIterator last, bool unique, zfwstl::forward_iterator_tag)
     {
       size_type n = zfwstl::distance(first, last);
       THROW_LENGTH_ERROR_IF(node_count > max_size() - n, "rb_tree<T, Comp>'s size too big");
+      size_type count = 0;
+      if (node_count == 0 && n > 1 && __sorted_count(first, last, unique, count))
+      {
+        __build_sorted(first, last, count, unique);
+        return;
+      }
       for (; n > 0; --n, ++first)
-        insert_equal(*first);
+        __insert_rightmost_or_search(*first, unique);
     }
-    //==========================
-    iterator lower_bound(const key_type &k)
+    // 新值排在当前最大键之后(unique 要求严格大于)时直接挂到最右节点下，否则从根向下查找插入点
+    void __insert_rightmost_or_search(const value_type &v, bool unique)
     {
-      link_type y = header; // 最后一个不小于K的节点
-      link_type x = root(); // 当前节点
-
-      while (x != 0)
-        if (!key_compare(key(x), k))
-          y = x, x = left(x);
-        else
-          x = right(x);
-
-      return iterator(y);
+      if (node_count != 0 && (unique ? key_compare(key(rightmost()), KeyOfValue()(v))
+                                     : !key_compare(KeyOfValue()(v), key(rightmost()))))
+        __insert(nullptr, rightmost(), v);
+      else if (unique)
+        insert_unique(v);
+      else
+        insert_equal(v);
+    }
+    // [first, last) 是否按 key_compare 非降序排列；是则给出建树的节点个数(unique 时相邻重复只算一个)
+    template <class ForwardIterator>
+    bool __sorted_count(ForwardIterator first, ForwardIterator last, bool unique, size_type &count) const
+    {
+      count = 1;
+      ForwardIterator prev = first;
+      for (++first; first != last; prev = first, ++first)
+      {
+        if (key_compare(KeyOfValue()(*first), KeyOfValue()(*prev)))
+          return false;
+        if (!unique || key_compare(KeyOfValue()(*prev), KeyOfValue()(*first)))
+          ++count;
+      }
+      return true;
     }
-    const_iterator lower_bound(const key_type &k) const
+    /**
+     * 由排好序的区间 O(n) 建树(要求树为空)：按中点递归，每个节点左右子树大小至多差 1，
+     * 所以树中所有空指针的深度至多差 1。把最深一层(深度 floor(log2(n)))的节点涂红、其余涂黑，
+     * 则任一路径上的黑节点数相同，且红节点的父节点必为黑，即是一棵合法的红黑树
+     */
+    template <class ForwardIterator>
+    void __build_sorted(ForwardIterator first, ForwardIterator last, size_type n, bool unique)
+    {
+      size_type red_depth = 0;
+      for (size_type m = n; m > 1; m >>= 1)
+        ++red_depth;
+      link_type r = __build_subtree(first, last, n, 0, red_depth, unique);
+      r->parent = header;
+      r->color = __rb_tree_black;
+      root() = r;
+      leftmost() = minimum(r);
+      rightmost() = maximum(r);
+      node_count = n;
+    }
+    // 中序消耗 first，建出 n 个节点的子树并返回其根；unique 时相邻的重复元素只取第一个
+    template <class ForwardIterator>
+    link_type __build_subtree(ForwardIterator &first, ForwardIterator last, size_type n,
+                              size_type depth, size_type red_depth, bool unique)
+    {
+      if (n == 0)
+        return nullptr;
+      const size_type left_n = (n - 1) / 2;
+      link_type l = __build_subtree(first, last, left_n, depth + 1, red_depth, unique);
+      link_type x;
+      try
+      {
+        x = create_node(*first);
+      }
+      catch (...)
+      {
+        erase_since(l);
+        throw;
+      }
+      for (++first; unique && first != last && !key_compare(key(x), KeyOfValue()(*first)); ++first)
+      {
+      }
+      x->color = (depth == red_depth && depth != 0) ? __rb_tree_red : __rb_tree_black;
+      x->left = l;
+      if (l)
+        l->parent = x;
+      link_type r;
+      try
+      {
+        r = __build_subtree(first, last, n - 1 - left_n, depth + 1, red_depth, unique);
+      }
+      catch (...)
+      {
+        erase_since(x);
+        throw;
+      }
+      x->right = r;
+      if (r)
+        r->parent = x;
+      return x;
+    }
+    // 以下查找函数对 key_type 与透明比较的任意键型别共用，返回节点(找不到时为 header)
+    // 第一个不小于 k 的节点
+    template <class K>
+    link_type __lower_bound(const K &k) const
     {
       link_type y = header; // 最后一个不小于K的节点
       link_type x = root(); // 当前节点
@@ -549,9 +654,11 @@ namespace zfwstl
         else
           x = right(x);
 
-      return iterator(y);
+      return y;
     }
-    iterator upper_bound(const key_type &k)
+    // 第一个大于 k 的节点
+    template <class K>
+    link_type __upper_bound(const K &k) const
     {
       link_type y = header;
       link_type x = root();
@@ -562,32 +669,33 @@ namespace zfwstl
         else
           x = right(x);
 
-      return iterator(y);
+      return y;
     }
-    const_iterator upper_bound(const key_type &k) const
+    template <class K>
+    link_type __find(const K &k) const
     {
-      link_type y = header;
-      link_type x = root();
-
-      while (x != 0)
-        if (key_compare(k, key(x)))
-          y = x, x = left(x);
-        else
-          x = right(x);
-
-      return iterator(y);
+      // 先找第一个不小于 k 的节点，再判断它是否也不大于 k
+      link_type y = __lower_bound(k);
+      return (y == header || key_compare(k, key(y))) ? header : y;
     }
-    // 在容器中所有相等元素的范围
-    zfwstl::pair<iterator, iterator> equal_range(const key_type &k)
+    template <class K>
+    size_type __erase_multi(const K &k)
     {
-      return zfwstl::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+      iterator first(__lower_bound(k)), last(__upper_bound(k));
+      auto n = zfwstl::distance(first, last);
+      erase(first, last);
+      return n;
     }
-    zfwstl::pair<const_iterator, const_iterator> equal_range(const key_type &k) const
+    template <class K>
+    size_type __erase_unique(const K &k)
     {
-      return zfwstl::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+      link_type y = __find(k);
+      if (y == header)
+        return 0;
+      erase(iterator(y));
+      return 1;
     }
 
-  private:
     iterator __insert(base_ptr x_, base_ptr y_, const value_type &v)
     {
       link_type x = static_cast<link_type>(x_);
@@ -930,45 +1038,45 @@ namespace zfwstl
   };
 
   // 重载比较操作符
-  template <class Key, class Value, class KeyOfValue, class Compare>
-  bool operator==(const rb_tree<Key, Value, KeyOfValue, Compare> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare> &rhs)
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+  bool operator==(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs)
   {
     return lhs.size() == rhs.size() && zfwstl::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
 
-  template <class Key, class Value, class KeyOfValue, class Compare>
-  bool operator<(const rb_tree<Key, Value, KeyOfValue, Compare> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare> &rhs)
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+  bool operator<(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs)
   {
     return zfwstl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
   }
 
-  template <class Key, class Value, class KeyOfValue, class Compare>
-  bool operator!=(const rb_tree<Key, Value, KeyOfValue, Compare> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare> &rhs)
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+  bool operator!=(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs)
   {
     return !(lhs == rhs);
   }
 
-  template <class Key, class Value, class KeyOfValue, class Compare>
-  bool operator>(const rb_tree<Key, Value, KeyOfValue, Compare> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare> &rhs)
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+  bool operator>(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs)
   {
     return rhs < lhs;
   }
 
-  template <class Key, class Value, class KeyOfValue, class Compare>
-  bool operator<=(const rb_tree<Key, Value, KeyOfValue, Compare> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare> &rhs)
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+  bool operator<=(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs)
   {
     return !(rhs < lhs);
   }
 
-  template <class Key, class Value, class KeyOfValue, class Compare>
-  bool operator>=(const rb_tree<Key, Value, KeyOfValue, Compare> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare> &rhs)
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+  bool operator>=(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs)
   {
     return !(lhs < rhs);
   }
 
   // 重载 zfwstl 的 swap
-  template <class Key, class Value, class KeyOfValue, class Compare>
-  void swap(rb_tree<Key, Value, KeyOfValue, Compare> &lhs, rb_tree<Key, Value, KeyOfValue, Compare> &rhs) noexcept
+  template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+  void swap(rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &lhs, rb_tree<Key, Value, KeyOfValue, Compare, Alloc> &rhs) noexcept
   {
     lhs.swap(rhs);
   }
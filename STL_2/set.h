@@ -11,7 +11,7 @@
 namespace zfwstl
 {
 
-  template <class Key, class Compare = zfwstl::less<Key> /* ,class Alloc=alloc */>
+  template <class Key, class Compare = zfwstl::less<Key>, class Alloc = zfwstl::alloc>
   class set
   {
   public:
@@ -22,7 +22,7 @@ namespace zfwstl
     typedef Compare value_compare;
 
   private:
-    typedef rb_tree<key_type, value_type, zfwstl::identity<value_type>, key_compare> rep_type;
+    typedef rb_tree<key_type, value_type, zfwstl::identity<value_type>, key_compare, Alloc> rep_type;
     rep_type t; // 采用红黑树表现set
 
   public:
@@ -90,7 +90,7 @@ namespace zfwstl
     bool empty() { return t.empty(); }
     size_type size() const noexcept { return t.size(); }
     size_type max_size() const noexcept { return t.max_size(); }
-    void swap(set<Key, Compare> &x) { t.swap(x.t); }
+    void swap(set<Key, Compare, Alloc> &x) { t.swap(x.t); }
     //==================插入删除操作==================
     void clear() { t.clear(); }
 
@@ -118,7 +118,7 @@ namespace zfwstl
     }
     size_type erase(const key_type &x)
     {
-      return t.erase(x);
+      return t.erase_unique(x);
     }
     void erase(iterator first, iterator last) { t.erase(first, last); }
 
@@ -131,39 +131,52 @@ namespace zfwstl
     {
       return t.equal_range(x);
     }
+    // Compare 透明(如 less<>)时，以下重载接受任何可与 key_type 比较的键，查找时不构造临时 key_type
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator find(const K &x) const { return t.find(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    size_type count(const K &x) const { return t.count_unique(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator lower_bound(const K &x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    iterator upper_bound(const K &x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &x) const { return t.equal_range(x); }
+    template <class K, class C = Compare, typename std::enable_if<zfwstl::has_transparent<C>::value && !std::is_convertible<const K &, iterator>::value, int>::type = 0>
+    size_type erase(const K &x) { return t.erase_unique(x); }
 
   public:
     friend bool operator==(const set &lhs, const set &rhs) { return lhs.t == rhs.t; }
     friend bool operator<(const set &lhs, const set &rhs) { return lhs.t < rhs.t; }
   };
   // 重载比较操作符
-  template <class Key, class Compare>
-  bool operator==(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator==(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
   {
     return lhs.t == rhs.t;
   }
-  template <class Key, class Compare>
-  bool operator<(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator<(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
   {
     return lhs.t < rhs.t;
   }
-  template <class Key, class Compare>
-  bool operator!=(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator!=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
   {
     return !(lhs == rhs);
   }
-  template <class Key, class Compare>
-  bool operator>(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator>(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
   {
     return rhs < lhs;
   }
-  template <class Key, class Compare>
-  bool operator<=(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator<=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
   {
     return !(rhs < lhs);
   }
-  template <class Key, class Compare>
-  bool operator>=(const set<Key, Compare> &lhs, const set<Key, Compare> &rhs)
+  template <class Key, class Compare, class Alloc>
+  bool operator>=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
   {
     return !(lhs < rhs);
   }
@@ -2,6 +2,7 @@
 #define ZFWSTL_UNORDERED_MAP_H_
 /**
  * unordered_map
+ * 不是线程安全的；多线程共享读写时使用 concurrent_hash_map.h 中的 concurrent_hash_map
  */
 #include <cstddef> //for size_t, ptrdiff_t
 #include "hashtable.h"
@@ -11,10 +12,11 @@
 namespace zfwstl
 {
 
-  template <class Key, class Tp, class HashFcn = zfwstl::hash<Key>, class EqualKey = zfwstl::equal_to<Key>>
+  template <class Key, class Tp, class HashFcn = zfwstl::hash<Key>, class EqualKey = zfwstl::equal_to<Key>, class Alloc = zfwstl::alloc,
+            class BucketPolicy = zfwstl::prime_bucket_policy>
   class unordered_map
   {
-    typedef hashtable<zfwstl::pair<const Key, Tp>, Key, HashFcn, zfwstl::select1st<zfwstl::pair<const Key, Tp>>, EqualKey> ht;
+    typedef hashtable<zfwstl::pair<const Key, Tp>, Key, HashFcn, zfwstl::select1st<zfwstl::pair<const Key, Tp>>, EqualKey, Alloc, BucketPolicy> ht;
     ht rep; // 底层机制hash table完成
   public:
     typedef typename ht::key_type key_type;
@@ -133,10 +135,26 @@ namespace zfwstl
       zfwstl::pair<typename ht::iterator, bool> p = rep.insert_equal_noresize(obj);
       return zfwstl::pair<iterator, bool>(p.first, p.second);
     }
+    iterator find(const key_type &key) { return rep.find(key); }
     const_iterator find(const key_type &key) const { return rep.find(key); }
     size_type count(const key_type &key) const { return rep.count(key); }
-    zfwstl::pair<iterator, iterator> equal_range(const key_type &key) const { return rep.equal_range_unique(key); }
-    size_type erase(const key_type &key) { return rep.erase(key); }
+    zfwstl::pair<iterator, iterator> equal_range(const key_type &key) { return rep.equal_range_multi(key); }
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const key_type &key) const { return rep.equal_range_multi(key); }
+    size_type erase(const key_type &key) { return rep.erase_multi(key); }
+    // hasher 与 key_equal 都透明(如 hash<std::string> 搭配 equal_to<>)时，以下重载接受任何可哈希、可比较的键，
+    // 例如以 const char* 查找 std::string 键，不再为每次查找构造临时 std::string
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    iterator find(const K &key) { return rep.find(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    const_iterator find(const K &key) const { return rep.find(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    size_type count(const K &key) const { return rep.count(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &key) { return rep.equal_range_multi(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    zfwstl::pair<const_iterator, const_iterator> equal_range(const K &key) const { return rep.equal_range_multi(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value && !std::is_convertible<const K &, iterator>::value, int>::type = 0>
+    size_type erase(const K &key) { return rep.erase_multi(key); }
     void erase(iterator it) { rep.erase(it); }
     void erase(iterator first, iterator last) { rep.erase(first, last); }
     void clear() { rep.clear(); }
@@ -146,17 +164,21 @@ namespace zfwstl
     size_type bucket_count() const { return rep.bucket_count(); }
     size_type max_bucket_count() const { return rep.max_bucket_count(); }
     size_type elems_in_bucket(size_type n) const { return rep.elems_in_bucket(n); }
+    // 渐进式 rehash：开启后扩容不再一次性重排所有节点，而是摊到之后的插入中
+    void set_incremental_rehash(bool on) { rep.set_incremental_rehash(on); }
+    bool incremental_rehash() const noexcept { return rep.incremental_rehash(); }
+    bool rehashing() const noexcept { return rep.rehashing(); }
   };
-  template <class Key, class Tp, class HashFcn, class EqualKey>
-  inline bool operator==(const unordered_map<Key, Tp, HashFcn, EqualKey> &lhs,
-                         const unordered_map<Key, Tp, HashFcn, EqualKey> &rhs)
+  template <class Key, class Tp, class HashFcn, class EqualKey, class Alloc, class BucketPolicy>
+  inline bool operator==(const unordered_map<Key, Tp, HashFcn, EqualKey, Alloc, BucketPolicy> &lhs,
+                         const unordered_map<Key, Tp, HashFcn, EqualKey, Alloc, BucketPolicy> &rhs)
   {
     return lhs.rep == rhs.rep;
   }
 
-  template <class Key, class Tp, class HashFcn, class EqualKey>
-  inline bool operator!=(const unordered_map<Key, Tp, HashFcn, EqualKey> &lhs,
-                         const unordered_map<Key, Tp, HashFcn, EqualKey> &rhs)
+  template <class Key, class Tp, class HashFcn, class EqualKey, class Alloc, class BucketPolicy>
+  inline bool operator!=(const unordered_map<Key, Tp, HashFcn, EqualKey, Alloc, BucketPolicy> &lhs,
+                         const unordered_map<Key, Tp, HashFcn, EqualKey, Alloc, BucketPolicy> &rhs)
   {
     return lhs.rep != rhs.rep;
   }
@@ -11,10 +11,11 @@
 namespace zfwstl
 {
 
-  template <class Value, class HashFcn = zfwstl::hash<Value>, class EqualKey = zfwstl::equal_to<Value>>
+  template <class Value, class HashFcn = zfwstl::hash<Value>, class EqualKey = zfwstl::equal_to<Value>, class Alloc = zfwstl::alloc,
+            class BucketPolicy = zfwstl::prime_bucket_policy>
   class unordered_set
   {
-    typedef hashtable<Value, Value, HashFcn, zfwstl::identity<Value>, EqualKey> ht;
+    typedef hashtable<Value, Value, HashFcn, zfwstl::identity<Value>, EqualKey, Alloc, BucketPolicy> ht;
     ht rep; // 底层机制hash table完成
   public:
     typedef typename ht::key_type key_type;
@@ -103,7 +104,16 @@ namespace zfwstl
     iterator find(const key_type &key) const { return rep.find(key); }
     size_type count(const key_type &key) const { return rep.count(key); }
     zfwstl::pair<iterator, iterator> equal_range(const key_type &key) const { return rep.equal_range_unique(key); }
-    size_type erase(const key_type &key) { return rep.erase(key); }
+    size_type erase(const key_type &key) { return rep.erase_unique(key); }
+    // hasher 与 key_equal 都透明时，以下重载接受任何可哈希、可比较的键，查找时不构造临时 key_type
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    iterator find(const K &key) const { return rep.find(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    size_type count(const K &key) const { return rep.count(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value, int>::type = 0>
+    zfwstl::pair<iterator, iterator> equal_range(const K &key) const { return rep.equal_range_unique(key); }
+    template <class K, class H = HashFcn, class E = EqualKey, typename std::enable_if<zfwstl::has_transparent<H>::value && zfwstl::has_transparent<E>::value && !std::is_convertible<const K &, iterator>::value, int>::type = 0>
+    size_type erase(const K &key) { return rep.erase_unique(key); }
     void erase(iterator it) { rep.erase(it); }
     void erase(iterator first, iterator last) { rep.erase(first, last); }
     void clear() { rep.clear(); }
@@ -113,17 +123,21 @@ namespace zfwstl
     size_type bucket_count() const { return rep.bucket_count(); }
     size_type max_bucket_count() const { return rep.max_bucket_count(); }
     size_type elems_in_bucket(size_type n) const { return rep.elems_in_bucket(n); }
+    // 渐进式 rehash：开启后扩容不再一次性重排所有节点，而是摊到之后的插入中
+    void set_incremental_rehash(bool on) { rep.set_incremental_rehash(on); }
+    bool incremental_rehash() const noexcept { return rep.incremental_rehash(); }
+    bool rehashing() const noexcept { return rep.rehashing(); }
   };
-  template <class Value, class HashFcn, class EqualKey>
-  inline bool operator==(const unordered_set<Value, HashFcn, EqualKey> &lhs,
-                         const unordered_set<Value, HashFcn, EqualKey> &rhs)
+  template <class Value, class HashFcn, class EqualKey, class Alloc, class BucketPolicy>
+  inline bool operator==(const unordered_set<Value, HashFcn, EqualKey, Alloc, BucketPolicy> &lhs,
+                         const unordered_set<Value, HashFcn, EqualKey, Alloc, BucketPolicy> &rhs)
   {
     return lhs.rep == rhs.rep;
   }
 
-  template <class Value, class HashFcn, class EqualKey>
-  inline bool operator!=(const unordered_set<Value, HashFcn, EqualKey> &lhs,
-                         const unordered_set<Value, HashFcn, EqualKey> &rhs)
+  template <class Value, class HashFcn, class EqualKey, class Alloc, class BucketPolicy>
+  inline bool operator!=(const unordered_set<Value, HashFcn, EqualKey, Alloc, BucketPolicy> &lhs,
+                         const unordered_set<Value, HashFcn, EqualKey, Alloc, BucketPolicy> &rhs)
   {
     return lhs.rep != rhs.rep;
   }
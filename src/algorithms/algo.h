@@ -3,12 +3,14 @@
 #include <type_traits> // for enable_if()
 #include <cstddef>
 #include <ctime>           // for time()
-#include <cstring>         // for memmove()
+#include <cstring>         // for memmove(), memcpy()
+#include <cstdint>         // for uint32_t, uint64_t
 #include "../iterator.h"   // for XXX_iterator_tag, iterator_traits, reverse_iterator, distance(), advance()
 #include "../util.h"       // for pair, swap()
 #include "../functional.h" // for equal_to
 #include "algobase.h"      // for iter_swap()
 #include "heap_algo.h"     // forpush_heap, pop_heap, sort_heap, make_heap
+#include "../memory/allocator.h" // for simple_allocator, construct(), destroy(): stable_sort 的缓冲区
 #include <memory>          // for temporary_buffer
 /**
  * all_of、any_of、none_of
@@ -43,6 +45,7 @@
  * partition 分割
  * partition_copy 将分割的结果放置新的两个区间
  * prev_permutation 获得前一个排列组合
+ * radix_sort 基数排序(整数、浮点数键)
  * random_shuffle 随机重排元素
  * random_sample * 随机取样
  * random_sample_n *
@@ -58,7 +61,7 @@
  * reverse_copy
  * rotate 旋转
  * rotate_copy
- * search 查找某个子序列
+ * search 查找某个子序列(也可传入查找器：default / boyer_moore_horspool / two_way / simd_searcher)
  * search_n 查找“连续发生n次”的子序列
  * sort 排序
  * stable_partition 分割并保持元素的相对次序(对应区别partition)
@@ -79,6 +82,8 @@ namespace zfwstl
   ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T &value);
   template <class ForwardIter1, class ForwardIter2>
   ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2);
+  template <class ForwardIter1, class ForwardIter2, class Compared>
+  ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2, Compared comp);
   template <class ForwardIter>
   void rotate(ForwardIter, ForwardIter, ForwardIter);
   template <class InputIter1, class InputIter2, class OutputIter>
@@ -237,6 +242,19 @@ namespace zfwstl
     return n;
   }
 
+  // 为连续的整数区间提供特化版本：用 SIMD 一次比较 16 / 32 字节(见 simd_algo.h)
+  // value 换成元素类型后值变了，说明没有元素能等于它
+  template <class Tp, class T>
+  typename std::enable_if<zfwstl::simd_comparable<Tp>::value && std::is_integral<T>::value, ptrdiff_t>::type
+  count(Tp *first, Tp *last, const T &value)
+  {
+    typedef typename std::remove_const<Tp>::type value_type;
+    const auto v = static_cast<value_type>(value);
+    if (static_cast<T>(v) != value)
+      return 0;
+    return static_cast<ptrdiff_t>(zfwstl::simd_count<value_type>(first, last, v));
+  }
+
   // ===========================count_if===========================
   // 对[first, last)区间内的每个元素都进行一元 unary_pred 操作，返回结果为 true 的个数
   template <class InputIter, class UnaryPredicate>
@@ -410,13 +428,56 @@ namespace zfwstl
   // 顺序查找，在[first, last)区间内找到等于 value 的元素，返回指向该元素的迭代器
   template <class InputIter, class T>
   InputIter
-  find(InputIter first, InputIter last, const T &value)
+  find(InputIter first, InputIter last, const T &value);
+
+  // 为连续的整数区间提供特化版本，同 count
+  template <class Tp, class T>
+  typename std::enable_if<zfwstl::simd_comparable<Tp>::value && std::is_integral<T>::value, Tp *>::type
+  find(Tp *first, Tp *last, const T &value)
+  {
+    typedef typename std::remove_const<Tp>::type value_type;
+    const auto v = static_cast<value_type>(value);
+    if (static_cast<T>(v) != value)
+      return last;
+    return first + (zfwstl::simd_find<value_type>(first, last, v) - first);
+  }
+
+  // 分段迭代器(见 iterator.h)版本：逐段查找，整数段走上面的 SIMD 版本
+  template <class SegIter, class T>
+  SegIter find_seg(SegIter first, SegIter last, const T &value, std::true_type)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (; !traits::same_segment(first, last); traits::next_segment(first))
+    {
+      auto p = zfwstl::find(traits::local(first), traits::local_end(first), value);
+      if (p != traits::local_end(first))
+      {
+        traits::set_local(first, p);
+        return first;
+      }
+    }
+    auto p = zfwstl::find(traits::local(first), traits::local(last), value);
+    if (p == traits::local(last))
+      return last;
+    traits::set_local(first, p);
+    return first;
+  }
+
+  template <class InputIter, class T>
+  InputIter find_seg(InputIter first, InputIter last, const T &value, std::false_type)
   {
     while (first != last && *first != value)
       ++first;
     return first;
   }
 
+  template <class InputIter, class T>
+  InputIter
+  find(InputIter first, InputIter last, const T &value)
+  {
+    return find_seg(first, last, value, is_segmented_iterator<InputIter>{});
+  }
+
   // ===========================find_if===========================
   // 在[first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素并返回指向该元素的迭代器
   template <class InputIter, class UnaryPredicate>
@@ -577,6 +638,15 @@ namespace zfwstl
     return zfwstl::find_end_dispatch(first1, last1, first2, last2, Category1(), Category2(), comp);
   }
 
+  // 为连续的字节串提供特化版本：从后往前的 SIMD 首末字节过滤(见 simd_algo.h)
+  template <class Tp, class Up>
+  typename std::enable_if<zfwstl::simd_byte_search<Tp, Up>::value, Tp *>::type
+  find_end(Tp *first1, Tp *last1, Up *first2, Up *last2)
+  {
+    typedef typename std::remove_const<Tp>::type value_type;
+    return first1 + (zfwstl::simd_rsearch<value_type>(first1, last1, first2, last2) - first1);
+  }
+
   // ===========================find_first_of===========================
   // 在[first1, last1)中查找[first2, last2)中的某些元素，返回指向第一次出现的元素的迭代器
   template <class InputIter, class ForwardIter>
@@ -620,7 +690,7 @@ namespace zfwstl
    * 如果想一一修改元素内容，应配合transform()使用，且f返回的值会被忽略
    */
   template <class InputIter, class Function>
-  Function for_each(InputIter first, InputIter last, Function f)
+  Function for_each_seg(InputIter first, InputIter last, Function f, std::false_type)
   {
     for (; first != last; ++first)
     {
@@ -629,6 +699,27 @@ namespace zfwstl
     return f;
   }
 
+  // 分段迭代器版本：每段按裸指针遍历，省去每步的段边界判断
+  template <class SegIter, class Function>
+  Function for_each_seg(SegIter first, SegIter last, Function f, std::true_type)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (; !traits::same_segment(first, last); traits::next_segment(first))
+    {
+      for (auto p = traits::local(first), end = traits::local_end(first); p != end; ++p)
+        f(*p);
+    }
+    for (auto p = traits::local(first), end = traits::local(last); p != end; ++p)
+      f(*p);
+    return f;
+  }
+
+  template <class InputIter, class Function>
+  Function for_each(InputIter first, InputIter last, Function f)
+  {
+    return for_each_seg(first, last, f, is_segmented_iterator<InputIter>{});
+  }
+
   // ===========================generate===========================
   // 将函数对象 gen 的运算结果对[first, last)内的每个元素赋值
   // 用的是迭代器所知元素的赋值(assignment)操作符
@@ -1224,6 +1315,15 @@ namespace zfwstl
     return result;
   }
 
+  // 为连续的整数区间提供特化版本：先用 SIMD 求出最大值，再找第一个等于它的位置
+  template <class Tp>
+  typename std::enable_if<zfwstl::simd_comparable<Tp>::value, Tp *>::type
+  max_element(Tp *first, Tp *last)
+  {
+    typedef typename std::remove_const<Tp>::type value_type;
+    return first + (zfwstl::simd_extreme_element<true, value_type>(first, last) - first);
+  }
+
   // 重载版本使用函数对象 comp 代替比较操作
   template <class ForwardIter, class Compared>
   ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp)
@@ -1322,6 +1422,15 @@ namespace zfwstl
     return result;
   }
 
+  // 为连续的整数区间提供特化版本，同 max_element
+  template <class Tp>
+  typename std::enable_if<zfwstl::simd_comparable<Tp>::value, Tp *>::type
+  min_element(Tp *first, Tp *last)
+  {
+    typedef typename std::remove_const<Tp>::type value_type;
+    return first + (zfwstl::simd_extreme_element<false, value_type>(first, last) - first);
+  }
+
   // 重载版本使用函数对象 comp 代替比较操作
   template <class ForwardIter, class Compared>
   ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp)
@@ -2233,83 +2342,467 @@ namespace zfwstl
     return first1;
   }
 
-  // ===========================search_n===========================
-  // 在[first, last)中查找连续 n 个 value 所形成的子序列，返回一个迭代器指向该子序列的起始处
-  template <class ForwardIter, class Size, class T>
-  ForwardIter
-  search_n(ForwardIter first, ForwardIter last, Size n, const T &value)
+  // 为连续的字节串提供特化版本：SIMD 首末字节过滤(见 simd_algo.h)
+  template <class Tp, class Up>
+  typename std::enable_if<zfwstl::simd_byte_search<Tp, Up>::value, Tp *>::type
+  search(Tp *first1, Tp *last1, Up *first2, Up *last2)
   {
-    if (n <= 0)
+    typedef typename std::remove_const<Tp>::type value_type;
+    return first1 + (zfwstl::simd_search<value_type>(first1, last1, first2, last2) - first1);
+  }
+
+  // 使用查找器：searcher(first, last) 返回匹配的区间，这里取其起点；找不到返回 last
+  template <class ForwardIter, class Searcher>
+  ForwardIter search(ForwardIter first, ForwardIter last, const Searcher &searcher)
+  {
+    return searcher(first, last).first;
+  }
+
+  // ===========================searcher===========================
+  /**
+   * 查找器：构造时预处理模式 [pat_first, pat_last)，之后可以在多个文本上重复查找(模式区间必须一直有效)
+   * operator()(first, last) 返回第一次出现的区间 [pos, pos + m)；找不到返回 (last, last)；空模式返回 (first, first)
+   *
+   * default_searcher              : 上面的逐个起点比较，O(n·m)，只要求前向迭代器
+   * boyer_moore_horspool_searcher : 比较窗口末尾的元素，按它在模式中最后出现的位置跳过；
+   *                                 平均 O(n / m)，最坏 O(n·m)。跳跃表为 256 个桶，元素按 hash(x) & 255 分桶，
+   *                                 桶内取最小的跳跃距离(保守)，所以任意可哈希的类型都可用；1 字节整数的哈希互不相同，跳跃表是精确的
+   * two_way_searcher              : Crochemore-Perrin 双向算法，最坏 O(n + m)；需要元素的全序(comp)
+   *                                 预处理求出模式的临界分解 u·v，先从左往右比较 v，再从右往左比较 u，失配时按周期安全地跳过；
+   *                                 整数元素(缺省的序)另外用窗口末尾元素的跳跃表，平均也是亚线性的
+   * simd_searcher                 : 1 字节整数(char 等)的连续区间，用 simd_search(同字节串的 search 特化版本)
+   * 都要求随机访问迭代器(default_searcher 除外)
+   */
+  template <class ForwardIter2, class BinaryPredicate = zfwstl::equal_to<void>>
+  class default_searcher
+  {
+    ForwardIter2 pat_first;
+    ForwardIter2 pat_last;
+    BinaryPredicate pred;
+
+  public:
+    default_searcher(ForwardIter2 first, ForwardIter2 last, BinaryPredicate p = BinaryPredicate())
+        : pat_first(first), pat_last(last), pred(p) {}
+
+    template <class ForwardIter1>
+    zfwstl::pair<ForwardIter1, ForwardIter1> operator()(ForwardIter1 first, ForwardIter1 last) const
     {
-      return first;
+      ForwardIter1 pos = zfwstl::search(first, last, pat_first, pat_last, pred);
+      if (pos == last)
+        return zfwstl::pair<ForwardIter1, ForwardIter1>(last, last);
+      ForwardIter1 end = pos;
+      zfwstl::advance(end, zfwstl::distance(pat_first, pat_last));
+      return zfwstl::pair<ForwardIter1, ForwardIter1>(pos, end);
+    }
+  };
+
+  template <class RandomIter2,
+            class Hash = zfwstl::hash<typename iterator_traits<RandomIter2>::value_type>,
+            class BinaryPredicate = zfwstl::equal_to<typename iterator_traits<RandomIter2>::value_type>>
+  class boyer_moore_horspool_searcher
+  {
+    typedef typename iterator_traits<RandomIter2>::difference_type difference_type;
+    RandomIter2 pat_first;
+    difference_type len;
+    Hash hf;
+    BinaryPredicate pred;
+    difference_type skip[256]; // 窗口末尾元素所在桶 -> 窗口可以右移的距离
+
+    template <class T>
+    size_t bucket(const T &x) const { return static_cast<size_t>(hf(x)) & 255; }
+
+  public:
+    boyer_moore_horspool_searcher(RandomIter2 first, RandomIter2 last,
+                                  Hash h = Hash(), BinaryPredicate p = BinaryPredicate())
+        : pat_first(first), len(last - first), hf(h), pred(p)
+    {
+      for (size_t b = 0; b < 256; ++b)
+        skip[b] = len;
+      // 越靠后的元素跳得越少，后赋值的覆盖前面的，自然就是桶内最小值
+      for (difference_type i = 0; i + 1 < len; ++i)
+        skip[bucket(*(pat_first + i))] = len - 1 - i;
     }
-    else
+
+    template <class RandomIter1>
+    zfwstl::pair<RandomIter1, RandomIter1> operator()(RandomIter1 first, RandomIter1 last) const
     {
-      first = zfwstl::find(first, last, value);
-      while (first != last)
+      if (len == 0)
+        return zfwstl::pair<RandomIter1, RandomIter1>(first, first);
+      const difference_type n = static_cast<difference_type>(last - first);
+      const auto &pat_back = *(pat_first + (len - 1));
+      for (difference_type pos = 0; n - pos >= len;)
       {
-        auto m = n - 1;
-        auto i = first;
-        ++i;
-        while (i != last && m != 0 && *i == value)
+        const auto &back = *(first + (pos + len - 1));
+        if (pred(back, pat_back))
         {
-          ++i;
-          --m;
+          difference_type j = 0;
+          while (j + 1 < len && pred(*(first + (pos + j)), *(pat_first + j)))
+            ++j;
+          if (j + 1 == len)
+            return zfwstl::pair<RandomIter1, RandomIter1>(first + pos, first + (pos + len));
+        }
+        pos += skip[bucket(back)];
+      }
+      return zfwstl::pair<RandomIter1, RandomIter1>(last, last);
+    }
+  };
+
+  template <class RandomIter2, class Compared = zfwstl::less<typename iterator_traits<RandomIter2>::value_type>>
+  class two_way_searcher
+  {
+    typedef typename iterator_traits<RandomIter2>::difference_type difference_type;
+    RandomIter2 pat_first;
+    difference_type len;
+    Compared comp;
+    difference_type split;  // 临界分解：u = [0, split], v = [split + 1, len)
+    difference_type period; // 失配后(u 已匹配)窗口右移的距离
+    difference_type memory; // 模式以 period 为周期时，右移后已知匹配的前缀长度；否则为 0
+    // 整数元素且为缺省的序时，先看窗口末尾的元素：不等于模式末尾元素时按它在模式中最后出现的位置跳过(同 Horspool)
+    difference_type skip[256];
+
+    typedef typename iterator_traits<RandomIter2>::value_type value_type;
+    typedef std::integral_constant<bool, std::is_same<Compared, zfwstl::less<value_type>>::value ||
+                                             std::is_same<Compared, zfwstl::less<void>>::value>
+        default_order;
+    typedef std::integral_constant<bool, default_order::value && std::is_integral<value_type>::value> use_skip;
+
+    // 缺省的 less 直接用 ==，其它的序由 comp 推出相等
+    template <class T, class U>
+    bool eq_aux(const T &a, const U &b, std::true_type) const { return a == b; }
+    template <class T, class U>
+    bool eq_aux(const T &a, const U &b, std::false_type) const { return !comp(a, b) && !comp(b, a); }
+    template <class T, class U>
+    bool eq(const T &a, const U &b) const { return eq_aux(a, b, default_order()); }
+
+    template <class T>
+    static size_t bucket(const T &x) { return static_cast<size_t>(x) & 255; }
+
+    // 最大后缀 [suffix + 1, len) 及其周期；reversed 为 true 时按相反的序
+    void maximal_suffix(bool reversed, difference_type &suffix, difference_type &per) const
+    {
+      difference_type ip = -1, jp = 0, k = 1, p = 1;
+      while (jp + k < len)
+      {
+        const auto &a = *(pat_first + (ip + k));
+        const auto &b = *(pat_first + (jp + k));
+        if (eq(a, b))
+        {
+          if (k == p)
+          {
+            jp += p;
+            k = 1;
+          }
+          else
+          {
+            ++k;
+          }
+        }
+        else if (reversed ? comp(a, b) : comp(b, a))
+        {
+          jp += k;
+          k = 1;
+          p = jp - ip;
         }
-        if (m == 0)
-          return first;
         else
-          first = zfwstl::find(i, last, value);
+        {
+          ip = jp++;
+          k = p = 1;
+        }
       }
-      return last;
+      suffix = ip;
+      per = p;
+    }
+
+    void init_skip(std::false_type) {}
+    void init_skip(std::true_type)
+    {
+      for (size_t b = 0; b < 256; ++b)
+        skip[b] = len;
+      for (difference_type i = 0; i < len; ++i)
+        skip[bucket(*(pat_first + i))] = len - 1 - i;
+    }
+
+    // 窗口 [pos, pos + len) 可以右移的距离，0 表示需要逐个比较
+    template <class RandomIter1>
+    difference_type skip_of(RandomIter1, difference_type, std::false_type) const { return 0; }
+    template <class RandomIter1>
+    difference_type skip_of(RandomIter1 first, difference_type pos, std::true_type) const
+    {
+      const auto &back = *(first + (pos + len - 1));
+      return back == *(pat_first + (len - 1)) ? 0 : skip[bucket(back)];
+    }
+
+  public:
+    two_way_searcher(RandomIter2 first, RandomIter2 last, Compared c = Compared())
+        : pat_first(first), len(last - first), comp(c), split(-1), period(1), memory(0)
+    {
+      if (len == 0)
+        return;
+      difference_type s1, p1, s2, p2;
+      maximal_suffix(false, s1, p1);
+      maximal_suffix(true, s2, p2);
+      // 两种序的最大后缀中取较短的一个(起点较大)，即为临界分解
+      split = s2 > s1 ? s2 : s1;
+      period = s2 > s1 ? p2 : p1;
+      bool periodic = period + split + 1 <= len;
+      for (difference_type i = 0; periodic && i <= split; ++i)
+        periodic = eq(*(pat_first + i), *(pat_first + (i + period)));
+      if (periodic)
+      {
+        memory = len - period;
+      }
+      else
+      {
+        memory = 0;
+        period = (split > len - split - 1 ? split : len - split - 1) + 1;
+      }
+      init_skip(use_skip());
+    }
+
+    template <class RandomIter1>
+    zfwstl::pair<RandomIter1, RandomIter1> operator()(RandomIter1 first, RandomIter1 last) const
+    {
+      if (len == 0)
+        return zfwstl::pair<RandomIter1, RandomIter1>(first, first);
+      const difference_type n = static_cast<difference_type>(last - first);
+      difference_type mem = 0; // 当前窗口已知匹配的前缀长度
+      for (difference_type pos = 0; n - pos >= len;)
+      {
+        // 没有已知匹配的前缀时才跳跃(跳跃后的状态与从该位置重新开始相同，不破坏线性时间)
+        if (mem == 0)
+        {
+          const difference_type shift = skip_of(first, pos, use_skip());
+          if (shift != 0)
+          {
+            pos += shift;
+            continue;
+          }
+        }
+        // 从左往右比较 v
+        difference_type k = split + 1 > mem ? split + 1 : mem;
+        while (k < len && eq(*(pat_first + k), *(first + (pos + k))))
+          ++k;
+        if (k < len)
+        {
+          pos += k - split;
+          mem = 0;
+          continue;
+        }
+        // 再从右往左比较 u
+        k = split + 1;
+        while (k > mem && eq(*(pat_first + (k - 1)), *(first + (pos + k - 1))))
+          --k;
+        if (k <= mem)
+          return zfwstl::pair<RandomIter1, RandomIter1>(first + pos, first + (pos + len));
+        pos += period;
+        mem = memory;
+      }
+      return zfwstl::pair<RandomIter1, RandomIter1>(last, last);
+    }
+  };
+
+  template <class CharT>
+  class simd_searcher
+  {
+    static_assert(zfwstl::simd_byte_search<CharT, CharT>::value, "simd_searcher requires a 1-byte integer type");
+    typedef typename std::remove_const<CharT>::type value_type;
+    const value_type *pat_first;
+    const value_type *pat_last;
+
+  public:
+    simd_searcher(const value_type *first, const value_type *last) : pat_first(first), pat_last(last) {}
+
+    template <class Tp>
+    typename std::enable_if<zfwstl::simd_byte_search<Tp, value_type>::value, zfwstl::pair<Tp *, Tp *>>::type
+    operator()(Tp *first, Tp *last) const
+    {
+      Tp *pos = first + (zfwstl::simd_search<value_type>(first, last, pat_first, pat_last) - first);
+      return zfwstl::pair<Tp *, Tp *>(pos, pos == last ? last : pos + (pat_last - pat_first));
+    }
+  };
+
+  template <class ForwardIter2>
+  default_searcher<ForwardIter2> make_default_searcher(ForwardIter2 first, ForwardIter2 last)
+  {
+    return default_searcher<ForwardIter2>(first, last);
+  }
+  template <class ForwardIter2, class BinaryPredicate>
+  default_searcher<ForwardIter2, BinaryPredicate>
+  make_default_searcher(ForwardIter2 first, ForwardIter2 last, BinaryPredicate pred)
+  {
+    return default_searcher<ForwardIter2, BinaryPredicate>(first, last, pred);
+  }
+  template <class RandomIter2>
+  boyer_moore_horspool_searcher<RandomIter2> make_boyer_moore_horspool_searcher(RandomIter2 first, RandomIter2 last)
+  {
+    return boyer_moore_horspool_searcher<RandomIter2>(first, last);
+  }
+  template <class RandomIter2, class Hash, class BinaryPredicate>
+  boyer_moore_horspool_searcher<RandomIter2, Hash, BinaryPredicate>
+  make_boyer_moore_horspool_searcher(RandomIter2 first, RandomIter2 last, Hash hf, BinaryPredicate pred)
+  {
+    return boyer_moore_horspool_searcher<RandomIter2, Hash, BinaryPredicate>(first, last, hf, pred);
+  }
+  template <class RandomIter2>
+  two_way_searcher<RandomIter2> make_two_way_searcher(RandomIter2 first, RandomIter2 last)
+  {
+    return two_way_searcher<RandomIter2>(first, last);
+  }
+  template <class RandomIter2, class Compared>
+  two_way_searcher<RandomIter2, Compared> make_two_way_searcher(RandomIter2 first, RandomIter2 last, Compared comp)
+  {
+    return two_way_searcher<RandomIter2, Compared>(first, last, comp);
+  }
+  template <class CharT>
+  simd_searcher<CharT> make_simd_searcher(const CharT *first, const CharT *last)
+  {
+    return simd_searcher<CharT>(first, last);
+  }
+
+  // ===========================search_n===========================
+  // 在[first, last)中查找连续 n 个 value 所形成的子序列，返回一个迭代器指向该子序列的起始处
+  /**
+   * 随机访问迭代器的版本可以跳跃：设候选区间为 [cand, cand + n)，先看它的最后一个元素，
+   * 不相等则任何包含它的区间都不可能，直接跳到它的下一个元素，每次比较一个元素就跳过 n 个；
+   * 相等则往回数到第一个不相等的元素，再从后面继续往前数，每个元素最多比较一次
+   * matches(x) 判断元素是否等于 value
+   */
+  template <class RandomIter, class Size, class UnaryPredicate>
+  RandomIter search_n_skip(RandomIter first, RandomIter last, Size count, UnaryPredicate matches)
+  {
+    typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+    const difference_type n = static_cast<difference_type>(count);
+    RandomIter cand = first; // 在 cand 之前开始的区间都已排除
+    while (last - cand >= n)
+    {
+      RandomIter probe = cand + (n - 1);
+      if (!matches(*probe))
+      {
+        cand = probe + 1;
+        continue;
+      }
+      RandomIter back = probe;
+      while (back != cand && matches(*(back - 1)))
+        --back;
+      if (back == cand)
+        return cand;
+      // [back, probe] 都相等，back - 1 不相等：从 back 开始的区间还差 n - (probe - back + 1) 个
+      cand = back;
+      RandomIter forward = probe + 1;
+      difference_type have = probe - back + 1;
+      while (have < n && forward != last && matches(*forward))
+      {
+        ++forward;
+        ++have;
+      }
+      if (have == n)
+        return cand;
+      if (forward == last)
+        return last;
+      cand = forward + 1;
+    }
+    return last;
+  }
+
+  template <class ForwardIter, class Size, class T>
+  ForwardIter
+  search_n_dispatch(ForwardIter first, ForwardIter last, Size n, const T &value, forward_iterator_tag)
+  {
+    first = zfwstl::find(first, last, value);
+    while (first != last)
+    {
+      auto m = n - 1;
+      auto i = first;
+      ++i;
+      while (i != last && m != 0 && *i == value)
+      {
+        ++i;
+        --m;
+      }
+      if (m == 0)
+        return first;
+      else
+        first = zfwstl::find(i, last, value);
     }
+    return last;
+  }
+
+  template <class RandomIter, class Size, class T>
+  RandomIter
+  search_n_dispatch(RandomIter first, RandomIter last, Size n, const T &value, random_access_iterator_tag)
+  {
+    if (n == 1)
+      return zfwstl::find(first, last, value);
+    return zfwstl::search_n_skip(first, last, n, [&value](typename iterator_traits<RandomIter>::reference x)
+                                 { return x == value; });
+  }
+
+  template <class ForwardIter, class Size, class T>
+  ForwardIter
+  search_n(ForwardIter first, ForwardIter last, Size n, const T &value)
+  {
+    if (n <= 0)
+      return first;
+    return zfwstl::search_n_dispatch(first, last, n, value, iterator_category(first));
   }
 
   // 重载版本使用函数对象 comp 代替比较操作
   template <class ForwardIter, class Size, class T, class Compared>
   ForwardIter
-  search_n(ForwardIter first, ForwardIter last,
-           Size n, const T &value, Compared comp)
+  search_n_dispatch(ForwardIter first, ForwardIter last,
+                    Size n, const T &value, Compared comp, forward_iterator_tag)
   {
-    if (n <= 0)
+    while (first != last)
     {
-      return first;
+      if (comp(*first, value))
+        break;
+      ++first;
     }
-    else
+    while (first != last)
     {
-      while (first != last)
+      auto m = n - 1;
+      auto i = first;
+      ++i;
+      while (i != last && m != 0 && comp(*i, value))
       {
-        if (comp(*first, value))
-          break;
-        ++first;
+        ++i;
+        --m;
       }
-      while (first != last)
+      if (m == 0)
       {
-        auto m = n - 1;
-        auto i = first;
-        ++i;
-        while (i != last && m != 0 && comp(*i, value))
+        return first;
+      }
+      else
+      {
+        while (i != last)
         {
+          if (comp(*i, value))
+            break;
           ++i;
-          --m;
-        }
-        if (m == 0)
-        {
-          return first;
-        }
-        else
-        {
-          while (i != last)
-          {
-            if (comp(*i, value))
-              break;
-            ++i;
-          }
-          first = i;
         }
+        first = i;
       }
-      return last;
     }
+    return last;
+  }
+
+  template <class RandomIter, class Size, class T, class Compared>
+  RandomIter
+  search_n_dispatch(RandomIter first, RandomIter last,
+                    Size n, const T &value, Compared comp, random_access_iterator_tag)
+  {
+    return zfwstl::search_n_skip(first, last, n, [&value, &comp](typename iterator_traits<RandomIter>::reference x)
+                                 { return comp(x, value); });
+  }
+
+  template <class ForwardIter, class Size, class T, class Compared>
+  ForwardIter
+  search_n(ForwardIter first, ForwardIter last,
+           Size n, const T &value, Compared comp)
+  {
+    if (n <= 0)
+      return first;
+    return zfwstl::search_n_dispatch(first, last, n, value, comp, iterator_category(first));
   }
 
   // ===========================sort===========================
@@ -2317,7 +2810,8 @@ namespace zfwstl
    * STL的排序算法：
    * 数据量大-->快排
    * 一旦分段，数据量小于某个门槛-->插入排序
-   * 若递归层次过深-->堆排序
+   * 若分割恶化次数过多-->堆排序
+   * 快排部分采用 pdqsort 的做法(见 intro_sort)，对有序、逆序、大量重复等输入是线性或接近线性的
    */
   // 将[first, last)内的元素以递增的方式排序
   constexpr static size_t kSmallSectionSize = 128; // 小型区间的大小，在这个大小内采用插入排序
@@ -2351,25 +2845,6 @@ namespace zfwstl
     }
   }
 
-  // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
-  template <class RandomIter, class Size>
-  void intro_sort(RandomIter first, RandomIter last, Size depth_limit)
-  {
-    while (static_cast<size_t>(last - first) > kSmallSectionSize)
-    {
-      if (depth_limit == 0)
-      {                                          // 到达最大分割深度限制
-        zfwstl::partial_sort(first, last, last); // 改用 heap_sort
-        return;
-      }
-      --depth_limit;
-      auto mid = zfwstl::median(*(first), *(first + (last - first) / 2), *(last - 1));
-      auto cut = zfwstl::unchecked_partition(first, last, mid);
-      zfwstl::intro_sort(cut, last, depth_limit);
-      last = cut;
-    }
-  }
-
   // 插入排序辅助函数 unchecked_linear_insert
   template <class RandomIter, class T>
   void unchecked_linear_insert(RandomIter last, const T &value)
@@ -2391,7 +2866,8 @@ namespace zfwstl
   {
     for (auto i = first; i != last; ++i)
     {
-      zfwstl::unchecked_linear_insert(i, *i);
+      auto value = *i; // 先取出：搬移时 *i 会被覆盖
+      zfwstl::unchecked_linear_insert(i, value);
     }
   }
 
@@ -2416,32 +2892,6 @@ namespace zfwstl
     }
   }
 
-  // 最终插入排序函数 final_insertion_sort
-  template <class RandomIter>
-  void final_insertion_sort(RandomIter first, RandomIter last)
-  {
-    if (static_cast<size_t>(last - first) > kSmallSectionSize)
-    {
-      zfwstl::insertion_sort(first, first + kSmallSectionSize);
-      zfwstl::unchecked_insertion_sort(first + kSmallSectionSize, last);
-    }
-    else
-    {
-      zfwstl::insertion_sort(first, last);
-    }
-  }
-
-  template <class RandomIter>
-  void sort(RandomIter first, RandomIter last)
-  {
-    if (first != last)
-    {
-      // 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序
-      zfwstl::intro_sort(first, last, slg2(last - first) * 2);
-      zfwstl::final_insertion_sort(first, last);
-    }
-  }
-
   // 重载版本使用函数对象 comp 代替比较操作
   // 分割函数 unchecked_partition
   template <class RandomIter, class T, class Compared>
@@ -2463,26 +2913,6 @@ namespace zfwstl
     }
   }
 
-  // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
-  template <class RandomIter, class Size, class Compared>
-  void intro_sort(RandomIter first, RandomIter last,
-                  Size depth_limit, Compared comp)
-  {
-    while (static_cast<size_t>(last - first) > kSmallSectionSize)
-    {
-      if (depth_limit == 0)
-      {                                                // 到达最大分割深度限制
-        zfwstl::partial_sort(first, last, last, comp); // 改用 heap_sort
-        return;
-      }
-      --depth_limit;
-      auto mid = zfwstl::median(*(first), *(first + (last - first) / 2), *(last - 1));
-      auto cut = zfwstl::unchecked_partition(first, last, mid, comp);
-      zfwstl::intro_sort(cut, last, depth_limit, comp);
-      last = cut;
-    }
-  }
-
   // 插入排序辅助函数 unchecked_linear_insert
   template <class RandomIter, class T, class Compared>
   void unchecked_linear_insert(RandomIter last, const T &value, Compared comp)
@@ -2505,7 +2935,8 @@ namespace zfwstl
   {
     for (auto i = first; i != last; ++i)
     {
-      zfwstl::unchecked_linear_insert(i, *i, comp);
+      auto value = *i; // 先取出：搬移时 *i 会被覆盖
+      zfwstl::unchecked_linear_insert(i, value, comp);
     }
   }
 
@@ -2530,19 +2961,360 @@ namespace zfwstl
     }
   }
 
-  // 最终插入排序函数 final_insertion_sort
+  // 以下为 pattern-defeating quicksort(pdqsort) 形式的内省式排序
+  constexpr static size_t kInsertionSortThreshold = 24; // 不超过这个大小的区段直接插入排序
+  constexpr static size_t kNintherThreshold = 128;      // 超过这个大小用九点取中(ninther)选枢轴
+  constexpr static size_t kPartialInsertionLimit = 8;   // partial_insertion_sort 最多搬移的次数
+  constexpr static size_t kPartitionBlockSize = 64;     // 无分支分割每块的元素个数(偏移量存在 unsigned char 中)
+
+  // 比较很便宜的情况(算术类型 + 缺省的 less / greater)才用无分支分割：
+  // 其余情况比较次数更重要，用普通的分割
+  template <class T, class Compared>
+  struct use_branchless_partition
+      : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                         (std::is_same<Compared, zfwstl::less<T>>::value ||
+                                          std::is_same<Compared, zfwstl::greater<T>>::value ||
+                                          std::is_same<Compared, zfwstl::less<void>>::value ||
+                                          std::is_same<Compared, zfwstl::greater<void>>::value)>
+  {
+  };
+
+  // 使 *a <= *b
   template <class RandomIter, class Compared>
-  void final_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+  void sort2(RandomIter a, RandomIter b, Compared comp)
   {
-    if (static_cast<size_t>(last - first) > kSmallSectionSize)
-    {
-      zfwstl::insertion_sort(first, first + kSmallSectionSize, comp);
-      zfwstl::unchecked_insertion_sort(first + kSmallSectionSize, last, comp);
-    }
-    else
-    {
-      zfwstl::insertion_sort(first, last, comp);
-    }
+    if (comp(*b, *a))
+      zfwstl::iter_swap(a, b);
+  }
+
+  // 使 *a <= *b <= *c
+  template <class RandomIter, class Compared>
+  void sort3(RandomIter a, RandomIter b, RandomIter c, Compared comp)
+  {
+    zfwstl::sort2(a, b, comp);
+    zfwstl::sort2(b, c, comp);
+    zfwstl::sort2(a, b, comp);
+  }
+
+  // 插入排序，但搬移次数超过 kPartialInsertionLimit 时放弃并返回 false；返回 true 表示已排好序
+  // 用来以很小的代价识别几乎有序的区段
+  template <class RandomIter, class Compared>
+  bool partial_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+  {
+    if (first == last)
+      return true;
+    size_t limit = 0;
+    for (auto cur = first + 1; cur != last; ++cur)
+    {
+      auto sift = cur;
+      auto sift_1 = cur - 1;
+      if (comp(*sift, *sift_1))
+      {
+        auto value = zfwstl::move(*sift);
+        do
+        {
+          *sift-- = zfwstl::move(*sift_1);
+        } while (sift != first && comp(value, *--sift_1));
+        *sift = zfwstl::move(value);
+        limit += static_cast<size_t>(cur - sift);
+      }
+      if (limit > kPartialInsertionLimit)
+        return false;
+    }
+    return true;
+  }
+
+  // 把 first + offsets_l[i] 与 last - offsets_r[i] 两两交换
+  // 个数不等时用循环搬移(每对只需两次赋值)；个数相等时必须逐对交换，否则逆序输入会退化
+  template <class RandomIter>
+  void swap_offsets(RandomIter first, RandomIter last,
+                    const unsigned char *offsets_l, const unsigned char *offsets_r,
+                    size_t num, bool use_swaps)
+  {
+    if (use_swaps)
+    {
+      for (size_t i = 0; i < num; ++i)
+        zfwstl::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+    }
+    else if (num > 0)
+    {
+      auto l = first + offsets_l[0];
+      auto r = last - offsets_r[0];
+      auto tmp = zfwstl::move(*l);
+      *l = zfwstl::move(*r);
+      for (size_t i = 1; i < num; ++i)
+      {
+        l = first + offsets_l[i];
+        *r = zfwstl::move(*l);
+        r = last - offsets_r[i];
+        *l = zfwstl::move(*r);
+      }
+      *r = zfwstl::move(tmp);
+    }
+  }
+
+  // 以 *first 为枢轴分割：小于枢轴的放左边，不小于的放右边，返回枢轴的最终位置
+  // second 为 true 表示区间本来就分割好了(一次交换也没做)
+  // 调用前需保证 *(last - 1) 不小于枢轴(选枢轴时已保证)，左右扫描因此不需要边界检查
+  template <class RandomIter, class Compared>
+  pair<RandomIter, bool> partition_right(RandomIter first, RandomIter last, Compared comp)
+  {
+    auto begin = first;
+    auto pivot = zfwstl::move(*begin);
+    while (comp(*++first, pivot))
+      ;
+    if (first - 1 == begin)
+    {
+      while (first < last && !comp(*--last, pivot))
+        ;
+    }
+    else
+    {
+      while (!comp(*--last, pivot))
+        ;
+    }
+    const bool already_partitioned = first >= last;
+    while (first < last)
+    {
+      zfwstl::iter_swap(first, last);
+      while (comp(*++first, pivot))
+        ;
+      while (!comp(*--last, pivot))
+        ;
+    }
+    auto pivot_pos = first - 1;
+    *begin = zfwstl::move(*pivot_pos);
+    *pivot_pos = zfwstl::move(pivot);
+    return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+  }
+
+  // 同 partition_right，但用块分割(BlockQuicksort)避免分支预测失败：
+  // 左右各取一块，先只记录放错边的元素的偏移量(比较结果直接加到计数上，没有分支)，再成批交换
+  template <class RandomIter, class Compared>
+  pair<RandomIter, bool> partition_right_branchless(RandomIter first, RandomIter last, Compared comp)
+  {
+    auto begin = first;
+    auto pivot = zfwstl::move(*begin);
+    while (comp(*++first, pivot))
+      ;
+    if (first - 1 == begin)
+    {
+      while (first < last && !comp(*--last, pivot))
+        ;
+    }
+    else
+    {
+      while (!comp(*--last, pivot))
+        ;
+    }
+    const bool already_partitioned = first >= last;
+    if (!already_partitioned)
+    {
+      zfwstl::iter_swap(first, last);
+      ++first;
+      unsigned char offsets_l[kPartitionBlockSize];
+      unsigned char offsets_r[kPartitionBlockSize];
+      auto offsets_l_base = first;
+      auto offsets_r_base = last;
+      size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+      while (first < last)
+      {
+        // 决定左右两块各扫描多少个未知元素：只有空了的一侧才继续扫描
+        const size_t num_unknown = static_cast<size_t>(last - first);
+        const size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+        const size_t right_split = num_r == 0 ? num_unknown - left_split : 0;
+        const size_t l_size = left_split < kPartitionBlockSize ? left_split : kPartitionBlockSize;
+        const size_t r_size = right_split < kPartitionBlockSize ? right_split : kPartitionBlockSize;
+        for (size_t i = 0; i < l_size; ++i)
+        {
+          offsets_l[num_l] = static_cast<unsigned char>(i);
+          num_l += !comp(*first, pivot);
+          ++first;
+        }
+        for (size_t i = 0; i < r_size; ++i)
+        {
+          offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+          num_r += comp(*--last, pivot);
+        }
+        const size_t num = num_l < num_r ? num_l : num_r;
+        zfwstl::swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                             num, num_l == num_r);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0)
+        {
+          start_l = 0;
+          offsets_l_base = first;
+        }
+        if (num_r == 0)
+        {
+          start_r = 0;
+          offsets_r_base = last;
+        }
+      }
+      // 未知元素已全部扫描完，剩下一侧还有放错边的元素：逐个换到分界处
+      if (num_l)
+      {
+        while (num_l--)
+          zfwstl::iter_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+        first = last;
+      }
+      if (num_r)
+      {
+        while (num_r--)
+        {
+          zfwstl::iter_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+          ++first;
+        }
+      }
+    }
+    auto pivot_pos = first - 1;
+    *begin = zfwstl::move(*pivot_pos);
+    *pivot_pos = zfwstl::move(pivot);
+    return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+  }
+
+  template <class RandomIter, class Compared>
+  pair<RandomIter, bool> partition_right(RandomIter first, RandomIter last, Compared comp, std::true_type)
+  {
+    return zfwstl::partition_right_branchless(first, last, comp);
+  }
+  template <class RandomIter, class Compared>
+  pair<RandomIter, bool> partition_right(RandomIter first, RandomIter last, Compared comp, std::false_type)
+  {
+    return zfwstl::partition_right(first, last, comp);
+  }
+
+  // 以 *first 为枢轴分割：不大于枢轴的放左边，大于的放右边，返回枢轴的最终位置
+  // 用于枢轴与左边相邻区段的枢轴相等的情况：左边的部分全都等于枢轴，不需要再排序(即重复元素的"胖分割")
+  template <class RandomIter, class Compared>
+  RandomIter partition_left(RandomIter first, RandomIter last, Compared comp)
+  {
+    auto begin = first;
+    const auto &pivot = *begin; // 交换只发生在 begin 之后，*begin 在分割过程中不变，也是左扫描的哨兵
+    auto end = last;
+    while (comp(pivot, *--last))
+      ;
+    if (last + 1 == end)
+    {
+      while (first < last && !comp(pivot, *++first))
+        ;
+    }
+    else
+    {
+      while (!comp(pivot, *++first))
+        ;
+    }
+    while (first < last)
+    {
+      zfwstl::iter_swap(first, last);
+      while (comp(pivot, *--last))
+        ;
+      while (!comp(pivot, *++first))
+        ;
+    }
+    zfwstl::iter_swap(begin, last);
+    return last;
+  }
+
+  // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
+  // 在经典做法上的改进(pdqsort)：
+  //   1. 九点取中选枢轴；分割很不平衡时打乱几个元素破坏输入的模式，bad_allowed 次之后才改用 heap sort
+  //   2. 分割时一次交换也没做，说明区段可能已经有序，用 partial_insertion_sort 试一下，成功就直接结束
+  //   3. 枢轴与左边相邻区段的枢轴相等时(说明有大量重复元素)，用 partition_left 把等于枢轴的元素一次分出去
+  //   4. 比较便宜时用无分支的块分割(见 partition_right_branchless)
+  // leftmost 为 false 时 *(first - 1) 不大于区间内所有元素，可以作为插入排序的哨兵
+  template <class RandomIter, class Size, class Compared, class Branchless>
+  void intro_sort(RandomIter first, RandomIter last, Size bad_allowed, Compared comp,
+                  bool leftmost, Branchless branchless)
+  {
+    while (true)
+    {
+      const size_t size = static_cast<size_t>(last - first);
+      if (size <= kInsertionSortThreshold)
+      {
+        if (leftmost)
+          zfwstl::insertion_sort(first, last, comp);
+        else
+          zfwstl::unchecked_insertion_sort(first, last, comp);
+        return;
+      }
+      // 选枢轴放到 *first，同时保证 *(last - 1) 不小于枢轴
+      const size_t half = size / 2;
+      if (size > kNintherThreshold)
+      {
+        zfwstl::sort3(first, first + half, last - 1, comp);
+        zfwstl::sort3(first + 1, first + (half - 1), last - 2, comp);
+        zfwstl::sort3(first + 2, first + (half + 1), last - 3, comp);
+        zfwstl::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+        zfwstl::iter_swap(first, first + half);
+      }
+      else
+      {
+        zfwstl::sort3(first + half, first, last - 1, comp);
+      }
+      if (!leftmost && !comp(*(first - 1), *first))
+      { // 枢轴等于左边的枢轴：等于它的元素都放左边，不再处理
+        first = zfwstl::partition_left(first, last, comp) + 1;
+        continue;
+      }
+      auto part = zfwstl::partition_right(first, last, comp, branchless);
+      auto pivot_pos = part.first;
+      const size_t l_size = static_cast<size_t>(pivot_pos - first);
+      const size_t r_size = static_cast<size_t>(last - (pivot_pos + 1));
+      if (l_size < size / 8 || r_size < size / 8)
+      { // 分割很不平衡
+        if (--bad_allowed == 0)
+        {
+          zfwstl::partial_sort(first, last, last, comp); // 改用 heap_sort
+          return;
+        }
+        if (l_size >= kInsertionSortThreshold)
+        {
+          zfwstl::iter_swap(first, first + l_size / 4);
+          zfwstl::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+          if (l_size > kNintherThreshold)
+          {
+            zfwstl::iter_swap(first + 1, first + (l_size / 4 + 1));
+            zfwstl::iter_swap(first + 2, first + (l_size / 4 + 2));
+            zfwstl::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+            zfwstl::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+          }
+        }
+        if (r_size >= kInsertionSortThreshold)
+        {
+          zfwstl::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+          zfwstl::iter_swap(last - 1, last - r_size / 4);
+          if (r_size > kNintherThreshold)
+          {
+            zfwstl::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+            zfwstl::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+            zfwstl::iter_swap(last - 2, last - (1 + r_size / 4));
+            zfwstl::iter_swap(last - 3, last - (2 + r_size / 4));
+          }
+        }
+      }
+      else if (part.second &&
+               zfwstl::partial_insertion_sort(first, pivot_pos, comp) &&
+               zfwstl::partial_insertion_sort(pivot_pos + 1, last, comp))
+      { // 本来就分割好，两边也几乎有序
+        return;
+      }
+      // 递归处理较短的一段，较长的一段继续循环，栈深度不超过 O(log n)
+      if (l_size < r_size)
+      {
+        zfwstl::intro_sort(first, pivot_pos, bad_allowed, comp, leftmost, branchless);
+        first = pivot_pos + 1;
+        leftmost = false;
+      }
+      else
+      {
+        zfwstl::intro_sort(pivot_pos + 1, last, bad_allowed, comp, false, branchless);
+        last = pivot_pos;
+      }
+    }
   }
 
   template <class RandomIter, class Compared>
@@ -2550,17 +3322,350 @@ namespace zfwstl
   {
     if (first != last)
     {
-      // 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序
-      zfwstl::intro_sort(first, last, slg2(last - first) * 2, comp);
-      zfwstl::final_insertion_sort(first, last, comp);
+      typedef typename iterator_traits<RandomIter>::value_type value_type;
+      zfwstl::intro_sort(first, last, slg2(last - first), comp, true,
+                         use_branchless_partition<value_type, Compared>());
     }
   }
 
+  template <class RandomIter>
+  void sort(RandomIter first, RandomIter last)
+  {
+    zfwstl::sort(first, last, zfwstl::less<typename iterator_traits<RandomIter>::value_type>());
+  }
+
   // ===========================stable_partition ===========================
   // 分割并保持元素的相对次序(对应区别 partition)
 
   // ===========================stable_sort===========================
   // 排序并保持等值元素的相对次序
+  // 归并排序：配置 n 个元素的缓冲区，每层归并在原区间与缓冲区之间来回搬移一次；不超过 kStableChunk 的小段用插入排序
+  constexpr static size_t kStableChunk = 16;
+
+  // 搬移式归并，相等时先取第一段的元素(稳定)
+  template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+  OutputIter move_merge(InputIter1 first1, InputIter1 last1,
+                        InputIter2 first2, InputIter2 last2,
+                        OutputIter result, Compared comp)
+  {
+    for (; first1 != last1 && first2 != last2; ++result)
+    {
+      if (comp(*first2, *first1))
+        *result = zfwstl::move(*first2++);
+      else
+        *result = zfwstl::move(*first1++);
+    }
+    for (; first1 != last1; ++first1, ++result)
+      *result = zfwstl::move(*first1);
+    for (; first2 != last2; ++first2, ++result)
+      *result = zfwstl::move(*first2);
+    return result;
+  }
+
+  // 数据在 [first, last)，to_other 为 true 时排序结果放到 other 开始的等长区间，否则留在原处
+  // 两段空间都必须是已构造的对象；两个子区间的结果放在与本层相反的一侧，归并时正好搬到本层要的一侧
+  template <class Iter1, class Iter2, class Compared>
+  void stable_sort_aux(Iter1 first, Iter1 last, Iter2 other, bool to_other, Compared comp)
+  {
+    const auto len = last - first;
+    if (len <= static_cast<decltype(len)>(kStableChunk))
+    {
+      zfwstl::insertion_sort(first, last, comp); // 插入排序只在严格小于时前移，是稳定的
+      if (to_other)
+      {
+        for (; first != last; ++first, ++other)
+          *other = zfwstl::move(*first);
+      }
+      return;
+    }
+    const auto half = len / 2;
+    zfwstl::stable_sort_aux(first, first + half, other, !to_other, comp);
+    zfwstl::stable_sort_aux(first + half, last, other + half, !to_other, comp);
+    if (to_other)
+      zfwstl::move_merge(first, first + half, first + half, last, other, comp);
+    else
+      zfwstl::move_merge(other, other + half, other + half, other + len, first, comp);
+  }
+
+  // 稳定排序的缓冲区：配置 len 个元素的空间，并以 [first, first + len) 的元素移动构造
+  template <class RandomIter>
+  class stable_sort_buffer
+  {
+  public:
+    typedef typename zfwstl::iterator_traits<RandomIter>::value_type value_type;
+
+  private:
+    typedef zfwstl::simple_allocator<value_type> data_allocator;
+    value_type *buf;
+    size_t len;
+
+  public:
+    stable_sort_buffer(RandomIter first, size_t n) : buf(data_allocator::allocate(n)), len(0)
+    {
+      try
+      {
+        for (; len < n; ++len, ++first)
+          zfwstl::construct(buf + len, zfwstl::move(*first));
+      }
+      catch (...)
+      {
+        zfwstl::destroy(buf, buf + len);
+        data_allocator::deallocate(buf, n);
+        throw;
+      }
+    }
+    ~stable_sort_buffer()
+    {
+      zfwstl::destroy(buf, buf + len);
+      data_allocator::deallocate(buf, len);
+    }
+    stable_sort_buffer(const stable_sort_buffer &) = delete;
+    stable_sort_buffer &operator=(const stable_sort_buffer &) = delete;
+
+    value_type *begin() const noexcept { return buf; }
+    value_type *end() const noexcept { return buf + len; }
+  };
+
+  // 重载版本使用函数对象 comp 代替比较操作
+  template <class RandomIter, class Compared>
+  void stable_sort(RandomIter first, RandomIter last, Compared comp)
+  {
+    const auto len = last - first;
+    if (len <= static_cast<decltype(len)>(kStableChunk))
+    {
+      zfwstl::insertion_sort(first, last, comp);
+      return;
+    }
+    // 元素先移入缓冲区，再以缓冲区为数据、原区间为另一侧排序，结果落回原区间
+    stable_sort_buffer<RandomIter> buf(first, static_cast<size_t>(len));
+    zfwstl::stable_sort_aux(buf.begin(), buf.end(), first, true, comp);
+  }
+
+  template <class RandomIter>
+  void stable_sort(RandomIter first, RandomIter last)
+  {
+    zfwstl::stable_sort(first, last, zfwstl::less<typename zfwstl::iterator_traits<RandomIter>::value_type>());
+  }
+
+  // ===========================radix_sort===========================
+  // 基数排序(LSD)：按键的字节从低到高，每趟把元素稳定地分配到 256 个桶，共 sizeof(键) 趟；
+  // 一趟扫描统计出所有字节的直方图，所有元素某字节都相同的那趟直接跳过；
+  // 元素多于 kRadixMsdThreshold 时先按最高字节做一趟 MSD 分配，各桶再分别排序(见 radix_sort_aux)
+  // 键可以是整数(含有符号)、float、double，先映射为顺序相同的无符号整数：
+  //   有符号整数翻转符号位；浮点数为负时各位取反，非负时翻转符号位(-0.0 排在 +0.0 前，NaN 按符号位排在两端)
+  // 需要 n 个元素的缓冲区(simple_allocator 配置)，元素在原区间与缓冲区之间来回搬移；是稳定排序
+  // 不超过 kSmallSectionSize 个元素时改用插入排序
+  constexpr static size_t kRadixMsdThreshold = 1 << 16;
+
+  template <class Key, class Enable = void>
+  struct radix_traits;
+
+  template <class Key>
+  struct radix_traits<Key, typename std::enable_if<std::is_integral<Key>::value && !std::is_same<Key, bool>::value>::type>
+  {
+    typedef typename std::make_unsigned<Key>::type bits_type;
+    static bits_type to_bits(Key k)
+    {
+      return std::is_signed<Key>::value
+                 ? static_cast<bits_type>(static_cast<bits_type>(k) ^ (bits_type(1) << (sizeof(Key) * 8 - 1)))
+                 : static_cast<bits_type>(k);
+    }
+  };
+
+  template <>
+  struct radix_traits<float>
+  {
+    typedef uint32_t bits_type;
+    static bits_type to_bits(float k)
+    {
+      bits_type b;
+      std::memcpy(&b, &k, sizeof(b));
+      return (b & 0x80000000u) ? ~b : (b | 0x80000000u);
+    }
+  };
+
+  template <>
+  struct radix_traits<double>
+  {
+    typedef uint64_t bits_type;
+    static bits_type to_bits(double k)
+    {
+      bits_type b;
+      std::memcpy(&b, &k, sizeof(b));
+      return (b & 0x8000000000000000ull) ? ~b : (b | 0x8000000000000000ull);
+    }
+  };
+
+  // 按映射后的键比较，小区间插入排序用
+  template <class Traits, class KeyOf>
+  struct radix_key_less
+  {
+    KeyOf key;
+    explicit radix_key_less(KeyOf k) : key(k) {}
+    template <class T>
+    bool operator()(const T &a, const T &b) const { return Traits::to_bits(key(a)) < Traits::to_bits(key(b)); }
+  };
+
+  // 可平凡复制的元素：缓冲区只配置不构造，数据起初仍在原区间
+  template <class RandomIter, bool Trivial = std::is_trivially_copyable<
+                                  typename zfwstl::iterator_traits<RandomIter>::value_type>::value>
+  class radix_sort_buffer
+  {
+  public:
+    typedef typename zfwstl::iterator_traits<RandomIter>::value_type value_type;
+    static constexpr bool data_in_buffer = false;
+
+  private:
+    typedef zfwstl::simple_allocator<value_type> data_allocator;
+    value_type *buf;
+    size_t len;
+
+  public:
+    radix_sort_buffer(RandomIter, size_t n) : buf(data_allocator::allocate(n)), len(n) {}
+    ~radix_sort_buffer() { data_allocator::deallocate(buf, len); }
+    radix_sort_buffer(const radix_sort_buffer &) = delete;
+    radix_sort_buffer &operator=(const radix_sort_buffer &) = delete;
+
+    value_type *begin() const noexcept { return buf; }
+    value_type *end() const noexcept { return buf + len; }
+  };
+  // 其他元素：与 stable_sort 相同，先把元素移动构造到缓冲区
+  template <class RandomIter>
+  class radix_sort_buffer<RandomIter, false> : public stable_sort_buffer<RandomIter>
+  {
+  public:
+    static constexpr bool data_in_buffer = true;
+    radix_sort_buffer(RandomIter first, size_t n) : stable_sort_buffer<RandomIter>(first, n) {}
+  };
+
+  // 一趟分配：offset 为各桶在输出中的起点，分配后指向各桶的末尾
+  template <class Traits, class InputIter, class OutputIter, class KeyOf>
+  void radix_scatter(InputIter first, InputIter last, OutputIter result,
+                     size_t *offset, unsigned shift, KeyOf key)
+  {
+    for (; first != last; ++first)
+    {
+      const auto b = Traits::to_bits(key(*first));
+      *(result + offset[(b >> shift) & 0xFF]++) = zfwstl::move(*first);
+    }
+  }
+
+  // 数据在 first 开始的 n 个元素，other 为等长的另一段空间(都已可赋值)；只按 digits 列出的字节(从低到高)排序
+  // to_other 为 true 时结果放到 other，否则留在原处
+  // 元素多于 kRadixMsdThreshold 时先按最高的字节做一趟 MSD 分配，各桶再分别递归：
+  //   桶小到能放进 cache 后再做 LSD，避免每趟都在整个大数组上随机写
+  template <class Traits, class Iter1, class Iter2, class KeyOf>
+  void radix_sort_aux(Iter1 first, Iter2 other, size_t n, const unsigned *digits, size_t ndigit,
+                      bool to_other, KeyOf key)
+  {
+    typedef typename Traits::bits_type bits_type;
+    if (n <= kSmallSectionSize)
+    {
+      if (n > 1)
+        zfwstl::insertion_sort(first, first + n, radix_key_less<Traits, KeyOf>(key));
+      if (to_other)
+      {
+        for (size_t i = 0; i < n; ++i)
+          *(other + i) = zfwstl::move(*(first + i));
+      }
+      return;
+    }
+    // 一次扫描统计所有字节的直方图，所有元素该字节都相同的去掉
+    size_t count[sizeof(bits_type)][256] = {};
+    for (Iter1 it = first, last = first + n; it != last; ++it)
+    {
+      const bits_type b = Traits::to_bits(key(*it));
+      for (size_t i = 0; i < ndigit; ++i)
+        ++count[i][(b >> (digits[i] * 8)) & 0xFF];
+    }
+    unsigned passes[sizeof(bits_type)];
+    size_t pass_index[sizeof(bits_type)];
+    size_t npass = 0;
+    const bits_type b0 = Traits::to_bits(key(*first));
+    for (size_t i = 0; i < ndigit; ++i)
+    {
+      if (count[i][(b0 >> (digits[i] * 8)) & 0xFF] != n)
+      {
+        pass_index[npass] = i;
+        passes[npass++] = digits[i];
+      }
+    }
+    size_t offset[256];
+    if (n > kRadixMsdThreshold && npass > 1)
+    {
+      const size_t *top = count[pass_index[npass - 1]];
+      size_t sum = 0;
+      for (size_t i = 0; i < 256; ++i)
+      {
+        offset[i] = sum;
+        sum += top[i];
+      }
+      zfwstl::radix_scatter<Traits>(first, first + n, other, offset, passes[npass - 1] * 8, key);
+      // 分配后 offset[i] 指向第 i 个桶的末尾；数据在 other 一侧，结果要回到 first 一侧时子问题的 to_other 为 true
+      size_t begin = 0;
+      for (size_t i = 0; i < 256; ++i)
+      {
+        if (top[i] != 0)
+          zfwstl::radix_sort_aux<Traits>(other + begin, first + begin, top[i], passes, npass - 1, !to_other, key);
+        begin = offset[i];
+      }
+      return;
+    }
+    bool in_other = false;
+    for (size_t p = 0; p < npass; ++p)
+    {
+      const size_t *cnt = count[pass_index[p]];
+      size_t sum = 0;
+      for (size_t i = 0; i < 256; ++i)
+      {
+        offset[i] = sum;
+        sum += cnt[i];
+      }
+      if (in_other)
+        zfwstl::radix_scatter<Traits>(other, other + n, first, offset, passes[p] * 8, key);
+      else
+        zfwstl::radix_scatter<Traits>(first, first + n, other, offset, passes[p] * 8, key);
+      in_other = !in_other;
+    }
+    if (in_other != to_other)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (in_other)
+          *(first + i) = zfwstl::move(*(other + i));
+        else
+          *(other + i) = zfwstl::move(*(first + i));
+      }
+    }
+  }
+
+  // 键提取版本：key(元素) 返回整数或浮点数键
+  template <class RandomIter, class KeyOf>
+  void radix_sort(RandomIter first, RandomIter last, KeyOf key)
+  {
+    typedef typename std::decay<decltype(key(*first))>::type key_type;
+    typedef radix_traits<key_type> traits;
+    const size_t n = static_cast<size_t>(last - first);
+    if (n <= kSmallSectionSize)
+    {
+      zfwstl::insertion_sort(first, last, radix_key_less<traits, KeyOf>(key));
+      return;
+    }
+    unsigned digits[sizeof(typename traits::bits_type)];
+    for (unsigned i = 0; i < sizeof(digits) / sizeof(digits[0]); ++i)
+      digits[i] = i;
+    radix_sort_buffer<RandomIter> buf(first, n);
+    if (radix_sort_buffer<RandomIter>::data_in_buffer)
+      zfwstl::radix_sort_aux<traits>(buf.begin(), first, n, digits, sizeof(digits) / sizeof(digits[0]), true, key);
+    else
+      zfwstl::radix_sort_aux<traits>(first, buf.begin(), n, digits, sizeof(digits) / sizeof(digits[0]), false, key);
+  }
+
+  template <class RandomIter>
+  void radix_sort(RandomIter first, RandomIter last)
+  {
+    zfwstl::radix_sort(first, last, zfwstl::identity<typename zfwstl::iterator_traits<RandomIter>::value_type>());
+  }
 
   // ===========================swap_ranges===========================
   // 将[first1, last1)从 first2 开始，交换相同个数元素
@@ -2866,10 +3971,7 @@ namespace zfwstl
 
   template <class InputIter, class OutputIter>
   OutputIter
-  unchecked_move(InputIter first, InputIter last, OutputIter result)
-  {
-    return unchecked_move_cat(first, last, result, iterator_category(first));
-  }
+  unchecked_move(InputIter first, InputIter last, OutputIter result);
 
   // 为 trivially_copy_assignable 类型提供特化版本
   template <class Tp, class Up>
@@ -2885,6 +3987,68 @@ namespace zfwstl
     return result + n;
   }
 
+  // 分段迭代器(见 iterator.h)版本，同 unchecked_copy_seg
+  template <class SegIter, class OutputIter, class OutSeg>
+  OutputIter
+  unchecked_move_seg(SegIter first, SegIter last, OutputIter result, std::true_type, OutSeg)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (; !traits::same_segment(first, last); traits::next_segment(first))
+      result = zfwstl::unchecked_move(traits::local(first), traits::local_end(first), result);
+    return zfwstl::unchecked_move(traits::local(first), traits::local(last), result);
+  }
+
+  template <class RandomIter, class SegIter>
+  SegIter
+  unchecked_move_seg_out(RandomIter first, RandomIter last, SegIter result,
+                         zfwstl::random_access_iterator_tag)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (ptrdiff_t n = last - first; n > 0;)
+    {
+      const ptrdiff_t room = traits::local_end(result) - traits::local(result);
+      const ptrdiff_t len = n < room ? n : room;
+      auto p = zfwstl::unchecked_move(first, first + len, traits::local(result));
+      first += len;
+      n -= len;
+      if (p == traits::local_end(result))
+        traits::next_segment(result);
+      else
+        traits::set_local(result, p);
+    }
+    return result;
+  }
+
+  template <class InputIter, class SegIter>
+  SegIter
+  unchecked_move_seg_out(InputIter first, InputIter last, SegIter result,
+                         zfwstl::input_iterator_tag)
+  {
+    return unchecked_move_cat(first, last, result, iterator_category(first));
+  }
+
+  template <class InputIter, class SegIter>
+  SegIter
+  unchecked_move_seg(InputIter first, InputIter last, SegIter result, std::false_type, std::true_type)
+  {
+    return unchecked_move_seg_out(first, last, result, iterator_category(first));
+  }
+
+  template <class InputIter, class OutputIter>
+  OutputIter
+  unchecked_move_seg(InputIter first, InputIter last, OutputIter result, std::false_type, std::false_type)
+  {
+    return unchecked_move_cat(first, last, result, iterator_category(first));
+  }
+
+  template <class InputIter, class OutputIter>
+  OutputIter
+  unchecked_move(InputIter first, InputIter last, OutputIter result)
+  {
+    return unchecked_move_seg(first, last, result, is_segmented_iterator<InputIter>{},
+                              is_segmented_iterator<OutputIter>{});
+  }
+
   template <class InputIter, class OutputIter>
   OutputIter move(InputIter first, InputIter last, OutputIter result)
   {
@@ -2918,11 +4082,7 @@ namespace zfwstl
   template <class BidirectionalIter1, class BidirectionalIter2>
   BidirectionalIter2
   unchecked_move_backward(BidirectionalIter1 first, BidirectionalIter1 last,
-                          BidirectionalIter2 result)
-  {
-    return unchecked_move_backward_cat(first, last, result,
-                                       iterator_category(first));
-  }
+                          BidirectionalIter2 result);
 
   // 为 trivially_copy_assignable 类型提供特化版本
   template <class Tp, class Up>
@@ -2932,8 +4092,8 @@ namespace zfwstl
       Up *>::type
   unchecked_move_backward(Tp *first, Tp *last, Up *result)
   {
-    const size_t n = static_cast<size_t>(last - first);
-    if (n != 0)
+    const ptrdiff_t n = last - first;
+    if (n > 0)
     {
       result -= n;
       std::memmove(result, first, n * sizeof(Up));
@@ -2941,6 +4101,70 @@ namespace zfwstl
     return result;
   }
 
+  // 分段迭代器版本，同 unchecked_copy_backward_seg
+  template <class SegIter, class BidirectionalIter2, class OutSeg>
+  BidirectionalIter2
+  unchecked_move_backward_seg(SegIter first, SegIter last, BidirectionalIter2 result,
+                              std::true_type, OutSeg)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (; !traits::same_segment(first, last); traits::prev_segment(last))
+      result = zfwstl::unchecked_move_backward(traits::local_begin(last), traits::local(last), result);
+    return zfwstl::unchecked_move_backward(traits::local(first), traits::local(last), result);
+  }
+
+  template <class RandomIter, class SegIter>
+  SegIter
+  unchecked_move_backward_seg_out(RandomIter first, RandomIter last, SegIter result,
+                                  zfwstl::random_access_iterator_tag)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (ptrdiff_t n = last - first; n > 0;)
+    {
+      if (traits::local(result) == traits::local_begin(result))
+        traits::prev_segment(result);
+      const ptrdiff_t room = traits::local(result) - traits::local_begin(result);
+      const ptrdiff_t len = n < room ? n : room;
+      traits::set_local(result, zfwstl::unchecked_move_backward(last - len, last, traits::local(result)));
+      last -= len;
+      n -= len;
+    }
+    return result;
+  }
+
+  template <class BidirectionalIter1, class SegIter>
+  SegIter
+  unchecked_move_backward_seg_out(BidirectionalIter1 first, BidirectionalIter1 last, SegIter result,
+                                  zfwstl::bidirectional_iterator_tag)
+  {
+    return unchecked_move_backward_cat(first, last, result, iterator_category(first));
+  }
+
+  template <class BidirectionalIter1, class SegIter>
+  SegIter
+  unchecked_move_backward_seg(BidirectionalIter1 first, BidirectionalIter1 last, SegIter result,
+                              std::false_type, std::true_type)
+  {
+    return unchecked_move_backward_seg_out(first, last, result, iterator_category(first));
+  }
+
+  template <class BidirectionalIter1, class BidirectionalIter2>
+  BidirectionalIter2
+  unchecked_move_backward_seg(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result,
+                              std::false_type, std::false_type)
+  {
+    return unchecked_move_backward_cat(first, last, result, iterator_category(first));
+  }
+
+  template <class BidirectionalIter1, class BidirectionalIter2>
+  BidirectionalIter2
+  unchecked_move_backward(BidirectionalIter1 first, BidirectionalIter1 last,
+                          BidirectionalIter2 result)
+  {
+    return unchecked_move_backward_seg(first, last, result, is_segmented_iterator<BidirectionalIter1>{},
+                                       is_segmented_iterator<BidirectionalIter2>{});
+  }
+
   template <class BidirectionalIter1, class BidirectionalIter2>
   BidirectionalIter2
   move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result)
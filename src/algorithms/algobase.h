@@ -3,6 +3,7 @@
 #include <cstring>       //for memset(), memmove()
 #include "../util.h"     //for move(), swap(), pair
 #include "../iterator.h" //for value_type(), iterator_traits
+#include "simd_algo.h"   //for simd_mismatch(): 连续整数区间的 mismatch
 /**
  * 基本算法
  * copy 复制 -if in-place
@@ -16,6 +17,7 @@
  * max/min
  * mismatch 找出不匹配点
  * swap 交换(对调)
+ * copy / copy_backward / fill / fill_n 遇到分段迭代器(如 deque)时逐段处理，每段走指针版本
  */
 namespace zfwstl
 {
@@ -69,10 +71,7 @@ namespace zfwstl
 
   template <class InputIter, class OutputIter>
   OutputIter
-  unchecked_copy(InputIter first, InputIter last, OutputIter result)
-  {
-    return unchecked_copy_cat(first, last, result, iterator_category(first));
-  }
+  unchecked_copy(InputIter first, InputIter last, OutputIter result);
 
   // 为 trivially_copy_assignable 类型提供特化版本
   template <class Tp, class Up>
@@ -88,6 +87,69 @@ namespace zfwstl
     return result + n;
   }
 
+  // 分段迭代器(见 iterator.h)版本：输入区间逐段取出裸指针区间拷贝
+  template <class SegIter, class OutputIter, class OutSeg>
+  OutputIter
+  unchecked_copy_seg(SegIter first, SegIter last, OutputIter result, std::true_type, OutSeg)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (; !traits::same_segment(first, last); traits::next_segment(first))
+      result = zfwstl::unchecked_copy(traits::local(first), traits::local_end(first), result);
+    return zfwstl::unchecked_copy(traits::local(first), traits::local(last), result);
+  }
+
+  // 输出区间为分段迭代器：随机访问的输入按输出段的剩余空间分块拷贝
+  template <class RandomIter, class SegIter>
+  SegIter
+  unchecked_copy_seg_out(RandomIter first, RandomIter last, SegIter result,
+                         zfwstl::random_access_iterator_tag)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (ptrdiff_t n = last - first; n > 0;)
+    {
+      const ptrdiff_t room = traits::local_end(result) - traits::local(result);
+      const ptrdiff_t len = n < room ? n : room;
+      auto p = zfwstl::unchecked_copy(first, first + len, traits::local(result));
+      first += len;
+      n -= len;
+      if (p == traits::local_end(result)) // 写满本段，与 ++ 一样移到下一段开头
+        traits::next_segment(result);
+      else
+        traits::set_local(result, p);
+    }
+    return result;
+  }
+
+  template <class InputIter, class SegIter>
+  SegIter
+  unchecked_copy_seg_out(InputIter first, InputIter last, SegIter result,
+                         zfwstl::input_iterator_tag)
+  {
+    return unchecked_copy_cat(first, last, result, iterator_category(first));
+  }
+
+  template <class InputIter, class SegIter>
+  SegIter
+  unchecked_copy_seg(InputIter first, InputIter last, SegIter result, std::false_type, std::true_type)
+  {
+    return unchecked_copy_seg_out(first, last, result, iterator_category(first));
+  }
+
+  template <class InputIter, class OutputIter>
+  OutputIter
+  unchecked_copy_seg(InputIter first, InputIter last, OutputIter result, std::false_type, std::false_type)
+  {
+    return unchecked_copy_cat(first, last, result, iterator_category(first));
+  }
+
+  template <class InputIter, class OutputIter>
+  OutputIter
+  unchecked_copy(InputIter first, InputIter last, OutputIter result)
+  {
+    return unchecked_copy_seg(first, last, result, is_segmented_iterator<InputIter>{},
+                              is_segmented_iterator<OutputIter>{});
+  }
+
   template <class InputIter, class OutputIter>
   OutputIter copy(InputIter first, InputIter last, OutputIter result)
   {
@@ -124,11 +186,7 @@ namespace zfwstl
   template <class BidirectionalIter1, class BidirectionalIter2>
   BidirectionalIter2
   unchecked_copy_backward(BidirectionalIter1 first, BidirectionalIter1 last,
-                          BidirectionalIter2 result)
-  {
-    return unchecked_copy_backward_cat(first, last, result,
-                                       iterator_category(first));
-  }
+                          BidirectionalIter2 result);
 
   // TAG:为 trivially_copy_assignable 类型提供特化版本
   template <class Tp, class Up>
@@ -147,6 +205,71 @@ namespace zfwstl
     return result;
   }
 
+  // 分段迭代器版本：从最后一段往前逐段拷贝
+  template <class SegIter, class BidirectionalIter2, class OutSeg>
+  BidirectionalIter2
+  unchecked_copy_backward_seg(SegIter first, SegIter last, BidirectionalIter2 result,
+                              std::true_type, OutSeg)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (; !traits::same_segment(first, last); traits::prev_segment(last))
+      result = zfwstl::unchecked_copy_backward(traits::local_begin(last), traits::local(last), result);
+    return zfwstl::unchecked_copy_backward(traits::local(first), traits::local(last), result);
+  }
+
+  // 输出区间为分段迭代器：随机访问的输入按输出段已用的空间分块拷贝
+  template <class RandomIter, class SegIter>
+  SegIter
+  unchecked_copy_backward_seg_out(RandomIter first, RandomIter last, SegIter result,
+                                  zfwstl::random_access_iterator_tag)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (ptrdiff_t n = last - first; n > 0;)
+    {
+      if (traits::local(result) == traits::local_begin(result))
+        traits::prev_segment(result);
+      const ptrdiff_t room = traits::local(result) - traits::local_begin(result);
+      const ptrdiff_t len = n < room ? n : room;
+      traits::set_local(result, zfwstl::unchecked_copy_backward(last - len, last, traits::local(result)));
+      last -= len;
+      n -= len;
+    }
+    return result;
+  }
+
+  template <class BidirectionalIter1, class SegIter>
+  SegIter
+  unchecked_copy_backward_seg_out(BidirectionalIter1 first, BidirectionalIter1 last, SegIter result,
+                                  zfwstl::bidirectional_iterator_tag)
+  {
+    return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
+  }
+
+  template <class BidirectionalIter1, class SegIter>
+  SegIter
+  unchecked_copy_backward_seg(BidirectionalIter1 first, BidirectionalIter1 last, SegIter result,
+                              std::false_type, std::true_type)
+  {
+    return unchecked_copy_backward_seg_out(first, last, result, iterator_category(first));
+  }
+
+  template <class BidirectionalIter1, class BidirectionalIter2>
+  BidirectionalIter2
+  unchecked_copy_backward_seg(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result,
+                              std::false_type, std::false_type)
+  {
+    return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
+  }
+
+  template <class BidirectionalIter1, class BidirectionalIter2>
+  BidirectionalIter2
+  unchecked_copy_backward(BidirectionalIter1 first, BidirectionalIter1 last,
+                          BidirectionalIter2 result)
+  {
+    return unchecked_copy_backward_seg(first, last, result, is_segmented_iterator<BidirectionalIter1>{},
+                                       is_segmented_iterator<BidirectionalIter2>{});
+  }
+
   template <class BidirectionalIter1, class BidirectionalIter2>
   BidirectionalIter2
   copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result)
@@ -203,6 +326,28 @@ namespace zfwstl
     return true;
   }
 
+  // 为连续的整数区间提供特化版本：整数没有填充位，逐字节比较即可
+  template <class Tp, class Up>
+  typename std::enable_if<
+      std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+          zfwstl::simd_comparable<Tp>::value,
+      bool>::type
+  equal(Tp *first1, Tp *last1, Up *first2)
+  {
+    const auto n = static_cast<size_t>(last1 - first1);
+    return n == 0 || std::memcmp(first1, first2, n * sizeof(Tp)) == 0;
+  }
+
+  template <class Tp, class Up>
+  typename std::enable_if<
+      std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+          zfwstl::simd_comparable<Tp>::value,
+      bool>::type
+  equal(Tp *first1, Tp *last1, Up *first2, Up *last2)
+  {
+    return last1 - first1 == last2 - first2 && zfwstl::equal(first1, last1, first2);
+  }
+
   // ===========================fill_n===============================
   // 从 first 位置开始填充 n 个值
   /**
@@ -244,12 +389,37 @@ namespace zfwstl
     return first + n;
   }
 
+  // 分段迭代器版本：逐段填充，1 字节类型的段走 memset
+  template <class SegIter, class Size, class T>
+  SegIter unchecked_fill_n_seg(SegIter first, Size n, const T &value, std::true_type)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (ptrdiff_t left = static_cast<ptrdiff_t>(n); left > 0;)
+    {
+      const ptrdiff_t room = traits::local_end(first) - traits::local(first);
+      const ptrdiff_t len = left < room ? left : room;
+      auto p = zfwstl::unchecked_fill_n(traits::local(first), len, value);
+      left -= len;
+      if (p == traits::local_end(first))
+        traits::next_segment(first);
+      else
+        traits::set_local(first, p);
+    }
+    return first;
+  }
+
   template <class OutputIter, class Size, class T>
-  OutputIter fill_n(OutputIter first, Size n, const T &value)
+  OutputIter unchecked_fill_n_seg(OutputIter first, Size n, const T &value, std::false_type)
   {
     return unchecked_fill_n(first, n, value);
   }
 
+  template <class OutputIter, class Size, class T>
+  OutputIter fill_n(OutputIter first, Size n, const T &value)
+  {
+    return unchecked_fill_n_seg(first, n, value, is_segmented_iterator<OutputIter>{});
+  }
+
   // ===========================fill===========================
   // 为 [first, last)区间内的所有元素填充新值
   template <class ForwardIter, class T>
@@ -268,12 +438,28 @@ namespace zfwstl
     zfwstl::fill_n(first, n, value);
   }
 
+  // 分段迭代器版本：每段是连续内存，交给指针版本的 fill_n
+  template <class SegIter, class T>
+  void fill_seg(SegIter first, SegIter last, const T &value, std::true_type)
+  {
+    typedef segmented_iterator_traits<SegIter> traits;
+    for (; !traits::same_segment(first, last); traits::next_segment(first))
+      zfwstl::unchecked_fill_n(traits::local(first), traits::local_end(first) - traits::local(first), value);
+    zfwstl::unchecked_fill_n(traits::local(first), traits::local(last) - traits::local(first), value);
+  }
+
   template <class ForwardIter, class T>
-  void fill(ForwardIter first, ForwardIter last, const T &value)
+  void fill_seg(ForwardIter first, ForwardIter last, const T &value, std::false_type)
   {
     fill_cat(first, last, value, iterator_category(first));
   }
 
+  template <class ForwardIter, class T>
+  void fill(ForwardIter first, ForwardIter last, const T &value)
+  {
+    fill_seg(first, last, value, is_segmented_iterator<ForwardIter>{});
+  }
+
   // ===========================iter_swap===========================
   // 将两个迭代器所指对象对调
   // TinySTL的写法
@@ -367,6 +553,33 @@ namespace zfwstl
     return zfwstl::pair<InputIter1, InputIter2>(first1, first2);
   }
 
+  // 为连续的整数区间提供特化版本：用 SIMD 一次比较 16 / 32 字节(见 simd_algo.h)
+  template <class Tp, class Up>
+  typename std::enable_if<
+      std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+          zfwstl::simd_comparable<Tp>::value,
+      zfwstl::pair<Tp *, Up *>>::type
+  mismatch(Tp *first1, Tp *last1, Up *first2)
+  {
+    const auto i = zfwstl::simd_mismatch<typename std::remove_const<Tp>::type>(
+        first1, first2, static_cast<size_t>(last1 - first1));
+    return zfwstl::pair<Tp *, Up *>(first1 + i, first2 + i);
+  }
+
+  template <class Tp, class Up>
+  typename std::enable_if<
+      std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+          zfwstl::simd_comparable<Tp>::value,
+      zfwstl::pair<Tp *, Up *>>::type
+  mismatch(Tp *first1, Tp *last1, Up *first2, Up *last2)
+  {
+    const auto n1 = static_cast<size_t>(last1 - first1);
+    const auto n2 = static_cast<size_t>(last2 - first2);
+    const auto i = zfwstl::simd_mismatch<typename std::remove_const<Tp>::type>(
+        first1, first2, n1 < n2 ? n1 : n2);
+    return zfwstl::pair<Tp *, Up *>(first1 + i, first2 + i);
+  }
+
   // // ===========================swap===========================
   // template <class T>
   // inline void swap(T &a, T &b)
@@ -5,9 +5,12 @@
  * 不归属于STL容器组件，幕后英雄，扮演priority queue的助手；一种算法
  * 底层数据结构：使用array实现完全二叉树(complete binary tree)
  * heap 的四个算法: push_heap, pop_heap, sort_heap, make_heap
+ * d 叉堆版本: dary_push_heap, dary_pop_heap, dary_make_heap, dary_sort_heap, dary_is_heap，叉数 D 为模板参数
  */
-#include <cstddef>       //for size_t, ptrdiff_t
-#include "../iterator.h" //for distance_type
+#include <cstddef>         //for size_t, ptrdiff_t
+#include "../iterator.h"   //for distance_type, iterator_traits
+#include "../util.h"       //for move
+#include "../functional.h" //for less
 namespace zfwstl
 {
 
@@ -117,13 +120,13 @@ namespace zfwstl
   void adjust_heap(RandomIter first, RandomIter last, RandomIter result, T value, Distance *)
   {
     *result = *first;
-    __adjust_heap(first, static_cast<Distance>(0), Distance(last - first), value);
+    zfwstl::__adjust_heap(first, static_cast<Distance>(0), Distance(last - first), value);
   }
   template <class RandomIter, class T, class Distance, class Compared>
   void adjust_heap(RandomIter first, RandomIter last, RandomIter result, T value, Distance *, Compared comp)
   {
     *result = *first;
-    __adjust_heap(first, static_cast<Distance>(0), Distance(last - first), value, comp);
+    zfwstl::__adjust_heap(first, static_cast<Distance>(0), Distance(last - first), value, comp);
   }
 
   template <class RandomIter, class T, class Compared>
@@ -220,6 +223,143 @@ namespace zfwstl
     zfwstl::__make_heap(first, last, distance_type(first));
     ;
   }
+
+  // =====================================d-ary heap=================================
+  // d 叉堆：节点 i 的子节点为 d*i+1 ... d*i+d，父节点为 (i-1)/d；D 为 2 时与上面的二叉堆布局相同
+  // D 取 4 / 8 时树高降为二叉堆的 1/2、1/3，且同一节点的子节点连续存放，元素较小时一层只读一两条缓存行
+  // 下溯与 __adjust_heap 相同采用 bottom-up 方式：先沿最大的子节点一路下到叶子(每层 D-1 次比较，不与待放入的值比较)，
+  // 再把值从叶子上溯回去；pop 时放入的是尾部元素，通常很小，上溯一两步即停，每层比 top-down 方式少一次比较
+  template <size_t D, class RandomIter, class Distance, class T, class Compared>
+  void __dary_push_heap(RandomIter first, Distance holeIndex, Distance topIndex, T value, Compared comp)
+  {
+    while (holeIndex > topIndex)
+    {
+      const Distance parent = (holeIndex - 1) / static_cast<Distance>(D);
+      if (!comp(*(first + parent), value))
+        break;
+      *(first + holeIndex) = zfwstl::move(*(first + parent));
+      holeIndex = parent;
+    }
+    *(first + holeIndex) = zfwstl::move(value);
+  }
+
+  template <size_t D, class RandomIter, class Distance, class T, class Compared>
+  void __dary_adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value, Compared comp)
+  {
+    const Distance topIndex = holeIndex;
+    const Distance d = static_cast<Distance>(D);
+    Distance child = d * holeIndex + 1;
+    while (child + d <= len)
+    { // D 个子节点齐全，找出最大的一个
+      Distance best = child;
+      for (Distance k = child + 1; k < child + d; ++k)
+        if (comp(*(first + best), *(first + k)))
+          best = k;
+      *(first + holeIndex) = zfwstl::move(*(first + best));
+      holeIndex = best;
+      child = d * holeIndex + 1;
+    }
+    if (child < len)
+    { // 最后一个子节点不满的节点
+      Distance best = child;
+      for (Distance k = child + 1; k < len; ++k)
+        if (comp(*(first + best), *(first + k)))
+          best = k;
+      *(first + holeIndex) = zfwstl::move(*(first + best));
+      holeIndex = best;
+    }
+    zfwstl::__dary_push_heap<D>(first, holeIndex, topIndex, zfwstl::move(value), comp);
+  }
+
+  template <size_t D, class RandomIter, class Compared>
+  void dary_push_heap(RandomIter first, RandomIter last, Compared comp)
+  { // 新元素应该已置于底部容器的最尾端
+    static_assert(D >= 2, "heap arity should be at least 2");
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    typedef typename iterator_traits<RandomIter>::value_type T;
+    if (last - first < 2)
+      return;
+    T value = zfwstl::move(*(last - 1));
+    zfwstl::__dary_push_heap<D>(first, Distance(last - first) - 1, static_cast<Distance>(0), zfwstl::move(value), comp);
+  }
+  template <size_t D, class RandomIter>
+  void dary_push_heap(RandomIter first, RandomIter last)
+  {
+    zfwstl::dary_push_heap<D>(first, last, zfwstl::less<void>());
+  }
+
+  // 把根节点移到尾部，重整 [first, last-1)
+  template <size_t D, class RandomIter, class Compared>
+  void dary_pop_heap(RandomIter first, RandomIter last, Compared comp)
+  {
+    static_assert(D >= 2, "heap arity should be at least 2");
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    typedef typename iterator_traits<RandomIter>::value_type T;
+    if (last - first < 2)
+      return;
+    --last;
+    T value = zfwstl::move(*last);
+    *last = zfwstl::move(*first);
+    zfwstl::__dary_adjust_heap<D>(first, static_cast<Distance>(0), Distance(last - first), zfwstl::move(value), comp);
+  }
+  template <size_t D, class RandomIter>
+  void dary_pop_heap(RandomIter first, RandomIter last)
+  {
+    zfwstl::dary_pop_heap<D>(first, last, zfwstl::less<void>());
+  }
+
+  // 从最后一个非叶子节点开始逐个下溯(Floyd 建堆)
+  template <size_t D, class RandomIter, class Compared>
+  void dary_make_heap(RandomIter first, RandomIter last, Compared comp)
+  {
+    static_assert(D >= 2, "heap arity should be at least 2");
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    typedef typename iterator_traits<RandomIter>::value_type T;
+    const Distance len = last - first;
+    if (len < 2)
+      return;
+    for (Distance holeIndex = (len - 2) / static_cast<Distance>(D);; --holeIndex)
+    {
+      T value = zfwstl::move(*(first + holeIndex));
+      zfwstl::__dary_adjust_heap<D>(first, holeIndex, len, zfwstl::move(value), comp);
+      if (holeIndex == 0)
+        return;
+    }
+  }
+  template <size_t D, class RandomIter>
+  void dary_make_heap(RandomIter first, RandomIter last)
+  {
+    zfwstl::dary_make_heap<D>(first, last, zfwstl::less<void>());
+  }
+
+  template <size_t D, class RandomIter, class Compared>
+  void dary_sort_heap(RandomIter first, RandomIter last, Compared comp)
+  {
+    while (last - first > 1)
+      zfwstl::dary_pop_heap<D>(first, last--, comp);
+  }
+  template <size_t D, class RandomIter>
+  void dary_sort_heap(RandomIter first, RandomIter last)
+  {
+    zfwstl::dary_sort_heap<D>(first, last, zfwstl::less<void>());
+  }
+
+  // 检查 [first, last) 是否为 D 叉堆
+  template <size_t D, class RandomIter, class Compared>
+  bool dary_is_heap(RandomIter first, RandomIter last, Compared comp)
+  {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    const Distance len = last - first;
+    for (Distance i = 1; i < len; ++i)
+      if (comp(*(first + (i - 1) / static_cast<Distance>(D)), *(first + i)))
+        return false;
+    return true;
+  }
+  template <size_t D, class RandomIter>
+  bool dary_is_heap(RandomIter first, RandomIter last)
+  {
+    return zfwstl::dary_is_heap<D>(first, last, zfwstl::less<void>());
+  }
 }
 
 #endif // !ZFWSTL_HEAP_H_
\ No newline at end of file
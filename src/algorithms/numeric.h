@@ -3,6 +3,7 @@
 #include "algobase.h"      // for min()
 #include "../functional.h" //for multiplies, identity_element
 #include <string>          //for memcmp
+#include <type_traits>     // for is_arithmetic, is_floating_point
 /**
  * 数值算法
  * accumulate 元素累计
@@ -12,6 +13,10 @@
  * lexicographical_compare 以字典顺序进行比较
  * partial_sum 局部求和 -if in-place
  * power * 幂次方，表达式可指定
+ * reduce 归约，不保证计算顺序(运算需满足结合律与交换律)，可向量化、并行(parallel_algo.h)
+ * transform_reduce 先变换再归约，缺省为内积
+ * inclusive_scan / exclusive_scan 前缀和(包含 / 不包含当前元素)
+ * kahan_reduce 浮点数的补偿求和，精度远高于 accumulate / reduce
  */
 namespace zfwstl
 { // ===========================accumulate===========================
@@ -241,6 +246,457 @@ namespace zfwstl
       return result;
     }
   }
+
+  // ===========================reduce===========================
+  /**
+   * reduce 与 accumulate 相同，但不保证从左到右计算，binary_op 必须满足结合律与交换律
+   * 随机访问迭代器的计算顺序是固定的(与是否并行、线程数、指令集都无关)，因此浮点数的结果可以重现：
+   *   1. 区间按 kReduceBlock 个元素分块，最后一块可以不满
+   *   2. 块内(算术类型)用 L = reduce_lanes 路独立累加：第 i 路依次累加第 i, i + L, i + 2L ... 个元素，
+   *      再把各路两两合并(第 i 路与第 i + L/2 路 ...)，最后依次加上不足 L 个的尾部；不足 2L 个的块直接从左到右累加
+   *   3. 各块的结果按二分树合并：[lo, hi) 的结果 = op([lo, mid) 的结果, [mid, hi) 的结果)，mid = lo + (hi - lo) / 2
+   *   4. 结果为 op(init, 上一步的结果)
+   * 多路累加打破了循环依赖，编译器可以向量化；float / double 的求和与内积直接用 simd_algo.h 的 SIMD 版本，
+   * 各指令集结果逐位相同(前提是编译时不把乘加合并成 FMA，例如 -ffp-contract=fast 的 transform_reduce 可能与标量版本不同)
+   * 每一路只累加 kReduceBlock / L 个元素，块之间又是二分合并，舍入误差远小于从左到右累加；需要更高精度时用 kahan_reduce
+   * 非随机访问迭代器按从左到右的顺序计算
+   */
+  constexpr static size_t kReduceBlock = 1 << 14;
+
+  // 各路两两合并，再依次加上尾部 [k, n)
+  template <class T, class Get, class BinaryOp>
+  T reduce_lanes_finish(T *acc, size_t k, size_t n, Get &get, BinaryOp &op)
+  {
+    for (size_t w = reduce_lanes<T>::value / 2; w != 0; w /= 2)
+    {
+      for (size_t i = 0; i < w; ++i)
+        acc[i] = op(acc[i], acc[i + w]);
+    }
+    T result = acc[0];
+    for (; k < n; ++k)
+      result = op(result, get(k));
+    return result;
+  }
+
+  // 一块的归约，get(i) 为块内第 i 个元素(已转换为 T)，n >= 1
+  template <class T, class Get, class BinaryOp>
+  T reduce_lanes_block(size_t n, Get get, BinaryOp op, std::false_type)
+  {
+    T result = get(0);
+    for (size_t i = 1; i < n; ++i)
+      result = op(result, get(i));
+    return result;
+  }
+  template <class T, class Get, class BinaryOp>
+  T reduce_lanes_block(size_t n, Get get, BinaryOp op, std::true_type)
+  {
+    const size_t lanes = reduce_lanes<T>::value;
+    if (n < 2 * lanes)
+      return zfwstl::reduce_lanes_block<T>(n, get, op, std::false_type());
+    T acc[reduce_lanes<T>::value];
+    for (size_t i = 0; i < lanes; ++i)
+      acc[i] = get(i);
+    size_t k = lanes;
+    for (; k + lanes <= n; k += lanes)
+    {
+      for (size_t i = 0; i < lanes; ++i)
+        acc[i] = op(acc[i], get(k + i));
+    }
+    return zfwstl::reduce_lanes_finish(acc, k, n, get, op);
+  }
+
+  // reduce 的一块：[first, first + n)
+  template <class T, class RandomIter, class BinaryOp>
+  T reduce_block(RandomIter first, size_t n, BinaryOp op)
+  {
+    return zfwstl::reduce_lanes_block<T>(
+        n, [first](size_t i) -> T
+        { return *(first + i); },
+        op, std::is_arithmetic<T>());
+  }
+  // float / double 求和：与上面的多路累加完全相同，只是由 SIMD 完成
+  template <class T, class Tp>
+  typename std::enable_if<std::is_floating_point<T>::value &&
+                              std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+                              (sizeof(T) == 4 || sizeof(T) == 8),
+                          T>::type
+  reduce_block(Tp *first, size_t n, zfwstl::plus<T> op)
+  {
+    const size_t lanes = reduce_lanes<T>::value;
+    auto get = [first](size_t i) -> T
+    { return first[i]; };
+    if (n < 2 * lanes)
+      return zfwstl::reduce_lanes_block<T>(n, get, op, std::false_type());
+    T acc[reduce_lanes<T>::value];
+    const size_t m = n - n % lanes;
+    zfwstl::simd_sum_lanes<T>(first, m, acc);
+    return zfwstl::reduce_lanes_finish(acc, m, n, get, op);
+  }
+
+  // 第 [lo, hi) 块的结果按二分树合并，block(offset, count) 求出从 offset 开始 count 个元素的一块
+  template <class T, class Block, class BinaryOp>
+  T reduce_tree(size_t n, size_t lo, size_t hi, Block &block, BinaryOp &op)
+  {
+    if (hi - lo == 1)
+    {
+      const size_t offset = lo * kReduceBlock;
+      return block(offset, zfwstl::min(kReduceBlock, n - offset));
+    }
+    const size_t mid = lo + (hi - lo) / 2;
+    T left = zfwstl::reduce_tree<T>(n, lo, mid, block, op);
+    return op(left, zfwstl::reduce_tree<T>(n, mid, hi, block, op));
+  }
+
+  template <class T, class Block, class BinaryOp>
+  T reduce_blocks(size_t n, T init, Block block, BinaryOp op)
+  {
+    if (n == 0)
+      return init;
+    const size_t nblocks = (n + kReduceBlock - 1) / kReduceBlock;
+    return op(init, zfwstl::reduce_tree<T>(n, 0, nblocks, block, op));
+  }
+
+  template <class InputIter, class T, class BinaryOp>
+  T reduce_dispatch(InputIter first, InputIter last, T init, BinaryOp binary_op, input_iterator_tag)
+  {
+    for (; first != last; ++first)
+      init = binary_op(init, *first);
+    return init;
+  }
+  template <class RandomIter, class T, class BinaryOp>
+  T reduce_dispatch(RandomIter first, RandomIter last, T init, BinaryOp binary_op, random_access_iterator_tag)
+  {
+    return zfwstl::reduce_blocks(static_cast<size_t>(last - first), init,
+                                 [first, &binary_op](size_t offset, size_t count)
+                                 { return zfwstl::reduce_block<T>(first + offset, count, binary_op); },
+                                 binary_op);
+  }
+
+  // 版本1：以 init 为初值，用 binary_op 归约
+  template <class InputIter, class T, class BinaryOp>
+  T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op)
+  {
+    return zfwstl::reduce_dispatch(first, last, init, binary_op, iterator_category(first));
+  }
+
+  // 版本2：以 init 为初值求和
+  template <class InputIter, class T>
+  T reduce(InputIter first, InputIter last, T init)
+  {
+    return zfwstl::reduce(first, last, init, zfwstl::plus<T>());
+  }
+
+  // 版本3：以值初始化的 value_type 为初值求和
+  template <class InputIter>
+  typename iterator_traits<InputIter>::value_type reduce(InputIter first, InputIter last)
+  {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return zfwstl::reduce(first, last, value_type(), zfwstl::plus<value_type>());
+  }
+
+  // ===========================transform_reduce===========================
+  // 与 reduce 的计算顺序相同，只是每个元素先经过变换；二元版本缺省为内积(与 inner_product 相同，但不保证计算顺序)
+
+  // 二元版本的一块：[first1, first1 + n) 与 [first2, first2 + n)
+  template <class T, class RandomIter1, class RandomIter2, class BinaryOp1, class BinaryOp2>
+  T transform_reduce_block(RandomIter1 first1, RandomIter2 first2, size_t n,
+                           BinaryOp1 reduce_op, BinaryOp2 transform_op)
+  {
+    return zfwstl::reduce_lanes_block<T>(
+        n, [first1, first2, &transform_op](size_t i) -> T
+        { return transform_op(*(first1 + i), *(first2 + i)); },
+        reduce_op, std::is_arithmetic<T>());
+  }
+  // float / double 内积：SIMD
+  template <class T, class Tp, class Up>
+  typename std::enable_if<std::is_floating_point<T>::value &&
+                              std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+                              std::is_same<typename std::remove_const<Up>::type, T>::value &&
+                              (sizeof(T) == 4 || sizeof(T) == 8),
+                          T>::type
+  transform_reduce_block(Tp *first1, Up *first2, size_t n,
+                         zfwstl::plus<T> reduce_op, zfwstl::multiplies<T> transform_op)
+  {
+    const size_t lanes = reduce_lanes<T>::value;
+    auto get = [first1, first2, &transform_op](size_t i) -> T
+    { return transform_op(first1[i], first2[i]); };
+    if (n < 2 * lanes)
+      return zfwstl::reduce_lanes_block<T>(n, get, reduce_op, std::false_type());
+    T acc[reduce_lanes<T>::value];
+    const size_t m = n - n % lanes;
+    zfwstl::simd_dot_lanes<T>(first1, first2, m, acc);
+    return zfwstl::reduce_lanes_finish(acc, m, n, get, reduce_op);
+  }
+
+  template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+  T transform_reduce_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                              BinaryOp1 reduce_op, BinaryOp2 transform_op,
+                              input_iterator_tag, input_iterator_tag)
+  {
+    for (; first1 != last1; ++first1, ++first2)
+      init = reduce_op(init, transform_op(*first1, *first2));
+    return init;
+  }
+  template <class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2>
+  T transform_reduce_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                              BinaryOp1 reduce_op, BinaryOp2 transform_op,
+                              random_access_iterator_tag, random_access_iterator_tag)
+  {
+    return zfwstl::reduce_blocks(static_cast<size_t>(last1 - first1), init,
+                                 [first1, first2, &reduce_op, &transform_op](size_t offset, size_t count)
+                                 { return zfwstl::transform_reduce_block<T>(first1 + offset, first2 + offset, count,
+                                                                           reduce_op, transform_op); },
+                                 reduce_op);
+  }
+  template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2, class Tag1, class Tag2>
+  T transform_reduce_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                              BinaryOp1 reduce_op, BinaryOp2 transform_op, Tag1, Tag2)
+  {
+    return zfwstl::transform_reduce_dispatch(first1, last1, first2, init, reduce_op, transform_op,
+                                             input_iterator_tag(), input_iterator_tag());
+  }
+
+  // 一元版本
+  template <class InputIter, class T, class BinaryOp, class UnaryOp>
+  T transform_reduce_dispatch(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp transform_op,
+                    input_iterator_tag)
+  {
+    for (; first != last; ++first)
+      init = reduce_op(init, transform_op(*first));
+    return init;
+  }
+  template <class RandomIter, class T, class BinaryOp, class UnaryOp>
+  T transform_reduce_dispatch(RandomIter first, RandomIter last, T init, BinaryOp reduce_op, UnaryOp transform_op,
+                    random_access_iterator_tag)
+  {
+    return zfwstl::reduce_blocks(static_cast<size_t>(last - first), init,
+                                 [first, &reduce_op, &transform_op](size_t offset, size_t count)
+                                 { return zfwstl::reduce_lanes_block<T>(
+                                       count, [first, offset, &transform_op](size_t i) -> T
+                                       { return transform_op(*(first + offset + i)); },
+                                       reduce_op, std::is_arithmetic<T>()); },
+                                 reduce_op);
+  }
+
+  // 版本1：以 init 为初值，reduce_op 归约 transform_op(*first1, *first2)
+  template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+  T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                     BinaryOp1 reduce_op, BinaryOp2 transform_op)
+  {
+    return zfwstl::transform_reduce_dispatch(first1, last1, first2, init, reduce_op, transform_op,
+                                             iterator_category(first1), iterator_category(first2));
+  }
+
+  // 版本2：以 init 为初值的内积
+  template <class InputIter1, class InputIter2, class T>
+  T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+  {
+    return zfwstl::transform_reduce(first1, last1, first2, init, zfwstl::plus<T>(), zfwstl::multiplies<T>());
+  }
+
+  // 版本3：一元变换，以 init 为初值，reduce_op 归约 transform_op(*first)
+  template <class InputIter, class T, class BinaryOp, class UnaryOp>
+  T transform_reduce(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp transform_op)
+  {
+    return zfwstl::transform_reduce_dispatch(first, last, init, reduce_op, transform_op, iterator_category(first));
+  }
+
+  // ===========================inclusive_scan===========================
+  // 与 partial_sum 相同(第 i 个输出为前 i + 1 个元素的归约)，但 binary_op 须满足结合律，并行版本会改变计算顺序
+  // 可以原地计算(result == first)
+
+  // 版本1：以 init 为初值
+  template <class InputIter, class OutputIter, class BinaryOp, class T>
+  OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op, T init)
+  {
+    for (; first != last; ++first, ++result)
+    {
+      init = binary_op(init, *first);
+      *result = init;
+    }
+    return result;
+  }
+
+  // 版本2：自定义二元操作
+  template <class InputIter, class OutputIter, class BinaryOp>
+  OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op)
+  {
+    if (first == last)
+      return result;
+    typename iterator_traits<InputIter>::value_type value = *first;
+    *result = value;
+    return zfwstl::inclusive_scan(++first, last, ++result, binary_op, value);
+  }
+
+  // 版本3：求和
+  template <class InputIter, class OutputIter>
+  OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result)
+  {
+    return zfwstl::inclusive_scan(first, last, result,
+                                  zfwstl::plus<typename iterator_traits<InputIter>::value_type>());
+  }
+
+  // ===========================exclusive_scan===========================
+  // 第 i 个输出为 init 与前 i 个元素(不含第 i 个)的归约；可以原地计算(result == first)
+
+  // 版本1：自定义二元操作
+  template <class InputIter, class OutputIter, class T, class BinaryOp>
+  OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init, BinaryOp binary_op)
+  {
+    for (; first != last; ++first, ++result)
+    {
+      T value = binary_op(init, *first); // 先读出当前元素，原地计算时 *result 就是 *first
+      *result = init;
+      init = zfwstl::move(value);
+    }
+    return result;
+  }
+
+  // 版本2：求和
+  template <class InputIter, class OutputIter, class T>
+  OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init)
+  {
+    return zfwstl::exclusive_scan(first, last, result, init, zfwstl::plus<T>());
+  }
+
+  // ===========================kahan_reduce===========================
+  /**
+   * 浮点数的补偿求和(Kahan summation)：用 comp 记下每次加法的舍入误差，在下一次加法中补回去
+   * 计算顺序与 reduce 相同：块内 reduce_lanes 路各自做 Kahan 求和，各路、各块之间用 TwoSum 合并
+   * (TwoSum 求出两数相加的精确舍入误差)，因此结果同样与是否并行、指令集无关；误差不超过 (2·eps + O(n·eps²))·Σ|x|，
+   * 与元素个数基本无关(reduce / accumulate 的误差随 n 增长)，典型的场景是大量小数加到很大的部分和上；代价是比 reduce 慢
+   * 编译时不能打开 -ffast-math(会把补偿项化简掉)
+   * 非随机访问迭代器从左到右做 Kahan 求和
+   */
+  template <class T>
+  struct kahan_sum
+  {
+    T sum;
+    T comp; // 真实值约为 sum - comp
+  };
+
+  // 把 x 加到 (sum, comp) 上
+  template <class T>
+  inline void kahan_add(kahan_sum<T> &k, T x)
+  {
+    const T y = x - k.comp;
+    const T t = k.sum + y;
+    k.comp = (t - k.sum) - y;
+    k.sum = t;
+  }
+
+  // 两个补偿和相加：a.sum + b.sum == s + e 精确成立(TwoSum)
+  template <class T>
+  struct kahan_plus
+  {
+    kahan_sum<T> operator()(const kahan_sum<T> &a, const kahan_sum<T> &b) const
+    {
+      const T s = a.sum + b.sum;
+      const T bv = s - a.sum;
+      const T e = (a.sum - (s - bv)) + (b.sum - bv);
+      return kahan_sum<T>{s, (a.comp + b.comp) - e};
+    }
+  };
+
+  // 各路两两合并，再依次加上尾部 [k, n)
+  template <class T, class Get>
+  kahan_sum<T> kahan_lanes_finish(kahan_sum<T> *acc, size_t k, size_t n, Get &get)
+  {
+    kahan_plus<T> op;
+    for (size_t w = reduce_lanes<T>::value / 2; w != 0; w /= 2)
+    {
+      for (size_t i = 0; i < w; ++i)
+        acc[i] = op(acc[i], acc[i + w]);
+    }
+    kahan_sum<T> result = acc[0];
+    for (; k < n; ++k)
+      zfwstl::kahan_add(result, get(k));
+    return result;
+  }
+
+  // kahan_reduce 的一块：[first, first + n)，n >= 1
+  template <class T, class RandomIter>
+  kahan_sum<T> kahan_block(RandomIter first, size_t n)
+  {
+    const size_t lanes = reduce_lanes<T>::value;
+    auto get = [first](size_t i) -> T
+    { return *(first + i); };
+    kahan_sum<T> acc[reduce_lanes<T>::value];
+    size_t k = 0;
+    if (n >= 2 * lanes)
+    {
+      for (size_t i = 0; i < lanes; ++i)
+        acc[i] = kahan_sum<T>{get(i), T(0)};
+      for (k = lanes; k + lanes <= n; k += lanes)
+      {
+        for (size_t i = 0; i < lanes; ++i)
+          zfwstl::kahan_add(acc[i], get(k + i));
+      }
+      return zfwstl::kahan_lanes_finish(acc, k, n, get);
+    }
+    kahan_sum<T> result{get(0), T(0)};
+    for (k = 1; k < n; ++k)
+      zfwstl::kahan_add(result, get(k));
+    return result;
+  }
+  // float / double 指针：SIMD
+  template <class T, class Tp>
+  typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+                              (sizeof(T) == 4 || sizeof(T) == 8),
+                          kahan_sum<T>>::type
+  kahan_block(Tp *first, size_t n)
+  {
+    const size_t lanes = reduce_lanes<T>::value;
+    auto get = [first](size_t i) -> T
+    { return first[i]; };
+    if (n < 2 * lanes)
+    {
+      kahan_sum<T> result{get(0), T(0)};
+      for (size_t k = 1; k < n; ++k)
+        zfwstl::kahan_add(result, get(k));
+      return result;
+    }
+    T sum[reduce_lanes<T>::value], comp[reduce_lanes<T>::value];
+    const size_t m = n - n % lanes;
+    zfwstl::simd_kahan_lanes<T>(first, m, sum, comp);
+    kahan_sum<T> acc[reduce_lanes<T>::value];
+    for (size_t i = 0; i < lanes; ++i)
+      acc[i] = kahan_sum<T>{sum[i], comp[i]};
+    return zfwstl::kahan_lanes_finish(acc, m, n, get);
+  }
+
+  template <class InputIter, class T>
+  kahan_sum<T> kahan_reduce_dispatch(InputIter first, InputIter last, kahan_sum<T> init, input_iterator_tag)
+  {
+    for (; first != last; ++first)
+      zfwstl::kahan_add(init, static_cast<T>(*first));
+    return init;
+  }
+  template <class RandomIter, class T>
+  kahan_sum<T> kahan_reduce_dispatch(RandomIter first, RandomIter last, kahan_sum<T> init, random_access_iterator_tag)
+  {
+    return zfwstl::reduce_blocks(static_cast<size_t>(last - first), init,
+                                 [first](size_t offset, size_t count)
+                                 { return zfwstl::kahan_block<T>(first + offset, count); },
+                                 kahan_plus<T>());
+  }
+
+  // 版本1：以 init 为初值，T 为浮点类型
+  template <class InputIter, class T>
+  typename std::enable_if<std::is_floating_point<T>::value, T>::type
+  kahan_reduce(InputIter first, InputIter last, T init)
+  {
+    const kahan_sum<T> k = zfwstl::kahan_reduce_dispatch(first, last, kahan_sum<T>{init, T(0)},
+                                                         iterator_category(first));
+    return k.sum - k.comp;
+  }
+
+  // 版本2：以 0 为初值，结果类型为 value_type
+  template <class InputIter>
+  typename iterator_traits<InputIter>::value_type kahan_reduce(InputIter first, InputIter last)
+  {
+    return zfwstl::kahan_reduce(first, last, typename iterator_traits<InputIter>::value_type(0));
+  }
 }
 
 #endif // !ZFWSTL_NUMERIC_H_
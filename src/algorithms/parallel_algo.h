@@ -0,0 +1,589 @@
+#ifndef ZFWSTL_PARALLEL_ALGO_H_
+#define ZFWSTL_PARALLEL_ALGO_H_
+/**
+ * 带执行策略的算法重载(见 execution.h)，第一个参数为 execution::seq / par / par_unseq
+ * seq 直接调用 algo.h 中的顺序版本；par / par_unseq 在 work_stealing_pool 上 fork-join 执行
+ * 没有放进 algorithm.h：只有用到并行算法的代码才需要 <thread> 并链接线程库(-pthread)
+ *
+ * sort       : 并行内省式排序；每次分割后把右段作为新任务提交，左段继续在本线程分割，
+ *              小于 kParallelSortGrain 的区段用顺序 sort，分割恶化时同样改用 heap sort；不需要额外内存
+ * stable_sort: 并行归并排序；两半并行排序后再并行归并，需要 n 个元素的缓冲区(同顺序版本)
+ * merge      : 并行归并；取较长一段的中间元素，在另一段二分找到切分点，两半并行归并，保持稳定
+ * 这三个算法的并行版本要求随机访问迭代器(merge 的输出也是)，否则退回顺序版本
+ *
+ * reduce / transform_reduce / kahan_reduce: 各块(kReduceBlock 个元素)并行归约，再按与顺序版本相同的二分树合并，
+ *              结果与顺序版本逐位相同，与线程数无关
+ * inclusive_scan / exclusive_scan: 三趟：各块并行求和；顺序求出各块的初值；各块并行从初值开始扫描
+ *              计算顺序与顺序版本不同，浮点数的舍入可能不同，但对同一输入结果是确定的(与线程数无关)
+ * 以上算法要求随机访问迭代器(扫描的输出也是)，否则退回顺序版本
+ */
+#include <cstddef>  // for size_t
+#include "../execution.h"
+#include "../iterator.h" // for iterator_traits, random_access_iterator_tag
+#include "../functional.h" // for less
+#include "algo.h"   // for sort, intro_sort, stable_sort_aux, merge, lower_bound, upper_bound
+#include "numeric.h" // for reduce_blocks, reduce_tree, kahan_block, inclusive_scan, exclusive_scan
+namespace zfwstl
+{
+  constexpr static size_t kParallelSortGrain = 1 << 14;  // 并行 sort 的最小任务
+  constexpr static size_t kParallelMergeGrain = 1 << 14; // 并行 merge / stable_sort 的最小任务
+
+  // 取策略指定的任务池
+  inline work_stealing_pool &policy_pool(const execution::parallel_policy &policy)
+  {
+    return policy.pool ? *policy.pool : work_stealing_pool::default_pool();
+  }
+  inline work_stealing_pool &policy_pool(const execution::parallel_unsequenced_policy &policy)
+  {
+    return policy.pool ? *policy.pool : work_stealing_pool::default_pool();
+  }
+  // 顺序策略没有任务池
+  inline work_stealing_pool *policy_pool_ptr(const execution::sequenced_policy &)
+  {
+    return nullptr;
+  }
+  template <class ExecutionPolicy>
+  inline work_stealing_pool *policy_pool_ptr(const ExecutionPolicy &policy)
+  {
+    return &zfwstl::policy_pool(policy);
+  }
+
+  // ===========================sort===========================
+  template <class RandomIter, class Size, class Compared>
+  void parallel_intro_sort(RandomIter first, RandomIter last, Size depth_limit,
+                           Compared comp, task_group &group)
+  {
+    while (static_cast<size_t>(last - first) > kParallelSortGrain)
+    {
+      if (depth_limit == 0)
+      {
+        zfwstl::partial_sort(first, last, last, comp); // 改用 heap_sort
+        return;
+      }
+      --depth_limit;
+      auto mid = zfwstl::median(*(first), *(first + (last - first) / 2), *(last - 1), comp);
+      auto cut = zfwstl::unchecked_partition(first, last, mid, comp);
+      group.run([=, &group]
+                { zfwstl::parallel_intro_sort(cut, last, depth_limit, comp, group); });
+      last = cut;
+    }
+    zfwstl::sort(first, last, comp);
+  }
+
+  template <class RandomIter, class Compared>
+  void parallel_sort(work_stealing_pool &pool, RandomIter first, RandomIter last, Compared comp)
+  {
+    if (static_cast<size_t>(last - first) <= kParallelSortGrain || pool.concurrency() == 1)
+    {
+      zfwstl::sort(first, last, comp);
+      return;
+    }
+    task_group group(pool);
+    zfwstl::parallel_intro_sort(first, last, slg2(last - first) * 2, comp, group);
+    group.wait();
+  }
+
+  template <class RandomIter, class Compared>
+  void sort(const execution::sequenced_policy &, RandomIter first, RandomIter last, Compared comp)
+  {
+    zfwstl::sort(first, last, comp);
+  }
+  template <class RandomIter, class Compared>
+  void sort(const execution::parallel_policy &policy, RandomIter first, RandomIter last, Compared comp)
+  {
+    zfwstl::parallel_sort(zfwstl::policy_pool(policy), first, last, comp);
+  }
+  template <class RandomIter, class Compared>
+  void sort(const execution::parallel_unsequenced_policy &policy, RandomIter first, RandomIter last, Compared comp)
+  {
+    zfwstl::parallel_sort(zfwstl::policy_pool(policy), first, last, comp);
+  }
+  template <class ExecutionPolicy, class RandomIter,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  void sort(const ExecutionPolicy &policy, RandomIter first, RandomIter last)
+  {
+    zfwstl::sort(policy, first, last, zfwstl::less<typename zfwstl::iterator_traits<RandomIter>::value_type>());
+  }
+
+  // ===========================merge===========================
+  // 把 [first1, last1) 与 [first2, last2) 归并到 result；Merger 为叶子上的顺序归并(拷贝或搬移)
+  template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared, class Merger>
+  void parallel_merge_aux(RandomIter1 first1, RandomIter1 last1,
+                          RandomIter2 first2, RandomIter2 last2,
+                          RandomIter3 result, Compared comp, Merger merger, work_stealing_pool &pool)
+  {
+    const size_t len1 = static_cast<size_t>(last1 - first1);
+    const size_t len2 = static_cast<size_t>(last2 - first2);
+    if (len1 + len2 <= kParallelMergeGrain)
+    {
+      merger(first1, last1, first2, last2, result, comp);
+      return;
+    }
+    // 切分点左边的元素都不大于右边的元素；相等元素中第一段的排在前面
+    RandomIter1 cut1;
+    RandomIter2 cut2;
+    if (len1 >= len2)
+    {
+      cut1 = first1 + len1 / 2;
+      cut2 = zfwstl::lower_bound(first2, last2, *cut1, comp);
+    }
+    else
+    {
+      cut2 = first2 + len2 / 2;
+      cut1 = zfwstl::upper_bound(first1, last1, *cut2, comp);
+    }
+    RandomIter3 result2 = result + ((cut1 - first1) + (cut2 - first2));
+    task_group group(pool);
+    group.run([=, &pool]
+              { zfwstl::parallel_merge_aux(cut1, last1, cut2, last2, result2, comp, merger, pool); });
+    zfwstl::parallel_merge_aux(first1, cut1, first2, cut2, result, comp, merger, pool);
+    group.wait();
+  }
+
+  struct copy_merger
+  {
+    template <class I1, class I2, class O, class C>
+    void operator()(I1 f1, I1 l1, I2 f2, I2 l2, O out, C comp) const { zfwstl::merge(f1, l1, f2, l2, out, comp); }
+  };
+  struct move_merger
+  {
+    template <class I1, class I2, class O, class C>
+    void operator()(I1 f1, I1 l1, I2 f2, I2 l2, O out, C comp) const { zfwstl::move_merge(f1, l1, f2, l2, out, comp); }
+  };
+
+  template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+  OutputIter parallel_merge_dispatch(work_stealing_pool &pool,
+                                     InputIter1 first1, InputIter1 last1,
+                                     InputIter2 first2, InputIter2 last2,
+                                     OutputIter result, Compared comp,
+                                     random_access_iterator_tag, random_access_iterator_tag, random_access_iterator_tag)
+  {
+    zfwstl::parallel_merge_aux(first1, last1, first2, last2, result, comp, copy_merger(), pool);
+    return result + ((last1 - first1) + (last2 - first2));
+  }
+  template <class InputIter1, class InputIter2, class OutputIter, class Compared, class Tag1, class Tag2, class Tag3>
+  OutputIter parallel_merge_dispatch(work_stealing_pool &,
+                                     InputIter1 first1, InputIter1 last1,
+                                     InputIter2 first2, InputIter2 last2,
+                                     OutputIter result, Compared comp, Tag1, Tag2, Tag3)
+  {
+    return zfwstl::merge(first1, last1, first2, last2, result, comp);
+  }
+
+  template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+  OutputIter merge(const execution::sequenced_policy &,
+                   InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                   OutputIter result, Compared comp)
+  {
+    return zfwstl::merge(first1, last1, first2, last2, result, comp);
+  }
+  template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter, class Compared,
+            typename std::enable_if<std::is_same<ExecutionPolicy, execution::parallel_policy>::value ||
+                                        std::is_same<ExecutionPolicy, execution::parallel_unsequenced_policy>::value,
+                                    int>::type = 0>
+  OutputIter merge(const ExecutionPolicy &policy,
+                   InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                   OutputIter result, Compared comp)
+  {
+    return zfwstl::parallel_merge_dispatch(zfwstl::policy_pool(policy), first1, last1, first2, last2, result, comp,
+                                           iterator_category(first1), iterator_category(first2),
+                                           iterator_category(result));
+  }
+  template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  OutputIter merge(const ExecutionPolicy &policy,
+                   InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                   OutputIter result)
+  {
+    return zfwstl::merge(policy, first1, last1, first2, last2, result,
+                         zfwstl::less<typename zfwstl::iterator_traits<InputIter1>::value_type>());
+  }
+
+  // ===========================stable_sort===========================
+  // 与 stable_sort_aux 相同的来回归并，只是两半并行排序、归并也并行
+  template <class Iter1, class Iter2, class Compared>
+  void parallel_stable_sort_aux(Iter1 first, Iter1 last, Iter2 other, bool to_other,
+                                Compared comp, work_stealing_pool &pool)
+  {
+    const size_t len = static_cast<size_t>(last - first);
+    if (len <= kParallelMergeGrain)
+    {
+      zfwstl::stable_sort_aux(first, last, other, to_other, comp);
+      return;
+    }
+    const size_t half = len / 2;
+    {
+      task_group group(pool);
+      group.run([=, &pool]
+                { zfwstl::parallel_stable_sort_aux(first + half, last, other + half, !to_other, comp, pool); });
+      zfwstl::parallel_stable_sort_aux(first, first + half, other, !to_other, comp, pool);
+      group.wait();
+    }
+    if (to_other)
+      zfwstl::parallel_merge_aux(first, first + half, first + half, last, other, comp, move_merger(), pool);
+    else
+      zfwstl::parallel_merge_aux(other, other + half, other + half, other + len, first, comp, move_merger(), pool);
+  }
+
+  template <class RandomIter, class Compared>
+  void parallel_stable_sort(work_stealing_pool &pool, RandomIter first, RandomIter last, Compared comp)
+  {
+    if (static_cast<size_t>(last - first) <= kParallelMergeGrain || pool.concurrency() == 1)
+    {
+      zfwstl::stable_sort(first, last, comp);
+      return;
+    }
+    stable_sort_buffer<RandomIter> buf(first, static_cast<size_t>(last - first));
+    zfwstl::parallel_stable_sort_aux(buf.begin(), buf.end(), first, true, comp, pool);
+  }
+
+  template <class RandomIter, class Compared>
+  void stable_sort(const execution::sequenced_policy &, RandomIter first, RandomIter last, Compared comp)
+  {
+    zfwstl::stable_sort(first, last, comp);
+  }
+  template <class RandomIter, class Compared>
+  void stable_sort(const execution::parallel_policy &policy, RandomIter first, RandomIter last, Compared comp)
+  {
+    zfwstl::parallel_stable_sort(zfwstl::policy_pool(policy), first, last, comp);
+  }
+  template <class RandomIter, class Compared>
+  void stable_sort(const execution::parallel_unsequenced_policy &policy, RandomIter first, RandomIter last, Compared comp)
+  {
+    zfwstl::parallel_stable_sort(zfwstl::policy_pool(policy), first, last, comp);
+  }
+  template <class ExecutionPolicy, class RandomIter,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  void stable_sort(const ExecutionPolicy &policy, RandomIter first, RandomIter last)
+  {
+    zfwstl::stable_sort(policy, first, last, zfwstl::less<typename zfwstl::iterator_traits<RandomIter>::value_type>());
+  }
+
+  // ===========================reduce===========================
+  // 各块的结果：n 个 T 的缓冲区，只析构已构造的元素
+  template <class T>
+  class block_results
+  {
+    typedef zfwstl::simple_allocator<T> data_allocator;
+    typedef zfwstl::simple_allocator<bool> flag_allocator;
+    T *buf;
+    bool *built;
+    size_t len;
+
+  public:
+    explicit block_results(size_t n) : buf(data_allocator::allocate(n)), built(nullptr), len(n)
+    {
+      try
+      {
+        built = flag_allocator::allocate(n);
+      }
+      catch (...)
+      {
+        data_allocator::deallocate(buf, n);
+        throw;
+      }
+      for (size_t i = 0; i < n; ++i)
+        built[i] = false;
+    }
+    ~block_results()
+    {
+      for (size_t i = 0; i < len; ++i)
+      {
+        if (built[i])
+          zfwstl::destroy(buf + i);
+      }
+      flag_allocator::deallocate(built, len);
+      data_allocator::deallocate(buf, len);
+    }
+    block_results(const block_results &) = delete;
+    block_results &operator=(const block_results &) = delete;
+
+    template <class U>
+    void set(size_t i, U &&value)
+    {
+      zfwstl::construct(buf + i, zfwstl::forward<U>(value));
+      built[i] = true;
+    }
+    T &operator[](size_t i) const noexcept { return buf[i]; }
+  };
+
+  // 把 nblocks 块分成若干任务并行执行 f(第几块)
+  template <class F>
+  void parallel_for_blocks(work_stealing_pool &pool, size_t nblocks, F f)
+  {
+    const size_t ntasks = zfwstl::min(nblocks, pool.concurrency() * 4);
+    task_group group(pool);
+    for (size_t t = 0; t < ntasks; ++t)
+    {
+      const size_t lo = nblocks * t / ntasks, hi = nblocks * (t + 1) / ntasks;
+      group.run([lo, hi, &f]
+                {
+                  for (size_t j = lo; j < hi; ++j)
+                    f(j); });
+    }
+    group.wait();
+  }
+
+  // 与 reduce_blocks 相同的分块与合并顺序，只是各块并行计算
+  template <class T, class Block, class BinaryOp>
+  T parallel_reduce_blocks(work_stealing_pool *pool, size_t n, T init, Block block, BinaryOp op)
+  {
+    const size_t nblocks = (n + kReduceBlock - 1) / kReduceBlock;
+    if (pool == nullptr || nblocks <= 1 || pool->concurrency() == 1)
+      return zfwstl::reduce_blocks(n, init, block, op);
+    block_results<T> results(nblocks);
+    zfwstl::parallel_for_blocks(*pool, nblocks, [&](size_t j)
+                                {
+                                  const size_t offset = j * kReduceBlock;
+                                  results.set(j, block(offset, zfwstl::min(kReduceBlock, n - offset))); });
+    auto leaf = [&results](size_t offset, size_t) -> T
+    { return results[offset / kReduceBlock]; };
+    return op(init, zfwstl::reduce_tree<T>(n, 0, nblocks, leaf, op));
+  }
+
+  template <class RandomIter, class T, class BinaryOp>
+  T parallel_reduce_dispatch(work_stealing_pool *pool, RandomIter first, RandomIter last, T init,
+                             BinaryOp binary_op, random_access_iterator_tag)
+  {
+    return zfwstl::parallel_reduce_blocks(pool, static_cast<size_t>(last - first), init,
+                                          [first, &binary_op](size_t offset, size_t count)
+                                          { return zfwstl::reduce_block<T>(first + offset, count, binary_op); },
+                                          binary_op);
+  }
+  template <class InputIter, class T, class BinaryOp, class Tag>
+  T parallel_reduce_dispatch(work_stealing_pool *, InputIter first, InputIter last, T init,
+                             BinaryOp binary_op, Tag)
+  {
+    return zfwstl::reduce(first, last, init, binary_op);
+  }
+
+  template <class ExecutionPolicy, class InputIter, class T, class BinaryOp,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  T reduce(const ExecutionPolicy &policy, InputIter first, InputIter last, T init, BinaryOp binary_op)
+  {
+    return zfwstl::parallel_reduce_dispatch(zfwstl::policy_pool_ptr(policy), first, last, init, binary_op,
+                                            iterator_category(first));
+  }
+  template <class ExecutionPolicy, class InputIter, class T,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  T reduce(const ExecutionPolicy &policy, InputIter first, InputIter last, T init)
+  {
+    return zfwstl::reduce(policy, first, last, init, zfwstl::plus<T>());
+  }
+  template <class ExecutionPolicy, class InputIter,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  typename iterator_traits<InputIter>::value_type reduce(const ExecutionPolicy &policy, InputIter first, InputIter last)
+  {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return zfwstl::reduce(policy, first, last, value_type(), zfwstl::plus<value_type>());
+  }
+
+  // ===========================transform_reduce===========================
+  template <class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2>
+  T parallel_transform_reduce_dispatch(work_stealing_pool *pool, RandomIter1 first1, RandomIter1 last1,
+                                       RandomIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op,
+                                       random_access_iterator_tag, random_access_iterator_tag)
+  {
+    return zfwstl::parallel_reduce_blocks(pool, static_cast<size_t>(last1 - first1), init,
+                                          [first1, first2, &reduce_op, &transform_op](size_t offset, size_t count)
+                                          { return zfwstl::transform_reduce_block<T>(first1 + offset, first2 + offset,
+                                                                                    count, reduce_op, transform_op); },
+                                          reduce_op);
+  }
+  template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2, class Tag1, class Tag2>
+  T parallel_transform_reduce_dispatch(work_stealing_pool *, InputIter1 first1, InputIter1 last1,
+                                       InputIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op,
+                                       Tag1, Tag2)
+  {
+    return zfwstl::transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+  }
+
+  template <class RandomIter, class T, class BinaryOp, class UnaryOp>
+  T parallel_transform_reduce_dispatch(work_stealing_pool *pool, RandomIter first, RandomIter last, T init,
+                                       BinaryOp reduce_op, UnaryOp transform_op, random_access_iterator_tag)
+  {
+    return zfwstl::parallel_reduce_blocks(pool, static_cast<size_t>(last - first), init,
+                                          [first, &reduce_op, &transform_op](size_t offset, size_t count)
+                                          { return zfwstl::reduce_lanes_block<T>(
+                                                count, [first, offset, &transform_op](size_t i) -> T
+                                                { return transform_op(*(first + offset + i)); },
+                                                reduce_op, std::is_arithmetic<T>()); },
+                                          reduce_op);
+  }
+  template <class InputIter, class T, class BinaryOp, class UnaryOp, class Tag>
+  T parallel_transform_reduce_dispatch(work_stealing_pool *, InputIter first, InputIter last, T init,
+                                       BinaryOp reduce_op, UnaryOp transform_op, Tag)
+  {
+    return zfwstl::transform_reduce(first, last, init, reduce_op, transform_op);
+  }
+
+  template <class ExecutionPolicy, class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  T transform_reduce(const ExecutionPolicy &policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                     BinaryOp1 reduce_op, BinaryOp2 transform_op)
+  {
+    return zfwstl::parallel_transform_reduce_dispatch(zfwstl::policy_pool_ptr(policy), first1, last1, first2, init,
+                                                      reduce_op, transform_op,
+                                                      iterator_category(first1), iterator_category(first2));
+  }
+  template <class ExecutionPolicy, class InputIter1, class InputIter2, class T,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  T transform_reduce(const ExecutionPolicy &policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+  {
+    return zfwstl::transform_reduce(policy, first1, last1, first2, init, zfwstl::plus<T>(), zfwstl::multiplies<T>());
+  }
+  template <class ExecutionPolicy, class InputIter, class T, class BinaryOp, class UnaryOp,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  T transform_reduce(const ExecutionPolicy &policy, InputIter first, InputIter last, T init,
+                     BinaryOp reduce_op, UnaryOp transform_op)
+  {
+    return zfwstl::parallel_transform_reduce_dispatch(zfwstl::policy_pool_ptr(policy), first, last, init,
+                                                      reduce_op, transform_op, iterator_category(first));
+  }
+
+  // ===========================kahan_reduce===========================
+  template <class RandomIter, class T>
+  T parallel_kahan_reduce_dispatch(work_stealing_pool *pool, RandomIter first, RandomIter last, T init,
+                                   random_access_iterator_tag)
+  {
+    const kahan_sum<T> k = zfwstl::parallel_reduce_blocks(pool, static_cast<size_t>(last - first),
+                                                          kahan_sum<T>{init, T(0)},
+                                                          [first](size_t offset, size_t count)
+                                                          { return zfwstl::kahan_block<T>(first + offset, count); },
+                                                          kahan_plus<T>());
+    return k.sum - k.comp;
+  }
+  template <class InputIter, class T, class Tag>
+  T parallel_kahan_reduce_dispatch(work_stealing_pool *, InputIter first, InputIter last, T init, Tag)
+  {
+    return zfwstl::kahan_reduce(first, last, init);
+  }
+
+  template <class ExecutionPolicy, class InputIter, class T,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value &&
+                                        std::is_floating_point<T>::value,
+                                    int>::type = 0>
+  T kahan_reduce(const ExecutionPolicy &policy, InputIter first, InputIter last, T init)
+  {
+    return zfwstl::parallel_kahan_reduce_dispatch(zfwstl::policy_pool_ptr(policy), first, last, init,
+                                                  iterator_category(first));
+  }
+  template <class ExecutionPolicy, class InputIter,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  typename iterator_traits<InputIter>::value_type kahan_reduce(const ExecutionPolicy &policy,
+                                                               InputIter first, InputIter last)
+  {
+    return zfwstl::kahan_reduce(policy, first, last, typename iterator_traits<InputIter>::value_type(0));
+  }
+
+  // ===========================inclusive_scan / exclusive_scan===========================
+  /**
+   * 三趟并行扫描，n 个元素分为 kReduceBlock 大小的块：
+   *   1. 各块并行求出块内的归约 sums[j](从左到右)
+   *   2. 顺序求出各块的初值 offsets[j] = op(offsets[j - 1], sums[j - 1])，第 0 块为 init(没有 init 的 inclusive_scan 第 0 块不带初值)
+   *   3. 各块并行以 offsets[j] 为初值做顺序扫描
+   * 第 1 趟读完全部输入后才开始写输出，所以可以原地计算(result == first)
+   */
+  template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+  void parallel_scan(work_stealing_pool &pool, RandomIter1 first, size_t n, RandomIter2 result,
+                     const T *init, BinaryOp &binary_op, bool inclusive)
+  {
+    const size_t nblocks = (n + kReduceBlock - 1) / kReduceBlock;
+    block_results<T> sums(nblocks), offsets(nblocks);
+    zfwstl::parallel_for_blocks(pool, nblocks - 1, [&](size_t j)
+                                {
+                                  RandomIter1 block = first + j * kReduceBlock;
+                                  T value = *block;
+                                  for (size_t i = 1; i < kReduceBlock; ++i)
+                                    value = binary_op(value, *(block + i));
+                                  sums.set(j, zfwstl::move(value)); });
+    if (init)
+      offsets.set(0, *init);
+    for (size_t j = 1; j < nblocks; ++j)
+    {
+      if (j == 1 && !init)
+        offsets.set(1, sums[0]);
+      else
+        offsets.set(j, binary_op(offsets[j - 1], sums[j - 1]));
+    }
+    zfwstl::parallel_for_blocks(pool, nblocks, [&](size_t j)
+                                {
+                                  const size_t offset = j * kReduceBlock;
+                                  const size_t count = zfwstl::min(kReduceBlock, n - offset);
+                                  RandomIter1 block = first + offset;
+                                  if (!inclusive)
+                                    zfwstl::exclusive_scan(block, block + count, result + offset, offsets[j], binary_op);
+                                  else if (j == 0 && !init)
+                                    zfwstl::inclusive_scan(block, block + count, result + offset, binary_op);
+                                  else
+                                    zfwstl::inclusive_scan(block, block + count, result + offset, binary_op, offsets[j]); });
+  }
+
+  template <class InputIter, class OutputIter, class T, class BinaryOp, class Tag1, class Tag2>
+  OutputIter parallel_scan_dispatch(work_stealing_pool *, InputIter first, InputIter last,
+                                    OutputIter result, const T *init, BinaryOp binary_op, bool inclusive,
+                                    Tag1, Tag2)
+  {
+    if (!inclusive)
+      return zfwstl::exclusive_scan(first, last, result, *init, binary_op);
+    if (init)
+      return zfwstl::inclusive_scan(first, last, result, binary_op, *init);
+    return zfwstl::inclusive_scan(first, last, result, binary_op);
+  }
+
+  template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+  RandomIter2 parallel_scan_dispatch(work_stealing_pool *pool, RandomIter1 first, RandomIter1 last,
+                                     RandomIter2 result, const T *init, BinaryOp binary_op, bool inclusive,
+                                     random_access_iterator_tag, random_access_iterator_tag)
+  {
+    const size_t n = static_cast<size_t>(last - first);
+    if (pool == nullptr || n <= kReduceBlock || pool->concurrency() == 1)
+      return zfwstl::parallel_scan_dispatch(pool, first, last, result, init, binary_op, inclusive,
+                                            input_iterator_tag(), input_iterator_tag());
+    zfwstl::parallel_scan(*pool, first, n, result, init, binary_op, inclusive);
+    return result + n;
+  }
+  template <class ExecutionPolicy, class InputIter, class OutputIter, class BinaryOp, class T,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  OutputIter inclusive_scan(const ExecutionPolicy &policy, InputIter first, InputIter last, OutputIter result,
+                            BinaryOp binary_op, T init)
+  {
+    return zfwstl::parallel_scan_dispatch(zfwstl::policy_pool_ptr(policy), first, last, result, &init, binary_op,
+                                          true, iterator_category(first), iterator_category(result));
+  }
+  template <class ExecutionPolicy, class InputIter, class OutputIter, class BinaryOp,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  OutputIter inclusive_scan(const ExecutionPolicy &policy, InputIter first, InputIter last, OutputIter result,
+                            BinaryOp binary_op)
+  {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return zfwstl::parallel_scan_dispatch(zfwstl::policy_pool_ptr(policy), first, last, result,
+                                          static_cast<const value_type *>(nullptr), binary_op,
+                                          true, iterator_category(first), iterator_category(result));
+  }
+  template <class ExecutionPolicy, class InputIter, class OutputIter,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  OutputIter inclusive_scan(const ExecutionPolicy &policy, InputIter first, InputIter last, OutputIter result)
+  {
+    return zfwstl::inclusive_scan(policy, first, last, result,
+                                  zfwstl::plus<typename iterator_traits<InputIter>::value_type>());
+  }
+
+  template <class ExecutionPolicy, class InputIter, class OutputIter, class T, class BinaryOp,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  OutputIter exclusive_scan(const ExecutionPolicy &policy, InputIter first, InputIter last, OutputIter result,
+                            T init, BinaryOp binary_op)
+  {
+    return zfwstl::parallel_scan_dispatch(zfwstl::policy_pool_ptr(policy), first, last, result, &init, binary_op,
+                                          false, iterator_category(first), iterator_category(result));
+  }
+  template <class ExecutionPolicy, class InputIter, class OutputIter, class T,
+            typename std::enable_if<zfwstl::is_execution_policy<ExecutionPolicy>::value, int>::type = 0>
+  OutputIter exclusive_scan(const ExecutionPolicy &policy, InputIter first, InputIter last, OutputIter result,
+                            T init)
+  {
+    return zfwstl::exclusive_scan(policy, first, last, result, init, zfwstl::plus<T>());
+  }
+}
+
+#endif // !ZFWSTL_PARALLEL_ALGO_H_
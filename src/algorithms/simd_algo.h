@@ -0,0 +1,1050 @@
+#ifndef ZFWSTL_SIMD_ALGO_H_
+#define ZFWSTL_SIMD_ALGO_H_
+/**
+ * find / count / min_element / max_element / mismatch 在连续整数区间上的 SIMD 版本
+ * algobase.h、algo.h 中这几个算法对指针 Tp* (vector 的迭代器也是指针)且 Tp 为 1/2/4/8 字节整数时调用这里
+ * 浮点数不走这里：NaN 与 -0.0 的 == 语义与按位比较不同
+ *
+ * 指令集在运行时检测(simd_level)，同一份二进制在不同机器上选用不同的实现：
+ *   simd_isa_avx2  : 每次 32 字节(GCC / Clang 的 x86，用 target 属性单独编译这几个函数，不需要 -mavx2)
+ *   simd_isa_sse2  : 每次 16 字节(x86-64 都有)；SSE2 没有 64 位比较大小，8 字节的 min / max 用标量版本
+ *   simd_isa_scalar: 逐个比较
+ * find / mismatch 把比较结果用 movemask 压成"每字节一位"的掩码，元素下标 = 位下标 / sizeof(T)
+ * count 用与元素同宽的计数器逐向量累加(相等时比较结果为 -1，减去即加一)，计数器将要溢出前汇总一次
+ * min / max 先用向量求出极值(无符号数先翻转符号位，统一用有符号比较)，再用 find 找到第一个等于极值的位置
+ *
+ * 另有 float / double 的多路求和、点积、Kahan 求和(numeric.h 的 reduce、transform_reduce、kahan_reduce 使用)：
+ * 第 i 路依次累加第 i, i + L, i + 2L ... 个元素(L = reduce_lanes)，各指令集只是每条指令处理的路数不同，
+ * 每一路的运算顺序完全一样，所以标量、SSE2、AVX2 的结果逐位相同(不使用 FMA，乘加分两步舍入)
+ *
+ * 字节串的子串查找(algo.h 的 search / find_end / simd_searcher 使用)：模式长 m，每次取 W 个连续的起点，
+ * 同时比较起点处的字节与模式首字节、起点 + m - 1 处的字节与模式末字节，两者都相等的起点才用 memcmp 比较中间部分；
+ * 首末字节同时相等的概率很低，绝大部分数据只经过两次向量比较。rsearch 从后往前，找最后一次出现
+ */
+#include <cstddef> // for size_t
+#include <cstdint> // for int8_t ... int64_t, uint32_t
+#include <cstring> // for memchr, memcmp
+#include <limits>  // for numeric_limits
+#include <type_traits>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> // SSE2
+#define ZFWSTL_SIMD_SSE2 1
+#endif
+#if defined(ZFWSTL_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // AVX2
+#define ZFWSTL_SIMD_AVX2 1
+#define ZFWSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace zfwstl
+{
+  enum simd_isa
+  {
+    simd_isa_scalar,
+    simd_isa_sse2,
+    simd_isa_avx2
+  };
+
+  // 检测当前 CPU 支持(且编译进来了)的最高指令集；定义 ZFWSTL_NO_SIMD 时总是标量
+  inline simd_isa simd_detect()
+  {
+#if defined(ZFWSTL_NO_SIMD)
+    return simd_isa_scalar;
+#else
+#if defined(ZFWSTL_SIMD_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      return simd_isa_avx2;
+#endif
+#if defined(ZFWSTL_SIMD_SSE2)
+    return simd_isa_sse2;
+#else
+    return simd_isa_scalar;
+#endif
+#endif
+  }
+
+  inline simd_isa &simd_level_ref()
+  {
+    static simd_isa level = simd_detect();
+    return level;
+  }
+
+  // 当前使用的指令集
+  inline simd_isa simd_level() { return simd_level_ref(); }
+
+  // 限制使用的指令集(测试、对比性能用)；不会超过 simd_detect() 的结果
+  inline void simd_set_level(simd_isa isa)
+  {
+    const simd_isa best = simd_detect();
+    simd_level_ref() = isa < best ? isa : best;
+  }
+
+  // 可以走 SIMD 版本的元素类型：1/2/4/8 字节的整数(bool 除外)
+  template <class T>
+  struct simd_comparable
+      : std::integral_constant<bool, std::is_integral<typename std::remove_cv<T>::type>::value &&
+                                         !std::is_same<typename std::remove_cv<T>::type, bool>::value &&
+                                         (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>
+  {
+  };
+
+  // 可以用 simd_search 查找的字节串：文本与模式为同一种 1 字节整数(忽略 const)
+  template <class Tp, class Up>
+  struct simd_byte_search
+      : std::integral_constant<bool, simd_comparable<Tp>::value && sizeof(Tp) == 1 &&
+                                         std::is_same<typename std::remove_cv<Tp>::type,
+                                                      typename std::remove_cv<Up>::type>::value>
+  {
+  };
+
+  // 同样大小的有符号整数，用于 set1 与有符号比较
+  template <size_t Size>
+  struct simd_int;
+  template <>
+  struct simd_int<1> { typedef int8_t type; };
+  template <>
+  struct simd_int<2> { typedef int16_t type; };
+  template <>
+  struct simd_int<4> { typedef int32_t type; };
+  template <>
+  struct simd_int<8> { typedef int64_t type; };
+
+  // 最低位 1 的位置(mask != 0)
+  inline unsigned simd_ctz(uint32_t mask)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned n = 0;
+    while (!(mask & 1u))
+    {
+      mask >>= 1;
+      ++n;
+    }
+    return n;
+#endif
+  }
+
+  // count 中每个计数器(与元素同宽)最多累加的次数，超过前把计数器加到总数上
+  template <class T>
+  size_t simd_count_block()
+  {
+    return sizeof(T) == 1 ? 0xFF : sizeof(T) == 2 ? 0xFFFF : size_t(1) << 30;
+  }
+
+  // 有符号数的偏置为 0；无符号数翻转符号位后按有符号比较，大小顺序不变
+  template <class T>
+  typename simd_int<sizeof(T)>::type simd_sign_bias()
+  {
+    typedef typename simd_int<sizeof(T)>::type int_type;
+    return std::is_signed<T>::value ? int_type(0) : static_cast<int_type>(std::numeric_limits<int_type>::min());
+  }
+
+  // 最高位 1 的位置(mask != 0)
+  inline unsigned simd_msb(uint32_t mask)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31u - static_cast<unsigned>(__builtin_clz(mask));
+#else
+    unsigned n = 31;
+    while (!(mask & 0x80000000u))
+    {
+      mask <<= 1;
+      --n;
+    }
+    return n;
+#endif
+  }
+
+  // ===========================标量版本===========================
+  template <class T>
+  const T *scalar_find(const T *first, const T *last, T value)
+  {
+    while (first != last && *first != value)
+      ++first;
+    return first;
+  }
+
+  template <class T>
+  size_t scalar_count(const T *first, const T *last, T value)
+  {
+    size_t n = 0;
+    for (; first != last; ++first)
+      n += *first == value;
+    return n;
+  }
+
+  template <class T>
+  size_t scalar_mismatch(const T *first1, const T *first2, size_t n, size_t i = 0)
+  {
+    while (i != n && first1[i] == first2[i])
+      ++i;
+    return i;
+  }
+
+  // 返回 [first, last) 中的最大(Max)或最小值，last - first > 0
+  template <bool Max, class T>
+  T scalar_extreme(const T *first, const T *last)
+  {
+    T best = *first;
+    for (++first; first != last; ++first)
+    {
+      if (Max ? best < *first : *first < best)
+        best = *first;
+    }
+    return best;
+  }
+
+  // 返回第一个最大(Max)或最小的元素，last - first > 0
+  template <bool Max, class T>
+  const T *scalar_extreme_element(const T *first, const T *last)
+  {
+    const T *result = first;
+    while (++first != last)
+    {
+      if (Max ? *result < *first : *first < *result)
+        result = first;
+    }
+    return result;
+  }
+
+  // reduce 每块内独立累加的路数：两个 256 位向量
+  template <class T>
+  struct reduce_lanes : std::integral_constant<size_t, (sizeof(T) >= 8 ? 8 : 16)>
+  {
+  };
+
+  // 以下三个函数 n 为 L 的倍数且 n >= L：lanes[i] = p[i] + p[i + L] + p[i + 2L] + ...(按这个顺序)
+  template <class T>
+  void scalar_sum_lanes(const T *p, size_t n, T *lanes)
+  {
+    const size_t lanes_n = reduce_lanes<T>::value;
+    for (size_t i = 0; i < lanes_n; ++i)
+      lanes[i] = p[i];
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      for (size_t i = 0; i < lanes_n; ++i)
+        lanes[i] += p[k + i];
+    }
+  }
+
+  // lanes[i] = a[i] * b[i] + a[i + L] * b[i + L] + ...
+  template <class T>
+  void scalar_dot_lanes(const T *a, const T *b, size_t n, T *lanes)
+  {
+    const size_t lanes_n = reduce_lanes<T>::value;
+    for (size_t i = 0; i < lanes_n; ++i)
+      lanes[i] = a[i] * b[i];
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      for (size_t i = 0; i < lanes_n; ++i)
+      {
+        const T prod = a[k + i] * b[k + i];
+        lanes[i] += prod;
+      }
+    }
+  }
+
+  // 每一路做 Kahan 求和，真实值约为 sum[i] - comp[i]
+  template <class T>
+  void scalar_kahan_lanes(const T *p, size_t n, T *sum, T *comp)
+  {
+    const size_t lanes_n = reduce_lanes<T>::value;
+    for (size_t i = 0; i < lanes_n; ++i)
+    {
+      sum[i] = p[i];
+      comp[i] = T(0);
+    }
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      for (size_t i = 0; i < lanes_n; ++i)
+      {
+        const T y = p[k + i] - comp[i];
+        const T t = sum[i] + y;
+        comp[i] = (t - sum[i]) - y;
+        sum[i] = t;
+      }
+    }
+  }
+
+  // 以下子串查找函数：模式 [p, p + m)，m >= 2，只检查 [0, npos) 中的起点(npos = 文本长度 - m + 1)
+  // 返回第一个(rsearch 为最后一个)匹配的起点，找不到返回 npos
+  inline size_t scalar_search_bytes(const unsigned char *s, size_t npos, const unsigned char *p, size_t m)
+  {
+    for (size_t i = 0; i < npos; ++i)
+    {
+      const void *hit = std::memchr(s + i, p[0], npos - i);
+      if (hit == nullptr)
+        return npos;
+      i = static_cast<size_t>(static_cast<const unsigned char *>(hit) - s);
+      if (s[i + m - 1] == p[m - 1] && std::memcmp(s + i + 1, p + 1, m - 2) == 0)
+        return i;
+    }
+    return npos;
+  }
+
+  inline size_t scalar_rsearch_bytes(const unsigned char *s, size_t npos, const unsigned char *p, size_t m)
+  {
+    for (size_t i = npos; i != 0; --i)
+    {
+      if (s[i - 1] == p[0] && s[i + m - 2] == p[m - 1] && std::memcmp(s + i, p + 1, m - 2) == 0)
+        return i - 1;
+    }
+    return npos;
+  }
+
+#ifdef ZFWSTL_SIMD_SSE2
+  // ===========================SSE2 版本===========================
+  template <size_t Size>
+  struct sse2_ops;
+  template <>
+  struct sse2_ops<1>
+  {
+    static __m128i set1(int8_t x) { return _mm_set1_epi8(x); }
+    static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+    static __m128i gt(__m128i a, __m128i b) { return _mm_cmpgt_epi8(a, b); }
+    static __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi8(a, b); }
+  };
+  template <>
+  struct sse2_ops<2>
+  {
+    static __m128i set1(int16_t x) { return _mm_set1_epi16(x); }
+    static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+    static __m128i gt(__m128i a, __m128i b) { return _mm_cmpgt_epi16(a, b); }
+    static __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi16(a, b); }
+  };
+  template <>
+  struct sse2_ops<4>
+  {
+    static __m128i set1(int32_t x) { return _mm_set1_epi32(x); }
+    static __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+    static __m128i gt(__m128i a, __m128i b) { return _mm_cmpgt_epi32(a, b); }
+    static __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+  };
+  template <>
+  struct sse2_ops<8>
+  {
+    static __m128i set1(int64_t x) { return _mm_set1_epi64x(x); }
+    // SSE2 没有 64 位相等比较：两个 32 位的一半都相等才相等
+    static __m128i eq(__m128i a, __m128i b)
+    {
+      const __m128i t = _mm_cmpeq_epi32(a, b);
+      return _mm_and_si128(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    static __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi64(a, b); }
+  };
+
+  inline __m128i sse2_load(const void *p) { return _mm_loadu_si128(static_cast<const __m128i *>(p)); }
+  inline uint32_t sse2_mask(__m128i v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+
+  template <class T>
+  const T *sse2_find(const T *first, const T *last, T value)
+  {
+    typedef sse2_ops<sizeof(T)> ops;
+    const size_t width = 16 / sizeof(T);
+    const __m128i v = ops::set1(static_cast<typename simd_int<sizeof(T)>::type>(value));
+    // 每次看两个向量，合并后只判断一次
+    for (; static_cast<size_t>(last - first) >= 2 * width; first += 2 * width)
+    {
+      const __m128i e0 = ops::eq(sse2_load(first), v);
+      const __m128i e1 = ops::eq(sse2_load(first + width), v);
+      const uint32_t mask = sse2_mask(e0) | (sse2_mask(e1) << 16);
+      if (mask)
+        return first + simd_ctz(mask) / sizeof(T);
+    }
+    for (; static_cast<size_t>(last - first) >= width; first += width)
+    {
+      const uint32_t mask = sse2_mask(ops::eq(sse2_load(first), v));
+      if (mask)
+        return first + simd_ctz(mask) / sizeof(T);
+    }
+    return zfwstl::scalar_find(first, last, value);
+  }
+
+  template <class T>
+  size_t sse2_count(const T *first, const T *last, T value)
+  {
+    typedef sse2_ops<sizeof(T)> ops;
+    typedef typename std::make_unsigned<T>::type counter_type;
+    const size_t width = 16 / sizeof(T);
+    const __m128i v = ops::set1(static_cast<typename simd_int<sizeof(T)>::type>(value));
+    size_t n = 0;
+    while (static_cast<size_t>(last - first) >= width)
+    {
+      size_t rounds = static_cast<size_t>(last - first) / width;
+      if (rounds > simd_count_block<T>())
+        rounds = simd_count_block<T>();
+      __m128i acc = _mm_setzero_si128();
+      for (; rounds != 0; --rounds, first += width)
+        acc = ops::sub(acc, ops::eq(sse2_load(first), v));
+      counter_type lanes[16 / sizeof(T)];
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+      for (size_t i = 0; i < width; ++i)
+        n += lanes[i];
+    }
+    return n + zfwstl::scalar_count(first, last, value);
+  }
+
+  template <class T>
+  size_t sse2_mismatch(const T *first1, const T *first2, size_t n)
+  {
+    typedef sse2_ops<sizeof(T)> ops;
+    const size_t width = 16 / sizeof(T);
+    size_t i = 0;
+    for (; n - i >= width; i += width)
+    {
+      const uint32_t mask = sse2_mask(ops::eq(sse2_load(first1 + i), sse2_load(first2 + i))) ^ 0xFFFFu;
+      if (mask)
+        return i + simd_ctz(mask) / sizeof(T);
+    }
+    return zfwstl::scalar_mismatch(first1, first2, n, i);
+  }
+
+  // last - first >= 16 / sizeof(T)，sizeof(T) < 8
+  template <bool Max, class T>
+  T sse2_extreme(const T *first, const T *last)
+  {
+    typedef sse2_ops<sizeof(T)> ops;
+    const size_t width = 16 / sizeof(T);
+    const __m128i bias = ops::set1(simd_sign_bias<T>());
+    __m128i best = _mm_xor_si128(sse2_load(first), bias);
+    for (first += width; static_cast<size_t>(last - first) >= width; first += width)
+    {
+      const __m128i v = _mm_xor_si128(sse2_load(first), bias);
+      const __m128i take = Max ? ops::gt(v, best) : ops::gt(best, v);
+      best = _mm_or_si128(_mm_and_si128(take, v), _mm_andnot_si128(take, best));
+    }
+    T lanes[16 / sizeof(T)];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), _mm_xor_si128(best, bias));
+    T result = zfwstl::scalar_extreme<Max>(lanes, lanes + width);
+    if (first != last)
+    {
+      const T tail = zfwstl::scalar_extreme<Max>(first, last);
+      if (Max ? result < tail : tail < result)
+        result = tail;
+    }
+    return result;
+  }
+
+  template <bool Max, class T>
+  const T *sse2_extreme_element(const T *first, const T *last, std::true_type)
+  {
+    if (static_cast<size_t>(last - first) < 16 / sizeof(T))
+      return zfwstl::scalar_extreme_element<Max>(first, last);
+    return zfwstl::sse2_find(first, last, zfwstl::sse2_extreme<Max>(first, last));
+  }
+  // 8 字节整数：SSE2 没有 64 位的大小比较
+  template <bool Max, class T>
+  const T *sse2_extreme_element(const T *first, const T *last, std::false_type)
+  {
+    return zfwstl::scalar_extreme_element<Max>(first, last);
+  }
+  // 起点 [i, i + 16) 中首末字节都相等的位置掩码
+  inline uint32_t sse2_search_mask(const unsigned char *s, size_t i, size_t m, __m128i first, __m128i last)
+  {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + m - 1));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+  }
+
+  inline size_t sse2_search_bytes(const unsigned char *s, size_t npos, const unsigned char *p, size_t m)
+  {
+    const __m128i first = _mm_set1_epi8(static_cast<char>(p[0]));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(p[m - 1]));
+    size_t i = 0;
+    for (; i + 16 <= npos; i += 16)
+    {
+      for (uint32_t mask = sse2_search_mask(s, i, m, first, last); mask != 0; mask &= mask - 1)
+      {
+        const size_t j = i + simd_ctz(mask);
+        if (std::memcmp(s + j + 1, p + 1, m - 2) == 0)
+          return j;
+      }
+    }
+    return i + zfwstl::scalar_search_bytes(s + i, npos - i, p, m);
+  }
+
+  inline size_t sse2_rsearch_bytes(const unsigned char *s, size_t npos, const unsigned char *p, size_t m)
+  {
+    const __m128i first = _mm_set1_epi8(static_cast<char>(p[0]));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(p[m - 1]));
+    size_t i = npos;
+    for (; i >= 16; i -= 16)
+    {
+      for (uint32_t mask = sse2_search_mask(s, i - 16, m, first, last); mask != 0;)
+      {
+        const unsigned bit = simd_msb(mask);
+        const size_t j = i - 16 + bit;
+        if (std::memcmp(s + j + 1, p + 1, m - 2) == 0)
+          return j;
+        mask ^= 1u << bit;
+      }
+    }
+    const size_t r = zfwstl::scalar_rsearch_bytes(s, i, p, m);
+    return r == i ? npos : r;
+  }
+#endif // ZFWSTL_SIMD_SSE2
+
+#ifdef ZFWSTL_SIMD_AVX2
+  // ===========================AVX2 版本===========================
+  template <size_t Size>
+  struct avx2_ops;
+  template <>
+  struct avx2_ops<1>
+  {
+    ZFWSTL_TARGET_AVX2 static __m256i set1(int8_t x) { return _mm256_set1_epi8(x); }
+    ZFWSTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+    ZFWSTL_TARGET_AVX2 static __m256i gt(__m256i a, __m256i b) { return _mm256_cmpgt_epi8(a, b); }
+    ZFWSTL_TARGET_AVX2 static __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi8(a, b); }
+  };
+  template <>
+  struct avx2_ops<2>
+  {
+    ZFWSTL_TARGET_AVX2 static __m256i set1(int16_t x) { return _mm256_set1_epi16(x); }
+    ZFWSTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+    ZFWSTL_TARGET_AVX2 static __m256i gt(__m256i a, __m256i b) { return _mm256_cmpgt_epi16(a, b); }
+    ZFWSTL_TARGET_AVX2 static __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi16(a, b); }
+  };
+  template <>
+  struct avx2_ops<4>
+  {
+    ZFWSTL_TARGET_AVX2 static __m256i set1(int32_t x) { return _mm256_set1_epi32(x); }
+    ZFWSTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+    ZFWSTL_TARGET_AVX2 static __m256i gt(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(a, b); }
+    ZFWSTL_TARGET_AVX2 static __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
+  };
+  template <>
+  struct avx2_ops<8>
+  {
+    ZFWSTL_TARGET_AVX2 static __m256i set1(int64_t x) { return _mm256_set1_epi64x(x); }
+    ZFWSTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+    ZFWSTL_TARGET_AVX2 static __m256i gt(__m256i a, __m256i b) { return _mm256_cmpgt_epi64(a, b); }
+    ZFWSTL_TARGET_AVX2 static __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi64(a, b); }
+  };
+
+  ZFWSTL_TARGET_AVX2 inline __m256i avx2_load(const void *p)
+  {
+    return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+  }
+  ZFWSTL_TARGET_AVX2 inline uint32_t avx2_mask(__m256i v) { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); }
+
+  template <class T>
+  ZFWSTL_TARGET_AVX2 const T *avx2_find(const T *first, const T *last, T value)
+  {
+    typedef avx2_ops<sizeof(T)> ops;
+    const size_t width = 32 / sizeof(T);
+    const __m256i v = ops::set1(static_cast<typename simd_int<sizeof(T)>::type>(value));
+    // 每次看两个向量，合并后只判断一次
+    for (; static_cast<size_t>(last - first) >= 2 * width; first += 2 * width)
+    {
+      const __m256i e0 = ops::eq(avx2_load(first), v);
+      const __m256i e1 = ops::eq(avx2_load(first + width), v);
+      if (!_mm256_testz_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e0, e1)))
+      {
+        const uint32_t mask0 = avx2_mask(e0);
+        return mask0 ? first + simd_ctz(mask0) / sizeof(T)
+                     : first + width + simd_ctz(avx2_mask(e1)) / sizeof(T);
+      }
+    }
+    for (; static_cast<size_t>(last - first) >= width; first += width)
+    {
+      const uint32_t mask = avx2_mask(ops::eq(avx2_load(first), v));
+      if (mask)
+        return first + simd_ctz(mask) / sizeof(T);
+    }
+    return zfwstl::scalar_find(first, last, value);
+  }
+
+  template <class T>
+  ZFWSTL_TARGET_AVX2 size_t avx2_count(const T *first, const T *last, T value)
+  {
+    typedef avx2_ops<sizeof(T)> ops;
+    typedef typename std::make_unsigned<T>::type counter_type;
+    const size_t width = 32 / sizeof(T);
+    const __m256i v = ops::set1(static_cast<typename simd_int<sizeof(T)>::type>(value));
+    size_t n = 0;
+    while (static_cast<size_t>(last - first) >= width)
+    {
+      size_t rounds = static_cast<size_t>(last - first) / width;
+      if (rounds > simd_count_block<T>())
+        rounds = simd_count_block<T>();
+      __m256i acc = _mm256_setzero_si256();
+      for (; rounds != 0; --rounds, first += width)
+        acc = ops::sub(acc, ops::eq(avx2_load(first), v));
+      counter_type lanes[32 / sizeof(T)];
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+      for (size_t i = 0; i < width; ++i)
+        n += lanes[i];
+    }
+    return n + zfwstl::scalar_count(first, last, value);
+  }
+
+  template <class T>
+  ZFWSTL_TARGET_AVX2 size_t avx2_mismatch(const T *first1, const T *first2, size_t n)
+  {
+    typedef avx2_ops<sizeof(T)> ops;
+    const size_t width = 32 / sizeof(T);
+    size_t i = 0;
+    for (; n - i >= width; i += width)
+    {
+      const uint32_t mask = ~avx2_mask(ops::eq(avx2_load(first1 + i), avx2_load(first2 + i)));
+      if (mask)
+        return i + simd_ctz(mask) / sizeof(T);
+    }
+    return zfwstl::scalar_mismatch(first1, first2, n, i);
+  }
+
+  // last - first >= 32 / sizeof(T)
+  template <bool Max, class T>
+  ZFWSTL_TARGET_AVX2 T avx2_extreme(const T *first, const T *last)
+  {
+    typedef avx2_ops<sizeof(T)> ops;
+    const size_t width = 32 / sizeof(T);
+    const __m256i bias = ops::set1(simd_sign_bias<T>());
+    __m256i best = _mm256_xor_si256(avx2_load(first), bias);
+    for (first += width; static_cast<size_t>(last - first) >= width; first += width)
+    {
+      const __m256i v = _mm256_xor_si256(avx2_load(first), bias);
+      best = _mm256_blendv_epi8(best, v, Max ? ops::gt(v, best) : ops::gt(best, v));
+    }
+    T lanes[32 / sizeof(T)];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), _mm256_xor_si256(best, bias));
+    T result = zfwstl::scalar_extreme<Max>(lanes, lanes + width);
+    if (first != last)
+    {
+      const T tail = zfwstl::scalar_extreme<Max>(first, last);
+      if (Max ? result < tail : tail < result)
+        result = tail;
+    }
+    return result;
+  }
+  ZFWSTL_TARGET_AVX2 inline uint32_t avx2_search_mask(const unsigned char *s, size_t i, size_t m, __m256i first, __m256i last)
+  {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + m - 1));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+  }
+
+  ZFWSTL_TARGET_AVX2 inline size_t avx2_search_bytes(const unsigned char *s, size_t npos, const unsigned char *p, size_t m)
+  {
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(p[0]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(p[m - 1]));
+    size_t i = 0;
+    for (; i + 32 <= npos; i += 32)
+    {
+      for (uint32_t mask = avx2_search_mask(s, i, m, first, last); mask != 0; mask &= mask - 1)
+      {
+        const size_t j = i + simd_ctz(mask);
+        if (std::memcmp(s + j + 1, p + 1, m - 2) == 0)
+          return j;
+      }
+    }
+    return i + zfwstl::sse2_search_bytes(s + i, npos - i, p, m);
+  }
+
+  ZFWSTL_TARGET_AVX2 inline size_t avx2_rsearch_bytes(const unsigned char *s, size_t npos, const unsigned char *p, size_t m)
+  {
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(p[0]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(p[m - 1]));
+    size_t i = npos;
+    for (; i >= 32; i -= 32)
+    {
+      for (uint32_t mask = avx2_search_mask(s, i - 32, m, first, last); mask != 0;)
+      {
+        const unsigned bit = simd_msb(mask);
+        const size_t j = i - 32 + bit;
+        if (std::memcmp(s + j + 1, p + 1, m - 2) == 0)
+          return j;
+        mask ^= 1u << bit;
+      }
+    }
+    const size_t r = zfwstl::sse2_rsearch_bytes(s, i, p, m);
+    return r == i ? npos : r;
+  }
+#endif // ZFWSTL_SIMD_AVX2
+
+#ifdef ZFWSTL_SIMD_SSE2
+  // ===========================SSE2 版本(浮点数)===========================
+  template <class T>
+  struct sse2_fops;
+  template <>
+  struct sse2_fops<double>
+  {
+    typedef __m128d vec;
+    static vec load(const double *p) { return _mm_loadu_pd(p); }
+    static void store(double *p, vec v) { _mm_storeu_pd(p, v); }
+    static vec zero() { return _mm_setzero_pd(); }
+    static vec add(vec a, vec b) { return _mm_add_pd(a, b); }
+    static vec sub(vec a, vec b) { return _mm_sub_pd(a, b); }
+    static vec mul(vec a, vec b) { return _mm_mul_pd(a, b); }
+  };
+  template <>
+  struct sse2_fops<float>
+  {
+    typedef __m128 vec;
+    static vec load(const float *p) { return _mm_loadu_ps(p); }
+    static void store(float *p, vec v) { _mm_storeu_ps(p, v); }
+    static vec zero() { return _mm_setzero_ps(); }
+    static vec add(vec a, vec b) { return _mm_add_ps(a, b); }
+    static vec sub(vec a, vec b) { return _mm_sub_ps(a, b); }
+    static vec mul(vec a, vec b) { return _mm_mul_ps(a, b); }
+  };
+
+  // L 路为 4 个向量
+  template <class T>
+  void sse2_sum_lanes(const T *p, size_t n, T *lanes)
+  {
+    typedef sse2_fops<T> ops;
+    const size_t width = 16 / sizeof(T), lanes_n = reduce_lanes<T>::value;
+    typename ops::vec acc[4];
+    for (size_t j = 0; j < 4; ++j)
+      acc[j] = ops::load(p + j * width);
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      for (size_t j = 0; j < 4; ++j)
+        acc[j] = ops::add(acc[j], ops::load(p + k + j * width));
+    }
+    for (size_t j = 0; j < 4; ++j)
+      ops::store(lanes + j * width, acc[j]);
+  }
+
+  template <class T>
+  void sse2_dot_lanes(const T *a, const T *b, size_t n, T *lanes)
+  {
+    typedef sse2_fops<T> ops;
+    const size_t width = 16 / sizeof(T), lanes_n = reduce_lanes<T>::value;
+    typename ops::vec acc[4];
+    for (size_t j = 0; j < 4; ++j)
+      acc[j] = ops::mul(ops::load(a + j * width), ops::load(b + j * width));
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      for (size_t j = 0; j < 4; ++j)
+        acc[j] = ops::add(acc[j], ops::mul(ops::load(a + k + j * width), ops::load(b + k + j * width)));
+    }
+    for (size_t j = 0; j < 4; ++j)
+      ops::store(lanes + j * width, acc[j]);
+  }
+
+  template <class T>
+  void sse2_kahan_lanes(const T *p, size_t n, T *sum, T *comp)
+  {
+    typedef sse2_fops<T> ops;
+    const size_t width = 16 / sizeof(T), lanes_n = reduce_lanes<T>::value;
+    typename ops::vec s[4], c[4];
+    for (size_t j = 0; j < 4; ++j)
+    {
+      s[j] = ops::load(p + j * width);
+      c[j] = ops::zero();
+    }
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      for (size_t j = 0; j < 4; ++j)
+      {
+        const typename ops::vec y = ops::sub(ops::load(p + k + j * width), c[j]);
+        const typename ops::vec t = ops::add(s[j], y);
+        c[j] = ops::sub(ops::sub(t, s[j]), y);
+        s[j] = t;
+      }
+    }
+    for (size_t j = 0; j < 4; ++j)
+    {
+      ops::store(sum + j * width, s[j]);
+      ops::store(comp + j * width, c[j]);
+    }
+  }
+#endif // ZFWSTL_SIMD_SSE2
+
+#ifdef ZFWSTL_SIMD_AVX2
+  // ===========================AVX2 版本(浮点数)===========================
+  template <class T>
+  struct avx2_fops;
+  template <>
+  struct avx2_fops<double>
+  {
+    typedef __m256d vec;
+    ZFWSTL_TARGET_AVX2 static vec load(const double *p) { return _mm256_loadu_pd(p); }
+    ZFWSTL_TARGET_AVX2 static void store(double *p, vec v) { _mm256_storeu_pd(p, v); }
+    ZFWSTL_TARGET_AVX2 static vec zero() { return _mm256_setzero_pd(); }
+    ZFWSTL_TARGET_AVX2 static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+    ZFWSTL_TARGET_AVX2 static vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+    ZFWSTL_TARGET_AVX2 static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+  };
+  template <>
+  struct avx2_fops<float>
+  {
+    typedef __m256 vec;
+    ZFWSTL_TARGET_AVX2 static vec load(const float *p) { return _mm256_loadu_ps(p); }
+    ZFWSTL_TARGET_AVX2 static void store(float *p, vec v) { _mm256_storeu_ps(p, v); }
+    ZFWSTL_TARGET_AVX2 static vec zero() { return _mm256_setzero_ps(); }
+    ZFWSTL_TARGET_AVX2 static vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+    ZFWSTL_TARGET_AVX2 static vec sub(vec a, vec b) { return _mm256_sub_ps(a, b); }
+    ZFWSTL_TARGET_AVX2 static vec mul(vec a, vec b) { return _mm256_mul_ps(a, b); }
+  };
+
+  // L 路为 2 个向量
+  template <class T>
+  ZFWSTL_TARGET_AVX2 void avx2_sum_lanes(const T *p, size_t n, T *lanes)
+  {
+    typedef avx2_fops<T> ops;
+    const size_t width = 32 / sizeof(T), lanes_n = reduce_lanes<T>::value;
+    typename ops::vec acc0 = ops::load(p), acc1 = ops::load(p + width);
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      acc0 = ops::add(acc0, ops::load(p + k));
+      acc1 = ops::add(acc1, ops::load(p + k + width));
+    }
+    ops::store(lanes, acc0);
+    ops::store(lanes + width, acc1);
+  }
+
+  template <class T>
+  ZFWSTL_TARGET_AVX2 void avx2_dot_lanes(const T *a, const T *b, size_t n, T *lanes)
+  {
+    typedef avx2_fops<T> ops;
+    const size_t width = 32 / sizeof(T), lanes_n = reduce_lanes<T>::value;
+    typename ops::vec acc0 = ops::mul(ops::load(a), ops::load(b));
+    typename ops::vec acc1 = ops::mul(ops::load(a + width), ops::load(b + width));
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      acc0 = ops::add(acc0, ops::mul(ops::load(a + k), ops::load(b + k)));
+      acc1 = ops::add(acc1, ops::mul(ops::load(a + k + width), ops::load(b + k + width)));
+    }
+    ops::store(lanes, acc0);
+    ops::store(lanes + width, acc1);
+  }
+
+  template <class T>
+  ZFWSTL_TARGET_AVX2 void avx2_kahan_lanes(const T *p, size_t n, T *sum, T *comp)
+  {
+    typedef avx2_fops<T> ops;
+    const size_t width = 32 / sizeof(T), lanes_n = reduce_lanes<T>::value;
+    typename ops::vec s0 = ops::load(p), s1 = ops::load(p + width);
+    typename ops::vec c0 = ops::zero(), c1 = ops::zero();
+    for (size_t k = lanes_n; k < n; k += lanes_n)
+    {
+      const typename ops::vec y0 = ops::sub(ops::load(p + k), c0);
+      const typename ops::vec y1 = ops::sub(ops::load(p + k + width), c1);
+      const typename ops::vec t0 = ops::add(s0, y0);
+      const typename ops::vec t1 = ops::add(s1, y1);
+      c0 = ops::sub(ops::sub(t0, s0), y0);
+      c1 = ops::sub(ops::sub(t1, s1), y1);
+      s0 = t0;
+      s1 = t1;
+    }
+    ops::store(sum, s0);
+    ops::store(sum + width, s1);
+    ops::store(comp, c0);
+    ops::store(comp + width, c1);
+  }
+#endif // ZFWSTL_SIMD_AVX2
+
+  // ===========================按指令集分派===========================
+  template <class T>
+  const T *simd_find(const T *first, const T *last, T value)
+  {
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      return zfwstl::avx2_find(first, last, value);
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      return zfwstl::sse2_find(first, last, value);
+#endif
+    default:
+      return zfwstl::scalar_find(first, last, value);
+    }
+  }
+
+  template <class T>
+  size_t simd_count(const T *first, const T *last, T value)
+  {
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      return zfwstl::avx2_count(first, last, value);
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      return zfwstl::sse2_count(first, last, value);
+#endif
+    default:
+      return zfwstl::scalar_count(first, last, value);
+    }
+  }
+
+  // 返回第一处不相等的下标，全部相等时返回 n
+  template <class T>
+  size_t simd_mismatch(const T *first1, const T *first2, size_t n)
+  {
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      return zfwstl::avx2_mismatch(first1, first2, n);
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      return zfwstl::sse2_mismatch(first1, first2, n);
+#endif
+    default:
+      return zfwstl::scalar_mismatch(first1, first2, n);
+    }
+  }
+
+  // 返回第一个最大(Max)或最小的元素，区间为空时返回 last
+  template <bool Max, class T>
+  const T *simd_extreme_element(const T *first, const T *last)
+  {
+    if (first == last)
+      return last;
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      if (static_cast<size_t>(last - first) < 32 / sizeof(T))
+        return zfwstl::scalar_extreme_element<Max>(first, last);
+      return zfwstl::avx2_find(first, last, zfwstl::avx2_extreme<Max>(first, last));
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      return zfwstl::sse2_extreme_element<Max>(first, last, std::integral_constant<bool, (sizeof(T) < 8)>());
+#endif
+    default:
+      return zfwstl::scalar_extreme_element<Max>(first, last);
+    }
+  }
+
+  // 多路求和、点积、Kahan 求和(T 为 float 或 double)
+  template <class T>
+  void simd_sum_lanes(const T *p, size_t n, T *lanes)
+  {
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      return zfwstl::avx2_sum_lanes(p, n, lanes);
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      return zfwstl::sse2_sum_lanes(p, n, lanes);
+#endif
+    default:
+      return zfwstl::scalar_sum_lanes(p, n, lanes);
+    }
+  }
+
+  template <class T>
+  void simd_dot_lanes(const T *a, const T *b, size_t n, T *lanes)
+  {
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      return zfwstl::avx2_dot_lanes(a, b, n, lanes);
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      return zfwstl::sse2_dot_lanes(a, b, n, lanes);
+#endif
+    default:
+      return zfwstl::scalar_dot_lanes(a, b, n, lanes);
+    }
+  }
+
+  template <class T>
+  void simd_kahan_lanes(const T *p, size_t n, T *sum, T *comp)
+  {
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      return zfwstl::avx2_kahan_lanes(p, n, sum, comp);
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      return zfwstl::sse2_kahan_lanes(p, n, sum, comp);
+#endif
+    default:
+      return zfwstl::scalar_kahan_lanes(p, n, sum, comp);
+    }
+  }
+
+  // 字节串子串查找(T 为 1 字节整数)：返回第一次 / 最后一次出现的起点，找不到返回 last；空模式返回 first / last
+  template <class T>
+  const T *simd_search(const T *first, const T *last, const T *pfirst, const T *plast)
+  {
+    const size_t n = static_cast<size_t>(last - first), m = static_cast<size_t>(plast - pfirst);
+    if (m == 0)
+      return first;
+    if (m > n)
+      return last;
+    if (m == 1)
+      return zfwstl::simd_find(first, last, *pfirst);
+    const unsigned char *s = reinterpret_cast<const unsigned char *>(first);
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(pfirst);
+    const size_t npos = n - m + 1;
+    size_t i;
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      i = zfwstl::avx2_search_bytes(s, npos, p, m);
+      break;
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      i = zfwstl::sse2_search_bytes(s, npos, p, m);
+      break;
+#endif
+    default:
+      i = zfwstl::scalar_search_bytes(s, npos, p, m);
+      break;
+    }
+    return i == npos ? last : first + i;
+  }
+
+  template <class T>
+  const T *simd_rsearch(const T *first, const T *last, const T *pfirst, const T *plast)
+  {
+    const size_t n = static_cast<size_t>(last - first), m = static_cast<size_t>(plast - pfirst);
+    if (m == 0 || m > n)
+      return last;
+    const unsigned char *s = reinterpret_cast<const unsigned char *>(first);
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(pfirst);
+    if (m == 1)
+    {
+      for (const T *i = last; i != first; --i)
+      {
+        if (*(i - 1) == *pfirst)
+          return i - 1;
+      }
+      return last;
+    }
+    const size_t npos = n - m + 1;
+    size_t i;
+    switch (simd_level())
+    {
+#ifdef ZFWSTL_SIMD_AVX2
+    case simd_isa_avx2:
+      i = zfwstl::avx2_rsearch_bytes(s, npos, p, m);
+      break;
+#endif
+#ifdef ZFWSTL_SIMD_SSE2
+    case simd_isa_sse2:
+      i = zfwstl::sse2_rsearch_bytes(s, npos, p, m);
+      break;
+#endif
+    default:
+      i = zfwstl::scalar_rsearch_bytes(s, npos, p, m);
+      break;
+    }
+    return i == npos ? last : first + i;
+  }
+}
+
+#endif // !ZFWSTL_SIMD_ALGO_H_
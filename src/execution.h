@@ -0,0 +1,355 @@
+#ifndef ZFWSTL_EXECUTION_H_
+#define ZFWSTL_EXECUTION_H_
+/**
+ * 执行策略与工作窃取(work-stealing)任务池，供 parallel_algo.h 中的并行算法使用
+ * execution::seq      : 顺序执行，与不带策略的版本相同
+ * execution::par      : 在任务池中并行执行；par.on(pool) 指定任务池，缺省为 work_stealing_pool::default_pool()
+ * execution::par_unseq: 同 par(本库没有单独的向量化版本，循环的向量化交给编译器)
+ *
+ * work_stealing_pool(n): 并发度为 n，即 n - 1 个工作线程，外加调用 task_group::wait() 的线程
+ *   每个工作线程有自己的任务队列：自己从尾部取(后进先出，局部性好)，空闲时从其他队列头部窃取(先进先出，窃走的是较大的任务)
+ *   池外线程提交的任务放进公共队列，所有工作线程都会从中窃取
+ * task_group: 一组 fork-join 任务；run() 提交任务，wait() 等待本组任务全部完成
+ *   wait() 不会干等，而是帮忙执行池中的任务，因此任务里可以再创建 task_group 并 wait()(嵌套并行)
+ *   任务抛出的第一个异常由 wait() 重新抛出
+ */
+#include <cstddef>            // for size_t
+#include <cstring>            // for memmove
+#include <atomic>             // for std::atomic
+#include <mutex>              // for std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable> // for std::condition_variable
+#include <thread>             // for std::thread, hardware_concurrency, yield
+#include <exception>          // for std::exception_ptr
+#include <type_traits>        // for decay, integral_constant
+#include "util.h"             // for forward, move
+namespace zfwstl
+{
+  class work_stealing_pool;
+  class task_group;
+
+  namespace execution
+  {
+    struct sequenced_policy
+    {
+    };
+    struct parallel_policy
+    {
+      work_stealing_pool *pool;
+      constexpr parallel_policy() : pool(nullptr) {}
+      constexpr explicit parallel_policy(work_stealing_pool *p) : pool(p) {}
+      // 在指定的任务池上执行，如 sort(par.on(pool), first, last)
+      parallel_policy on(work_stealing_pool &p) const { return parallel_policy(&p); }
+    };
+    struct parallel_unsequenced_policy
+    {
+      work_stealing_pool *pool;
+      constexpr parallel_unsequenced_policy() : pool(nullptr) {}
+      constexpr explicit parallel_unsequenced_policy(work_stealing_pool *p) : pool(p) {}
+      parallel_unsequenced_policy on(work_stealing_pool &p) const { return parallel_unsequenced_policy(&p); }
+    };
+
+    constexpr sequenced_policy seq{};
+    constexpr parallel_policy par{};
+    constexpr parallel_unsequenced_policy par_unseq{};
+  }
+
+  // is_execution_policy: 用于算法重载的 enable_if
+  template <class T>
+  struct is_execution_policy : std::false_type
+  {
+  };
+  template <>
+  struct is_execution_policy<execution::sequenced_policy> : std::true_type
+  {
+  };
+  template <>
+  struct is_execution_policy<execution::parallel_policy> : std::true_type
+  {
+  };
+  template <>
+  struct is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type
+  {
+  };
+
+  //===============================work_stealing_pool==========================
+  class work_stealing_pool
+  {
+    friend class task_group;
+
+  private:
+    struct task
+    {
+      task_group *group;
+      virtual ~task() {}
+      virtual void run() = 0;
+    };
+    template <class F>
+    struct task_impl : task
+    {
+      F f;
+      explicit task_impl(F &&fn) : f(zfwstl::move(fn)) {}
+      explicit task_impl(const F &fn) : f(fn) {}
+      void run() override { f(); }
+    };
+    // 任务队列：数组 [head, tail) 加一把锁；所有者在 tail 端进出，窃取者从 head 端取
+    // 任务粒度较粗(每个至少几千个元素)，锁的开销可以忽略，不必用无锁的 Chase-Lev 队列
+    struct task_queue
+    {
+      std::mutex lock;
+      task **buf = nullptr;
+      size_t cap = 0, head = 0, tail = 0;
+
+      ~task_queue() { delete[] buf; }
+      void push(task *t)
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (tail == cap)
+        {
+          if (head > cap / 2)
+          { // 前面空出一半以上，前移即可
+            std::memmove(buf, buf + head, (tail - head) * sizeof(task *));
+          }
+          else
+          {
+            const size_t new_cap = cap == 0 ? 64 : cap * 2;
+            task **nb = new task *[new_cap];
+            if (tail != head)
+              std::memcpy(nb, buf + head, (tail - head) * sizeof(task *));
+            delete[] buf;
+            buf = nb;
+            cap = new_cap;
+          }
+          tail -= head;
+          head = 0;
+        }
+        buf[tail++] = t;
+      }
+      task *pop()
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (tail == head)
+          return nullptr;
+        task *t = buf[--tail];
+        if (tail == head)
+          head = tail = 0;
+        return t;
+      }
+      task *steal()
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (tail == head)
+          return nullptr;
+        task *t = buf[head++];
+        if (tail == head)
+          head = tail = 0;
+        return t;
+      }
+    };
+    // 当前线程所属的任务池与队列编号；池外线程 pool == nullptr
+    struct worker_slot
+    {
+      work_stealing_pool *pool;
+      size_t index;
+    };
+    static worker_slot &self()
+    {
+      static thread_local worker_slot slot = {nullptr, 0};
+      return slot;
+    }
+
+    size_t nworkers;
+    task_queue *queues; // nworkers 个工作线程各一个，最后一个是池外线程提交任务用的公共队列
+    std::thread *threads;
+    std::atomic<size_t> queued;   // 所有队列中的任务数，空闲线程据此决定是否睡眠
+    std::atomic<size_t> sleeping; // 正在睡眠的工作线程数
+    std::atomic<bool> stop;
+    std::mutex sleep_lock;
+    std::condition_variable wakeup;
+
+  public:
+    explicit work_stealing_pool(size_t concurrency = std::thread::hardware_concurrency())
+        : nworkers(concurrency > 1 ? concurrency - 1 : 0), queues(nullptr), threads(nullptr),
+          queued(0), sleeping(0), stop(false)
+    {
+      queues = new task_queue[nworkers + 1];
+      threads = new std::thread[nworkers];
+      for (size_t i = 0; i < nworkers; ++i)
+        threads[i] = std::thread(&work_stealing_pool::worker_loop, this, i);
+    }
+    ~work_stealing_pool()
+    {
+      stop.store(true);
+      {
+        std::lock_guard<std::mutex> guard(sleep_lock);
+      }
+      wakeup.notify_all();
+      for (size_t i = 0; i < nworkers; ++i)
+        threads[i].join();
+      delete[] threads;
+      delete[] queues;
+    }
+    work_stealing_pool(const work_stealing_pool &) = delete;
+    work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+
+    // 并发度：工作线程数 + 1(调用 wait 的线程)
+    size_t concurrency() const noexcept { return nworkers + 1; }
+
+    // 缺省任务池，并发度为 hardware_concurrency()，第一次使用时创建
+    static work_stealing_pool &default_pool()
+    {
+      static work_stealing_pool pool;
+      return pool;
+    }
+
+  private:
+    void submit(task *t)
+    {
+      worker_slot &s = self();
+      queues[s.pool == this ? s.index : nworkers].push(t);
+      queued.fetch_add(1);
+      // 与 worker_loop 中 sleeping 加一后检查 queued 相对：两边都是 seq_cst，不会双方都没看见对方
+      if (sleeping.load() != 0)
+      {
+        {
+          std::lock_guard<std::mutex> guard(sleep_lock);
+        }
+        wakeup.notify_one();
+      }
+    }
+    // 先取自己的队列，再从其他队列(含公共队列)窃取
+    task *find_task()
+    {
+      worker_slot &s = self();
+      const bool mine = s.pool == this;
+      if (mine)
+      {
+        if (task *t = queues[s.index].pop())
+        {
+          queued.fetch_sub(1);
+          return t;
+        }
+      }
+      const size_t n = nworkers + 1;
+      const size_t start = mine ? s.index + 1 : 0;
+      for (size_t k = 0; k < n; ++k)
+      {
+        const size_t i = (start + k) % n;
+        if (mine && i == s.index)
+          continue;
+        if (task *t = queues[i].steal())
+        {
+          queued.fetch_sub(1);
+          return t;
+        }
+      }
+      return nullptr;
+    }
+    inline void execute(task *t);
+    void worker_loop(size_t index)
+    {
+      self().pool = this;
+      self().index = index;
+      while (true)
+      {
+        if (task *t = find_task())
+        {
+          execute(t);
+          continue;
+        }
+        std::unique_lock<std::mutex> guard(sleep_lock);
+        sleeping.fetch_add(1);
+        wakeup.wait(guard, [this]
+                    { return stop.load() || queued.load() != 0; });
+        sleeping.fetch_sub(1);
+        if (stop.load() && queued.load() == 0)
+          return;
+      }
+    }
+  };
+
+  //===============================task_group==========================
+  class task_group
+  {
+    friend class work_stealing_pool;
+
+  private:
+    work_stealing_pool &pool;
+    std::atomic<size_t> pending;
+    std::mutex error_lock;
+    std::exception_ptr error;
+
+  public:
+    explicit task_group(work_stealing_pool &p = work_stealing_pool::default_pool()) : pool(p), pending(0) {}
+    // 析构时等待未完成的任务，但不再抛出异常
+    ~task_group()
+    {
+      try
+      {
+        wait();
+      }
+      catch (...)
+      {
+      }
+    }
+    task_group(const task_group &) = delete;
+    task_group &operator=(const task_group &) = delete;
+
+    work_stealing_pool &get_pool() const noexcept { return pool; }
+
+    template <class F>
+    void run(F &&f)
+    {
+      typedef work_stealing_pool::task_impl<typename std::decay<F>::type> impl;
+      work_stealing_pool::task *t = new impl(zfwstl::forward<F>(f));
+      t->group = this;
+      // 先计数再提交，否则任务可能在计数前就已执行完并减到负数；提交失败时任务没有入队，撤销计数
+      pending.fetch_add(1);
+      try
+      {
+        pool.submit(t);
+      }
+      catch (...)
+      {
+        pending.fetch_sub(1);
+        delete t;
+        throw;
+      }
+    }
+    // 等待期间帮忙执行池中的任务(不一定是本组的)
+    void wait()
+    {
+      while (pending.load(std::memory_order_acquire) != 0)
+      {
+        if (work_stealing_pool::task *t = pool.find_task())
+          pool.execute(t);
+        else
+          std::this_thread::yield();
+      }
+      if (error)
+      {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+      }
+    }
+  };
+
+  inline void work_stealing_pool::execute(task *t)
+  {
+    task_group *g = t->group;
+    try
+    {
+      t->run();
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> guard(g->error_lock);
+      if (!g->error)
+        g->error = std::current_exception();
+    }
+    delete t;
+    g->pending.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+#endif // !ZFWSTL_EXECUTION_H_
@@ -4,6 +4,12 @@
  * 包含了 zfwstl 的函数对象与哈希函数
  */
 #include <cstddef> //for size_t
+#include <cstdint> //for uint64_t, uint32_t
+#include <cstring> //for memcpy
+#include <string>  //for basic_string
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 namespace zfwstl
 {
   // 定义一元函数的参数型别和返回值型别
@@ -124,12 +130,23 @@ namespace zfwstl
   /**
    * functor-rational 关系运算类仿函数
    */
+  // T 缺省为 void 时(equal_to<>、less<>、greater<>)是透明仿函数：
+  // 定义 is_transparent，operator() 接受任意两种可比较的型别，
+  // 关联容器据此允许用非 key_type 的键直接查找(如以 const char* 查找 std::string 键)而不构造临时对象
+
   // 等于
-  template <class T>
+  template <class T = void>
   struct equal_to : public binary_function<T, T, bool>
   {
     bool operator()(const T &x, const T &y) const { return x == y; }
   };
+  template <>
+  struct equal_to<void>
+  {
+    typedef void is_transparent;
+    template <class T, class U>
+    bool operator()(const T &x, const U &y) const { return x == y; }
+  };
 
   // 不等于
   template <class T>
@@ -139,18 +156,32 @@ namespace zfwstl
   };
 
   // 大于
-  template <class T>
+  template <class T = void>
   struct greater : public binary_function<T, T, bool>
   {
     bool operator()(const T &x, const T &y) const { return x > y; }
   };
+  template <>
+  struct greater<void>
+  {
+    typedef void is_transparent;
+    template <class T, class U>
+    bool operator()(const T &x, const U &y) const { return x > y; }
+  };
 
   // 小于
-  template <class T>
+  template <class T = void>
   struct less : public binary_function<T, T, bool>
   {
     bool operator()(const T &x, const T &y) const { return x < y; }
   };
+  template <>
+  struct less<void>
+  {
+    typedef void is_transparent;
+    template <class T, class U>
+    bool operator()(const T &x, const U &y) const { return x < y; }
+  };
 
   // 大于等于
   template <class T>
@@ -660,51 +691,219 @@ namespace zfwstl
 
 #undef MYSTL_TRIVIAL_HASH_FCN
 
-  // 对于浮点数，逐位哈希
-  inline size_t bitwise_hash(const unsigned char *first, size_t count)
+  /**
+   * 字节串哈希(wyhash 算法)
+   * 每次读取 8 字节(长串每轮并行处理 48 字节)，用 64x64->128 位乘法把高低两半异或折叠作为混合，
+   * 比逐字节的 FNV-1a 快一个数量级且通过 SMHasher 的分布测试
+   */
+  // 64x64 -> 128 位乘法，结果的低/高 64 位分别写回 a, b
+  inline void __hash_mum(uint64_t &a, uint64_t &b)
   {
-#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) && __SIZEOF_POINTER__ == 8)
-    const size_t fnv_offset = 14695981039346656037ull;
-    const size_t fnv_prime = 1099511628211ull;
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64);
 #else
-    const size_t fnv_offset = 2166136261u;
-    const size_t fnv_prime = 16777619u;
+    const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    const uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
 #endif
-    size_t result = fnv_offset;
-    for (size_t i = 0; i < count; ++i)
+  }
+  // 乘法后把高低两半异或折叠
+  inline uint64_t __hash_fold_mul(uint64_t a, uint64_t b)
+  {
+    __hash_mum(a, b);
+    return a ^ b;
+  }
+  // 按小端序读取，memcpy 避免未对齐访问
+  inline uint64_t __hash_read8(const unsigned char *p)
+  {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+  }
+  inline uint64_t __hash_read4(const unsigned char *p)
+  {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+  }
+  // 1~3 字节
+  inline uint64_t __hash_read3(const unsigned char *p, size_t k)
+  {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+  }
+
+  inline size_t hash_bytes(const void *key, size_t len, size_t seed = 0)
+  {
+    static const uint64_t secret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+                                       0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+    const unsigned char *p = static_cast<const unsigned char *>(key);
+    uint64_t s = static_cast<uint64_t>(seed);
+    s ^= __hash_fold_mul(s ^ secret[0], secret[1]);
+    uint64_t a, b;
+    if (len <= 16)
+    {
+      if (len >= 4)
+      {
+        // 4~16 字节：首尾各取两个可能重叠的 4 字节
+        const size_t off = (len >> 3) << 2;
+        a = (__hash_read4(p) << 32) | __hash_read4(p + off);
+        b = (__hash_read4(p + len - 4) << 32) | __hash_read4(p + len - 4 - off);
+      }
+      else if (len > 0)
+      {
+        a = __hash_read3(p, len);
+        b = 0;
+      }
+      else
+        a = b = 0;
+    }
+    else
     {
-      result ^= (size_t)first[i];
-      result *= fnv_prime;
+      size_t i = len;
+      if (i > 48)
+      {
+        // 三路独立的乘法链，充分利用流水线
+        uint64_t s1 = s, s2 = s;
+        do
+        {
+          s = __hash_fold_mul(__hash_read8(p) ^ secret[1], __hash_read8(p + 8) ^ s);
+          s1 = __hash_fold_mul(__hash_read8(p + 16) ^ secret[2], __hash_read8(p + 24) ^ s1);
+          s2 = __hash_fold_mul(__hash_read8(p + 32) ^ secret[3], __hash_read8(p + 40) ^ s2);
+          p += 48;
+          i -= 48;
+        } while (i > 48);
+        s ^= s1 ^ s2;
+      }
+      while (i > 16)
+      {
+        s = __hash_fold_mul(__hash_read8(p) ^ secret[1], __hash_read8(p + 8) ^ s);
+        i -= 16;
+        p += 16;
+      }
+      // 最后 16 字节(可能与已处理部分重叠)
+      a = __hash_read8(p + i - 16);
+      b = __hash_read8(p + i - 8);
     }
-    return result;
+    a ^= secret[1];
+    b ^= s;
+    __hash_mum(a, b);
+    return static_cast<size_t>(__hash_fold_mul(a ^ secret[0] ^ len, b ^ secret[1]));
+  }
+
+  // 整数雪崩混合：一次 128 位乘法折叠，输入的每一位都会影响输出的所有位
+  // 缺省的整数 hash 仍返回原值(保持质数取模下的行为)，需要均匀低位时(如 2 的幂桶)对结果再做 hash_mix
+  inline size_t hash_mix(size_t x)
+  {
+    return static_cast<size_t>(__hash_fold_mul(static_cast<uint64_t>(x) ^ 0x2d358dccaa6c78a5ull,
+                                                0x8bb84b93962eacc9ull));
   }
 
+  // 在 hash<Key> 的基础上做一次 hash_mix，供需要高质量低位的表格作为 HashFcn 使用
+  template <class Key>
+  struct mixed_hash
+  {
+    size_t operator()(const Key &key) const
+    {
+      return hash_mix(zfwstl::hash<Key>()(key));
+    }
+  };
+
+  // 组合哈希：把 val 的哈希值合并进 seed，用于由多个字段组成的键
+  template <class T>
+  inline void hash_combine(size_t &seed, const T &val)
+  {
+    seed = hash_mix(seed + 0x9e3779b97f4a7c15ull + zfwstl::hash<T>()(val));
+  }
+
+  // 对于浮点数，逐位哈希
+  inline size_t bitwise_hash(const unsigned char *first, size_t count)
+  {
+    return hash_bytes(first, count);
+  }
+
+  // +0.0 与 -0.0 相等，须得到相同的哈希值
   template <>
   struct hash<float>
   {
-    size_t operator()(const float &val)
+    size_t operator()(const float &val) const noexcept
     {
-      return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val, sizeof(float));
+      if (val == 0.0f)
+        return 0;
+      uint32_t bits;
+      std::memcpy(&bits, &val, sizeof(bits));
+      return hash_mix(bits);
     }
   };
 
   template <>
   struct hash<double>
   {
-    size_t operator()(const double &val)
+    size_t operator()(const double &val) const noexcept
     {
-      return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val, sizeof(double));
+      if (val == 0.0)
+        return 0;
+      uint64_t bits;
+      std::memcpy(&bits, &val, sizeof(bits));
+      return hash_mix(static_cast<size_t>(bits ^ (bits >> 32)));
     }
   };
 
+  // x87 的 long double 只有前 10 字节有效，其余为未定义的填充字节
   template <>
   struct hash<long double>
   {
-    size_t operator()(const long double &val)
+    size_t operator()(const long double &val) const noexcept
     {
-      return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val, sizeof(long double));
+      if (val == 0.0L)
+        return 0;
+#if defined(__x86_64__) || defined(__i386__)
+      return hash_bytes(&val, sizeof(long double) > 10 ? 10 : sizeof(long double));
+#else
+      return hash_bytes(&val, sizeof(long double));
+#endif
     }
   };
 
+  // 字符串：按字节哈希其内容
+  // 同时接受 C 风格字符串(及 string_view)，内容相同则哈希值相同，因此是透明的，
+  // 搭配 equal_to<> 即可在 unordered 容器中直接以 const char* 查找
+  template <class CharT, class Traits, class Allocator>
+  struct hash<std::basic_string<CharT, Traits, Allocator>>
+  {
+    typedef void is_transparent;
+    size_t operator()(const std::basic_string<CharT, Traits, Allocator> &str) const noexcept
+    {
+      return hash_bytes(str.data(), str.size() * sizeof(CharT));
+    }
+    size_t operator()(const CharT *str) const noexcept
+    {
+      return hash_bytes(str, Traits::length(str) * sizeof(CharT));
+    }
+#if __cplusplus >= 201703L
+    size_t operator()(std::basic_string_view<CharT, Traits> str) const noexcept
+    {
+      return hash_bytes(str.data(), str.size() * sizeof(CharT));
+    }
+#endif
+  };
+
+#if __cplusplus >= 201703L
+  template <class CharT, class Traits>
+  struct hash<std::basic_string_view<CharT, Traits>>
+  {
+    size_t operator()(std::basic_string_view<CharT, Traits> str) const noexcept
+    {
+      return hash_bytes(str.data(), str.size() * sizeof(CharT));
+    }
+  };
+#endif
+
 }
 #endif // !ZFWINYSTL_FUNCTIONAL_H_
\ No newline at end of file
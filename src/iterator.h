@@ -169,6 +169,28 @@ namespace zfwstl
   {
   };
 
+  // =========================分段迭代器萃取=====================
+  /**
+   * 分段迭代器：区间由若干段连续内存组成(如 deque 的各个缓冲区)
+   * 容器特化 segmented_iterator_traits 并令 is_segmented 为 true_type，同时提供：
+   *   local(it) / local_begin(it) / local_end(it)：it 所在段的当前位置、段头、段尾(裸指针)
+   *   same_segment(a, b)：两个迭代器是否在同一段
+   *   next_segment(it) / prev_segment(it)：移到下一段开头 / 上一段末尾
+   *   set_local(it, p)：把 it 定位到所在段的 p 处
+   * copy / move / fill / find / for_each 等算法据此逐段处理，每段复用指针版本的 memmove / memset / SIMD 路径
+   */
+  template <class Iter>
+  struct segmented_iterator_traits
+  {
+    typedef std::false_type is_segmented;
+  };
+
+  template <class Iter>
+  struct is_segmented_iterator
+      : public std::integral_constant<bool, segmented_iterator_traits<Iter>::is_segmented::value>
+  {
+  };
+
   // =========================迭代器相应型别萃取函数=====================
   template <class Iterator>
   inline typename iterator_traits<Iterator>::iterator_category
@@ -398,6 +420,7 @@ namespace zfwstl
     // 下面构造函数将 reverse_iterator 与某个正向迭代器 x关联起来
     explicit reverse_iterator(iterator_type x) : current(x) {}
     reverse_iterator(const self &x) : current(x.current) {}
+    self &operator=(const self &) = default;
 
     iterator_type base() const { return current; } // 取出对应的正向迭代器
 
@@ -442,7 +465,7 @@ namespace zfwstl
     {
       // 因为反向迭代器的current成员变量是指向对应正向迭代器的，
       // 所以直接计算两个正向迭代器之间的距离即可。
-      return this->current - rhs.current;
+      return rhs.current - this->current;
     }
     // 前进与后退方向完全逆转
     // TAG: 这里的const是一个常量成员函数。这意味着函数不会修改类的任何成员变量，也就是说，它不会改变对象的状态
@@ -455,7 +478,7 @@ namespace zfwstl
     }
     self operator-=(difference_type n)
     {
-      current -= n;
+      current += n;
       return *this;
     }
     //(*this + n)回调哦那个本类的operator*和operator+; 最外面的*不会
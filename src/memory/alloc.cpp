@@ -1,22 +1,4 @@
 #include "alloc.h"
-// 静态成员变量初始化
-char *zfwstl::__default_alloc_template::start_free = nullptr;
-char *zfwstl::__default_alloc_template::end_free = nullptr;
-size_t zfwstl::__default_alloc_template::heap_size = 0;
-zfwstl::FreeList *zfwstl::__default_alloc_template::free_list[__FREELISTNUM] = {
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr,
-    nullptr};
\ No newline at end of file
+// 静态成员变量已随模板定义在 alloc.h 中，此处仅显式实例化两种二级配置器
+template class zfwstl::__default_alloc_template<false, 0>;
+template class zfwstl::__default_alloc_template<true, 0>;
@@ -1,29 +1,26 @@
 #ifndef ZFWSTL_ALLOC_H_
 #define ZFWSTL_ALLOC_H_
 /**
-<<<<<<< HEAD
  * 从 v2.0.0 版本开始，将不再使用内存池，这个文件将被弃用，但暂时保留
  * 推荐使用 <stdlib.h>（C）或 <cstdlib>（C++）来替代 alloc.h 头文件
  *
  * 特殊的空间配置器：内存空间的配置与释放
  * 配备:
- * 一级配置器_malloc_alloc_template
- * 二级配置器__default_alloc_template 内存池，自由链表free_list
-=======
- * 内存空间的配置与释放
- * 配备:
- * 一级配置器_malloc_alloc_template
- * 二级配置器__default_alloc_template
->>>>>>> 032d1b48e96f41c8c40afbe26cf6db12f00cbeaf
+ * 一级配置器_malloc_alloc_template(即 __malloc_alloc_template<0>)
+ * 二级配置器__default_alloc_template<threads, inst> 内存池，自由链表free_list
+ *   threads = false: 单线程版本，所有线程共用一组静态 free_list，不加锁
+ *   threads = true : 线程缓存版本(仿 tcmalloc)，每个线程持有自己的 free_list，
+ *                    多余区块按批(batch)归还给加锁的中心池(central free list)
  */
 #include <cstddef> // for size_t, ptrdiff_t, nullptr_t
 #include <cstdlib> // for malloc(), free(), realloc(), abort
 #include <new>     // for std::bad_alloc
 #include <iostream>
 #include <cstring> // for memcpy
+#include <mutex>   // for std::mutex, std::lock_guard
 namespace zfwstl
 {
-  void global_oom_handler()
+  inline void global_oom_handler()
   {
     std::cerr << "Out of Memory! Taking emergency actions..." << std::endl;
     // 这里可以添加一些紧急处理措施，比如尝试释放缓存，或者减少内存使用等
@@ -31,7 +28,9 @@ namespace zfwstl
   }
 
   // 1. 一级配置器
-  class _malloc_alloc_template
+  // inst: 仅用于产生不同的实例，做成模板使静态成员可以定义在头文件中
+  template <int inst>
+  class __malloc_alloc_template
   {
   private:
     //  oom: out of memory
@@ -88,7 +87,10 @@ namespace zfwstl
     }
   };
 
-  void (*_malloc_alloc_template::__malloc_alloc_oom_handler)() = global_oom_handler;
+  template <int inst>
+  void (*__malloc_alloc_template<inst>::__malloc_alloc_oom_handler)() = global_oom_handler;
+  typedef __malloc_alloc_template<0> _malloc_alloc_template;
+  typedef __malloc_alloc_template<0> malloc_alloc;
   // 2. 二级配置器： 为了避免太多小额区块造成的内存碎片
   /**
    * 当内存较小时，以内存池管理，每次配置一大块内存，并维护对应的自由链表
@@ -118,6 +120,8 @@ namespace zfwstl
     __FREELISTNUM = __MAX_BYTES / __ALIGN
   };
 
+  // threads: 是否为多线程版本; inst: 完全没派上用场，仅用于产生不同的实例(各自拥有独立的内存池)
+  template <bool threads, int inst>
   class __default_alloc_template
   {
   private:
@@ -305,6 +309,296 @@ namespace zfwstl
       return (result);
     }
   };
+  // 静态成员变量初始化
+  template <bool threads, int inst>
+  char *__default_alloc_template<threads, inst>::start_free = nullptr;
+  template <bool threads, int inst>
+  char *__default_alloc_template<threads, inst>::end_free = nullptr;
+  template <bool threads, int inst>
+  size_t __default_alloc_template<threads, inst>::heap_size = 0;
+  template <bool threads, int inst>
+  FreeList *__default_alloc_template<threads, inst>::free_list[__FREELISTNUM] = {nullptr};
+
+  // 3. 二级配置器的线程缓存版本(thread-caching, 仿 tcmalloc)
+  /**
+   * 单线程版本的 free_list 与内存池都是普通静态变量，多线程下只能在外部加一把全局锁
+   * 线程缓存版本分为两层:
+   * ThreadCache: 每个线程私有的 16 个自由链表，allocate/deallocate 的快速路径不加锁
+   * CentralList: 所有线程共享的中心自由链表，每个大小类别各一把锁
+   * 线程缓存为空时，一次从中心池批量取 __BATCH_SIZE 个区块;
+   * 线程缓存过长(超过 __CACHE_LIMIT)时，一次批量归还 __BATCH_SIZE 个区块;
+   * 线程退出时，其缓存中的全部区块归还中心池，可被其他线程复用
+   * 中心池也为空时，才从加锁的内存池(chunk)中切出新区块
+   */
+  template <int inst>
+  class __default_alloc_template<true, inst>
+  {
+  private:
+    enum // 线程缓存与中心池之间一次搬运的区块数
+    {
+      __BATCH_SIZE = 32
+    };
+    enum // 线程缓存中单个自由链表允许保留的最大区块数
+    {
+      __CACHE_LIMIT = __BATCH_SIZE * 2
+    };
+
+    // 每个线程私有的自由链表
+    struct ThreadCache
+    {
+      FreeList *free_list[__FREELISTNUM];
+      size_t length[__FREELISTNUM]; // 各自由链表当前长度
+
+      ThreadCache()
+      {
+        for (size_t i = 0; i < __FREELISTNUM; ++i)
+        {
+          free_list[i] = nullptr;
+          length[i] = 0;
+        }
+      }
+      // 线程退出: 把缓存的区块全部还给中心池
+      ~ThreadCache()
+      {
+        for (size_t i = 0; i < __FREELISTNUM; ++i)
+        {
+          if (length[i] > 0)
+            release_to_central(*this, i, length[i]);
+        }
+      }
+    };
+
+    // 所有线程共享的中心自由链表
+    struct CentralList
+    {
+      std::mutex lock;
+      FreeList *head = nullptr;
+      size_t count = 0;
+    };
+
+    static CentralList central[__FREELISTNUM]; // 16个中心自由链表
+
+    // 内存池 memory pool，由 pool_lock 保护
+    static std::mutex pool_lock;
+    static char *start_free;
+    static char *end_free;
+    static size_t heap_size;
+
+  private:
+    static size_t ROUND_UP(size_t bytes)
+    {
+      return (((bytes) + __ALIGN - 1) & ~(__ALIGN - 1));
+    }
+    static size_t FREELIST_INDEX(size_t bytes)
+    {
+      return (((bytes) + __ALIGN - 1) / __ALIGN - 1);
+    }
+    // 当前线程的缓存，线程首次使用时构造，线程退出时析构
+    static ThreadCache &thread_cache()
+    {
+      static thread_local ThreadCache cache;
+      return cache;
+    }
+
+    // 从线程缓存头部摘下 nobj 个区块，整批挂到中心自由链表上
+    static void release_to_central(ThreadCache &tc, size_t index, size_t nobj)
+    {
+      FreeList *first = tc.free_list[index];
+      FreeList *last = first;
+      for (size_t i = 1; i < nobj; ++i) // 在锁外找到这一批的尾节点
+        last = last->next;
+      tc.free_list[index] = last->next;
+      tc.length[index] -= nobj;
+
+      CentralList &c = central[index];
+      std::lock_guard<std::mutex> guard(c.lock);
+      last->next = c.head;
+      c.head = first;
+      c.count += nobj;
+    }
+
+    // 线程缓存为空: 先从中心自由链表取一批，中心为空再从内存池切一批
+    // 返回一个区块给调用者，其余放入线程缓存
+    static void *fetch_from_central(ThreadCache &tc, size_t index, size_t n)
+    {
+      FreeList *first = nullptr;
+      size_t nobj = 0;
+      {
+        CentralList &c = central[index];
+        std::lock_guard<std::mutex> guard(c.lock);
+        if (c.count > 0)
+        {
+          nobj = c.count < static_cast<size_t>(__BATCH_SIZE) ? c.count : static_cast<size_t>(__BATCH_SIZE);
+          first = c.head;
+          FreeList *last = first;
+          for (size_t i = 1; i < nobj; ++i)
+            last = last->next;
+          c.head = last->next;
+          c.count -= nobj;
+          last->next = nullptr;
+        }
+      }
+      if (first != nullptr)
+      {
+        tc.free_list[index] = first->next;
+        tc.length[index] = nobj - 1;
+        return first;
+      }
+      return refill(tc, n);
+    }
+
+    // 从内存池取 __BATCH_SIZE 个大小为 n 的区块，第一个返回给调用者，其余串成线程缓存
+    static void *refill(ThreadCache &tc, size_t n)
+    {
+      size_t nobj = __BATCH_SIZE;
+      char *chunk;
+      {
+        std::lock_guard<std::mutex> guard(pool_lock);
+        chunk = chunk_alloc(n, nobj);
+      }
+      if (1 == nobj)
+        return chunk;
+      FreeList *cur = (FreeList *)(chunk + n);
+      tc.free_list[FREELIST_INDEX(n)] = cur;
+      tc.length[FREELIST_INDEX(n)] = nobj - 1;
+      for (size_t i = 2; i < nobj; ++i)
+      {
+        cur->next = (FreeList *)((char *)cur + n);
+        cur = cur->next;
+      }
+      cur->next = nullptr;
+      return chunk;
+    }
+
+    // 与单线程版本相同，调用者须持有 pool_lock
+    static char *chunk_alloc(size_t size, size_t &nobj)
+    {
+      char *result;
+      size_t need_bytes = size * nobj;
+      size_t pool_bytes = end_free - start_free;
+
+      if (pool_bytes >= need_bytes)
+      {
+        result = start_free;
+        start_free += need_bytes;
+        return result;
+      }
+      else if (pool_bytes >= size)
+      {
+        nobj = pool_bytes / size;
+        need_bytes = size * nobj;
+        result = start_free;
+        start_free += need_bytes;
+        return result;
+      }
+      else
+      {
+        // 内存池的残余零头交给对应的中心自由链表
+        if (pool_bytes > 0)
+        {
+          CentralList &c = central[FREELIST_INDEX(pool_bytes)];
+          std::lock_guard<std::mutex> guard(c.lock);
+          ((FreeList *)start_free)->next = c.head;
+          c.head = (FreeList *)start_free;
+          ++c.count;
+        }
+        size_t bytes_to_get = (need_bytes << 1) + ROUND_UP(heap_size >> 4);
+        start_free = (char *)std::malloc(bytes_to_get);
+        if (!start_free)
+        { // heap 空间不够，到中心自由链表中找足够大的空闲区块填内存池
+          for (size_t i = size; i <= __MAX_BYTES; i += __ALIGN)
+          {
+            CentralList &c = central[FREELIST_INDEX(i)];
+            std::unique_lock<std::mutex> guard(c.lock);
+            FreeList *p = c.head;
+            if (p)
+            {
+              c.head = p->next;
+              --c.count;
+              guard.unlock();
+              start_free = (char *)p;
+              end_free = start_free + i;
+              return chunk_alloc(size, nobj);
+            }
+          }
+          end_free = nullptr;
+          throw std::bad_alloc();
+        }
+        end_free = start_free + bytes_to_get;
+        heap_size += bytes_to_get;
+        return chunk_alloc(size, nobj);
+      }
+    }
+
+  public:
+    // 分配大小为 n 的空间， n > 0
+    static inline void *allocate(size_t n)
+    {
+      if (n > static_cast<size_t>(__MAX_BYTES))
+        return _malloc_alloc_template::allocate(n);
+      ThreadCache &tc = thread_cache();
+      const size_t index = FREELIST_INDEX(n);
+      FreeList *result = tc.free_list[index];
+      if (result == nullptr)
+        return fetch_from_central(tc, index, ROUND_UP(n));
+      tc.free_list[index] = result->next;
+      --tc.length[index];
+      return result;
+    }
+    // 释放 _p 指向的大小为 n 的空间, _p 不能为 0
+    // 区块可以由任意线程释放，它会进入释放者的线程缓存
+    static inline void deallocate(void *_p, size_t n)
+    {
+      if (n > static_cast<size_t>(__MAX_BYTES))
+      {
+        std::free(_p);
+        return;
+      }
+      ThreadCache &tc = thread_cache();
+      const size_t index = FREELIST_INDEX(n);
+      FreeList *q = reinterpret_cast<FreeList *>(_p);
+      q->next = tc.free_list[index];
+      tc.free_list[index] = q;
+      if (++tc.length[index] > static_cast<size_t>(__CACHE_LIMIT))
+        release_to_central(tc, index, __BATCH_SIZE);
+    }
+    static void *reallocate(void *_p, size_t old_size, size_t new_size)
+    {
+      if (old_size > (size_t)__MAX_BYTES && new_size > (size_t)__MAX_BYTES)
+        return (std::realloc(_p, new_size));
+      if (ROUND_UP(old_size) == ROUND_UP(new_size))
+        return (_p);
+      void *result = allocate(new_size);
+      size_t copy_size = new_size > old_size ? old_size : new_size;
+      std::memcpy(result, _p, copy_size);
+      deallocate(_p, old_size);
+      return (result);
+    }
+  };
+  // 静态成员变量初始化
+  template <int inst>
+  typename __default_alloc_template<true, inst>::CentralList
+      __default_alloc_template<true, inst>::central[__FREELISTNUM];
+  template <int inst>
+  std::mutex __default_alloc_template<true, inst>::pool_lock;
+  template <int inst>
+  char *__default_alloc_template<true, inst>::start_free = nullptr;
+  template <int inst>
+  char *__default_alloc_template<true, inst>::end_free = nullptr;
+  template <int inst>
+  size_t __default_alloc_template<true, inst>::heap_size = 0;
+
+  // 常用的两种二级配置器
+  typedef __default_alloc_template<false, 0> single_client_alloc; // 单线程内存池
+  typedef __default_alloc_template<true, 0> multithreaded_alloc;  // 线程缓存内存池
+
+  // 节点型容器(list, slist, rb_tree, hashtable)默认使用的配置器
+  // 默认为线程缓存版本，不同线程各自使用自己的容器时无需外部加锁
+  // 确定只在单线程中使用时，可定义 ZFWSTL_NODE_ALLOCATOR_THREADS 为 false 换用单线程内存池
+#ifndef ZFWSTL_NODE_ALLOCATOR_THREADS
+#define ZFWSTL_NODE_ALLOCATOR_THREADS true
+#endif
+  typedef __default_alloc_template<ZFWSTL_NODE_ALLOCATOR_THREADS, 0> alloc;
 }
 
 #endif // !ZFWSTLSTL_ALLOC_H_
\ No newline at end of file
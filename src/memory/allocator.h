@@ -2,13 +2,47 @@
 #define ZFWSTL_ALLOCATOR_H_
 /**
  * 标准的空间配置器
+ * new_alloc: 以 ::operator new / ::operator delete 配置原始内存，接口与 alloc.h 中的配置器一致
+ * simple_allocator<T, Alloc>: 以元素为单位包装原始配置器 Alloc(仿 SGI simple_alloc)，并负责对象的构造、析构
+ *   Alloc 可以是 new_alloc，也可以是 alloc.h 中的内存池 alloc / single_client_alloc / multithreaded_alloc
+ *   Alloc::deallocate 需要区块大小，因此释放时传入的 n 必须与配置时相同
+ *   reallocate: Alloc 提供 reallocate(p, old_sz, new_sz) 时(alloc.h 中的配置器)直接转调，可能原地扩大；
+ *     否则配置新空间并 memcpy，只能用于可平凡搬移(is_trivially_relocatable)的元素
  */
 #include <cstddef>     //for size_t, ptrdiff_t
-#include "construct.h" // for zfwstl::construct, zfwstl::destroy
-#include "../util.h"   // forward, move
+#include <new>              //for ::operator new
+#include <cstring>          //for memcpy
+#include <type_traits>      //for true_type, false_type
+#include "construct.h"      // for zfwstl::construct, zfwstl::destroy
+#include "../util.h"        // forward, move
+#include "../type_traits.h" // for __make_void
 namespace zfwstl
 {
-  template <class T>
+  // has_reallocate 检查原始配置器是否提供 reallocate(p, old_sz, new_sz)
+  template <class Alloc, class = void>
+  struct has_reallocate : std::false_type
+  {
+  };
+  template <class Alloc>
+  struct has_reallocate<Alloc, typename __make_void<decltype(Alloc::reallocate((void *)0, size_t(0), size_t(0)))>::type>
+      : std::true_type
+  {
+  };
+
+  class new_alloc
+  {
+  public:
+    static void *allocate(size_t n)
+    {
+      return ::operator new(n);
+    }
+    static void deallocate(void *ptr, size_t /* n */)
+    {
+      ::operator delete(ptr);
+    }
+  };
+
+  template <class T, class Alloc = new_alloc>
   class simple_allocator
   {
   public:
@@ -25,26 +59,33 @@ namespace zfwstl
     static T *allocate()
     {
       // TAG: static_cast类型转换，将::operator new返回的void*指针转换为T*类型的指针
-      return static_cast<T *>(::operator new(sizeof(T)));
+      return static_cast<T *>(Alloc::allocate(sizeof(T)));
     }
     static T *allocate(size_type n)
     {
       if (0 == n)
         return nullptr;
-      return static_cast<T *>(::operator new(n * sizeof(T)));
+      return static_cast<T *>(Alloc::allocate(n * sizeof(T)));
     }
 
     static void deallocate(T *ptr)
     {
       if (ptr == nullptr)
         return;
-      ::operator delete(ptr);
+      Alloc::deallocate(ptr, sizeof(T));
     }
-    static void deallocate(T *ptr, size_type /* n */)
+    static void deallocate(T *ptr, size_type n)
     {
       if (ptr == nullptr)
         return;
-      ::operator delete(ptr);
+      Alloc::deallocate(ptr, n * sizeof(T));
+    }
+    // 把 ptr 处的 old_n 个元素整块搬到能容纳 new_n 个元素的空间，不调用构造、析构函数
+    static T *reallocate(T *ptr, size_type old_n, size_type new_n)
+    {
+      if (ptr == nullptr)
+        return allocate(new_n);
+      return reallocate_aux(ptr, old_n, new_n, has_reallocate<Alloc>{});
     }
     // 对象内容的构造、析构
     static void construct(T *ptr)
@@ -74,6 +115,19 @@ namespace zfwstl
     {
       zfwstl::destroy(first, last);
     }
+
+  private:
+    static T *reallocate_aux(T *ptr, size_type old_n, size_type new_n, std::true_type)
+    {
+      return static_cast<T *>(Alloc::reallocate(ptr, old_n * sizeof(T), new_n * sizeof(T)));
+    }
+    static T *reallocate_aux(T *ptr, size_type old_n, size_type new_n, std::false_type)
+    {
+      T *result = allocate(new_n);
+      std::memcpy(static_cast<void *>(result), static_cast<const void *>(ptr), (old_n < new_n ? old_n : new_n) * sizeof(T));
+      deallocate(ptr, old_n);
+      return result;
+    }
   };
 }
 
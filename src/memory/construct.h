@@ -56,6 +56,14 @@ namespace zfwstl
       _p->~T1(); // 调用dtor ~T()
   }
 
+  template <class T>
+  void destroy(T *_p)
+  { // NOTE: std::is_trivially_destructible<T>{}相当于创建了一个模板结构的实例
+    // TAG: destroy_one(_p, std::is_trivially_destructible<T>{});
+    // TODO: 我想尝试不创建实例，而是直接调用其value静态成员返回布尔值
+    destroy_one(_p, std::is_trivially_destructible<T>{});
+  }
+
   // 版本二：接受两个迭代器，析构掉[first, last)范围内对象
   template <class ForwardIter>
   inline void destroy_cat(ForwardIter _first, ForwardIter _last, std::true_type) {}
@@ -67,14 +75,6 @@ namespace zfwstl
       destroy(&*_first);
   }
 
-  template <class T>
-  void destroy(T *_p)
-  { // NOTE: std::is_trivially_destructible<T>{}相当于创建了一个模板结构的实例
-    // TAG: destroy_one(_p, std::is_trivially_destructible<T>{});
-    // TODO: 我想尝试不创建实例，而是直接调用其value静态成员返回布尔值
-    destroy_one(_p, std::is_trivially_destructible<T>{});
-  }
-
   template <class ForwardIter>
   void destroy(ForwardIter _first, ForwardIter _last)
   {
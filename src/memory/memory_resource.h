@@ -0,0 +1,433 @@
+#ifndef ZFWSTL_MEMORY_RESOURCE_H_
+#define ZFWSTL_MEMORY_RESOURCE_H_
+/**
+ * 多态内存资源(polymorphic memory resource)
+ * memory_resource              : 抽象基类，虚函数 do_allocate / do_deallocate / do_is_equal
+ * new_delete_resource()        : 以 ::operator new / ::operator delete 实现的全局资源
+ * monotonic_buffer_resource    : 单调缓冲资源，只分配不回收，release() 或析构时一次性归还全部内存
+ * unsynchronized_pool_resource : 非同步池资源，按 2 的幂划分大小类别，各自维护自由链表，不加锁
+ *
+ * 容器通过原始配置器 resource_alloc 使用内存资源:
+ *   zfwstl::monotonic_buffer_resource arena;
+ *   {
+ *     zfwstl::scoped_resource guard(&arena); // 本线程此后的 resource_alloc 配置都来自 arena
+ *     zfwstl::vector<int, zfwstl::resource_alloc> v;
+ *     zfwstl::map<int, int, zfwstl::less<int>, zfwstl::resource_alloc> m;
+ *     ...
+ *   }
+ *   arena.release(); // 一次归还本次请求的全部内存
+ * 容器的配置器是无状态的静态类，因此当前资源保存在线程局部变量中，由 scoped_resource 设定;
+ * 每个区块前放置一个头部记录其所属资源，释放时总能回到正确的资源，与当时的 scoped_resource 无关
+ */
+#include <cstddef> // for size_t, max_align_t
+#include <new>     // for ::operator new, std::bad_alloc
+#include <cstdint> // for uintptr_t
+
+namespace zfwstl
+{
+  // ===========================memory_resource===========================
+  class memory_resource
+  {
+  public:
+    static const size_t max_align = alignof(std::max_align_t);
+
+    virtual ~memory_resource() {}
+
+    void *allocate(size_t bytes, size_t alignment = max_align)
+    {
+      return do_allocate(bytes, alignment);
+    }
+    void deallocate(void *p, size_t bytes, size_t alignment = max_align)
+    {
+      do_deallocate(p, bytes, alignment);
+    }
+    bool is_equal(const memory_resource &other) const noexcept
+    {
+      return do_is_equal(other);
+    }
+
+  private:
+    virtual void *do_allocate(size_t bytes, size_t alignment) = 0;
+    virtual void do_deallocate(void *p, size_t bytes, size_t alignment) = 0;
+    virtual bool do_is_equal(const memory_resource &other) const noexcept = 0;
+  };
+
+  inline bool operator==(const memory_resource &a, const memory_resource &b) noexcept
+  {
+    return &a == &b || a.is_equal(b);
+  }
+  inline bool operator!=(const memory_resource &a, const memory_resource &b) noexcept
+  {
+    return !(a == b);
+  }
+
+  // 将 p 上调至 alignment(2 的幂) 的倍数
+  inline char *__align_up(char *p, size_t alignment)
+  {
+    return reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(p) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+  }
+
+  // ===========================new_delete_resource===========================
+  class __new_delete_resource : public memory_resource
+  {
+  private:
+    void *do_allocate(size_t bytes, size_t /* alignment */) override
+    {
+      return ::operator new(bytes); // ::operator new 保证 max_align 对齐
+    }
+    void do_deallocate(void *p, size_t /* bytes */, size_t /* alignment */) override
+    {
+      ::operator delete(p);
+    }
+    bool do_is_equal(const memory_resource &other) const noexcept override
+    {
+      return this == &other;
+    }
+  };
+
+  inline memory_resource *new_delete_resource() noexcept
+  {
+    static __new_delete_resource instance;
+    return &instance;
+  }
+
+  // ===========================monotonic_buffer_resource===========================
+  // 从当前块中顺序切分内存，不足时向上游申请一块更大的新块(几何增长)
+  // deallocate 什么也不做，release() 时把向上游申请的块全部归还，并回到初始缓冲区
+  class monotonic_buffer_resource : public memory_resource
+  {
+  private:
+    struct chunk // 每个上游块的头部，串成单链表
+    {
+      chunk *next;
+      size_t size;
+    };
+    enum
+    {
+      __INITIAL_SIZE = 1024
+    };
+    enum
+    {
+      __CHUNK_HEADER = (sizeof(chunk) + memory_resource::max_align - 1) & ~(memory_resource::max_align - 1)
+    };
+
+    memory_resource *upstream;
+    char *initial_buffer; // 用户提供的初始缓冲区，可为空
+    size_t initial_size;
+    char *cur;         // 当前块中下一个可用位置
+    char *end;         // 当前块结尾
+    size_t next_size;  // 下一次向上游申请的大小
+    size_t first_size; // release() 后 next_size 恢复为该值，避免反复使用时块越来越大
+    chunk *chunks;     // 向上游申请的所有块
+
+  public:
+    explicit monotonic_buffer_resource(memory_resource *up = new_delete_resource())
+        : upstream(up), initial_buffer(nullptr), initial_size(0),
+          cur(nullptr), end(nullptr), next_size(__INITIAL_SIZE), first_size(__INITIAL_SIZE), chunks(nullptr) {}
+    explicit monotonic_buffer_resource(size_t initial, memory_resource *up = new_delete_resource())
+        : upstream(up), initial_buffer(nullptr), initial_size(0),
+          cur(nullptr), end(nullptr), next_size(initial > 0 ? initial : 1), first_size(next_size), chunks(nullptr) {}
+    monotonic_buffer_resource(void *buffer, size_t size, memory_resource *up = new_delete_resource())
+        : upstream(up), initial_buffer(static_cast<char *>(buffer)), initial_size(size),
+          cur(static_cast<char *>(buffer)), end(static_cast<char *>(buffer) + size),
+          next_size(size > 0 ? size * 2 : static_cast<size_t>(__INITIAL_SIZE)), first_size(next_size), chunks(nullptr) {}
+    monotonic_buffer_resource(const monotonic_buffer_resource &) = delete;
+    monotonic_buffer_resource &operator=(const monotonic_buffer_resource &) = delete;
+    ~monotonic_buffer_resource() { release(); }
+
+    // 归还全部上游块，回到初始缓冲区，之前分配的内存全部失效
+    void release()
+    {
+      while (chunks)
+      {
+        chunk *next = chunks->next;
+        upstream->deallocate(chunks, chunks->size);
+        chunks = next;
+      }
+      cur = initial_buffer;
+      end = initial_buffer + initial_size;
+      next_size = first_size;
+    }
+    memory_resource *upstream_resource() const { return upstream; }
+
+  private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+      // 新块至少要放下 bytes + alignment 和块头部，这个和不能溢出
+      if (bytes > static_cast<size_t>(-1) - alignment - __CHUNK_HEADER)
+        throw std::bad_alloc();
+      char *p = __align_up(cur, alignment);
+      // 用剩余字节数比较，不构造可能越界的 p + bytes
+      if (cur == nullptr || p > end || bytes > static_cast<size_t>(end - p))
+      {
+        new_chunk(bytes + alignment);
+        p = __align_up(cur, alignment);
+      }
+      cur = p + bytes;
+      return p;
+    }
+    void do_deallocate(void *, size_t, size_t) override {} // 单调资源不回收单个区块
+    bool do_is_equal(const memory_resource &other) const noexcept override
+    {
+      return this == &other;
+    }
+
+    void new_chunk(size_t min_bytes)
+    {
+      size_t size = next_size;
+      while (size < min_bytes + __CHUNK_HEADER)
+      {
+        if (size > static_cast<size_t>(-1) / 2) // 再翻倍会溢出，直接按所需大小申请
+        {
+          size = min_bytes + __CHUNK_HEADER;
+          break;
+        }
+        size *= 2;
+      }
+      chunk *c = static_cast<chunk *>(upstream->allocate(size));
+      c->next = chunks;
+      c->size = size;
+      chunks = c;
+      cur = reinterpret_cast<char *>(c) + __CHUNK_HEADER;
+      end = reinterpret_cast<char *>(c) + size;
+      next_size = size > static_cast<size_t>(-1) / 2 ? size : size * 2;
+    }
+  };
+
+  // ===========================unsynchronized_pool_resource===========================
+  // 大小类别为 8, 16, 32, ..., 4096 bytes，每个类别一条自由链表
+  // 区块从向上游申请的块中切出，每次申请的区块数从 16 起倍增，最多 1024 个
+  // 超过 4096 bytes 或对齐要求超过 max_align 的请求直接交给上游，并串入双向链表以便 release() 时归还
+  class unsynchronized_pool_resource : public memory_resource
+  {
+  private:
+    enum
+    {
+      __MIN_SHIFT = 3, // 最小区块 8 bytes
+      __NUM_POOLS = 10 // 8 ~ 4096 bytes
+    };
+    enum
+    {
+      __MAX_POOL_BLOCK = size_t(1) << (__MIN_SHIFT + __NUM_POOLS - 1)
+    };
+    struct free_block
+    {
+      free_block *next;
+    };
+    struct chunk
+    {
+      chunk *next;
+      size_t size;
+    };
+    struct large_block // 大区块头部
+    {
+      large_block *prev;
+      large_block *next;
+      size_t size;
+    };
+    enum
+    {
+      __HEADER = (sizeof(large_block) + memory_resource::max_align - 1) & ~(memory_resource::max_align - 1)
+    };
+    struct pool
+    {
+      free_block *free_list;
+      size_t blocks_per_chunk;
+    };
+
+    memory_resource *upstream;
+    pool pools[__NUM_POOLS];
+    chunk *chunks;
+    large_block *large; // 大区块链表头
+
+  public:
+    explicit unsynchronized_pool_resource(memory_resource *up = new_delete_resource())
+        : upstream(up), chunks(nullptr), large(nullptr)
+    {
+      for (size_t i = 0; i < __NUM_POOLS; ++i)
+      {
+        pools[i].free_list = nullptr;
+        pools[i].blocks_per_chunk = 16;
+      }
+    }
+    unsynchronized_pool_resource(const unsynchronized_pool_resource &) = delete;
+    unsynchronized_pool_resource &operator=(const unsynchronized_pool_resource &) = delete;
+    ~unsynchronized_pool_resource() { release(); }
+
+    // 归还全部内存，包括尚未 deallocate 的区块
+    void release()
+    {
+      while (chunks)
+      {
+        chunk *next = chunks->next;
+        upstream->deallocate(chunks, chunks->size);
+        chunks = next;
+      }
+      while (large)
+      {
+        large_block *next = large->next;
+        upstream->deallocate(large, large->size);
+        large = next;
+      }
+      for (size_t i = 0; i < __NUM_POOLS; ++i)
+      {
+        pools[i].free_list = nullptr;
+        pools[i].blocks_per_chunk = 16;
+      }
+    }
+    memory_resource *upstream_resource() const { return upstream; }
+
+  private:
+    // bytes 所属的大小类别
+    static size_t pool_index(size_t bytes)
+    {
+      size_t index = 0;
+      size_t block = size_t(1) << __MIN_SHIFT;
+      while (block < bytes)
+      {
+        block <<= 1;
+        ++index;
+      }
+      return index;
+    }
+    static size_t block_size(size_t index) { return size_t(1) << (__MIN_SHIFT + index); }
+
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+      if (bytes > __MAX_POOL_BLOCK || alignment > max_align)
+        return allocate_large(bytes, alignment);
+      const size_t index = pool_index(bytes < alignment ? alignment : bytes); // 区块大小是 2 的幂，不小于 alignment 即按其对齐
+      pool &pl = pools[index];
+      if (pl.free_list == nullptr)
+        refill(index);
+      free_block *result = pl.free_list;
+      pl.free_list = result->next;
+      return result;
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+      if (bytes > __MAX_POOL_BLOCK || alignment > max_align)
+      {
+        deallocate_large(p);
+        return;
+      }
+      pool &pl = pools[pool_index(bytes < alignment ? alignment : bytes)];
+      free_block *q = static_cast<free_block *>(p);
+      q->next = pl.free_list;
+      pl.free_list = q;
+    }
+    bool do_is_equal(const memory_resource &other) const noexcept override
+    {
+      return this == &other;
+    }
+
+    // 向上游申请一块，切分成 blocks_per_chunk 个区块串入自由链表
+    void refill(size_t index)
+    {
+      pool &pl = pools[index];
+      const size_t bsize = block_size(index);
+      const size_t nblock = pl.blocks_per_chunk;
+      const size_t header = (sizeof(chunk) + max_align - 1) & ~(max_align - 1);
+      const size_t size = header + bsize * nblock;
+      chunk *c = static_cast<chunk *>(upstream->allocate(size));
+      c->next = chunks;
+      c->size = size;
+      chunks = c;
+      char *first = reinterpret_cast<char *>(c) + header;
+      for (size_t i = 0; i < nblock; ++i)
+      {
+        free_block *b = reinterpret_cast<free_block *>(first + i * bsize);
+        b->next = i + 1 < nblock ? reinterpret_cast<free_block *>(first + (i + 1) * bsize) : nullptr;
+      }
+      pl.free_list = reinterpret_cast<free_block *>(first);
+      if (pl.blocks_per_chunk < 1024)
+        pl.blocks_per_chunk *= 2;
+    }
+
+    void *allocate_large(size_t bytes, size_t alignment)
+    {
+      const size_t offset = alignment > __HEADER ? alignment : static_cast<size_t>(__HEADER);
+      const size_t size = bytes + offset + (alignment > max_align ? alignment : 0);
+      char *raw = static_cast<char *>(upstream->allocate(size));
+      char *p = __align_up(raw + offset, alignment);
+      // 大区块头部固定放在 raw 处，p 之前再记下 raw 以便释放时找回
+      large_block *b = reinterpret_cast<large_block *>(raw);
+      b->prev = nullptr;
+      b->next = large;
+      b->size = size;
+      if (large)
+        large->prev = b;
+      large = b;
+      reinterpret_cast<large_block **>(p)[-1] = b;
+      return p;
+    }
+    void deallocate_large(void *p)
+    {
+      large_block *b = static_cast<large_block **>(p)[-1];
+      if (b->prev)
+        b->prev->next = b->next;
+      else
+        large = b->next;
+      if (b->next)
+        b->next->prev = b->prev;
+      upstream->deallocate(b, b->size);
+    }
+  };
+
+  // ===========================当前资源与 resource_alloc===========================
+  // 本线程当前使用的内存资源，默认为 new_delete_resource()
+  inline memory_resource *&__current_resource()
+  {
+    static thread_local memory_resource *current = new_delete_resource();
+    return current;
+  }
+  inline memory_resource *get_default_resource() noexcept { return __current_resource(); }
+  // 设置本线程的当前资源，返回原先的资源; r 为空时恢复为 new_delete_resource()
+  inline memory_resource *set_default_resource(memory_resource *r) noexcept
+  {
+    memory_resource *old = __current_resource();
+    __current_resource() = r ? r : new_delete_resource();
+    return old;
+  }
+
+  // RAII: 在作用域内把本线程的当前资源设为 r，离开作用域时恢复
+  class scoped_resource
+  {
+  private:
+    memory_resource *old;
+
+  public:
+    explicit scoped_resource(memory_resource *r) : old(set_default_resource(r)) {}
+    ~scoped_resource() { set_default_resource(old); }
+    scoped_resource(const scoped_resource &) = delete;
+    scoped_resource &operator=(const scoped_resource &) = delete;
+  };
+
+  // 原始配置器，接口与 alloc.h / new_alloc 一致，可作为容器的 Alloc 参数
+  // 每个区块前有 max_align 大小的头部，记录该区块来自哪个资源
+  class resource_alloc
+  {
+  private:
+    enum
+    {
+      __HEADER = memory_resource::max_align
+    };
+
+  public:
+    static void *allocate(size_t n)
+    {
+      memory_resource *r = get_default_resource();
+      char *p = static_cast<char *>(r->allocate(n + __HEADER));
+      *reinterpret_cast<memory_resource **>(p) = r;
+      return p + __HEADER;
+    }
+    static void deallocate(void *ptr, size_t n)
+    {
+      char *p = static_cast<char *>(ptr) - __HEADER;
+      memory_resource *r = *reinterpret_cast<memory_resource **>(p);
+      r->deallocate(p, n + __HEADER);
+    }
+  };
+}
+
+#endif // !ZFWSTL_MEMORY_RESOURCE_H_
@@ -25,15 +25,14 @@ namespace zfwstl
     {
       for (; first != last; ++first, ++cur)
       {
-        // TODO：zfwstl::construct(&*cur, *first); 改成直接放入地址试一下
-        zfwstl::construct(cur, *first);
+        zfwstl::construct(&*cur, *first); // 取地址，cur 可以是 deque 等容器的迭代器
       }
     }
     catch (...)
     {
-      // TODO：zfwstl::destroy(&*cur); 改成直接放入地址试一下
-      for (; result != cur; --cur)
-        zfwstl::destroy(cur);
+      // commit or rollback：析构已构造的元素后重新抛出
+      zfwstl::destroy(result, cur);
+      throw;
     }
     return cur;
   }
@@ -75,6 +74,7 @@ namespace zfwstl
     {
       for (; first != cur; ++first)
         zfwstl::destroy(&*first);
+      throw;
     }
   }
 
@@ -98,11 +98,18 @@ namespace zfwstl
   inline ForwardIter __uninitialized_fill_n(ForwardIter first, Size n, const T &value, std::false_type)
   {
     auto cur = first;
-    // NOTE: &*cur获取迭代器所指向对象的地址
-    for (; n > 0; --n, ++cur)
+    try
     {
-      // TODO：zfwstl::construct(&*cur, value); 改成直接放入地址试一下
-      zfwstl::construct(cur, value);
+      // NOTE: &*cur获取迭代器所指向对象的地址
+      for (; n > 0; --n, ++cur)
+      {
+        zfwstl::construct(&*cur, value);
+      }
+    }
+    catch (...)
+    {
+      zfwstl::destroy(first, cur);
+      throw;
     }
     return cur;
   }
@@ -141,6 +148,7 @@ namespace zfwstl
     catch (...)
     {
       zfwstl::destroy(result, cur);
+      throw;
     }
     return cur;
   }
@@ -153,5 +161,30 @@ namespace zfwstl
                                              typename iterator_traits<InputIter>::
                                                  value_type>{});
   }
+  //=====================uninitialized_move_if_noexcept=====================
+  // 移动构造不抛异常(或只能移动)时移动，否则复制，保证搬移中途出错时源区间完好
+  template <class InputIter, class ForwardIter>
+  ForwardIter
+  __uninitialized_move_if_noexcept(InputIter first, InputIter last, ForwardIter result, std::true_type)
+  {
+    return zfwstl::uninitialized_move(first, last, result);
+  }
+
+  template <class InputIter, class ForwardIter>
+  ForwardIter
+  __uninitialized_move_if_noexcept(InputIter first, InputIter last, ForwardIter result, std::false_type)
+  {
+    return zfwstl::uninitialized_copy(first, last, result);
+  }
+
+  template <class InputIter, class ForwardIter>
+  ForwardIter uninitialized_move_if_noexcept(InputIter first, InputIter last, ForwardIter result)
+  {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return zfwstl::__uninitialized_move_if_noexcept(
+        first, last, result,
+        std::integral_constant<bool, std::is_nothrow_move_constructible<value_type>::value ||
+                                         !std::is_copy_constructible<value_type>::value>{});
+  }
 }
 #endif // !ZFWSTLSTL_UNINTIALIZED_H_
\ No newline at end of file
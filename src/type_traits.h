@@ -47,6 +47,32 @@ namespace zfwstl
   struct is_pair<zfwstl::pair<T1, T2>> : zfwstl::m_true_type
   {
   }; // 特化
+
+  // has_transparent 检查仿函数是否定义了 is_transparent(透明比较/哈希)
+  // 关联容器据此决定是否开放以任意键型别查找的重载
+  template <class...>
+  struct __make_void
+  {
+    typedef void type;
+  };
+
+  template <class T, class = void>
+  struct has_transparent : zfwstl::m_false_type
+  {
+  };
+
+  template <class T>
+  struct has_transparent<T, typename __make_void<typename T::is_transparent>::type> : zfwstl::m_true_type
+  {
+  };
+
+  // is_trivially_relocatable 元素能否以 memcpy/realloc 整块搬到新地址(搬移后旧对象不再析构)
+  // 缺省只认平凡可复制类型；不保存指向自身指针的类型可以特化为 true，vector 扩容时便直接 realloc
+  // 注意：libstdc++ 的 std::string 短字符串指向对象内部，不能特化
+  template <class T>
+  struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+  {
+  };
 }
 
 #endif // !ZFWSTLSTL_TYPE_TRAITS_H_
\ No newline at end of file
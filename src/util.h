@@ -6,6 +6,12 @@
 // TODO:研究这些的作用
 #include <cstddef> //for size_t
 #include "type_traits.h"
+
+// 缓存行大小，用于分隔不同线程写的变量、避免伪共享(ring_queue.h, concurrent_hash_map.h)
+#ifndef ZFWSTL_CACHE_LINE
+#define ZFWSTL_CACHE_LINE 64
+#endif
+
 namespace zfwstl
 {
   // ==========================move========================
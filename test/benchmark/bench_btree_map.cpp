@@ -0,0 +1,96 @@
+/**
+ * btree_map 与 map(红黑树) 基准测试
+ * 同样 n 个随机 int 键，依次测：逐个插入、随机顺序查找(全部命中)、中序遍历求和，
+ * 以及节点占用的内存(经计数配置器统计，含内存池对齐，不含内存池未分出去的空闲块)
+ * 每次运行只测一种容器：同一进程内先后测试时，后者会复用前者归还给内存池的节点，结果会失真
+ * 编译: g++ -std=c++14 -O2 bench_btree_map.cpp -o bench_btree_map
+ * 运行: ./bench_btree_map [元素个数, 缺省 1000000] [map|btree, 缺省 btree]
+ *      例: for c in map btree; do ./bench_btree_map 1000000 $c; done
+ */
+#include "../../STL_2/map.h"
+#include "../../STL_2/btree_map.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// 统计当前分配出去的字节数；小块按内存池的 8 字节对齐计
+struct counting_alloc
+{
+  static size_t bytes;
+  static void *allocate(size_t n)
+  {
+    bytes += n <= 128 ? (n + 7) & ~size_t(7) : n;
+    return zfwstl::alloc::allocate(n);
+  }
+  static void deallocate(void *p, size_t n)
+  {
+    bytes -= n <= 128 ? (n + 7) & ~size_t(7) : n;
+    zfwstl::alloc::deallocate(p, n);
+  }
+};
+size_t counting_alloc::bytes = 0;
+
+template <class Map>
+void bench(const char *name, const zfwstl::vector<int> &keys, const zfwstl::vector<int> &probe)
+{
+  Map m;
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < keys.size(); ++i)
+    m.insert(typename Map::value_type(keys[i], static_cast<int>(i)));
+  const double insert_ms = ms_since(start);
+
+  start = bench_clock::now();
+  long long hit = 0;
+  for (size_t i = 0; i < probe.size(); ++i)
+    hit += m.find(probe[i])->second;
+  const double find_ms = ms_since(start);
+
+  start = bench_clock::now();
+  long long sum = 0;
+  for (int round = 0; round < 10; ++round)
+    for (auto it = m.begin(); it != m.end(); ++it)
+      sum += it->first;
+  const double iter_ms = ms_since(start) / 10;
+
+  std::printf("%-6s insert %8.1f ms  find %8.1f ms  iterate %6.2f ms  memory %6.1f B/elem  size %zu  (%lld %lld)\n",
+              name, insert_ms, find_ms, iter_ms, static_cast<double>(counting_alloc::bytes) / m.size(), m.size(),
+              hit & 1, sum & 1);
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const char *which = argc > 2 ? argv[2] : "btree";
+  zfwstl::vector<int> keys;
+  keys.reserve(n);
+  uint64_t seed = 1;
+  for (size_t i = 0; i < n; ++i)
+    keys.push_back(static_cast<int>(splitmix64(seed) >> 33));
+  zfwstl::vector<int> probe;
+  probe.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    probe.push_back(keys[splitmix64(seed) % n]);
+
+  if (std::strcmp(which, "map") == 0)
+    bench<zfwstl::map<int, int, zfwstl::less<int>, counting_alloc>>(which, keys, probe);
+  else
+    bench<zfwstl::btree_map<int, int, zfwstl::less<int>, counting_alloc>>(which, keys, probe);
+  return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * 批量插入基准测试
+ * 1. unordered_map<int, int>：逐个 insert 与区间 insert(一次 reserve 到位，不再扩容)
+ * 2. map<int, int>：逐个 insert 与区间 insert，输入分为已排序(O(n) 直接建树)与随机顺序两种
+ * 输入都放在 vector<pair<int, int>> 中，输出总耗时
+ * 每次运行只测一种情形：同一进程内先后测试时，后者会复用前者归还给内存池的节点，结果会失真
+ * 编译: g++ -std=c++14 -O2 bench_bulk_insert.cpp -o bench_bulk_insert
+ * 运行: ./bench_bulk_insert [元素个数] [umap|map-sorted|map-random] [one|range]
+ *      例: for c in umap map-sorted map-random; do for m in one range; do ./bench_bulk_insert 2000000 $c $m; done; done
+ */
+#include "../../STL_2/map.h"
+#include "../../STL_2/unordered_map.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+typedef zfwstl::pair<int, int> value_type;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+template <class Map>
+void bench_one(const char *name, bool range, const zfwstl::vector<value_type> &data)
+{
+  auto start = bench_clock::now();
+  Map m;
+  if (range)
+    m.insert(data.begin(), data.end());
+  else
+    for (size_t i = 0; i < data.size(); ++i)
+      m.insert(data[i]);
+  std::printf("%-12s %-6s %9.1f ms   size %zu\n", name, range ? "range" : "one", ms_since(start), m.size());
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+  const char *which = argc > 2 ? argv[2] : "umap";
+  const bool range = !(argc > 3 && std::strcmp(argv[3], "one") == 0);
+  const bool sorted = std::strcmp(which, "map-sorted") == 0;
+  zfwstl::vector<value_type> data;
+  data.reserve(n);
+  uint64_t seed = 1;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const int key = sorted ? static_cast<int>(i * 3) : static_cast<int>(splitmix64(seed) >> 33);
+    data.push_back(value_type(key, static_cast<int>(i)));
+  }
+
+  if (std::strcmp(which, "umap") == 0)
+    bench_one<zfwstl::unordered_map<int, int>>(which, range, data);
+  else
+    bench_one<zfwstl::map<int, int>>(which, range, data);
+  return 0;
+}
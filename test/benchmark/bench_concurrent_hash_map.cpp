@@ -0,0 +1,130 @@
+/**
+ * 并发哈希表基准测试：concurrent_hash_map 与 shared_timed_mutex + zfwstl::unordered_map 对比
+ * 先插入一半的键，然后每个线程做固定次数的操作：读 find，写中一半 insert_or_assign、一半 erase
+ * 读写比例由参数给出：read 为 95% 读 / 5% 写，write 为 50% 读 / 50% 写
+ * 线程数依次取 1 / 2 / 4 / 8 / 16 / 32 / 64，打印总吞吐
+ * 编译: g++ -std=c++14 -O2 -pthread bench_concurrent_hash_map.cpp -o bench_concurrent_hash_map
+ * 运行: ./bench_concurrent_hash_map [chm|locked, 缺省 chm] [read|write, 缺省 read] [键个数, 缺省 1000000] [每线程操作数, 缺省 1000000]
+ *      例: for m in chm locked; do ./bench_concurrent_hash_map $m read; ./bench_concurrent_hash_map $m write; done
+ */
+#include "../../STL_2/concurrent_hash_map.h"
+#include "../../STL_2/unordered_map.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+typedef std::chrono::steady_clock bench_clock;
+
+// 现有做法：整张 unordered_map 由一把读写锁保护，接口与 concurrent_hash_map 一致
+class locked_map
+{
+  mutable std::shared_timed_mutex lock;
+  zfwstl::unordered_map<uint64_t, uint64_t> m;
+
+public:
+  bool find(uint64_t key, uint64_t &out) const
+  {
+    std::shared_lock<std::shared_timed_mutex> guard(lock);
+    auto it = m.find(key);
+    if (it == m.end())
+      return false;
+    out = it->second;
+    return true;
+  }
+  bool insert_or_assign(uint64_t key, uint64_t obj)
+  {
+    std::unique_lock<std::shared_timed_mutex> guard(lock);
+    auto it = m.find(key);
+    if (it != m.end())
+    {
+      it->second = obj;
+      return false;
+    }
+    m.insert(zfwstl::pair<const uint64_t, uint64_t>(key, obj));
+    return true;
+  }
+  size_t erase(uint64_t key)
+  {
+    std::unique_lock<std::shared_timed_mutex> guard(lock);
+    return m.erase(key);
+  }
+};
+
+// xorshift，每个线程一个，避免共享随机数状态
+static inline uint64_t next_rand(uint64_t &s)
+{
+  s ^= s << 13;
+  s ^= s >> 7;
+  s ^= s << 17;
+  return s;
+}
+
+template <class Map>
+static void worker(Map *m, uint64_t seed, uint64_t ops, uint64_t keys, unsigned read_pct, uint64_t *hits)
+{
+  uint64_t s = seed * 0x9E3779B97F4A7C15ull + 1, found = 0, v = 0;
+  for (uint64_t i = 0; i < ops; ++i)
+  {
+    const uint64_t r = next_rand(s);
+    const uint64_t key = (r >> 8) % keys;
+    const unsigned dice = static_cast<unsigned>(r & 0xff) * 100 / 256;
+    if (dice < read_pct)
+      found += m->find(key, v) ? 1 : 0;
+    else if (r & 0x100)
+      m->insert_or_assign(key, i);
+    else
+      m->erase(key);
+  }
+  *hits = found;
+}
+
+template <class Map>
+static void run(const char *name, int threads, uint64_t keys, uint64_t ops, unsigned read_pct)
+{
+  Map m;
+  for (uint64_t k = 0; k < keys; k += 2)
+    m.insert_or_assign(k, k);
+  zfwstl::vector<std::thread *> pool; // vector 的元素需要可复制，存放指针
+  zfwstl::vector<uint64_t> hits(threads, 0);
+  auto start = bench_clock::now();
+  for (int t = 0; t < threads; ++t)
+    pool.push_back(new std::thread(worker<Map>, &m, static_cast<uint64_t>(t), ops, keys, read_pct, &hits[t]));
+  for (size_t i = 0; i < pool.size(); ++i)
+  {
+    pool[i]->join();
+    delete pool[i];
+  }
+  const double sec = std::chrono::duration<double>(bench_clock::now() - start).count();
+  uint64_t total_hits = 0;
+  for (size_t i = 0; i < hits.size(); ++i)
+    total_hits += hits[i];
+  std::printf("%-7s threads %2d  %8.2f Mops/s  (hits %llu)\n", name, threads, ops * threads / sec / 1e6,
+              static_cast<unsigned long long>(total_hits));
+}
+
+int main(int argc, char **argv)
+{
+  const char *kind = argc > 1 ? argv[1] : "chm";
+  const char *mix = argc > 2 ? argv[2] : "read";
+  const uint64_t keys = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000000;
+  const uint64_t ops = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1000000;
+  const unsigned read_pct = std::strcmp(mix, "write") == 0 ? 50 : 95;
+  std::printf("%s: %u%% reads, %llu keys, %llu ops per thread, %u hardware threads\n", kind, read_pct,
+              static_cast<unsigned long long>(keys), static_cast<unsigned long long>(ops),
+              std::thread::hardware_concurrency());
+  const int threads[] = {1, 2, 4, 8, 16, 32, 64};
+  for (int t : threads)
+  {
+    if (std::strcmp(kind, "locked") == 0)
+      run<locked_map>("locked", t, keys == 0 ? 1 : keys, ops, read_pct);
+    else
+      run<zfwstl::concurrent_hash_map<uint64_t, uint64_t>>("chm", t, keys == 0 ? 1 : keys, ops, read_pct);
+  }
+  return 0;
+}
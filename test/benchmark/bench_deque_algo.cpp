@@ -0,0 +1,81 @@
+/**
+ * deque 分段迭代器算法基准测试
+ * 对 n 个 int 的 deque，对比逐个元素走迭代器(每步判断缓冲区边界)与按缓冲区分段处理(每段是裸指针区间)：
+ * copy: deque -> vector，分段后每段一次 memmove；参照为两个 vector 之间的 memcpy
+ * fill / find / for_each: 每段分别交给指针版本的 fill_n(1 字节类型为 memset)、SIMD 查找、指针循环
+ * 编译: g++ -std=c++14 -O2 bench_deque_algo.cpp -o bench_deque_algo
+ * 运行: ./bench_deque_algo [元素个数, 缺省 100000000]
+ */
+#include "../../STL/deque.h"
+#include "../../STL/vector.h"
+#include "../../src/algorithms/algo.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+typedef zfwstl::deque<int> int_deque;
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000000;
+  int_deque d;
+  for (size_t i = 0; i < n; ++i)
+    d.push_back(static_cast<int>(i));
+  zfwstl::vector<int> v(n), src(n, 1);
+  std::printf("%zu ints, buffer %zu elems\n", n, d.buffer_size());
+
+  auto start = bench_clock::now();
+  std::memcpy(v.data(), src.data(), n * sizeof(int));
+  std::printf("%-28s %9.1f ms\n", "memcpy vector -> vector", ms_since(start));
+
+  start = bench_clock::now();
+  auto out = v.begin();
+  for (auto it = d.begin(); it != d.end(); ++it, ++out) // 逐个元素，每步判断缓冲区边界
+    *out = *it;
+  std::printf("%-28s %9.1f ms  (%d)\n", "element-wise deque -> vector", ms_since(start), v[n - 1]);
+
+  start = bench_clock::now();
+  zfwstl::copy(d.begin(), d.end(), v.begin());
+  std::printf("%-28s %9.1f ms  (%d)\n", "copy deque -> vector", ms_since(start), v[n / 2]);
+
+  start = bench_clock::now();
+  zfwstl::copy(src.begin(), src.end(), d.begin());
+  std::printf("%-28s %9.1f ms  (%d)\n", "copy vector -> deque", ms_since(start), d[n / 2]);
+
+  start = bench_clock::now();
+  for (auto it = d.begin(); it != d.end(); ++it)
+    *it = 7;
+  std::printf("%-28s %9.1f ms\n", "element-wise fill", ms_since(start));
+  start = bench_clock::now();
+  zfwstl::fill(d.begin(), d.end(), 3);
+  std::printf("%-28s %9.1f ms  (%d)\n", "fill", ms_since(start), d[n - 1]);
+
+  d.back() = 42;
+  start = bench_clock::now();
+  auto it = d.begin();
+  while (it != d.end() && *it != 42)
+    ++it;
+  std::printf("%-28s %9.1f ms  (%td)\n", "element-wise find", ms_since(start), it - d.begin());
+  start = bench_clock::now();
+  it = zfwstl::find(d.begin(), d.end(), 42);
+  std::printf("%-28s %9.1f ms  (%td)\n", "find", ms_since(start), it - d.begin());
+
+  long long sum = 0;
+  start = bench_clock::now();
+  for (auto i = d.begin(); i != d.end(); ++i)
+    sum += *i;
+  std::printf("%-28s %9.1f ms  (%lld)\n", "element-wise sum", ms_since(start), sum);
+  sum = 0;
+  start = bench_clock::now();
+  zfwstl::for_each(d.begin(), d.end(), [&sum](int x) { sum += x; });
+  std::printf("%-28s %9.1f ms  (%lld)\n", "for_each sum", ms_since(start), sum);
+  return 0;
+}
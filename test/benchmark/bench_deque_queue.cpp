@@ -0,0 +1,107 @@
+/**
+ * deque 当作队列(zfwstl::queue)使用的吞吐基准测试
+ * 队列中常驻若干元素(积压量)，之后每轮 push 一个、pop 一个，对比不同缓冲区大小(运行期设定)下的
+ * 每次操作耗时与稳定阶段的配置次数；空闲缓冲区会被缓存复用、map 会被挪回中央，稳定阶段应不再配置内存
+ * 另有 burst 模式：每轮先 push 一批再全部 pop，队列反复在空与积压之间变化
+ * 缓存的空闲缓冲区个数可在编译时用 -DDEQUE_SPARE_BUFFERS=N 调整(N >= 1)
+ * 编译: g++ -std=c++14 -O2 bench_deque_queue.cpp -o bench_deque_queue
+ * 运行: ./bench_deque_queue [steady|burst, 缺省 steady] [操作轮数, 缺省 50000000] [积压量/每批个数, 缺省 1000]
+ *      例: ./bench_deque_queue steady 50000000 100000; ./bench_deque_queue burst 100000 5000
+ */
+#include "../../STL/queue.h"
+#include "../../STL/deque.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ns_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+}
+
+// 统计配置次数
+struct counting_alloc
+{
+  static size_t allocs;
+  static void *allocate(size_t n)
+  {
+    ++allocs;
+    return zfwstl::new_alloc::allocate(n);
+  }
+  static void deallocate(void *p, size_t n) { zfwstl::new_alloc::deallocate(p, n); }
+};
+size_t counting_alloc::allocs = 0;
+
+typedef zfwstl::deque<int, 0, counting_alloc> counted_deque;
+typedef zfwstl::queue<int, counted_deque> counted_queue;
+
+static void bench_steady(size_t rounds, size_t backlog)
+{
+  int64_t sink = 0;
+  int next = 0;
+  counted_queue q;
+  for (size_t i = 0; i < backlog; ++i)
+    q.push(next++);
+  for (size_t i = 0; i < backlog + 100000; ++i) // 预热：让 map 挪回中央、缓存填满
+  {
+    q.push(next++);
+    sink += q.front();
+    q.pop();
+  }
+  counting_alloc::allocs = 0;
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < rounds; ++i)
+  {
+    q.push(next++);
+    sink += q.front();
+    q.pop();
+  }
+  const double ns = ns_since(start);
+  std::printf("buffer %6zu elems  %6.2f ns/op  allocs %zu  (%lld)\n", counted_deque::default_buffer_size(),
+              ns / rounds, counting_alloc::allocs, static_cast<long long>(sink & 1));
+}
+
+static void bench_burst(size_t rounds, size_t batch)
+{
+  int64_t sink = 0;
+  counted_queue q;
+  counting_alloc::allocs = 0;
+  auto start = bench_clock::now();
+  for (size_t r = 0; r < rounds; ++r)
+  {
+    for (size_t i = 0; i < batch; ++i)
+      q.push(static_cast<int>(i));
+    while (!q.empty())
+    {
+      sink += q.front();
+      q.pop();
+    }
+  }
+  const double ns = ns_since(start);
+  std::printf("buffer %6zu elems  %6.2f ns/op  allocs %.3f /round  (%lld)\n", counted_deque::default_buffer_size(),
+              ns / (rounds * batch * 2), static_cast<double>(counting_alloc::allocs) / rounds,
+              static_cast<long long>(sink & 1));
+}
+
+int main(int argc, char **argv)
+{
+  const char *mode = argc > 1 ? argv[1] : "steady";
+  const size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 50000000;
+  const size_t backlog = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000;
+  const bool burst = std::strcmp(mode, "burst") == 0;
+  std::printf("%s: %zu rounds, %s %zu\n", mode, rounds, burst ? "batch" : "backlog", backlog);
+  const size_t bytes[] = {64, 512, 4096, 16384, 65536};
+  for (size_t b : bytes)
+  {
+    counted_deque::set_default_buffer_size(b / sizeof(int));
+    if (burst)
+      bench_burst(rounds, backlog);
+    else
+      bench_steady(rounds, backlog);
+  }
+  counted_deque::set_default_buffer_size(0);
+  return 0;
+}
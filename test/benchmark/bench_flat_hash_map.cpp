@@ -0,0 +1,115 @@
+/**
+ * flat_hash_map(开放定址) 与 unordered_map(开链) 基准测试
+ * 分别以 int 键与 string 键测试：插入、命中查找、未命中查找、按键删除
+ * unordered_map 的 erase(key) 目前不可用，删除一项只测 flat_hash_map
+ * 编译: g++ -std=c++14 -O2 bench_flat_hash_map.cpp -o bench_flat_hash_map
+ * 运行: ./bench_flat_hash_map [元素个数, 缺省 1000000, 可到 100000000] [int|string|all]
+ */
+#include "../../STL_2/flat_hash_map.h"
+#include "../../STL_2/unordered_map.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ns_per_op(bench_clock::time_point start, size_t n)
+{
+  return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / n;
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// 防止查找结果被优化掉
+static volatile size_t sink;
+
+template <class Map, class Key>
+void bench_common(const char *name, const zfwstl::vector<Key> &keys, const zfwstl::vector<Key> &miss)
+{
+  const size_t n = keys.size();
+  Map m;
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < n; ++i)
+    m[keys[i]] = i;
+  const double insert_ns = ns_per_op(start, n);
+
+  size_t found = 0;
+  start = bench_clock::now();
+  for (size_t i = 0; i < n; ++i)
+    found += m.find(keys[n - 1 - i]) != m.end();
+  const double hit_ns = ns_per_op(start, n);
+
+  start = bench_clock::now();
+  for (size_t i = 0; i < n; ++i)
+    found += m.find(miss[i]) != m.end();
+  const double miss_ns = ns_per_op(start, n);
+  sink = found;
+
+  std::printf("%-16s insert %8.1f  hit %8.1f  miss %8.1f", name, insert_ns, hit_ns, miss_ns);
+}
+
+template <class Key, class Hash>
+void bench_key(const char *title, const zfwstl::vector<Key> &keys, const zfwstl::vector<Key> &miss)
+{
+  std::printf("== %s keys, n = %zu (ns/op)\n", title, keys.size());
+  {
+    typedef zfwstl::flat_hash_map<Key, size_t, Hash> flat_map;
+    bench_common<flat_map>("flat_hash_map", keys, miss);
+    flat_map m;
+    m.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+      m[keys[i]] = i;
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i)
+      m.erase(keys[i]);
+    std::printf("  erase %8.1f\n", ns_per_op(start, keys.size()));
+  }
+  bench_common<zfwstl::unordered_map<Key, size_t, Hash>>("unordered_map", keys, miss);
+  std::printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const char *which = argc > 2 ? argv[2] : "all";
+  uint64_t seed = 42;
+
+  if (std::strcmp(which, "string") != 0)
+  {
+    zfwstl::vector<int> keys, miss;
+    keys.reserve(n);
+    miss.reserve(n);
+    // 最低位区分命中键(奇数)与未命中键(偶数)
+    for (size_t i = 0; i < n; ++i)
+    {
+      keys.push_back(static_cast<int>(splitmix64(seed) | 1));
+      miss.push_back(static_cast<int>(splitmix64(seed) & ~1ull));
+    }
+    bench_key<int, zfwstl::hash<int>>("int", keys, miss);
+  }
+  if (std::strcmp(which, "int") != 0)
+  {
+    zfwstl::vector<std::string> keys, miss;
+    keys.reserve(n);
+    miss.reserve(n);
+    char buf[32];
+    for (size_t i = 0; i < n; ++i)
+    {
+      std::snprintf(buf, sizeof(buf), "key:%016llx", static_cast<unsigned long long>(splitmix64(seed)));
+      keys.push_back(std::string(buf));
+      std::snprintf(buf, sizeof(buf), "miss:%016llx", static_cast<unsigned long long>(splitmix64(seed)));
+      miss.push_back(std::string(buf));
+    }
+    bench_key<std::string, zfwstl::hash<std::string>>("string", keys, miss);
+  }
+  return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * flat_map 与 map(红黑树) 基准测试
+ * 同样 n 个随机 int 键，值为 64 字节的结构体，依次测：区间构造(flat_map 只排序一次)、随机顺序查找(全部命中)、
+ * 只读键的全部命中查找 + 读值，以及中序遍历求和
+ * split 为键值分开存放的 flat_map：二分只访问键数组，值越大，相对交错存放的优势越明显
+ * 每次运行只测一种容器：同一进程内先后测试时，后者会复用前者归还给内存池的节点，结果会失真
+ * 编译: g++ -std=c++14 -O2 bench_flat_map.cpp -o bench_flat_map
+ * 运行: ./bench_flat_map [元素个数, 缺省 1000000] [map|flat|split, 缺省 flat]
+ *      例: for c in map flat split; do ./bench_flat_map 1000000 $c; done
+ */
+#include "../../STL_2/map.h"
+#include "../../STL_2/flat_map.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+struct payload
+{
+  long long v[8];
+};
+
+template <class Map>
+void bench(const char *name, const zfwstl::vector<zfwstl::pair<int, payload>> &src, const zfwstl::vector<int> &probe)
+{
+  auto start = bench_clock::now();
+  Map m(src.begin(), src.end());
+  const double build_ms = ms_since(start);
+
+  start = bench_clock::now();
+  long long hit = 0;
+  for (size_t i = 0; i < probe.size(); ++i)
+    hit += m.find(probe[i]) != m.end();
+  const double find_ms = ms_since(start);
+
+  start = bench_clock::now();
+  long long val = 0;
+  for (size_t i = 0; i < probe.size(); ++i)
+    val += (*m.find(probe[i])).second.v[0];
+  const double find_value_ms = ms_since(start);
+
+  start = bench_clock::now();
+  long long sum = 0;
+  for (int round = 0; round < 10; ++round)
+    for (auto it = m.begin(); it != m.end(); ++it)
+      sum += (*it).first;
+  const double iter_ms = ms_since(start) / 10;
+
+  std::printf("%-6s build %8.1f ms  find %8.1f ms  find+value %8.1f ms  iterate %6.2f ms  size %zu  (%lld %lld %lld)\n",
+              name, build_ms, find_ms, find_value_ms, iter_ms, m.size(), hit & 1, val & 1, sum & 1);
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const char *which = argc > 2 ? argv[2] : "flat";
+  zfwstl::vector<zfwstl::pair<int, payload>> src;
+  src.reserve(n);
+  uint64_t seed = 1;
+  for (size_t i = 0; i < n; ++i)
+  {
+    payload p;
+    for (int j = 0; j < 8; ++j)
+      p.v[j] = static_cast<long long>(i) + j;
+    src.push_back(zfwstl::pair<int, payload>(static_cast<int>(splitmix64(seed) >> 33), p));
+  }
+  zfwstl::vector<int> probe;
+  probe.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    probe.push_back(src[splitmix64(seed) % n].first);
+
+  if (std::strcmp(which, "map") == 0)
+    bench<zfwstl::map<int, payload>>(which, src, probe);
+  else if (std::strcmp(which, "split") == 0)
+    bench<zfwstl::flat_map<int, payload, zfwstl::less<int>, zfwstl::new_alloc, true>>(which, src, probe);
+  else
+    bench<zfwstl::flat_map<int, payload>>(which, src, probe);
+  return 0;
+}
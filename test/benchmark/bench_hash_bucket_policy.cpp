@@ -0,0 +1,87 @@
+/**
+ * hashtable 桶策略基准测试
+ * 同一个 unordered_map<int, int> 分别使用 prime(取模) / pow2(混合+位与) / fastrange(乘法取高位) 三种桶策略
+ * 测试插入、命中查找与未命中查找，并输出最长桶长度以观察分布
+ * 编译: g++ -std=c++14 -O2 bench_hash_bucket_policy.cpp -o bench_hash_bucket_policy
+ * 运行: ./bench_hash_bucket_policy [元素个数]
+ */
+#include "../../STL_2/unordered_map.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ns_per_op(bench_clock::time_point start, size_t n)
+{
+  return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / n;
+}
+
+static volatile size_t sink;
+
+template <class Policy>
+void bench_policy(const char *name, const char *keyset, const zfwstl::vector<int> &keys)
+{
+  typedef zfwstl::unordered_map<int, int, zfwstl::hash<int>, zfwstl::equal_to<int>, zfwstl::alloc, Policy> umap;
+  const size_t n = keys.size();
+  umap m;
+  auto start = bench_clock::now();
+  for (size_t i = 0; i < n; ++i)
+    m[keys[i]] = static_cast<int>(i);
+  const double insert_ns = ns_per_op(start, n);
+
+  size_t found = 0;
+  start = bench_clock::now();
+  for (size_t i = 0; i < n; ++i)
+    found += m.count(keys[i]);
+  const double hit_ns = ns_per_op(start, n);
+
+  start = bench_clock::now();
+  for (size_t i = 0; i < n; ++i)
+    found += m.count(keys[i] + 1); // 所有键都是偶数，+1 必然未命中
+  const double miss_ns = ns_per_op(start, n);
+  sink = found;
+
+  size_t longest = 0;
+  for (size_t b = 0; b < m.bucket_count(); ++b)
+    longest = zfwstl::max(longest, m.elems_in_bucket(b));
+  std::printf("%-10s %-10s insert %7.1f  hit %7.1f  miss %7.1f ns/op  buckets %9zu  longest %zu\n",
+              keyset, name, insert_ns, hit_ns, miss_ns, m.bucket_count(), longest);
+}
+
+static void run(const char *keyset, const zfwstl::vector<int> &keys)
+{
+  bench_policy<zfwstl::prime_bucket_policy>("prime", keyset, keys);
+  bench_policy<zfwstl::pow2_bucket_policy>("pow2", keyset, keys);
+  bench_policy<zfwstl::fastrange_bucket_policy>("fastrange", keyset, keys);
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  zfwstl::vector<int> keys;
+  keys.reserve(n);
+
+  // 连续偶数键
+  for (size_t i = 0; i < n; ++i)
+    keys.push_back(static_cast<int>(i * 2));
+  run("sequence", keys);
+
+  // 步长 1024 的键：低 10 位全为 0，直接位与会全部落在同一个桶
+  keys.clear();
+  for (size_t i = 0; i < n; ++i)
+    keys.push_back(static_cast<int>(i * 1024));
+  run("stride1024", keys);
+
+  // 随机偶数键
+  keys.clear();
+  unsigned x = 12345;
+  for (size_t i = 0; i < n; ++i)
+  {
+    x = x * 1103515245u + 12345u;
+    keys.push_back(static_cast<int>(x & ~1u));
+  }
+  run("random", keys);
+  return 0;
+}
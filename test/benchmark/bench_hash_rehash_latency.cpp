@@ -0,0 +1,70 @@
+/**
+ * hashtable 渐进式 rehash 插入延迟基准测试
+ * 同一个 unordered_map<int, int> 分别以一次性 rehash(缺省) 与渐进式 rehash 插入 n 个随机键，
+ * 逐次计时，输出 p50 / p99 / p999 / 最大延迟与总耗时
+ * 一次性 rehash 的代价集中在少数几次插入上(最大延迟随 n 线性增长)，渐进式把它摊到之后的插入中；
+ * 渐进式模式下新的 bucket 数组也在元素数过半后提前分配、分段清零，换来的是 p99 略高(缺页被分散到普通插入中)
+ * 两种模式请分两次运行：同一进程内先后运行时，后者会复用前者归还给内存池的节点，延迟会失真
+ * 编译: g++ -std=c++14 -O2 bench_hash_rehash_latency.cpp -o bench_hash_rehash_latency
+ * 运行: ./bench_hash_rehash_latency [元素个数, 缺省 5000000] [stop|incremental, 缺省 incremental]
+ */
+#include "../../STL_2/unordered_map.h"
+#include "../../STL/vector.h"
+#include "../../src/algorithms/algo.h" //for sort
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static void bench(const char *name, bool incremental, const zfwstl::vector<int> &keys)
+{
+  const size_t n = keys.size();
+  zfwstl::vector<uint64_t> lat(n, 0);
+  zfwstl::unordered_map<int, int> m;
+  m.set_incremental_rehash(incremental);
+
+  const auto all = bench_clock::now();
+  for (size_t i = 0; i < n; ++i)
+  {
+    const auto start = bench_clock::now();
+    m[keys[i]] = static_cast<int>(i);
+    lat[i] = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start).count());
+  }
+  const double total_ms = std::chrono::duration<double, std::milli>(bench_clock::now() - all).count();
+
+  zfwstl::sort(lat.begin(), lat.end());
+  std::printf("%-12s p50 %6llu  p99 %6llu  p999 %8llu  max %10llu ns   total %8.1f ms  size %zu\n", name,
+              static_cast<unsigned long long>(lat[n / 2]),
+              static_cast<unsigned long long>(lat[n - n / 100]),
+              static_cast<unsigned long long>(lat[n - n / 1000]),
+              static_cast<unsigned long long>(lat[n - 1]),
+              total_ms, m.size());
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+  const bool incremental = !(argc > 2 && std::strcmp(argv[2], "stop") == 0);
+  zfwstl::vector<int> keys;
+  keys.reserve(n);
+  uint64_t seed = 7;
+  for (size_t i = 0; i < n; ++i)
+    keys.push_back(static_cast<int>(splitmix64(seed)));
+
+  std::printf("== insert latency, n = %zu\n", n);
+  if (incremental)
+    bench("incremental", true, keys);
+  else
+    bench("stop-world", false, keys);
+  return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * 按请求生命周期释放容器的基准测试
+ * 每个"请求"构建一个 vector<int>、一个 map<int,int>、一个 unordered_map<int,int>，使用后一起丢弃
+ * 分别统计构建与拆除(teardown)的平均耗时:
+ *   default            : 容器默认配置器，析构时逐个释放
+ *   monotonic          : resource_alloc + monotonic_buffer_resource，析构时释放为空操作，最后 release()
+ *   monotonic,no-dtor  : 容器本身也放在 arena 中且不析构(元素可平凡析构)，拆除只剩一次 release()
+ *   pool               : resource_alloc + unsynchronized_pool_resource，析构时区块回到池中，供下一个请求复用
+ * 编译: g++ -std=c++14 -O2 -pthread bench_memory_resource.cpp -o bench_memory_resource
+ * 运行: ./bench_memory_resource [请求数] [每个容器的元素数]
+ */
+#include "../../src/memory/memory_resource.h"
+#include "../../STL/vector.h"
+#include "../../STL_2/map.h"
+#include "../../STL_2/unordered_map.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+typedef std::chrono::steady_clock bench_clock;
+
+template <class VAlloc, class NAlloc>
+struct request_state
+{
+  zfwstl::vector<int, VAlloc> v;
+  zfwstl::map<int, int, zfwstl::less<int>, NAlloc> m;
+  zfwstl::unordered_map<int, int, zfwstl::hash<int>, zfwstl::equal_to<int>, NAlloc> um;
+
+  void build(int n)
+  {
+    unsigned x = 7;
+    for (int i = 0; i < n; ++i)
+    {
+      x = x * 1103515245u + 12345u;
+      int k = static_cast<int>(x >> 8);
+      v.push_back(k);
+      m[k] = i;
+      um[k] = i;
+    }
+  }
+};
+
+typedef request_state<zfwstl::new_alloc, zfwstl::alloc> default_state;
+typedef request_state<zfwstl::resource_alloc, zfwstl::resource_alloc> resource_state;
+
+struct timing
+{
+  double build = 0, teardown = 0;
+};
+
+static double us(bench_clock::time_point a, bench_clock::time_point b)
+{
+  return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+timing run_default(int requests, int n)
+{
+  timing t;
+  for (int r = 0; r < requests; ++r)
+  {
+    auto t0 = bench_clock::now();
+    default_state *s = new default_state;
+    s->build(n);
+    auto t1 = bench_clock::now();
+    delete s;
+    auto t2 = bench_clock::now();
+    t.build += us(t0, t1);
+    t.teardown += us(t1, t2);
+  }
+  return t;
+}
+
+template <class Resource>
+timing run_resource(int requests, int n, Resource &res, bool run_dtors, bool release)
+{
+  timing t;
+  for (int r = 0; r < requests; ++r)
+  {
+    auto t0 = bench_clock::now();
+    resource_state *s;
+    {
+      zfwstl::scoped_resource guard(&res);
+      s = new (res.allocate(sizeof(resource_state))) resource_state;
+      s->build(n);
+    }
+    auto t1 = bench_clock::now();
+    if (run_dtors)
+    {
+      s->~resource_state();
+      res.deallocate(s, sizeof(resource_state));
+    }
+    if (release)
+      res.release();
+    auto t2 = bench_clock::now();
+    t.build += us(t0, t1);
+    t.teardown += us(t1, t2);
+  }
+  return t;
+}
+
+static void report(const char *name, timing t, int requests)
+{
+  std::printf("%-20s %12.2f %12.2f\n", name, t.build / requests, t.teardown / requests);
+}
+
+int main(int argc, char **argv)
+{
+  int requests = argc > 1 ? std::atoi(argv[1]) : 2000;
+  int n = argc > 2 ? std::atoi(argv[2]) : 500;
+  std::printf("%d requests, %d elements per container, microseconds per request\n", requests, n);
+  std::printf("%-20s %12s %12s\n", "mode", "build", "teardown");
+  report("default", run_default(requests, n), requests);
+  {
+    zfwstl::monotonic_buffer_resource arena(64 * 1024);
+    report("monotonic", run_resource(requests, n, arena, true, true), requests);
+  }
+  {
+    zfwstl::monotonic_buffer_resource arena(64 * 1024);
+    report("monotonic,no-dtor", run_resource(requests, n, arena, false, true), requests);
+  }
+  {
+    zfwstl::unsynchronized_pool_resource pool;
+    report("pool", run_resource(requests, n, pool, true, false), requests);
+  }
+  return 0;
+}
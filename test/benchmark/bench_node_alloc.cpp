@@ -0,0 +1,72 @@
+/**
+ * 节点型容器的空间配置器基准测试
+ * 对比同一容器分别使用 new_alloc(每个节点一次 ::operator new) 与内存池 alloc 的插入、析构耗时
+ * 编译: g++ -std=c++14 -O2 -pthread bench_node_alloc.cpp -o bench_node_alloc
+ * 运行: ./bench_node_alloc [元素个数]
+ */
+#include "../../STL/list.h"
+#include "../../STL_2/map.h"
+#include "../../STL_2/unordered_map.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+template <class Alloc>
+void bench_list(size_t n, const char *name)
+{
+  auto start = bench_clock::now();
+  {
+    zfwstl::list<int, Alloc> l;
+    for (size_t i = 0; i < n; ++i)
+      l.push_back(static_cast<int>(i));
+  }
+  std::printf("%-14s %-16s %10.2f ms\n", "list", name, ms_since(start));
+}
+
+template <class Alloc>
+void bench_map(size_t n, const char *name)
+{
+  auto start = bench_clock::now();
+  {
+    zfwstl::map<int, int, zfwstl::less<int>, Alloc> m;
+    unsigned x = 12345;
+    for (size_t i = 0; i < n; ++i)
+    {
+      x = x * 1103515245u + 12345u;
+      m.insert(zfwstl::make_pair(static_cast<int>(x >> 1), static_cast<int>(i)));
+    }
+  }
+  std::printf("%-14s %-16s %10.2f ms\n", "map", name, ms_since(start));
+}
+
+template <class Alloc>
+void bench_unordered_map(size_t n, const char *name)
+{
+  auto start = bench_clock::now();
+  {
+    zfwstl::unordered_map<int, int, zfwstl::hash<int>, zfwstl::equal_to<int>, Alloc> m;
+    for (size_t i = 0; i < n; ++i)
+      m.insert(zfwstl::make_pair(static_cast<int>(i), static_cast<int>(i)));
+  }
+  std::printf("%-14s %-16s %10.2f ms\n", "unordered_map", name, ms_since(start));
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  std::printf("insert %zu elements then destroy the container\n", n);
+  bench_list<zfwstl::new_alloc>(n, "new_alloc");
+  bench_list<zfwstl::alloc>(n, "alloc");
+  bench_map<zfwstl::new_alloc>(n, "new_alloc");
+  bench_map<zfwstl::alloc>(n, "alloc");
+  bench_unordered_map<zfwstl::new_alloc>(n, "new_alloc");
+  bench_unordered_map<zfwstl::alloc>(n, "alloc");
+  return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * 并行 sort / stable_sort / merge 扩展性测试
+ * n 个随机 uint64_t，先测顺序版本(seq)，再以并发度 1, 2, 4, ... 直到最大线程数的任务池测 par 版本，
+ * 打印耗时与相对顺序版本的加速比；merge 为两段各 n / 2 个有序元素的归并
+ * 编译: g++ -std=c++14 -O2 -pthread bench_parallel_sort.cpp -o bench_parallel_sort
+ * 运行: ./bench_parallel_sort [元素个数, 缺省 20000000] [sort|stable_sort|merge, 缺省 sort] [最大线程数, 缺省 hardware_concurrency]
+ *      例: for a in sort stable_sort merge; do ./bench_parallel_sort 50000000 $a; done
+ */
+#include "../../src/algorithms/parallel_algo.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// policy 为 nullptr 时测顺序版本
+static double run(const char *algo, const zfwstl::vector<uint64_t> &src, zfwstl::work_stealing_pool *pool)
+{
+  zfwstl::vector<uint64_t> v(src.begin(), src.end());
+  zfwstl::vector<uint64_t> out;
+  if (std::strcmp(algo, "merge") == 0)
+  {
+    // 两半各自有序，预处理不计时
+    zfwstl::sort(v.begin(), v.begin() + v.size() / 2);
+    zfwstl::sort(v.begin() + v.size() / 2, v.end());
+    out = zfwstl::vector<uint64_t>(v.size(), 0);
+  }
+  auto start = bench_clock::now();
+  if (std::strcmp(algo, "stable_sort") == 0)
+  {
+    if (pool)
+      zfwstl::stable_sort(zfwstl::execution::par.on(*pool), v.begin(), v.end());
+    else
+      zfwstl::stable_sort(zfwstl::execution::seq, v.begin(), v.end());
+  }
+  else if (std::strcmp(algo, "merge") == 0)
+  {
+    auto mid = v.begin() + v.size() / 2;
+    if (pool)
+      zfwstl::merge(zfwstl::execution::par.on(*pool), v.begin(), mid, mid, v.end(), out.begin());
+    else
+      zfwstl::merge(zfwstl::execution::seq, v.begin(), mid, mid, v.end(), out.begin());
+  }
+  else
+  {
+    if (pool)
+      zfwstl::sort(zfwstl::execution::par.on(*pool), v.begin(), v.end());
+    else
+      zfwstl::sort(zfwstl::execution::seq, v.begin(), v.end());
+  }
+  const double ms = ms_since(start);
+  const zfwstl::vector<uint64_t> &result = out.empty() ? v : out;
+  if (!zfwstl::is_sorted(result.begin(), result.end()))
+    std::printf("NOT SORTED\n");
+  return ms;
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+  const char *algo = argc > 2 ? argv[2] : "sort";
+  size_t max_threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : std::thread::hardware_concurrency();
+  if (max_threads == 0)
+    max_threads = 1;
+  zfwstl::vector<uint64_t> src;
+  src.reserve(n);
+  uint64_t seed = 1;
+  for (size_t i = 0; i < n; ++i)
+    src.push_back(splitmix64(seed));
+
+  const double seq_ms = run(algo, src, nullptr);
+  std::printf("%-11s n=%zu  seq        %9.1f ms\n", algo, n, seq_ms);
+  for (size_t t = 1;; t = t * 2 > max_threads && t != max_threads ? max_threads : t * 2)
+  {
+    zfwstl::work_stealing_pool pool(t);
+    const double ms = run(algo, src, &pool);
+    std::printf("%-11s n=%zu  par x%-4zu %9.1f ms  speedup %5.2f\n", algo, n, t, ms, seq_ms / ms);
+    if (t == max_threads)
+      break;
+  }
+  return 0;
+}
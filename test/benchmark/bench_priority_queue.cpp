@@ -0,0 +1,144 @@
+/**
+ * 优先级队列基准测试：2 / 4 / 8 叉 zfwstl::priority_queue、radix_heap 与 std::priority_queue 对比
+ * 小顶堆，元素为 uint64_t 键；规模 n 从 1K 起每次乘 10，直到给定的最大规模
+ * hold 模式：先放入 n 个随机键，之后每轮取出最小键 k、放入 k + 随机增量(事件调度的典型用法，键单调)
+ * drain 模式：放入 n 个随机键，再全部取出
+ * 同时统计 d 叉堆每次 pop 的比较次数(单独一轮，不计入耗时)
+ * 编译: g++ -std=c++14 -O2 bench_priority_queue.cpp -o bench_priority_queue
+ * 运行: ./bench_priority_queue [hold|drain, 缺省 hold] [最大规模, 缺省 10000000] [hold 轮数, 缺省 10000000]
+ *      例: ./bench_priority_queue hold 100000000; ./bench_priority_queue drain 100000000
+ */
+#include "../../STL/priority_queue.h"
+#include "../../STL/radix_heap.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <vector>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ns_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+}
+
+static inline uint64_t next_rand(uint64_t &s)
+{
+  s ^= s << 13;
+  s ^= s >> 7;
+  s ^= s << 17;
+  return s;
+}
+
+// 统一接口：push(k) / top_key() / pop()
+template <size_t D>
+struct dary_pq
+{
+  zfwstl::priority_queue<uint64_t, zfwstl::vector<uint64_t>, zfwstl::greater<uint64_t>, D> q;
+  void push(uint64_t k) { q.push(k); }
+  uint64_t top_key() { return q.top(); }
+  void pop() { q.pop(); }
+};
+struct radix_pq
+{
+  zfwstl::radix_heap<uint64_t, uint32_t> q;
+  void push(uint64_t k) { q.push(k, 0); }
+  uint64_t top_key() { return q.top_key(); }
+  void pop() { q.pop(); }
+};
+struct std_pq
+{
+  std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> q;
+  void push(uint64_t k) { q.push(k); }
+  uint64_t top_key() { return q.top(); }
+  void pop() { q.pop(); }
+};
+
+template <class PQ>
+static void run(const char *name, bool hold, uint64_t n, uint64_t rounds)
+{
+  PQ *pq = new PQ; // 100M 个元素时不放在栈上
+  uint64_t s = 88172645463325252ull, sum = 0;
+  auto start = bench_clock::now();
+  for (uint64_t i = 0; i < n; ++i)
+    pq->push(next_rand(s) % (n * 16));
+  const double fill_ns = ns_since(start);
+  start = bench_clock::now();
+  uint64_t ops = 0;
+  if (hold)
+  {
+    for (uint64_t i = 0; i < rounds; ++i)
+    {
+      const uint64_t k = pq->top_key();
+      sum += k;
+      pq->pop();
+      pq->push(k + next_rand(s) % 1024);
+    }
+    ops = rounds;
+  }
+  else
+  {
+    for (uint64_t i = 0; i < n; ++i)
+    {
+      sum += pq->top_key();
+      pq->pop();
+    }
+    ops = n;
+  }
+  const double run_ns = ns_since(start);
+  std::printf("%-7s n %10llu  push %7.1f ns  %s %7.1f ns/op  (checksum %llx)\n", name,
+              static_cast<unsigned long long>(n), fill_ns / n, hold ? "pop+push" : "pop     ", run_ns / ops,
+              static_cast<unsigned long long>(sum));
+  delete pq;
+}
+
+// 统计 d 叉堆 pop 的比较次数
+static uint64_t comparisons = 0;
+struct counting_greater
+{
+  bool operator()(uint64_t a, uint64_t b) const
+  {
+    ++comparisons;
+    return a > b;
+  }
+};
+template <size_t D>
+static void count_pop(uint64_t n)
+{
+  zfwstl::vector<uint64_t> v;
+  uint64_t s = 12345;
+  for (uint64_t i = 0; i < n; ++i)
+    v.push_back(next_rand(s));
+  zfwstl::dary_make_heap<D>(v.begin(), v.end(), counting_greater());
+  comparisons = 0;
+  for (uint64_t i = n; i > 1; --i)
+    zfwstl::dary_pop_heap<D>(v.begin(), v.begin() + i, counting_greater());
+  std::printf("arity %zu n %10llu  %6.2f comparisons per pop\n", D, static_cast<unsigned long long>(n),
+              static_cast<double>(comparisons) / n);
+}
+
+int main(int argc, char **argv)
+{
+  const char *mode = argc > 1 ? argv[1] : "hold";
+  const uint64_t max_n = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+  const uint64_t rounds = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10000000;
+  const bool hold = std::strcmp(mode, "drain") != 0;
+  for (uint64_t n = 1000; n <= max_n; n *= 10)
+  {
+    run<dary_pq<2>>("2-ary", hold, n, rounds);
+    run<dary_pq<4>>("4-ary", hold, n, rounds);
+    run<dary_pq<8>>("8-ary", hold, n, rounds);
+    run<radix_pq>("radix", hold, n, rounds);
+    run<std_pq>("std", hold, n, rounds);
+  }
+  const uint64_t count_n = max_n < 1000000 ? max_n : 1000000;
+  count_pop<2>(count_n);
+  count_pop<4>(count_n);
+  count_pop<8>(count_n);
+  return 0;
+}
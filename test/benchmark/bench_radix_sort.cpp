@@ -0,0 +1,125 @@
+/**
+ * radix_sort 与 sort 对比
+ * 元素个数从 1K 起每次乘 10，直到给定的最大值；每个规模测同一份随机数据，打印耗时与每元素纳秒数
+ * 类型: u32 / u64 / i64 / float / double，record 为 {int64_t 键, 8 字节负载}，radix_sort 用键提取版本
+ * 1B 个 u64 需要约 16 GB 内存(数据、sort 用的副本以及 radix_sort 的缓冲区)
+ * 编译: g++ -std=c++14 -O2 bench_radix_sort.cpp -o bench_radix_sort
+ * 运行: ./bench_radix_sort [最大元素个数, 缺省 100000000] [u32|u64|i64|float|double|record, 缺省 u64]
+ *      例: for t in u32 u64 double record; do ./bench_radix_sort 100000000 $t; done
+ */
+#include "../../src/algorithms/algo.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+struct record
+{
+  int64_t key;
+  uint64_t payload;
+};
+struct record_key
+{
+  int64_t operator()(const record &r) const { return r.key; }
+};
+struct record_less
+{
+  bool operator()(const record &a, const record &b) const { return a.key < b.key; }
+};
+
+template <class T>
+T make_value(uint64_t r);
+template <>
+uint32_t make_value<uint32_t>(uint64_t r) { return static_cast<uint32_t>(r); }
+template <>
+uint64_t make_value<uint64_t>(uint64_t r) { return r; }
+template <>
+int64_t make_value<int64_t>(uint64_t r) { return static_cast<int64_t>(r); }
+template <>
+float make_value<float>(uint64_t r) { return static_cast<float>(static_cast<int64_t>(r)) * 1e-12f; }
+template <>
+double make_value<double>(uint64_t r) { return static_cast<double>(static_cast<int64_t>(r)) * 1e-12; }
+template <>
+record make_value<record>(uint64_t r) { return record{static_cast<int64_t>(r), r}; }
+
+template <class T>
+void sort_once(zfwstl::vector<T> &v, bool radix)
+{
+  if (radix)
+    zfwstl::radix_sort(v.begin(), v.end());
+  else
+    zfwstl::sort(v.begin(), v.end());
+}
+template <>
+void sort_once<record>(zfwstl::vector<record> &v, bool radix)
+{
+  if (radix)
+    zfwstl::radix_sort(v.begin(), v.end(), record_key());
+  else
+    zfwstl::sort(v.begin(), v.end(), record_less());
+}
+
+template <class T>
+void bench(const char *name, size_t max_n)
+{
+  for (size_t n = 1000; n <= max_n; n *= 10)
+  {
+    zfwstl::vector<T> src;
+    src.reserve(n);
+    uint64_t seed = n;
+    for (size_t i = 0; i < n; ++i)
+      src.push_back(make_value<T>(splitmix64(seed)));
+    // 小规模重复多次，减小计时误差
+    const size_t rounds = n < 1000000 ? 10000000 / n : 1;
+    double ms[2];
+    for (int radix = 0; radix < 2; ++radix)
+    {
+      double total = 0;
+      for (size_t r = 0; r < rounds; ++r)
+      {
+        zfwstl::vector<T> v(src.begin(), src.end());
+        auto start = bench_clock::now();
+        sort_once(v, radix != 0);
+        total += ms_since(start);
+      }
+      ms[radix] = total / rounds;
+    }
+    std::printf("%-6s n=%-11zu sort %10.3f ms (%5.1f ns/elem)  radix_sort %10.3f ms (%5.1f ns/elem)  speedup %5.2f\n",
+                name, n, ms[0], ms[0] * 1e6 / n, ms[1], ms[1] * 1e6 / n, ms[0] / ms[1]);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const size_t max_n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000000;
+  const char *type = argc > 2 ? argv[2] : "u64";
+  if (std::strcmp(type, "u32") == 0)
+    bench<uint32_t>(type, max_n);
+  else if (std::strcmp(type, "i64") == 0)
+    bench<int64_t>(type, max_n);
+  else if (std::strcmp(type, "float") == 0)
+    bench<float>(type, max_n);
+  else if (std::strcmp(type, "double") == 0)
+    bench<double>(type, max_n);
+  else if (std::strcmp(type, "record") == 0)
+    bench<record>(type, max_n);
+  else
+    bench<uint64_t>(type, max_n);
+  return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * 数值归约与扫描
+ * n 个随机 double(或 float)，对比 accumulate(从左到右)、reduce(标量 / SSE2 / AVX2)、kahan_reduce，
+ * 以及并发度 1, 2, 4, ... 直到最大线程数的 par 版本；同时打印相对 long double 精确值的误差
+ * sum: accumulate / reduce / kahan_reduce；dot: inner_product / transform_reduce；scan: partial_sum / inclusive_scan
+ * 编译: g++ -std=c++14 -O2 -pthread bench_reduce.cpp -o bench_reduce
+ * 运行: ./bench_reduce [元素个数, 缺省 20000000] [sum|dot|scan, 缺省 sum] [double|float, 缺省 double] [最大线程数, 缺省 hardware_concurrency]
+ *      例: for a in sum dot scan; do ./bench_reduce 100000000 $a; done
+ */
+#include "../../src/algorithms/parallel_algo.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static const char *kLevelNames[] = {"scalar", "sse2", "avx2"};
+
+// 重复 rounds 次取最短时间
+template <class F>
+static double best_ms(F f, int rounds = 5)
+{
+  double best = 1e300;
+  for (int r = 0; r < rounds; ++r)
+  {
+    auto start = bench_clock::now();
+    f();
+    const double ms = ms_since(start);
+    best = ms < best ? ms : best;
+  }
+  return best;
+}
+
+template <class T>
+static void report(const char *name, size_t n, double ms, T value, long double exact, double base_ms)
+{
+  std::printf("%-26s %9.2f ms  %6.2f GB/s  speedup %5.2f  rel.err %.3Le\n", name, ms,
+              n * sizeof(T) / (ms * 1e6), base_ms / ms,
+              exact == 0 ? 0.0L : std::fabs((static_cast<long double>(value) - exact) / exact));
+}
+
+template <class T>
+static void bench_sum(const zfwstl::vector<T> &a, const zfwstl::vector<T> &b, bool dot, size_t max_threads)
+{
+  const size_t n = a.size();
+  long double exact = 0;
+  for (size_t i = 0; i < n; ++i)
+    exact += dot ? static_cast<long double>(a[i]) * b[i] : static_cast<long double>(a[i]);
+  volatile T sink;
+  T value = 0;
+  const double base = best_ms([&]
+                              { sink = value = dot ? zfwstl::inner_product(a.begin(), a.end(), b.begin(), T(0))
+                                                   : zfwstl::accumulate(a.begin(), a.end(), T(0)); });
+  report(dot ? "inner_product" : "accumulate", n, base, value, exact, base);
+  const zfwstl::simd_isa best = zfwstl::simd_detect();
+  for (int lv = 0; lv <= static_cast<int>(best); ++lv)
+  {
+    zfwstl::simd_set_level(static_cast<zfwstl::simd_isa>(lv));
+    const double ms = best_ms([&]
+                              { sink = value = dot ? zfwstl::transform_reduce(a.begin(), a.end(), b.begin(), T(0))
+                                                   : zfwstl::reduce(a.begin(), a.end(), T(0)); });
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s %s", dot ? "transform_reduce" : "reduce", kLevelNames[lv]);
+    report(name, n, ms, value, exact, base);
+    if (!dot)
+    {
+      const double kms = best_ms([&]
+                                 { sink = value = zfwstl::kahan_reduce(a.begin(), a.end(), T(0)); });
+      std::snprintf(name, sizeof(name), "kahan_reduce %s", kLevelNames[lv]);
+      report(name, n, kms, value, exact, base);
+    }
+  }
+  zfwstl::simd_set_level(best);
+  for (size_t t = 1;; t = t * 2 > max_threads && t != max_threads ? max_threads : t * 2)
+  {
+    zfwstl::work_stealing_pool pool(t);
+    auto policy = zfwstl::execution::par.on(pool);
+    const double ms = best_ms([&]
+                              { sink = value = dot ? zfwstl::transform_reduce(policy, a.begin(), a.end(), b.begin(), T(0))
+                                                   : zfwstl::reduce(policy, a.begin(), a.end(), T(0)); });
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s par x%zu", dot ? "transform_reduce" : "reduce", t);
+    report(name, n, ms, value, exact, base);
+    if (t == max_threads)
+      break;
+  }
+  (void)sink;
+}
+
+template <class T>
+static void bench_scan(const zfwstl::vector<T> &a, size_t max_threads)
+{
+  const size_t n = a.size();
+  zfwstl::vector<T> out(n, T(0));
+  const double base = best_ms([&]
+                              { zfwstl::partial_sum(a.begin(), a.end(), out.begin()); });
+  const T last = out[n - 1];
+  report("partial_sum", n, base, last, static_cast<long double>(last), base);
+  double ms = best_ms([&]
+                      { zfwstl::inclusive_scan(a.begin(), a.end(), out.begin()); });
+  report("inclusive_scan", n, ms, out[n - 1], static_cast<long double>(last), base);
+  for (size_t t = 1;; t = t * 2 > max_threads && t != max_threads ? max_threads : t * 2)
+  {
+    zfwstl::work_stealing_pool pool(t);
+    ms = best_ms([&]
+                 { zfwstl::inclusive_scan(zfwstl::execution::par.on(pool), a.begin(), a.end(), out.begin()); });
+    char name[64];
+    std::snprintf(name, sizeof(name), "inclusive_scan par x%zu", t);
+    report(name, n, ms, out[n - 1], static_cast<long double>(last), base);
+    if (t == max_threads)
+      break;
+  }
+}
+
+template <class T>
+static void run(size_t n, const char *algo, size_t max_threads)
+{
+  zfwstl::vector<T> a, b;
+  a.reserve(n);
+  b.reserve(n);
+  uint64_t seed = 1;
+  for (size_t i = 0; i < n; ++i)
+  {
+    a.push_back(static_cast<T>(static_cast<double>(splitmix64(seed) >> 11) / 9007199254740992.0));
+    b.push_back(static_cast<T>(static_cast<double>(splitmix64(seed) >> 11) / 9007199254740992.0));
+  }
+  if (std::strcmp(algo, "scan") == 0)
+    bench_scan(a, max_threads);
+  else
+    bench_sum(a, b, std::strcmp(algo, "dot") == 0, max_threads);
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+  const char *algo = argc > 2 ? argv[2] : "sum";
+  const char *type = argc > 3 ? argv[3] : "double";
+  size_t max_threads = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : std::thread::hardware_concurrency();
+  if (max_threads == 0)
+    max_threads = 1;
+  std::printf("%s n=%zu %s\n", algo, n, type);
+  if (std::strcmp(type, "float") == 0)
+    run<float>(n, algo, max_threads);
+  else
+    run<double>(n, algo, max_threads);
+  return 0;
+}
@@ -0,0 +1,200 @@
+/**
+ * 线程间队列基准测试：spsc_queue / mpmc_queue 与 mutex + zfwstl::queue 对比
+ * 线程数 t 为 1 时单线程交替放入、取出；否则 t / 2 个生产者与 t / 2 个消费者(spsc 固定为 1 + 1)
+ * 生产者每隔 64 个元素在元素里记下放入时刻，消费者取出时记录延迟，打印吞吐与延迟的 p50 / p99
+ * 批量大小 > 1 时使用 push_n / pop_n(mutex 版本一次加锁放入/取出一批)
+ * 编译: g++ -std=c++14 -O2 -pthread bench_ring_queue.cpp -o bench_ring_queue
+ * 运行: ./bench_ring_queue [spsc|mpmc|mutex, 缺省 mpmc] [元素总数, 缺省 10000000] [批量大小, 缺省 1] [队列容量, 缺省 1024]
+ *      例: for q in spsc mpmc mutex; do ./bench_ring_queue $q 10000000 1; ./bench_ring_queue $q 10000000 32; done
+ */
+#include "../../STL/ring_queue.h"
+#include "../../STL/queue.h"
+#include "../../STL/vector.h"
+#include "../../src/algorithms/algo.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now().time_since_epoch()).count();
+}
+
+struct item
+{
+  uint64_t seq;
+  int64_t stamp; // 放入时刻(ns)，0 表示不参与延迟统计
+};
+
+// 有界的 mutex + queue，接口与 ring queue 一致
+class mutex_queue
+{
+  std::mutex lock;
+  zfwstl::queue<item> q;
+  size_t cap;
+
+public:
+  explicit mutex_queue(size_t n) : cap(n) {}
+  size_t push_n(const item *first, size_t n)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    size_t cnt = 0;
+    for (; cnt < n && q.size() < cap; ++cnt)
+      q.push(first[cnt]);
+    return cnt;
+  }
+  size_t pop_n(item *result, size_t n)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    size_t cnt = 0;
+    for (; cnt < n && !q.empty(); ++cnt)
+    {
+      result[cnt] = q.front();
+      q.pop();
+    }
+    return cnt;
+  }
+  bool try_push(const item &x) { return push_n(&x, 1) == 1; }
+  bool try_pop(item &x) { return pop_n(&x, 1) == 1; }
+};
+
+template <class Queue>
+static size_t put(Queue &q, const item *batch, size_t n)
+{
+  return n == 1 ? (q.try_push(batch[0]) ? 1 : 0) : q.push_n(batch, n);
+}
+template <class Queue>
+static size_t get(Queue &q, item *batch, size_t n)
+{
+  return n == 1 ? (q.try_pop(batch[0]) ? 1 : 0) : q.pop_n(batch, n);
+}
+
+template <class Queue>
+static void produce(Queue *q, uint64_t begin, uint64_t end, size_t batch_size)
+{
+  zfwstl::vector<item> batch(batch_size);
+  for (uint64_t i = begin; i < end;)
+  {
+    const size_t n = end - i < batch_size ? static_cast<size_t>(end - i) : batch_size;
+    for (size_t k = 0; k < n; ++k)
+      batch[k] = item{i + k, (i + k) % 64 == 0 ? now_ns() : 0};
+    size_t done = 0;
+    while (done < n)
+    {
+      const size_t cnt = put(*q, batch.data() + done, n - done);
+      if (cnt == 0)
+        std::this_thread::yield();
+      done += cnt;
+    }
+    i += n;
+  }
+}
+
+template <class Queue>
+static void run(const char *name, Queue &q, int threads, uint64_t total, size_t batch_size)
+{
+  std::atomic<uint64_t> consumed(0);
+  std::mutex lat_lock;
+  zfwstl::vector<int64_t> lat;
+  uint64_t checksum = 0;
+  auto consume = [&](uint64_t quota)
+  {
+    zfwstl::vector<item> batch(batch_size);
+    zfwstl::vector<int64_t> local;
+    uint64_t sum = 0;
+    while (consumed.load(std::memory_order_relaxed) < quota)
+    {
+      const size_t cnt = get(q, batch.data(), batch_size);
+      if (cnt == 0)
+      {
+        std::this_thread::yield();
+        continue;
+      }
+      const int64_t t = now_ns();
+      for (size_t k = 0; k < cnt; ++k)
+      {
+        sum += batch[k].seq;
+        if (batch[k].stamp != 0)
+          local.push_back(t - batch[k].stamp);
+      }
+      consumed.fetch_add(cnt, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> guard(lat_lock);
+    checksum += sum;
+    for (size_t i = 0; i < local.size(); ++i)
+      lat.push_back(local[i]);
+  };
+
+  auto start = bench_clock::now();
+  if (threads == 1)
+  { // 单线程：放入一批再取出一批
+    const size_t chunk = batch_size < 64 ? 64 : batch_size;
+    for (uint64_t i = 0; i < total; i += chunk)
+    {
+      const uint64_t end = i + chunk < total ? i + chunk : total;
+      produce(&q, i, end, batch_size);
+      consume(end);
+    }
+  }
+  else
+  {
+    const int pairs = threads / 2;
+    zfwstl::vector<std::thread *> pool; // vector 的元素需要可复制，存放指针
+    for (int p = 0; p < pairs; ++p)
+      pool.push_back(new std::thread(produce<Queue>, &q, total * p / pairs, total * (p + 1) / pairs, batch_size));
+    for (int c = 0; c < pairs; ++c)
+      pool.push_back(new std::thread(consume, total));
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+      pool[i]->join();
+      delete pool[i];
+    }
+  }
+  const double sec = std::chrono::duration<double>(bench_clock::now() - start).count();
+  zfwstl::sort(lat.begin(), lat.end());
+  const bool ok = checksum == total * (total - 1) / 2;
+  std::printf("%-6s threads %2d  %7.2f Mops/s  latency p50 %8.0f ns  p99 %9.0f ns  %s\n", name, threads,
+              total / sec / 1e6, lat.empty() ? 0.0 : static_cast<double>(lat[lat.size() / 2]),
+              lat.empty() ? 0.0 : static_cast<double>(lat[lat.size() * 99 / 100]), ok ? "" : "CHECKSUM MISMATCH");
+}
+
+int main(int argc, char **argv)
+{
+  const char *kind = argc > 1 ? argv[1] : "mpmc";
+  const uint64_t total = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+  const size_t batch = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1;
+  const size_t cap = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 1024;
+  const size_t batch_size = batch == 0 ? 1 : batch;
+  std::printf("%s: %llu items, batch %zu, capacity %zu, %u hardware threads\n", kind,
+              static_cast<unsigned long long>(total), batch_size, cap, std::thread::hardware_concurrency());
+  if (std::strcmp(kind, "spsc") == 0)
+  {
+    for (int t = 1; t <= 2; ++t)
+    {
+      zfwstl::spsc_queue<item> q(cap);
+      run("spsc", q, t, total, batch_size);
+    }
+    return 0;
+  }
+  const int threads[] = {1, 2, 4, 8, 16};
+  for (int t : threads)
+  {
+    if (std::strcmp(kind, "mutex") == 0)
+    {
+      mutex_queue q(cap);
+      run("mutex", q, t, total, batch_size);
+    }
+    else
+    {
+      zfwstl::mpmc_queue<item> q(cap);
+      run("mpmc", q, t, total, batch_size);
+    }
+  }
+  return 0;
+}
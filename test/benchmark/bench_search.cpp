@@ -0,0 +1,166 @@
+/**
+ * 子串查找：在模拟的日志文本(时间戳、级别、模块名、请求路径、十六进制 id 等)中查找各种长度的标记
+ * 对比逐个起点比较的 search(带谓词的版本，即改动前的实现)、default_searcher、boyer_moore_horspool_searcher、
+ * two_way_searcher、字节串 search(SIMD，标量 / SSE2 / AVX2)，以及 find_end 的通用版本与 SIMD 版本
+ * 每个标记都放在文本的末尾附近(find_end 则在开头附近)，即需要扫描几乎整个文本；"absent" 不出现
+ * 编译: g++ -std=c++14 -O2 bench_search.cpp -o bench_search
+ * 运行: ./bench_search [文本字节数, 缺省 64000000] [search|find_end|search_n, 缺省 search]
+ *      例: for a in search find_end search_n; do ./bench_search 64000000 $a; done
+ */
+#include "../../src/algorithms/algo.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// 一行日志，例：2024-05-17T08:12:44.123Z INFO  [http.server] GET /api/v2/orders/48213 status=200 latency_ms=17 req=9f3a1c...
+static void append_log_line(std::string &out, uint64_t &seed)
+{
+  static const char *levels[] = {"INFO ", "DEBUG", "INFO ", "WARN ", "INFO "};
+  static const char *modules[] = {"http.server", "db.pool", "cache", "auth", "scheduler", "billing.worker"};
+  static const char *verbs[] = {"GET", "POST", "PUT", "DELETE"};
+  static const char *paths[] = {"/api/v2/orders/", "/api/v2/users/", "/static/js/app.", "/healthz?probe=", "/api/v1/search?q="};
+  const uint64_t r = splitmix64(seed);
+  char buf[256];
+  int len = std::snprintf(buf, sizeof(buf), "2024-05-%02u T%02u:%02u:%02u.%03uZ %s [%s] %s %s%u status=%u latency_ms=%u req=%08x%08x\n",
+                          static_cast<unsigned>(r % 28 + 1), static_cast<unsigned>(r >> 8) % 24, static_cast<unsigned>(r >> 16) % 60,
+                          static_cast<unsigned>(r >> 24) % 60, static_cast<unsigned>(r >> 32) % 1000, levels[(r >> 42) % 5],
+                          modules[(r >> 45) % 6], verbs[(r >> 48) % 4], paths[(r >> 50) % 5], static_cast<unsigned>(r >> 20) % 100000,
+                          (r >> 53) % 16 == 0 ? 500u : 200u, static_cast<unsigned>(r >> 36) % 300,
+                          static_cast<unsigned>(splitmix64(seed)), static_cast<unsigned>(r));
+  out.append(buf, static_cast<size_t>(len));
+}
+
+static const char *kLevelNames[] = {"scalar", "sse2", "avx2"};
+
+template <class F>
+static double best_ms(F f, int rounds = 3)
+{
+  double best = 1e300;
+  for (int r = 0; r < rounds; ++r)
+  {
+    auto start = bench_clock::now();
+    f();
+    const double ms = ms_since(start);
+    best = ms < best ? ms : best;
+  }
+  return best;
+}
+
+static void report(const char *token, const char *name, double ms, double base, size_t n, long pos)
+{
+  std::printf("%-34.34s %-22s %9.2f ms  %6.2f GB/s  speedup %6.2f  pos %ld\n", token, name, ms, n / (ms * 1e6), base / ms, pos);
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64000000;
+  const char *algo = argc > 2 ? argv[2] : "search";
+  std::string text;
+  uint64_t seed = 1;
+  while (text.size() < n)
+    append_log_line(text, seed);
+  const bool at_front = std::strcmp(algo, "find_end") == 0;
+  const char *tokens[] = {
+      "ERROR",
+      "status=503",
+      "[payments.gateway] connection reset by peer",
+      "FATAL [billing.worker] ledger checksum mismatch for account 0000000000 while reconciling batch 7f",
+      "absent-token-xyz"};
+  const size_t ntokens = sizeof(tokens) / sizeof(tokens[0]);
+  // 出现的标记放在末尾附近(find_end 时放在开头附近)
+  for (size_t k = 0; k + 1 < ntokens; ++k)
+  {
+    const size_t at = at_front ? 100 + k * 200 : text.size() - 1000 - k * 200;
+    text.replace(at, std::strlen(tokens[k]), tokens[k]);
+  }
+  const char *first = text.data(), *last = text.data() + text.size();
+  std::printf("%s over %zu bytes of log text\n", algo, text.size());
+
+  if (std::strcmp(algo, "search_n") == 0)
+  {
+    // 连续空格 / 连续 '9'：日志里的长串较少，随机访问版本每次可以跳过 count 个元素
+    zfwstl::vector<char> v(first, last);
+    for (int count : {4, 16, 64})
+    {
+      const double base = best_ms([&]
+                                  { volatile auto r = zfwstl::search_n_dispatch(v.begin(), v.end(), count, '9',
+                                                                                zfwstl::forward_iterator_tag()); (void)r; });
+      auto r = zfwstl::search_n(v.begin(), v.end(), count, '9');
+      const double ms = best_ms([&]
+                                { volatile auto x = zfwstl::search_n(v.begin(), v.end(), count, '9'); (void)x; });
+      char token[32];
+      std::snprintf(token, sizeof(token), "search_n '9' x%d", count);
+      report(token, "forward", base, base, text.size(), static_cast<long>(r - v.begin()));
+      report(token, "skip-ahead", ms, base, text.size(), static_cast<long>(r - v.begin()));
+    }
+    return 0;
+  }
+
+  for (size_t k = 0; k < ntokens; ++k)
+  {
+    const char *pf = tokens[k], *pl = tokens[k] + std::strlen(tokens[k]);
+    const char *result = nullptr;
+    if (at_front)
+    {
+      const double base = best_ms([&]
+                                  { result = zfwstl::find_end(first, last, pf, pl, zfwstl::equal_to<char>()); });
+      report(tokens[k], "find_end generic", base, base, text.size(), result == last ? -1L : static_cast<long>(result - first));
+      const zfwstl::simd_isa best = zfwstl::simd_detect();
+      for (int lv = 0; lv <= static_cast<int>(best); ++lv)
+      {
+        zfwstl::simd_set_level(static_cast<zfwstl::simd_isa>(lv));
+        const double ms = best_ms([&]
+                                  { result = zfwstl::find_end(first, last, pf, pl); });
+        char name[32];
+        std::snprintf(name, sizeof(name), "find_end %s", kLevelNames[lv]);
+        report(tokens[k], name, ms, base, text.size(), result == last ? -1L : static_cast<long>(result - first));
+      }
+      zfwstl::simd_set_level(best);
+      continue;
+    }
+    const double base = best_ms([&]
+                                { result = zfwstl::search(first, last, pf, pl, zfwstl::equal_to<char>()); });
+    report(tokens[k], "naive search", base, base, text.size(), result == last ? -1L : static_cast<long>(result - first));
+    double ms = best_ms([&]
+                        { result = zfwstl::search(first, last, zfwstl::make_default_searcher(pf, pl)); });
+    report(tokens[k], "default_searcher", ms, base, text.size(), result == last ? -1L : static_cast<long>(result - first));
+    const auto horspool = zfwstl::make_boyer_moore_horspool_searcher(pf, pl);
+    ms = best_ms([&]
+                 { result = zfwstl::search(first, last, horspool); });
+    report(tokens[k], "horspool", ms, base, text.size(), result == last ? -1L : static_cast<long>(result - first));
+    const auto two_way = zfwstl::make_two_way_searcher(pf, pl);
+    ms = best_ms([&]
+                 { result = zfwstl::search(first, last, two_way); });
+    report(tokens[k], "two_way", ms, base, text.size(), result == last ? -1L : static_cast<long>(result - first));
+    const zfwstl::simd_isa best = zfwstl::simd_detect();
+    for (int lv = 0; lv <= static_cast<int>(best); ++lv)
+    {
+      zfwstl::simd_set_level(static_cast<zfwstl::simd_isa>(lv));
+      ms = best_ms([&]
+                   { result = zfwstl::search(first, last, pf, pl); });
+      char name[32];
+      std::snprintf(name, sizeof(name), "simd %s", kLevelNames[lv]);
+      report(tokens[k], name, ms, base, text.size(), result == last ? -1L : static_cast<long>(result - first));
+    }
+    zfwstl::simd_set_level(best);
+  }
+  return 0;
+}
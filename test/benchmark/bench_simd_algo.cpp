@@ -0,0 +1,84 @@
+/**
+ * find / count / min_element / max_element / equal / mismatch 的 SIMD 版本与标量版本对比
+ * 对每种元素类型、每个规模分别限制指令集为 scalar / sse2 / avx2(见 simd_set_level)，打印每次调用的纳秒数
+ * find 查找不存在的值、mismatch 的两段完全相同，都要扫描整个区间；equal 用 memcmp，与指令集无关
+ * 编译: g++ -std=c++14 -O2 bench_simd_algo.cpp -o bench_simd_algo
+ * 运行: ./bench_simd_algo [find|count|min_element|max_element|equal|mismatch, 缺省 find] [最大元素个数, 缺省 1048576]
+ *      例: for a in find count min_element max_element equal mismatch; do ./bench_simd_algo $a; done
+ */
+#include "../../src/algorithms/algo.h"
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static volatile size_t sink; // 防止结果被优化掉
+
+template <class T>
+size_t run_once(const char *algo, const T *first, const T *last, const T *other)
+{
+  if (std::strcmp(algo, "count") == 0)
+    return static_cast<size_t>(zfwstl::count(first, last, T(0)));
+  if (std::strcmp(algo, "min_element") == 0)
+    return static_cast<size_t>(zfwstl::min_element(first, last) - first);
+  if (std::strcmp(algo, "max_element") == 0)
+    return static_cast<size_t>(zfwstl::max_element(first, last) - first);
+  if (std::strcmp(algo, "equal") == 0)
+    return zfwstl::equal(first, last, other);
+  if (std::strcmp(algo, "mismatch") == 0)
+    return static_cast<size_t>(zfwstl::mismatch(first, last, other).first - first);
+  return static_cast<size_t>(zfwstl::find(first, last, T(0)) - first);
+}
+
+template <class T>
+void bench(const char *algo, const char *type, size_t max_n)
+{
+  for (size_t n = 16; n <= max_n; n *= 4)
+  {
+    zfwstl::vector<T> v;
+    uint64_t seed = n;
+    for (size_t i = 0; i < n; ++i)
+    {
+      T x = static_cast<T>(splitmix64(seed));
+      v.push_back(x == T(0) ? T(1) : x); // 不含 0：find 扫描整个区间
+    }
+    zfwstl::vector<T> w(v.begin(), v.end());
+    const size_t rounds = 64 * 1024 * 1024 / (n * sizeof(T)) + 1;
+    double ns[3];
+    for (int isa = 0; isa < 3; ++isa)
+    {
+      zfwstl::simd_set_level(static_cast<zfwstl::simd_isa>(isa));
+      auto start = bench_clock::now();
+      for (size_t r = 0; r < rounds; ++r)
+        sink = run_once(algo, v.begin(), v.end(), w.begin());
+      ns[isa] = std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / rounds;
+    }
+    std::printf("%-11s %-4s n=%-8zu scalar %10.1f ns  sse2 %10.1f ns (x%5.2f)  avx2 %10.1f ns (x%5.2f)\n",
+                algo, type, n, ns[0], ns[1], ns[0] / ns[1], ns[2], ns[0] / ns[2]);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const char *algo = argc > 1 ? argv[1] : "find";
+  const size_t max_n = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1048576;
+  std::printf("detected: %s\n", zfwstl::simd_detect() == zfwstl::simd_isa_avx2   ? "avx2"
+                                : zfwstl::simd_detect() == zfwstl::simd_isa_sse2 ? "sse2"
+                                                                                 : "scalar");
+  bench<int8_t>(algo, "i8", max_n);
+  bench<uint16_t>(algo, "u16", max_n);
+  bench<int32_t>(algo, "i32", max_n);
+  bench<uint64_t>(algo, "u64", max_n);
+  return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * small_vector 与 vector 对比：模拟逐条处理消息，每条消息建一个小容器、push_back 若干元素、求和后销毁
+ * 每条消息的元素个数随机取自 [0, 最大元素个数]，打印每条消息的配置次数与耗时；
+ * 耗时按每 256 条消息一组计时，除平均值外给出组内平均耗时的 p50 / p99，反映配置器带来的长尾
+ * 元素类型: int，或 msg(32 字节的平凡结构体)
+ * 编译: g++ -std=c++14 -O2 bench_small_vector.cpp -o bench_small_vector
+ * 运行: ./bench_small_vector [消息条数, 缺省 10000000] [每条消息最大元素个数, 缺省 8] [int|msg, 缺省 int]
+ *      例: for k in 4 8 16 64; do ./bench_small_vector 10000000 $k; done
+ */
+#include "../../STL/small_vector.h"
+#include "../../STL/vector.h"
+#include "../../src/algorithms/algo.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ns_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// 统计配置次数
+struct counting_alloc
+{
+  static size_t allocs;
+  static void *allocate(size_t n)
+  {
+    ++allocs;
+    return zfwstl::new_alloc::allocate(n);
+  }
+  static void deallocate(void *p, size_t n) { zfwstl::new_alloc::deallocate(p, n); }
+};
+size_t counting_alloc::allocs = 0;
+
+struct msg
+{
+  int64_t id;
+  int64_t a, b, c;
+};
+static int64_t value_of(int x) { return x; }
+static int64_t value_of(const msg &m) { return m.id + m.c; }
+template <class T>
+T make_value(size_t i);
+template <>
+int make_value<int>(size_t i) { return static_cast<int>(i); }
+template <>
+msg make_value<msg>(size_t i) { return msg{static_cast<int64_t>(i), 1, 2, 3}; }
+
+template <class Vec>
+void bench(const char *name, const zfwstl::vector<unsigned char> &sizes)
+{
+  typedef typename Vec::value_type T;
+  const size_t group = 256;
+  zfwstl::vector<double> lat;
+  lat.reserve(sizes.size() / group + 1);
+  counting_alloc::allocs = 0;
+  int64_t sink = 0;
+  auto total_start = bench_clock::now();
+  for (size_t g = 0; g < sizes.size(); g += group)
+  {
+    const size_t end = g + group < sizes.size() ? g + group : sizes.size();
+    auto start = bench_clock::now();
+    for (size_t m = g; m < end; ++m)
+    {
+      Vec v;
+      for (size_t i = 0; i < sizes[m]; ++i)
+        v.push_back(make_value<T>(i + m));
+      for (size_t i = 0; i < v.size(); ++i)
+        sink += value_of(v[i]);
+    }
+    lat.push_back(ns_since(start) / (end - g));
+  }
+  const double total_ns = ns_since(total_start);
+  zfwstl::sort(lat.begin(), lat.end());
+  std::printf("%-13s %7.1f ns/msg  p50 %7.1f  p99 %7.1f  allocs %5.2f /msg  (%lld)\n",
+              name, total_ns / sizes.size(), lat[lat.size() / 2], lat[lat.size() * 99 / 100],
+              static_cast<double>(counting_alloc::allocs) / sizes.size(), static_cast<long long>(sink & 1));
+}
+
+template <class T>
+void run(const zfwstl::vector<unsigned char> &sizes)
+{
+  bench<zfwstl::vector<T, counting_alloc>>("vector", sizes);
+  bench<zfwstl::small_vector<T, 4, counting_alloc>>("small_vector4", sizes);
+  bench<zfwstl::small_vector<T, 8, counting_alloc>>("small_vector8", sizes);
+  bench<zfwstl::small_vector<T, 16, counting_alloc>>("small_vector16", sizes);
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+  size_t max_elems = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+  const char *type = argc > 3 ? argv[3] : "int";
+  if (max_elems > 255)
+    max_elems = 255;
+  zfwstl::vector<unsigned char> sizes;
+  sizes.reserve(n);
+  uint64_t seed = 1;
+  for (size_t i = 0; i < n; ++i)
+    sizes.push_back(static_cast<unsigned char>(splitmix64(seed) % (max_elems + 1)));
+  std::printf("%zu messages, 0..%zu %s elements each\n", n, max_elems, type);
+  if (std::strcmp(type, "msg") == 0)
+    run<msg>(sizes);
+  else
+    run<int>(sizes);
+  return 0;
+}
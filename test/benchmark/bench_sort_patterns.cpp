@@ -0,0 +1,114 @@
+/**
+ * sort 在各种输入分布上的表现，以 std::sort 作参照
+ * 分布: random 随机 / sorted 有序 / reverse 逆序 / organ 先升后降 / few 只有 4 种取值 / sawtooth 多段有序
+ * 元素类型: int(无分支分割)、int_cmp(int + 自定义比较，普通分割)、string
+ * 编译: g++ -std=c++14 -O2 bench_sort_patterns.cpp -o bench_sort_patterns
+ * 运行: ./bench_sort_patterns [元素个数, 缺省 10000000] [int|int_cmp|string, 缺省 int] [分布, 缺省全部]
+ *      例: for t in int int_cmp string; do ./bench_sort_patterns 1000000 $t; done
+ */
+#include "../../src/algorithms/algo.h"
+#include "../../STL/vector.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static const char *const kPatterns[] = {"random", "sorted", "reverse", "organ", "few", "sawtooth"};
+
+static int pattern_value(const char *pattern, size_t i, size_t n, uint64_t &seed)
+{
+  if (std::strcmp(pattern, "sorted") == 0)
+    return static_cast<int>(i);
+  if (std::strcmp(pattern, "reverse") == 0)
+    return static_cast<int>(n - i);
+  if (std::strcmp(pattern, "organ") == 0)
+    return static_cast<int>(i < n / 2 ? i : n - i);
+  if (std::strcmp(pattern, "few") == 0)
+    return static_cast<int>(splitmix64(seed) % 4);
+  if (std::strcmp(pattern, "sawtooth") == 0)
+    return static_cast<int>(i % 10000);
+  return static_cast<int>(splitmix64(seed) >> 33);
+}
+
+struct int_less // 自定义比较：zfwstl::sort 不走无分支分割
+{
+  bool operator()(int a, int b) const { return a < b; }
+};
+
+template <class T>
+T make_value(int v);
+template <>
+int make_value<int>(int v) { return v; }
+template <>
+std::string make_value<std::string>(int v)
+{
+  char buf[16];
+  std::snprintf(buf, sizeof(buf), "%010d", v); // 定长，字典序与数值顺序一致
+  return buf;
+}
+
+template <class T, class Compared>
+void bench(const char *type, const char *pattern, size_t n, Compared comp)
+{
+  zfwstl::vector<T> src;
+  src.reserve(n);
+  uint64_t seed = 1;
+  for (size_t i = 0; i < n; ++i)
+    src.push_back(make_value<T>(pattern_value(pattern, i, n, seed)));
+  double ms[2];
+  for (int which = 0; which < 2; ++which)
+  {
+    zfwstl::vector<T> v(src.begin(), src.end());
+    auto start = bench_clock::now();
+    if (which == 0)
+      zfwstl::sort(v.begin(), v.end(), comp);
+    else
+      std::sort(v.begin(), v.end(), comp);
+    ms[which] = ms_since(start);
+    if (!zfwstl::is_sorted(v.begin(), v.end(), comp))
+      std::printf("NOT SORTED\n");
+  }
+  std::printf("%-7s %-9s n=%-10zu zfwstl::sort %9.2f ms (%6.1f ns/elem)  std::sort %9.2f ms (%6.1f ns/elem)\n",
+              type, pattern, n, ms[0], ms[0] * 1e6 / n, ms[1], ms[1] * 1e6 / n);
+}
+
+static void run(const char *type, const char *pattern, size_t n)
+{
+  if (std::strcmp(type, "int_cmp") == 0)
+    bench<int>(type, pattern, n, int_less());
+  else if (std::strcmp(type, "string") == 0)
+    bench<std::string>(type, pattern, n, zfwstl::less<std::string>());
+  else
+    bench<int>(type, pattern, n, zfwstl::less<int>());
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+  const char *type = argc > 2 ? argv[2] : "int";
+  if (argc > 3)
+  {
+    run(type, argv[3], n);
+    return 0;
+  }
+  for (const char *pattern : kPatterns)
+    run(type, pattern, n);
+  return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * vector 扩容基准测试
+ * 从空 vector 逐个 push_back n 个元素，对比扩容倍数(2x / 1.5x)与原始配置器(new_alloc / malloc_alloc)；
+ * string 元素扩容时移动(不复制字符串内容)，int / 64 字节 POD 元素扩容时整块 realloc，malloc_alloc 下可能原地扩大
+ * 同时打印扩容次数与结束时的容量
+ * 编译: g++ -std=c++14 -O2 bench_vector_growth.cpp -o bench_vector_growth
+ * 运行: ./bench_vector_growth [元素个数, 缺省 10000000] [int|pod|string, 缺省 string]
+ *      例: for t in int pod string; do ./bench_vector_growth 10000000 $t; done
+ */
+#include "../../STL/vector.h"
+#include "../../src/memory/alloc.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+struct pod
+{
+  int64_t v[8];
+};
+template <class T>
+T make_value(size_t i);
+template <>
+int make_value<int>(size_t i) { return static_cast<int>(i); }
+template <>
+pod make_value<pod>(size_t i) { return pod{{static_cast<int64_t>(i)}}; }
+template <>
+std::string make_value<std::string>(size_t i) { return "message-payload-" + std::to_string(i); } // 超出短字符串缓冲区
+
+template <class T, class Alloc, class Growth>
+void bench(const char *name, size_t n)
+{
+  auto start = bench_clock::now();
+  zfwstl::vector<T, Alloc, Growth> v;
+  size_t grows = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (v.size() == v.capacity())
+      ++grows;
+    v.push_back(make_value<T>(i));
+  }
+  std::printf("%-20s %10.1f ms  grows %3zu  capacity %zu\n", name, ms_since(start), grows, v.capacity());
+}
+
+template <class T>
+void run(size_t n)
+{
+  bench<T, zfwstl::new_alloc, zfwstl::growth_2x>("new_alloc    2x", n);
+  bench<T, zfwstl::new_alloc, zfwstl::growth_1_5x>("new_alloc    1.5x", n);
+  bench<T, zfwstl::malloc_alloc, zfwstl::growth_2x>("malloc_alloc 2x", n);
+  bench<T, zfwstl::malloc_alloc, zfwstl::growth_1_5x>("malloc_alloc 1.5x", n);
+}
+
+int main(int argc, char **argv)
+{
+  const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+  const char *type = argc > 2 ? argv[2] : "string";
+  std::printf("push_back %zu %s elements\n", n, type);
+  if (std::strcmp(type, "int") == 0)
+    run<int>(n);
+  else if (std::strcmp(type, "pod") == 0)
+    run<pod>(n);
+  else
+    run<std::string>(n);
+  return 0;
+}
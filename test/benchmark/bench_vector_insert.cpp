@@ -0,0 +1,86 @@
+/**
+ * vector 批量插入基准测试
+ * fill : 准备 n 字节的缓冲区再整块写入，对比 resize(n)(先清零) 与 resize_default_init(n)(不清零)
+ * range: 在开头插入 n 个 int，对比逐个 insert、一次 insert(pos, first, last)(前向迭代器，尾部只挪一次)
+ *        与输入迭代器区间(先追加再 rotate)；逐个 insert 为平方复杂度，n 取 1 万到 10 万量级
+ * 编译: g++ -std=c++14 -O2 bench_vector_insert.cpp -o bench_vector_insert
+ * 运行: ./bench_vector_insert [fill|range, 缺省 fill] [元素个数, fill 缺省 1000000000, range 缺省 50000]
+ *      例: ./bench_vector_insert fill 4000000000; ./bench_vector_insert range 100000
+ */
+#include "../../STL/vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double ms_since(bench_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+// 只支持单趟遍历的输入迭代器：产生 [cur, end)
+struct counting_input_iter : public zfwstl::iterator<zfwstl::input_iterator_tag, int>
+{
+  int cur;
+  explicit counting_input_iter(int c) : cur(c) {}
+  int operator*() const { return cur; }
+  counting_input_iter &operator++()
+  {
+    ++cur;
+    return *this;
+  }
+  bool operator!=(const counting_input_iter &rhs) const { return cur != rhs.cur; }
+  bool operator==(const counting_input_iter &rhs) const { return cur == rhs.cur; }
+};
+
+static void bench_fill(size_t n)
+{
+  for (int mode = 0; mode < 2; ++mode)
+  {
+    auto start = bench_clock::now();
+    zfwstl::vector<char> buf;
+    if (mode == 0)
+      buf.resize(n);
+    else
+      buf.resize_default_init(n);
+    const double resize_ms = ms_since(start);
+    std::memset(buf.data(), 'x', n); // 模拟随后读入的数据
+    std::printf("%-20s resize %9.1f ms  total %9.1f ms  (%c)\n", mode == 0 ? "resize" : "resize_default_init",
+                resize_ms, ms_since(start), buf[n / 2]);
+  }
+}
+
+static void bench_range(size_t n)
+{
+  zfwstl::vector<int> src;
+  for (size_t i = 0; i < n; ++i)
+    src.push_back(static_cast<int>(i));
+  const char *names[] = {"insert one by one", "insert forward range", "insert input range"};
+  for (int mode = 0; mode < 3; ++mode)
+  {
+    zfwstl::vector<int> v(1000, -1);
+    auto start = bench_clock::now();
+    if (mode == 0)
+    {
+      for (size_t i = 0; i < n; ++i)
+        v.insert(v.begin() + i, src[i]);
+    }
+    else if (mode == 1)
+      v.insert(v.begin(), src.begin(), src.end());
+    else
+      v.insert(v.begin(), counting_input_iter(0), counting_input_iter(static_cast<int>(n)));
+    std::printf("%-20s %9.2f ms  size %zu  (%d %d)\n", names[mode], ms_since(start), v.size(), v[n - 1], v[n]);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const char *mode = argc > 1 ? argv[1] : "fill";
+  if (std::strcmp(mode, "range") == 0)
+    bench_range(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 50000);
+  else
+    bench_fill(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000000);
+  return 0;
+}
@@ -0,0 +1,129 @@
+#include "../../src/algorithms/parallel_algo.h"
+#include "../../STL/vector.h"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+static uint64_t next_rand(uint64_t &x)
+{
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+struct record
+{
+  int key;
+  int seq; // 原始位置，用于检查稳定性
+};
+struct by_key
+{
+  bool operator()(const record &a, const record &b) const { return a.key < b.key; }
+};
+
+// 测试任务池：嵌套 fork-join、异常在 wait() 中重新抛出
+void test_task_group()
+{
+  zfwstl::work_stealing_pool pool(4);
+  assert(pool.concurrency() == 4);
+  std::atomic<int> sum(0);
+  {
+    zfwstl::task_group g(pool);
+    for (int i = 0; i < 100; ++i)
+      g.run([&, i]
+            {
+              zfwstl::task_group inner(pool);
+              inner.run([&, i] { sum += i; });
+              inner.run([&, i] { sum += i; });
+              inner.wait(); });
+    g.wait();
+  }
+  assert(sum == 9900);
+  zfwstl::task_group g(pool);
+  g.run([]
+        { throw std::string("boom"); });
+  bool caught = false;
+  try
+  {
+    g.wait();
+  }
+  catch (const std::string &e)
+  {
+    caught = e == "boom";
+  }
+  assert(caught);
+  std::cout << "task_group ok" << std::endl;
+}
+
+// 测试 sort / stable_sort / merge 的 seq、par、par_unseq 版本与顺序版本结果一致
+void test_parallel_sort()
+{
+  zfwstl::work_stealing_pool pool(4);
+  uint64_t seed = 88172645463325252ull;
+  const size_t n = 300000;
+  zfwstl::vector<int> src;
+  for (size_t i = 0; i < n; ++i)
+    src.push_back(static_cast<int>(next_rand(seed) % 100000));
+
+  zfwstl::vector<int> expect(src.begin(), src.end());
+  zfwstl::sort(expect.begin(), expect.end());
+  zfwstl::vector<int> a(src.begin(), src.end());
+  zfwstl::sort(zfwstl::execution::par.on(pool), a.begin(), a.end());
+  assert(a == expect);
+  zfwstl::vector<int> b(src.begin(), src.end());
+  zfwstl::sort(zfwstl::execution::par_unseq.on(pool), b.begin(), b.end(), zfwstl::greater<int>());
+  for (size_t i = 0; i < n; ++i)
+    assert(b[i] == expect[n - 1 - i]);
+  zfwstl::vector<int> c(src.begin(), src.end());
+  zfwstl::stable_sort(zfwstl::execution::seq, c.begin(), c.end());
+  assert(c == expect);
+
+  // 大量相等键：检查稳定性
+  zfwstl::vector<record> r;
+  for (size_t i = 0; i < n; ++i)
+    r.push_back(record{static_cast<int>(next_rand(seed) % 100), static_cast<int>(i)});
+  zfwstl::vector<record> r2(r.begin(), r.end());
+  zfwstl::stable_sort(zfwstl::execution::par.on(pool), r.begin(), r.end(), by_key());
+  zfwstl::stable_sort(r2.begin(), r2.end(), by_key());
+  for (size_t i = 1; i < n; ++i)
+  {
+    assert(r[i - 1].key < r[i].key || (r[i - 1].key == r[i].key && r[i - 1].seq < r[i].seq));
+    assert(r[i].seq == r2[i].seq);
+  }
+
+  // 非平凡类型
+  zfwstl::vector<std::string> s;
+  for (size_t i = 0; i < 50000; ++i)
+    s.push_back(std::to_string(next_rand(seed) % 1000000));
+  zfwstl::vector<std::string> s2(s.begin(), s.end());
+  zfwstl::stable_sort(zfwstl::execution::par.on(pool), s.begin(), s.end());
+  zfwstl::sort(zfwstl::execution::par.on(pool), s2.begin(), s2.end());
+  assert(s == s2);
+  std::cout << "parallel sort / stable_sort ok" << std::endl;
+}
+
+void test_parallel_merge()
+{
+  zfwstl::work_stealing_pool pool(3);
+  zfwstl::vector<int> x, y;
+  for (int i = 0; i < 100000; ++i)
+    x.push_back(i * 2);
+  for (int i = 0; i < 70000; ++i)
+    y.push_back(i * 3);
+  zfwstl::vector<int> out1(x.size() + y.size(), 0), out2(x.size() + y.size(), 0);
+  auto e1 = zfwstl::merge(zfwstl::execution::par.on(pool), x.begin(), x.end(), y.begin(), y.end(), out1.begin());
+  auto e2 = zfwstl::merge(x.begin(), x.end(), y.begin(), y.end(), out2.begin());
+  assert(e1 == out1.end() && e2 == out2.end());
+  assert(out1 == out2);
+  std::cout << "parallel merge ok" << std::endl;
+}
+
+int main()
+{
+  test_task_group();
+  test_parallel_sort();
+  test_parallel_merge();
+  return 0;
+}
@@ -0,0 +1,196 @@
+#include "../../src/algorithms/parallel_algo.h"
+#include "../../STL/vector.h"
+#include "../../STL/list.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+static uint64_t next_rand(uint64_t &x)
+{
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+template <class T>
+static bool same_bits(T a, T b)
+{
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+static const zfwstl::simd_isa kLevels[] = {zfwstl::simd_isa_scalar, zfwstl::simd_isa_sse2, zfwstl::simd_isa_avx2};
+
+// 测试整数的 reduce / transform_reduce：与 accumulate / inner_product 结果相同；非随机访问迭代器；自定义运算
+void test_reduce_integer()
+{
+  zfwstl::work_stealing_pool pool(4);
+  uint64_t seed = 88172645463325252ull;
+  for (size_t n : {0, 1, 31, 32, 33, 1000, 16384, 16385, 100000})
+  {
+    zfwstl::vector<int64_t> a, b;
+    for (size_t i = 0; i < n; ++i)
+    {
+      a.push_back(static_cast<int64_t>(next_rand(seed) % 2001) - 1000);
+      b.push_back(static_cast<int64_t>(next_rand(seed) % 2001) - 1000);
+    }
+    const int64_t sum = zfwstl::accumulate(a.begin(), a.end(), int64_t(5));
+    const int64_t dot = zfwstl::inner_product(a.begin(), a.end(), b.begin(), int64_t(0));
+    assert(zfwstl::reduce(a.begin(), a.end(), int64_t(5)) == sum);
+    assert(zfwstl::reduce(a.begin(), a.end()) == sum - 5);
+    assert(zfwstl::reduce(zfwstl::execution::par.on(pool), a.begin(), a.end(), int64_t(5)) == sum);
+    assert(zfwstl::reduce(zfwstl::execution::seq, a.begin(), a.end()) == sum - 5);
+    assert(zfwstl::transform_reduce(a.begin(), a.end(), b.begin(), int64_t(0)) == dot);
+    assert(zfwstl::transform_reduce(zfwstl::execution::par_unseq.on(pool), a.begin(), a.end(), b.begin(), int64_t(0)) == dot);
+    // 一元变换：平方和
+    int64_t squares = 0;
+    for (size_t i = 0; i < n; ++i)
+      squares += a[i] * a[i];
+    auto square = [](int64_t x)
+    { return x * x; };
+    assert(zfwstl::transform_reduce(a.begin(), a.end(), int64_t(0), zfwstl::plus<int64_t>(), square) == squares);
+    assert(zfwstl::transform_reduce(zfwstl::execution::par.on(pool), a.begin(), a.end(), int64_t(0),
+                                    zfwstl::plus<int64_t>(), square) == squares);
+    // 满足结合律、交换律的其它运算
+    auto max_op = [](int64_t x, int64_t y)
+    { return x < y ? y : x; };
+    const int64_t mx = zfwstl::accumulate(a.begin(), a.end(), INT64_MIN, max_op);
+    assert(zfwstl::reduce(zfwstl::execution::par.on(pool), a.begin(), a.end(), INT64_MIN, max_op) == mx);
+    zfwstl::list<int64_t> l(a.begin(), a.end());
+    assert(zfwstl::reduce(zfwstl::execution::par.on(pool), l.begin(), l.end(), int64_t(5)) == sum);
+  }
+  // 非算术类型：字符串拼接满足结合律，块之间、块内都必须保持相对顺序(不满足交换律时顺序版本仍然正确)
+  zfwstl::vector<std::string> s;
+  std::string expect;
+  for (int i = 0; i < 40000; ++i)
+  {
+    s.push_back(std::to_string(i % 10));
+    expect += s.back();
+  }
+  assert(zfwstl::reduce(zfwstl::execution::par.on(pool), s.begin(), s.end(), std::string()) == expect);
+  std::cout << "reduce / transform_reduce (integer) ok" << std::endl;
+}
+
+// 测试浮点数：结果与指令集、是否并行、线程数都无关(逐位相同)，误差远小于 accumulate
+template <class T>
+void check_reduce_float()
+{
+  uint64_t seed = 2463534242ull;
+  zfwstl::work_stealing_pool pool2(2), pool5(5);
+  for (size_t n : {0, 1, 15, 16, 17, 33, 1000, 16384, 16385, 300001})
+  {
+    zfwstl::vector<T> a, b;
+    long double exact = 0, exact_dot = 0, abs_sum = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      a.push_back(static_cast<T>(static_cast<double>(next_rand(seed) % 2000001) / 1000.0 - 1000.0));
+      b.push_back(static_cast<T>(static_cast<double>(next_rand(seed) % 2001) / 1000.0));
+      exact += a.back();
+      abs_sum += std::fabs(static_cast<long double>(a.back()));
+      exact_dot += static_cast<long double>(a.back()) * b.back();
+    }
+    T sum[3], dot[3], kahan[3];
+    for (int lv = 0; lv < 3; ++lv)
+    {
+      zfwstl::simd_set_level(kLevels[lv]);
+      sum[lv] = zfwstl::reduce(a.begin(), a.end());
+      dot[lv] = zfwstl::transform_reduce(a.begin(), a.end(), b.begin(), T(0));
+      kahan[lv] = zfwstl::kahan_reduce(a.begin(), a.end());
+      assert(same_bits(sum[lv], sum[0]) && same_bits(dot[lv], dot[0]) && same_bits(kahan[lv], kahan[0]));
+      // 并行、不同线程数
+      assert(same_bits(zfwstl::reduce(zfwstl::execution::par.on(pool2), a.begin(), a.end()), sum[0]));
+      assert(same_bits(zfwstl::reduce(zfwstl::execution::par.on(pool5), a.begin(), a.end()), sum[0]));
+      assert(same_bits(zfwstl::transform_reduce(zfwstl::execution::par.on(pool5), a.begin(), a.end(), b.begin(), T(0)), dot[0]));
+      assert(same_bits(zfwstl::kahan_reduce(zfwstl::execution::par.on(pool2), a.begin(), a.end()), kahan[0]));
+    }
+    zfwstl::simd_set_level(zfwstl::simd_detect());
+    // 通用迭代器路径(list 从左到右)与指针路径的计算顺序不同，只比较误差
+    const long double scale = 1000.0L * (n + 1);
+    const long double eps = sizeof(T) == 4 ? 1.2e-7L : 2.3e-16L;
+    assert(std::fabs(static_cast<long double>(sum[0]) - exact) <= scale * eps * 64);
+    assert(std::fabs(static_cast<long double>(dot[0]) - exact_dot) <= scale * eps * 64);
+    const long double kahan_bound = abs_sum * (eps * 2 + n * eps * eps * 4);
+    assert(std::fabs(static_cast<long double>(kahan[0]) - exact) <= kahan_bound);
+
+    zfwstl::list<T> l(a.begin(), a.end());
+    assert(std::fabs(static_cast<long double>(zfwstl::kahan_reduce(l.begin(), l.end())) - exact) <= kahan_bound);
+  }
+  // 大量小数加到很大的部分和上：accumulate 每次都被舍掉，kahan_reduce 精确(float 的 n·eps² 项太大，只测 double)
+  if (sizeof(T) != 8)
+    return;
+  zfwstl::vector<T> c(300001, T(1));
+  c[0] = T(1e16); // 相邻 double 相差 2，1e16 + 1 舍入为 1e16
+  const T k = zfwstl::kahan_reduce(c.begin(), c.end());
+  assert(k == T(1e16) + T(300000));
+  assert(zfwstl::accumulate(c.begin(), c.end(), T(0)) == T(1e16));
+  assert(zfwstl::kahan_reduce(zfwstl::execution::par.on(pool5), c.begin(), c.end()) == k);
+}
+
+void test_reduce_float()
+{
+  check_reduce_float<double>();
+  check_reduce_float<float>();
+  std::cout << "reduce / transform_reduce / kahan_reduce (floating point) ok" << std::endl;
+}
+
+// 测试 inclusive_scan / exclusive_scan：与 partial_sum 结果相同，包括原地计算与并行版本
+void test_scan()
+{
+  zfwstl::work_stealing_pool pool(4);
+  uint64_t seed = 362436069ull;
+  for (size_t n : {0, 1, 2, 1000, 16384, 16385, 50000, 200003})
+  {
+    zfwstl::vector<int64_t> a;
+    for (size_t i = 0; i < n; ++i)
+      a.push_back(static_cast<int64_t>(next_rand(seed) % 1001) - 500);
+    zfwstl::vector<int64_t> expect(n, 0), out(n, 0);
+    zfwstl::partial_sum(a.begin(), a.end(), expect.begin());
+    assert(zfwstl::inclusive_scan(a.begin(), a.end(), out.begin()) == out.end());
+    assert(out == expect);
+    assert(zfwstl::inclusive_scan(zfwstl::execution::par.on(pool), a.begin(), a.end(), out.begin()) == out.end());
+    assert(out == expect);
+    zfwstl::inclusive_scan(zfwstl::execution::par.on(pool), a.begin(), a.end(), out.begin(), zfwstl::plus<int64_t>(), int64_t(7));
+    for (size_t i = 0; i < n; ++i)
+      assert(out[i] == expect[i] + 7);
+    zfwstl::exclusive_scan(a.begin(), a.end(), out.begin(), int64_t(7));
+    for (size_t i = 0; i < n; ++i)
+      assert(out[i] == (i == 0 ? 7 : expect[i - 1] + 7));
+    zfwstl::vector<int64_t> out2(n, 0);
+    assert(zfwstl::exclusive_scan(zfwstl::execution::par_unseq.on(pool), a.begin(), a.end(), out2.begin(), int64_t(7)) == out2.end());
+    assert(out2 == out);
+    // 原地计算
+    zfwstl::vector<int64_t> b(a.begin(), a.end()), c(a.begin(), a.end());
+    zfwstl::inclusive_scan(zfwstl::execution::par.on(pool), b.begin(), b.end(), b.begin());
+    assert(b == expect);
+    zfwstl::exclusive_scan(zfwstl::execution::par.on(pool), c.begin(), c.end(), c.begin(), int64_t(7));
+    assert(c == out);
+    zfwstl::exclusive_scan(a.begin(), a.end(), a.begin(), int64_t(7));
+    assert(a == out);
+  }
+  // 非算术类型、非随机访问迭代器
+  zfwstl::vector<std::string> s;
+  for (int i = 0; i < 40000; ++i)
+    s.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+  zfwstl::vector<std::string> s1(s.size(), std::string()), s2(s.size(), std::string());
+  zfwstl::partial_sum(s.begin(), s.end(), s1.begin());
+  zfwstl::inclusive_scan(zfwstl::execution::par.on(pool), s.begin(), s.end(), s2.begin());
+  assert(s1 == s2);
+  zfwstl::list<int> l;
+  for (int i = 1; i <= 100; ++i)
+    l.push_back(i);
+  zfwstl::vector<int> o(100, 0);
+  zfwstl::exclusive_scan(zfwstl::execution::par.on(pool), l.begin(), l.end(), o.begin(), 0);
+  assert(o[99] == 4950);
+  std::cout << "inclusive_scan / exclusive_scan ok" << std::endl;
+}
+
+int main()
+{
+  test_reduce_integer();
+  test_reduce_float();
+  test_scan();
+  return 0;
+}
@@ -0,0 +1,196 @@
+#include "../../src/algorithms/algo.h"
+#include "../../STL/vector.h"
+#include "../../STL/list.h"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+static uint64_t next_rand(uint64_t &x)
+{
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+static const zfwstl::simd_isa kLevels[] = {zfwstl::simd_isa_scalar, zfwstl::simd_isa_sse2, zfwstl::simd_isa_avx2};
+
+// 逐个起点比较的参考实现
+template <class T>
+static size_t naive_find(const zfwstl::vector<T> &s, const zfwstl::vector<T> &p, bool last_occurrence)
+{
+  size_t result = s.size();
+  for (size_t i = 0; i + p.size() <= s.size(); ++i)
+  {
+    size_t j = 0;
+    while (j < p.size() && s[i + j] == p[j])
+      ++j;
+    if (j == p.size())
+    {
+      result = i;
+      if (!last_occurrence)
+        break;
+    }
+  }
+  if (p.empty())
+    return last_occurrence ? s.size() : 0;
+  return result;
+}
+
+// 小字母表的随机文本，模式取自文本或随机生成，覆盖大量部分匹配、周期性模式
+template <class T>
+static void check_searchers(const zfwstl::vector<T> &s, const zfwstl::vector<T> &p)
+{
+  const size_t expect = naive_find(s, p, false);
+  const T *first = s.data(), *last = s.data() + s.size();
+  const T *pf = p.data(), *pl = p.data() + p.size();
+  assert(zfwstl::search(s.begin(), s.end(), p.begin(), p.end(), zfwstl::equal_to<T>()) - s.begin() == static_cast<ptrdiff_t>(expect));
+  auto d = zfwstl::search(s.begin(), s.end(), zfwstl::make_default_searcher(pf, pl));
+  assert(d - s.begin() == static_cast<ptrdiff_t>(expect));
+  auto h = zfwstl::make_boyer_moore_horspool_searcher(pf, pl)(first, last);
+  assert(h.first - first == static_cast<ptrdiff_t>(expect));
+  assert(h.second - h.first == (expect == s.size() ? 0 : static_cast<ptrdiff_t>(p.size())));
+  auto t = zfwstl::make_two_way_searcher(pf, pl)(first, last);
+  assert(t.first - first == static_cast<ptrdiff_t>(expect));
+  assert(t.second - t.first == (expect == s.size() ? 0 : static_cast<ptrdiff_t>(p.size())));
+  // 非缺省的序：相等由 comp 推出，不用跳跃表
+  auto g = zfwstl::make_two_way_searcher(pf, pl, zfwstl::greater<T>())(first, last);
+  assert(g.first - first == static_cast<ptrdiff_t>(expect));
+}
+
+static void check_bytes(const zfwstl::vector<char> &s, const zfwstl::vector<char> &p)
+{
+  check_searchers(s, p);
+  const size_t expect = naive_find(s, p, false);
+  const size_t expect_last = naive_find(s, p, true);
+  const char *first = s.data(), *last = s.data() + s.size();
+  for (zfwstl::simd_isa lv : kLevels)
+  {
+    zfwstl::simd_set_level(lv);
+    assert(zfwstl::search(first, last, p.data(), p.data() + p.size()) - first == static_cast<ptrdiff_t>(expect));
+    assert(zfwstl::search(first, last, zfwstl::make_simd_searcher(p.data(), p.data() + p.size())) - first ==
+           static_cast<ptrdiff_t>(expect));
+    assert(zfwstl::find_end(first, last, p.data(), p.data() + p.size()) - first == static_cast<ptrdiff_t>(expect_last));
+  }
+  zfwstl::simd_set_level(zfwstl::simd_detect());
+  // 通用的 find_end(逆向迭代器上的 search)
+  assert(zfwstl::find_end(first, last, p.data(), p.data() + p.size(), zfwstl::equal_to<char>()) - first ==
+         static_cast<ptrdiff_t>(expect_last));
+  zfwstl::list<char> l(s.begin(), s.end());
+  auto it = zfwstl::find_end(l.begin(), l.end(), p.begin(), p.end());
+  assert(static_cast<size_t>(zfwstl::distance(l.begin(), it)) == expect_last);
+}
+
+// 测试各查找器及字节串 search / find_end 的 SIMD 版本与逐个比较的结果一致
+void test_searchers()
+{
+  uint64_t seed = 88172645463325252ull;
+  for (int alphabet : {2, 4, 26})
+  {
+    for (size_t n : {0, 1, 15, 16, 17, 31, 32, 33, 64, 100, 1000})
+    {
+      zfwstl::vector<char> s;
+      for (size_t i = 0; i < n; ++i)
+        s.push_back(static_cast<char>('a' + next_rand(seed) % alphabet));
+      for (size_t m : {0, 1, 2, 3, 5, 8, 17, 40})
+      {
+        for (int trial = 0; trial < 4; ++trial)
+        {
+          zfwstl::vector<char> p;
+          if (trial < 2 && m <= n)
+          {
+            const size_t at = next_rand(seed) % (n - m + 1); // 一定出现
+            p.assign(s.begin() + at, s.begin() + at + m);
+          }
+          else
+          {
+            for (size_t i = 0; i < m; ++i)
+              p.push_back(static_cast<char>('a' + next_rand(seed) % alphabet));
+          }
+          check_bytes(s, p);
+        }
+      }
+    }
+  }
+  // 周期性模式、只在末尾出现、高位字节(负的 char)
+  zfwstl::vector<char> s(5000, 'a'), p(300, 'a');
+  check_bytes(s, p);
+  p.back() = 'b';
+  check_bytes(s, p);
+  s.back() = 'b';
+  check_bytes(s, p);
+  for (size_t i = 0; i < s.size(); ++i)
+    s[i] = static_cast<char>("ab\xff"[i % 3]);
+  zfwstl::vector<char> q{'\xff', 'a', 'b', '\xff', 'a'};
+  check_bytes(s, q);
+
+  // 非字节类型：哈希分桶的 Horspool 跳跃表、双向算法
+  for (size_t n : {0, 10, 1000, 20000})
+  {
+    zfwstl::vector<int> a;
+    for (size_t i = 0; i < n; ++i)
+      a.push_back(static_cast<int>(next_rand(seed) % 3) * 256); // 全部落在同一个桶
+    for (size_t m : {1, 2, 7, 30})
+    {
+      zfwstl::vector<int> p;
+      if (m <= n)
+        p.assign(a.begin() + (n - m), a.end());
+      else
+        p.assign(m, 0);
+      check_searchers(a, p);
+      p.back() = 1;
+      check_searchers(a, p);
+    }
+  }
+  std::cout << "searchers ok" << std::endl;
+}
+
+// 测试 search_n：随机访问迭代器的跳跃版本与前向迭代器版本一致
+void test_search_n()
+{
+  uint64_t seed = 2463534242ull;
+  for (size_t n : {0, 1, 5, 100, 3000})
+  {
+    zfwstl::vector<int> v;
+    for (size_t i = 0; i < n; ++i)
+      v.push_back(next_rand(seed) % 4 == 0 ? 1 : 0);
+    zfwstl::list<int> l(v.begin(), v.end());
+    for (int count : {0, 1, 2, 3, 4, 7, 20})
+    {
+      for (int value : {0, 1, 2})
+      {
+        auto r1 = zfwstl::search_n(v.begin(), v.end(), count, value);
+        auto r2 = zfwstl::search_n(l.begin(), l.end(), count, value);
+        assert(r1 - v.begin() == zfwstl::distance(l.begin(), r2));
+        auto r3 = zfwstl::search_n(v.begin(), v.end(), count, value, zfwstl::equal_to<int>());
+        auto r4 = zfwstl::search_n(l.begin(), l.end(), count, value, zfwstl::equal_to<int>());
+        assert(r3 == r1 && r4 == r2);
+        // 参考实现
+        size_t expect = n;
+        if (count <= 0)
+          expect = 0;
+        for (size_t i = 0; count > 0 && i + count <= n; ++i)
+        {
+          int j = 0;
+          while (j < count && v[i + j] == value)
+            ++j;
+          if (j == count)
+          {
+            expect = i;
+            break;
+          }
+        }
+        assert(r1 - v.begin() == static_cast<ptrdiff_t>(expect));
+      }
+    }
+  }
+  std::cout << "search_n ok" << std::endl;
+}
+
+int main()
+{
+  test_searchers();
+  test_search_n();
+  return 0;
+}
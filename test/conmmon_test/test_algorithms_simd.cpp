@@ -0,0 +1,118 @@
+#include "../../src/algorithms/algo.h"
+#include "../../STL/vector.h"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+static uint64_t next_rand(uint64_t &x)
+{
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+// 逐个比较的参照结果
+template <class T>
+void check_range(const zfwstl::vector<T> &v, const zfwstl::vector<T> &w, T value)
+{
+  const T *first = v.begin(), *last = v.end();
+  const T *f = first;
+  while (f != last && *f != value)
+    ++f;
+  assert(zfwstl::find(first, last, value) == f);
+  ptrdiff_t c = 0;
+  for (const T *p = first; p != last; ++p)
+    c += *p == value;
+  assert(zfwstl::count(first, last, value) == c);
+  const T *mn = first, *mx = first;
+  for (const T *p = first; p != last; ++p)
+  {
+    if (*p < *mn)
+      mn = p;
+    if (*mx < *p)
+      mx = p;
+  }
+  assert(zfwstl::min_element(first, last) == mn);
+  assert(zfwstl::max_element(first, last) == mx);
+  size_t i = 0;
+  while (i != v.size() && v[i] == w[i])
+    ++i;
+  auto mm = zfwstl::mismatch(first, last, w.begin());
+  assert(mm.first == first + i && mm.second == w.begin() + i);
+  assert(zfwstl::equal(first, last, w.begin()) == (i == v.size()));
+  assert(zfwstl::equal(first, last, w.begin(), w.end()) == (i == v.size()));
+}
+
+// 各种长度(含不足一个向量的尾部)、取值范围很小(大量重复)与完整范围的数据
+template <class T>
+void check_type(uint64_t &seed)
+{
+  for (size_t n = 0; n < 200; n += (n < 70 ? 1 : 13))
+  {
+    for (uint64_t range : {uint64_t(3), uint64_t(0)})
+    {
+      zfwstl::vector<T> v;
+      for (size_t i = 0; i < n; ++i)
+      {
+        const uint64_t r = next_rand(seed);
+        v.push_back(static_cast<T>(range ? r % range : r));
+      }
+      zfwstl::vector<T> w(v.begin(), v.end());
+      if (n != 0)
+        w[next_rand(seed) % n] ^= 1; // 某一处不同
+      check_range(v, v, n ? v[n - 1] : T(0));
+      check_range(v, w, T(1));
+      check_range(v, w, n ? v[n / 2] : T(0));
+    }
+  }
+}
+
+void check_all(const char *name)
+{
+  uint64_t seed = 88172645463325252ull;
+  check_type<int8_t>(seed);
+  check_type<uint8_t>(seed);
+  check_type<char>(seed);
+  check_type<int16_t>(seed);
+  check_type<uint16_t>(seed);
+  check_type<int32_t>(seed);
+  check_type<uint32_t>(seed);
+  check_type<int64_t>(seed);
+  check_type<uint64_t>(seed);
+  std::cout << "simd algorithms (" << name << ") ok" << std::endl;
+}
+
+// 查找值与元素类型不同：按 == 的语义，值换成元素类型后变了的查不到
+void test_value_conversion()
+{
+  zfwstl::vector<unsigned char> u;
+  for (int i = 0; i < 100; ++i)
+    u.push_back(static_cast<unsigned char>(i * 7));
+  assert(zfwstl::find(u.begin(), u.end(), -1) == u.end());
+  assert(zfwstl::find(u.begin(), u.end(), 7 + 256) == u.end());
+  assert(zfwstl::find(u.begin(), u.end(), 7) == u.begin() + 1);
+  assert(zfwstl::count(u.begin(), u.end(), 300) == 0);
+  zfwstl::vector<unsigned> w(40, 0xFFFFFFFFu);
+  assert(zfwstl::count(w.begin(), w.end(), -1) == 40); // -1 转成 unsigned 后相等
+  assert(zfwstl::count(w.begin(), w.end(), -1LL) == 0); // unsigned 提升为 long long，不等于 -1
+  zfwstl::vector<int64_t> big(50, 5);
+  big[33] = INT64_MIN;
+  big[44] = INT64_MAX;
+  assert(zfwstl::min_element(big.begin(), big.end()) == big.begin() + 33);
+  assert(zfwstl::max_element(big.begin(), big.end()) == big.begin() + 44);
+  std::cout << "value conversion ok" << std::endl;
+}
+
+int main()
+{
+  // 依次限制到标量、SSE2、AVX2，CPU 不支持的级别会退回已支持的最高级别
+  zfwstl::simd_set_level(zfwstl::simd_isa_scalar);
+  check_all("scalar");
+  zfwstl::simd_set_level(zfwstl::simd_isa_sse2);
+  check_all("sse2");
+  zfwstl::simd_set_level(zfwstl::simd_isa_avx2);
+  check_all("avx2");
+  test_value_conversion();
+  return 0;
+}
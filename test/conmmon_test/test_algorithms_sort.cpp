@@ -0,0 +1,195 @@
+#include "../../src/algorithms/algo.h"
+#include "../../STL/vector.h"
+#include <cassert>
+#include <cstdint>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+static uint64_t next_rand(uint64_t &x)
+{
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+
+struct record
+{
+  int64_t key;
+  std::string name; // 非平凡类型：走移动构造缓冲区的路径
+  size_t seq;       // 原始位置，用于检查稳定性
+};
+struct record_key
+{
+  int64_t operator()(const record &r) const { return r.key; }
+};
+struct record_less
+{
+  bool operator()(const record &a, const record &b) const { return a.key < b.key; }
+};
+
+// 几种会让快排退化的输入分布
+enum pattern
+{
+  kRandom,
+  kSorted,
+  kReverse,
+  kOrganPipe, // 先升后降
+  kFewUnique,
+  kAllEqual,
+  kSawtooth, // 多段有序
+  kPatternCount
+};
+
+static int pattern_value(pattern p, size_t i, size_t n, uint64_t &seed)
+{
+  switch (p)
+  {
+  case kRandom:
+    return static_cast<int>(next_rand(seed) % 1000000007);
+  case kSorted:
+    return static_cast<int>(i);
+  case kReverse:
+    return static_cast<int>(n - i);
+  case kOrganPipe:
+    return static_cast<int>(i < n / 2 ? i : n - i);
+  case kFewUnique:
+    return static_cast<int>(next_rand(seed) % 4);
+  case kAllEqual:
+    return 7;
+  default:
+    return static_cast<int>(i % 1000);
+  }
+}
+
+struct int_greater // 非缺省比较：走普通分割
+{
+  bool operator()(int a, int b) const { return a > b; }
+};
+
+// 测试 sort：各种分布、大小，无分支分割(int + less)与普通分割(自定义比较、string)都与 stable_sort 结果一致
+void test_sort_patterns()
+{
+  uint64_t seed = 362436069ull;
+  for (size_t n : {0, 1, 2, 5, 24, 25, 100, 129, 1000, 4097, 100000})
+  {
+    for (int p = 0; p < kPatternCount; ++p)
+    {
+      zfwstl::vector<int> src;
+      for (size_t i = 0; i < n; ++i)
+        src.push_back(pattern_value(static_cast<pattern>(p), i, n, seed));
+      zfwstl::vector<int> a(src.begin(), src.end()), b(src.begin(), src.end());
+      zfwstl::sort(a.begin(), a.end());
+      zfwstl::stable_sort(b.begin(), b.end());
+      assert(a == b);
+      zfwstl::vector<int> c(src.begin(), src.end()), d(src.begin(), src.end());
+      zfwstl::sort(c.begin(), c.end(), int_greater());
+      zfwstl::stable_sort(d.begin(), d.end(), int_greater());
+      assert(c == d);
+      if (n <= 4097)
+      {
+        zfwstl::vector<std::string> e, f;
+        for (size_t i = 0; i < n; ++i)
+          e.push_back(std::to_string(src[i]));
+        f = e;
+        zfwstl::sort(e.begin(), e.end());
+        zfwstl::stable_sort(f.begin(), f.end());
+        assert(e == f);
+      }
+    }
+  }
+  // 专门构造的 median-of-3 杀手序列，不能退化成平方
+  const size_t n = 1 << 16;
+  zfwstl::vector<int> killer(n, 0);
+  for (size_t i = 0; i < n / 2; ++i)
+  {
+    killer[2 * i] = static_cast<int>(i % 2 ? n / 2 + i : i + 1);
+    killer[2 * i + 1] = static_cast<int>(i % 2 ? i + 1 : n / 2 + i);
+  }
+  zfwstl::sort(killer.begin(), killer.end());
+  assert(zfwstl::is_sorted(killer.begin(), killer.end()));
+  std::cout << "sort patterns ok" << std::endl;
+}
+
+template <class T>
+void check_radix(const zfwstl::vector<T> &src)
+{
+  zfwstl::vector<T> a(src.begin(), src.end());
+  zfwstl::vector<T> b(src.begin(), src.end());
+  zfwstl::radix_sort(a.begin(), a.end());
+  zfwstl::sort(b.begin(), b.end());
+  assert(a == b);
+}
+
+// 测试基数排序：无符号、有符号、浮点数键，与 sort 结果一致
+void test_radix_sort()
+{
+  uint64_t seed = 88172645463325252ull;
+  for (size_t n : {0, 1, 100, 129, 5000, 100000})
+  {
+    zfwstl::vector<uint32_t> u32;
+    zfwstl::vector<int64_t> i64;
+    zfwstl::vector<int8_t> i8;
+    zfwstl::vector<double> f64;
+    zfwstl::vector<float> f32;
+    for (size_t i = 0; i < n; ++i)
+    {
+      const uint64_t r = next_rand(seed);
+      u32.push_back(static_cast<uint32_t>(r));
+      i64.push_back(static_cast<int64_t>(r));
+      i8.push_back(static_cast<int8_t>(r));
+      f64.push_back((static_cast<double>(r % 2000001) - 1000000.0) / 7.0);
+      f32.push_back(static_cast<float>(static_cast<int64_t>(r % 20001) - 10000) * 0.25f);
+    }
+    check_radix(u32);
+    check_radix(i64);
+    check_radix(i8);
+    check_radix(f64);
+    check_radix(f32);
+  }
+  // 高位字节全相同(跳过的趟)、极值
+  zfwstl::vector<int32_t> small;
+  for (int i = 0; i < 1000; ++i)
+    small.push_back(static_cast<int32_t>(next_rand(seed) % 7) - 3);
+  small.push_back(INT32_MIN);
+  small.push_back(INT32_MAX);
+  check_radix(small);
+  zfwstl::vector<double> special;
+  for (int i = 0; i < 300; ++i)
+    special.push_back(i % 3 == 0 ? -0.5 * i : 0.25 * i);
+  special.push_back(-HUGE_VAL);
+  special.push_back(HUGE_VAL);
+  special.push_back(-0.0);
+  check_radix(special);
+  std::cout << "radix_sort ok" << std::endl;
+}
+
+// 测试键提取版本：稳定，且支持非平凡元素
+void test_radix_sort_key()
+{
+  uint64_t seed = 2463534242ull;
+  zfwstl::vector<record> r;
+  for (size_t i = 0; i < 20000; ++i)
+  {
+    const int64_t k = static_cast<int64_t>(next_rand(seed) % 500) - 250;
+    r.push_back(record{k, std::to_string(k), i});
+  }
+  zfwstl::vector<record> s(r.begin(), r.end());
+  zfwstl::radix_sort(r.begin(), r.end(), record_key());
+  zfwstl::stable_sort(s.begin(), s.end(), record_less());
+  for (size_t i = 0; i < r.size(); ++i)
+  {
+    assert(r[i].key == s[i].key && r[i].seq == s[i].seq);
+    assert(r[i].name == std::to_string(r[i].key));
+  }
+  std::cout << "radix_sort with key extractor ok" << std::endl;
+}
+
+int main()
+{
+  test_sort_patterns();
+  test_radix_sort();
+  test_radix_sort_key();
+  return 0;
+}
@@ -2,6 +2,8 @@
 #include "/home/zhoufeiwei/Desktop/STLofZFW/src/memory/alloc.cpp"
 #include <iostream>
 #include <limits> // for numeric_limits
+#include <thread> // for std::thread
+#include <vector>
 
 // 测试：一级配置器
 void test_reallocation()
@@ -29,19 +31,49 @@ void test_reallocation()
 void test_second_level_allocator()
 {
   const size_t size = 356; // 小于 __MAX_BYTES
-  void *ptr = zfwstl::__default_alloc_template::allocate(size);
+  void *ptr = zfwstl::single_client_alloc::allocate(size);
   std::cout << "Allocated " << size << " bytes at " << ptr << std::endl;
 
   // 模拟使用内存
   std::memset(ptr, 0xFF, size);
 
-  zfwstl::__default_alloc_template::deallocate(ptr, size);
+  zfwstl::single_client_alloc::deallocate(ptr, size);
   std::cout << "Deallocated memory at " << ptr << std::endl;
 }
 
+// 测试线程缓存版本的二级配置器：多个线程交错分配、释放，跨线程释放
+void test_multithreaded_allocator()
+{
+  const int nthreads = 4;
+  const int rounds = 10000;
+  std::vector<void *> shared(nthreads * 64, nullptr);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nthreads; ++t)
+  {
+    workers.emplace_back([t, &shared]()
+                         {
+      for (int i = 0; i < rounds; ++i)
+      {
+        size_t n = 8 + (i % 16) * 8; // 8 ~ 128 bytes
+        void *p = zfwstl::multithreaded_alloc::allocate(n);
+        std::memset(p, t, n);
+        zfwstl::multithreaded_alloc::deallocate(p, n);
+      }
+      // 留下一些区块由主线程释放
+      for (int i = 0; i < 64; ++i)
+        shared[t * 64 + i] = zfwstl::multithreaded_alloc::allocate(32); });
+  }
+  for (auto &w : workers)
+    w.join();
+  for (auto p : shared)
+    zfwstl::multithreaded_alloc::deallocate(p, 32);
+  std::cout << "multithreaded_alloc: " << nthreads << " threads x " << rounds << " rounds done" << std::endl;
+}
+
 int main()
 {
   test_reallocation();
   test_second_level_allocator();
+  test_multithreaded_allocator();
   return 0;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "../src/functional.h"
 #include <iostream>
+#include <string>
 int main()
 {
   /**
@@ -71,5 +72,21 @@ int main()
   std::cout << zfwstl::logical_and<int>()(true, true) << std::endl;
   std::cout << zfwstl::logical_or<int>()(true, false) << std::endl;
   std::cout << zfwstl::logical_not<int>()(true) << std::endl;
+  /**
+   * functor-hash
+   */
+  // 字符串按内容哈希，相同内容得到相同哈希值
+  std::string s1 = "zhoufeiwei", s2 = "zhoufeiwei";
+  std::cout << (zfwstl::hash<std::string>()(s1) == zfwstl::hash<std::string>()(s2)) << std::endl;
+  std::cout << zfwstl::hash_bytes(s1.data(), s1.size()) << std::endl;
+  // 整数缺省返回原值，mixed_hash 再做一次雪崩混合
+  std::cout << zfwstl::hash<int>()(42) << " " << zfwstl::mixed_hash<int>()(42) << std::endl;
+  // +0.0 与 -0.0 的哈希值相同
+  std::cout << (zfwstl::hash<double>()(0.0) == zfwstl::hash<double>()(-0.0)) << std::endl;
+  // 组合多个字段的哈希值
+  size_t seed = 0;
+  zfwstl::hash_combine(seed, 1);
+  zfwstl::hash_combine(seed, s1);
+  std::cout << seed << std::endl;
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "../../src/memory/memory_resource.h"
+#include "../../STL/vector.h"
+#include "../../STL_2/map.h"
+#include "../../STL_2/unordered_map.h"
+#include <cassert>
+#include <iostream>
+
+typedef zfwstl::vector<int, zfwstl::resource_alloc> rvector;
+typedef zfwstl::map<int, int, zfwstl::less<int>, zfwstl::resource_alloc> rmap;
+typedef zfwstl::unordered_map<int, int, zfwstl::hash<int>, zfwstl::equal_to<int>, zfwstl::resource_alloc> runordered_map;
+
+// 测试单调缓冲资源：初始缓冲区用完后向上游申请，release() 后回到初始缓冲区
+void test_monotonic_buffer_resource()
+{
+  char buffer[256];
+  zfwstl::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+  void *p1 = arena.allocate(100);
+  assert(p1 == buffer);
+  void *p2 = arena.allocate(1, 64);
+  assert(reinterpret_cast<uintptr_t>(p2) % 64 == 0);
+  void *p3 = arena.allocate(1000); // 超出初始缓冲区
+  assert(p3 < (void *)buffer || p3 >= (void *)(buffer + sizeof(buffer)));
+  arena.release();
+  assert(arena.allocate(8) == buffer);
+  // 过大的请求抛出 bad_alloc，而不是长度计算溢出后返回过小的区块或死循环
+  const size_t huge[] = {static_cast<size_t>(-1), static_cast<size_t>(-1) - 64, static_cast<size_t>(-1) / 2 + 1};
+  for (size_t bytes : huge)
+  {
+    bool thrown = false;
+    try
+    {
+      arena.allocate(bytes);
+    }
+    catch (const std::bad_alloc &)
+    {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+  assert(arena.allocate(8) != nullptr);
+  std::cout << "monotonic_buffer_resource ok" << std::endl;
+}
+
+// 测试非同步池资源：释放后的区块被复用，大区块直接交给上游
+void test_unsynchronized_pool_resource()
+{
+  zfwstl::unsynchronized_pool_resource pool;
+  void *p = pool.allocate(24);
+  pool.deallocate(p, 24);
+  assert(pool.allocate(32) == p); // 24 与 32 同属 32 bytes 类别
+  void *big = pool.allocate(100000);
+  pool.deallocate(big, 100000);
+  void *aligned = pool.allocate(10, 256);
+  assert(reinterpret_cast<uintptr_t>(aligned) % 256 == 0);
+  // 小于对齐要求的请求按对齐要求选择大小类别，每个区块都对齐
+  void *small[128];
+  for (int i = 0; i < 128; ++i)
+  {
+    const size_t bytes = i % 2 == 0 ? 8 : 24;
+    small[i] = pool.allocate(bytes, 16);
+    assert(reinterpret_cast<uintptr_t>(small[i]) % 16 == 0);
+  }
+  for (int i = 0; i < 128; ++i)
+    pool.deallocate(small[i], i % 2 == 0 ? 8 : 24, 16);
+  assert(pool.allocate(16) == small[126]); // 8 bytes/16 对齐的区块回到 16 bytes 类别
+  pool.release();
+  std::cout << "unsynchronized_pool_resource ok" << std::endl;
+}
+
+// 测试容器通过 resource_alloc 使用当前资源
+void test_containers_on_resource()
+{
+  zfwstl::monotonic_buffer_resource arena;
+  zfwstl::unsynchronized_pool_resource pool;
+  {
+    zfwstl::scoped_resource guard(&arena);
+    rvector v;
+    rmap m;
+    runordered_map um;
+    for (int i = 0; i < 1000; ++i)
+    {
+      v.push_back(i);
+      m[i] = i;
+      um[i] = i;
+    }
+    assert(v.size() == 1000 && m.size() == 1000 && um.size() == 1000);
+    {
+      // 嵌套作用域换用池资源，旧容器的区块仍归还给 arena
+      zfwstl::scoped_resource inner(&pool);
+      rvector w(v.begin(), v.end());
+      v.push_back(1000);
+      assert(w.size() == 1000 && v.size() == 1001);
+    }
+  }
+  assert(zfwstl::get_default_resource() == zfwstl::new_delete_resource());
+  arena.release();
+  std::cout << "containers on memory_resource ok" << std::endl;
+}
+
+int main()
+{
+  test_monotonic_buffer_resource();
+  test_unsynchronized_pool_resource();
+  test_containers_on_resource();
+  return 0;
+}
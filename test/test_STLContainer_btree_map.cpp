@@ -0,0 +1,356 @@
+#ifndef GOOGLETEST_SAMPLES_btree_map_H_
+#define GOOGLETEST_SAMPLES_btree_map_H_
+#include "../../googletest-1.14.0/googletest/include/gtest/gtest.h"
+#include <iostream>
+#include <cstddef> // for size_t, ptrdiff_t
+#include <cstdint> // for uint64_t
+#include <string>
+#include "../STL_2/btree_map.h"
+#include "../STL_2/btree_set.h"
+#include "../STL_2/btree_multimap.h"
+#include "../STL_2/map.h"
+#include "../STL_2/multimap.h"
+#include "../src/util.h" // for pair, move
+/**
+ * AContainerTestBtreeMap: B+ tree 有序容器测试类
+ * -----------------------------------------------------
+ * Constructor：各种构造函数(区间构造走有序建树)
+ * InsertFind：insert / operator[] / find / lower_bound / upper_bound / 透明查找
+ * Iterate：正反向遍历、跨叶节点的 ++ / --
+ * EraseRebalance：随机插入删除，与 map 逐一对照并校验树结构(借元素、合并、树高下降)
+ * BtreeMultimap：重复键的插入顺序、equal_range、按键删除
+ * BtreeSet：btree_set 基本操作
+ * BigKey：键比节点还大时每个节点取最少的 4 个槽位，仍能正常分裂与查找
+ */
+void print_start()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[----------------- Run container test : btree_map -----------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+}
+void print_process(string tmp)
+{
+  std::cout << "[---- " << tmp << " ----]\n";
+}
+// 节点只有 64 字节的小树：叶节点 8 个元素、内部节点 4 个键，几百个元素就有好几层，便于覆盖分裂与合并
+typedef zfwstl::btree<int, int, zfwstl::identity<int>, zfwstl::less<int>, zfwstl::alloc, 64> small_tree;
+
+static uint64_t next_rand(uint64_t &x)
+{
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+// 测试类
+class AContainerTestBtreeMap : public ::testing::Test
+{
+protected:
+  zfwstl::btree_map<int, int> imap;
+
+  void SetUp() override
+  {
+    for (int i = 0; i < 1000; ++i)
+      imap[i] = i * 10;
+  }
+};
+//===============测试用例开始===============
+TEST_F(AContainerTestBtreeMap, Constructor)
+{
+  print_process("Default constructor");
+  zfwstl::btree_map<int, int> v1;
+  EXPECT_TRUE(v1.empty());
+  EXPECT_EQ(v1.begin(), v1.end());
+  EXPECT_TRUE(v1.__btree_verify());
+
+  print_process("Copy constructor");
+  zfwstl::btree_map<int, int> v2(imap);
+  EXPECT_EQ(v2, imap);
+  EXPECT_TRUE(v2.__btree_verify());
+
+  print_process("Move constructor");
+  zfwstl::btree_map<int, int> v3(zfwstl::move(v2));
+  EXPECT_EQ(v3, imap);
+  EXPECT_TRUE(v2.empty());
+
+  print_process("range constructor");
+  zfwstl::btree_map<int, int> v4(imap.begin(), imap.end());
+  EXPECT_EQ(v4, imap);
+  EXPECT_TRUE(v4.__btree_verify());
+
+  print_process("initializer_list constructor");
+  zfwstl::btree_map<int, const char *> v5({{3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}});
+  EXPECT_EQ(v5.size(), 3);
+  EXPECT_STREQ(v5[1], "one");
+  EXPECT_STREQ(v5.begin()->second, "one");
+
+  print_process("Assignment operator");
+  zfwstl::btree_map<int, int> v6;
+  v6 = imap;
+  EXPECT_EQ(v6, imap);
+  v6 = zfwstl::move(v4);
+  EXPECT_EQ(v6, imap);
+  v6 = {{5, 5}};
+  EXPECT_EQ(v6.size(), 1);
+  EXPECT_LT(imap, v6);
+}
+TEST_F(AContainerTestBtreeMap, InsertFind)
+{
+  print_process("insert");
+  auto res = imap.insert(zfwstl::pair<const int, int>(5000, 1));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(res.first->second, 1);
+  res = imap.insert(zfwstl::pair<const int, int>(5000, 2));
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(res.first->second, 1);
+  EXPECT_EQ(imap.size(), 1001);
+
+  print_process("find / count");
+  for (int i = 0; i < 1000; ++i)
+  {
+    auto it = imap.find(i);
+    ASSERT_NE(it, imap.end());
+    EXPECT_EQ(it->second, i * 10);
+  }
+  EXPECT_EQ(imap.find(-1), imap.end());
+  EXPECT_EQ(imap.count(500), 1);
+  EXPECT_EQ(imap.count(1500), 0);
+
+  print_process("lower_bound / upper_bound");
+  zfwstl::btree_map<int, int> v1;
+  for (int i = 0; i < 1000; ++i)
+    v1[i * 2] = i;
+  EXPECT_EQ(v1.lower_bound(10)->first, 10);
+  EXPECT_EQ(v1.lower_bound(11)->first, 12);
+  EXPECT_EQ(v1.upper_bound(10)->first, 12);
+  EXPECT_EQ(v1.lower_bound(-5), v1.begin());
+  EXPECT_EQ(v1.upper_bound(1998), v1.end());
+  auto range = v1.equal_range(100);
+  EXPECT_EQ(range.first->first, 100);
+  EXPECT_EQ(range.second->first, 102);
+
+  print_process("string key / transparent lookup");
+  zfwstl::btree_map<std::string, int, zfwstl::less<>> smap;
+  smap["banana"] = 2;
+  smap["apple"] = 1;
+  smap[std::string("cherry")] = 3;
+  EXPECT_EQ(smap.begin()->first, "apple");
+  EXPECT_EQ(smap.find("banana")->second, 2);
+  EXPECT_EQ(smap.count("durian"), 0);
+  EXPECT_EQ(smap.lower_bound("b")->first, "banana");
+  EXPECT_EQ(smap.erase("apple"), 1);
+  EXPECT_EQ(smap.size(), 2);
+}
+TEST_F(AContainerTestBtreeMap, Iterate)
+{
+  print_process("forward");
+  int expect = 0;
+  for (auto it = imap.begin(); it != imap.end(); ++it, ++expect)
+    ASSERT_EQ(it->first, expect);
+  EXPECT_EQ(expect, 1000);
+
+  print_process("backward");
+  expect = 999;
+  for (auto it = imap.rbegin(); it != imap.rend(); ++it, --expect)
+    ASSERT_EQ(it->first, expect);
+  EXPECT_EQ(expect, -1);
+  auto last = imap.end();
+  --last;
+  EXPECT_EQ(last->first, 999);
+
+  print_process("modify value through iterator");
+  for (auto &kv : imap)
+    kv.second = -kv.first;
+  EXPECT_EQ(imap[123], -123);
+
+  print_process("const_iterator");
+  const zfwstl::btree_map<int, int> &cref = imap;
+  EXPECT_EQ(zfwstl::distance(cref.begin(), cref.end()), 1000);
+  EXPECT_EQ(cref.find(7)->second, -7);
+}
+TEST_F(AContainerTestBtreeMap, EraseRebalance)
+{
+  print_process("erase by key / iterator");
+  for (int i = 0; i < 1000; i += 2)
+    EXPECT_EQ(imap.erase(i), 1);
+  EXPECT_EQ(imap.erase(0), 0);
+  EXPECT_EQ(imap.size(), 500);
+  EXPECT_TRUE(imap.__btree_verify());
+  for (auto it = imap.begin(); it != imap.end();)
+  {
+    if (it->first % 3 == 0)
+      it = imap.erase(it);
+    else
+      ++it;
+  }
+  for (auto &kv : imap)
+    EXPECT_NE(kv.first % 3, 0);
+  EXPECT_TRUE(imap.__btree_verify());
+
+  print_process("erase range");
+  auto first = imap.lower_bound(100);
+  auto last = imap.lower_bound(800);
+  auto next = imap.erase(first, last);
+  EXPECT_EQ(next->first, 803); // 801 已作为 3 的倍数删除
+  EXPECT_EQ(imap.lower_bound(100)->first, 803);
+  EXPECT_TRUE(imap.__btree_verify());
+
+  print_process("random insert / erase against map");
+  small_tree t;
+  zfwstl::map<int, int> ref;
+  uint64_t seed = 88172645463325252ull;
+  for (int round = 0; round < 20000; ++round)
+  {
+    const int k = static_cast<int>(next_rand(seed) % 600);
+    if (next_rand(seed) % 3 != 0)
+    {
+      EXPECT_EQ(t.insert_unique(k).second, ref.insert(zfwstl::pair<const int, int>(k, k)).second);
+    }
+    else
+    {
+      EXPECT_EQ(t.erase_unique(k), ref.erase(k));
+    }
+    if (round % 1000 == 0)
+    {
+      ASSERT_TRUE(t.__btree_verify());
+    }
+  }
+  ASSERT_TRUE(t.__btree_verify());
+  ASSERT_EQ(t.size(), ref.size());
+  auto rit = ref.begin();
+  for (auto it = t.begin(); it != t.end(); ++it, ++rit)
+    ASSERT_EQ(*it, rit->first);
+
+  print_process("erase everything");
+  while (!t.empty())
+  {
+    t.erase(t.begin());
+    if (t.size() % 64 == 0)
+    {
+      ASSERT_TRUE(t.__btree_verify());
+    }
+  }
+  EXPECT_EQ(t.begin(), t.end());
+  EXPECT_TRUE(t.__btree_verify());
+
+  print_process("clear");
+  imap.clear();
+  EXPECT_TRUE(imap.empty());
+  EXPECT_EQ(imap.begin(), imap.end());
+}
+TEST(AContainerTestBtreeMultimap, BtreeMultimap)
+{
+  print_process("duplicate keys keep insertion order");
+  zfwstl::btree_multimap<int, int> mm;
+  for (int i = 0; i < 300; ++i)
+    mm.insert(zfwstl::pair<const int, int>(i % 10, i));
+  EXPECT_EQ(mm.size(), 300);
+  EXPECT_EQ(mm.count(3), 30);
+  EXPECT_TRUE(mm.__btree_verify());
+  auto range = mm.equal_range(3);
+  int expect = 3;
+  for (auto it = range.first; it != range.second; ++it, expect += 10)
+    ASSERT_EQ(it->second, expect);
+  EXPECT_EQ(expect, 303);
+
+  print_process("erase by key");
+  EXPECT_EQ(mm.erase(3), 30);
+  EXPECT_EQ(mm.count(3), 0);
+  EXPECT_EQ(mm.size(), 270);
+  EXPECT_TRUE(mm.__btree_verify());
+
+  print_process("random against multimap");
+  zfwstl::btree_multimap<int, int> v1;
+  zfwstl::multimap<int, int> ref;
+  uint64_t seed = 2463534242ull;
+  for (int i = 0; i < 5000; ++i)
+  {
+    const int k = static_cast<int>(next_rand(seed) % 50);
+    v1.insert(zfwstl::pair<const int, int>(k, i));
+    ref.insert(zfwstl::pair<const int, int>(k, i));
+    if (i % 7 == 0)
+    {
+      EXPECT_EQ(v1.erase(k / 2), ref.erase(k / 2));
+    }
+  }
+  EXPECT_TRUE(v1.__btree_verify());
+  ASSERT_EQ(v1.size(), ref.size());
+  auto rit = ref.begin();
+  for (auto it = v1.begin(); it != v1.end(); ++it, ++rit)
+    ASSERT_TRUE(it->first == rit->first && it->second == rit->second);
+
+  print_process("copy keeps duplicates");
+  zfwstl::btree_multimap<int, int> v2(v1);
+  EXPECT_EQ(v2, v1);
+  EXPECT_TRUE(v2.__btree_verify());
+}
+TEST(AContainerTestBtreeSet, BtreeSet)
+{
+  print_process("btree_set");
+  zfwstl::btree_set<int> s({5, 3, 1, 3, 5});
+  EXPECT_EQ(s.size(), 3);
+  EXPECT_FALSE(s.insert(1).second);
+  EXPECT_TRUE(s.insert(2).second);
+  EXPECT_EQ(*s.begin(), 1);
+  EXPECT_EQ(s.erase(3), 1);
+  EXPECT_EQ(s.find(3), s.end());
+  zfwstl::btree_set<int> s2(s.begin(), s.end());
+  EXPECT_EQ(s, s2);
+  s2.insert(100);
+  EXPECT_NE(s, s2);
+
+  print_process("sorted range builds a packed tree");
+  zfwstl::vector<int> v;
+  for (int i = 0; i < 100000; ++i)
+    v.push_back(i / 2); // 相邻重复
+  zfwstl::btree_set<int> s3(v.begin(), v.end());
+  EXPECT_EQ(s3.size(), 50000);
+  EXPECT_TRUE(s3.__btree_verify());
+  EXPECT_LT(s3.bytes_used(), 50000 * sizeof(int) * 2);
+  int expect = 0;
+  for (auto x : s3)
+    ASSERT_EQ(x, expect++);
+
+  print_process("sequential insert keeps leaves full");
+  zfwstl::btree_set<int> s4;
+  for (int i = 0; i < 50000; ++i)
+    s4.insert(i);
+  EXPECT_TRUE(s4.__btree_verify());
+  EXPECT_LT(s4.bytes_used(), 50000 * sizeof(int) * 2);
+}
+// 比缺省 256 字节节点还大的键
+struct big_key
+{
+  int id;
+  char pad[300];
+  explicit big_key(int i = 0) : id(i) { pad[0] = static_cast<char>(i); }
+  bool operator<(const big_key &rhs) const { return id < rhs.id; }
+};
+TEST(AContainerTestBtreeBigKey, BigKey)
+{
+  print_process("key larger than a node");
+  zfwstl::btree_map<big_key, int> m;
+  for (int i = 0; i < 200; ++i)
+    m.insert(zfwstl::pair<const big_key, int>(big_key((i * 37) % 200), i));
+  EXPECT_EQ(m.size(), 200);
+  EXPECT_TRUE(m.__btree_verify());
+  int expect = 0;
+  for (auto &kv : m)
+  {
+    ASSERT_EQ(kv.first.id, expect);
+    ASSERT_EQ(kv.first.pad[0], static_cast<char>(expect));
+    ++expect;
+  }
+  EXPECT_EQ(m.find(big_key(123))->first.id, 123);
+  for (int i = 0; i < 200; i += 2)
+    EXPECT_EQ(m.erase(big_key(i)), 1);
+  EXPECT_EQ(m.size(), 100);
+  EXPECT_TRUE(m.__btree_verify());
+}
+int main(int argc, char **argv)
+{
+  print_start();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif // GOOGLETEST_SAMPLES_btree_map_H_
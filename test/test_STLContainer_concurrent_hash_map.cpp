@@ -0,0 +1,274 @@
+#ifndef GOOGLETEST_SAMPLES_concurrent_hash_map_H_
+#define GOOGLETEST_SAMPLES_concurrent_hash_map_H_
+#include "../../googletest-1.14.0/googletest/include/gtest/gtest.h"
+#include <iostream>
+#include <cstddef> // for size_t, ptrdiff_t
+#include <string>
+#include <atomic>
+#include <thread>
+#include "../STL_2/concurrent_hash_map.h"
+#include "../STL/vector.h"
+/**
+ * SContainerTestConcurrentHashMap: 并发哈希表测试类
+ * -----------------------------------------------------
+ * Basic：find / contains / insert / insert_or_assign / erase / compute_if_absent / visit / for_each / clear
+ * Growth：插入大量元素时各段扩容，扩容后全部元素仍可找到；reserve；构造中配置失败时归还已配置的内存
+ * NonTrivial：string 键值，覆盖、删除与析构时释放节点
+ * ConcurrentMix：多个线程在各自的键区间内插入、覆盖、删除，同时有线程读取共享的键
+ * ComputeIfAbsent：多个线程对同一批键调用 compute_if_absent，每个键的 f 只被调用一次
+ */
+void print_start()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[----------- Run container test : concurrent_hash_map ----------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+}
+void print_process(string tmp)
+{
+  std::cout << "[---- " << tmp << " ----]\n";
+}
+// 第 budget 次配置时抛出 bad_alloc，统计未归还的块数
+struct failing_alloc
+{
+  static int budget, live;
+  static void *allocate(size_t n)
+  {
+    if (budget >= 0 && budget-- == 0)
+      throw std::bad_alloc();
+    ++live;
+    return zfwstl::new_alloc::allocate(n);
+  }
+  static void deallocate(void *p, size_t n)
+  {
+    --live;
+    zfwstl::new_alloc::deallocate(p, n);
+  }
+};
+int failing_alloc::budget = -1, failing_alloc::live = 0;
+typedef zfwstl::concurrent_hash_map<int, int, zfwstl::hash<int>, zfwstl::equal_to<int>, failing_alloc> failing_map;
+// 测试类
+class SContainerTestConcurrentHashMap : public ::testing::Test
+{
+protected:
+  zfwstl::concurrent_hash_map<int, int> m{0, 4};
+};
+//===============测试用例开始===============
+TEST_F(SContainerTestConcurrentHashMap, Basic)
+{
+  print_process("insert / find / contains");
+  EXPECT_EQ(m.segment_count(), 4u);
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.insert(1, 10));
+  EXPECT_FALSE(m.insert(1, 11)); // 已存在时不覆盖
+  EXPECT_TRUE(m.insert(zfwstl::pair<const int, int>(2, 20)));
+  int x = -1;
+  EXPECT_TRUE(m.find(1, x));
+  EXPECT_EQ(x, 10);
+  EXPECT_FALSE(m.find(3, x));
+  EXPECT_EQ(x, 10);
+  EXPECT_TRUE(m.contains(2));
+  EXPECT_EQ(m.count(3), 0u);
+  EXPECT_EQ(m.size(), 2u);
+
+  print_process("insert_or_assign / erase");
+  EXPECT_FALSE(m.insert_or_assign(1, 100));
+  EXPECT_TRUE(m.insert_or_assign(3, 30));
+  EXPECT_TRUE(m.find(1, x));
+  EXPECT_EQ(x, 100);
+  EXPECT_EQ(m.erase(2), 1u);
+  EXPECT_EQ(m.erase(2), 0u);
+  EXPECT_FALSE(m.contains(2));
+  EXPECT_EQ(m.size(), 2u);
+
+  print_process("compute_if_absent / visit / for_each");
+  int calls = 0;
+  EXPECT_EQ(m.compute_if_absent(1, [&calls]
+                                { return ++calls; }),
+            100);
+  EXPECT_EQ(m.compute_if_absent(4, [&calls]
+                                { return ++calls + 40; }),
+            41);
+  EXPECT_EQ(calls, 1);
+  EXPECT_THROW(m.compute_if_absent(5, []() -> int
+                                   { throw std::runtime_error("f"); }),
+               std::runtime_error);
+  EXPECT_FALSE(m.contains(5));
+  int seen = 0;
+  EXPECT_TRUE(m.visit(4, [&seen](const zfwstl::pair<const int, int> &v)
+                      { seen = v.second; }));
+  EXPECT_EQ(seen, 41);
+  EXPECT_FALSE(m.visit(5, [&seen](const zfwstl::pair<const int, int> &v)
+                       { seen = v.second; }));
+  int key_sum = 0, val_sum = 0;
+  m.for_each([&](const zfwstl::pair<const int, int> &v)
+             { key_sum += v.first; val_sum += v.second; });
+  EXPECT_EQ(key_sum, 1 + 3 + 4);
+  EXPECT_EQ(val_sum, 100 + 30 + 41);
+
+  print_process("clear");
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_FALSE(m.contains(1));
+  EXPECT_TRUE(m.insert(1, 1));
+}
+
+TEST_F(SContainerTestConcurrentHashMap, Growth)
+{
+  print_process("per-segment rehash");
+  const size_t initial = m.bucket_count();
+  EXPECT_EQ(initial, 4u * 8);
+  const int n = 20000;
+  for (int i = 0; i < n; ++i)
+    ASSERT_TRUE(m.insert(i * 7, i));
+  EXPECT_EQ(m.size(), static_cast<size_t>(n));
+  EXPECT_GE(m.bucket_count(), static_cast<size_t>(n));
+  for (int i = 0; i < n; ++i)
+  {
+    int x = -1;
+    ASSERT_TRUE(m.find(i * 7, x)) << i;
+    ASSERT_EQ(x, i);
+    ASSERT_FALSE(m.contains(i * 7 + 1));
+  }
+  for (int i = 0; i < n; i += 2)
+    ASSERT_EQ(m.erase(i * 7), 1u);
+  EXPECT_EQ(m.size(), static_cast<size_t>(n / 2));
+
+  print_process("reserve");
+  zfwstl::concurrent_hash_map<int, int> r(0, 8);
+  r.reserve(1000);
+  const size_t reserved = r.bucket_count();
+  EXPECT_GE(reserved, 1000u);
+  for (int i = 0; i < 500; ++i)
+    r.insert(i, i);
+  EXPECT_EQ(r.bucket_count(), reserved); // 预留后插入不再扩容
+  EXPECT_THROW(r.reserve(static_cast<size_t>(-1)), std::length_error);
+  EXPECT_EQ(r.bucket_count(), reserved);
+  zfwstl::concurrent_hash_map<int, int> one(0, 1);
+  EXPECT_EQ(one.segment_count(), 1u);
+  for (int i = 0; i < 100; ++i)
+    one.insert(i, -i);
+  int x = 0;
+  EXPECT_TRUE(one.find(99, x));
+  EXPECT_EQ(x, -99);
+
+  print_process("constructor rollback");
+  for (int fail = 0; fail < 5; ++fail)
+  { // 第 0 次为段数组，第 1 ~ 4 次为各段的 bucket
+    failing_alloc::budget = fail;
+    EXPECT_THROW(failing_map(0, 4), std::bad_alloc);
+    EXPECT_EQ(failing_alloc::live, 0);
+  }
+  failing_alloc::budget = -1;
+}
+
+TEST_F(SContainerTestConcurrentHashMap, NonTrivial)
+{
+  print_process("string keys and values");
+  const std::string long_str(100, 'x'); // 超出短字符串缓冲区，泄漏时 ASan 可以发现
+  zfwstl::concurrent_hash_map<std::string, std::string> s;
+  for (int i = 0; i < 200; ++i)
+    s.insert(long_str + std::to_string(i), std::to_string(i));
+  std::string v;
+  EXPECT_TRUE(s.find(long_str + "42", v));
+  EXPECT_EQ(v, "42");
+  EXPECT_FALSE(s.insert_or_assign(long_str + "42", long_str));
+  EXPECT_TRUE(s.find(long_str + "42", v));
+  EXPECT_EQ(v, long_str);
+  EXPECT_EQ(s.erase(long_str + "7"), 1u);
+  EXPECT_EQ(s.compute_if_absent(long_str + "7", [&long_str]
+                                { return long_str + "!"; }),
+            long_str + "!");
+  EXPECT_EQ(s.size(), 200u);
+  // 离开作用域时由析构函数销毁剩余节点
+}
+
+TEST_F(SContainerTestConcurrentHashMap, ConcurrentMix)
+{
+  print_process("4 writers, 2 readers");
+  const int writers = 4, readers = 2, per = 20000, shared = 100;
+  zfwstl::concurrent_hash_map<int, int> c(0, 16);
+  for (int k = 0; k < shared; ++k)
+    c.insert(-1 - k, k);
+  std::atomic<int> running(writers);
+  std::atomic<bool> reader_ok(true);
+  std::thread threads[writers + readers];
+  for (int w = 0; w < writers; ++w)
+    threads[w] = std::thread([&c, &running, w, per]
+                             {
+      const int base = w * per;
+      for (int i = 0; i < per; ++i)
+      {
+        c.insert(base + i, i);
+        if (i % 3 == 0)
+          c.insert_or_assign(base + i, -i);
+        if (i % 4 == 0)
+          c.erase(base + i);
+        if (i % 256 == 0)
+          std::this_thread::yield();
+      }
+      running.fetch_sub(1); });
+  for (int r = 0; r < readers; ++r)
+    threads[writers + r] = std::thread([&c, &running, &reader_ok, shared]
+                                       {
+      int k = 0;
+      while (running.load() > 0)
+      {
+        int x = -1;
+        if (!c.find(-1 - k, x) || x != k)
+          reader_ok = false;
+        k = (k + 1) % shared;
+        if (k == 0)
+          std::this_thread::yield();
+      } });
+  for (auto &t : threads)
+    t.join();
+  EXPECT_TRUE(reader_ok.load());
+  // 每个写线程留下 i % 4 != 0 的键，i % 3 == 0 的值为 -i
+  EXPECT_EQ(c.size(), static_cast<size_t>(shared + writers * (per - per / 4)));
+  for (int w = 0; w < writers; ++w)
+    for (int i = 0; i < per; ++i)
+    {
+      int x = 0;
+      const bool found = c.find(w * per + i, x);
+      ASSERT_EQ(found, i % 4 != 0) << w << " " << i;
+      if (found)
+      {
+        ASSERT_EQ(x, i % 3 == 0 ? -i : i);
+      }
+    }
+}
+
+TEST_F(SContainerTestConcurrentHashMap, ComputeIfAbsent)
+{
+  print_process("f is called once per key");
+  const int threads_n = 4, keys = 5000;
+  zfwstl::concurrent_hash_map<int, int> c(0, 8);
+  std::atomic<int> calls(0);
+  std::atomic<bool> ok(true);
+  std::thread threads[threads_n];
+  for (int t = 0; t < threads_n; ++t)
+    threads[t] = std::thread([&c, &calls, &ok, t, keys]
+                             {
+      for (int i = 0; i < keys; ++i)
+      {
+        const int k = (i * (t + 1)) % keys; // 各线程以不同顺序访问同一批键
+        const int v = c.compute_if_absent(k, [&calls, k]
+                                          { calls.fetch_add(1); return k * 2; });
+        if (v != k * 2)
+          ok = false;
+        if (i % 256 == 0)
+          std::this_thread::yield();
+      } });
+  for (auto &t : threads)
+    t.join();
+  EXPECT_TRUE(ok.load());
+  EXPECT_EQ(c.size(), static_cast<size_t>(keys));
+  EXPECT_EQ(calls.load(), keys);
+}
+int main(int argc, char **argv)
+{
+  print_start();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif // GOOGLETEST_SAMPLES_concurrent_hash_map_H_
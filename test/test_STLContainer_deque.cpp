@@ -13,6 +13,10 @@
  * InitialState：测试向量在初始化后的状态。
  * PushBack：测试 push_back 方法是否正确增加了元素并更新了大小。
  * Insert：测试 insert 方法是否正确插入了元素，并检查了插入位置及其后元素的状态
+ * BufferSize：运行期设定缓冲区大小，迭代器跨缓冲区运算
+ * QueueRecycling：当作队列使用时缓冲区循环利用、map 挪回中央，稳定后不再配置内存
+ * RandomOps：小缓冲区下随机的头尾插入删除、中间插入删除，与 vector 对照
+ * SegmentedAlgo：copy / move / copy_backward / fill / fill_n / find / for_each 按缓冲区分段处理的结果
  */
 void print_start()
 {
@@ -299,6 +303,244 @@ TEST_F(SContainerTestDeque, ShrinkToFit)
   d.resize(50);
   d.shrink_to_fit();
 }
+// 统计配置次数
+struct counting_alloc
+{
+  static size_t allocs;
+  static void *allocate(size_t n)
+  {
+    ++allocs;
+    return zfwstl::new_alloc::allocate(n);
+  }
+  static void deallocate(void *p, size_t n) { zfwstl::new_alloc::deallocate(p, n); }
+};
+size_t counting_alloc::allocs = 0;
+
+TEST_F(SContainerTestDeque, BufferSize)
+{
+  print_process("runtime buffer size");
+  typedef zfwstl::deque<long> dq;
+  EXPECT_EQ(dq::default_buffer_size(), 4096 / sizeof(long));
+  dq::set_default_buffer_size(3);
+  dq a;
+  dq::set_default_buffer_size(0);
+  dq b;
+  EXPECT_EQ(a.buffer_size(), 3);
+  EXPECT_EQ(b.buffer_size(), 4096 / sizeof(long));
+  for (long i = 0; i < 100; ++i)
+  {
+    a.push_back(i);
+    a.push_front(-i);
+  }
+  ASSERT_EQ(a.size(), 200);
+  EXPECT_EQ(a.end() - a.begin(), 200);
+  auto it = a.begin() + 150;
+  EXPECT_EQ(*it, 50);
+  it -= 101;
+  EXPECT_EQ(*it, -50);
+  EXPECT_EQ(it[7], -43);
+  EXPECT_EQ((a.end() - 1) - it, 150);
+  EXPECT_EQ(a[199], 99);
+  a.swap(b);
+  EXPECT_EQ(b.buffer_size(), 3);
+  EXPECT_EQ(b.size(), 200);
+  dq c(zfwstl::move(b));
+  EXPECT_EQ(c.buffer_size(), 3);
+  EXPECT_EQ(c.back(), 99);
+  c.shrink_to_fit();
+  EXPECT_EQ(c.front(), -99);
+  EXPECT_EQ(c[100], 0);
+}
+
+TEST_F(SContainerTestDeque, QueueRecycling)
+{
+  print_process("queue churn reuses buffers");
+  zfwstl::deque<int, 16, counting_alloc> q;
+  for (int i = 0; i < 100; ++i)
+    q.push_back(i);
+  int expect = 0;
+  for (int round = 0; round < 1000; ++round) // 预热：map 挪回中央、缓存填满
+  {
+    q.push_back(100 + round);
+    EXPECT_EQ(q.front(), expect++);
+    q.pop_front();
+  }
+  counting_alloc::allocs = 0;
+  for (int round = 1000; round < 200000; ++round)
+  {
+    q.push_back(100 + round);
+    ASSERT_EQ(q.front(), expect++);
+    q.pop_front();
+  }
+  EXPECT_EQ(counting_alloc::allocs, 0);
+  EXPECT_EQ(q.size(), 100);
+  EXPECT_EQ(q.back(), 200099);
+  // 反方向(头进尾出)同样
+  for (int round = 0; round < 100000; ++round)
+  {
+    q.push_front(round);
+    q.pop_back();
+  }
+  EXPECT_EQ(counting_alloc::allocs, 0);
+  EXPECT_EQ(q.front(), 99999);
+}
+
+TEST_F(SContainerTestDeque, RandomOps)
+{
+  print_process("random operations against vector");
+  typedef zfwstl::deque<std::string, 4> dq;
+  dq d;
+  zfwstl::vector<std::string> ref;
+  unsigned x = 2463534242u;
+  for (int round = 0; round < 5000; ++round)
+  {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    const std::string v = std::to_string(round);
+    const size_t pos = ref.empty() ? 0 : x % (ref.size() + 1);
+    switch ((x >> 8) % 8)
+    {
+    case 0:
+      d.push_back(v);
+      ref.push_back(v);
+      break;
+    case 1:
+      d.push_front(v);
+      ref.insert(ref.begin(), v);
+      break;
+    case 2:
+      if (!ref.empty())
+      {
+        d.pop_front();
+        ref.erase(ref.begin());
+      }
+      break;
+    case 3:
+      if (!ref.empty())
+      {
+        d.pop_back();
+        ref.pop_back();
+      }
+      break;
+    case 4:
+      d.insert(d.begin() + pos, v);
+      ref.insert(ref.begin() + pos, v);
+      break;
+    case 5:
+      if (pos < ref.size())
+      {
+        d.erase(d.begin() + pos);
+        ref.erase(ref.begin() + pos);
+      }
+      break;
+    case 6:
+    {
+      const size_t n = (x >> 16) % 11;
+      d.insert(d.begin() + pos, n, v);
+      ref.insert(ref.begin() + pos, n, v);
+      break;
+    }
+    default:
+      if (ref.size() > 8)
+      {
+        const size_t first = pos / 2, last = first + (x >> 20) % (ref.size() - first);
+        d.erase(d.begin() + first, d.begin() + last);
+        ref.erase(ref.begin() + first, ref.begin() + last);
+      }
+      break;
+    }
+    ASSERT_EQ(d.size(), ref.size());
+    if (round % 50 == 0)
+    {
+      for (size_t i = 0; i < ref.size(); ++i)
+        ASSERT_EQ(d[i], ref[i]);
+    }
+  }
+  zfwstl::vector<std::string> extra(30, "z");
+  d.insert(d.begin() + d.size() / 3, extra.begin(), extra.end());
+  ref.insert(ref.begin() + ref.size() / 3, extra.begin(), extra.end());
+  ASSERT_EQ(d.size(), ref.size());
+  for (size_t i = 0; i < ref.size(); ++i)
+    ASSERT_EQ(d[i], ref[i]);
+}
+TEST_F(SContainerTestDeque, SegmentedAlgo)
+{
+  print_process("copy / move between deque and vector");
+  typedef zfwstl::deque<int, 5> dq; // 小缓冲区，区间跨越很多段
+  EXPECT_TRUE(zfwstl::is_segmented_iterator<dq::iterator>::value);
+  EXPECT_TRUE(zfwstl::is_segmented_iterator<dq::const_iterator>::value);
+  EXPECT_FALSE(zfwstl::is_segmented_iterator<int *>::value);
+  dq d;
+  for (int i = 0; i < 103; ++i)
+    d.push_back(i);
+  d.pop_front(); // 让 begin 不在段首
+  d.pop_front();
+  zfwstl::vector<int> v(d.size());
+  EXPECT_TRUE(zfwstl::copy(d.begin(), d.end(), v.begin()) == v.end());
+  for (size_t i = 0; i < v.size(); ++i)
+    ASSERT_EQ(v[i], static_cast<int>(i) + 2);
+  const dq &cd = d;
+  zfwstl::vector<int> cv(cd.begin() + 3, cd.begin() + 3); // 空区间
+  EXPECT_TRUE(cv.empty());
+  zfwstl::vector<int> w(cd.begin() + 7, cd.end() - 4); // 经 uninitialized_copy 逐段 memmove
+  ASSERT_EQ(w.size(), d.size() - 11);
+  EXPECT_EQ(w.front(), 9);
+  EXPECT_EQ(w.back(), 98);
+  for (size_t n = 0; n <= 13; ++n) // 各种起止位置：同一段、相邻段、跨多段
+  {
+    dq e(d.size() + 20, -1);
+    auto it = zfwstl::copy(v.begin() + n, v.end() - n, e.begin() + n + 1);
+    EXPECT_TRUE(it == e.begin() + (v.size() - n + 1));
+    EXPECT_EQ(e[n], -1);
+    for (size_t i = n; i < v.size() - n; ++i)
+      ASSERT_EQ(e[i + 1], v[i]);
+    EXPECT_EQ(e[v.size() - n + 1], -1);
+    auto back = zfwstl::copy_backward(e.begin() + n + 1, e.begin() + 40, e.begin() + 50); // 同一 deque 内重叠
+    EXPECT_TRUE(back == e.begin() + n + 11);
+    for (size_t i = n + 11; i < 50; ++i)
+      ASSERT_EQ(e[i], v[i - 11]);
+    auto fwd = zfwstl::copy(e.begin() + 20, e.end(), e.begin() + 3);
+    EXPECT_TRUE(fwd == e.end() - 17);
+  }
+  zfwstl::vector<std::string> sv;
+  for (int i = 0; i < 40; ++i)
+    sv.push_back(std::to_string(i));
+  zfwstl::deque<std::string, 3> sd(40);
+  zfwstl::move(sv.begin(), sv.end(), sd.begin());
+  EXPECT_EQ(sd[17], "17");
+  zfwstl::vector<std::string> sv2(40);
+  zfwstl::move_backward(sd.begin(), sd.end(), sv2.end());
+  EXPECT_EQ(sv2[39], "39");
+  EXPECT_TRUE(sd[39].empty());
+  zfwstl::move_backward(sv2.begin(), sv2.begin() + 20, sd.begin() + 25);
+  EXPECT_EQ(sd[5], "0");
+  EXPECT_EQ(sd[24], "19");
+
+  print_process("fill / fill_n / find / for_each");
+  zfwstl::deque<char, 7> c(100, 'a');
+  zfwstl::fill(c.begin() + 3, c.end() - 5, 'b');
+  EXPECT_EQ(c[2], 'a');
+  EXPECT_EQ(c[3], 'b');
+  EXPECT_EQ(c[94], 'b');
+  EXPECT_EQ(c[95], 'a');
+  auto fe = zfwstl::fill_n(c.begin() + 10, 14, 'c'); // 恰好写到段尾
+  EXPECT_TRUE(fe == c.begin() + 24);
+  EXPECT_EQ(c[23], 'c');
+  EXPECT_EQ(c[24], 'b');
+  EXPECT_TRUE(zfwstl::find(c.begin(), c.end(), 'c') == c.begin() + 10);
+  EXPECT_TRUE(zfwstl::find(c.begin() + 24, c.end(), 'c') == c.end());
+  EXPECT_TRUE(zfwstl::find(c.begin() + 24, c.begin() + 27, 'a') == c.begin() + 27);
+  EXPECT_TRUE(zfwstl::find(c.begin() + 24, c.end(), 'a') == c.begin() + 95);
+  EXPECT_TRUE(zfwstl::find(d.cbegin(), d.cend(), 77) == d.cbegin() + 75);
+  EXPECT_TRUE(zfwstl::find(d.begin(), d.end(), 1000) == d.end());
+  long sum = 0;
+  zfwstl::for_each(d.begin() + 1, d.end() - 1, [&sum](int x) { sum += x; });
+  EXPECT_EQ(sum, (3 + 101) * 99 / 2);
+  int cnt = 0;
+  zfwstl::for_each(d.begin() + 4, d.begin() + 4, [&cnt](int) { ++cnt; });
+  EXPECT_EQ(cnt, 0);
+}
 int main(int argc, char **argv)
 {
   print_start();
@@ -0,0 +1,216 @@
+#ifndef GOOGLETEST_SAMPLES_flat_hash_map_H_
+#define GOOGLETEST_SAMPLES_flat_hash_map_H_
+#include "../../googletest-1.14.0/googletest/include/gtest/gtest.h"
+#include <iostream>
+#include <cstddef> // for size_t, ptrdiff_t
+#include <string>
+#include "../STL_2/flat_hash_map.h"
+#include "../STL_2/flat_hash_set.h"
+#include "../src/util.h" // for pair, move
+/**
+ * AContainerTestFlatMap: 开放定址哈希容器测试类
+ * -----------------------------------------------------
+ * Constructor：各种构造函数
+ * InsertFind：insert / operator[] / try_emplace / insert_or_assign / find
+ * EraseReuse：大量删除后墓碑复用、迭代器删除
+ * Rehash：扩容过程中元素不丢失
+ * FlatHashSet：flat_hash_set 基本操作
+ */
+void print_start()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[----------------- Run container test : flat_hash_map -----------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+}
+void print_process(string tmp)
+{
+  std::cout << "[---- " << tmp << " ----]\n";
+}
+// 测试类
+class AContainerTestFlatMap : public ::testing::Test
+{
+protected:
+  zfwstl::flat_hash_map<int, int> imap;
+
+  void SetUp() override
+  {
+    for (int i = 0; i < 100; ++i)
+      imap[i] = i * 10;
+  }
+};
+//===============测试用例开始===============
+TEST_F(AContainerTestFlatMap, Constructor)
+{
+  print_process("Default constructor");
+  zfwstl::flat_hash_map<int, int> v1;
+  EXPECT_TRUE(v1.empty());
+  EXPECT_EQ(v1.bucket_count(), 0);
+
+  print_process("Reserve constructor");
+  zfwstl::flat_hash_map<int, int> v2(1000);
+  EXPECT_GE(v2.bucket_count() * 7 / 8, 1000);
+
+  print_process("Copy constructor");
+  zfwstl::flat_hash_map<int, int> v3(imap);
+  EXPECT_EQ(v3, imap);
+
+  print_process("Move constructor");
+  zfwstl::flat_hash_map<int, int> v4(zfwstl::move(v3));
+  EXPECT_EQ(v4, imap);
+  EXPECT_TRUE(v3.empty());
+
+  print_process("range constructor");
+  zfwstl::flat_hash_map<int, int> v5(imap.begin(), imap.end());
+  EXPECT_EQ(v5, imap);
+
+  print_process("initializer_list constructor");
+  zfwstl::flat_hash_map<int, const char *> v6({{1, "one"}, {2, "two"}, {3, "three"}});
+  EXPECT_EQ(v6.size(), 3);
+  EXPECT_STREQ(v6[2], "two");
+
+  print_process("Assignment operator");
+  zfwstl::flat_hash_map<int, int> v7;
+  v7 = imap;
+  EXPECT_EQ(v7, imap);
+  v7 = zfwstl::move(v5);
+  EXPECT_EQ(v7, imap);
+}
+TEST_F(AContainerTestFlatMap, InsertFind)
+{
+  print_process("insert");
+  auto res = imap.insert(zfwstl::pair<const int, int>(1000, 1));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(res.first->second, 1);
+  res = imap.insert(zfwstl::pair<const int, int>(1000, 2));
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(res.first->second, 1);
+  EXPECT_EQ(imap.size(), 101);
+
+  print_process("find / count / at");
+  for (int i = 0; i < 100; ++i)
+  {
+    auto it = imap.find(i);
+    ASSERT_NE(it, imap.end());
+    EXPECT_EQ(it->second, i * 10);
+  }
+  EXPECT_EQ(imap.find(-1), imap.end());
+  EXPECT_EQ(imap.count(50), 1);
+  EXPECT_FALSE(imap.contains(-5));
+  EXPECT_EQ(imap.at(7), 70);
+  EXPECT_THROW(imap.at(-7), std::out_of_range);
+
+  print_process("try_emplace / insert_or_assign");
+  EXPECT_FALSE(imap.try_emplace(5, 123).second);
+  EXPECT_EQ(imap[5], 50);
+  EXPECT_TRUE(imap.try_emplace(-5, 123).second);
+  EXPECT_EQ(imap[-5], 123);
+  EXPECT_FALSE(imap.insert_or_assign(5, 555).second);
+  EXPECT_EQ(imap[5], 555);
+
+  print_process("string key");
+  zfwstl::flat_hash_map<std::string, int> smap;
+  smap["apple"] = 1;
+  smap[std::string("banana")] = 2;
+  smap.emplace(std::string("cherry"), 3);
+  EXPECT_EQ(smap.size(), 3);
+  EXPECT_EQ(smap["banana"], 2);
+  EXPECT_EQ(smap.count("durian"), 0);
+
+  print_process("transparent lookup");
+  zfwstl::flat_hash_map<std::string, int, zfwstl::hash<std::string>, zfwstl::equal_to<>> tmap;
+  tmap["apple"] = 1;
+  tmap["banana"] = 2;
+  EXPECT_EQ(tmap.find("banana")->second, 2);
+  EXPECT_TRUE(tmap.contains("apple"));
+  EXPECT_EQ(tmap.count("cherry"), 0);
+  EXPECT_EQ(tmap.erase("apple"), 1);
+  EXPECT_EQ(tmap.size(), 1);
+}
+TEST_F(AContainerTestFlatMap, EraseReuse)
+{
+  print_process("erase by key");
+  for (int i = 0; i < 100; i += 2)
+    EXPECT_EQ(imap.erase(i), 1);
+  EXPECT_EQ(imap.erase(0), 0);
+  EXPECT_EQ(imap.size(), 50);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(imap.count(i), static_cast<size_t>(i & 1));
+
+  print_process("erase by iterator");
+  for (auto it = imap.begin(); it != imap.end();)
+  {
+    if (it->first % 3 == 0)
+      it = imap.erase(it);
+    else
+      ++it;
+  }
+  for (auto &kv : imap)
+    EXPECT_NE(kv.first % 3, 0);
+
+  print_process("insert/erase cycles do not grow the table");
+  zfwstl::flat_hash_map<int, int> v1(64);
+  const size_t buckets = v1.bucket_count();
+  for (int round = 0; round < 100; ++round)
+  {
+    for (int i = 0; i < 32; ++i)
+      v1[round * 32 + i] = i;
+    for (int i = 0; i < 32; ++i)
+      v1.erase(round * 32 + i);
+  }
+  EXPECT_TRUE(v1.empty());
+  EXPECT_EQ(v1.bucket_count(), buckets);
+
+  print_process("clear");
+  imap.clear();
+  EXPECT_TRUE(imap.empty());
+  EXPECT_EQ(imap.begin(), imap.end());
+}
+TEST_F(AContainerTestFlatMap, Rehash)
+{
+  print_process("grow");
+  zfwstl::flat_hash_map<int, int> v1;
+  const int n = 100000;
+  for (int i = 0; i < n; ++i)
+    v1[i * 7] = i;
+  EXPECT_EQ(v1.size(), static_cast<size_t>(n));
+  EXPECT_LE(v1.load_factor(), v1.max_load_factor());
+  for (int i = 0; i < n; ++i)
+    ASSERT_EQ(v1[i * 7], i);
+  size_t cnt = 0;
+  for (auto it = v1.begin(); it != v1.end(); ++it)
+    ++cnt;
+  EXPECT_EQ(cnt, static_cast<size_t>(n));
+
+  print_process("rehash");
+  v1.rehash(0);
+  EXPECT_EQ(v1.size(), static_cast<size_t>(n));
+  EXPECT_EQ(v1[7 * 123], 123);
+
+  print_process("swap");
+  zfwstl::flat_hash_map<int, int> v2;
+  zfwstl::swap(v1, v2);
+  EXPECT_TRUE(v1.empty());
+  EXPECT_EQ(v2.size(), static_cast<size_t>(n));
+}
+TEST(AContainerTestFlatSet, FlatHashSet)
+{
+  print_process("flat_hash_set");
+  zfwstl::flat_hash_set<int> s({5, 3, 1, 3, 5});
+  EXPECT_EQ(s.size(), 3);
+  EXPECT_FALSE(s.insert(1).second);
+  EXPECT_TRUE(s.insert(2).second);
+  EXPECT_TRUE(s.contains(2));
+  EXPECT_EQ(s.erase(3), 1);
+  EXPECT_EQ(s.find(3), s.end());
+  zfwstl::flat_hash_set<int> s2(s.begin(), s.end());
+  EXPECT_EQ(s, s2);
+  s2.insert(100);
+  EXPECT_NE(s, s2);
+}
+int main(int argc, char **argv)
+{
+  print_start();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif // GOOGLETEST_SAMPLES_flat_hash_map_H_
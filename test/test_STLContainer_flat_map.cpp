@@ -0,0 +1,277 @@
+#ifndef GOOGLETEST_SAMPLES_flat_map_H_
+#define GOOGLETEST_SAMPLES_flat_map_H_
+#include "../../googletest-1.14.0/googletest/include/gtest/gtest.h"
+#include <iostream>
+#include <cstddef> // for size_t, ptrdiff_t
+#include <cstdint> // for uint64_t
+#include <string>
+#include "../STL_2/flat_map.h"
+#include "../STL_2/flat_multimap.h"
+#include "../STL_2/flat_set.h"
+#include "../STL_2/flat_multiset.h"
+#include "../STL_2/map.h"
+#include "../STL_2/multimap.h"
+#include "../STL/vector.h"
+#include "../src/util.h" // for pair, move
+/**
+ * AContainerTestFlatMap: 有序 vector 关联容器测试类
+ * -----------------------------------------------------
+ * Constructor：各种构造函数(区间构造排序一次并去重)
+ * InsertFind：insert / operator[] / find / lower_bound / upper_bound / 透明查找
+ * BulkInsert：区间插入与已有元素归并，随机数据与 map 对照
+ * Erase：按位置、区间、键删除
+ * SplitStorage：键值分开存放的 flat_map，与默认存放方式逐一对照
+ * FlatMultimap：重复键的顺序、equal_range、按键删除
+ * FlatSet：flat_set / flat_multiset 基本操作
+ */
+void print_start()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[----------------- Run container test : flat_map -----------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+}
+void print_process(string tmp)
+{
+  std::cout << "[---- " << tmp << " ----]\n";
+}
+typedef zfwstl::flat_map<int, int, zfwstl::less<int>, zfwstl::new_alloc, true> split_map;
+
+static uint64_t next_rand(uint64_t &x)
+{
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return x;
+}
+// 测试类
+class AContainerTestFlatMap : public ::testing::Test
+{
+protected:
+  zfwstl::flat_map<int, int> imap;
+
+  void SetUp() override
+  {
+    for (int i = 0; i < 100; ++i)
+      imap[i] = i * 10;
+  }
+};
+//===============测试用例开始===============
+TEST_F(AContainerTestFlatMap, Constructor)
+{
+  print_process("Default constructor");
+  zfwstl::flat_map<int, int> v1;
+  EXPECT_TRUE(v1.empty());
+
+  print_process("Range constructor: sort once, drop duplicates");
+  zfwstl::vector<zfwstl::pair<int, int>> src;
+  for (int i = 9; i >= 0; --i)
+    src.push_back(zfwstl::pair<int, int>(i % 5, i));
+  zfwstl::flat_map<int, int> v2(src.begin(), src.end());
+  EXPECT_EQ(v2.size(), 5);
+  for (int i = 0; i < 5; ++i)
+    EXPECT_EQ(v2.begin()[i].first, i);
+
+  print_process("Initializer list constructor");
+  zfwstl::flat_map<int, int> v3{{3, 30}, {1, 10}, {2, 20}, {1, 11}};
+  EXPECT_EQ(v3.size(), 3);
+  EXPECT_EQ(v3[1], 10);
+
+  print_process("Copy / move constructor");
+  zfwstl::flat_map<int, int> v4(imap);
+  EXPECT_TRUE(v4 == imap);
+  zfwstl::flat_map<int, int> v5(zfwstl::move(v4));
+  EXPECT_TRUE(v5 == imap);
+  EXPECT_TRUE(v4.empty());
+}
+TEST_F(AContainerTestFlatMap, InsertFind)
+{
+  print_process("insert");
+  auto p = imap.insert(zfwstl::pair<int, int>(50, 0));
+  EXPECT_FALSE(p.second);
+  EXPECT_EQ(p.first->second, 500);
+  p = imap.insert(zfwstl::pair<int, int>(-1, -10));
+  EXPECT_TRUE(p.second);
+  EXPECT_EQ(imap.begin()->first, -1);
+  EXPECT_EQ(imap.size(), 101);
+
+  print_process("operator[]");
+  imap[200] = 2000;
+  EXPECT_EQ((imap.end() - 1)->second, 2000);
+  EXPECT_EQ(imap[7], 70);
+
+  print_process("find / count / contains");
+  EXPECT_EQ(imap.find(42)->second, 420);
+  EXPECT_TRUE(imap.find(150) == imap.end());
+  EXPECT_EQ(imap.count(99), 1);
+  EXPECT_FALSE(imap.contains(150));
+
+  print_process("lower_bound / upper_bound / equal_range");
+  EXPECT_EQ(imap.lower_bound(150)->first, 200);
+  EXPECT_EQ(imap.upper_bound(99)->first, 200);
+  auto r = imap.equal_range(10);
+  EXPECT_EQ(r.second - r.first, 1);
+
+  print_process("transparent lookup");
+  zfwstl::flat_map<std::string, int, zfwstl::less<>> smap{{"apple", 1}, {"pear", 2}};
+  EXPECT_EQ(smap.find("pear")->second, 2);
+  EXPECT_TRUE(smap.contains("apple"));
+  EXPECT_EQ(smap.erase("apple"), 1);
+  EXPECT_EQ(smap.size(), 1);
+}
+TEST_F(AContainerTestFlatMap, BulkInsert)
+{
+  print_process("append after the largest key");
+  zfwstl::vector<zfwstl::pair<int, int>> tail;
+  for (int i = 99; i < 120; ++i)
+    tail.push_back(zfwstl::pair<int, int>(i, -i));
+  imap.insert(tail.begin(), tail.end());
+  EXPECT_EQ(imap.size(), 120);
+  EXPECT_EQ(imap[99], 990); // 已有元素优先
+
+  print_process("random bulk insert against map");
+  zfwstl::map<int, int> ref;
+  zfwstl::flat_map<int, int> fm;
+  uint64_t seed = 88172645463325252ull;
+  for (int round = 0; round < 20; ++round)
+  {
+    zfwstl::vector<zfwstl::pair<int, int>> batch;
+    for (int i = 0; i < 300; ++i)
+    {
+      int k = static_cast<int>(next_rand(seed) % 2000);
+      batch.push_back(zfwstl::pair<int, int>(k, round));
+      ref.insert(zfwstl::pair<const int, int>(k, round));
+    }
+    fm.insert(batch.begin(), batch.end());
+    ASSERT_EQ(fm.size(), ref.size());
+  }
+  auto it = fm.begin();
+  for (auto rit = ref.begin(); rit != ref.end(); ++rit, ++it)
+  {
+    EXPECT_EQ(it->first, rit->first);
+  }
+}
+TEST_F(AContainerTestFlatMap, Erase)
+{
+  print_process("erase(position)");
+  auto it = imap.erase(imap.find(10));
+  EXPECT_EQ(it->first, 11);
+  print_process("erase(first, last)");
+  it = imap.erase(imap.find(20), imap.find(30));
+  EXPECT_EQ(it->first, 30);
+  EXPECT_EQ(imap.size(), 89);
+  print_process("erase(key)");
+  EXPECT_EQ(imap.erase(50), 1);
+  EXPECT_EQ(imap.erase(50), 0);
+  EXPECT_EQ(imap.size(), 88);
+  imap.clear();
+  EXPECT_TRUE(imap.empty());
+}
+TEST_F(AContainerTestFlatMap, SplitStorage)
+{
+  print_process("split storage matches interleaved storage");
+  split_map sm(imap.begin(), imap.end());
+  uint64_t seed = 2463534242ull;
+  for (int i = 0; i < 2000; ++i)
+  {
+    int k = static_cast<int>(next_rand(seed) % 500);
+    if (i % 3 == 0)
+    {
+      EXPECT_EQ(sm.erase(k), imap.erase(k));
+    }
+    else
+    {
+      sm[k] += i;
+      imap[k] += i;
+    }
+  }
+  ASSERT_EQ(sm.size(), imap.size());
+  auto it = imap.begin();
+  for (auto sit = sm.begin(); sit != sm.end(); ++sit, ++it)
+  {
+    EXPECT_EQ(sit->first, it->first);
+    EXPECT_EQ((*sit).second, it->second);
+  }
+
+  print_process("bulk insert / iterator arithmetic / modify value");
+  zfwstl::vector<zfwstl::pair<int, int>> src;
+  for (int i = 0; i < 100; ++i)
+    src.push_back(zfwstl::pair<int, int>((i * 37) % 100, i));
+  split_map s2(src.begin(), src.end());
+  EXPECT_EQ(s2.size(), 100);
+  EXPECT_EQ(s2.end() - s2.begin(), 100);
+  EXPECT_EQ(s2.begin()[50].first, 50);
+  s2.find(50)->second = -1;
+  EXPECT_EQ(s2[50], -1);
+  split_map::const_iterator cit = s2.lower_bound(98);
+  EXPECT_EQ((cit + 1)->first, 99);
+  zfwstl::pair<int, int> copied = *cit;
+  EXPECT_EQ(copied.first, 98);
+  EXPECT_EQ(s2.erase(s2.begin(), s2.begin() + 10)->first, 10);
+  EXPECT_EQ(s2.size(), 90);
+}
+TEST(FlatMultimapTest, FlatMultimap)
+{
+  print_process("flat_multimap against multimap");
+  zfwstl::flat_multimap<int, int> fm;
+  zfwstl::multimap<int, int> ref;
+  for (int i = 0; i < 200; ++i)
+  {
+    fm.insert(zfwstl::pair<int, int>(i % 7, i));
+    ref.insert(zfwstl::pair<const int, int>(i % 7, i));
+  }
+  ASSERT_EQ(fm.size(), ref.size());
+  auto it = fm.begin();
+  for (auto rit = ref.begin(); rit != ref.end(); ++rit, ++it)
+  {
+    EXPECT_EQ(it->first, rit->first);
+    EXPECT_EQ(it->second, rit->second); // 相等键按插入顺序
+  }
+  EXPECT_EQ(fm.count(3), ref.count(3));
+  auto r = fm.equal_range(3);
+  EXPECT_EQ(r.first->second, 3);
+  EXPECT_EQ(fm.erase(3), ref.erase(3));
+  EXPECT_EQ(fm.count(3), 0);
+
+  print_process("bulk insert keeps existing elements first");
+  zfwstl::vector<zfwstl::pair<int, int>> batch;
+  for (int i = 0; i < 10; ++i)
+    batch.push_back(zfwstl::pair<int, int>(i % 2, -1));
+  fm.insert(batch.begin(), batch.end());
+  EXPECT_EQ(fm.find(1)->second, 1);
+  EXPECT_EQ(fm.count(1), ref.count(1) + 5);
+
+  print_process("split storage");
+  zfwstl::flat_multimap<int, int, zfwstl::less<int>, zfwstl::new_alloc, true> sm(batch.begin(), batch.end());
+  EXPECT_EQ(sm.count(0), 5);
+  sm.insert(zfwstl::pair<int, int>(0, 7));
+  EXPECT_EQ((sm.upper_bound(0) - 1)->second, 7);
+}
+TEST(FlatSetTest, FlatSet)
+{
+  print_process("flat_set");
+  zfwstl::flat_set<int> s{5, 1, 3, 3, 9};
+  EXPECT_EQ(s.size(), 4);
+  EXPECT_EQ(*s.begin(), 1);
+  EXPECT_FALSE(s.insert(3).second);
+  EXPECT_TRUE(s.insert(4).second);
+  EXPECT_EQ(*s.lower_bound(4), 4);
+  EXPECT_EQ(s.erase(1), 1);
+  EXPECT_EQ(*s.begin(), 3);
+  s.reserve(100);
+  EXPECT_GE(s.capacity(), 100);
+
+  print_process("flat_multiset");
+  zfwstl::flat_multiset<int> ms{2, 1, 2, 3, 2};
+  EXPECT_EQ(ms.count(2), 3);
+  ms.insert(2);
+  EXPECT_EQ(ms.count(2), 4);
+  EXPECT_EQ(ms.erase(2), 4);
+  EXPECT_EQ(ms.size(), 2);
+}
+int main(int argc, char **argv)
+{
+  print_start();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif // GOOGLETEST_SAMPLES_flat_map_H_
@@ -214,6 +214,153 @@ TEST_F(HashtableTest, BeginEndIterators)
   auto cbegin_it = iht.cbegin();
   EXPECT_EQ(*cbegin_it, 5); // 检查 cbegin() 是否指向第一个元素
 }
+// 测试可选的桶策略：元素经过多次 resize 后仍能全部找到
+template <class BucketPolicy>
+void check_bucket_policy()
+{
+  zfwstl::hashtable<int,
+                    int,
+                    zfwstl::hash<int>,
+                    zfwstl::identity<int>,
+                    zfwstl::equal_to<int>,
+                    zfwstl::alloc,
+                    BucketPolicy>
+      ht(50, zfwstl::hash<int>(), zfwstl::equal_to<int>());
+  for (int i = 0; i < 20000; ++i)
+    ht.insert_unique(i * 1024); // 低位全为 0 的键，位与取模时最容易冲突
+  EXPECT_EQ(ht.size(), 20000);
+  for (int i = 0; i < 20000; ++i)
+    ASSERT_EQ(ht.count(i * 1024), 1);
+  EXPECT_EQ(ht.count(1), 0);
+  EXPECT_EQ(zfwstl::distance(ht.begin(), ht.end()), 20000);
+  size_t longest = 0;
+  for (size_t i = 0; i < ht.bucket_count(); ++i)
+    longest = zfwstl::max(longest, ht.elems_in_bucket(i));
+  EXPECT_LT(longest, 16);
+  EXPECT_EQ(ht.erase_unique(1024), 1);
+  EXPECT_EQ(ht.count(1024), 0);
+}
+TEST(HashtableBucketPolicy, Policies)
+{
+  print_process("prime_bucket_policy");
+  check_bucket_policy<zfwstl::prime_bucket_policy>();
+  print_process("pow2_bucket_policy");
+  check_bucket_policy<zfwstl::pow2_bucket_policy>();
+  print_process("fastrange_bucket_policy");
+  check_bucket_policy<zfwstl::fastrange_bucket_policy>();
+
+  zfwstl::hashtable<int, int, zfwstl::hash<int>, zfwstl::identity<int>, zfwstl::equal_to<int>,
+                    zfwstl::alloc, zfwstl::pow2_bucket_policy>
+      ht(50, zfwstl::hash<int>(), zfwstl::equal_to<int>());
+  EXPECT_EQ(ht.bucket_count(), 64);
+  EXPECT_THROW(ht.reserve(static_cast<size_t>(-1)), std::length_error); // 不能左移溢出后死循环
+  EXPECT_EQ(ht.bucket_count(), 64u);
+}
+// 测试渐进式 rehash：迁移过程中查找、遍历、删除、复制都能看到全部元素
+TEST(HashtableIncrementalRehash, Migrate)
+{
+  typedef zfwstl::hashtable<int, int, zfwstl::hash<int>, zfwstl::identity<int>, zfwstl::equal_to<int>> int_ht;
+  int_ht ht(50, zfwstl::hash<int>(), zfwstl::equal_to<int>());
+  ht.set_incremental_rehash(true);
+  EXPECT_TRUE(ht.incremental_rehash());
+
+  print_process("insert while migrating");
+  bool seen_rehashing = false;
+  int checked_at = -1;
+  for (int i = 0; i < 20000; ++i)
+  {
+    ht.insert_unique(i);
+    if (ht.rehashing() && checked_at < 0)
+    { // 第一次处于迁移中时检查一遍，旧表与新表中的元素都要能找到
+      seen_rehashing = true;
+      checked_at = i;
+      for (int j = 0; j <= i; ++j)
+        ASSERT_EQ(ht.count(j), 1);
+      EXPECT_EQ(zfwstl::distance(ht.begin(), ht.end()), i + 1);
+      int_ht copy(ht);
+      EXPECT_EQ(copy.size(), static_cast<size_t>(i + 1));
+      for (int j = 0; j <= i; ++j)
+        ASSERT_EQ(copy.count(j), 1);
+    }
+  }
+  EXPECT_TRUE(seen_rehashing);
+  EXPECT_FALSE(ht.insert_unique(100).second);
+  EXPECT_EQ(ht.size(), 20000);
+  for (int i = 0; i < 20000; ++i)
+    ASSERT_EQ(ht.count(i), 1);
+  EXPECT_EQ(zfwstl::distance(ht.begin(), ht.end()), 20000);
+
+  print_process("erase while migrating");
+  while (!ht.rehashing())
+    ht.insert_unique(static_cast<int>(ht.size()));
+  const int n = static_cast<int>(ht.size());
+  for (int i = 0; i < n; i += 2)
+    ASSERT_EQ(ht.erase_unique(i), 1);
+  EXPECT_TRUE(ht.rehashing());
+  for (int i = 0; i < n; ++i)
+    ASSERT_EQ(ht.count(i), static_cast<size_t>(i & 1));
+  EXPECT_EQ(zfwstl::distance(ht.begin(), ht.end()), n / 2);
+  size_t in_buckets = 0; // 尚未迁移的节点也按新表计入各 bucket
+  for (size_t b = 0; b < ht.bucket_count(); ++b)
+    in_buckets += ht.elems_in_bucket(b);
+  EXPECT_EQ(in_buckets, ht.size());
+
+  print_process("disable finishes migration");
+  ht.set_incremental_rehash(false);
+  EXPECT_FALSE(ht.rehashing());
+  EXPECT_EQ(zfwstl::distance(ht.begin(), ht.end()), n / 2);
+  for (int i = 1; i < n; i += 2)
+    ASSERT_EQ(ht.count(i), 1);
+
+  print_process("insert_equal while migrating");
+  int_ht multi(50, zfwstl::hash<int>(), zfwstl::equal_to<int>());
+  multi.set_incremental_rehash(true);
+  for (int i = 0; i < 5000; ++i)
+  {
+    multi.insert_equal(i % 1000);
+    if (multi.rehashing())
+    {
+      auto p = multi.equal_range_multi(i % 1000);
+      ASSERT_EQ(static_cast<size_t>(zfwstl::distance(p.first, p.second)), multi.count(i % 1000));
+    }
+  }
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(multi.count(i), 5);
+  multi.clear();
+  EXPECT_FALSE(multi.rehashing());
+  EXPECT_EQ(multi.begin(), multi.end());
+}
+// 测试批量插入：前向迭代器区间一次扩容到位
+TEST(HashtableBulkInsert, Reserve)
+{
+  typedef zfwstl::hashtable<int, int, zfwstl::hash<int>, zfwstl::identity<int>, zfwstl::equal_to<int>> int_ht;
+  zfwstl::vector<int> keys;
+  for (int i = 0; i < 10000; ++i)
+    keys.push_back(i % 5000);
+  int_ht ht(50, zfwstl::hash<int>(), zfwstl::equal_to<int>());
+  ht.insert_unique(keys.begin(), keys.end());
+  EXPECT_EQ(ht.size(), 5000);
+  EXPECT_GE(ht.bucket_count(), keys.size());
+  for (int i = 0; i < 5000; ++i)
+    ASSERT_EQ(ht.count(i), 1);
+
+  int_ht multi(50, zfwstl::hash<int>(), zfwstl::equal_to<int>());
+  multi.insert_equal(keys.begin(), keys.end());
+  multi.insert_equal(keys.begin(), keys.begin() + 100); // 非空表上再批量插入，元素数要累加
+  EXPECT_EQ(multi.size(), 10100);
+  EXPECT_EQ(multi.count(7), 3);
+  EXPECT_EQ(multi.count(4999), 2);
+  EXPECT_GE(multi.bucket_count(), multi.size());
+
+  print_process("reserve");
+  int_ht r(50, zfwstl::hash<int>(), zfwstl::equal_to<int>());
+  r.reserve(100000);
+  const size_t buckets = r.bucket_count();
+  EXPECT_GE(buckets, 100000);
+  for (int i = 0; i < 100000; ++i)
+    r.insert_unique(i);
+  EXPECT_EQ(r.bucket_count(), buckets);
+}
 int main(int argc, char **argv)
 {
   print_start();
@@ -358,6 +358,24 @@ TEST_F(SContainerTestList, Sort)
             { return a < b; }, '\0');
   EXPECT_EQ(lst2, zfwstl::list<int>({1, 2, 3, 5, 6, 8}));
 }
+// 测试可替换的空间配置器 Alloc
+TEST_F(SContainerTestList, Allocator)
+{
+  print_process("list<int, new_alloc>");
+  zfwstl::list<int, zfwstl::new_alloc> a = {3, 1, 2};
+  a.sort();
+  EXPECT_EQ(a, (zfwstl::list<int, zfwstl::new_alloc>({1, 2, 3})));
+
+  print_process("list<int, single_client_alloc>");
+  zfwstl::list<int, zfwstl::single_client_alloc> b;
+  for (int i = 0; i < 1000; ++i)
+    b.push_back(i);
+  b.remove_if([](int x)
+              { return x % 2 == 0; });
+  EXPECT_EQ(b.size(), 500);
+  EXPECT_EQ(b.front(), 1);
+  EXPECT_EQ(b.back(), 999);
+}
 int main(int argc, char **argv)
 {
   print_start();
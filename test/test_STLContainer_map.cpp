@@ -230,6 +230,74 @@ TEST_F(AContainerTestMap, BeginEndIterators)
   auto crend_it = simap.crend();
   EXPECT_EQ((*(--crend_it)).first, "one"); // 检查 crend() 前一个元素是否是最后一个元素
 }
+// 测试可替换的空间配置器 Alloc
+TEST_F(AContainerTestMap, Allocator)
+{
+  print_process("map<int, int, less<int>, single_client_alloc>");
+  zfwstl::map<int, int, zfwstl::less<int>, zfwstl::single_client_alloc> m;
+  for (int i = 0; i < 1000; ++i)
+    m[i] = i * 2;
+  EXPECT_EQ(m.size(), 1000);
+  EXPECT_EQ(m[500], 1000);
+
+  print_process("map<int, int, less<int>, new_alloc>");
+  zfwstl::map<int, int, zfwstl::less<int>, zfwstl::new_alloc> n;
+  n.insert(zfwstl::make_pair(1, 1));
+  EXPECT_EQ(n.begin()->second, 1);
+}
+// 以 id 排序的记录，只能用 int 与之比较，无法由 int 构造
+struct IdRecord
+{
+  int id;
+  std::string name;
+  bool operator<(const IdRecord &rhs) const { return id < rhs.id; }
+};
+struct IdLess
+{
+  typedef void is_transparent;
+  bool operator()(const IdRecord &a, const IdRecord &b) const { return a.id < b.id; }
+  bool operator()(const IdRecord &a, int b) const { return a.id < b; }
+  bool operator()(int a, const IdRecord &b) const { return a < b.id; }
+};
+// 测试透明比较器下的异构查找
+TEST_F(AContainerTestMap, TransparentLookup)
+{
+  print_process("map<std::string, int, less<>> lookup by const char*");
+  zfwstl::map<std::string, int, zfwstl::less<>> m;
+  m["apple"] = 1;
+  m["banana"] = 2;
+  m["cherry"] = 3;
+  EXPECT_EQ(m.find("banana")->second, 2);
+  EXPECT_EQ(m.find("durian"), m.end());
+  EXPECT_EQ(m.count("apple"), 1);
+  EXPECT_EQ(m.lower_bound("b")->first, "banana");
+  EXPECT_EQ(m.upper_bound("banana")->first, "cherry");
+  auto range = m.equal_range("cherry");
+  EXPECT_EQ(zfwstl::distance(range.first, range.second), 1);
+  EXPECT_EQ(m.erase("apple"), 1);
+  EXPECT_EQ(m.erase("apple"), 0);
+  EXPECT_EQ(m.size(), 2);
+
+  print_process("map<IdRecord, int, IdLess> lookup by int");
+  zfwstl::map<IdRecord, int, IdLess> r;
+  r[IdRecord{3, "c"}] = 30;
+  r[IdRecord{1, "a"}] = 10;
+  r[IdRecord{2, "b"}] = 20;
+  EXPECT_EQ(r.find(2)->second, 20);
+  EXPECT_EQ(r.find(2)->first.name, "b");
+  EXPECT_EQ(r.count(4), 0);
+  EXPECT_EQ(r.lower_bound(2)->second, 20);
+  EXPECT_EQ(r.erase(1), 1);
+  EXPECT_EQ(r.begin()->first.id, 2);
+
+  print_process("erase(key) with non-transparent less<int>");
+  zfwstl::map<int, int> n;
+  n[1] = 1;
+  n[2] = 2;
+  EXPECT_EQ(n.erase(1), 1);
+  EXPECT_EQ(n.erase(1), 0);
+  EXPECT_EQ(n.size(), 1);
+}
 int main(int argc, char **argv)
 {
   print_start();
@@ -4,12 +4,17 @@
 #include <iostream>
 #include <cstddef> // for size_t, ptrdiff_t
 #include <string>
+#include <random>
 #include "../STL/priority_queue.h"
+#include "../STL/radix_heap.h"
 #include "../STL/vector.h"
+#include "../src/algorithms/algo.h"
 /**
  * SContainerTestPriQue: 序列容器测试类
  * 测试类继承自 ::testing::Test，它将用于所有测试用例
  * -----------------------------------------------------
+ * DAryHeap：dary_make_heap / push / pop / sort / is_heap 在 D = 2, 3, 4, 8 下与排序结果一致；4 叉、8 叉 priority_queue
+ * RadixHeap：单调基数堆按键从小到大取出，键小于 last_key 时抛出异常，随机的 hold 操作与二叉堆结果一致
  */
 void print_start()
 {
@@ -122,6 +127,147 @@ TEST_F(SContainerTestPriQue, Swap)
   EXPECT_EQ(v3.size(), 5);
   EXPECT_EQ(v1.top(), 15);
 }
+// 测试 d 叉堆
+template <size_t D>
+void check_dary_heap(const zfwstl::vector<int> &src)
+{
+  zfwstl::vector<int> v(src), sorted(src);
+  zfwstl::sort(sorted.begin(), sorted.end());
+  zfwstl::dary_make_heap<D>(v.begin(), v.end());
+  ASSERT_TRUE(zfwstl::dary_is_heap<D>(v.begin(), v.end())) << D;
+  zfwstl::vector<int> h;
+  for (size_t i = 0; i < src.size(); ++i)
+  {
+    h.push_back(src[i]);
+    zfwstl::dary_push_heap<D>(h.begin(), h.end());
+  }
+  ASSERT_TRUE(zfwstl::dary_is_heap<D>(h.begin(), h.end())) << D;
+  for (size_t n = h.size(); n > 0; --n)
+  {
+    ASSERT_EQ(h.front(), sorted[n - 1]) << D;
+    zfwstl::dary_pop_heap<D>(h.begin(), h.begin() + n);
+    ASSERT_TRUE(zfwstl::dary_is_heap<D>(h.begin(), h.begin() + n - 1)) << D;
+  }
+  EXPECT_TRUE(h == sorted); // pop 出的元素依次放在尾部
+  zfwstl::dary_sort_heap<D>(v.begin(), v.end());
+  EXPECT_TRUE(v == sorted);
+  zfwstl::dary_make_heap<D>(v.begin(), v.end(), zfwstl::greater<int>()); // 小顶堆
+  if (!sorted.empty())
+  {
+    EXPECT_EQ(v.front(), sorted.front());
+  }
+}
+TEST_F(SContainerTestPriQue, DAryHeap)
+{
+  print_process("dary heap algorithms");
+  std::mt19937 rng(7);
+  for (int n : {0, 1, 2, 3, 5, 8, 9, 17, 64, 1000})
+  {
+    zfwstl::vector<int> src;
+    for (int i = 0; i < n; ++i)
+      src.push_back(static_cast<int>(rng() % 100)); // 有重复元素
+    check_dary_heap<2>(src);
+    check_dary_heap<3>(src);
+    check_dary_heap<4>(src);
+    check_dary_heap<8>(src);
+  }
+
+  print_process("4-ary / 8-ary priority_queue");
+  zfwstl::priority_queue<int, zfwstl::vector<int>, zfwstl::less<int>, 4> q4 = {3, 9, 1, 7, 5};
+  EXPECT_EQ(q4.top(), 9);
+  zfwstl::priority_queue<int, zfwstl::vector<int>, zfwstl::greater<int>, 8> q8;
+  zfwstl::vector<int> all;
+  for (int i = 0; i < 5000; ++i)
+  {
+    const int x = static_cast<int>(rng() % 10000);
+    q4.push(x);
+    q8.emplace(x);
+    all.push_back(x);
+    if (i % 3 == 2)
+    { // 穿插取出
+      q8.pop();
+    }
+  }
+  EXPECT_EQ(q4.size(), 5005u);
+  all.push_back(3), all.push_back(9), all.push_back(1), all.push_back(7), all.push_back(5);
+  zfwstl::sort(all.begin(), all.end());
+  for (size_t i = all.size(); i > 0; --i)
+  {
+    ASSERT_EQ(q4.top(), all[i - 1]);
+    q4.pop();
+  }
+  EXPECT_TRUE(q4.empty());
+  int prev = -1;
+  while (!q8.empty())
+  { // 小顶堆依次取出不减
+    ASSERT_GE(q8.top(), prev);
+    prev = q8.top();
+    q8.pop();
+  }
+}
+// 测试单调基数堆
+TEST_F(SContainerTestPriQue, RadixHeap)
+{
+  print_process("radix heap");
+  zfwstl::radix_heap<unsigned, std::string> rh;
+  EXPECT_TRUE(rh.empty());
+  rh.push(10, "ten");
+  rh.push(3, "three");
+  rh.emplace(7, 3, 's');
+  rh.push(3, "three again");
+  EXPECT_EQ(rh.size(), 4u);
+  EXPECT_EQ(rh.top_key(), 3u);
+  EXPECT_EQ(rh.top().second.substr(0, 5), "three");
+  rh.pop();
+  EXPECT_EQ(rh.top_key(), 3u);
+  rh.pop();
+  EXPECT_EQ(rh.last_key(), 3u);
+  EXPECT_THROW(rh.push(2, "late"), std::out_of_range);
+  rh.push(3, "same");
+  EXPECT_EQ(rh.top().second, "same");
+  rh.pop();
+  EXPECT_EQ(rh.top().second, "sss");
+  rh.pop();
+  EXPECT_EQ(rh.top_key(), 10u);
+  rh.clear();
+  EXPECT_TRUE(rh.empty());
+  rh.push(0, "zero"); // clear 之后 last 回到 0
+  EXPECT_EQ(rh.top_key(), 0u);
+
+  print_process("hold model against binary heap");
+  zfwstl::radix_heap<uint64_t, int> r;
+  zfwstl::priority_queue<uint64_t, zfwstl::vector<uint64_t>, zfwstl::greater<uint64_t>> ref;
+  std::mt19937_64 rng(11);
+  for (int i = 0; i < 1000; ++i)
+  {
+    const uint64_t k = rng() % 100000;
+    r.push(k, i);
+    ref.push(k);
+  }
+  for (int i = 0; i < 20000; ++i)
+  { // 取出最小的事件，再安排一个更晚的事件
+    ASSERT_EQ(r.top_key(), ref.top());
+    const uint64_t k = r.top_key();
+    r.pop();
+    ref.pop();
+    const uint64_t next = k + (i % 7 == 0 ? 0 : rng() % (uint64_t(1) << (i % 40)));
+    r.push(next, i);
+    ref.push(next);
+  }
+  while (!ref.empty())
+  {
+    ASSERT_EQ(r.top_key(), ref.top());
+    r.pop();
+    ref.pop();
+  }
+  EXPECT_TRUE(r.empty());
+  zfwstl::radix_heap<unsigned char, int> small;
+  small.push(255, 1);
+  small.push(0, 2);
+  EXPECT_EQ(small.top_key(), 0);
+  small.pop();
+  EXPECT_EQ(small.top_key(), 255);
+}
 int main(int argc, char **argv)
 {
   print_start();
@@ -8,6 +8,7 @@
 #include "../src/functional.h" //for less
 #include "../src/util.h"       //for make_pair
 #include "../src/iterator.h"   //for distance()
+#include "../STL/vector.h"
 /**
  * SContainerTestRBTree: 序列容器测试类
  * 测试类继承自 ::testing::Test，它将用于所有测试用例
@@ -230,6 +231,61 @@ TEST_F(RBTreeTest, BeginEndIterators)
   auto crend_it = itree.crend();
   EXPECT_EQ(*(--crend_it), 5); // 检查 crend() 前一个元素是否是最后一个元素
 }
+// 测试批量插入：已排序输入 O(n) 建树，其余逐个插入，结果都必须是合法的红黑树
+TEST(RBTreeBulkInsert, SortedBuild)
+{
+  typedef zfwstl::rb_tree<int, int, KeyOfValue<int>, zfwstl::less<int>> int_tree;
+  print_process("sorted input of every size");
+  for (int n = 0; n <= 300; ++n)
+  {
+    zfwstl::vector<int> v;
+    for (int i = 0; i < n; ++i)
+      v.push_back(i * 2);
+    int_tree t;
+    t.insert_unique(v.begin(), v.end());
+    ASSERT_TRUE(t.__rb_verify()) << "n = " << n;
+    ASSERT_EQ(t.size(), static_cast<size_t>(n));
+    EXPECT_TRUE(zfwstl::equal(v.begin(), v.end(), t.begin()));
+    if (n > 0)
+    {
+      EXPECT_EQ(*t.begin(), 0);
+      EXPECT_EQ(*(--t.end()), (n - 1) * 2);
+    }
+  }
+
+  print_process("sorted input with duplicates");
+  int dup[] = {1, 1, 2, 3, 3, 3, 4, 7, 7, 9};
+  int_tree u;
+  u.insert_unique(dup, dup + 10);
+  EXPECT_TRUE(u.__rb_verify());
+  EXPECT_EQ(u.size(), 6);
+  int expect[] = {1, 2, 3, 4, 7, 9};
+  EXPECT_TRUE(zfwstl::equal(expect, expect + 6, u.begin()));
+  int_tree m;
+  m.insert_equal(dup, dup + 10);
+  EXPECT_TRUE(m.__rb_verify());
+  EXPECT_EQ(m.size(), 10);
+  EXPECT_EQ(m.count_multi(3), 3);
+  EXPECT_TRUE(zfwstl::equal(dup, dup + 10, m.begin()));
+
+  print_process("copy from another tree, then insert after / before");
+  int_tree c;
+  c.insert_unique(u.begin(), u.end());
+  EXPECT_TRUE(c.__rb_verify());
+  EXPECT_EQ(c.size(), u.size());
+  zfwstl::vector<int> tail;
+  for (int i = 10; i < 1000; ++i)
+    tail.push_back(i);
+  c.insert_unique(tail.begin(), tail.end()); // 都大于当前最大键，逐个挂在最右节点下
+  EXPECT_TRUE(c.__rb_verify());
+  EXPECT_EQ(c.size(), 6 + 990);
+  int unsorted[] = {500, 0, -3, 8, 8, 1000, 5};
+  c.insert_unique(unsorted, unsorted + 7);
+  EXPECT_TRUE(c.__rb_verify());
+  EXPECT_EQ(c.size(), 996 + 5);
+  EXPECT_EQ(*c.begin(), -3);
+  EXPECT_EQ(*(--c.end()), 1000);
+}
 int main(int argc, char **argv)
 {
   print_start();
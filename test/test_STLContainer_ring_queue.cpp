@@ -0,0 +1,276 @@
+#ifndef GOOGLETEST_SAMPLES_ring_queue_H_
+#define GOOGLETEST_SAMPLES_ring_queue_H_
+#include "../../googletest-1.14.0/googletest/include/gtest/gtest.h"
+#include <iostream>
+#include <cstddef> // for size_t, ptrdiff_t
+#include <string>
+#include <thread>
+#include "../STL/ring_queue.h"
+#include "../STL/vector.h"
+/**
+ * SContainerTestRingQueue: 无锁环形队列测试类
+ * -----------------------------------------------------
+ * SpscBasic：容量取整、满/空、绕回、批量 push_n / pop_n
+ * SpscThreads：一个生产者一个消费者，检查元素个数与先后次序
+ * MpmcBasic：单线程下的满/空、绕回、批量操作、容量为 1 的情况
+ * MpmcThreads：4 个生产者 4 个消费者(混用单个与批量接口)，每个元素恰好被取出一次
+ * NonTrivial：string 元素，析构时销毁队列中剩余的元素
+ */
+void print_start()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[--------------- Run container test : ring_queue ---------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+}
+void print_process(string tmp)
+{
+  std::cout << "[---- " << tmp << " ----]\n";
+}
+// 测试类
+class SContainerTestRingQueue : public ::testing::Test
+{
+protected:
+  zfwstl::spsc_queue<int> sq{5};
+  zfwstl::mpmc_queue<int> mq{5};
+};
+//===============测试用例开始===============
+TEST_F(SContainerTestRingQueue, SpscBasic)
+{
+  print_process("capacity / full / empty");
+  EXPECT_EQ(sq.capacity(), 8u);
+  EXPECT_THROW(zfwstl::spsc_queue<int>(0), std::length_error);
+  int x = -1;
+  EXPECT_FALSE(sq.try_pop(x));
+  for (int i = 0; i < 8; ++i)
+    EXPECT_TRUE(sq.try_push(i));
+  EXPECT_FALSE(sq.try_push(8));
+  EXPECT_EQ(sq.size_approx(), 8u);
+
+  print_process("wrap around");
+  for (int i = 8; i < 100; ++i)
+  {
+    ASSERT_TRUE(sq.try_pop(x));
+    EXPECT_EQ(x, i - 8);
+    ASSERT_TRUE(sq.try_emplace(i));
+  }
+  EXPECT_EQ(sq.size_approx(), 8u);
+
+  print_process("push_n / pop_n");
+  int out[16];
+  EXPECT_EQ(sq.pop_n(out, 3), 3u);
+  EXPECT_EQ(out[0], 92);
+  EXPECT_EQ(out[2], 94);
+  int in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(sq.push_n(in, 10), 3u); // 只剩 3 个空位
+  EXPECT_EQ(sq.push_n(in, 10), 0u);
+  EXPECT_EQ(sq.pop_n(out, 16), 8u);
+  EXPECT_EQ(out[4], 99);
+  EXPECT_EQ(out[7], 2);
+  EXPECT_TRUE(sq.empty_approx());
+  EXPECT_EQ(sq.pop_n(out, 16), 0u);
+}
+
+TEST_F(SContainerTestRingQueue, SpscThreads)
+{
+  print_process("one producer, one consumer");
+  const int n = 500000;
+  zfwstl::spsc_queue<long> q(64);
+  std::thread producer([&q, n]
+                       {
+    long batch[7];
+    for (long i = 0; i < n;)
+    {
+      if (i % 3 == 0)
+      {
+        while (!q.try_push(i))
+          std::this_thread::yield();
+        ++i;
+      }
+      else
+      {
+        long cnt = n - i < 7 ? n - i : 7;
+        for (long k = 0; k < cnt; ++k)
+          batch[k] = i + k;
+        const size_t pushed = q.push_n(batch, cnt);
+        if (pushed == 0)
+          std::this_thread::yield();
+        i += static_cast<long>(pushed);
+      }
+    } });
+  long expect = 0;
+  long buf[5];
+  bool ordered = true;
+  while (expect < n)
+  {
+    long x;
+    if (expect % 2 == 0 && q.try_pop(x))
+    {
+      ordered = ordered && x == expect;
+      ++expect;
+    }
+    else
+    {
+      const size_t cnt = q.pop_n(buf, 5);
+      for (size_t k = 0; k < cnt; ++k)
+        ordered = ordered && buf[k] == expect++;
+      if (cnt == 0)
+        std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(expect, n);
+  EXPECT_TRUE(q.empty_approx());
+}
+
+TEST_F(SContainerTestRingQueue, MpmcBasic)
+{
+  print_process("capacity / full / empty");
+  EXPECT_EQ(mq.capacity(), 8u);
+  int x = -1;
+  EXPECT_FALSE(mq.try_pop(x));
+  for (int i = 0; i < 8; ++i)
+    EXPECT_TRUE(mq.try_push(i));
+  EXPECT_FALSE(mq.try_push(8));
+  for (int i = 8; i < 50; ++i)
+  {
+    ASSERT_TRUE(mq.try_pop(x));
+    EXPECT_EQ(x, i - 8);
+    ASSERT_TRUE(mq.try_emplace(i));
+  }
+
+  print_process("push_n / pop_n");
+  int out[16];
+  EXPECT_EQ(mq.pop_n(out, 5), 5u);
+  EXPECT_EQ(out[0], 42);
+  EXPECT_EQ(out[4], 46);
+  int in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(mq.push_n(in, 10), 5u);
+  EXPECT_EQ(mq.push_n(in, 1), 0u);
+  EXPECT_EQ(mq.pop_n(out, 0), 0u);
+  EXPECT_EQ(mq.pop_n(out, 16), 8u);
+  EXPECT_EQ(out[2], 49);
+  EXPECT_EQ(out[7], 4);
+  EXPECT_EQ(mq.pop_n(out, 16), 0u);
+  EXPECT_FALSE(mq.try_pop(x));
+
+  print_process("capacity 1 is rounded up to 2");
+  zfwstl::mpmc_queue<int> tiny(1);
+  EXPECT_EQ(tiny.capacity(), 2u);
+  EXPECT_TRUE(tiny.try_push(1));
+  EXPECT_TRUE(tiny.try_push(2));
+  EXPECT_FALSE(tiny.try_push(3));
+  EXPECT_TRUE(tiny.try_pop(x));
+  EXPECT_EQ(x, 1);
+}
+
+TEST_F(SContainerTestRingQueue, MpmcThreads)
+{
+  print_process("4 producers, 4 consumers");
+  const int producers = 4, consumers = 4, per = 200000;
+  zfwstl::mpmc_queue<int> q(128);
+  std::thread threads[producers + consumers];
+  zfwstl::vector<zfwstl::vector<int>> got(consumers);
+  std::atomic<int> done(0);
+  for (int p = 0; p < producers; ++p)
+    threads[p] = std::thread([&q, p, per]
+                                  {
+      int batch[4];
+      for (int i = 0; i < per;)
+      {
+        const int v = p * per + i;
+        if (i % 2 == 0)
+        {
+          if (q.try_push(v))
+            ++i;
+          else
+            std::this_thread::yield();
+        }
+        else
+        {
+          const int cnt = per - i < 4 ? per - i : 4;
+          for (int k = 0; k < cnt; ++k)
+            batch[k] = v + k;
+          const size_t pushed = q.push_n(batch, cnt);
+          if (pushed == 0)
+            std::this_thread::yield();
+          i += static_cast<int>(pushed);
+        }
+      } });
+  for (int c = 0; c < consumers; ++c)
+    threads[producers + c] = std::thread([&q, &got, &done, c, producers, per]
+                                  {
+      int buf[3];
+      while (done.load() < producers * per)
+      {
+        int x;
+        if (c % 2 == 0 && q.try_pop(x))
+        {
+          got[c].push_back(x);
+          done.fetch_add(1);
+        }
+        else
+        {
+          const size_t cnt = q.pop_n(buf, 3);
+          for (size_t k = 0; k < cnt; ++k)
+            got[c].push_back(buf[k]);
+          done.fetch_add(static_cast<int>(cnt));
+          if (cnt == 0)
+            std::this_thread::yield();
+        }
+      } });
+  for (auto &t : threads)
+    t.join();
+  zfwstl::vector<int> seen(producers * per, 0);
+  bool fifo_per_producer = true;
+  for (auto &g : got)
+  {
+    zfwstl::vector<int> last(producers, -1); // 同一个消费者看到的同一生产者的元素是递增的
+    for (int v : g)
+    {
+      ++seen[v];
+      fifo_per_producer = fifo_per_producer && v > last[v / per];
+      last[v / per] = v;
+    }
+  }
+  for (int i = 0; i < producers * per; ++i)
+    ASSERT_EQ(seen[i], 1) << i;
+  EXPECT_TRUE(fifo_per_producer);
+  EXPECT_TRUE(q.empty_approx());
+}
+
+TEST_F(SContainerTestRingQueue, NonTrivial)
+{
+  print_process("string elements");
+  const std::string long_str(100, 'x'); // 超出短字符串缓冲区，泄漏时 ASan 可以发现
+  {
+    zfwstl::spsc_queue<std::string> s(4);
+    zfwstl::mpmc_queue<std::string> m(4);
+    for (int i = 0; i < 10; ++i)
+    {
+      s.try_push(long_str + std::to_string(i));
+      m.try_emplace(3, 'a' + i);
+    }
+    std::string x;
+    EXPECT_TRUE(s.try_pop(x));
+    EXPECT_EQ(x, long_str + "0");
+    EXPECT_TRUE(m.try_pop(x));
+    EXPECT_EQ(x, "aaa");
+    std::string arr[3] = {long_str, "b", "c"};
+    EXPECT_EQ(s.push_n(arr, 3), 1u);
+    EXPECT_EQ(m.push_n(arr, 3), 1u);
+    std::string out[4];
+    EXPECT_EQ(m.pop_n(out, 4), 4u);
+    EXPECT_EQ(out[0], "bbb");
+    EXPECT_EQ(out[3], long_str);
+    EXPECT_TRUE(m.try_push(long_str));
+    // 离开作用域时 s 中剩 4 个、m 中剩 1 个元素，由析构函数销毁
+  }
+}
+int main(int argc, char **argv)
+{
+  print_start();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif // GOOGLETEST_SAMPLES_ring_queue_H_
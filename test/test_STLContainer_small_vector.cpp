@@ -0,0 +1,410 @@
+#ifndef GOOGLETEST_SAMPLES_small_vector_H_
+#define GOOGLETEST_SAMPLES_small_vector_H_
+#include "../../googletest-1.14.0/googletest/include/gtest/gtest.h"
+#include <iostream>
+#include <cstddef> // for size_t, ptrdiff_t
+#include <string>
+#include "../STL/small_vector.h"
+#include "../STL/vector.h"
+/**
+ * SContainerTestSmallVec: 带内嵌缓冲区的 vector 测试类
+ * -----------------------------------------------------
+ * Constructor：各种构造函数，不超过 N 个元素时不配置内存
+ * Spill：push_back 超过 N 个元素后搬到堆上，元素不变
+ * InsertErase：insert / emplace / erase 与 vector 对照，包括插入本容器中的元素
+ * RangeInsert：前向/输入迭代器区间与 initializer_list 插入，空位足够时就地挪动，不够时搬到堆上
+ * MoveSwap：内嵌存储与堆存储之间的移动构造、移动赋值、swap
+ * NonTrivial：string 元素，检查搬移后内容与析构
+ * Exceptions：构造函数中元素构造抛出异常时不泄漏；移动可能抛出异常时扩容改为复制，失败后原元素不变
+ */
+void print_start()
+{
+  std::cout << "[===============================================================]\n";
+  std::cout << "[-------------- Run container test : small_vector --------------]\n";
+  std::cout << "[-------------------------- API test ---------------------------]\n";
+}
+void print_process(string tmp)
+{
+  std::cout << "[---- " << tmp << " ----]\n";
+}
+// 统计配置次数
+struct counting_alloc
+{
+  static size_t allocs;
+  static void *allocate(size_t n)
+  {
+    ++allocs;
+    return zfwstl::new_alloc::allocate(n);
+  }
+  static void deallocate(void *p, size_t n) { zfwstl::new_alloc::deallocate(p, n); }
+};
+size_t counting_alloc::allocs = 0;
+typedef zfwstl::small_vector<int, 4, counting_alloc> counted_vec;
+
+template <class A, class B>
+void expect_same(const A &a, const B &b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i], b[i]);
+}
+// 测试类
+class SContainerTestSmallVec : public ::testing::Test
+{
+protected:
+  zfwstl::small_vector<int, 4> v1, v2;
+
+  void SetUp() override
+  {
+    v1 = {1, 2, 3};          // 内嵌存储
+    v2 = {6, 7, 8, 9, 10};   // 堆存储
+  }
+};
+//===============测试用例开始===============
+TEST_F(SContainerTestSmallVec, Constructor)
+{
+  print_process("Default constructor");
+  counting_alloc::allocs = 0;
+  counted_vec a;
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.is_inline());
+  EXPECT_EQ(a.capacity(), 4u);
+
+  print_process("Fill / initializer_list / range constructor");
+  counted_vec b(4, 7);
+  counted_vec c{1, 2, 3};
+  int arr[] = {5, 6, 7, 8};
+  counted_vec d(arr, arr + 4);
+  EXPECT_EQ(counting_alloc::allocs, 0u);
+  EXPECT_EQ(b.size(), 4u);
+  EXPECT_EQ(b[3], 7);
+  EXPECT_EQ(c.back(), 3);
+  EXPECT_EQ(d.front(), 5);
+  counted_vec e(5, 1);
+  EXPECT_EQ(counting_alloc::allocs, 1u);
+  EXPECT_FALSE(e.is_inline());
+
+  print_process("Copy constructor");
+  zfwstl::small_vector<int, 4> f(v1), g(v2);
+  EXPECT_TRUE(f == v1);
+  EXPECT_TRUE(g == v2);
+  EXPECT_TRUE(f.is_inline());
+  EXPECT_THROW(f.at(3), std::out_of_range);
+}
+
+TEST_F(SContainerTestSmallVec, Spill)
+{
+  print_process("push_back past N");
+  counting_alloc::allocs = 0;
+  counted_vec v;
+  for (int i = 0; i < 4; ++i)
+    v.push_back(i);
+  EXPECT_EQ(counting_alloc::allocs, 0u);
+  EXPECT_TRUE(v.is_inline());
+  v.push_back(v[0]); // 扩容时参数引用的是本容器中的元素
+  EXPECT_EQ(counting_alloc::allocs, 1u);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 8u);
+  for (int i = 5; i < 100; ++i)
+    v.push_back(i);
+  EXPECT_EQ(v.size(), 100u);
+  EXPECT_EQ(v[4], 0);
+  for (int i = 5; i < 100; ++i)
+    EXPECT_EQ(v[i], i);
+
+  print_process("reserve / resize / clear");
+  zfwstl::small_vector<int, 4> w;
+  w.reserve(3);
+  EXPECT_TRUE(w.is_inline());
+  w.reserve(10);
+  EXPECT_FALSE(w.is_inline());
+  EXPECT_GE(w.capacity(), 10u);
+  w.resize(6, 9);
+  EXPECT_EQ(w.size(), 6u);
+  EXPECT_EQ(w.back(), 9);
+  w.resize(2);
+  EXPECT_EQ(w.size(), 2u);
+  w.clear();
+  EXPECT_TRUE(w.empty());
+}
+
+TEST_F(SContainerTestSmallVec, InsertErase)
+{
+  print_process("insert / emplace / erase against vector");
+  zfwstl::small_vector<int, 4> s;
+  zfwstl::vector<int> ref;
+  unsigned x = 12345;
+  for (int round = 0; round < 2000; ++round)
+  {
+    x = x * 1103515245u + 12345u;
+    const size_t pos = s.empty() ? 0 : (x >> 8) % (s.size() + 1);
+    const int op = (x >> 4) % 5;
+    if (op == 0 && !s.empty() && pos < s.size())
+    {
+      s.erase(s.begin() + pos);
+      ref.erase(ref.begin() + pos);
+    }
+    else if (op == 1)
+    {
+      const size_t n = (x >> 20) % 6;
+      s.insert(s.begin() + pos, n, round);
+      ref.insert(ref.begin() + pos, n, round);
+    }
+    else if (op == 2 && s.size() > 20)
+    {
+      s.erase(s.begin(), s.begin() + 10);
+      ref.erase(ref.begin(), ref.begin() + 10);
+    }
+    else
+    {
+      s.emplace(s.begin() + pos, round);
+      ref.insert(ref.begin() + pos, round);
+    }
+    expect_same(s, ref);
+  }
+
+  print_process("insert an element of the container itself");
+  zfwstl::small_vector<int, 4> t{1, 2, 3, 4};
+  t.insert(t.begin(), 3, t[3]);
+  EXPECT_EQ(t.size(), 7u);
+  EXPECT_EQ(t[0], 4);
+  EXPECT_EQ(t[2], 4);
+  EXPECT_EQ(t[3], 1);
+  t.insert(t.begin() + 1, t.back());
+  EXPECT_EQ(t[1], 4);
+  EXPECT_EQ(t.size(), 8u);
+
+  print_process("erase an empty range");
+  zfwstl::small_vector<std::string, 2> heap_strs;
+  zfwstl::small_vector<std::string, 8> inline_strs;
+  for (int i = 0; i < 5; ++i)
+  {
+    heap_strs.push_back("item" + std::to_string(i));
+    inline_strs.push_back("item" + std::to_string(i));
+  }
+  EXPECT_EQ(heap_strs.erase(heap_strs.begin() + 1, heap_strs.begin() + 1), heap_strs.begin() + 1);
+  inline_strs.erase(inline_strs.begin() + 1, inline_strs.begin() + 1);
+  inline_strs.erase(inline_strs.end(), inline_strs.end());
+  EXPECT_EQ(heap_strs.size(), 5u);
+  EXPECT_EQ(inline_strs.size(), 5u);
+  for (int i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(heap_strs[i], "item" + std::to_string(i));
+    EXPECT_EQ(inline_strs[i], "item" + std::to_string(i));
+  }
+
+  print_process("assign");
+  t.assign(2, 5);
+  EXPECT_EQ(t.size(), 2u);
+  EXPECT_EQ(t[1], 5);
+  t.assign({9, 8, 7});
+  EXPECT_EQ(t.size(), 3u);
+  EXPECT_EQ(t[0], 9);
+}
+
+// 只支持单趟遍历的输入迭代器：产生 [cur, end)
+struct counting_input_iter : public zfwstl::iterator<zfwstl::input_iterator_tag, int>
+{
+  int cur;
+  explicit counting_input_iter(int c) : cur(c) {}
+  int operator*() const { return cur; }
+  counting_input_iter &operator++()
+  {
+    ++cur;
+    return *this;
+  }
+  bool operator==(const counting_input_iter &rhs) const { return cur == rhs.cur; }
+  bool operator!=(const counting_input_iter &rhs) const { return cur != rhs.cur; }
+};
+TEST_F(SContainerTestSmallVec, RangeInsert)
+{
+  print_process("pointer range within inline storage");
+  const int src[] = {10, 11, 12, 13, 14, 15};
+  counted_vec a{1, 2};
+  counting_alloc::allocs = 0;
+  counted_vec::iterator it = a.insert(a.begin() + 1, src, src + 1);
+  EXPECT_EQ(it, a.begin() + 1);
+  it = a.insert(a.end(), src + 1, src + 2);
+  EXPECT_EQ(*it, 11);
+  EXPECT_EQ(counting_alloc::allocs, 0u);
+  const int expect1[] = {1, 10, 2, 11};
+  ASSERT_EQ(a.size(), 4u);
+  for (size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i], expect1[i]);
+
+  print_process("pointer range spills to the heap");
+  it = a.insert(a.begin() + 2, src + 2, src + 6);
+  EXPECT_EQ(it, a.begin() + 2);
+  EXPECT_EQ(counting_alloc::allocs, 1u);
+  const int expect2[] = {1, 10, 12, 13, 14, 15, 2, 11};
+  ASSERT_EQ(a.size(), 8u);
+  for (size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i], expect2[i]);
+
+  print_process("initializer_list");
+  zfwstl::small_vector<std::string, 2> s{"a", "d"};
+  s.insert(s.begin() + 1, {"b", "c"});
+  ASSERT_EQ(s.size(), 4u);
+  EXPECT_EQ(s[1], "b");
+  EXPECT_EQ(s[2], "c");
+  EXPECT_EQ(s[3], "d");
+  s.insert(s.begin(), {});
+  EXPECT_EQ(s.size(), 4u);
+
+  print_process("input iterators against vector");
+  zfwstl::small_vector<int, 4> b{1, 2};
+  zfwstl::vector<int> ref{1, 2};
+  b.insert(b.begin() + 1, counting_input_iter(0), counting_input_iter(2));
+  ref.insert(ref.begin() + 1, counting_input_iter(0), counting_input_iter(2));
+  expect_same(b, ref);
+  it = b.insert(b.begin() + 2, counting_input_iter(5), counting_input_iter(20));
+  ref.insert(ref.begin() + 2, counting_input_iter(5), counting_input_iter(20));
+  EXPECT_EQ(*it, 5);
+  expect_same(b, ref);
+}
+
+TEST_F(SContainerTestSmallVec, MoveSwap)
+{
+  print_process("Move constructor");
+  zfwstl::small_vector<int, 4> a(zfwstl::move(v1));
+  EXPECT_TRUE(a.is_inline());
+  EXPECT_EQ(a.size(), 3u);
+  EXPECT_TRUE(v1.empty());
+  EXPECT_TRUE(v1.is_inline());
+  const int *heap = v2.data();
+  zfwstl::small_vector<int, 4> b(zfwstl::move(v2));
+  EXPECT_EQ(b.data(), heap); // 堆空间直接接管
+  EXPECT_TRUE(v2.empty());
+  v2.push_back(1);
+  EXPECT_EQ(v2.size(), 1u);
+
+  print_process("Move assignment");
+  zfwstl::small_vector<int, 4> c{1, 2, 3, 4, 5, 6};
+  c = zfwstl::move(a);
+  EXPECT_TRUE(c.is_inline());
+  EXPECT_EQ(c.size(), 3u);
+  EXPECT_EQ(c[2], 3);
+
+  print_process("swap");
+  zfwstl::small_vector<int, 4> d{1, 2}, e{3, 4, 5, 6, 7, 8};
+  zfwstl::swap(d, e);
+  EXPECT_EQ(d.size(), 6u);
+  EXPECT_EQ(d[5], 8);
+  EXPECT_EQ(e.size(), 2u);
+  EXPECT_EQ(e[1], 2);
+  EXPECT_TRUE(e.is_inline());
+  zfwstl::small_vector<int, 4> f{10, 11, 12, 13, 14};
+  heap = f.data();
+  d.swap(f);
+  EXPECT_EQ(d.data(), heap);
+  EXPECT_EQ(f.size(), 6u);
+
+  print_process("compare");
+  zfwstl::small_vector<int, 4> g{1, 2}, h{1, 3};
+  EXPECT_TRUE(g < h);
+  EXPECT_TRUE(g != h);
+  EXPECT_TRUE(g <= g);
+}
+
+TEST_F(SContainerTestSmallVec, NonTrivial)
+{
+  print_process("string elements");
+  zfwstl::small_vector<std::string, 2> s;
+  s.push_back("a long string that does not fit into the small string buffer");
+  s.emplace_back(3, 'x');
+  s.emplace(s.begin(), "front");
+  EXPECT_FALSE(s.is_inline());
+  EXPECT_EQ(s[0], "front");
+  EXPECT_EQ(s[2], "xxx");
+  zfwstl::small_vector<std::string, 2> t(s);
+  EXPECT_TRUE(t == s);
+  s.erase(s.begin());
+  EXPECT_EQ(s.size(), 2u);
+  EXPECT_EQ(s[1], "xxx");
+  zfwstl::small_vector<std::string, 2> u{"p", "q"};
+  u.swap(t);
+  EXPECT_EQ(u.size(), 3u);
+  EXPECT_EQ(t.size(), 2u);
+  EXPECT_EQ(t[1], "q");
+  t = u;
+  EXPECT_TRUE(t == u);
+  t.insert(t.begin() + 1, 2, t[0]);
+  EXPECT_EQ(t[1], "front");
+  EXPECT_EQ(t[2], "front");
+  EXPECT_EQ(t.size(), 5u);
+}
+// 第 budget 次构造时抛出异常；移动构造未声明 noexcept
+struct thrower
+{
+  static int live, budget;
+  int v;
+  thrower(int x) : v(x) { tick(), ++live; }
+  thrower(const thrower &rhs) : v(rhs.v) { tick(), ++live; }
+  thrower(thrower &&rhs) noexcept(false) : v(rhs.v) { ++live; }
+  thrower &operator=(const thrower &rhs)
+  {
+    v = rhs.v;
+    return *this;
+  }
+  ~thrower() { --live; }
+  static void tick()
+  {
+    if (budget >= 0 && budget-- == 0)
+      throw std::runtime_error("thrower");
+  }
+};
+int thrower::live = 0, thrower::budget = -1;
+TEST_F(SContainerTestSmallVec, Exceptions)
+{
+  print_process("noexcept follows the element type");
+  EXPECT_TRUE((std::is_nothrow_move_constructible<zfwstl::small_vector<int, 4>>::value));
+  EXPECT_FALSE((std::is_nothrow_move_constructible<zfwstl::small_vector<thrower, 2>>::value));
+  EXPECT_FALSE((std::is_nothrow_move_assignable<zfwstl::small_vector<thrower, 2>>::value));
+
+  print_process("constructors release storage on failure");
+  thrower seed(7);
+  thrower::budget = 5;
+  EXPECT_THROW((zfwstl::small_vector<thrower, 2>(10, seed)), std::runtime_error);
+  EXPECT_EQ(thrower::live, 1);
+  zfwstl::vector<thrower> src(10, seed);
+  thrower::budget = 5;
+  EXPECT_THROW((zfwstl::small_vector<thrower, 2>(src.begin(), src.end())), std::runtime_error);
+  EXPECT_EQ(thrower::live, 11);
+  thrower::budget = -1;
+  zfwstl::small_vector<thrower, 2> big(src.begin(), src.end());
+  thrower::budget = 3;
+  EXPECT_THROW((zfwstl::small_vector<thrower, 2>(big)), std::runtime_error);
+  EXPECT_EQ(thrower::live, 21);
+
+  print_process("growth copies when move may throw");
+  thrower::budget = -1;
+  zfwstl::small_vector<thrower, 2> g;
+  g.emplace_back(1);
+  g.emplace_back(2);
+  thrower::budget = 2; // 新元素构造成功，搬第二个旧元素时失败
+  EXPECT_THROW(g.emplace_back(3), std::runtime_error);
+  EXPECT_TRUE(g.is_inline());
+  ASSERT_EQ(g.size(), 2u);
+  EXPECT_EQ(g[0].v, 1);
+  EXPECT_EQ(g[1].v, 2);
+  thrower::budget = 1;
+  EXPECT_THROW(g.insert(g.begin() + 1, 2, seed), std::runtime_error);
+  EXPECT_EQ(g.size(), 2u);
+  thrower::budget = -1;
+  g.insert(g.begin() + 1, 2, seed);
+  EXPECT_EQ(g.size(), 4u);
+  EXPECT_EQ(g[2].v, 7);
+  EXPECT_EQ(g[3].v, 2);
+  thrower::budget = 2;
+  EXPECT_THROW(g.reserve(100), std::runtime_error);
+  EXPECT_EQ(g.capacity(), 4u);
+  EXPECT_EQ(g[3].v, 2);
+  thrower::budget = -1;
+}
+int main(int argc, char **argv)
+{
+  print_start();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif // GOOGLETEST_SAMPLES_small_vector_H_
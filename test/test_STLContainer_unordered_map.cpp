@@ -183,6 +183,31 @@ TEST_F(AContainerTestUMap, BeginEndIterators)
   auto cbegin_it = simap.cbegin();
   EXPECT_EQ((*(cbegin_it)).first, "one"); // 检查 cbegin() 是否指向第一个元素
 }
+// 测试透明哈希/比较器下的异构查找
+TEST(AContainerTestUMapTransparent, TransparentLookup)
+{
+  print_process("unordered_map<std::string, int, hash<std::string>, equal_to<>> lookup by const char*");
+  zfwstl::unordered_map<std::string, int, zfwstl::hash<std::string>, zfwstl::equal_to<>> m;
+  m[std::string("apple")] = 1;
+  m[std::string("banana")] = 2;
+  const char *key = "banana";
+  EXPECT_EQ(m.find(key)->second, 2);
+  EXPECT_EQ(m.find("durian"), m.end());
+  EXPECT_EQ(m.count("apple"), 1);
+  auto range = m.equal_range("apple");
+  EXPECT_EQ(zfwstl::distance(range.first, range.second), 1);
+  EXPECT_EQ(m.erase("apple"), 1);
+  EXPECT_EQ(m.count("apple"), 0);
+  EXPECT_EQ(m.size(), 1);
+
+  print_process("erase(key) with default hash<int>");
+  zfwstl::unordered_map<int, int> n;
+  n[1] = 1;
+  n[2] = 2;
+  EXPECT_EQ(n.erase(1), 1);
+  EXPECT_EQ(n.count(1), 0);
+  EXPECT_EQ(n.size(), 1);
+}
 int main(int argc, char **argv)
 {
   print_start();
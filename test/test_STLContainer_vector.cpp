@@ -5,6 +5,7 @@
 #include <cstddef> // for size_t, ptrdiff_t
 #include <string>
 #include "../STL/vector.h"
+#include "../src/memory/alloc.h" // for malloc_alloc
 /**
  * SContainerTestVec: 序列容器测试类
  * 测试类继承自 ::testing::Test，它将用于所有测试用例
@@ -12,6 +13,8 @@
  * InitialState：测试向量在初始化后的状态。
  * PushBack：测试 push_back 方法是否正确增加了元素并更新了大小。
  * Insert：测试 insert 方法是否正确插入了元素，并检查了插入位置及其后元素的状态
+ * Growth：扩容策略、扩容时中间插入保留尾部元素、移动/复制的选择、realloc 路径
+ * RangeInsert：区间插入(前向/输入迭代器，扩容与不扩容)、append_range、resize_default_init
  */
 void print_start()
 {
@@ -97,6 +100,19 @@ TEST_F(SContainerTestVec, AssignmentOperator)
   EXPECT_EQ(v5.size(), 6);
   EXPECT_EQ(v5.front(), 6);
   EXPECT_EQ(v5.back(), 6);
+
+  print_process("copy assignment keeps capacity");
+  zfwstl::vector<int, zfwstl::alloc> a, b(5, 7);
+  a.reserve(100);
+  a.push_back(1);
+  a = b; // size() < b.size() <= capacity()，原地复制，容量不变
+  EXPECT_EQ(a.size(), 5u);
+  EXPECT_EQ(a.capacity(), 100u);
+  for (int i = 0; i < 200; ++i) // 之后扩容时按原容量归还内存池
+    a.push_back(i);
+  EXPECT_EQ(a.size(), 205u);
+  EXPECT_EQ(a[4], 7);
+  EXPECT_EQ(a.back(), 199);
 }
 // 测试 assign 方法
 TEST_F(SContainerTestVec, Assign)
@@ -235,6 +251,194 @@ TEST_F(SContainerTestVec, ReserveResize)
   v1.resize(10, 3);
   EXPECT_EQ(v1.size(), 10);
 }
+// 统计复制、移动次数；移动构造可能抛异常时扩容应复制，否则应移动
+template <bool NoExcept>
+struct counted_move
+{
+  static int copies, moves;
+  int v;
+  counted_move(int x) : v(x) {}
+  counted_move(const counted_move &rhs) : v(rhs.v) { ++copies; }
+  counted_move(counted_move &&rhs) noexcept(NoExcept) : v(rhs.v) { ++moves; }
+  counted_move &operator=(const counted_move &rhs)
+  {
+    v = rhs.v;
+    return *this;
+  }
+};
+template <bool NoExcept>
+int counted_move<NoExcept>::copies = 0;
+template <bool NoExcept>
+int counted_move<NoExcept>::moves = 0;
+// 测试扩容
+TEST_F(SContainerTestVec, Growth)
+{
+  print_process("growth factor");
+  zfwstl::vector<int> a;
+  zfwstl::vector<int, zfwstl::new_alloc, zfwstl::growth_1_5x> b;
+  for (int i = 0; i < 9; ++i)
+  {
+    a.push_back(i);
+    b.push_back(i);
+  }
+  EXPECT_EQ(a.capacity(), 16u);
+  EXPECT_EQ(b.capacity(), 9u); // 1 2 3 4 6 9
+  b.insert(b.begin(), 10, -1);
+  EXPECT_EQ(b.capacity(), 19u);
+  EXPECT_EQ(b[10], 0);
+  EXPECT_EQ(b.back(), 8);
+
+  print_process("insert in the middle keeps the tail when growing");
+  zfwstl::vector<std::string> s = {"a", "b", "c", "d"};
+  s.insert(s.begin() + 1, std::string("x"));
+  ASSERT_EQ(s.size(), 5u);
+  EXPECT_EQ(s[1], "x");
+  EXPECT_EQ(s[4], "d");
+  s.emplace(s.begin() + 2, 3, 'y');
+  ASSERT_EQ(s.size(), 6u);
+  EXPECT_EQ(s[2], "yyy");
+  EXPECT_EQ(s[5], "d");
+  s.insert(s.begin() + 3, 10, s[0]);
+  ASSERT_EQ(s.size(), 16u);
+  EXPECT_EQ(s[12], "a");
+  EXPECT_EQ(s[13], "b");
+  EXPECT_EQ(s[15], "d");
+  v1.insert(v1.begin(), v1[4]); // 扩容时参数引用的是本容器中的元素
+  EXPECT_EQ(v1[0], 5);
+  EXPECT_EQ(v1[5], 5);
+  EXPECT_EQ(v1.size(), 6u);
+
+  print_process("move when nothrow, copy when move may throw");
+  zfwstl::vector<counted_move<true>> mv;
+  zfwstl::vector<counted_move<false>> cp;
+  for (int i = 0; i < 5; ++i)
+  {
+    mv.emplace_back(i);
+    cp.emplace_back(i);
+  }
+  counted_move<true>::copies = counted_move<true>::moves = 0;
+  counted_move<false>::copies = counted_move<false>::moves = 0;
+  mv.reserve(100);
+  cp.reserve(100);
+  EXPECT_EQ(counted_move<true>::moves, 5);
+  EXPECT_EQ(counted_move<true>::copies, 0);
+  EXPECT_EQ(counted_move<false>::moves, 0);
+  EXPECT_EQ(counted_move<false>::copies, 5);
+  EXPECT_EQ(mv[4].v, 4);
+  EXPECT_EQ(cp[4].v, 4);
+
+  print_process("insert with spare capacity moves the tail");
+  counted_move<true>::copies = counted_move<true>::moves = 0;
+  mv.emplace(mv.begin(), 9);
+  EXPECT_EQ(counted_move<true>::copies, 0);
+  EXPECT_EQ(mv[0].v, 9);
+  EXPECT_EQ(mv[5].v, 4);
+  mv.insert(mv.begin() + 1, mv.back()); // 参数引用的是本容器中被挪动的元素
+  EXPECT_EQ(mv[1].v, 4);
+  EXPECT_EQ(mv[6].v, 4);
+  EXPECT_EQ(mv.capacity(), 100u);
+
+  print_process("realloc with malloc_alloc");
+  zfwstl::vector<int, zfwstl::malloc_alloc> m;
+  for (int i = 0; i < 1000; ++i)
+    m.insert(m.begin() + m.size() / 2, i);
+  zfwstl::vector<int, zfwstl::alloc> p;
+  for (int i = 0; i < 1000; ++i)
+    p.push_back(i);
+  ASSERT_EQ(m.size(), 1000u);
+  EXPECT_EQ(m[0], 1);
+  EXPECT_EQ(m[999], 0);
+  EXPECT_EQ(p[999], 999);
+  m.reserve(5000);
+  EXPECT_EQ(m.capacity(), 5000u);
+  EXPECT_EQ(m[999], 0);
+}
+// 只支持单趟遍历的输入迭代器：产生 [cur, end)
+struct counting_input_iter : public zfwstl::iterator<zfwstl::input_iterator_tag, int>
+{
+  int cur;
+  explicit counting_input_iter(int c) : cur(c) {}
+  int operator*() const { return cur; }
+  counting_input_iter &operator++()
+  {
+    ++cur;
+    return *this;
+  }
+  bool operator==(const counting_input_iter &rhs) const { return cur == rhs.cur; }
+  bool operator!=(const counting_input_iter &rhs) const { return cur != rhs.cur; }
+};
+// 测试区间插入
+TEST_F(SContainerTestVec, RangeInsert)
+{
+  print_process("forward iterator range, with and without growing");
+  zfwstl::vector<std::string> s = {"a", "b", "c", "d"};
+  s.reserve(20);
+  zfwstl::vector<std::string> src = {"x", "y", "z"};
+  auto it = s.insert(s.begin() + 3, src.begin(), src.end()); // 插入点之后元素少于新增元素
+  EXPECT_EQ(*it, "x");
+  it = s.insert(s.begin() + 1, src.begin(), src.begin() + 2); // 插入点之后元素多于新增元素
+  EXPECT_EQ(*it, "x");
+  const char *expect1[] = {"a", "x", "y", "b", "c", "x", "y", "z", "d"};
+  ASSERT_EQ(s.size(), 9u);
+  for (size_t i = 0; i < 9; ++i)
+    EXPECT_EQ(s[i], expect1[i]);
+  zfwstl::vector<std::string> big(30, "q");
+  s.insert(s.begin() + 2, big.begin(), big.end());
+  ASSERT_EQ(s.size(), 39u);
+  EXPECT_EQ(s[1], "x");
+  EXPECT_EQ(s[31], "q");
+  EXPECT_EQ(s[32], "y");
+  EXPECT_EQ(s[38], "d");
+  int arr[] = {7, 8, 9};
+  v1.insert(v1.begin() + 1, arr, arr + 3);
+  v1.insert(v1.end(), {10, 11});
+  const int expect2[] = {1, 7, 8, 9, 2, 3, 4, 5, 10, 11};
+  ASSERT_EQ(v1.size(), 10u);
+  for (size_t i = 0; i < 10; ++i)
+    EXPECT_EQ(v1[i], expect2[i]);
+
+  print_process("input iterator range");
+  zfwstl::vector<int> from_input(counting_input_iter(0), counting_input_iter(20));
+  ASSERT_EQ(from_input.size(), 20u);
+  EXPECT_EQ(from_input[19], 19);
+  zfwstl::vector<int> w = {-1, -2};
+  auto wit = w.insert(w.begin() + 1, counting_input_iter(0), counting_input_iter(100));
+  EXPECT_EQ(*wit, 0);
+  ASSERT_EQ(w.size(), 102u);
+  EXPECT_EQ(w[0], -1);
+  EXPECT_EQ(w[100], 99);
+  EXPECT_EQ(w[101], -2);
+  w.assign(counting_input_iter(5), counting_input_iter(8));
+  ASSERT_EQ(w.size(), 3u);
+  EXPECT_EQ(w[2], 7);
+  w.assign(counting_input_iter(0), counting_input_iter(50));
+  ASSERT_EQ(w.size(), 50u);
+  EXPECT_EQ(w[49], 49);
+
+  print_process("append_range / insert_range");
+  zfwstl::vector<int> a;
+  a.append_range(v2);
+  a.append_range(counting_input_iter(0), counting_input_iter(3));
+  a.insert_range(a.begin(), v2);
+  ASSERT_EQ(a.size(), 13u);
+  EXPECT_EQ(a[0], 6);
+  EXPECT_EQ(a[5], 6);
+  EXPECT_EQ(a[12], 2);
+
+  print_process("resize_default_init");
+  zfwstl::vector<char> buf;
+  buf.resize_default_init(1000);
+  EXPECT_EQ(buf.size(), 1000u);
+  EXPECT_GE(buf.capacity(), 1000u);
+  buf[999] = 'z';
+  buf.resize_default_init(10);
+  EXPECT_EQ(buf.size(), 10u);
+  zfwstl::vector<std::string> strs(2, "s");
+  strs.resize_default_init(5);
+  EXPECT_EQ(strs.size(), 5u);
+  EXPECT_EQ(strs[0], "s");
+  EXPECT_TRUE(strs[4].empty());
+}
 // 测试一系列反向迭代器rbegin, rend()
 TEST_F(SContainerTestVec, BeginEndIterators)
 {